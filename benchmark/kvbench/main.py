@@ -21,6 +21,7 @@ import logging
 import os
 from pathlib import Path
 from test.custom_traffic_perftest import CTPerftest
+from test.disagg_serving_sim import run_serving_sim
 from test.sequential_custom_traffic_perftest import SequentialCTPerftest
 from test.traffic_pattern import TrafficPattern
 
@@ -423,5 +424,75 @@ def ct_perftest(config_file, verify_buffers, print_recv_buffers):
     perftest.run(verify_buffers=verify_buffers, print_recv_buffers=print_recv_buffers)
 
 
+@cli.command("serving-sim")
+@common_args
+@cli_args
+@click.option(
+    "--backend", type=str, default="UCX", help="NIXL backend of the KV transfers"
+)
+@click.option(
+    "--mem-type",
+    type=click.Choice(["cpu", "cuda"]),
+    default="cpu",
+    help="Memory type of the KV buffers",
+)
+@click.option(
+    "--request-rate",
+    type=float,
+    default=1.0,
+    help="Poisson arrival rate in requests/s, ignored with --arrival-trace",
+)
+@click.option(
+    "--arrival-trace",
+    type=click.Path(exists=True),
+    default=None,
+    help="Request trace file, one '<arrival sec> [<isl> [<osl>]]' line per request",
+)
+@click.option(
+    "--kv-slots", type=int, default=4, help="Requests that can hold a KV slot at once"
+)
+@click.option(
+    "--max-decode-batch", type=int, default=64, help="Max requests in a decode step"
+)
+@click.option(
+    "--tflops", type=float, default=400.0, help="Compute throughput per GPU in TFLOPS"
+)
+@click.option(
+    "--hbm-bw", type=float, default=3350.0, help="Memory bandwidth per GPU in GB/s"
+)
+@click.option("--seed", type=int, default=0, help="Seed of the Poisson arrivals")
+@click.option(
+    "--json-output-path",
+    type=click.Path(),
+    help="Path to save JSON output",
+    default=None,
+)
+def serving_sim_command(model, model_config, **kwargs):
+    """Simulate disaggregated serving with modeled compute and real NIXL KV transfers"""
+    if not model or not model_config:
+        click.echo("Error: --model and --model_config are required")
+        return
+
+    model_arch = BaseModelArch.from_yaml(model, None)
+    model_configuration = ModelConfig.from_yaml(model_config)
+    override_yaml_args(model_configuration, type("Args", (), kwargs)())
+    model_arch.set_model_config(model_configuration)
+
+    run_serving_sim(
+        model_arch,
+        model_configuration,
+        backend=kwargs["backend"],
+        mem_type=kwargs["mem_type"],
+        request_rate=kwargs["request_rate"],
+        arrival_trace=kwargs["arrival_trace"],
+        num_slots=kwargs["kv_slots"],
+        max_decode_batch=kwargs["max_decode_batch"],
+        tflops=kwargs["tflops"],
+        hbm_bw_gbps=kwargs["hbm_bw"],
+        seed=kwargs["seed"],
+        json_output_path=kwargs["json_output_path"],
+    )
+
+
 if __name__ == "__main__":
     cli()
@@ -0,0 +1,422 @@
+# SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Disaggregated serving simulator that overlaps modeled compute with real NIXL transfers
+
+A prefill worker and a decode worker run in this process, each with its own NIXL agent.
+Compute is modeled: a prefill layer or a decode step keeps its worker busy for a time
+derived from the model size, the compute throughput and the memory bandwidth given. The KV
+cache of each prefill layer is written to the decode worker through NIXL as soon as the
+layer is computed, so the transfers overlap with the compute of the next layers, and a
+request joins the decode batch once all of its layers arrived.
+
+Disclaimers:
+- The transfers are the ones of a single TP rank, the compute model covers the whole TP group
+- The compute estimation is naive: dense layers, causal attention, and decode steps bound by
+  the larger of the compute time and the time to read the weights and the KV cache
+- A request holds a KV slot on both workers, from the start of its prefill until its KV cache
+  is transferred on the prefill worker and until its last token on the decode worker
+
+Reported per request:
+- TTFT: from arrival to the first token generated by the decode worker
+- TPOT: mean time between the following tokens
+- Transfer stall: from the end of the prefill compute to the arrival of the last KV layer
+"""
+
+import json
+import logging
+import random
+import time
+from collections import deque
+from dataclasses import dataclass, field
+from typing import Any, Dict, List, Optional
+
+import torch
+from models.model_config import ModelConfig
+from models.models import BaseModelArch
+from models.utils import get_precision_size
+from tabulate import tabulate
+
+from nixl._api import nixl_agent, nixl_agent_config
+
+log = logging.getLogger(__name__)
+
+
+@dataclass
+class SimRequest:
+    id: int
+    arrival: float
+    isl: int
+    osl: int
+    prefill_start: Optional[float] = None
+    prefill_end: Optional[float] = None
+    kv_ready: Optional[float] = None
+    first_token: Optional[float] = None
+    finish: Optional[float] = None
+    tokens: int = 0
+    slot: Optional[int] = None
+    handles: List[Any] = field(default_factory=list)
+
+    @property
+    def ttft(self) -> float:
+        return self.first_token - self.arrival
+
+    @property
+    def tpot(self) -> float:
+        if self.osl <= 1:
+            return 0.0
+        return (self.finish - self.first_token) / (self.osl - 1)
+
+    @property
+    def stall(self) -> float:
+        return self.kv_ready - self.prefill_end
+
+
+def poisson_arrivals(
+    num_requests: int, rate: float, isl: int, osl: int, seed: int = 0
+) -> List[SimRequest]:
+    """Requests with exponential inter-arrival times of mean 1/rate seconds"""
+    rng = random.Random(seed)
+    now = 0.0
+    requests = []
+    for i in range(num_requests):
+        now += rng.expovariate(rate)
+        requests.append(SimRequest(id=i, arrival=now, isl=isl, osl=osl))
+    return requests
+
+
+def load_arrivals(trace_file: str, isl: int, osl: int) -> List[SimRequest]:
+    """Load a request trace, one "<arrival sec> [<isl> [<osl>]]" line per request.
+    The ISL and OSL of the model config are used for the missing columns.
+    """
+    requests = []
+    with open(trace_file, "r") as f:
+        for line in f:
+            fields = line.split("#")[0].split()
+            if not fields:
+                continue
+            requests.append(
+                SimRequest(
+                    id=len(requests),
+                    arrival=float(fields[0]),
+                    isl=int(fields[1]) if len(fields) > 1 else isl,
+                    osl=int(fields[2]) if len(fields) > 2 else osl,
+                )
+            )
+    requests.sort(key=lambda req: req.arrival)
+    return requests
+
+
+class ComputeModel:
+    """Per-layer compute times of a TP group, in seconds"""
+
+    def __init__(
+        self,
+        model_arch: BaseModelArch,
+        model_config: ModelConfig,
+        tflops: float = 400.0,
+        hbm_bw_gbps: float = 3350.0,
+    ):
+        tp = model_config.model.tp_size
+        self.num_layers = model_arch.num_layers
+        self.layer_params = model_arch.num_model_params / self.num_layers
+        self.layer_weight_bytes = self.layer_params * get_precision_size(
+            model_config.model.model_quant_mode
+        )
+        self.layer_kv_bytes_per_token = (
+            model_arch.get_kv_size_per_token() / self.num_layers
+        )
+        # Attention FLOPs need the hidden size, which not every architecture exposes
+        self.model_dimension = getattr(model_arch, "model_dimension", 0)
+        self.flops = tflops * 1e12 * tp
+        self.hbm_bw = hbm_bw_gbps * 1e9 * tp
+
+    def prefill_layer_time(self, isl: int) -> float:
+        flop = 2 * self.layer_params * isl + 2 * self.model_dimension * isl**2
+        return flop / self.flops
+
+    def decode_step_time(self, batch_size: int, context_tokens: int) -> float:
+        compute = 2 * self.layer_params * batch_size / self.flops
+        memory = (
+            self.layer_weight_bytes + self.layer_kv_bytes_per_token * context_tokens
+        ) / self.hbm_bw
+        return self.num_layers * max(compute, memory)
+
+
+class NixlKVTransfer:
+    """Prefill and decode agents of this process, with a KV slot per in-flight request"""
+
+    def __init__(
+        self,
+        backend: str,
+        mem_type: str,
+        num_layers: int,
+        layer_bytes: int,
+        num_slots: int,
+    ):
+        if mem_type in ("cuda", "vram"):
+            device = torch.device("cuda")
+        elif mem_type in ("cpu", "dram"):
+            device = torch.device("cpu")
+        else:
+            raise ValueError(f"Unsupported memory type: {mem_type}")
+
+        config = nixl_agent_config(backends=[backend])
+        self.prefill_agent = nixl_agent("prefill", config)
+        self.decode_agent = nixl_agent("decode", config)
+
+        shape = (num_slots, num_layers, layer_bytes)
+        self.prefill_buf = torch.ones(shape, dtype=torch.int8, device=device)
+        self.decode_buf = torch.zeros(shape, dtype=torch.int8, device=device)
+        self.prefill_reg = self.prefill_agent.register_memory(self.prefill_buf)
+        self.decode_reg = self.decode_agent.register_memory(self.decode_buf)
+        assert self.prefill_reg is not None and self.decode_reg is not None
+
+        self.prefill_agent.add_remote_agent(self.decode_agent.get_agent_metadata())
+        self.bytes_transferred = 0
+
+    def post(self, slot: int, layer: int, nbytes: int):
+        src = self.prefill_agent.get_xfer_descs(self.prefill_buf[slot, layer, :nbytes])
+        dst = self.decode_agent.get_xfer_descs(self.decode_buf[slot, layer, :nbytes])
+        handle = self.prefill_agent.initialize_xfer("WRITE", src, dst, "decode")
+        state = self.prefill_agent.transfer(handle)
+        assert state != "ERR", "Transfer failed"
+        self.bytes_transferred += nbytes
+        return handle
+
+    def done(self, handle) -> bool:
+        state = self.prefill_agent.check_xfer_state(handle)
+        assert state != "ERR", "Transfer got to Error state."
+        if state != "DONE":
+            return False
+        self.prefill_agent.release_xfer_handle(handle)
+        return True
+
+    def destroy(self):
+        self.prefill_agent.remove_remote_agent("decode")
+        self.prefill_agent.deregister_memory(self.prefill_reg)
+        self.decode_agent.deregister_memory(self.decode_reg)
+
+
+class DisaggServingSim:
+    def __init__(
+        self,
+        requests: List[SimRequest],
+        compute: ComputeModel,
+        kv_transfer: NixlKVTransfer,
+        layer_kv_bytes_per_token: float,
+        num_slots: int = 4,
+        max_decode_batch: int = 64,
+    ):
+        """
+        Args:
+            requests: Requests sorted by arrival time
+            compute: Model of the prefill and decode compute times
+            kv_transfer: Transfers of the KV cache layers of one TP rank
+            layer_kv_bytes_per_token: KV bytes per token and layer of one TP rank
+            num_slots: Requests that can hold a KV slot at once
+            max_decode_batch: Max requests in a decode step
+        """
+        self.requests = requests
+        self.compute = compute
+        self.kv_transfer = kv_transfer
+        self.layer_kv_bytes_per_token = layer_kv_bytes_per_token
+        self.num_slots = num_slots
+        self.max_decode_batch = max_decode_batch
+
+    def _layer_bytes(self, req: SimRequest) -> int:
+        return max(1, int(self.layer_kv_bytes_per_token * req.isl))
+
+    def run(self) -> Dict[str, Any]:
+        """Replay the requests in real time, returns the metrics of the run"""
+        num_layers = self.compute.num_layers
+        arrivals = deque(self.requests)
+        prefill_queue: deque = deque()
+        free_slots = list(range(self.num_slots))
+        prefill_req: Optional[SimRequest] = None
+        prefill_layer = 0
+        layer_end = 0.0
+        transferring: List[SimRequest] = []
+        decode_queue: deque = deque()
+        decode_batch: List[SimRequest] = []
+        step_end: Optional[float] = None
+        finished = 0
+
+        start = time.perf_counter()
+        while finished < len(self.requests):
+            now = time.perf_counter() - start
+
+            while arrivals and arrivals[0].arrival <= now:
+                prefill_queue.append(arrivals.popleft())
+
+            # Prefill worker, each computed layer is sent right away. Modeled times advance
+            # from the end of the previous layer, so that polling delays don't add up.
+            if prefill_req is not None and now >= layer_end:
+                prefill_req.handles.append(
+                    self.kv_transfer.post(
+                        prefill_req.slot, prefill_layer, self._layer_bytes(prefill_req)
+                    )
+                )
+                prefill_layer += 1
+                if prefill_layer == num_layers:
+                    prefill_req.prefill_end = layer_end
+                    prefill_req = None
+                else:
+                    layer_end += self.compute.prefill_layer_time(prefill_req.isl)
+
+            if prefill_req is None and prefill_queue and free_slots:
+                prefill_req = prefill_queue.popleft()
+                prefill_req.slot = free_slots.pop()
+                prefill_req.prefill_start = now
+                prefill_layer = 0
+                layer_end = now + self.compute.prefill_layer_time(prefill_req.isl)
+                transferring.append(prefill_req)
+
+            # KV transfers, a request is ready for decode once all its layers arrived
+            for req in list(transferring):
+                req.handles = [h for h in req.handles if not self.kv_transfer.done(h)]
+                if req.prefill_end is not None and not req.handles:
+                    req.kv_ready = max(now, req.prefill_end)
+                    transferring.remove(req)
+                    decode_queue.append(req)
+
+            # Decode worker, continuous batching at step boundaries
+            if step_end is not None and now >= step_end:
+                running = []
+                for req in decode_batch:
+                    req.tokens += 1
+                    if req.first_token is None:
+                        req.first_token = step_end
+                    if req.tokens >= req.osl:
+                        req.finish = step_end
+                        free_slots.append(req.slot)
+                        finished += 1
+                    else:
+                        running.append(req)
+                decode_batch = running
+                step_end = None
+
+            if step_end is None:
+                while decode_queue and len(decode_batch) < self.max_decode_batch:
+                    decode_batch.append(decode_queue.popleft())
+                if decode_batch:
+                    context = sum(req.isl + req.tokens for req in decode_batch)
+                    step_end = now + self.compute.decode_step_time(
+                        len(decode_batch), context
+                    )
+
+        duration = time.perf_counter() - start
+        return self._metrics(duration)
+
+    def _metrics(self, duration: float) -> Dict[str, Any]:
+        def stats(values: List[float]) -> Dict[str, float]:
+            values = sorted(values)
+            n = len(values)
+            return {
+                "mean": sum(values) / n,
+                "p50": values[min(n - 1, int(0.5 * n))],
+                "p99": values[min(n - 1, int(0.99 * n))],
+                "max": values[-1],
+            }
+
+        output_tokens = sum(req.osl for req in self.requests)
+        return {
+            "requests": len(self.requests),
+            "duration_sec": duration,
+            "request_throughput": len(self.requests) / duration,
+            "output_token_throughput": output_tokens / duration,
+            "kv_transferred_gb": self.kv_transfer.bytes_transferred / 1e9,
+            "ttft_sec": stats([req.ttft for req in self.requests]),
+            "tpot_sec": stats([req.tpot for req in self.requests]),
+            "transfer_stall_sec": stats([req.stall for req in self.requests]),
+        }
+
+
+def print_metrics(metrics: Dict[str, Any]):
+    print(
+        f"{metrics['requests']} requests in {metrics['duration_sec']:.3f} s: "
+        f"{metrics['request_throughput']:.3f} req/s, "
+        f"{metrics['output_token_throughput']:.1f} output tokens/s, "
+        f"{metrics['kv_transferred_gb']:.3f} GB of KV cache transferred"
+    )
+    headers = ["Metric (ms)", "Mean", "P50", "P99", "Max"]
+    data = [
+        [name] + [metrics[key][stat] * 1e3 for stat in ("mean", "p50", "p99", "max")]
+        for name, key in (
+            ("TTFT", "ttft_sec"),
+            ("TPOT", "tpot_sec"),
+            ("Transfer stall", "transfer_stall_sec"),
+        )
+    ]
+    print(tabulate(data, headers=headers, floatfmt=".3f"))
+
+
+def run_serving_sim(
+    model_arch: BaseModelArch,
+    model_config: ModelConfig,
+    backend: str = "UCX",
+    mem_type: str = "cpu",
+    request_rate: float = 1.0,
+    arrival_trace: Optional[str] = None,
+    num_slots: int = 4,
+    max_decode_batch: int = 64,
+    tflops: float = 400.0,
+    hbm_bw_gbps: float = 3350.0,
+    seed: int = 0,
+    json_output_path: Optional[str] = None,
+) -> Dict[str, Any]:
+    runtime = model_config.runtime
+    if arrival_trace:
+        requests = load_arrivals(arrival_trace, runtime.isl, runtime.osl)
+    else:
+        requests = poisson_arrivals(
+            runtime.num_requests, request_rate, runtime.isl, runtime.osl, seed
+        )
+    if not requests:
+        raise ValueError("No requests to simulate")
+
+    compute = ComputeModel(model_arch, model_config, tflops, hbm_bw_gbps)
+    layer_kv_bytes_per_token = (
+        compute.layer_kv_bytes_per_token / model_config.model.tp_size
+    )
+    max_layer_bytes = int(
+        layer_kv_bytes_per_token * max(req.isl for req in requests)
+    )
+    log.info(
+        f"Allocating {num_slots} KV slots of {compute.num_layers} x {max_layer_bytes} bytes"
+    )
+    kv_transfer = NixlKVTransfer(
+        backend, mem_type, compute.num_layers, max(1, max_layer_bytes), num_slots
+    )
+
+    try:
+        sim = DisaggServingSim(
+            requests,
+            compute,
+            kv_transfer,
+            layer_kv_bytes_per_token,
+            num_slots=num_slots,
+            max_decode_batch=max_decode_batch,
+        )
+        metrics = sim.run()
+    finally:
+        kv_transfer.destroy()
+
+    print_metrics(metrics)
+    if json_output_path:
+        log.info(f"Saving results to {json_output_path}")
+        with open(json_output_path, "w") as f:
+            json.dump(metrics, f)
+    return metrics
@@ -101,6 +101,47 @@ static std::vector<std::vector<xferBenchIOV>> createTransferDescLists(xferBenchW
     return xfer_lists;
 }
 
+static int processArrivalRates(xferBenchWorker &worker,
+                               std::vector<std::vector<xferBenchIOV>> &local_trans_lists,
+                               size_t block_size, size_t batch_size) {
+    // Without rates, the trace is replayed as recorded by each thread
+    std::vector<double> rates = xferBenchConfig::arrival_rates;
+    if (rates.empty()) {
+        rates.push_back(0);
+    }
+
+    for (size_t i = 0; !worker.signaled() && i < rates.size(); i++) {
+        double offered_rate = rates[i];
+        if (0 == offered_rate) {
+            offered_rate = xferBenchArrivals::traceRate() * xferBenchConfig::num_threads;
+        }
+
+        if (worker.isTarget()) {
+            std::vector<double> latencies;
+            worker.exchangeIOV(local_trans_lists);
+            worker.poll(block_size);
+            if (IS_PAIRWISE_AND_SG()) {
+                xferBenchUtils::printOpenLoopStats(true, block_size, batch_size, offered_rate,
+                                                   0, latencies);
+            }
+        } else if (worker.isInitiator()) {
+            std::vector<std::vector<xferBenchIOV>> remote_trans_lists(worker.exchangeIOV(local_trans_lists));
+            std::vector<double> latencies;
+
+            auto result = worker.transferOpenLoop(block_size, local_trans_lists,
+                                                  remote_trans_lists, rates[i], latencies);
+            if (std::holds_alternative<int>(result)) {
+                return 1;
+            }
+
+            xferBenchUtils::printOpenLoopStats(false, block_size, batch_size, offered_rate,
+                                               std::get<double>(result), latencies);
+        }
+    }
+
+    return 0;
+}
+
 static int processBatchSizes(xferBenchWorker &worker,
                              std::vector<std::vector<xferBenchIOV>> &iov_lists,
                              size_t block_size, int num_threads) {
@@ -114,7 +155,11 @@ static int processBatchSizes(xferBenchWorker &worker,
                                                          batch_size,
                                                          num_threads);
 
-        if (worker.isTarget()) {
+        if (xferBenchConfig::isOpenLoop()) {
+            if (processArrivalRates(worker, local_trans_lists, block_size, batch_size) != 0) {
+                return 1;
+            }
+        } else if (worker.isTarget()) {
             worker.exchangeIOV(local_trans_lists);
             worker.poll(block_size);
 
@@ -213,7 +258,11 @@ int main(int argc, char *argv[]) {
 
     if (worker_ptr->isInitiator() && worker_ptr->isMasterRank()) {
         xferBenchConfig::printConfig();
-        xferBenchUtils::printStatsHeader();
+        if (xferBenchConfig::isOpenLoop()) {
+            xferBenchUtils::printOpenLoopStatsHeader();
+        } else {
+            xferBenchUtils::printStatsHeader();
+        }
     }
 
     for (size_t block_size = xferBenchConfig::start_block_size;
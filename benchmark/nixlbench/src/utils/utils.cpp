@@ -15,8 +15,11 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <cstring>
+#include <fstream>
 #include <gflags/gflags.h>
+#include <numeric>
 #include <sstream>
 #include <sys/time.h>
 #include <unistd.h>
@@ -91,6 +94,17 @@ DEFINE_string (posix_api_type,
 DEFINE_string(gpunetio_device_list, "0", "Comma-separated GPU CUDA device id to use for \
 		      communication (only used with nixl worker)");
 
+// Open-loop options - transfers are issued at a target rate instead of back to back
+DEFINE_string(arrival_rates, "", "Comma-separated offered loads in transfers/sec per initiator \
+              process, one run each (Default: closed loop)");
+DEFINE_string(arrival_pattern, XFERBENCH_ARRIVAL_POISSON, "Inter-arrival times of the open-loop \
+              mode [poisson, fixed]");
+DEFINE_string(arrival_trace, "", "File with recorded inter-arrival times in us, one per line, \
+              rescaled to each arrival rate or replayed as recorded without --arrival_rates");
+DEFINE_int32(max_inflight, 64, "Max transfers in flight per thread in the open-loop mode");
+DEFINE_bool(completion_queue, false, "Collect open-loop completions from a completion queue \
+            instead of checking each transfer in flight (only used with nixl worker)");
+
 std::string xferBenchConfig::runtime_type = "";
 std::string xferBenchConfig::worker_type = "";
 std::string xferBenchConfig::backend = "";
@@ -122,6 +136,11 @@ int xferBenchConfig::num_files = 0;
 std::string xferBenchConfig::posix_api_type = "";
 std::string xferBenchConfig::filepath = "";
 bool xferBenchConfig::storage_enable_direct = false;
+std::vector<double> xferBenchConfig::arrival_rates;
+std::string xferBenchConfig::arrival_pattern = "";
+std::string xferBenchConfig::arrival_trace = "";
+int xferBenchConfig::max_inflight = 0;
+bool xferBenchConfig::completion_queue = false;
 
 int xferBenchConfig::loadFromFlags() {
     runtime_type = FLAGS_runtime_type;
@@ -193,6 +212,42 @@ int xferBenchConfig::loadFromFlags() {
     num_files = FLAGS_num_files;
     posix_api_type = FLAGS_posix_api_type;
     storage_enable_direct = FLAGS_storage_enable_direct;
+    arrival_pattern = FLAGS_arrival_pattern;
+    arrival_trace = FLAGS_arrival_trace;
+    max_inflight = FLAGS_max_inflight;
+    completion_queue = FLAGS_completion_queue;
+
+    std::stringstream rates(FLAGS_arrival_rates);
+    std::string rate;
+    while (std::getline(rates, rate, ',')) {
+        char *end;
+        double value = strtod(rate.c_str(), &end);
+        if (*end != '\0' || value <= 0) {
+            std::cerr << "Invalid arrival rate: " << rate << std::endl;
+            return -1;
+        }
+        arrival_rates.push_back(value);
+    }
+
+    if (isOpenLoop()) {
+        if (worker_type != XFERBENCH_WORKER_NIXL) {
+            std::cerr << "Open-loop mode is only supported with the nixl worker" << std::endl;
+            return -1;
+        }
+        if (arrival_pattern != XFERBENCH_ARRIVAL_POISSON &&
+            arrival_pattern != XFERBENCH_ARRIVAL_FIXED) {
+            std::cerr << "Invalid arrival pattern: " << arrival_pattern
+                      << ". Must be one of [poisson, fixed]" << std::endl;
+            return -1;
+        }
+        if (max_inflight < 1) {
+            std::cerr << "max_inflight must be at least 1" << std::endl;
+            return -1;
+        }
+        if (!arrival_trace.empty() && xferBenchArrivals::loadTrace(arrival_trace) != 0) {
+            return -1;
+        }
+    }
 
     if (worker_type == XFERBENCH_WORKER_NVSHMEM) {
         if (!((XFERBENCH_SEG_TYPE_VRAM == initiator_seg_type) &&
@@ -327,6 +382,21 @@ void xferBenchConfig::printConfig() {
     printOption ("Num iter (--num_iter=N)", std::to_string (num_iter));
     printOption ("Warmup iter (--warmup_iter=N)", std::to_string (warmup_iter));
     printOption ("Num threads (--num_threads=N)", std::to_string (num_threads));
+    if (isOpenLoop()) {
+        std::string rates;
+        for (double rate : arrival_rates) {
+            rates += (rates.empty() ? "" : ",") + std::to_string (rate);
+        }
+        printOption ("Arrival rates (--arrival_rates=R1,R2,...)", rates.empty() ? "trace" : rates);
+        if (arrival_trace.empty()) {
+            printOption ("Arrival pattern (--arrival_pattern=[poisson,fixed])", arrival_pattern);
+        } else {
+            printOption ("Arrival trace (--arrival_trace=path)", arrival_trace);
+        }
+        printOption ("Max inflight (--max_inflight=N)", std::to_string (max_inflight));
+        printOption ("Completion queue (--completion_queue=[0,1])",
+                     std::to_string (completion_queue));
+    }
     std::cout << std::string(80, '-') << std::endl;
     std::cout << std::endl;
 }
@@ -363,6 +433,69 @@ xferBenchConfig::isStorageBackend() {
             XFERBENCH_BACKEND_HF3FS == xferBenchConfig::backend ||
             XFERBENCH_BACKEND_POSIX == xferBenchConfig::backend);
 }
+bool
+xferBenchConfig::isOpenLoop() {
+    return !arrival_rates.empty() || !arrival_trace.empty();
+}
+
+/**********
+ * xferBench Arrivals
+ **********/
+std::vector<double> xferBenchArrivals::trace;
+
+xferBenchArrivals::xferBenchArrivals(double rate, unsigned int seed) :
+    gen(seed), exp_dist(1.0), mean_gap(0), trace_scale(1), trace_pos(0), now(0) {
+    if (!trace.empty()) {
+        // Each generator starts at a different point of the trace to avoid lockstep bursts
+        trace_pos = gen() % trace.size();
+        if (rate > 0) {
+            trace_scale = traceRate() / rate;
+        }
+    } else {
+        mean_gap = 1e6 / rate;
+    }
+}
+
+double xferBenchArrivals::next() {
+    if (!trace.empty()) {
+        now += trace[trace_pos] * trace_scale;
+        trace_pos = (trace_pos + 1) % trace.size();
+    } else if (XFERBENCH_ARRIVAL_POISSON == xferBenchConfig::arrival_pattern) {
+        now += exp_dist(gen) * mean_gap;
+    } else {
+        now += mean_gap;
+    }
+    return now;
+}
+
+int xferBenchArrivals::loadTrace(const std::string &path) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Failed to open arrival trace " << path << std::endl;
+        return -1;
+    }
+
+    double gap;
+    while (file >> gap) {
+        if (gap < 0) {
+            std::cerr << "Negative inter-arrival time in " << path << std::endl;
+            return -1;
+        }
+        trace.push_back(gap);
+    }
+
+    if (!file.eof() || trace.empty() || traceRate() == 0) {
+        std::cerr << "Invalid arrival trace " << path << std::endl;
+        return -1;
+    }
+    return 0;
+}
+
+double xferBenchArrivals::traceRate() {
+    double total = std::accumulate(trace.begin(), trace.end(), 0.0);
+    return total > 0 ? trace.size() * 1e6 / total : 0;
+}
+
 /**********
  * xferBench Utils
  **********/
@@ -558,3 +691,72 @@ void xferBenchUtils::printStats(bool is_target, size_t block_size, size_t batch_
                   << std::endl;
     }
 }
+
+void xferBenchUtils::printOpenLoopStatsHeader() {
+    std::cout << std::left << std::setw(20) << "Block Size (B)"
+              << std::setw(15) << "Batch Size"
+              << std::setw(18) << "Offered (Xfer/s)"
+              << std::setw(18) << "Achieved (Xfer/s)"
+              << std::setw(15) << "B/W (GB/Sec)";
+    if (IS_PAIRWISE_AND_SG() && rt->getSize() > 2) {
+        std::cout << std::setw(25) << "Aggregate B/W (GB/Sec)";
+    }
+    std::cout << std::setw(15) << "Avg Lat. (us)"
+              << std::setw(15) << "P50 Lat. (us)"
+              << std::setw(15) << "P99 Lat. (us)"
+              << std::setw(17) << "P99.9 Lat. (us)"
+              << std::setw(15) << "Max Lat. (us)"
+              << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+}
+
+// Latencies are measured from the intended issue time of each transfer, so the time a
+// transfer waited for a free slot while the system was saturated is included
+void xferBenchUtils::printOpenLoopStats(bool is_target, size_t block_size, size_t batch_size,
+                                        double offered_rate, double total_duration,
+                                        std::vector<double> &latencies) {
+    double throughput_gb = 0, totalbw = 0;
+
+    // Targets only take part in the reduction of the aggregate bandwidth
+    if (is_target) {
+        if (IS_PAIRWISE_AND_SG() && rt->getSize() > 2) {
+            rt->reduceSumDouble(&throughput_gb, &totalbw, 0);
+        }
+        return;
+    }
+
+    const size_t num_xfers = latencies.size();
+    const double achieved_rate = num_xfers / (total_duration / 1e6);
+    throughput_gb = (((double) block_size * batch_size * num_xfers / (1000 * 1000 * 1000)) /
+                     (total_duration / 1e6));   // In GB/Sec
+
+    if (IS_PAIRWISE_AND_SG() && rt->getSize() > 2) {
+        rt->reduceSumDouble(&throughput_gb, &totalbw, 0);
+    }
+
+    if (IS_PAIRWISE_AND_SG() && rt->getRank() != 0) {
+        return;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) {
+        return latencies[std::min(num_xfers - 1, size_t(p * num_xfers))];
+    };
+    const double avg_latency =
+        std::accumulate(latencies.begin(), latencies.end(), 0.0) / num_xfers;
+
+    std::cout << std::left << std::setw(20) << block_size
+              << std::setw(15) << batch_size
+              << std::setw(18) << offered_rate
+              << std::setw(18) << achieved_rate
+              << std::setw(15) << throughput_gb;
+    if (IS_PAIRWISE_AND_SG() && rt->getSize() > 2) {
+        std::cout << std::setw(25) << totalbw;
+    }
+    std::cout << std::setw(15) << avg_latency
+              << std::setw(15) << percentile(0.5)
+              << std::setw(15) << percentile(0.99)
+              << std::setw(17) << percentile(0.999)
+              << std::setw(15) << latencies.back()
+              << std::endl;
+}
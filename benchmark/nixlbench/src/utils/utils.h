@@ -25,6 +25,7 @@
 #include <variant>
 #include <vector>
 #include <optional>
+#include <random>
 #include "runtime/runtime.h"
 
 #if HAVE_CUDA
@@ -94,6 +95,10 @@
 #define XFERBENCH_SEG_TYPE_DRAM "DRAM"
 #define XFERBENCH_SEG_TYPE_VRAM "VRAM"
 
+// Arrival patterns of the open-loop mode
+#define XFERBENCH_ARRIVAL_POISSON "poisson"
+#define XFERBENCH_ARRIVAL_FIXED   "fixed"
+
 // Worker types
 #define XFERBENCH_WORKER_NIXL     "nixl"
 #define XFERBENCH_WORKER_NVSHMEM  "nvshmem"
@@ -134,6 +139,11 @@ class xferBenchConfig {
         static int gds_batch_pool_size;
         static int gds_batch_limit;
         static std::string gpunetio_device_list;
+        static std::vector<double> arrival_rates;
+        static std::string arrival_pattern;
+        static std::string arrival_trace;
+        static int max_inflight;
+        static bool completion_queue;
 
         static int loadFromFlags();
         static void printConfig();
@@ -142,6 +152,8 @@ class xferBenchConfig {
         static std::vector<std::string> parseDeviceList();
         static bool
         isStorageBackend();
+        static bool
+        isOpenLoop();
 };
 
 // Generic IOV descriptor class independent of NIXL
@@ -160,6 +172,27 @@ public:
         addr(a), len(l), devId(d), padded_size(p), handle(h) {}
 };
 
+// Intended issue times of an open-loop run, generated independently of the completions
+class xferBenchArrivals {
+    private:
+        static std::vector<double> trace; // Recorded inter-arrival times in us
+        std::mt19937_64 gen;
+        std::exponential_distribution<double> exp_dist;
+        double mean_gap;
+        double trace_scale;
+        size_t trace_pos;
+        double now;
+    public:
+        // Rate in transfers/sec, 0 replays the trace as recorded
+        xferBenchArrivals(double rate, unsigned int seed);
+
+        // Time of the next arrival in us from the start of the run
+        double next();
+
+        static int loadTrace(const std::string &path);
+        static double traceRate();
+};
+
 class xferBenchUtils {
     private:
         static xferBenchRT *rt;
@@ -173,6 +206,10 @@ class xferBenchUtils {
         static void printStatsHeader();
         static void printStats(bool is_target, size_t block_size, size_t batch_size,
 			                   double total_duration);
+        static void printOpenLoopStatsHeader();
+        static void printOpenLoopStats(bool is_target, size_t block_size, size_t batch_size,
+                                       double offered_rate, double total_duration,
+                                       std::vector<double> &latencies);
 };
 
 #endif // __UTILS_H
@@ -18,6 +18,7 @@
 #include "worker/nixl/nixl_worker.h"
 #include <algorithm>
 #include <cctype>
+#include <chrono>
 #include <cstring>
 #if HAVE_CUDA
 #include <cuda.h>
@@ -27,6 +28,7 @@
 #include <filesystem>
 #include <iomanip>
 #include <sstream>
+#include <unordered_map>
 #include "utils/utils.h"
 #include <unistd.h>
 #include <utility>
@@ -653,6 +655,42 @@ xferBenchNixlWorker::exchangeIOV(const std::vector<std::vector<xferBenchIOV>> &l
     return res;
 }
 
+static nixlXferReqH *createXferReq(nixlAgent *agent,
+                                   const std::vector<xferBenchIOV> &local_iov,
+                                   const std::vector<xferBenchIOV> &remote_iov,
+                                   const nixl_xfer_op_t op)
+{
+    // TODO: fetch local_desc and remote_desc directly from config
+    nixl_xfer_dlist_t local_desc(GET_SEG_TYPE(true));
+    nixl_xfer_dlist_t remote_desc(GET_SEG_TYPE(false));
+
+    if (xferBenchConfig::isStorageBackend()) {
+        remote_desc = nixl_xfer_dlist_t(FILE_SEG);
+    }
+
+    iovListToNixlXferDlist(local_iov, local_desc);
+    iovListToNixlXferDlist(remote_iov, remote_desc);
+
+    nixl_opt_args_t params;
+    nixlXferReqH *req;
+    std::string target;
+
+    if (xferBenchConfig::isStorageBackend()) {
+        target = "initiator";
+    } else if (XFERBENCH_BACKEND_MOONCAKE == xferBenchConfig::backend) {
+        params.hasNotif = false;
+        target = "target";
+    } else {
+        params.notifMsg = "0xBEEF";
+        params.hasNotif = true;
+        target = "target";
+    }
+
+    CHECK_NIXL_ERROR(agent->createXferReq(op, local_desc, remote_desc, target,
+                                        req, &params), "createTransferReq failed");
+    return req;
+}
+
 static int execTransfer(nixlAgent *agent,
                         const std::vector<std::vector<xferBenchIOV>> &local_iovs,
                         const std::vector<std::vector<xferBenchIOV>> &remote_iovs,
@@ -665,40 +703,9 @@ static int execTransfer(nixlAgent *agent,
     #pragma omp parallel num_threads(num_threads)
     {
         const int tid = omp_get_thread_num();
-        const auto &local_iov = local_iovs[tid];
-        const auto &remote_iov = remote_iovs[tid];
-
-        // TODO: fetch local_desc and remote_desc directly from config
-        nixl_xfer_dlist_t local_desc(GET_SEG_TYPE(true));
-        nixl_xfer_dlist_t remote_desc(GET_SEG_TYPE(false));
-
-        if (xferBenchConfig::isStorageBackend()) {
-            remote_desc = nixl_xfer_dlist_t(FILE_SEG);
-        }
-
-        iovListToNixlXferDlist(local_iov, local_desc);
-        iovListToNixlXferDlist(remote_iov, remote_desc);
-
-        nixl_opt_args_t params;
-        nixl_b_params_t b_params;
         bool error = false;
-        nixlXferReqH *req;
+        nixlXferReqH *req = createXferReq(agent, local_iovs[tid], remote_iovs[tid], op);
         nixl_status_t rc;
-        std::string target;
-
-        if (xferBenchConfig::isStorageBackend()) {
-            target = "initiator";
-        } else if (XFERBENCH_BACKEND_MOONCAKE == xferBenchConfig::backend) {
-            params.hasNotif = false;
-            target = "target";
-        } else {
-            params.notifMsg = "0xBEEF";
-            params.hasNotif = true;
-            target = "target";
-        }
-
-        CHECK_NIXL_ERROR(agent->createXferReq(op, local_desc, remote_desc, target,
-                                            req, &params), "createTransferReq failed");
 
         for (int i = 0; i < num_iter && !error; i++) {
             rc = agent->postXferReq(req);
@@ -728,6 +735,134 @@ static int execTransfer(nixlAgent *agent,
     return ret;
 }
 
+// Transfers arrive at their intended times whether or not earlier ones completed. An arrival
+// that finds all the requests of the thread in flight is posted once one completes, and the
+// wait is part of its latency.
+static int execTransferOpenLoop(nixlAgent *agent,
+                                const std::vector<std::vector<xferBenchIOV>> &local_iovs,
+                                const std::vector<std::vector<xferBenchIOV>> &remote_iovs,
+                                const nixl_xfer_op_t op,
+                                const int num_iter,
+                                const int num_threads,
+                                const double offered_rate,
+                                const int rank,
+                                std::vector<std::vector<double>> &latencies)
+{
+    int ret = 0;
+
+    #pragma omp parallel num_threads(num_threads)
+    {
+        const int tid = omp_get_thread_num();
+        std::vector<nixlXferReqH *> reqs;
+        std::vector<double> intended(xferBenchConfig::max_inflight);
+        std::vector<int> free_slots, active_slots;
+        bool error = false;
+
+        for (int i = 0; i < xferBenchConfig::max_inflight; i++) {
+            reqs.push_back(createXferReq(agent, local_iovs[tid], remote_iovs[tid], op));
+            free_slots.push_back(i);
+        }
+
+        // With a completion queue, every post completes through the queue, even the ones
+        // done within postXferReq
+        nixlComplQueueH *cq = nullptr;
+        std::unordered_map<nixlXferReqH *, int> req_slots;
+        std::vector<nixl_xfer_compl_t> compls;
+        if (xferBenchConfig::completion_queue) {
+            if (agent->createComplQueue(cq) != NIXL_SUCCESS) {
+                std::cout << "NIXL createComplQueue failed" << std::endl;
+                error = true;
+            }
+            for (int i = 0; i < xferBenchConfig::max_inflight && !error; i++) {
+                if (agent->bindXferReq(reqs[i], cq) != NIXL_SUCCESS) {
+                    std::cout << "NIXL bindXferReq failed" << std::endl;
+                    error = true;
+                }
+                req_slots[reqs[i]] = i;
+            }
+        }
+
+        // Threads of all processes draw different arrival sequences
+        xferBenchArrivals arrivals(offered_rate / num_threads, rank * num_threads + tid + 1);
+        double next_arrival = arrivals.next();
+        int issued = 0;
+        auto &thread_latencies = latencies[tid];
+
+        const auto start = std::chrono::steady_clock::now();
+        auto elapsed = [&start]() {
+            return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() -
+                                                             start).count();
+        };
+
+        while ((int)thread_latencies.size() < num_iter && !error) {
+            double now = elapsed();
+            while (issued < num_iter && next_arrival <= now && !free_slots.empty()) {
+                int slot = free_slots.back();
+                free_slots.pop_back();
+                nixl_status_t rc = agent->postXferReq(reqs[slot]);
+                if (rc < 0) {
+                    std::cout << "NIXL postRequest failed" << std::endl;
+                    error = true;
+                    break;
+                }
+
+                intended[slot] = next_arrival;
+                if (NIXL_SUCCESS == rc && !cq) {
+                    thread_latencies.push_back(elapsed() - intended[slot]);
+                    free_slots.push_back(slot);
+                } else if (!cq) {
+                    active_slots.push_back(slot);
+                }
+                issued++;
+                next_arrival = arrivals.next();
+            }
+
+            if (cq && !error) {
+                compls.clear();
+                agent->pollCompletions(cq, compls);
+                for (const auto &entry : compls) {
+                    if (entry.status < 0) {
+                        std::cout << "NIXL transfer failed" << std::endl;
+                        error = true;
+                        break;
+                    }
+                    int slot = req_slots[entry.req];
+                    thread_latencies.push_back(elapsed() - intended[slot]);
+                    free_slots.push_back(slot);
+                }
+            }
+
+            for (size_t i = 0; i < active_slots.size() && !error;) {
+                int slot = active_slots[i];
+                nixl_status_t rc = agent->getXferStatus(reqs[slot]);
+                if (rc < 0) {
+                    std::cout << "NIXL getStatus failed" << std::endl;
+                    error = true;
+                } else if (NIXL_SUCCESS == rc) {
+                    thread_latencies.push_back(elapsed() - intended[slot]);
+                    free_slots.push_back(slot);
+                    active_slots[i] = active_slots.back();
+                    active_slots.pop_back();
+                } else {
+                    i++;
+                }
+            }
+        }
+
+        if (cq) {
+            agent->releaseComplQueue(cq);
+        }
+        for (auto req : reqs) {
+            agent->releaseXferReq(req);
+        }
+        if (error) {
+            ret = -1;
+        }
+    }
+
+    return ret;
+}
+
 std::variant<double, int> xferBenchNixlWorker::transfer(size_t block_size,
                                                const std::vector<std::vector<xferBenchIOV>> &local_iovs,
                                                const std::vector<std::vector<xferBenchIOV>> &remote_iovs) {
@@ -765,6 +900,51 @@ std::variant<double, int> xferBenchNixlWorker::transfer(size_t block_size,
     return ret < 0 ? std::variant<double, int>(ret) : std::variant<double, int>(total_duration);
 }
 
+std::variant<double, int> xferBenchNixlWorker::transferOpenLoop(size_t block_size,
+                                               const std::vector<std::vector<xferBenchIOV>> &local_iovs,
+                                               const std::vector<std::vector<xferBenchIOV>> &remote_iovs,
+                                               double offered_rate,
+                                               std::vector<double> &latencies) {
+    int num_iter = xferBenchConfig::num_iter / xferBenchConfig::num_threads;
+    int skip = xferBenchConfig::warmup_iter / xferBenchConfig::num_threads;
+    struct timeval t_start, t_end;
+    double total_duration = 0.0;
+    int ret = 0;
+    nixl_xfer_op_t xfer_op = XFERBENCH_OP_READ == xferBenchConfig::op_type ? NIXL_READ : NIXL_WRITE;
+    std::vector<std::vector<double>> thread_latencies(xferBenchConfig::num_threads);
+
+    if (block_size > LARGE_BLOCK_SIZE) {
+        skip /= LARGE_BLOCK_SIZE_ITER_FACTOR;
+        num_iter /= LARGE_BLOCK_SIZE_ITER_FACTOR;
+    }
+
+    // Warmup is closed loop, the target counts its notifications the same way
+    ret = execTransfer(agent, local_iovs, remote_iovs, xfer_op, skip, xferBenchConfig::num_threads);
+    if (ret < 0) {
+        return std::variant<double, int>(ret);
+    }
+
+    synchronize();
+
+    gettimeofday(&t_start, nullptr);
+
+    ret = execTransferOpenLoop(agent, local_iovs, remote_iovs, xfer_op, num_iter,
+                               xferBenchConfig::num_threads, offered_rate, rt->getRank(),
+                               thread_latencies);
+
+    gettimeofday(&t_end, nullptr);
+    total_duration += (((t_end.tv_sec - t_start.tv_sec) * 1e6) +
+                       (t_end.tv_usec - t_start.tv_usec)); // In us
+
+    latencies.clear();
+    for (const auto &thread_latency : thread_latencies) {
+        latencies.insert(latencies.end(), thread_latency.begin(), thread_latency.end());
+    }
+
+    synchronize();
+    return ret < 0 ? std::variant<double, int>(ret) : std::variant<double, int>(total_duration);
+}
+
 void xferBenchNixlWorker::poll(size_t block_size) {
     nixl_notifs_t notifs;
     nixl_status_t status;
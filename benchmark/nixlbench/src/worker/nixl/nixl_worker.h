@@ -55,6 +55,11 @@ class xferBenchNixlWorker: public xferBenchWorker {
         std::variant<double, int> transfer(size_t block_size,
                                            const std::vector<std::vector<xferBenchIOV>> &local_iov_lists,
                                            const std::vector<std::vector<xferBenchIOV>> &remote_iov_lists) override;
+        std::variant<double, int> transferOpenLoop(size_t block_size,
+                                                   const std::vector<std::vector<xferBenchIOV>> &local_iov_lists,
+                                                   const std::vector<std::vector<xferBenchIOV>> &remote_iov_lists,
+                                                   double offered_rate,
+                                                   std::vector<double> &latencies) override;
 
     private:
         std::optional<xferBenchIOV> initBasicDescDram(size_t buffer_size, int mem_dev_id);
@@ -98,6 +98,16 @@ bool xferBenchWorker::isTarget() {
     return ("target" == name);
 }
 
+std::variant<double, int> xferBenchWorker::transferOpenLoop(size_t block_size,
+                                                           const std::vector<std::vector<xferBenchIOV>> &local_iov_lists,
+                                                           const std::vector<std::vector<xferBenchIOV>> &remote_iov_lists,
+                                                           double offered_rate,
+                                                           std::vector<double> &latencies) {
+    std::cerr << "Open-loop transfers are not supported by the " << xferBenchConfig::worker_type
+              << " worker" << std::endl;
+    return std::variant<double, int>(-1);
+}
+
 int xferBenchWorker::terminate = 0;
 
 void xferBenchWorker::signalHandler(int signal) {
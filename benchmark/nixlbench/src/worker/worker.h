@@ -58,6 +58,12 @@ class xferBenchWorker {
         virtual std::variant<double, int> transfer(size_t block_size,
                                                    const std::vector<std::vector<xferBenchIOV>> &local_iov_lists,
                                                    const std::vector<std::vector<xferBenchIOV>> &remote_iov_lists) = 0;
+        // Issues transfers at the offered rate, latencies are in us from the intended issue times
+        virtual std::variant<double, int> transferOpenLoop(size_t block_size,
+                                                           const std::vector<std::vector<xferBenchIOV>> &local_iov_lists,
+                                                           const std::vector<std::vector<xferBenchIOV>> &remote_iov_lists,
+                                                           double offered_rate,
+                                                           std::vector<double> &latencies);
 };
 
 #endif // __WORKER_H
@@ -33,6 +33,9 @@ struct nixlBackendOptionalArgs {
     nixl_blob_t notifMsg;
     bool        hasNotif = false;
     nixl_blob_t customParam;
+    // Element type conversion, only passed to backends that support conversions
+    nixl_xfer_conv_t conversion;
+    bool             hasConversion = false;
 };
 
 using nixl_opt_b_args_t = nixlBackendOptionalArgs;
@@ -17,12 +17,24 @@
 #ifndef __BACKEND_ENGINE_H
 #define __BACKEND_ENGINE_H
 
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
 #include "nixl_types.h"
 #include "backend_aux.h"
 
+// Handler for notifications as they arrive, returns true if it took the message, which is
+// then not returned by getNotifs. It can be called from the backend progress thread.
+using nixl_notif_handler_t = std::function<bool(const std::string &remote_agent,
+                                                nixl_blob_t &msg)>;
+
+// Handler for transfers completed by the backend, called once per post that returned
+// NIXL_IN_PROG with its final status. It can be called from the backend progress thread, and
+// before postXfer returns.
+using nixl_xfer_compl_handler_t = std::function<void(nixlBackendReqH *handle,
+                                                     nixl_status_t status)>;
+
 // Base backend engine class for different backend implementations
 class nixlBackendEngine {
     private:
@@ -83,11 +95,26 @@ class nixlBackendEngine {
         // pure virtual, and return errors, as parent shouldn't call if supportsNotif is false.
         virtual bool supportsNotif() const = 0;
 
+        // Determines if a backend supports compact notifications, in addition to string ones.
+        virtual bool supportsCompactNotif() const { return false; }
+
         // Determines if a backend supports progress thread.
         virtual bool supportsProgTh() const = 0;
 
+        // Determines if a backend applies the element type conversions of nixl_opt_b_args_t
+        // while transferring. Descriptor lengths then differ by the element size ratio.
+        virtual bool supportsConversion() const { return false; }
+
         virtual nixl_mem_list_t getSupportedMems() const = 0;  // TODO: Return by const-reference and mark noexcept?
 
+        // Determines if registerMem and deregisterMem of this memory type can be called
+        // concurrently from multiple threads. Otherwise NIXL serializes these calls.
+        virtual bool supportsParallelReg(const nixl_mem_t &nixl_mem) const { return false; }
+
+        // Length of a registration made with a zero length, for backends that resolve it when
+        // registering, e.g., to the end of a file. Zero leaves the registered range unbounded.
+        virtual size_t getRegLen(const nixlBackendMD* meta) const { return 0; }
+
 
         // *** Pure virtual methods that need to be implemented by any backend *** //
 
@@ -141,6 +168,24 @@ class nixlBackendEngine {
         // Use a handle to progress backend engine and see if a transfer is completed or not
         virtual nixl_status_t checkXfer(nixlBackendReqH* handle) const = 0;
 
+        // Check a batch of handles, possibly to different agents, in one call. Backends can
+        // override it to progress shared resources once for the whole batch.
+        virtual nixl_status_t checkXfers(const std::vector<nixlBackendReqH*> &handles,
+                                         std::vector<nixl_status_t> &status) const
+        {
+            status.resize(handles.size());
+            for (size_t i = 0; i < handles.size(); i++)
+                status[i] = checkXfer(handles[i]);
+            return NIXL_SUCCESS;
+        }
+
+        // Sets a handler called for each transfer as it completes, so that completion queues
+        // don't have to check it. It is set right after the engine is created, transfers of
+        // backends without it are checked through checkXfers by the completion queues.
+        virtual nixl_status_t setXferComplHandler(nixl_xfer_compl_handler_t handler) {
+            return NIXL_ERR_NOT_SUPPORTED;
+        }
+
         //Backend aborts the transfer if necessary, and destructs the relevant objects
         virtual nixl_status_t releaseReqH(nixlBackendReqH* handle) const = 0;
 
@@ -193,6 +238,27 @@ class nixlBackendEngine {
             return NIXL_ERR_BACKEND;
         }
 
+        // Sets a handler called for each received notification before it is queued. It is
+        // set right after the engine is created, before any connection is made.
+        virtual nixl_status_t setNotifHandler(nixl_notif_handler_t handler) {
+            return NIXL_ERR_NOT_SUPPORTED;
+        }
+
+
+        // *** Needs to be implemented if supportsCompactNotif() is true *** //
+
+        // Fill up to max_notifs received compact notifications, the rest stay in the backend.
+        virtual nixl_status_t getCompactNotifs(nixl_compact_notif_t* notifs, size_t max_notifs,
+                                               size_t &num_notifs) {
+            return NIXL_ERR_NOT_SUPPORTED;
+        }
+
+        // Generates a compact notification, len is at most compact_notif_max_payload.
+        virtual nixl_status_t genCompactNotif(const std::string &remote_agent, uint64_t tag,
+                                              const void* payload, size_t len) const {
+            return NIXL_ERR_NOT_SUPPORTED;
+        }
+
 
         // *** Needs to be implemented if supportsProgTh() is true *** //
 
@@ -24,6 +24,7 @@
 #include "nixl_types.h"
 #include "nixl_params.h"
 #include "nixl_descriptors.h"
+#include "nixl_layout.h"
 #include <chrono>
 #include <memory>
 
@@ -130,6 +131,60 @@ class nixlAgent {
         deregisterMem (const nixl_reg_dlist_t &descs,
                        const nixl_opt_args_t* extra_params = nullptr);
 
+        /**
+         * @brief  Asynchronous version of registerMem. Regions are registered by a pool of
+         *         registration threads, in parallel across backends, and across regions for
+         *         backends that support it. The agent is not locked during the backend calls,
+         *         and each region can be used in transfers as soon as it's registered. If a
+         *         region fails to register with a backend, the regions of this request already
+         *         registered with that backend are deregistered again.
+         *
+         * @param  descs          Descriptor list of the buffers to be registered
+         * @param  req_hndl [out] Registration request handle output
+         * @param  extra_params   Optional additional parameters used in registering memory
+         * @return nixl_status_t  Error code if call was not successful
+         */
+        nixl_status_t
+        registerMemAsync (const nixl_reg_dlist_t &descs,
+                          nixlRegReqH* &req_hndl,
+                          const nixl_opt_args_t* extra_params = nullptr);
+
+        /**
+         * @brief  Asynchronous version of deregisterMem. Regions are removed from the agent
+         *         before the call returns, so they can't be used in new transfers, and are
+         *         deregistered from the backends by the registration threads.
+         *
+         * @param  descs          Descriptor list of the buffers to be deregistered
+         * @param  req_hndl [out] Registration request handle output
+         * @param  extra_params   Optional additional parameters used in deregistering memory
+         * @return nixl_status_t  Error code if call was not successful
+         */
+        nixl_status_t
+        deregisterMemAsync (const nixl_reg_dlist_t &descs,
+                            nixlRegReqH* &req_hndl,
+                            const nixl_opt_args_t* extra_params = nullptr);
+
+        /**
+         * @brief  Check the status of an asynchronous registration or deregistration.
+         *         Returns NIXL_IN_PROG while regions are being processed, and the same
+         *         status as registerMem/deregisterMem after that.
+         *
+         * @param  req_hndl      Registration request handle
+         * @return nixl_status_t Status of the request
+         */
+        nixl_status_t
+        getRegStatus (nixlRegReqH* req_hndl) const;
+
+        /**
+         * @brief  Release a registration request handle, waiting for the request to complete
+         *         if it's still in progress.
+         *
+         * @param  req_hndl      Registration request handle to be released
+         * @return nixl_status_t Status of the request
+         */
+        nixl_status_t
+        releaseRegReq (nixlRegReqH* req_hndl) const;
+
         /**
          * @brief  Make connection proactively, instead of at the time of the first transfer
          *         towards the target agent. If a list of backends hints is provided
@@ -230,6 +285,31 @@ class nixlAgent {
                        nixlXferReqH* &req_hndl,
                        const nixl_opt_args_t* extra_params = nullptr) const;
 
+        /**
+         * @brief  Create a transfer request between two tensor layouts of the same shape,
+         *         where each element of `local_layout` is transferred to or from the element
+         *         with the same index in `remote_layout`. The layouts can be views obtained
+         *         through slice and permute, such as the heads of a KV cache that move to
+         *         another tensor parallel rank. The transfer is lowered to the contiguous
+         *         runs common to both layouts, instead of one descriptor per slice, and the
+         *         request is then used as one made by createXferReq.
+         *
+         * @param  operation      Operation for transfer (e.g., NIXL_WRITE)
+         * @param  local_layout   Local tensor layout
+         * @param  remote_layout  Remote tensor layout
+         * @param  remote_agent   Remote agent name for accessing the remote data
+         * @param  req_hndl [out] Transfer request handle output
+         * @param  extra_params   Optional extra parameters used in creating a transfer request
+         * @return nixl_status_t  Error code if call was not successful
+         */
+        nixl_status_t
+        createLayoutXferReq (const nixl_xfer_op_t &operation,
+                             const nixlTensorLayout &local_layout,
+                             const nixlTensorLayout &remote_layout,
+                             const std::string &remote_agent,
+                             nixlXferReqH* &req_hndl,
+                             const nixl_opt_args_t* extra_params = nullptr) const;
+
         /*** Operations on prepared Transfer Request ***/
 
         /**
@@ -306,13 +386,460 @@ class nixlAgent {
         releasedDlistH (nixlDlistH* dlist_hndl) const;
 
 
+        /*** Transfer Completion Queues ***/
+
+        /**
+         * @brief  Create a completion queue. Transfer requests bound to it are returned by
+         *         pollCompletions as they finish, so that many outstanding requests can be
+         *         tracked without checking each of them with getXferStatus.
+         *
+         * @param  cq_hndl [out] Completion queue handle
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        createComplQueue (nixlComplQueueH* &cq_hndl);
+
+        /**
+         * @brief  Bind a transfer request to a completion queue, or unbind it if `cq_hndl` is
+         *         nullptr. Each post of a bound request finishes with one completion in the
+         *         queue, including posts that complete or fail within postXferReq. A request
+         *         can't be bound or unbound while it is in progress.
+         *
+         * @param  req_hndl      Transfer request handle
+         * @param  cq_hndl       Completion queue handle, or nullptr
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        bindXferReq (nixlXferReqH* req_hndl,
+                     nixlComplQueueH* cq_hndl) const;
+
+        /**
+         * @brief  Append up to `max_compls` finished requests of a completion queue, with their
+         *         status, to `compls`. Backends with a progress thread report completions as
+         *         they happen; requests on the other backends are checked by this call, in one
+         *         batch per backend.
+         *
+         * @param  cq_hndl       Completion queue handle
+         * @param  compls        Output list of finished requests
+         * @param  max_compls    Maximum number of requests to return
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        pollCompletions (nixlComplQueueH* cq_hndl,
+                         std::vector<nixl_xfer_compl_t> &compls,
+                         size_t max_compls = SIZE_MAX) const;
+
+        /**
+         * @brief  Wait until a completion queue has finished requests to return, or until the
+         *         timeout expires.
+         *
+         * @param  cq_hndl       Completion queue handle
+         * @param  timeout       Maximum time to wait
+         * @return nixl_status_t NIXL_SUCCESS if requests finished, NIXL_IN_PROG on timeout
+         */
+        nixl_status_t
+        waitCompletions (nixlComplQueueH* cq_hndl,
+                         std::chrono::microseconds timeout) const;
+
+        /**
+         * @brief  Get an eventfd that is readable while a completion queue has finished
+         *         requests to return, e.g., to wait in an event loop. Requests on backends
+         *         without a progress thread are only found finished by pollCompletions and
+         *         waitCompletions, and don't make it readable.
+         *
+         * @param  cq_hndl       Completion queue handle
+         * @param  fd [out]      File descriptor, owned by the completion queue
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        getComplQueueFd (const nixlComplQueueH* cq_hndl,
+                         int &fd) const;
+
+        /**
+         * @brief  Release a completion queue. Requests still bound to it are unbound. It waits
+         *         for posts, binds and polls of other threads in progress, but must not be called
+         *         while another thread waits on the queue.
+         *
+         * @param  cq_hndl       Completion queue handle to be released
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        releaseComplQueue (nixlComplQueueH* cq_hndl);
+
+
+        /*** KV Block Directory ***/
+
+        /**
+         * @brief  Set the agents sharing the block directory, each of them being the shard
+         *         of part of the keys. All of them have to be given the same list, and have
+         *         the metadata of each other. Blocks published by this agent are moved to
+         *         their new shards, and entries this agent is no longer the shard of are
+         *         dropped.
+         *
+         * @param  agents        Names of the directory agents, possibly including this one
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        setDirMembers (const std::vector<std::string> &agents);
+
+        /**
+         * @brief  Publish blocks held by this agent in the directory, e.g., KV blocks by
+         *         the hash of their prefix. Key i is held in descs[i], which has to be
+         *         within registered memory. Blocks are unpublished when their memory is
+         *         deregistered, without waiting for the shards, and by the shards when the
+         *         metadata of this agent is invalidated there. Agents reading them have to
+         *         load the updated metadata of this agent to stop using them right away.
+         *         A key published again replaces its previous block.
+         *
+         * @param  keys          Keys of the blocks
+         * @param  descs         Descriptors of the blocks in local memory
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        publishBlocks (const std::vector<uint64_t> &keys,
+                       const nixl_xfer_dlist_t &descs);
+
+        /**
+         * @brief  Remove blocks published by this agent from the directory.
+         *
+         * @param  keys          Keys of the blocks
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        unpublishBlocks (const std::vector<uint64_t> &keys);
+
+        /**
+         * @brief  Look up blocks in the directory, sending one query per shard involved.
+         *         Shards answer queries within their getNotifs calls, and the answers are
+         *         received by getLookupStatus. The shards have to answer within
+         *         lookupTimeoutUs of extra_params.
+         *
+         * @param  keys          Keys of the blocks to find
+         * @param  lookup_hndl [out] Lookup handle
+         * @param  extra_params  Optional extra parameters used in looking up blocks
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        lookupBlocks (const std::vector<uint64_t> &keys,
+                      nixlDirLookupH* &lookup_hndl,
+                      const nixl_opt_args_t* extra_params = nullptr);
+
+        /**
+         * @brief  Check the status of a lookup, receiving the answers of the shards.
+         *
+         * @param  lookup_hndl   Lookup handle
+         * @return nixl_status_t NIXL_SUCCESS once all shards answered, NIXL_IN_PROG,
+         *                       NIXL_ERR_REMOTE_DISCONNECT if a shard did not answer in
+         *                       time, or error
+         */
+        nixl_status_t
+        getLookupStatus (nixlDirLookupH* lookup_hndl);
+
+        /**
+         * @brief  Get the blocks found by a completed lookup, grouped by agent and memory
+         *         type. Keys that were not found are left out, and if a key is held by
+         *         several agents, the one that published it last is returned. Blocks not
+         *         within the registered memory of their holder, per the metadata of the
+         *         holder loaded in this agent, are left out as well, since a shard may
+         *         answer before it received the unpublishing of a deregistered block.
+         *
+         * @param  lookup_hndl   Lookup handle
+         * @param  blocks [out]  Blocks found, ready to be used as remote descriptors
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        getLookupResults (const nixlDirLookupH* lookup_hndl,
+                          std::vector<nixl_dir_blocks_t> &blocks) const;
+
+        /**
+         * @brief  Release a lookup handle, answers still to come are dropped.
+         *
+         * @param  lookup_hndl   Lookup handle to be released
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        releaseLookup (nixlDirLookupH* lookup_hndl);
+
+
+        /*** Multi-peer Transfer Requests ***/
+
+        /**
+         * @brief  Create a transfer request whose remote descriptors span several agents, such
+         *         as scattering blocks to several peers or gathering them. `remote_agents` gives
+         *         the agent of each descriptor in `remote_descs`, descriptors are matched with
+         *         `local_descs` by index as in createXferReq. The request is tracked with a
+         *         single status, and each remote agent gets the notification, if requested
+         *         through extra_params, as soon as its own part of the transfer is done.
+         *
+         * @param  operation      Operation for transfer (e.g., NIXL_WRITE)
+         * @param  local_descs    Local descriptor list
+         * @param  remote_descs   Remote descriptor list
+         * @param  remote_agents  Remote agent of each descriptor in `remote_descs`
+         * @param  req_hndl [out] Multi-peer transfer request handle output
+         * @param  extra_params   Optional extra parameters used in creating the request
+         * @return nixl_status_t  Error code if call was not successful
+         */
+        nixl_status_t
+        createMultiXferReq (const nixl_xfer_op_t &operation,
+                            const nixl_xfer_dlist_t &local_descs,
+                            const nixl_xfer_dlist_t &remote_descs,
+                            const std::vector<std::string> &remote_agents,
+                            nixlMultiXferReqH* &req_hndl,
+                            const nixl_opt_args_t* extra_params = nullptr) const;
+
+        /**
+         * @brief  Post a multi-peer transfer request, see postXferReq. The notification can be
+         *         updated per re-post through extra_params.
+         *
+         * @param  req_hndl      Multi-peer transfer request handle
+         * @param  extra_params  Optional extra parameters used in posting the request
+         * @return nixl_status_t NIXL_IN_PROG or error code if call was not successful
+         */
+        nixl_status_t
+        postMultiXferReq (nixlMultiXferReqH* req_hndl,
+                          const nixl_opt_args_t* extra_params = nullptr) const;
+
+        /**
+         * @brief  Check the status of a multi-peer transfer request. The transfers to all the
+         *         agents are checked in one pass, with backend calls batched across agents.
+         *
+         * @param  req_hndl      Multi-peer transfer request handle after postMultiXferReq
+         * @return nixl_status_t NIXL_SUCCESS once all the agents are done, NIXL_IN_PROG,
+         *                       or the error of the first failed transfer
+         */
+        nixl_status_t
+        getMultiXferStatus (nixlMultiXferReqH* req_hndl) const;
+
+        /**
+         * @brief  Release a multi-peer transfer request, canceling the transfers in progress.
+         *
+         * @param  req_hndl      Multi-peer transfer request handle to be released
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        releaseMultiXferReq (nixlMultiXferReqH* req_hndl) const;
+
+        /*** Replicated Transfer Requests ***/
+
+        /**
+         * @brief  Create a transfer request whose remote side is replicated, as the copies of
+         *         the same blocks on redundant storage or on several peers. Each entry of
+         *         `remote_descs` is matched with `local_descs` as in createXferReq, at the
+         *         agent of the same index in `remote_agents`. A read is posted to the first
+         *         source, and hedged to the next one each time hedgeDelayUs of extra_params
+         *         passes without a completion, or a percentile of the previous latencies of
+         *         the first source when it is 0. A read is also posted to the next source
+         *         right away when a source fails. The first read to complete wins. Reads
+         *         into DRAM from several sources go through a staging buffer per source,
+         *         registered with the agent, and only the winner is copied to the local
+         *         buffers. The other reads finish into their staging buffers, and their
+         *         sources are skipped by later posts until then. Reads into other memory
+         *         types complete once all their posted reads are done, as those write to
+         *         the local buffers. A write is posted to all targets and is done once
+         *         writeQuorum of them have completed, the others are left to finish.
+         *
+         * @param  operation      Operation for transfer (e.g., NIXL_READ)
+         * @param  local_descs    Local descriptor list
+         * @param  remote_descs   Remote descriptor list of each source or target
+         * @param  remote_agents  Remote agent of each entry in `remote_descs`
+         * @param  req_hndl [out] Replicated transfer request handle output
+         * @param  extra_params   Optional extra parameters used in creating the request
+         * @return nixl_status_t  Error code if call was not successful
+         */
+        nixl_status_t
+        createReplicaXferReq (const nixl_xfer_op_t &operation,
+                              const nixl_xfer_dlist_t &local_descs,
+                              const std::vector<nixl_xfer_dlist_t> &remote_descs,
+                              const std::vector<std::string> &remote_agents,
+                              nixlReplicaXferReqH* &req_hndl,
+                              const nixl_opt_args_t* extra_params = nullptr);
+
+        /**
+         * @brief  Post a replicated transfer request. Writes still in progress from the
+         *         previous post, after their quorum was reached, must be done first.
+         *
+         * @param  req_hndl      Replicated transfer request handle
+         * @return nixl_status_t NIXL_SUCCESS, NIXL_IN_PROG or error code if call was not successful
+         */
+        nixl_status_t
+        postReplicaXferReq (nixlReplicaXferReqH* req_hndl) const;
+
+        /**
+         * @brief  Check the status of a replicated transfer request, posting the hedged reads
+         *         that are due. Writes still in progress after their quorum was reached are
+         *         progressed by this call as well.
+         *
+         * @param  req_hndl      Replicated transfer request handle after postReplicaXferReq
+         * @return nixl_status_t NIXL_SUCCESS once a read completed or a write reached its
+         *                       quorum, NIXL_IN_PROG, or the error of the last failed
+         *                       transfer once the request can't succeed anymore
+         */
+        nixl_status_t
+        getReplicaXferStatus (nixlReplicaXferReqH* req_hndl) const;
+
+        /**
+         * @brief  Get the source a replicated read completed from.
+         *
+         * @param  req_hndl      Replicated read request handle, after it completed
+         * @param  source [out]  Index of the source in `remote_agents`
+         * @return nixl_status_t Error code if the request is not a completed read
+         */
+        nixl_status_t
+        getReplicaXferSource (const nixlReplicaXferReqH* req_hndl, size_t &source) const;
+
+        /**
+         * @brief  Release a replicated transfer request, canceling the transfers in progress.
+         *         Staged reads still in progress write to their staging buffers until done,
+         *         they are released along with their buffers by later calls creating or
+         *         releasing replicated requests, or with the agent.
+         *
+         * @param  req_hndl      Replicated transfer request handle to be released
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        releaseReplicaXferReq (nixlReplicaXferReqH* req_hndl);
+
+        /*** Transfer Graphs ***/
+
+        /**
+         * @brief  Create an empty transfer graph. A transfer graph groups prepared transfer
+         *         requests with dependencies between them. Once the graph is posted, the agent
+         *         posts each request as soon as all the requests it depends on have completed,
+         *         and the whole graph is tracked through a single handle. If the agent has
+         *         its progress thread enabled, graphs are executed by the agent in background,
+         *         otherwise they are progressed within getXferGraphStatus calls.
+         *
+         * @param  graph_hndl [out] Transfer graph handle output
+         * @return nixl_status_t    Error code if call was not successful
+         */
+        nixl_status_t
+        createXferGraph (nixlXferGraphH* &graph_hndl) const;
+
+        /**
+         * @brief  Add a transfer request to a graph, to be posted after all the requests in
+         *         `deps` have completed. Dependencies must have been added to the graph before,
+         *         a request can have several dependencies (fan-in) and be a dependency of
+         *         several requests (fan-out). Requests are posted with the notification set at
+         *         their creation, they must not be posted, reposted or released by the user
+         *         while the graph is in progress, and are not released along with the graph.
+         *
+         * @param  graph_hndl    Transfer graph handle
+         * @param  req_hndl      Transfer request handle obtained from makeXferReq/createXferReq
+         * @param  deps          Requests of the graph that must complete before this one
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        addXferGraphNode (nixlXferGraphH* graph_hndl,
+                          nixlXferReqH* req_hndl,
+                          const std::vector<nixlXferReqH*> &deps = {}) const;
+
+        /**
+         * @brief  Post a transfer graph, starting with the requests without dependencies.
+         *         A completed graph can be posted again, which reposts all its requests.
+         *
+         * @param  graph_hndl    Transfer graph handle
+         * @return nixl_status_t NIXL_IN_PROG, NIXL_SUCCESS if all requests completed within
+         *                       the call, or error code if call was not successful
+         */
+        nixl_status_t
+        postXferGraph (nixlXferGraphH* graph_hndl) const;
+
+        /**
+         * @brief  Check the status of a transfer graph. The graph is NIXL_IN_PROG until all
+         *         of its requests completed, or reports the error of the first failed request,
+         *         in which case its dependent requests are not posted.
+         *
+         * @param  graph_hndl    Transfer graph handle after postXferGraph
+         * @return nixl_status_t NIXL_IN_PROG or error code if call was not successful
+         */
+        nixl_status_t
+        getXferGraphStatus (nixlXferGraphH* graph_hndl) const;
+
+        /**
+         * @brief  Release a transfer graph. If the graph is in progress, no further requests
+         *         are posted, requests already in flight can be canceled by releasing them.
+         *
+         * @param  graph_hndl    Transfer graph handle to be released
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        releaseXferGraph (nixlXferGraphH* graph_hndl) const;
+
+
+        /*** Broadcast ***/
+
+        /**
+         * @brief  Create a request to broadcast a local buffer to the same sized buffers of
+         *         several remote agents. Instead of writing the whole buffer to every agent,
+         *         the agents are arranged in a chain (or a tree, based on bcastFanout in
+         *         extra_params) and the buffer is sent in chunks of bcastChunkSize: this agent
+         *         only writes to its children, and each receiver relays every chunk to its own
+         *         children as soon as the chunk arrives. Receivers relay within getNotifs or
+         *         getSubNotifs, so all of them must keep calling one of them during the
+         *         broadcast, and must have loaded the metadata of the agents they relay to.
+         *         Once a receiver has the whole buffer, it gets notifMsg of extra_params as a
+         *         notification from this agent. The remote buffers are in the order of the
+         *         schedule, a chain goes through `remote_agents` in order.
+         *
+         * @param  local_descs    Local buffer to broadcast, as a single descriptor
+         * @param  remote_agents  Receiving agents, each must appear only once
+         * @param  remote_descs   Buffer at each receiving agent, as a single descriptor
+         * @param  req_hndl [out] Broadcast request handle output
+         * @param  extra_params   Optional extra parameters used in creating the broadcast
+         * @return nixl_status_t  Error code if call was not successful
+         */
+        nixl_status_t
+        createBcastReq (const nixl_xfer_dlist_t &local_descs,
+                        const std::vector<std::string> &remote_agents,
+                        const std::vector<nixl_xfer_dlist_t> &remote_descs,
+                        nixlBcastReqH* &req_hndl,
+                        const nixl_opt_args_t* extra_params = nullptr) const;
+
+        /**
+         * @brief  Post a broadcast request. A completed broadcast can be posted again.
+         *
+         * @param  req_hndl      Broadcast request handle obtained from createBcastReq
+         * @return nixl_status_t NIXL_IN_PROG, NIXL_SUCCESS or error code if call was not successful
+         */
+        nixl_status_t
+        postBcastReq (nixlBcastReqH* req_hndl) const;
+
+        /**
+         * @brief  Check the status of a broadcast request. Every receiver reports the status
+         *         of its subtree to the agent it got the chunks from, so the request completes
+         *         once all receivers have the whole buffer, and fails if a relay failed
+         *         anywhere in the schedule. The reports arrive as notifications, which are
+         *         drained here, other notifications drained along are kept for getNotifs.
+         *
+         * @param  req_hndl      Broadcast request handle after postBcastReq
+         * @return nixl_status_t NIXL_IN_PROG or error code if call was not successful
+         */
+        nixl_status_t
+        getBcastStatus (nixlBcastReqH* req_hndl) const;
+
+        /**
+         * @brief  Release a broadcast request, canceling the transfers of this agent if the
+         *         broadcast is in progress.
+         *
+         * @param  req_hndl      Broadcast request handle to be released
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        releaseBcastReq (nixlBcastReqH* req_hndl) const;
+
+
         /*** Notification Handling ***/
 
         /**
          * @brief  Add entries to the input notifications list (can be non-empty), which is a map
          *         from agent name to a list of notification received from that agent. Elements
          *         are released within the agent after this call. Optionally, a list of backends
-         *         can be mentioned in extra_params to only get those backends notifications.
+         *         can be mentioned in extra_params to only get those backends notifications,
+         *         notifications of unsubscribed prefixes and completed broadcasts are then
+         *         left for a call on all backends. The notifications drained by this call
+         *         are all returned. While subscriptions are active, notifications drained by
+         *         other calls and not retrieved yet are kept up to a bound per backend,
+         *         beyond which the oldest are dropped.
          *
          * @param  notif_map     Input notifications list
          * @param  extra_params  Optional extra parameters used in getting notifications
@@ -339,6 +866,82 @@ class nixlAgent {
                   const nixl_blob_t &msg,
                   const nixl_opt_args_t* extra_params = nullptr) const;
 
+        /**
+         * @brief  Get received compact notifications into a caller provided array. Up to
+         *         max_notifs notifications are returned, the rest are kept for the next call.
+         *         Compact notifications are not returned by getNotifs. Optionally, a list of
+         *         backends can be mentioned in extra_params to only get their notifications.
+         *
+         * @param  notifs        Array of at least max_notifs notifications to fill
+         * @param  max_notifs    Size of the notifs array
+         * @param  num_notifs    [out] Number of notifications filled
+         * @param  extra_params  Optional extra parameters used in getting notifications
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        getCompactNotifs (nixl_compact_notif_t* notifs,
+                          size_t max_notifs,
+                          size_t &num_notifs,
+                          const nixl_opt_args_t* extra_params = nullptr);
+
+        /**
+         * @brief  Generate a compact notification, a 64-bit tag with an optional payload of
+         *         up to compact_notif_max_payload bytes, received by getCompactNotifs.
+         *         Metadata of remote agent should be available before this call. Optionally,
+         *         a backend can be specified for the notification through the extra_params.
+         *
+         * @param  remote_agent  Remote agent name as string
+         * @param  tag           Tag of the notification
+         * @param  payload       Optional payload of the notification
+         * @param  len           Size of the payload
+         * @param  extra_params  Optional extra parameters used in generating the notification
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        genCompactNotif (const std::string &remote_agent,
+                         uint64_t tag,
+                         const void* payload = nullptr,
+                         size_t len = 0,
+                         const nixl_opt_args_t* extra_params = nullptr) const;
+
+        /**
+         * @brief  Subscribe to notifications starting with a prefix, e.g., one per request
+         *         stream, to receive them in a queue of their own through getSubNotifs.
+         *         A notification goes to the subscription with the longest matching prefix,
+         *         an empty prefix matches all notifications. Notifications that match no
+         *         subscription are received by getNotifs.
+         *
+         * @param  prefix        Prefix of the notification messages
+         * @param  sub_hndl [out] Subscription handle
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        subscribeNotifs (const nixl_blob_t &prefix,
+                         nixlNotifSubH* &sub_hndl);
+
+        /**
+         * @brief  Add the notifications received by a subscription to the input notifications
+         *         list, as in getNotifs. Subscriptions are served by separate queues, so
+         *         threads with different subscriptions can call this concurrently.
+         *
+         * @param  sub_hndl      Subscription handle
+         * @param  notif_map     Input notifications list
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        getSubNotifs (nixlNotifSubH* sub_hndl,
+                      nixl_notifs_t &notif_map);
+
+        /**
+         * @brief  Remove a subscription and release its handle. Notifications left in its
+         *         queue are received by getNotifs.
+         *
+         * @param  sub_hndl      Subscription handle to be released
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        unsubscribeNotifs (nixlNotifSubH* sub_hndl);
+
         /*** Metadata handling through side channel ***/
         /**
          * @brief  Get metadata blob for this agent, to be given to other agents.
@@ -392,7 +995,7 @@ class nixlAgent {
         nixl_status_t
         invalidateRemoteMD (const std::string &remote_agent);
 
-        /*** Metadata handling through direct channels (p2p socket and ETCD) ***/
+        /*** Metadata handling through direct channels (p2p socket, metadata server and ETCD) ***/
         /**
          * @brief  Send your own agent metadata to a remote location.
          *
@@ -436,7 +1039,7 @@ class nixlAgent {
          *         is supported. When fetching from a central metadata server, the metadataLabel
          *         can be specified to fetch partial metadata.
          *
-         * @param  remote_name   Name of remote agent to fetch from ETCD or socket.
+         * @param  remote_name   Name of remote agent to fetch from metadata server, ETCD or socket.
          * @param  extra_params  Only to optionally specify IP address and/or port.
          *                       If IP is specified, this will enable peer to peer fetching of metadata.
          *                       If IP is unspecified, this will fetch from the metadata server.
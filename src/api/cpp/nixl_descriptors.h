@@ -345,4 +345,21 @@ using nixl_xfer_dlist_t = nixlDescList<nixlBasicDesc>;
  */
 using nixl_reg_dlist_t = nixlDescList<nixlBlobDesc>;
 
+/**
+ * @struct nixl_dir_blocks_t
+ * @brief  Blocks found by a directory lookup in one memory type of one agent. Key i is
+ *         held in descs[i], which can be used as remote descriptors towards that agent.
+ */
+struct nixl_dir_blocks_t {
+    /** @var Name of the agent holding the blocks */
+    std::string           agent;
+    /** @var Keys of the blocks, in the order they were looked up */
+    std::vector<uint64_t> keys;
+    /** @var Descriptors of the blocks in the memory of the agent */
+    nixl_xfer_dlist_t     descs;
+
+    nixl_dir_blocks_t(const std::string &agent, nixl_mem_t mem_type)
+        : agent(agent), descs(mem_type) { }
+};
+
 #endif
@@ -0,0 +1,124 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _NIXL_LAYOUT_H
+#define _NIXL_LAYOUT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "nixl_types.h"
+#include "nixl_descriptors.h"
+
+/**
+ * @class nixlTensorLayout
+ * @brief Describes a strided tensor in a memory region, by its shape and the stride in
+ *        bytes of each dimension. Views of the tensor can be derived with slice and
+ *        permute, and two layouts of the same shape define a transfer between them,
+ *        where element (i0, ..., in) of the source is moved to (i0, ..., in) of the
+ *        destination. For instance, re-sharding a KV cache along the head dimension
+ *        between different tensor parallel degrees slices the heads of the larger
+ *        tensor, and transfers that view to the smaller one.
+ */
+class nixlTensorLayout {
+    public:
+        /** @var Address of the first element */
+        uintptr_t           addr     = 0;
+        /** @var deviceID/blockID/fileID of the region */
+        uint64_t            devId    = 0;
+        /** @var NIXL memory type of the region */
+        nixl_mem_t          memType  = DRAM_SEG;
+        /** @var Element size in bytes */
+        size_t              elemSize = 0;
+        /** @var Number of elements in each dimension */
+        std::vector<size_t> shape;
+        /** @var Distance in bytes between consecutive elements of each dimension */
+        std::vector<size_t> strides;
+
+        /**
+         * @brief Default constructor for an empty layout
+         */
+        nixlTensorLayout() { }
+        /**
+         * @brief Parametrized constructor for nixlTensorLayout
+         *
+         * @param addr      Address of the first element
+         * @param dev_id    deviceID/blockID/fileID
+         * @param mem_type  NIXL memory type
+         * @param elem_size Element size in bytes
+         * @param shape     Number of elements in each dimension
+         * @param strides   Strides in bytes, defaults to a contiguous row-major tensor
+         */
+        nixlTensorLayout(uintptr_t addr,
+                         uint64_t dev_id,
+                         nixl_mem_t mem_type,
+                         size_t elem_size,
+                         const std::vector<size_t> &shape,
+                         const std::vector<size_t> &strides = {});
+
+        /**
+         * @brief Total number of elements in the tensor
+         */
+        size_t numElems() const;
+
+        /**
+         * @brief View of the elements [start, start + len) along dimension `dim`
+         *
+         * @param  dim   Dimension to slice
+         * @param  start First index kept
+         * @param  len   Number of indices kept
+         * @return nixl_status_t Error code if slice is out of bounds
+         */
+        nixl_status_t slice(size_t dim, size_t start, size_t len, nixlTensorLayout &out) const;
+
+        /**
+         * @brief View with reordered dimensions, dimension `d` of the result is
+         *        dimension `perm[d]` of this layout
+         *
+         * @param  perm  Permutation of the dimensions
+         * @return nixl_status_t Error code if `perm` is not a permutation
+         */
+        nixl_status_t permute(const std::vector<size_t> &perm, nixlTensorLayout &out) const;
+
+        /**
+         * @brief Lower a transfer from `src` to `dst` into pairs of contiguous descriptors.
+         *        Dimensions are reordered and merged where both layouts are contiguous, so
+         *        the number of descriptors is the number of contiguous runs common to both
+         *        layouts, rather than one per slice.
+         *
+         * @param  src       Source layout
+         * @param  dst       Destination layout, with the same shape and element size
+         * @param  src_descs [out] Source descriptors, appended to
+         * @param  dst_descs [out] Destination descriptors, appended to
+         * @return nixl_status_t Error code if the layouts don't match
+         */
+        static nixl_status_t toDescs(const nixlTensorLayout &src,
+                                     const nixlTensorLayout &dst,
+                                     nixl_xfer_dlist_t &src_descs,
+                                     nixl_xfer_dlist_t &dst_descs);
+
+        /**
+         * @brief Reference implementation of the transfer from `src` to `dst`, for layouts
+         *        that are both in local DRAM.
+         *
+         * @param  src  Source layout
+         * @param  dst  Destination layout
+         * @return nixl_status_t Error code if the layouts don't match or are not in DRAM
+         */
+        static nixl_status_t copy(const nixlTensorLayout &src, const nixlTensorLayout &dst);
+};
+
+#endif
@@ -0,0 +1,97 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/**
+ * @file nixl_md_server.h
+ * @brief Built-in metadata server, an alternative to etcd for metadata exchange
+ */
+#ifndef _NIXL_MD_SERVER_H
+#define _NIXL_MD_SERVER_H
+
+#include "nixl_types.h"
+#include <memory>
+#include <string>
+
+/**
+ * @brief A constant to define the default port of the metadata server.
+ */
+constexpr int default_md_server_port = 8889;
+
+/**
+ * @brief A constant to define the default address the metadata server listens on.
+ */
+constexpr const char *default_md_server_addr = "127.0.0.1";
+
+class nixlMDServerData;
+
+/**
+ * @class nixlMDServer
+ * @brief In-memory metadata server for agents that have NIXL_MD_SERVER set to its
+ *        "<IPv4 address>[:<port>]". Agents keep a connection to the server, and
+ *        sendLocalMD, sendLocalPartialMD, fetchRemoteMD and invalidateLocalMD without an IP
+ *        address go through it. Fetched metadata is pushed again to the fetching agents when
+ *        it is updated or invalidated, and fetches issued together are sent as one batch.
+ *        The server can run in the nixl_md_server binary or in any process of the job.
+ *        A connection can only publish and invalidate the metadata of the first agent
+ *        it published or invalidated as.
+ */
+class nixlMDServer {
+    private:
+        /** @var  data  The members of the server wrapped into single nixlMDServerData member. */
+        std::unique_ptr<nixlMDServerData> data;
+
+    public:
+        /**
+         * @brief Constructor for nixlMDServer, the server starts listening in start().
+         *
+         * @param port     TCP port to listen on, 0 to pick a free port
+         * @param ip_addr  IPv4 address to listen on, the loopback address by default
+         */
+        nixlMDServer (const int port = default_md_server_port,
+                      const std::string &ip_addr = default_md_server_addr);
+        /**
+         * @brief Destructor for nixlMDServer object, stops the server
+         */
+        ~nixlMDServer ();
+
+        nixlMDServer(nixlMDServer&&) noexcept = delete;
+        nixlMDServer &operator=(nixlMDServer&&) noexcept = delete;
+
+        /**
+         * @brief  Listen on the address and port and serve agents from a thread of the server.
+         *
+         * @return nixl_status_t Error code if call was not successful
+         */
+        nixl_status_t
+        start ();
+
+        /**
+         * @brief  Stop serving and close the connections of the agents. The stored metadata
+         *         is dropped, agents publish theirs again when they reconnect to a server.
+         */
+        void
+        stop ();
+
+        /**
+         * @brief  Get the port the server listens on, once started.
+         *
+         * @return int Port number
+         */
+        int
+        getPort () const;
+};
+
+#endif
@@ -52,6 +52,12 @@ class nixlAgentConfig {
          *      These will be combined into a unified NIXL Thread API in a future version.
          */
         uint64_t lthrDelay;
+        /**
+         * @var Number of threads used by registerMemAsync and deregisterMemAsync.
+         *      Threads are started on the first asynchronous registration, 0 uses
+         *      the number of hardware threads.
+         */
+        unsigned int regThreads = 0;
 
 
         /**
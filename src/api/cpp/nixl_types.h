@@ -16,8 +16,10 @@
  */
 #ifndef _NIXL_TYPES_H
 #define _NIXL_TYPES_H
+#include <cstdint>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 
@@ -26,6 +28,14 @@ class nixlSerDes;
 class nixlDlistH;
 class nixlBackendH;
 class nixlXferReqH;
+class nixlMultiXferReqH;
+class nixlReplicaXferReqH;
+class nixlXferGraphH;
+class nixlBcastReqH;
+class nixlRegReqH;
+class nixlNotifSubH;
+class nixlComplQueueH;
+class nixlDirLookupH;
 class nixlAgentData;
 
 
@@ -118,6 +128,55 @@ using nixl_b_params_t = std::unordered_map<std::string, std::string>;
  */
 using nixl_notifs_t = std::unordered_map<std::string, std::vector<nixl_blob_t>>;
 
+/**
+ * @brief A constant to define the maximum payload size of a compact notification.
+ */
+constexpr size_t compact_notif_max_payload = 40;
+
+/**
+ * @struct nixl_compact_notif_t
+ * @brief  A fixed size binary notification, with a 64-bit tag and a small inline payload.
+ *         Compact notifications are received separately from string notifications, into
+ *         arrays of this type, so that frequent small signals cost no allocations.
+ */
+struct nixl_compact_notif_t {
+    /**
+     * @var agent Name of the sending agent, valid as long as the receiving backend exists
+     */
+    std::string_view agent;
+
+    /**
+     * @var tag User defined tag of the notification
+     */
+    uint64_t tag = 0;
+
+    /**
+     * @var len Number of valid bytes in payload
+     */
+    uint32_t len = 0;
+
+    /**
+     * @var payload Inline payload of the notification
+     */
+    uint8_t payload[compact_notif_max_payload];
+};
+
+/**
+ * @struct nixl_xfer_compl_t
+ * @brief  A finished transfer request returned by pollCompletions, with its final status.
+ */
+struct nixl_xfer_compl_t {
+    /**
+     * @var req Transfer request handle bound to the completion queue
+     */
+    nixlXferReqH* req = nullptr;
+
+    /**
+     * @var status NIXL_SUCCESS, or the error the transfer failed with
+     */
+    nixl_status_t status = NIXL_SUCCESS;
+};
+
 /**
  * @brief A constant to define the default communication port.
  */
@@ -144,6 +203,59 @@ enum class nixl_cost_t {
     ANALYTICAL_BACKEND = 0, // Analytical backend cost estimate
 };
 
+/**
+ * @enum  nixl_dtype_t
+ * @brief Element types a transfer can convert between, see nixl_xfer_conv_t.
+ *        The FP8 types are the OCP E4M3 (finite only) and E5M2 formats.
+ */
+enum nixl_dtype_t {
+    NIXL_DTYPE_BF16,
+    NIXL_DTYPE_FP16,
+    NIXL_DTYPE_FP8_E4M3,
+    NIXL_DTYPE_FP8_E5M2,
+};
+
+/**
+ * @enum  nixl_scale_mode_t
+ * @brief Scaling applied by a transfer conversion. With NIXL_SCALE_FIXED, values are
+ *        divided by the scale when converted to the remote type, and multiplied by it
+ *        when converted back to the local type.
+ */
+enum nixl_scale_mode_t {
+    NIXL_SCALE_NONE,
+    NIXL_SCALE_FIXED,
+};
+
+/**
+ * @struct nixl_xfer_conv_t
+ * @brief  Element type conversion of a transfer. The local descriptors hold elements of
+ *         localType, BF16 or FP16, and the remote ones elements of remoteType, one of the
+ *         FP8 types, in the same number. Writes
+ *         convert from the local to the remote type, and reads back. Values out of the
+ *         range of the destination type saturate to its largest finite value.
+ */
+struct nixl_xfer_conv_t {
+    /**
+     * @var localType Element type of the local descriptors
+     */
+    nixl_dtype_t localType = NIXL_DTYPE_BF16;
+
+    /**
+     * @var remoteType Element type of the remote descriptors
+     */
+    nixl_dtype_t remoteType = NIXL_DTYPE_FP8_E4M3;
+
+    /**
+     * @var scaleMode Scaling applied with the conversion
+     */
+    nixl_scale_mode_t scaleMode = NIXL_SCALE_NONE;
+
+    /**
+     * @var scale Scale of NIXL_SCALE_FIXED, e.g., the per tensor scale of an FP8 KV cache
+     */
+    float scale = 1.0f;
+};
+
 /**
  * @struct nixlAgentOptionalArgs
  * @brief A structure for optional argument that can be provided to relevant agent methods.
@@ -193,8 +305,8 @@ struct nixlAgentOptionalArgs {
 
     /**
      * @var metadataLabel Used to specify the label of the metadata to be sent/fetched
-     *                    when working with ETCD metadata server. The label will be appended to the
-     *                    agent's key prefix, and the full key will be used to store/fetch
+     *                    when working with the built-in or ETCD metadata server. The label
+     *                    will be appended to the agent's key prefix, and the full key will be used to store/fetch
      *                    the metadata key-value pair from the server.
      *                    Used in fetchRemoteMD, sendLocalPartialMD.
      *                    Note that sendLocalMD always uses default_metadata_label and ignores this parameter.
@@ -202,6 +314,57 @@ struct nixlAgentOptionalArgs {
      */
     std::string metadataLabel;
 
+    /**
+     * @var bcastChunkSize Size of the chunks a broadcast buffer is split into, used in
+     *                     createBcastReq. Receivers relay each chunk onwards as soon as it
+     *                     arrives, smaller chunks start the relays earlier. 0 selects a default.
+     */
+    size_t bcastChunkSize = 0;
+
+    /**
+     * @var bcastFanout Number of agents each participant of a broadcast sends to, used in
+     *                  createBcastReq. 1 builds a chain, larger values build a tree.
+     */
+    unsigned bcastFanout = 1;
+
+    /**
+     * @var conversion Element type conversion applied by the backend while transferring,
+     *                 used in createXferReq when hasConversion is set. Only backends that
+     *                 support conversions are considered, e.g., POSIX. prepXferDlist and
+     *                 makeXferReq reject it.
+     */
+    nixl_xfer_conv_t conversion;
+
+    /**
+     * @var hasConversion boolean value to indicate that a conversion is provided.
+     */
+    bool hasConversion = false;
+
+    /**
+     * @var hedgeDelayUs Time in microseconds after which a replicated read is also posted
+     *                   to its next source, used in createReplicaXferReq. 0 derives the delay
+     *                   from the latencies of the previous reads of the first source.
+     */
+    uint64_t hedgeDelayUs = 0;
+
+    /**
+     * @var hedgePercentile Percentile of the previous read latencies of a source after which
+     *                      a read is hedged, when hedgeDelayUs is 0. Between 0 and 1.
+     */
+    double hedgePercentile = 0.95;
+
+    /**
+     * @var writeQuorum Number of targets a replicated write must complete on before it is
+     *                  reported as done, used in createReplicaXferReq. 0 waits for all targets.
+     */
+    size_t writeQuorum = 0;
+
+    /**
+     * @var lookupTimeoutUs Time in microseconds the directory shards have to answer a
+     *                      lookup in, used in lookupBlocks. 0 selects a default of 5 seconds.
+     */
+    uint64_t lookupTimeoutUs = 0;
+
     /**
      * @var Backend custom parameter
      */
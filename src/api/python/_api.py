@@ -14,6 +14,7 @@
 # limitations under the License.
 
 import pickle
+import threading
 from typing import Optional, Union
 
 import numpy as np
@@ -34,6 +35,9 @@ nixl_xfer_handle = int
 @param enable_prog_thread Whether to enable the progress thread, if available.
 @param enable_listen_thread Whether to enable the listener thread for metadata communication.
 @param listen_port Specify the port for the listener thread to listen on.
+@param thread_safe Whether the agent can be used from multiple Python threads concurrently.
+        The bindings release the GIL during NIXL calls, so even on GIL builds an agent that
+        is not thread safe must only be used by one Python thread at a time. Defaults to True.
 
 @param backends List of backend names for agent to initialize.
         Default is UCX, other backends can be added to the list, or after
@@ -48,12 +52,14 @@ class nixl_agent_config:
         enable_listen_thread: bool = False,
         listen_port: int = 0,
         backends: list[str] = ["UCX"],
+        thread_safe: bool = True,
     ):
         # TODO: add backend init parameters
         self.backends = backends
         self.enable_pthread = enable_prog_thread
         self.enable_listen = enable_listen_thread
         self.port = listen_port
+        self.thread_safe = thread_safe
 
 
 """
@@ -82,11 +88,14 @@ class nixl_agent:
         if not nixl_conf:
             nixl_conf = nixl_agent_config()  # Using defaults set in nixl_agent_config
 
-        thread_config = (
-            nixlBind.NIXL_THREAD_SYNC_STRICT
-            if nixl_conf.enable_listen
-            else nixlBind.NIXL_THREAD_SYNC_NONE
-        )
+        # Posting and checking transfers only take the agent lock as readers in RW mode,
+        # so threads sharing an agent don't serialize on it.
+        if nixl_conf.enable_listen:
+            thread_config = nixlBind.NIXL_THREAD_SYNC_STRICT
+        elif nixl_conf.thread_safe:
+            thread_config = nixlBind.NIXL_THREAD_SYNC_RW
+        else:
+            thread_config = nixlBind.NIXL_THREAD_SYNC_NONE
 
         # Set agent config and instantiate an agent
         agent_config = nixlBind.nixlAgentConfig(
@@ -103,6 +112,15 @@ class nixl_agent:
         self.backend_mems: dict[str, list[str]] = {}
         self.backend_options: dict[str, dict[str, str]] = {}
 
+        # Shared state is protected explicitly, the GIL isn't held during NIXL calls
+        # and doesn't exist on free-threaded builds.
+        self._backend_lock = threading.Lock()
+        self._notif_lock = threading.Lock()
+        # Live handles, so that a handle is released once and not used after release.
+        # Single set operations are atomic, the handles need no extra lock.
+        self._xfer_handles: set[nixl_xfer_handle] = set()
+        self._dlist_handles: set[nixl_prepped_dlist_handle] = set()
+
         self.plugin_list = self.agent.getAvailPlugins()
         if len(self.plugin_list) == 0:
             print("No plugins available, cannot start transfers!")
@@ -231,13 +249,14 @@ class nixl_agent:
     """
 
     def create_backend(self, backend: str, initParams: dict[str, str] = {}):
-        self.backends[backend] = self.agent.createBackend(backend, initParams)
+        with self._backend_lock:
+            self.backends[backend] = self.agent.createBackend(backend, initParams)
 
-        (backend_options, mem_types) = self.agent.getBackendParams(
-            self.backends[backend]
-        )
-        self.backend_mems[backend] = mem_types
-        self.backend_options[backend] = backend_options
+            (backend_options, mem_types) = self.agent.getBackendParams(
+                self.backends[backend]
+            )
+            self.backend_mems[backend] = mem_types
+            self.backend_options[backend] = backend_options
         print("Backend", backend, "was instantiated")
 
     """
@@ -341,6 +360,7 @@ class nixl_agent:
             handle_list.append(self.backends[backend_string])
 
         handle = self.agent.prepXferDlist(agent_name, descs, handle_list)
+        self._dlist_handles.add(handle)
 
         return handle
 
@@ -403,6 +423,7 @@ class nixl_agent:
             handle_list,
             skip_desc_merge,
         )
+        self._xfer_handles.add(handle)
 
         return handle
 
@@ -440,6 +461,7 @@ class nixl_agent:
         handle = self.agent.createXferReq(
             op, local_descs, remote_descs, remote_agent, notif_msg, handle_list
         )
+        self._xfer_handles.add(handle)
 
         return handle
 
@@ -456,7 +478,17 @@ class nixl_agent:
     """
 
     def transfer(self, handle: nixl_xfer_handle, notif_msg: bytes = b"") -> str:
-        status = self.agent.postXferReq(handle, notif_msg)
+        self._check_xfer_handle(handle)
+        try:
+            status = self.agent.postXferReq(handle, notif_msg)
+        except (
+            nixlBind.nixlNotFoundError,
+            nixlBind.nixlRepostActiveError,
+            nixlBind.nixlBackendError,
+        ):
+            # NIXL frees the handle on these errors
+            self._xfer_handles.discard(handle)
+            raise
         if status == nixlBind.NIXL_SUCCESS:
             return "DONE"
         elif status == nixlBind.NIXL_IN_PROG:
@@ -472,7 +504,13 @@ class nixl_agent:
     """
 
     def check_xfer_state(self, handle: nixl_xfer_handle) -> str:
-        status = self.agent.getXferStatus(handle)
+        self._check_xfer_handle(handle)
+        try:
+            status = self.agent.getXferStatus(handle)
+        except nixlBind.nixlNotFoundError:
+            # NIXL frees the handle if the remote agent was removed
+            self._xfer_handles.discard(handle)
+            raise
         if status == nixlBind.NIXL_SUCCESS:
             return "DONE"
         elif status == nixlBind.NIXL_IN_PROG:
@@ -490,30 +528,52 @@ class nixl_agent:
     def query_xfer_backend(self, handle: nixl_xfer_handle) -> str:
         b_handle = self.agent.queryXferBackend(handle)
         # this works because there should not be multiple matching handles in the Dict
-        return next(
-            backendS
-            for backendS, backendH in self.backends.items()
-            if backendH == b_handle
-        )
+        with self._backend_lock:
+            return next(
+                backendS
+                for backendS, backendH in self.backends.items()
+                if backendH == b_handle
+            )
 
     """
     @brief  Releases a transfer handle, which internally frees the memory used for the handle.
             If the transfer is active, NIXL will attempt to cancel it.
             If it cannot be canceled, an error will be returned and the handle will not be freed.
 
+            Releasing a handle that was already released is a no-op.
+
     @param handle Handle to the transfer operation from initialize_xfer or make_xfer.
     """
 
     def release_xfer_handle(self, handle: nixl_xfer_handle):
-        self.agent.releaseXferReq(handle)
+        # Only the thread that removes the handle releases it
+        try:
+            self._xfer_handles.remove(handle)
+        except KeyError:
+            return
+        try:
+            self.agent.releaseXferReq(handle)
+        except nixlBind.nixlRepostActiveError:
+            # The transfer couldn't be canceled and the handle is still valid
+            self._xfer_handles.add(handle)
+            raise
+
+    def _check_xfer_handle(self, handle: nixl_xfer_handle):
+        if handle not in self._xfer_handles:
+            raise nixlBind.nixlNotFoundError("Transfer handle was released or is not valid")
 
     """
     @brief Release a descriptor list handle, which internally frees the memory used for the handle.
+           Releasing a handle that was already released is a no-op.
 
     @param handle Handle to the descriptor list from make_prepped_dlist.
     """
 
     def release_dlist_handle(self, handle: nixl_prepped_dlist_handle):
+        try:
+            self._dlist_handles.remove(handle)
+        except KeyError:
+            return
         self.agent.releasedDlistH(handle)
 
     """
@@ -542,8 +602,9 @@ class nixl_agent:
         handle_list = []
         for backend_string in backends:
             handle_list.append(self.backends[backend_string])
-        self.notifs = self.agent.getNotifs(self.notifs, handle_list)  # Adds new notifs
-        return self.notifs
+        with self._notif_lock:
+            self.notifs = self.agent.getNotifs(self.notifs, handle_list)  # Adds new notifs
+            return self.notifs
 
     """
     @brief Check if a remote transfer is done with a specific notification.
@@ -567,20 +628,21 @@ class nixl_agent:
         handle_list = []
         for backend_string in backends:
             handle_list.append(self.backends[backend_string])
-        self.notifs = self.agent.getNotifs(self.notifs, handle_list)  # Adds new notifs
         found = False
         message = None
 
-        if remote_agent_name in self.notifs:
-            for msg in self.notifs[remote_agent_name]:
-                if (tag_is_prefix and msg.startswith(lookup_tag)) or (
-                    not tag_is_prefix and lookup_tag in msg
-                ):
-                    message = msg
-                    found = True
-                    break
-        if message:
-            self.notifs[remote_agent_name].remove(message)
+        with self._notif_lock:
+            self.notifs = self.agent.getNotifs(self.notifs, handle_list)  # Adds new notifs
+            if remote_agent_name in self.notifs:
+                for msg in self.notifs[remote_agent_name]:
+                    if (tag_is_prefix and msg.startswith(lookup_tag)) or (
+                        not tag_is_prefix and lookup_tag in msg
+                    ):
+                        message = msg
+                        found = True
+                        break
+            if message:
+                self.notifs[remote_agent_name].remove(message)
         return found
 
     """
@@ -29,6 +29,16 @@ namespace py = pybind11;
 
 typedef std::map<std::string, std::vector<py::bytes>> nixl_py_notifs_t;
 
+// Agent calls don't touch Python objects and release the GIL, so the module is also
+// declared safe to import without the GIL on free-threaded Python builds.
+#if PYBIND11_VERSION_HEX >= 0x020D0000
+#define NIXL_PY_MODULE_GIL_NOT_USED , py::mod_gil_not_used()
+#else
+#define NIXL_PY_MODULE_GIL_NOT_USED
+#endif
+
+using nixl_gil_release_t = py::call_guard<py::gil_scoped_release>;
+
 class nixlNotPostedError : public std::runtime_error {
     public:
         nixlNotPostedError(const char* what) : runtime_error(what) {}
@@ -114,7 +124,7 @@ void throw_nixl_exception(const nixl_status_t &status) {
     }
 }
 
-PYBIND11_MODULE(_bindings, m) {
+PYBIND11_MODULE(_bindings, m NIXL_PY_MODULE_GIL_NOT_USED) {
 
     //TODO: each nixl class and/or function can be documented in place
     m.doc() = "pybind11 NIXL plugin: Implements NIXL descriptors and lists, as well as bindings of NIXL CPP APIs";
@@ -127,6 +137,7 @@ PYBIND11_MODULE(_bindings, m) {
     py::enum_<nixl_thread_sync_t>(m, "nixl_thread_sync_t")
         .value("NIXL_THREAD_SYNC_NONE", nixl_thread_sync_t::NIXL_THREAD_SYNC_NONE)
         .value("NIXL_THREAD_SYNC_STRICT", nixl_thread_sync_t::NIXL_THREAD_SYNC_STRICT)
+        .value("NIXL_THREAD_SYNC_RW", nixl_thread_sync_t::NIXL_THREAD_SYNC_RW)
         .value("NIXL_THREAD_SYNC_DEFAULT", nixl_thread_sync_t::NIXL_THREAD_SYNC_DEFAULT)
         .export_values();
 
@@ -381,7 +392,7 @@ PYBIND11_MODULE(_bindings, m) {
                     nixlBackendH* backend = nullptr;
                     throw_nixl_exception(agent.createBackend(type, initParams, backend));
                     return (uintptr_t) backend;
-            })
+            }, nixl_gil_release_t())
         .def("registerMem", [](nixlAgent &agent, nixl_reg_dlist_t descs, std::vector<uintptr_t> backends) -> nixl_status_t {
                     nixl_opt_args_t extra_params;
                     nixl_status_t ret;
@@ -391,7 +402,7 @@ PYBIND11_MODULE(_bindings, m) {
                     ret = agent.registerMem(descs, &extra_params);
                     throw_nixl_exception(ret);
                     return ret;
-                }, py::arg("descs"), py::arg("backends") = std::vector<uintptr_t>({}))
+                }, nixl_gil_release_t(), py::arg("descs"), py::arg("backends") = std::vector<uintptr_t>({}))
         .def("deregisterMem", [](nixlAgent &agent, nixl_reg_dlist_t descs, std::vector<uintptr_t> backends) -> nixl_status_t {
                     nixl_opt_args_t extra_params;
                     nixl_status_t ret;
@@ -401,7 +412,7 @@ PYBIND11_MODULE(_bindings, m) {
                     ret = agent.deregisterMem(descs, &extra_params);
                     throw_nixl_exception(ret);
                     return ret;
-                }, py::arg("descs"), py::arg("backends") = std::vector<uintptr_t>({}))
+                }, nixl_gil_release_t(), py::arg("descs"), py::arg("backends") = std::vector<uintptr_t>({}))
         .def("makeConnection", [](nixlAgent &agent,
                                   const std::string &remote_agent,
                                   std::vector<uintptr_t> backends) {
@@ -413,7 +424,7 @@ PYBIND11_MODULE(_bindings, m) {
                     nixl_status_t ret = agent.makeConnection(remote_agent, &extra_params);
                     throw_nixl_exception(ret);
                     return ret;
-                })
+                }, nixl_gil_release_t())
         .def("prepXferDlist", [](nixlAgent &agent,
                                  std::string &agent_name,
                                  const nixl_xfer_dlist_t &descs,
@@ -427,7 +438,7 @@ PYBIND11_MODULE(_bindings, m) {
                     throw_nixl_exception(agent.prepXferDlist(agent_name, descs, handle, &extra_params));
 
                     return (uintptr_t) handle;
-                }, py::arg("agent_name"), py::arg("descs"), py::arg("backend") = std::vector<uintptr_t>({}))
+                }, nixl_gil_release_t(), py::arg("agent_name"), py::arg("descs"), py::arg("backend") = std::vector<uintptr_t>({}))
         .def("makeXferReq", [](nixlAgent &agent,
                                const nixl_xfer_op_t &operation,
                                uintptr_t local_side,
@@ -472,10 +483,15 @@ PYBIND11_MODULE(_bindings, m) {
                     local_indices_vec = init_indices_lambda(local_indices);
                     remote_indices_vec = init_indices_lambda(remote_indices);
 
-                    throw_nixl_exception(agent.makeXferReq(operation,
-                                                           (nixlDlistH*)local_side, local_indices_vec,
-                                                           (nixlDlistH*)remote_side, remote_indices_vec,
-                                                           handle, &extra_params));
+                    nixl_status_t ret;
+                    {
+                        py::gil_scoped_release release;
+                        ret = agent.makeXferReq(operation,
+                                                (nixlDlistH*)local_side, local_indices_vec,
+                                                (nixlDlistH*)remote_side, remote_indices_vec,
+                                                handle, &extra_params);
+                    }
+                    throw_nixl_exception(ret);
 
                     return (uintptr_t) handle;
                 }, py::arg("operation"), py::arg("local_side"),
@@ -504,7 +520,7 @@ PYBIND11_MODULE(_bindings, m) {
 
                     throw_nixl_exception(ret);
                     return (uintptr_t) handle;
-                }, py::arg("operation"), py::arg("local_descs"),
+                }, nixl_gil_release_t(), py::arg("operation"), py::arg("local_descs"),
                    py::arg("remote_descs"), py::arg("remote_agent"),
                    py::arg("notif_msg") = std::string(""),
                    py::arg("backend") = std::vector<uintptr_t>({}))
@@ -515,7 +531,7 @@ PYBIND11_MODULE(_bindings, m) {
                 nixl_status_t ret = agent.estimateXferCost(reinterpret_cast<const nixlXferReqH*>(reqh), duration, err_margin, method);
                 throw_nixl_exception(ret);
                 return std::make_tuple(duration.count(), err_margin.count(), int(method));
-            }, py::arg("req_handle"))
+            }, nixl_gil_release_t(), py::arg("req_handle"))
         .def("postXferReq", [](nixlAgent &agent, uintptr_t reqh, std::string notif_msg) -> nixl_status_t {
                     nixl_opt_args_t extra_params;
                     nixl_status_t ret;
@@ -528,27 +544,27 @@ PYBIND11_MODULE(_bindings, m) {
                     }
                     throw_nixl_exception(ret);
                     return ret;
-                }, py::arg("reqh"), py::arg("notif_msg") = std::string(""))
+                }, nixl_gil_release_t(), py::arg("reqh"), py::arg("notif_msg") = std::string(""))
         .def("getXferStatus", [](nixlAgent &agent, uintptr_t reqh) -> nixl_status_t {
                     nixl_status_t ret = agent.getXferStatus((nixlXferReqH*) reqh);
                     throw_nixl_exception(ret);
                     return ret;
-                })
+                }, nixl_gil_release_t())
         .def("queryXferBackend", [](nixlAgent &agent, uintptr_t reqh) -> uintptr_t {
                     nixlBackendH* backend = nullptr;
                     throw_nixl_exception(agent.queryXferBackend((nixlXferReqH*) reqh, backend));
                     return (uintptr_t) backend;
-                })
+                }, nixl_gil_release_t())
         .def("releaseXferReq", [](nixlAgent &agent, uintptr_t reqh) -> nixl_status_t {
                     nixl_status_t ret = agent.releaseXferReq((nixlXferReqH*) reqh);
                     throw_nixl_exception(ret);
                     return ret;
-                })
+                }, nixl_gil_release_t())
         .def("releasedDlistH", [](nixlAgent &agent, uintptr_t handle) -> nixl_status_t {
                     nixl_status_t ret = agent.releasedDlistH((nixlDlistH*) handle);
                     throw_nixl_exception(ret);
                     return ret;
-                })
+                }, nixl_gil_release_t())
         .def("getNotifs", [](nixlAgent &agent,
                              nixl_py_notifs_t &notif_map,
                              std::vector<uintptr_t> backends) -> nixl_py_notifs_t {
@@ -558,7 +574,11 @@ PYBIND11_MODULE(_bindings, m) {
                     for(uintptr_t backend: backends)
                         extra_params.backends.push_back((nixlBackendH*) backend);
 
-                    nixl_status_t ret = agent.getNotifs(new_notifs, &extra_params);
+                    nixl_status_t ret;
+                    {
+                        py::gil_scoped_release release;
+                        ret = agent.getNotifs(new_notifs, &extra_params);
+                    }
 
                     throw_nixl_exception(ret);
 
@@ -582,11 +602,16 @@ PYBIND11_MODULE(_bindings, m) {
 
                     throw_nixl_exception(ret);
                     return ret;
-                }, py::arg("remote_agent"), py::arg("msg"), py::arg("backends") = std::vector<uintptr_t>({}))
+                }, nixl_gil_release_t(), py::arg("remote_agent"), py::arg("msg"), py::arg("backends") = std::vector<uintptr_t>({}))
         .def("getLocalMD", [](nixlAgent &agent) -> py::bytes {
                     //python can only interpret text strings
                     std::string ret_str("");
-                    throw_nixl_exception(agent.getLocalMD(ret_str));
+                    nixl_status_t ret;
+                    {
+                        py::gil_scoped_release release;
+                        ret = agent.getLocalMD(ret_str);
+                    }
+                    throw_nixl_exception(ret);
                     return py::bytes(ret_str);
                 })
         .def("getLocalPartialMD", [](nixlAgent &agent, nixl_reg_dlist_t descs, bool inc_conn_info, std::vector<uintptr_t> backends) -> py::bytes {
@@ -598,16 +623,26 @@ PYBIND11_MODULE(_bindings, m) {
                         extra_params.backends.push_back((nixlBackendH*) backend);
                     extra_params.includeConnInfo = inc_conn_info;
 
-                    throw_nixl_exception(agent.getLocalPartialMD(descs, ret_str, &extra_params));
+                    nixl_status_t ret;
+                    {
+                        py::gil_scoped_release release;
+                        ret = agent.getLocalPartialMD(descs, ret_str, &extra_params);
+                    }
+                    throw_nixl_exception(ret);
                     return py::bytes(ret_str);
                 }, py::arg("descs"), py::arg("inc_conn_info") = false, py::arg("backends") = std::vector<uintptr_t>({}))
         .def("loadRemoteMD", [](nixlAgent &agent, const std::string &remote_metadata) -> py::bytes {
                     //python can only interpret text strings
                     std::string remote_name("");
-                    throw_nixl_exception(agent.loadRemoteMD(remote_metadata, remote_name));
+                    nixl_status_t ret;
+                    {
+                        py::gil_scoped_release release;
+                        ret = agent.loadRemoteMD(remote_metadata, remote_name);
+                    }
+                    throw_nixl_exception(ret);
                     return py::bytes(remote_name);
                 })
-        .def("invalidateRemoteMD", &nixlAgent::invalidateRemoteMD)
+        .def("invalidateRemoteMD", &nixlAgent::invalidateRemoteMD, nixl_gil_release_t())
         .def("sendLocalMD", [](nixlAgent &agent, std::string ip_addr, int port){
                     nixl_opt_args_t extra_params;
 
@@ -615,7 +650,7 @@ PYBIND11_MODULE(_bindings, m) {
                     extra_params.port = port;
 
                     throw_nixl_exception(agent.sendLocalMD(&extra_params));
-                }, py::arg("ip_addr") = std::string(""), py::arg("port") = 0 )
+                }, nixl_gil_release_t(), py::arg("ip_addr") = std::string(""), py::arg("port") = 0 )
 
         .def("sendLocalPartialMD", [](nixlAgent &agent, nixl_reg_dlist_t descs, bool inc_conn_info, std::vector<uintptr_t> backends, std::string ip_addr, int port, std::string label) {
                     std::string ret_str("");
@@ -630,7 +665,7 @@ PYBIND11_MODULE(_bindings, m) {
                     extra_params.metadataLabel = label;
 
                     throw_nixl_exception(agent.sendLocalPartialMD(descs, &extra_params));
-                }, py::arg("descs"), py::arg("inc_conn_info") = false, py::arg("backends") = std::vector<uintptr_t>({}), py::arg("ip_addr") = std::string(""), py::arg("port") = 0, py::arg("label") = std::string(""))
+                }, nixl_gil_release_t(), py::arg("descs"), py::arg("inc_conn_info") = false, py::arg("backends") = std::vector<uintptr_t>({}), py::arg("ip_addr") = std::string(""), py::arg("port") = 0, py::arg("label") = std::string(""))
         .def("fetchRemoteMD", [](nixlAgent &agent, std::string remote_agent, std::string ip_addr, int port, std::string label){
                     nixl_opt_args_t extra_params;
 
@@ -639,7 +674,7 @@ PYBIND11_MODULE(_bindings, m) {
                     extra_params.metadataLabel = label;
 
                     throw_nixl_exception(agent.fetchRemoteMD(remote_agent, &extra_params));
-                }, py::arg("remote_agent"), py::arg("ip_addr") = std::string(""), py::arg("port") = 0, py::arg("label") = std::string(""))
+                }, nixl_gil_release_t(), py::arg("remote_agent"), py::arg("ip_addr") = std::string(""), py::arg("port") = 0, py::arg("label") = std::string(""))
         .def("invalidateLocalMD", [](nixlAgent &agent, std::string ip_addr, int port){
                     nixl_opt_args_t extra_params;
 
@@ -647,6 +682,6 @@ PYBIND11_MODULE(_bindings, m) {
                     extra_params.port = port;
 
                     throw_nixl_exception(agent.invalidateLocalMD(&extra_params));
-                }, py::arg("ip_addr") = std::string(""), py::arg("port") = 0 )
-        .def("checkRemoteMD", &nixlAgent::checkRemoteMD);
+                }, nixl_gil_release_t(), py::arg("ip_addr") = std::string(""), py::arg("port") = 0 )
+        .def("checkRemoteMD", &nixlAgent::checkRemoteMD, nixl_gil_release_t());
 }
@@ -39,7 +39,11 @@ void verify_transfer(uintptr_t addr1, uintptr_t addr2, int size) {
     for(int i = 0; i<size; i++) assert(((uint8_t*) addr1)[i] == ((uint8_t*) addr2)[i]);
 }
 
+#if PYBIND11_VERSION_HEX >= 0x020D0000
+PYBIND11_MODULE(_utils, m, py::mod_gil_not_used()) {
+#else
 PYBIND11_MODULE(_utils, m) {
+#endif
     m.def("malloc_passthru", &malloc_passthru);
     m.def("free_passthru", &free_passthru);
     m.def("ba_buf", &ba_buf);
@@ -17,11 +17,25 @@
 #ifndef __AGENT_DATA_H_
 #define __AGENT_DATA_H_
 
+#include "bcast_request.h"
 #include "common/str_tools.h"
+#include "directory.h"
 #include "mem_section.h"
 #include "stream/metadata_stream.h"
 #include "sync.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_set>
+
 #if HAVE_ETCD
 #include <etcd/Client.hpp>
 
@@ -41,6 +55,9 @@ enum nixl_comm_t {
     SOCK_FETCH,
     SOCK_INVAL,
     SOCK_MAX,
+    MDS_SEND,
+    MDS_FETCH,
+    MDS_INVAL,
 #if HAVE_ETCD
     ETCD_SEND,
     ETCD_FETCH,
@@ -57,6 +74,38 @@ using nixl_comm_req_t = std::tuple<nixl_comm_t, std::string, int, nixl_blob_t>;
 
 using nixl_socket_peer_t = std::pair<std::string, int>;
 
+// Latencies of the last reads completed from an agent, to hedge reads from it
+// once they take longer than a percentile of them
+class nixlReadLatencies {
+    private:
+        static constexpr size_t window = 256;
+        std::vector<uint64_t>   samples; // In microseconds
+        size_t                  next = 0;
+
+    public:
+        // Below that, the percentile is not considered meaningful
+        static constexpr size_t minSamples = 16;
+
+        inline void add(uint64_t us) {
+            if (samples.size() < window) {
+                samples.push_back(us);
+            } else {
+                samples[next] = us;
+                next = (next + 1) % window;
+            }
+        }
+
+        inline bool percentile(double p, uint64_t &us) const {
+            if (samples.size() < minSamples)
+                return false;
+            std::vector<uint64_t> sorted(samples);
+            auto nth = sorted.begin() + (size_t)(p * (sorted.size() - 1));
+            std::nth_element(sorted.begin(), nth, sorted.end());
+            us = *nth;
+            return true;
+        }
+};
+
 class nixlAgentData {
     private:
         std::string     name;
@@ -70,6 +119,7 @@ class nixlAgentData {
         backend_list_t                         notifEngines;
         backend_map_t                          backendEngines;
         std::array<backend_list_t, FILE_SEG+1> memToBackend;
+        std::unordered_set<nixlBackendEngine*> sharedEngines;  // Attached to shared instances
 
         // Bookkeping for local connection metadata and user handles per backend
         std::unordered_map<nixl_backend_t, nixlBackendH*> backendHandles;
@@ -92,11 +142,159 @@ class nixlAgentData {
         std::mutex                         commLock;
         bool                               commThreadStop;
         bool                               useEtcd;
+        // Set when NIXL_MD_SERVER gives the address of a built-in metadata server
+        bool                               useMDServer;
+        std::string                        mdServerAddr;
 
         void commWorker(nixlAgent* myAgent);
         void enqueueCommWork(nixl_comm_req_t request);
         void getCommWork(std::vector<nixl_comm_req_t> &req_list);
 
+        // State/methods for transfer graph execution, graph thread is only
+        // started when progress thread is enabled in the agent config, on the
+        // first graph that doesn't complete when posted
+        std::mutex                         graphLock;
+        std::condition_variable            graphCV;
+        std::vector<nixlXferGraphH*>       activeGraphs;
+        std::thread                        graphThread;
+        bool                               graphThreadStop = false;
+
+        void graphWorker();
+        // Must be called with graphLock held
+        void startGraphThread();
+        void progressGraph(nixlXferGraphH* graph, std::vector<size_t> &ready);
+        nixl_status_t postGraphReq(nixlXferReqH* req);
+        nixl_status_t checkGraphReq(nixlXferReqH* req);
+
+        // State/methods for relaying broadcast chunks received from other agents. Every
+        // receiver reports the status of its subtree to its parent, so the initiator
+        // knows when the whole schedule has the buffer or a relay in it failed.
+        std::mutex                                       bcastLock;
+        std::atomic<uint64_t>                            bcastCount{0};
+        std::unordered_map<std::string, nixlBcastState>  bcastStates;
+
+        void relayBcast(const nixlAgent* myAgent, const notif_list_t &bcast_msgs,
+                        nixl_notifs_t &notif_map);
+        // Must be called with bcastLock held
+        void relayBcastChunk(const nixlAgent* myAgent, const std::string &id,
+                             nixlBcastState &state, uint64_t offset, uint64_t len);
+        nixl_status_t bcastSubtreeStatus(const nixlBcastState &state) const;
+
+        // State/methods for asynchronous registration. Threads are started on the first
+        // asynchronous request, calls to backends without parallel registration support
+        // are serialized by a lock per engine, also taken by registerMem/deregisterMem.
+        std::mutex                                   regQueueLock;
+        std::condition_variable                      regQueueCV;
+        std::deque<std::function<void()>>            regQueue;
+        std::vector<std::thread>                     regThreads;
+        bool                                         regThreadStop = false;
+        std::unordered_map<nixlBackendEngine*,
+                           std::unique_ptr<std::mutex>> regEngineLocks;
+
+        void regWorker();
+        void enqueueRegWork(std::function<void()> task);
+        std::mutex* getRegEngineLock(nixlBackendEngine* engine, nixl_mem_t mem);
+        void runRegTask(nixlRegReqH* req, size_t backend_idx, int first, int last);
+        void runDeregTask(nixlRegReqH* req, size_t backend_idx, int first, int last);
+        void finishRegTask(nixlRegReqH* req, size_t backend_idx);
+
+        // State/methods for notification subscriptions. Notifications are routed to the
+        // subscription with the longest matching prefix by the backend notification handler,
+        // or by the thread that drains the backends. Broadcast and directory messages given
+        // to the handler are queued in notifAgentMsgs for the next drain. Drained
+        // notifications matching no subscription are kept per backend for getNotifs, nullptr
+        // for the ones of no particular backend, up to a bound while subscriptions are active,
+        // getNotifs returns them all at once. Drains are serialized by
+        // notifDrainLock, taken before the agent lock, and are only needed for subscriptions
+        // if a backend can't route notifications on its own progress thread.
+        std::shared_mutex                                  notifSubLock;
+        std::map<nixl_blob_t, nixlNotifSubH*, std::less<>> notifSubs;
+        std::map<size_t, size_t, std::greater<>>           notifSubLens;
+        std::mutex                                         notifDrainLock;
+        std::unordered_map<nixlBackendEngine*, notif_list_t> notifUnrouted;
+        bool                                               notifDrainNeeded = false;
+        std::mutex                                         notifAgentLock;
+        notif_list_t                                       notifAgentMsgs;
+        std::atomic<bool>                                  notifAgentQueued{false};
+
+        bool routeNotif(const std::string &remote_agent, nixl_blob_t &msg);
+        bool handleNotif(const std::string &remote_agent, nixl_blob_t &msg);
+        // Must be called with notifDrainLock and the agent lock held
+        nixl_status_t drainNotifs(const backend_list_t &backends, notif_list_t &agent_msgs);
+        // Must be called with notifDrainLock held
+        void relayDrained(const nixlAgent* myAgent, notif_list_t &agent_msgs);
+        void keepUnrouted(nixlBackendEngine* engine, notif_list_t &notifs);
+        // Must be called with notifDrainLock held, and not between a drain and the return
+        // of its notifications by getNotifs
+        void trimUnrouted();
+
+        // State/methods for completion queues. Completion handlers of the backends find the
+        // queue of a finished transfer under complQueuesLock, taken shared, so that queues
+        // are not released under them. complEngines have a completion handler set.
+        std::shared_mutex                                  complQueuesLock;
+        std::vector<nixlComplQueueH*>                      complQueues;
+        std::unordered_set<nixlBackendEngine*>             complEngines;
+
+        void complXfer(nixlBackendReqH* handle, nixl_status_t status);
+        // Must be called with the agent lock held
+        void checkPolledXfers(nixlComplQueueH* cq);
+
+        // State/methods for the block directory. Each member agent is the shard of the keys
+        // whose rendezvous hash is highest for it among the members. Blocks published by this
+        // agent are kept to move them to new shards when members change, and to unpublish them
+        // when their memory is deregistered. Directory messages are consumed like broadcast
+        // chunks, and dirLock is never held while sending them.
+        std::mutex                                              dirLock;
+        std::vector<std::pair<std::string, uint64_t>>           dirMembers;   // Name and hash
+        std::unordered_map<uint64_t, std::vector<nixlDirEntry>> dirShard;
+        std::unordered_map<uint64_t, nixlDirEntry>              dirPublished;
+        std::unordered_map<uint64_t, nixlDirLookupH*>           dirLookups;
+        uint64_t                                                dirLookupCount = 0;
+
+        // Must be called with dirLock held
+        const std::string& dirHome(uint64_t key) const;
+        void dirApply(const std::string &src, const nixlDirMsg &msg, nixl_dir_msgs_t &out);
+        void handleDir(const nixlAgent* myAgent, const notif_list_t &dir_msgs);
+        nixl_status_t sendDir(const nixlAgent* myAgent, nixl_dir_msgs_t &msgs);
+        nixl_status_t unpublishDeregistered(const nixlAgent* myAgent,
+                                            const nixl_reg_dlist_t &descs);
+        // Must be called with the agent lock held
+        bool dirRegistered(const nixlDirEntry &entry);
+
+        // Read latencies per remote agent, for the hedge delays of replicated reads
+        std::mutex                                         hedgeLock;
+        std::unordered_map<std::string, nixlReadLatencies> readLatencies;
+
+        std::chrono::microseconds hedgeDelayFor(const std::string &agent, double percentile);
+        void addReadLatency(const std::string &agent, std::chrono::microseconds latency);
+        void finishReplicaRead(nixlReplicaXferReqH* req, size_t idx,
+                               std::chrono::steady_clock::time_point now);
+        nixl_status_t stageReplicaRead(nixlAgent* myAgent, nixlReplicaXferReqH* req,
+                                       size_t idx, nixl_xfer_dlist_t &staged_descs);
+        nixl_status_t releaseReplicas(nixlAgent* myAgent, nixlReplicaXferReqH* req);
+
+        // Staged reads that lost and were still in flight when their request was released,
+        // released with their staging buffer once done by later replicated requests
+        struct nixlStagedRelease {
+            nixlXferReqH*           req;
+            std::unique_ptr<char[]> staging;
+            size_t                  len;
+            nixl_opt_args_t         args;
+        };
+        std::mutex                                         stagedLock;
+        std::vector<nixlStagedRelease>                     stagedReleases;
+
+        void deregisterStaging(nixlAgent* myAgent, char* staging, size_t len,
+                               const nixl_opt_args_t &args);
+        void reapStagedReads(nixlAgent* myAgent);
+
+        // Notifications sent through a shared backend instance, or to an agent on one, carry
+        // the source and destination agents. Requests find it out once, when created, with
+        // the agent lock held.
+        bool sharedNotifTo(nixlBackendEngine* engine, const std::string &remote_agent) const;
+        nixl_blob_t notifMsgTo(bool shared, const std::string &remote_agent,
+                               const nixl_blob_t &msg) const;
+
     public:
         nixlAgentData(const std::string &name, const nixlAgentConfig &cfg);
         ~nixlAgentData();
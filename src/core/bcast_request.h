@@ -0,0 +1,88 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __BCAST_REQUEST_H_
+#define __BCAST_REQUEST_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+// Node of a broadcast schedule. Schedules are kept as a preorder list of nodes, the
+// subtree of each node is contiguous in the list and can be sent along with the chunks.
+struct nixlBcastNode {
+    std::string agent;
+    uintptr_t   addr;
+    uint64_t    devId;
+    nixl_mem_t  memType;
+    uint32_t    numChildren;
+};
+
+using nixl_bcast_tree_t = std::vector<nixlBcastNode>;
+
+class nixlXferReqH;
+
+// Broadcast as seen by one agent of its schedule, either the initiator for one post, or a
+// receiver from its first chunk until its subtree has the whole buffer. The subtree comes
+// with the first chunk from the parent, chunks that arrive before it wait to be relayed.
+struct nixlBcastState {
+    std::string                                parent;  // Sender of chunks, none at initiator
+    std::string                                src;
+    std::string                                msg;
+    nixl_bcast_tree_t                          tree;    // Subtree rooted at this agent
+    // Offsets and lengths of chunks to relay once the subtree arrives
+    std::vector<std::pair<uint64_t, uint64_t>> pending;
+    uint64_t                                   received = 0;
+    uint64_t                                   total    = 0;
+    size_t                                     acks     = 0;      // Children done with subtree
+    std::vector<nixlXferReqH*>                 relays;            // Relays still in flight
+    bool                                       treeSent = false;  // Children have their subtrees
+    bool                                       notified = false;
+    bool                                       reported = false;  // Status was sent to parent
+    nixl_status_t                              status   = NIXL_IN_PROG;
+};
+
+// One-to-many broadcast of a local buffer. The initiator only writes the buffer to its own
+// children in the broadcast schedule, chunk by chunk, and every receiver relays each chunk
+// to its children as soon as it arrives, so chunks are pipelined down the chain or tree.
+class nixlBcastReqH {
+    private:
+        struct chunkXfer {
+            nixlXferReqH* req;
+            size_t        child;   // Position of the receiving node in the schedule
+            size_t        offset;
+            size_t        len;
+        };
+
+        std::string            bcastId;
+        std::string            postId;    // Broadcast id of the last post
+        std::string            notifMsg;
+        size_t                 totalLen  = 0;
+        uint64_t               postCount = 0;
+
+        // Schedule rooted at the initiator, and chunk transfers to its children
+        nixl_bcast_tree_t      schedule;
+        std::vector<chunkXfer> chunks;
+
+        nixl_status_t status = NIXL_ERR_NOT_POSTED;
+
+    public:
+        inline nixlBcastReqH() { }
+
+    friend class nixlAgent;
+};
+
+#endif
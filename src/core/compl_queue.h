@@ -0,0 +1,94 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __COMPL_QUEUE_H_
+#define __COMPL_QUEUE_H_
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "nixl_types.h"
+
+class nixlBackendReqH;
+
+// Completion queue that transfer requests are bound to. Finished requests are queued by the
+// backend completion handler, as a transfer completes on the backend progress thread, or by
+// the thread that posts the request or checks the requests of backends without a handler.
+// The eventfd is readable while requests are queued.
+class nixlComplQueueH {
+    private:
+        std::mutex                                          lock;
+        std::vector<nixl_xfer_compl_t>                      done;
+        // Requests in progress on a backend with a completion handler, by backend handle
+        std::unordered_map<nixlBackendReqH*, nixlXferReqH*> armed;
+        // Requests in progress on the other backends
+        std::vector<nixlXferReqH*>                          polled;
+        std::vector<nixlXferReqH*>                          bound;
+        int                                                 fd;
+        bool                                                signaled = false;
+
+        // Must be called with lock held
+        inline void push(nixlXferReqH* req, nixl_status_t status) {
+            done.push_back({req, status});
+            if (!signaled) {
+                const uint64_t one = 1;
+                signaled = write(fd, &one, sizeof(one)) == sizeof(one);
+            }
+        }
+
+        // Must be called with lock held
+        inline void resetSignal() {
+            uint64_t count;
+            if (signaled && read(fd, &count, sizeof(count)) == sizeof(count))
+                signaled = false;
+        }
+
+        // Forgets everything about a request, called when it is unbound or released
+        inline void unbind(nixlXferReqH* req, nixlBackendReqH* backend_handle) {
+            const std::lock_guard<std::mutex> guard(lock);
+            auto it = armed.find(backend_handle);
+            if (it != armed.end() && it->second == req)
+                armed.erase(it);
+            polled.erase(std::remove(polled.begin(), polled.end(), req), polled.end());
+            bound.erase(std::remove(bound.begin(), bound.end(), req), bound.end());
+            done.erase(std::remove_if(done.begin(), done.end(),
+                                      [req](const nixl_xfer_compl_t &entry) {
+                                          return entry.req == req;
+                                      }),
+                       done.end());
+            if (done.empty())
+                resetSignal();
+        }
+
+    public:
+        inline nixlComplQueueH() : fd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) { }
+
+        inline ~nixlComplQueueH() {
+            if (fd >= 0)
+                close(fd);
+        }
+
+    friend class nixlAgent;
+    friend class nixlAgentData;
+    friend class nixlXferReqH;
+};
+
+#endif
@@ -0,0 +1,81 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __DIRECTORY_H_
+#define __DIRECTORY_H_
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Block held by an agent, as kept by the directory shard of its key
+struct nixlDirEntry {
+    std::string agent;
+    uintptr_t   addr;
+    size_t      len;
+    uint64_t    devId;
+    nixl_mem_t  memType;
+};
+
+// Block of a directory message, holders are only given in answers, as an index
+// into the agents of the message
+struct nixlDirBlock {
+    uint64_t key;
+    uint64_t addr;
+    uint64_t len;
+    uint64_t devId;
+    uint32_t memType;
+    uint32_t holder;
+};
+
+enum class nixl_dir_op_t : uint32_t {
+    PUBLISH,
+    UNPUBLISH,
+    QUERY,
+    ANSWER
+};
+
+// Directory message from or to one agent, queries and answers are matched by id
+struct nixlDirMsg {
+    nixl_dir_op_t             op;
+    uint64_t                  id = 0;
+    std::vector<std::string>  agents;
+    std::vector<nixlDirBlock> blocks;
+};
+
+using nixl_dir_msgs_t = std::vector<std::pair<std::string, nixlDirMsg>>;
+
+// Lookup of blocks in the directory, complete once every shard of its keys answered,
+// failed if one did not before the deadline
+class nixlDirLookupH {
+    private:
+        uint64_t                                   lookupId;
+        std::vector<uint64_t>                      keys;
+        std::unordered_map<uint64_t, nixlDirEntry> found;
+        size_t                                     pendingShards = 0;
+        std::chrono::steady_clock::time_point      deadline;
+
+        nixl_status_t status = NIXL_IN_PROG;
+
+    public:
+        inline nixlDirLookupH() { }
+
+    friend class nixlAgent;
+    friend class nixlAgentData;
+};
+
+#endif
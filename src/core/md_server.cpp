@@ -0,0 +1,377 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <set>
+#include <thread>
+#include <unordered_map>
+
+#include "nixl_md_server.h"
+#include "md_server_msg.h"
+#include "common/nixl_log.h"
+#include <absl/strings/str_format.h>
+
+namespace {
+
+// Larger messages are taken as garbage, and their connection is closed
+constexpr size_t max_msg_size = 64UL << 20;
+constexpr size_t recv_chunk_size = 64 * 1024;
+
+struct mdsConn {
+    std::string                                     in;
+    std::string                                     out;
+    size_t                                          outOffset = 0;
+    // Agent the connection publishes as, set by its first PUT or DEL
+    std::string                                     owner;
+    // Labels fetched by the agent of the connection, by agent
+    std::set<std::pair<std::string, std::string>>   subs;
+    bool                                            closed = false;
+};
+
+struct mdsAgent {
+    uint64_t                                        gen = 0;
+    std::map<std::string, nixlMDServerEntry>        labels;
+};
+
+} // unnamed namespace
+
+class nixlMDServerData {
+    public:
+        int                                         port;
+        std::string                                 ipAddr;
+        int                                         listenFd = -1;
+        int                                         wakeFd = -1;
+        std::thread                                 thread;
+        std::atomic<bool>                           stopping{false};
+
+        std::unordered_map<int, mdsConn>            conns;
+        // Agents stay after they are invalidated, for their generation to keep growing
+        std::unordered_map<std::string, mdsAgent>   agents;
+        // Connections subscribed to the labels of an agent
+        std::unordered_map<std::string, std::map<int, std::set<std::string>>> subscribers;
+
+        nixlMDServerData(int port, const std::string &ip_addr) :
+            port(port), ipAddr(ip_addr) {}
+
+        void run();
+        void acceptConns();
+        void recvConn(int fd, mdsConn &conn);
+        bool checkOwner(int fd, mdsConn &conn, const std::vector<nixlMDServerEntry> &entries);
+        void handleMsg(int fd, mdsConn &conn, const std::string &msg);
+        void queueMsg(mdsConn &conn, const std::string &msg);
+        void flushConn(int fd, mdsConn &conn);
+        void closeConn(int fd);
+};
+
+void nixlMDServerData::queueMsg(mdsConn &conn, const std::string &msg) {
+    size_t size = msg.size();
+    conn.out.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    conn.out.append(msg);
+}
+
+void nixlMDServerData::flushConn(int fd, mdsConn &conn) {
+    while (!conn.closed && conn.outOffset < conn.out.size()) {
+        ssize_t bytes = send(fd, conn.out.data() + conn.outOffset,
+                             conn.out.size() - conn.outOffset, MSG_NOSIGNAL);
+        if (bytes < 0) {
+            if (errno == EINTR)
+                continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+                conn.closed = true;
+            break;
+        }
+        conn.outOffset += bytes;
+    }
+
+    if (conn.outOffset == conn.out.size()) {
+        conn.out.clear();
+        conn.outOffset = 0;
+    }
+}
+
+void nixlMDServerData::closeConn(int fd) {
+    for (const auto &[agent, label] : conns.at(fd).subs) {
+        auto it = subscribers.find(agent);
+        if (it == subscribers.end())
+            continue;
+        it->second.erase(fd);
+        if (it->second.empty())
+            subscribers.erase(it);
+    }
+    conns.erase(fd);
+    close(fd);
+    NIXL_DEBUG << "Metadata server closed connection " << fd;
+}
+
+// A connection only updates the metadata of one agent, so that it can't overwrite or
+// invalidate the metadata of others
+bool nixlMDServerData::checkOwner(int fd, mdsConn &conn,
+                                  const std::vector<nixlMDServerEntry> &entries) {
+    for (const auto &entry : entries) {
+        if (conn.owner.empty())
+            conn.owner = entry.agent;
+        if (entry.agent != conn.owner) {
+            NIXL_ERROR << "Metadata server connection " << fd << " of agent " << conn.owner
+                       << " tried to update the metadata of agent " << entry.agent;
+            conn.closed = true;
+            return false;
+        }
+    }
+    return true;
+}
+
+void nixlMDServerData::handleMsg(int fd, mdsConn &conn, const std::string &msg) {
+    std::string op;
+    std::vector<nixlMDServerEntry> entries;
+    if (!nixlMDServerMsg::decode(msg, op, entries)) {
+        NIXL_ERROR << "Metadata server received a malformed message on connection " << fd;
+        conn.closed = true;
+        return;
+    }
+
+    if ((op == nixlMDServerMsg::put || op == nixlMDServerMsg::del) &&
+        !checkOwner(fd, conn, entries))
+        return;
+
+    if (op == nixlMDServerMsg::put) {
+        for (auto &entry : entries) {
+            auto &agent = agents[entry.agent];
+            entry.gen = ++agent.gen;
+
+            // Only the metadata of the entry is pushed, to the agents that fetched its label
+            auto subs_it = subscribers.find(entry.agent);
+            if (subs_it != subscribers.end()) {
+                const std::string push = nixlMDServerMsg::encode(nixlMDServerMsg::load, {entry});
+                for (const auto &[sub_fd, labels] : subs_it->second) {
+                    if (labels.count(entry.label))
+                        queueMsg(conns.at(sub_fd), push);
+                }
+            }
+            agent.labels[entry.label] = std::move(entry);
+        }
+    } else if (op == nixlMDServerMsg::get) {
+        // Entries not stored yet are pushed once they are, like a watch
+        std::vector<nixlMDServerEntry> found;
+        for (const auto &entry : entries) {
+            subscribers[entry.agent][fd].insert(entry.label);
+            conn.subs.emplace(entry.agent, entry.label);
+
+            auto agent_it = agents.find(entry.agent);
+            if (agent_it == agents.end())
+                continue;
+            auto label_it = agent_it->second.labels.find(entry.label);
+            if (label_it != agent_it->second.labels.end())
+                found.push_back(label_it->second);
+        }
+        if (!found.empty())
+            queueMsg(conn, nixlMDServerMsg::encode(nixlMDServerMsg::load, found));
+    } else if (op == nixlMDServerMsg::del) {
+        for (auto &entry : entries) {
+            auto &agent = agents[entry.agent];
+            agent.labels.clear();
+            entry.gen = ++agent.gen;
+
+            auto subs_it = subscribers.find(entry.agent);
+            if (subs_it == subscribers.end())
+                continue;
+            const std::string push = nixlMDServerMsg::encode(nixlMDServerMsg::inval, {entry});
+            for (const auto &[sub_fd, labels] : subs_it->second)
+                queueMsg(conns.at(sub_fd), push);
+        }
+    } else {
+        NIXL_ERROR << "Metadata server received unknown operation " << op << " on connection "
+                   << fd;
+        conn.closed = true;
+    }
+}
+
+void nixlMDServerData::recvConn(int fd, mdsConn &conn) {
+    char buf[recv_chunk_size];
+    while (true) {
+        ssize_t bytes = recv(fd, buf, sizeof(buf), 0);
+        if (bytes > 0) {
+            conn.in.append(buf, bytes);
+            // The rest is read once the buffered messages are handled
+            if (conn.in.size() > max_msg_size + sizeof(size_t))
+                break;
+            continue;
+        }
+        if (bytes < 0 && errno == EINTR)
+            continue;
+        if (bytes == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+            conn.closed = true;
+        break;
+    }
+
+    // Messages are handled as soon as they are complete, a partial one stays buffered
+    size_t offset = 0;
+    while (!conn.closed && conn.in.size() - offset >= sizeof(size_t)) {
+        size_t size;
+        memcpy(&size, conn.in.data() + offset, sizeof(size));
+        if (size > max_msg_size) {
+            NIXL_ERROR << "Metadata server received a message of " << size
+                       << " bytes on connection " << fd;
+            conn.closed = true;
+            break;
+        }
+        if (conn.in.size() - offset - sizeof(size) < size)
+            break;
+
+        handleMsg(fd, conn, conn.in.substr(offset + sizeof(size), size));
+        offset += sizeof(size) + size;
+    }
+    conn.in.erase(0, offset);
+}
+
+void nixlMDServerData::acceptConns() {
+    while (true) {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK);
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+                NIXL_PERROR << "Metadata server failed to accept a connection";
+            return;
+        }
+        conns.emplace(fd, mdsConn());
+        NIXL_DEBUG << "Metadata server accepted connection " << fd;
+    }
+}
+
+void nixlMDServerData::run() {
+    std::vector<struct pollfd> fds;
+    while (!stopping) {
+        fds.clear();
+        fds.push_back({listenFd, POLLIN, 0});
+        fds.push_back({wakeFd, POLLIN, 0});
+        for (const auto &[fd, conn] : conns)
+            fds.push_back({fd, static_cast<short>(POLLIN | (conn.out.empty() ? 0 : POLLOUT)), 0});
+
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            NIXL_PERROR << "Metadata server poll failed";
+            break;
+        }
+
+        for (size_t i = 2; i < fds.size(); ++i) {
+            if (fds[i].revents & (POLLIN | POLLHUP | POLLERR))
+                recvConn(fds[i].fd, conns.at(fds[i].fd));
+        }
+
+        // Pushes of the messages above are sent to all their subscribers at once
+        std::vector<int> closed;
+        for (auto &[fd, conn] : conns) {
+            if (!conn.out.empty())
+                flushConn(fd, conn);
+            if (conn.closed)
+                closed.push_back(fd);
+        }
+        for (int fd : closed)
+            closeConn(fd);
+
+        if (fds[0].revents & POLLIN)
+            acceptConns();
+    }
+}
+
+/*** nixlMDServer implementation ***/
+nixlMDServer::nixlMDServer(const int port, const std::string &ip_addr) :
+    data(std::make_unique<nixlMDServerData>(port, ip_addr)) {}
+
+nixlMDServer::~nixlMDServer() {
+    stop();
+}
+
+nixl_status_t nixlMDServer::start() {
+    if (data->thread.joinable())
+        return NIXL_ERR_NOT_ALLOWED;
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    if (inet_pton(AF_INET, data->ipAddr.c_str(), &addr.sin_addr) != 1) {
+        NIXL_ERROR << "Invalid metadata server IPv4 address: " << data->ipAddr;
+        return NIXL_ERR_INVALID_PARAM;
+    }
+
+    data->listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (data->listenFd < 0) {
+        NIXL_PERROR << "Failed to create the metadata server socket";
+        return NIXL_ERR_BACKEND;
+    }
+
+    int opt = 1;
+    socklen_t addr_len = sizeof(addr);
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(data->port);
+    if (setsockopt(data->listenFd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) < 0 ||
+        bind(data->listenFd, (struct sockaddr*)&addr, sizeof(addr)) < 0 ||
+        listen(data->listenFd, SOMAXCONN) < 0 ||
+        getsockname(data->listenFd, (struct sockaddr*)&addr, &addr_len) < 0) {
+        NIXL_PERROR << "Failed to listen on metadata server address " << data->ipAddr << ":"
+                    << data->port;
+        close(data->listenFd);
+        data->listenFd = -1;
+        return NIXL_ERR_BACKEND;
+    }
+    data->port = ntohs(addr.sin_port);
+
+    data->wakeFd = eventfd(0, EFD_NONBLOCK);
+    if (data->wakeFd < 0) {
+        NIXL_PERROR << "Failed to create the metadata server eventfd";
+        close(data->listenFd);
+        data->listenFd = -1;
+        return NIXL_ERR_BACKEND;
+    }
+
+    data->stopping = false;
+    data->thread = std::thread(&nixlMDServerData::run, data.get());
+    NIXL_INFO << "Metadata server listening on " << data->ipAddr << ":" << data->port;
+    return NIXL_SUCCESS;
+}
+
+void nixlMDServer::stop() {
+    if (!data->thread.joinable())
+        return;
+
+    data->stopping = true;
+    uint64_t one = 1;
+    if (write(data->wakeFd, &one, sizeof(one)) < 0)
+        NIXL_PERROR << "Failed to wake the metadata server up";
+    data->thread.join();
+
+    for (auto &[fd, conn] : data->conns)
+        close(fd);
+    data->conns.clear();
+    data->subscribers.clear();
+    data->agents.clear();
+    close(data->listenFd);
+    close(data->wakeFd);
+    data->listenFd = -1;
+    data->wakeFd = -1;
+}
+
+int nixlMDServer::getPort() const {
+    return data->port;
+}
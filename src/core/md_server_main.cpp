@@ -0,0 +1,86 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Standalone metadata server, agents use it with NIXL_MD_SERVER=<address>:<port>
+
+#include <signal.h>
+
+#include <iostream>
+#include <string>
+
+#include "nixl_md_server.h"
+#include "absl/strings/numbers.h"
+
+namespace {
+
+void printUsage(const char *prog) {
+    std::cout << "Usage: " << prog << " [options]\n"
+              << "  --port N          Port to listen on (default " << default_md_server_port
+              << ")\n"
+              << "  --addr IP         IPv4 address to listen on (default "
+              << default_md_server_addr << ")\n";
+}
+
+bool parseArgs(int argc, char *argv[], int &port, std::string &ip_addr) {
+    for (int i = 1; i < argc; i++) {
+        const std::string arg(argv[i]);
+        if (arg == "-h" || arg == "--help" || i + 1 == argc)
+            return false;
+
+        const std::string value(argv[++i]);
+        if (arg == "--port") {
+            if (!absl::SimpleAtoi(value, &port) || port < 0 || port > 65535)
+                return false;
+        } else if (arg == "--addr") {
+            ip_addr = value;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    int port = default_md_server_port;
+    std::string ip_addr = default_md_server_addr;
+    if (!parseArgs(argc, argv, port, ip_addr)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // Signals are taken synchronously, so that the server stops cleanly
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    nixlMDServer server(port, ip_addr);
+    if (server.start() != NIXL_SUCCESS) {
+        std::cerr << "Failed to start the metadata server on " << ip_addr << ":" << port << "\n";
+        return 1;
+    }
+    std::cout << "NIXL metadata server listening on " << ip_addr << ":" << server.getPort()
+              << std::endl;
+
+    int sig;
+    sigwait(&signals, &sig);
+    server.stop();
+    return 0;
+}
@@ -0,0 +1,101 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __MD_SERVER_MSG_H_
+#define __MD_SERVER_MSG_H_
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "nixl_types.h"
+#include "serdes/serdes.h"
+
+// Metadata of an agent under a label, as stored by the metadata server. The generation
+// grows with every update or invalidation of the agent, so that agents can tell stale
+// pushes from current ones.
+struct nixlMDServerEntry {
+    std::string agent;
+    std::string label;
+    uint64_t    gen = 0;
+    nixl_blob_t md;
+};
+
+// Messages between agents and the metadata server, an operation and a list of entries.
+// They are framed like the messages between agents, by their size.
+//   PUT   agent -> server  Store the metadata of the entries, and push it to subscribers
+//   GET   agent -> server  Batched fetch of the entries, subscribing to their updates
+//   DEL   agent -> server  Drop all the labels of the agents, and push invalidations
+//   LOAD  server -> agent  Metadata of the entries, for a fetch or an update
+//   INVL  server -> agent  Invalidation of the agents, at the generations of the entries
+namespace nixlMDServerMsg {
+
+const std::string put   = "PUT";
+const std::string get   = "GET";
+const std::string del   = "DEL";
+const std::string load  = "LOAD";
+const std::string inval = "INVL";
+
+inline std::string
+encode(const std::string &op, const std::vector<nixlMDServerEntry> &entries) {
+    nixlSerDes sd;
+    size_t count = entries.size();
+    sd.addStr("op", op);
+    sd.addBuf("count", &count, sizeof(count));
+    for (const auto &entry : entries) {
+        sd.addStr("agent", entry.agent);
+        sd.addStr("label", entry.label);
+        sd.addBuf("gen", &entry.gen, sizeof(entry.gen));
+        sd.addStr("md", entry.md);
+    }
+    return sd.exportStr();
+}
+
+inline bool
+decode(const std::string &msg, std::string &op, std::vector<nixlMDServerEntry> &entries) {
+    nixlSerDes sd;
+    size_t count;
+    entries.clear();
+    try {
+        if (sd.importStr(msg) != NIXL_SUCCESS)
+            return false;
+        op = sd.getStr("op");
+        if (sd.getBufLen("count") != sizeof(count) ||
+            sd.getBuf("count", &count, sizeof(count)) != NIXL_SUCCESS)
+            return false;
+
+        for (size_t i = 0; i < count; ++i) {
+            nixlMDServerEntry entry;
+            entry.agent = sd.getStr("agent");
+            entry.label = sd.getStr("label");
+            if (sd.getBufLen("gen") != sizeof(entry.gen) ||
+                sd.getBuf("gen", &entry.gen, sizeof(entry.gen)) != NIXL_SUCCESS)
+                return false;
+            entry.md = sd.getStr("md");
+            entries.push_back(std::move(entry));
+        }
+    }
+    catch (const std::out_of_range &) {
+        // Truncated message
+        return false;
+    }
+    return !op.empty();
+}
+
+} // namespace nixlMDServerMsg
+
+#endif
@@ -15,14 +15,24 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <poll.h>
 #include "nixl.h"
 #include "serdes/serdes.h"
 #include "backend/backend_engine.h"
 #include "transfer_request.h"
+#include "transfer_graph.h"
+#include "bcast_request.h"
+#include "directory.h"
+#include "reg_request.h"
+#include "notif_sub.h"
+#include "shared_backend.h"
 #include "agent_data.h"
 #include "plugin_manager.h"
 #include "common/nixl_log.h"
+#include "dtype_convert.h"
 
 /*** nixlEnumStrings namespace implementation in API ***/
 std::string nixlEnumStrings::memTypeStr(const nixl_mem_t &mem) {
@@ -59,6 +69,264 @@ std::string nixlEnumStrings::statusStr (const nixl_status_t &status) {
     }
 }
 
+/*** Broadcast schedule and chunk messages ***/
+namespace {
+
+// Chunk messages of broadcasts are carried by the backend notifications, and are
+// consumed by the agent within getNotifs instead of being passed to the user.
+const std::string bcast_prefix = "NIXL_BCAST|";
+constexpr size_t bcast_default_chunk_size = 1024 * 1024;
+constexpr std::chrono::microseconds compl_poll_interval(100);
+// Shortest interval of the graph thread between polls of active graphs
+constexpr std::chrono::microseconds graph_min_poll_interval(50);
+// Hedge delay of replicated reads until enough latencies of their source are known
+constexpr std::chrono::microseconds hedge_default_delay(10000);
+// Notifications kept per backend for getNotifs between calls while subscriptions are
+// active, the oldest are dropped beyond it
+constexpr size_t notif_unrouted_max = 64 * 1024;
+// Time directory shards have to answer a lookup in, unless given by the lookup
+constexpr std::chrono::microseconds dir_lookup_timeout(5000000);
+
+struct bcastChunk {
+    uint64_t offset;
+    uint64_t len;
+    uint64_t total;
+};
+
+struct bcastNodeInfo {
+    uint64_t addr;
+    uint64_t devId;
+    uint32_t memType;
+    uint32_t numChildren;
+};
+
+// Preorder list of the k-ary tree over the initiator (node 0) and the receivers
+// (nodes 1 to N), the children of node j are nodes j*fanout+1 to j*fanout+fanout.
+void
+bcastBuildTree(const nixl_bcast_tree_t &nodes, size_t j, size_t fanout, nixl_bcast_tree_t &tree) {
+    const size_t pos = tree.size();
+    tree.push_back(nodes[j]);
+    tree[pos].numChildren = 0;
+    for (size_t child = j * fanout + 1; child <= j * fanout + fanout && child < nodes.size();
+         child++) {
+        tree[pos].numChildren++;
+        bcastBuildTree(nodes, child, fanout, tree);
+    }
+}
+
+size_t
+bcastSubtreeSize(const nixl_bcast_tree_t &tree, size_t pos) {
+    size_t size = 1;
+    for (uint32_t i = 0; i < tree[pos].numChildren; i++)
+        size += bcastSubtreeSize(tree, pos + size);
+    return size;
+}
+
+std::vector<size_t>
+bcastChildren(const nixl_bcast_tree_t &tree, size_t pos) {
+    std::vector<size_t> children;
+    size_t child = pos + 1;
+    for (uint32_t i = 0; i < tree[pos].numChildren; i++) {
+        children.push_back(child);
+        if (i + 1 < tree[pos].numChildren)
+            child += bcastSubtreeSize(tree, child);
+    }
+    return children;
+}
+
+// Messages of a broadcast, from an agent to its children or back to its parent
+struct bcastMsgInfo {
+    std::string       id;
+    bool              isAck = false;
+    nixl_status_t     ack   = NIXL_SUCCESS;  // Status of the sender's subtree
+    bcastChunk        chunk = {};
+    std::string       src;
+    std::string       msg;
+    nixl_bcast_tree_t tree;                  // Subtree of the receiver, empty if already sent
+};
+
+// The first chunk message to a receiver carries its subtree, so that the receiver knows
+// where to relay the chunks without any other coordination. The other chunk messages
+// only carry the chunk, so their size doesn't grow with the schedule.
+std::string
+bcastMsg(const std::string &id, const std::string &src, const std::string &msg,
+         const bcastChunk &chunk, const nixl_bcast_tree_t &tree, size_t pos, bool with_tree) {
+    nixlSerDes sd;
+    const size_t count = with_tree ? bcastSubtreeSize(tree, pos) : 0;
+
+    sd.addStr("id", id);
+    sd.addBuf("chunk", &chunk, sizeof(chunk));
+    sd.addBuf("nodes", &count, sizeof(count));
+    if (count == 0)
+        return bcast_prefix + sd.exportStr();
+
+    sd.addStr("src", src);
+    sd.addStr("msg", msg);
+    for (size_t i = pos; i < pos + count; i++) {
+        const bcastNodeInfo info = {tree[i].addr, tree[i].devId,
+                                    static_cast<uint32_t>(tree[i].memType),
+                                    tree[i].numChildren};
+        sd.addStr("agent", tree[i].agent);
+        sd.addBuf("node", &info, sizeof(info));
+    }
+    return bcast_prefix + sd.exportStr();
+}
+
+// Sent by a receiver to its parent once its subtree has the whole buffer, or as soon as
+// a relay within the subtree failed
+std::string
+bcastAckMsg(const std::string &id, nixl_status_t status) {
+    nixlSerDes sd;
+    const int32_t ack = status;
+
+    sd.addStr("id", id);
+    sd.addBuf("ack", &ack, sizeof(ack));
+    return bcast_prefix + sd.exportStr();
+}
+
+nixl_status_t
+bcastParse(const std::string &str, bcastMsgInfo &info) {
+    nixlSerDes sd;
+    size_t count;
+
+    if (sd.importStr(str.substr(bcast_prefix.size())) != NIXL_SUCCESS)
+        return NIXL_ERR_MISMATCH;
+
+    info.id = sd.getStr("id");
+    if (info.id.empty())
+        return NIXL_ERR_MISMATCH;
+
+    if (sd.getBufLen("ack") == sizeof(int32_t)) {
+        int32_t ack;
+        sd.getBuf("ack", &ack, sizeof(ack));
+        info.isAck = true;
+        info.ack   = static_cast<nixl_status_t>(ack);
+        return NIXL_SUCCESS;
+    }
+
+    if (sd.getBuf("chunk", &info.chunk, sizeof(info.chunk)) != NIXL_SUCCESS ||
+        sd.getBuf("nodes", &count, sizeof(count)) != NIXL_SUCCESS)
+        return NIXL_ERR_MISMATCH;
+    if (count == 0)
+        return NIXL_SUCCESS;
+
+    // Every node takes more than its info in the message, which bounds the count
+    if (count > str.size() / sizeof(bcastNodeInfo))
+        return NIXL_ERR_MISMATCH;
+
+    info.src = sd.getStr("src");
+    info.msg = sd.getStr("msg");
+    info.tree.resize(count);
+    for (auto &node : info.tree) {
+        bcastNodeInfo node_info;
+        node.agent = sd.getStr("agent");
+        if (node.agent.empty() ||
+            sd.getBuf("node", &node_info, sizeof(node_info)) != NIXL_SUCCESS)
+            return NIXL_ERR_MISMATCH;
+        node.addr        = node_info.addr;
+        node.devId       = node_info.devId;
+        node.memType     = static_cast<nixl_mem_t>(node_info.memType);
+        node.numChildren = node_info.numChildren;
+    }
+    return NIXL_SUCCESS;
+}
+
+} // namespace
+
+/*** Block directory messages and shard placement ***/
+namespace {
+
+// Directory updates, queries and answers are carried by the backend notifications like
+// broadcast chunks, and are consumed by the agent within getNotifs.
+const std::string dir_prefix = "NIXL_DIR|";
+
+std::string
+dirMsgStr(const nixlDirMsg &msg) {
+    nixlSerDes sd;
+    const uint32_t num_agents = msg.agents.size();
+
+    sd.addBuf("op", &msg.op, sizeof(msg.op));
+    sd.addBuf("id", &msg.id, sizeof(msg.id));
+    sd.addBuf("agents", &num_agents, sizeof(num_agents));
+    for (auto &agent : msg.agents)
+        sd.addStr("agent", agent);
+    sd.addBuf("blocks", msg.blocks.data(), msg.blocks.size() * sizeof(nixlDirBlock));
+    return dir_prefix + sd.exportStr();
+}
+
+nixl_status_t
+dirMsgParse(const std::string &str, nixlDirMsg &msg) {
+    nixlSerDes sd;
+    uint32_t num_agents;
+
+    if (sd.importStr(str.substr(dir_prefix.size())) != NIXL_SUCCESS)
+        return NIXL_ERR_MISMATCH;
+
+    if (sd.getBuf("op", &msg.op, sizeof(msg.op)) != NIXL_SUCCESS ||
+        sd.getBuf("id", &msg.id, sizeof(msg.id)) != NIXL_SUCCESS ||
+        sd.getBuf("agents", &num_agents, sizeof(num_agents)) != NIXL_SUCCESS)
+        return NIXL_ERR_MISMATCH;
+
+    // Every agent takes more than a byte of the message, which bounds the count
+    if (num_agents > str.size())
+        return NIXL_ERR_MISMATCH;
+
+    msg.agents.resize(num_agents);
+    for (auto &agent : msg.agents) {
+        agent = sd.getStr("agent");
+        if (agent.empty())
+            return NIXL_ERR_MISMATCH;
+    }
+
+    const ssize_t len = sd.getBufLen("blocks");
+    if (len < 0 || len % sizeof(nixlDirBlock))
+        return NIXL_ERR_MISMATCH;
+    msg.blocks.resize(len / sizeof(nixlDirBlock));
+    if (sd.getBuf("blocks", msg.blocks.data(), len) != NIXL_SUCCESS)
+        return NIXL_ERR_MISMATCH;
+
+    for (auto &block : msg.blocks)
+        if (msg.op == nixl_dir_op_t::ANSWER && block.holder >= num_agents)
+            return NIXL_ERR_MISMATCH;
+    return NIXL_SUCCESS;
+}
+
+// Member hashes have to agree across processes, so std::hash is not used
+uint64_t
+dirNameHash(const std::string &name) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char c : name)
+        hash = (hash ^ c) * 0x100000001b3ULL;
+    return hash;
+}
+
+uint64_t
+dirMix(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+nixlDirBlock
+dirBlock(uint64_t key, const nixlDirEntry &entry, uint32_t holder = 0) {
+    return {key, entry.addr, entry.len, entry.devId,
+            static_cast<uint32_t>(entry.memType), holder};
+}
+
+nixlDirMsg &
+dirMsgTo(std::map<std::string, nixlDirMsg> &msgs, const std::string &agent, nixl_dir_op_t op,
+         uint64_t id = 0) {
+    auto it = msgs.find(agent);
+    if (it == msgs.end()) {
+        it = msgs.emplace(agent, nixlDirMsg()).first;
+        it->second.op = op;
+        it->second.id = id;
+    }
+    return it->second;
+}
+
+} // namespace
+
 /*** nixlAgentData constructor/destructor, as part of nixlAgent's ***/
 nixlAgentData::nixlAgentData(const std::string &name,
                              const nixlAgentConfig &cfg) :
@@ -73,6 +341,12 @@ nixlAgentData::nixlAgentData(const std::string &name,
         NIXL_DEBUG << "NIXL ETCD is disabled";
     }
 #endif // HAVE_ETCD
+    const char *md_server = getenv("NIXL_MD_SERVER");
+    mdServerAddr = md_server ? md_server : "";
+    useMDServer = !mdServerAddr.empty();
+    if (useMDServer)
+        NIXL_DEBUG << "NIXL metadata server is enabled: " << mdServerAddr;
+
     if (name.empty())
         throw std::invalid_argument("Agent needs a name");
 
@@ -86,6 +360,12 @@ nixlAgentData::~nixlAgentData() {
         delete elm.second;
 
     for (auto & elm: backendEngines) {
+        // Engines of shared instances only detach, the instance is destroyed with the last one
+        if (dynamic_cast<nixlSharedEngine*>(elm.second)) {
+            delete elm.second;
+            continue;
+        }
+
         auto& plugin_manager = nixlPluginManager::getInstance();
         auto plugin_handle = plugin_manager.getPlugin(elm.second->getType());
 
@@ -98,885 +378,3336 @@ nixlAgentData::~nixlAgentData() {
     for (auto & elm: backendHandles)
         delete elm.second;
 
-}
+    // After the backends, which may still route notifications until destroyed
+    for (auto & elm: notifSubs)
+        delete elm.second;
 
-/*** nixlAgent implementation ***/
-nixlAgent::nixlAgent(const std::string &name, const nixlAgentConfig &cfg) :
-    data(std::make_unique<nixlAgentData>(name, cfg))
-{
-    if(cfg.useListenThread) {
-        int my_port = cfg.listenPort;
-        if(my_port == 0) my_port = default_comm_port;
-        data->listener = new nixlMDStreamListener(my_port);
-        data->listener->setupListener();
+    // Also after the backends, which may still report completions until destroyed
+    for (auto & cq: complQueues) {
+        for (auto & req: cq->bound)
+            req->complQueue = nullptr;
+        delete cq;
     }
+}
 
-    if (data->useEtcd || cfg.useListenThread) {
-        data->commThreadStop = false;
-        data->commThread =
-            std::thread(&nixlAgentData::commWorker, data.get(), this);
+/*** nixlAgentData completion queues ***/
+void
+nixlAgentData::complXfer(nixlBackendReqH* handle, nixl_status_t status) {
+    const std::shared_lock<std::shared_mutex> cq_lock(complQueuesLock);
+    for (auto & cq : complQueues) {
+        const std::lock_guard<std::mutex> guard(cq->lock);
+        auto it = cq->armed.find(handle);
+        if (it == cq->armed.end())
+            continue;
+        cq->push(it->second, status);
+        cq->armed.erase(it);
+        return;
     }
 }
 
-nixlAgent::~nixlAgent() {
-    if (data && (data->useEtcd || data->config.useListenThread)) {
-        data->commThreadStop = true;
-        if(data->commThread.joinable()) data->commThread.join();
-
-        // Close remaining connections from comm thread
-        for (auto &[remote, fd] : data->remoteSockets) {
-            shutdown(fd, SHUT_RDWR);
-            close(fd);
-        }
+void
+nixlAgentData::checkPolledXfers(nixlComplQueueH* cq) {
+    const std::lock_guard<std::mutex> guard(cq->lock);
+    if (cq->polled.empty())
+        return;
+
+    // One batch per backend, so that its progress is made once for all the requests
+    std::unordered_map<nixlBackendEngine*, std::vector<nixlXferReqH*>> batches;
+    for (auto & req : cq->polled)
+        batches[req->engine].push_back(req);
+
+    std::vector<nixlBackendReqH*> handles;
+    std::vector<nixl_status_t> status;
+    for (auto & [engine, reqs] : batches) {
+        handles.clear();
+        for (auto & req : reqs)
+            handles.push_back(req->backendHandle);
+
+        if (engine->checkXfers(handles, status) != NIXL_SUCCESS)
+            continue;
 
-        if(data->config.useListenThread) {
-            if(data->listener) delete data->listener;
+        for (size_t i = 0; i < reqs.size(); i++) {
+            reqs[i]->status = status[i];
+            if (status[i] != NIXL_IN_PROG)
+                cq->push(reqs[i], status[i]);
         }
     }
-}
 
-nixl_status_t
-nixlAgent::getAvailPlugins (std::vector<nixl_backend_t> &plugins) {
-    auto& plugin_manager = nixlPluginManager::getInstance();
-    plugins = plugin_manager.getLoadedPluginNames();
-    return NIXL_SUCCESS;
+    cq->polled.erase(std::remove_if(cq->polled.begin(), cq->polled.end(),
+                                    [](const nixlXferReqH* req) {
+                                        return req->status != NIXL_IN_PROG;
+                                    }),
+                     cq->polled.end());
 }
 
+/*** nixlAgentData transfer graph execution ***/
 nixl_status_t
-nixlAgent::getPluginParams (const nixl_backend_t &type,
-                            nixl_mem_list_t &mems,
-                            nixl_b_params_t &params) const {
+nixlAgentData::postGraphReq(nixlXferReqH* req) {
+    nixl_opt_b_args_t opt_args;
 
-    // TODO: unify to uppercase/lowercase and do ltrim/rtrim for type
+    // Same as postXferReq, except that the handle is not released on errors
+    // since the graph still refers to it
+    NIXL_SHARED_LOCK_GUARD(lock);
+    if (remoteSections.count(req->remoteAgent) == 0)
+        return NIXL_ERR_NOT_FOUND;
 
-    // First try to get options from a loaded plugin
-    auto& plugin_manager = nixlPluginManager::getInstance();
-    auto plugin_handle = plugin_manager.getPlugin(type);
+    if (req->status == NIXL_IN_PROG) {
+        req->status = req->engine->checkXfer(req->backendHandle);
+        if (req->status == NIXL_IN_PROG)
+            return NIXL_ERR_REPOST_ACTIVE;
+    }
 
-    if (plugin_handle) {
-      // If the plugin is already loaded, get options directly
-        params = plugin_handle->getBackendOptions();
-        mems   = plugin_handle->getBackendMems();
-        return NIXL_SUCCESS;
+    opt_args.hasNotif = req->hasNotif;
+    if (req->hasNotif && !req->engine->supportsNotif())
+        return NIXL_ERR_BACKEND;
+    if (req->hasNotif)
+        opt_args.notifMsg = notifMsgTo(req->sharedNotif, req->remoteAgent, req->notifMsg);
+
+    req->status = req->engine->postXfer(req->backendOp,
+                                        *req->initiatorDescs,
+                                        *req->targetDescs,
+                                        req->remoteAgent,
+                                        req->backendHandle,
+                                        &opt_args);
+    return req->status;
+}
+
+nixl_status_t
+nixlAgentData::checkGraphReq(nixlXferReqH* req) {
+    NIXL_SHARED_LOCK_GUARD(lock);
+    if (req->status == NIXL_IN_PROG) {
+        if (remoteSections.count(req->remoteAgent) == 0)
+            return NIXL_ERR_NOT_FOUND;
+        req->status = req->engine->checkXfer(req->backendHandle);
     }
+    return req->status;
+}
 
-    // If plugin isn't loaded yet, try to load it temporarily
-    plugin_handle = plugin_manager.loadPlugin(type);
-    if (plugin_handle) {
-        params = plugin_handle->getBackendOptions();
-        mems   = plugin_handle->getBackendMems();
+std::chrono::microseconds
+nixlAgentData::hedgeDelayFor(const std::string &agent, double percentile) {
+    uint64_t us;
+    std::lock_guard<std::mutex> hedge_lock(hedgeLock);
+    auto it = readLatencies.find(agent);
+    if (it == readLatencies.end() || !it->second.percentile(percentile, us))
+        return hedge_default_delay;
+    return std::chrono::microseconds(us);
+}
 
-        NIXL_LOCK_GUARD(data->lock);
+void
+nixlAgentData::addReadLatency(const std::string &agent, std::chrono::microseconds latency) {
+    std::lock_guard<std::mutex> hedge_lock(hedgeLock);
+    readLatencies[agent].add(latency.count());
+}
 
-        // We don't keep the plugin loaded if we didn't have it before
-        if (data->backendEngines.count(type) == 0) {
-            plugin_manager.unloadPlugin(type);
+void
+nixlAgentData::finishReplicaRead(nixlReplicaXferReqH* req, size_t idx,
+                                 std::chrono::steady_clock::time_point now) {
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    const auto &winner = req->replicas[idx];
+    req->source = idx;
+    req->won    = true;
+    addReadLatency(winner.agent, duration_cast<microseconds>(now - winner.postTime));
+
+    if (winner.staging) {
+        size_t offset = 0;
+        for (auto &desc : req->localDescs) {
+            std::memcpy(reinterpret_cast<void*>(desc.addr), winner.staging.get() + offset,
+                        desc.len);
+            offset += desc.len;
         }
-        return NIXL_SUCCESS;
     }
 
-    return NIXL_ERR_NOT_FOUND;
+    for (size_t i = 0; i < req->nextRead; i++) {
+        auto &replica = req->replicas[i];
+        if (replica.status != NIXL_IN_PROG || replica.lost)
+            continue;
+        // Reads posted before the winner took at least that long, which is kept
+        // so that a stalled source is hedged sooner next time
+        if (replica.postTime <= winner.postTime)
+            addReadLatency(replica.agent,
+                           duration_cast<microseconds>(now - replica.postTime));
+        // Staged reads finish into their own buffer, others are waited for
+        replica.lost = (replica.staging != nullptr);
+    }
 }
 
 nixl_status_t
-nixlAgent::getBackendParams (const nixlBackendH* backend,
-                             nixl_mem_list_t &mems,
-                             nixl_b_params_t &params) const {
-    if (!backend)
-        return NIXL_ERR_INVALID_PARAM;
+nixlAgentData::stageReplicaRead(nixlAgent* myAgent, nixlReplicaXferReqH* req, size_t idx,
+                                nixl_xfer_dlist_t &staged_descs) {
+    auto &replica = req->replicas[idx];
+    replica.staging.reset(new char[req->stagingLen]);
+
+    nixl_reg_dlist_t reg_descs(DRAM_SEG);
+    reg_descs.addDesc(nixlBlobDesc(reinterpret_cast<uintptr_t>(replica.staging.get()),
+                                   req->stagingLen, 0));
+    nixl_status_t ret = myAgent->registerMem(reg_descs, &req->createArgs);
+    if (ret != NIXL_SUCCESS) {
+        replica.staging.reset();
+        return ret;
+    }
 
-    NIXL_LOCK_GUARD(data->lock);
-    mems   = backend->engine->getSupportedMems();
-    params = backend->engine->getCustomParams();
+    // The staging buffer holds the local descriptors back to back
+    size_t offset = 0;
+    for (auto &desc : req->localDescs) {
+        staged_descs.addDesc(nixlBasicDesc(
+                reinterpret_cast<uintptr_t>(replica.staging.get()) + offset, desc.len, 0));
+        offset += desc.len;
+    }
     return NIXL_SUCCESS;
 }
 
 nixl_status_t
-nixlAgent::createBackend(const nixl_backend_t &type,
-                         const nixl_b_params_t &params,
-                         nixlBackendH* &bknd_hndl) {
-
-    nixlBackendEngine*    backend = nullptr;
-    nixlBackendInitParams init_params;
-    nixl_mem_list_t       mems;
-    nixl_status_t         ret;
-    std::string           str;
-    backend_list_t*       backend_list;
-
-    NIXL_LOCK_GUARD(data->lock);
-    // Registering same type of backend is not supported, unlikely and prob error
-    if (data->backendEngines.count(type)!=0)
-        return NIXL_ERR_INVALID_PARAM;
+nixlAgentData::releaseReplicas(nixlAgent* myAgent, nixlReplicaXferReqH* req) {
+    nixl_status_t ret = NIXL_SUCCESS;
+    for (auto &replica : req->replicas) {
+        // The backend may still write to a staging buffer after a canceled read, so
+        // reads still in flight are released later, once done
+        if (replica.staging && replica.status == NIXL_IN_PROG)
+            replica.status = checkGraphReq(replica.req);
+        if (replica.staging && replica.status == NIXL_IN_PROG) {
+            std::lock_guard<std::mutex> staged_lock(stagedLock);
+            stagedReleases.push_back({replica.req, std::move(replica.staging),
+                                      req->stagingLen, req->createArgs});
+            continue;
+        }
 
-    init_params.localAgent   = data->name;
-    init_params.type         = type;
-    init_params.customParams = const_cast<nixl_b_params_t*>(&params);
-    init_params.enableProgTh = data->config.useProgThread;
-    init_params.pthrDelay    = data->config.pthrDelay;
-    init_params.syncMode     = data->config.syncMode;
+        if (replica.req && myAgent->releaseXferReq(replica.req) != NIXL_SUCCESS)
+            ret = NIXL_ERR_REPOST_ACTIVE;
+        if (replica.staging)
+            deregisterStaging(myAgent, replica.staging.get(), req->stagingLen,
+                              req->createArgs);
+    }
+    return ret;
+}
 
-    // First, try to load the backend as a plugin
-    auto& plugin_manager = nixlPluginManager::getInstance();
-    auto plugin_handle = plugin_manager.loadPlugin(type);
+void
+nixlAgentData::deregisterStaging(nixlAgent* myAgent, char* staging, size_t len,
+                                 const nixl_opt_args_t &args) {
+    nixl_reg_dlist_t reg_descs(DRAM_SEG);
+    reg_descs.addDesc(nixlBlobDesc(reinterpret_cast<uintptr_t>(staging), len, 0));
+    myAgent->deregisterMem(reg_descs, &args);
+}
 
-    if (plugin_handle) {
-        // Plugin found, use it to create the backend
-        backend = plugin_handle->createEngine(&init_params);
-    } else {
-        NIXL_ERROR << "Unsupported backend: " << type;
-        return NIXL_ERR_NOT_FOUND;
+void
+nixlAgentData::reapStagedReads(nixlAgent* myAgent) {
+    std::vector<nixlStagedRelease> staged;
+    {
+        std::lock_guard<std::mutex> staged_lock(stagedLock);
+        staged.swap(stagedReleases);
     }
+    if (staged.empty())
+        return;
 
-    if (backend) {
-        if (backend->getInitErr()) {
-            delete backend;
-            return NIXL_ERR_BACKEND;
+    std::vector<nixlStagedRelease> pending;
+    for (auto &read : staged) {
+        if (checkGraphReq(read.req) == NIXL_IN_PROG) {
+            pending.push_back(std::move(read));
+            continue;
         }
+        myAgent->releaseXferReq(read.req);
+        deregisterStaging(myAgent, read.staging.get(), read.len, read.args);
+    }
 
-        if (backend->supportsRemote()) {
-            ret = backend->getConnInfo(str);
-            if (ret != NIXL_SUCCESS) {
-                delete backend;
-                return ret;
-            }
-            data->connMD[type] = str;
+    std::lock_guard<std::mutex> staged_lock(stagedLock);
+    stagedReleases.insert(stagedReleases.end(), std::make_move_iterator(pending.begin()),
+                          std::make_move_iterator(pending.end()));
+}
+
+void
+nixlAgentData::progressGraph(nixlXferGraphH* graph, std::vector<size_t> &ready) {
+    // Ready nodes are passed in for the roots on post, later they are released
+    // by completions of running nodes. Ready nodes are posted right away and
+    // may in turn complete immediately and release their own successors.
+    std::vector<size_t> still_running;
+    for (auto &idx : graph->running) {
+        nixl_status_t ret = checkGraphReq(graph->nodes[idx].req);
+        if (ret == NIXL_IN_PROG) {
+            still_running.push_back(idx);
+        } else if (ret == NIXL_SUCCESS) {
+            graph->remaining--;
+            for (auto &succ : graph->nodes[idx].successors)
+                if (--graph->nodes[succ].pendingDeps == 0)
+                    ready.push_back(succ);
+        } else {
+            NIXL_ERROR << "Transfer graph request failed: " << nixlEnumStrings::statusStr(ret);
+            graph->status = ret;
+            return;
+        }
+    }
+    graph->running.swap(still_running);
+
+    while (!ready.empty()) {
+        const size_t idx = ready.back();
+        ready.pop_back();
+
+        auto &node = graph->nodes[idx];
+        nixl_status_t ret = postGraphReq(node.req);
+        if (ret == NIXL_IN_PROG) {
+            graph->running.push_back(idx);
+        } else if (ret == NIXL_SUCCESS) {
+            graph->remaining--;
+            for (auto &succ : node.successors)
+                if (--graph->nodes[succ].pendingDeps == 0)
+                    ready.push_back(succ);
+        } else {
+            NIXL_ERROR << "Failed to post transfer graph request: "
+                       << nixlEnumStrings::statusStr(ret);
+            graph->status = ret;
+            return;
         }
+    }
 
-        if (backend->supportsLocal()) {
-            ret = backend->connect(data->name);
+    if (graph->remaining == 0)
+        graph->status = NIXL_SUCCESS;
+}
 
-            if (NIXL_SUCCESS != ret) {
-                delete backend;
-                return ret;
-            }
-        }
+void
+nixlAgentData::graphWorker() {
+    std::unique_lock<std::mutex> graph_lock(graphLock);
+    std::vector<size_t> ready;
 
-        bknd_hndl = new nixlBackendH(backend);
-        if (!bknd_hndl) {
-            delete backend;
-            return NIXL_ERR_BACKEND;
+    while (!graphThreadStop) {
+        if (activeGraphs.empty()) {
+            graphCV.wait(graph_lock);
+            continue;
         }
 
-        data->backendEngines[type] = backend;
-        data->backendHandles[type] = bknd_hndl;
-        mems = backend->getSupportedMems();
-        for (auto & elm : mems) {
-            backend_list = &data->memToBackend[elm];
-            // First time creating this backend handle, so unique
-            // The order of creation sets the preference order
-            backend_list->push_back(backend);
+        for (auto &graph : activeGraphs) {
+            ready.clear();
+            progressGraph(graph, ready);
         }
 
-        if (backend->supportsRemote())
-            data->notifEngines.push_back(backend);
-
-        // TODO: Check if backend supports ProgThread
-        //       when threading is in agent
+        activeGraphs.erase(std::remove_if(activeGraphs.begin(), activeGraphs.end(),
+                                          [](nixlXferGraphH* graph) {
+                                              return graph->status != NIXL_IN_PROG;
+                                          }),
+                           activeGraphs.end());
+
+        // Backends have no completion event to wait on, so active graphs are
+        // polled at the progress thread interval. API calls on graphs get
+        // through while waiting, and new graphs wake the thread up early.
+        graphCV.wait_for(graph_lock, std::max(std::chrono::microseconds(config.pthrDelay),
+                                              graph_min_poll_interval));
+    }
+}
 
-        NIXL_DEBUG << "Created backend: " << type;
+void
+nixlAgentData::startGraphThread() {
+    if (!graphThread.joinable())
+        graphThread = std::thread(&nixlAgentData::graphWorker, this);
+}
 
-        return NIXL_SUCCESS;
+/*** nixlAgentData broadcast relaying ***/
+void
+nixlAgentData::relayBcastChunk(const nixlAgent* myAgent, const std::string &id,
+                               nixlBcastState &state, uint64_t offset, uint64_t len) {
+    const auto &tree = state.tree;
+    const bcastChunk chunk = {offset, len, state.total};
+
+    // The chunk is in the local buffer now, send it on to each child, along with the
+    // child's own part of the schedule if it's the first chunk it gets
+    nixl_xfer_dlist_t local_descs(tree[0].memType);
+    local_descs.addDesc(nixlBasicDesc(tree[0].addr + offset, len, tree[0].devId));
+
+    for (auto &child : bcastChildren(tree, 0)) {
+        nixl_xfer_dlist_t remote_descs(tree[child].memType);
+        remote_descs.addDesc(nixlBasicDesc(tree[child].addr + offset, len,
+                                           tree[child].devId));
+
+        nixl_opt_args_t extra_params;
+        extra_params.hasNotif = true;
+        extra_params.notifMsg = bcastMsg(id, state.src, state.msg, chunk, tree, child,
+                                         !state.treeSent);
+
+        nixlXferReqH* req = nullptr;
+        nixl_status_t ret = myAgent->createXferReq(NIXL_WRITE, local_descs, remote_descs,
+                                                   tree[child].agent, req, &extra_params);
+        if (ret == NIXL_SUCCESS)
+            ret = postGraphReq(req);
+
+        if (ret == NIXL_IN_PROG) {
+            state.relays.push_back(req);
+            continue;
+        }
+        if (ret < 0) {
+            NIXL_ERROR << "Failed to relay broadcast to " << tree[child].agent
+                       << ": " << nixlEnumStrings::statusStr(ret);
+            if (state.status == NIXL_IN_PROG)
+                state.status = ret;
+        }
+        if (req)
+            myAgent->releaseXferReq(req);
     }
-
-    return NIXL_ERR_BACKEND;
+    state.treeSent = true;
 }
 
 nixl_status_t
-nixlAgent::registerMem(const nixl_reg_dlist_t &descs,
-                       const nixl_opt_args_t* extra_params) {
+nixlAgentData::bcastSubtreeStatus(const nixlBcastState &state) const {
+    if (state.status != NIXL_IN_PROG)
+        return state.status;
+    if (state.tree.empty() || state.received < state.total || !state.relays.empty() ||
+        state.acks < state.tree[0].numChildren)
+        return NIXL_IN_PROG;
+    return NIXL_SUCCESS;
+}
 
-    backend_list_t* backend_list;
-    nixl_status_t   ret;
-    unsigned int    count = 0;
+void
+nixlAgentData::relayBcast(const nixlAgent* myAgent, const notif_list_t &bcast_msgs,
+                          nixl_notifs_t &notif_map) {
+    std::lock_guard<std::mutex> bcast_lock(bcastLock);
 
-    NIXL_LOCK_GUARD(data->lock);
-    if (!extra_params || extra_params->backends.size() == 0) {
-        backend_list = &data->memToBackend[descs.getType()];
-        if (backend_list->empty())
+    for (auto &elm : bcast_msgs) {
+        bcastMsgInfo info;
+        if (bcastParse(elm.second, info) != NIXL_SUCCESS) {
+            NIXL_ERROR << "Invalid broadcast message received from " << elm.first;
+            continue;
+        }
+
+        // Statuses of finished or released broadcasts are dropped
+        if (info.isAck) {
+            auto it = bcastStates.find(info.id);
+            if (it == bcastStates.end())
+                continue;
+            if (info.ack == NIXL_SUCCESS) {
+                it->second.acks++;
+            } else if (it->second.status == NIXL_IN_PROG) {
+                NIXL_ERROR << "Broadcast failed in the subtree of " << elm.first << ": "
+                           << nixlEnumStrings::statusStr(info.ack);
+                it->second.status = info.ack;
+            }
+            continue;
+        }
+
+        auto &state = bcastStates[info.id];
+        if (state.total == 0) {
+            state.parent = elm.first;
+            state.total  = info.chunk.total;
+        }
+        state.received += info.chunk.len;
+        state.pending.emplace_back(info.chunk.offset, info.chunk.len);
+        if (!info.tree.empty()) {
+            state.tree = std::move(info.tree);
+            state.src  = std::move(info.src);
+            state.msg  = std::move(info.msg);
+        }
+        if (state.tree.empty())
+            continue;
+
+        for (auto &chunk : state.pending)
+            relayBcastChunk(myAgent, info.id, state, chunk.first, chunk.second);
+        state.pending.clear();
+    }
+
+    for (auto it = bcastStates.begin(); it != bcastStates.end();) {
+        auto &state = it->second;
+
+        std::vector<nixlXferReqH*> still_running;
+        for (auto &req : state.relays) {
+            nixl_status_t ret = checkGraphReq(req);
+            if (ret == NIXL_IN_PROG) {
+                still_running.push_back(req);
+                continue;
+            }
+            if (ret < 0) {
+                NIXL_ERROR << "Broadcast relay to " << req->remoteAgent
+                           << " failed: " << nixlEnumStrings::statusStr(ret);
+                if (state.status == NIXL_IN_PROG)
+                    state.status = ret;
+            }
+            myAgent->releaseXferReq(req);
+        }
+        state.relays.swap(still_running);
+
+        // The initiator's status is checked by getBcastStatus
+        if (state.parent.empty()) {
+            ++it;
+            continue;
+        }
+
+        // The user is notified once, when the whole buffer has arrived
+        if (!state.notified && !state.tree.empty() && state.received >= state.total) {
+            notif_map[state.src].push_back(state.msg);
+            state.notified = true;
+        }
+
+        const nixl_status_t status = bcastSubtreeStatus(state);
+        if (!state.reported && status != NIXL_IN_PROG) {
+            nixl_status_t ret = myAgent->genNotif(state.parent, bcastAckMsg(it->first, status));
+            if (ret != NIXL_SUCCESS)
+                NIXL_ERROR << "Failed to report broadcast status to " << state.parent << ": "
+                           << nixlEnumStrings::statusStr(ret);
+            state.reported = true;
+        }
+
+        // Failed subtrees are kept until all chunks arrived, so that late ones are dropped
+        if (state.reported && state.relays.empty() && state.received >= state.total)
+            it = bcastStates.erase(it);
+        else
+            ++it;
+    }
+}
+
+/*** nixlAgentData block directory ***/
+const std::string&
+nixlAgentData::dirHome(uint64_t key) const {
+    // Rendezvous hashing, only the keys of a changed member move
+    size_t   home = 0;
+    uint64_t best = 0;
+    for (size_t i = 0; i < dirMembers.size(); i++) {
+        const uint64_t score = dirMix(key ^ dirMembers[i].second);
+        if (i == 0 || score > best) {
+            best = score;
+            home = i;
+        }
+    }
+    return dirMembers[home].first;
+}
+
+void
+nixlAgentData::dirApply(const std::string &src, const nixlDirMsg &msg, nixl_dir_msgs_t &out) {
+    switch (msg.op) {
+    case nixl_dir_op_t::PUBLISH:
+    case nixl_dir_op_t::UNPUBLISH:
+        for (auto &block : msg.blocks) {
+            auto &entries = dirShard[block.key];
+            entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                         [&src](const nixlDirEntry &entry) {
+                                             return entry.agent == src;
+                                         }),
+                          entries.end());
+            // The last holder to publish a key is the first one returned
+            if (msg.op == nixl_dir_op_t::PUBLISH)
+                entries.push_back({src, block.addr, block.len, block.devId,
+                                   static_cast<nixl_mem_t>(block.memType)});
+            if (entries.empty())
+                dirShard.erase(block.key);
+        }
+        break;
+
+    case nixl_dir_op_t::QUERY: {
+        // Queries are always answered, so that the lookup knows this shard is done
+        nixlDirMsg answer;
+        std::unordered_map<std::string, uint32_t> holders;
+        answer.op = nixl_dir_op_t::ANSWER;
+        answer.id = msg.id;
+        for (auto &block : msg.blocks) {
+            auto it = dirShard.find(block.key);
+            if (it == dirShard.end())
+                continue;
+            const nixlDirEntry &entry = it->second.back();
+            auto holder = holders.emplace(entry.agent, answer.agents.size());
+            if (holder.second)
+                answer.agents.push_back(entry.agent);
+            answer.blocks.push_back(dirBlock(block.key, entry, holder.first->second));
+        }
+        out.emplace_back(src, std::move(answer));
+        break;
+    }
+
+    case nixl_dir_op_t::ANSWER: {
+        auto it = dirLookups.find(msg.id);
+        if (it == dirLookups.end())
+            break; // Released before the answer arrived
+        nixlDirLookupH* lookup = it->second;
+        for (auto &block : msg.blocks)
+            lookup->found[block.key] = {msg.agents[block.holder], block.addr, block.len,
+                                        block.devId, static_cast<nixl_mem_t>(block.memType)};
+        if (--lookup->pendingShards == 0)
+            lookup->status = NIXL_SUCCESS;
+        break;
+    }
+    }
+}
+
+void
+nixlAgentData::handleDir(const nixlAgent* myAgent, const notif_list_t &dir_msgs) {
+    nixl_dir_msgs_t out;
+    {
+        std::lock_guard<std::mutex> dir_lock(dirLock);
+        for (auto &elm : dir_msgs) {
+            nixlDirMsg msg;
+            if (dirMsgParse(elm.second, msg) != NIXL_SUCCESS) {
+                NIXL_ERROR << "Invalid directory message received from " << elm.first;
+                continue;
+            }
+            dirApply(elm.first, msg, out);
+        }
+    }
+
+    // Failures to answer are only logged, the lookup of the requester stays in progress
+    sendDir(myAgent, out);
+}
+
+nixl_status_t
+nixlAgentData::sendDir(const nixlAgent* myAgent, nixl_dir_msgs_t &msgs) {
+    nixl_status_t ret = NIXL_SUCCESS;
+
+    // Messages to this agent are applied directly, a query can add its answer to the list
+    for (size_t i = 0; i < msgs.size(); i++) {
+        if (msgs[i].first != name)
+            continue;
+        std::lock_guard<std::mutex> dir_lock(dirLock);
+        nixlDirMsg msg = std::move(msgs[i].second);
+        dirApply(name, msg, msgs);
+    }
+
+    for (auto &[agent, msg] : msgs) {
+        if (agent == name)
+            continue;
+        nixl_status_t status = myAgent->genNotif(agent, dirMsgStr(msg));
+        if (status != NIXL_SUCCESS) {
+            NIXL_ERROR << "Failed to send directory message to " << agent << ": "
+                       << nixlEnumStrings::statusStr(status);
+            ret = status;
+        }
+    }
+    return ret;
+}
+
+bool
+nixlAgentData::dirRegistered(const nixlDirEntry &entry) {
+    nixlMemSection* section = memorySection;
+    if (entry.agent != name) {
+        auto it = remoteSections.find(entry.agent);
+        if (it == remoteSections.end())
+            return false;
+        section = it->second;
+    }
+
+    backend_set_t* backends = section->queryBackends(entry.memType);
+    if (!backends)
+        return false;
+
+    nixl_xfer_dlist_t descs(entry.memType);
+    descs.addDesc(nixlBasicDesc(entry.addr, entry.len, entry.devId));
+    for (auto &backend : *backends) {
+        nixl_meta_dlist_t resp(entry.memType);
+        if (section->populate(descs, backend, resp) == NIXL_SUCCESS)
+            return true;
+    }
+    return false;
+}
+
+nixl_status_t
+nixlAgentData::unpublishDeregistered(const nixlAgent* myAgent,
+                                     const nixl_reg_dlist_t &descs) {
+    std::map<std::string, nixlDirMsg> unpublish;
+    {
+        std::lock_guard<std::mutex> dir_lock(dirLock);
+        for (auto it = dirPublished.begin(); it != dirPublished.end();) {
+            const nixlBasicDesc block(it->second.addr, it->second.len, it->second.devId);
+            bool deregistered = false;
+            if (it->second.memType == descs.getType())
+                for (auto &desc : descs)
+                    deregistered = deregistered || desc.overlaps(block);
+
+            if (!deregistered) {
+                ++it;
+                continue;
+            }
+            if (!dirMembers.empty())
+                dirMsgTo(unpublish, dirHome(it->first), nixl_dir_op_t::UNPUBLISH)
+                    .blocks.push_back(dirBlock(it->first, it->second));
+            it = dirPublished.erase(it);
+        }
+    }
+
+    nixl_dir_msgs_t msgs(std::make_move_iterator(unpublish.begin()),
+                         std::make_move_iterator(unpublish.end()));
+    return sendDir(myAgent, msgs);
+}
+
+/*** nixlAgentData notification routing ***/
+bool
+nixlAgentData::routeNotif(const std::string &remote_agent, nixl_blob_t &msg) {
+    // Notifications of shared backend instances are routed by their source agent and message,
+    // msg is only changed if routed, otherwise the caller queues it as received
+    std::string src, dst;
+    nixl_blob_t inner;
+    if (sharedNotifParse(msg, src, dst, inner))
+        return routeNotif(src, inner);
+
+    // Broadcast chunks and directory messages are consumed by the agent, they're never
+    // passed to a subscription
+    if (msg.compare(0, bcast_prefix.size(), bcast_prefix) == 0 ||
+        msg.compare(0, dir_prefix.size(), dir_prefix) == 0)
+        return false;
+
+    std::shared_lock<std::shared_mutex> sub_lock(notifSubLock);
+    // Lengths are in decreasing order, so the first match is the longest prefix
+    for (auto &len : notifSubLens) {
+        if (len.first > msg.size())
+            continue;
+
+        auto it = notifSubs.find(std::string_view(msg).substr(0, len.first));
+        if (it == notifSubs.end())
+            continue;
+
+        nixlNotifSubH* sub = it->second;
+        std::lock_guard<std::mutex> queue_lock(sub->lock);
+        sub->queue.emplace_back(remote_agent, std::move(msg));
+        return true;
+    }
+
+    return false;
+}
+
+bool
+nixlAgentData::handleNotif(const std::string &remote_agent, nixl_blob_t &msg) {
+    std::string src, dst;
+    nixl_blob_t inner;
+    const bool shared = sharedNotifParse(msg, src, dst, inner);
+    const nixl_blob_t &body = shared ? inner : msg;
+
+    // Broadcast chunks and directory messages post transfers and notifications when
+    // processed, which isn't done on the progress thread of the backend
+    if (body.compare(0, bcast_prefix.size(), bcast_prefix) == 0 ||
+        body.compare(0, dir_prefix.size(), dir_prefix) == 0) {
+        std::lock_guard<std::mutex> agent_msgs_lock(notifAgentLock);
+        if (shared)
+            notifAgentMsgs.emplace_back(std::move(src), std::move(inner));
+        else
+            notifAgentMsgs.emplace_back(remote_agent, std::move(msg));
+        notifAgentQueued = true;
+        return true;
+    }
+
+    return shared ? routeNotif(src, inner) : routeNotif(remote_agent, msg);
+}
+
+void
+nixlAgentData::keepUnrouted(nixlBackendEngine* engine, notif_list_t &notifs) {
+    if (notifs.empty())
+        return;
+
+    notif_list_t &kept = notifUnrouted[engine];
+    kept.insert(kept.end(), std::make_move_iterator(notifs.begin()),
+                std::make_move_iterator(notifs.end()));
+    notifs.clear();
+}
+
+void
+nixlAgentData::trimUnrouted() {
+    // Without subscriptions, notifications are only drained along lookups and broadcasts,
+    // and getNotifs still gets all of them
+    {
+        std::shared_lock<std::shared_mutex> sub_lock(notifSubLock);
+        if (notifSubs.empty())
+            return;
+    }
+
+    for (auto &[engine, kept] : notifUnrouted) {
+        if (kept.size() <= notif_unrouted_max)
+            continue;
+        const size_t dropped = kept.size() - notif_unrouted_max;
+        NIXL_WARN << "Dropping " << dropped << " notifications not retrieved by getNotifs";
+        kept.erase(kept.begin(), kept.begin() + dropped);
+    }
+}
+
+nixl_status_t
+nixlAgentData::drainNotifs(const backend_list_t &backends, notif_list_t &agent_msgs) {
+    notif_list_t  bknd_notif_list, unrouted;
+    nixl_status_t ret, bad_ret = NIXL_SUCCESS;
+
+    if (notifAgentQueued) {
+        std::lock_guard<std::mutex> agent_msgs_lock(notifAgentLock);
+        agent_msgs.insert(agent_msgs.end(), std::make_move_iterator(notifAgentMsgs.begin()),
+                          std::make_move_iterator(notifAgentMsgs.end()));
+        notifAgentMsgs.clear();
+        notifAgentQueued = false;
+    }
+
+    // Doing best effort, if any backend errors out we return
+    // error but proceed with the rest. We can add metadata about
+    // the backend to the msg, but user could put it themselves.
+    for (auto &eng : backends) {
+        bknd_notif_list.clear();
+        ret = eng->getNotifs(bknd_notif_list);
+        if (ret < 0)
+            bad_ret = ret;
+
+        for (auto &elm : bknd_notif_list) {
+            std::string src, dst;
+            nixl_blob_t inner;
+            if (sharedNotifParse(elm.second, src, dst, inner)) {
+                elm.first  = std::move(src);
+                elm.second = std::move(inner);
+            }
+
+            // Broadcast chunks and directory messages are handled by the agent, not passed
+            // to the user
+            if (elm.second.compare(0, bcast_prefix.size(), bcast_prefix) == 0 ||
+                elm.second.compare(0, dir_prefix.size(), dir_prefix) == 0)
+                agent_msgs.push_back(std::move(elm));
+            else if (!routeNotif(elm.first, elm.second))
+                unrouted.push_back(std::move(elm));
+        }
+        keepUnrouted(eng, unrouted);
+    }
+
+    return bad_ret;
+}
+
+void
+nixlAgentData::relayDrained(const nixlAgent* myAgent, notif_list_t &agent_msgs) {
+    nixl_notifs_t completed;
+    notif_list_t  bcast_msgs, dir_msgs, unrouted;
+
+    for (auto &elm : agent_msgs) {
+        if (elm.second.compare(0, dir_prefix.size(), dir_prefix) == 0)
+            dir_msgs.push_back(std::move(elm));
+        else
+            bcast_msgs.push_back(std::move(elm));
+    }
+
+    // Shards answer queries before relays are posted, as lookups are latency sensitive
+    if (!dir_msgs.empty())
+        handleDir(myAgent, dir_msgs);
+    relayBcast(myAgent, bcast_msgs, completed);
+    for (auto &elm : completed)
+        for (auto &msg : elm.second)
+            if (!routeNotif(elm.first, msg))
+                unrouted.emplace_back(elm.first, std::move(msg));
+    keepUnrouted(nullptr, unrouted);
+}
+
+bool
+nixlAgentData::sharedNotifTo(nixlBackendEngine* engine, const std::string &remote_agent) const {
+    if (sharedEngines.count(engine) != 0)
+        return true;
+
+    auto remote = remoteBackends.find(remote_agent);
+    if (remote == remoteBackends.end())
+        return false;
+    auto conn = remote->second.find(engine->getType());
+    return conn != remote->second.end() &&
+           conn->second.compare(0, shared_prefix.size(), shared_prefix) == 0;
+}
+
+nixl_blob_t
+nixlAgentData::notifMsgTo(bool shared, const std::string &remote_agent,
+                          const nixl_blob_t &msg) const {
+    return shared ? sharedNotifMsg(name, remote_agent, msg) : msg;
+}
+
+/*** nixlAgentData asynchronous registration ***/
+void
+nixlAgentData::regWorker() {
+    std::unique_lock<std::mutex> queue_lock(regQueueLock);
+    while (true) {
+        regQueueCV.wait(queue_lock, [this]() { return regThreadStop || !regQueue.empty(); });
+        // Queued work is drained before stopping, so pending requests still complete
+        if (regQueue.empty())
+            return;
+
+        auto task = std::move(regQueue.front());
+        regQueue.pop_front();
+        queue_lock.unlock();
+        task();
+        queue_lock.lock();
+    }
+}
+
+void
+nixlAgentData::enqueueRegWork(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> queue_lock(regQueueLock);
+        if (regThreads.empty()) {
+            unsigned int num_threads = config.regThreads;
+            if (num_threads == 0)
+                num_threads = std::max(1u, std::thread::hardware_concurrency());
+            for (unsigned int i = 0; i < num_threads; ++i)
+                regThreads.emplace_back(&nixlAgentData::regWorker, this);
+        }
+        regQueue.push_back(std::move(task));
+    }
+    regQueueCV.notify_one();
+}
+
+std::mutex*
+nixlAgentData::getRegEngineLock(nixlBackendEngine* engine, nixl_mem_t mem) {
+    if (engine->supportsParallelReg(mem))
+        return nullptr;
+
+    auto &engine_lock = regEngineLocks[engine];
+    if (!engine_lock)
+        engine_lock = std::make_unique<std::mutex>();
+    return engine_lock.get();
+}
+
+void
+nixlAgentData::runRegTask(nixlRegReqH* req, size_t backend_idx, int first, int last) {
+    auto &bknd              = req->backends[backend_idx];
+    nixlBackendEngine* eng  = bknd.engine;
+    nixl_mem_t mem          = req->descs.getType();
+
+    for (int i = first; i < last; ++i) {
+        {
+            // Stop early if another region failed with this backend
+            std::lock_guard<std::mutex> req_lock(req->lock);
+            if (bknd.status != NIXL_SUCCESS)
+                break;
+        }
+
+        nixlSectionDesc local_sec, self_sec;
+        nixl_status_t ret;
+        {
+            std::unique_lock<std::mutex> engine_lock;
+            if (bknd.engineLock)
+                engine_lock = std::unique_lock<std::mutex>(*bknd.engineLock);
+            ret = nixlLocalSection::registerDesc(req->descs[i], mem, eng, local_sec, self_sec);
+        }
+
+        if (ret != NIXL_SUCCESS) {
+            std::lock_guard<std::mutex> req_lock(req->lock);
+            bknd.status = ret;
+            break;
+        }
+
+        // Make the region available for transfers right away
+        nixl_sec_dlist_t local_descs(mem, false);
+        nixl_sec_dlist_t self_descs(mem, false);
+        local_descs.addDesc(local_sec);
+        {
+            NIXL_LOCK_GUARD(lock);
+            memorySection->insertDescList(local_descs, eng);
+            if (eng->supportsLocal()) {
+                self_descs.addDesc(self_sec);
+                if (remoteSections.count(name) == 0)
+                    remoteSections[name] = new nixlRemoteSection(name);
+                remoteSections[name]->loadLocalData(self_descs, eng);
+            }
+        }
+
+        std::lock_guard<std::mutex> req_lock(req->lock);
+        bknd.localDescs.addDesc(local_sec);
+        if (eng->supportsLocal())
+            bknd.selfDescs.addDesc(self_sec);
+    }
+
+    finishRegTask(req, backend_idx);
+}
+
+void
+nixlAgentData::runDeregTask(nixlRegReqH* req, size_t backend_idx, int first, int last) {
+    auto &bknd = req->backends[backend_idx];
+
+    for (int i = first; i < last; ++i) {
+        std::unique_lock<std::mutex> engine_lock;
+        if (bknd.engineLock)
+            engine_lock = std::unique_lock<std::mutex>(*bknd.engineLock);
+
+        nixl_status_t ret = bknd.engine->deregisterMem(bknd.localDescs[i].metadataP);
+        if (ret != NIXL_SUCCESS) {
+            std::lock_guard<std::mutex> req_lock(req->lock);
+            bknd.status = ret;
+        }
+    }
+
+    finishRegTask(req, backend_idx);
+}
+
+void
+nixlAgentData::finishRegTask(nixlRegReqH* req, size_t backend_idx) {
+    auto &bknd = req->backends[backend_idx];
+    bool rollback;
+    {
+        std::lock_guard<std::mutex> req_lock(req->lock);
+        rollback = (--bknd.pendingTasks == 0) && !req->dereg &&
+                   (bknd.status != NIXL_SUCCESS) && (bknd.localDescs.descCount() > 0);
+    }
+
+    // Same as registerMem, registration with a backend is all or nothing
+    if (rollback) {
+        nixlBackendEngine* eng = bknd.engine;
+        nixl_reg_dlist_t registered(req->descs.getType());
+        for (auto &elm : bknd.localDescs)
+            registered.addDesc(nixlBlobDesc(elm, ""));
+
+        NIXL_LOCK_GUARD(lock);
+        std::unique_lock<std::mutex> engine_lock;
+        if (bknd.engineLock)
+            engine_lock = std::unique_lock<std::mutex>(*bknd.engineLock);
+
+        if (eng->supportsLocal()) {
+            remoteSections[name]->remLocalData(bknd.selfDescs, eng);
+            for (int i = 0; i < bknd.localDescs.descCount(); ++i)
+                if (bknd.selfDescs[i].metadataP != bknd.localDescs[i].metadataP)
+                    eng->unloadMD(bknd.selfDescs[i].metadataP);
+        }
+        memorySection->remDescList(registered, eng);
+    }
+
+    std::lock_guard<std::mutex> req_lock(req->lock);
+    if (--req->pendingTasks > 0)
+        return;
+
+    // Registration succeeds if any backend succeeded, deregistration if all did
+    unsigned int count = 0;
+    nixl_status_t bad_ret = NIXL_SUCCESS;
+    for (auto &elm : req->backends) {
+        if (elm.status == NIXL_SUCCESS)
+            count++;
+        else
+            bad_ret = elm.status;
+    }
+
+    if (req->dereg)
+        req->status = bad_ret;
+    else
+        req->status = (count > 0) ? NIXL_SUCCESS : NIXL_ERR_BACKEND;
+    req->cv.notify_all();
+}
+
+/*** nixlAgent implementation ***/
+nixlAgent::nixlAgent(const std::string &name, const nixlAgentConfig &cfg) :
+    data(std::make_unique<nixlAgentData>(name, cfg))
+{
+    if(cfg.useListenThread) {
+        int my_port = cfg.listenPort;
+        if(my_port == 0) my_port = default_comm_port;
+        data->listener = new nixlMDStreamListener(my_port);
+        data->listener->setupListener();
+    }
+
+    if (data->useEtcd || data->useMDServer || cfg.useListenThread) {
+        data->commThreadStop = false;
+        data->commThread =
+            std::thread(&nixlAgentData::commWorker, data.get(), this);
+    }
+
+}
+
+nixlAgent::~nixlAgent() {
+    if (data && data->graphThread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(data->graphLock);
+            data->graphThreadStop = true;
+        }
+        data->graphCV.notify_all();
+        data->graphThread.join();
+    }
+
+    if (data) {
+        for (auto &state : data->bcastStates)
+            for (auto &req : state.second.relays)
+                releaseXferReq(req);
+        data->bcastStates.clear();
+
+        // Reads that still can't be aborted keep their staging buffer, as the backend
+        // may write to it until it is destroyed
+        for (auto &read : data->stagedReleases) {
+            if (releaseXferReq(read.req) != NIXL_SUCCESS) {
+                NIXL_WARN << "Leaking the staging buffer of a replicated read in progress";
+                read.staging.release();
+                continue;
+            }
+            data->deregisterStaging(this, read.staging.get(), read.len, read.args);
+        }
+        data->stagedReleases.clear();
+    }
+
+    if (data) {
+        {
+            std::lock_guard<std::mutex> queue_lock(data->regQueueLock);
+            data->regThreadStop = true;
+        }
+        data->regQueueCV.notify_all();
+        for (auto &thread : data->regThreads)
+            thread.join();
+    }
+
+    if (data && (data->useEtcd || data->useMDServer || data->config.useListenThread)) {
+        data->commThreadStop = true;
+        if(data->commThread.joinable()) data->commThread.join();
+
+        // Close remaining connections from comm thread
+        for (auto &[remote, fd] : data->remoteSockets) {
+            shutdown(fd, SHUT_RDWR);
+            close(fd);
+        }
+
+        if(data->config.useListenThread) {
+            if(data->listener) delete data->listener;
+        }
+    }
+}
+
+nixl_status_t
+nixlAgent::getAvailPlugins (std::vector<nixl_backend_t> &plugins) {
+    auto& plugin_manager = nixlPluginManager::getInstance();
+    plugins = plugin_manager.getLoadedPluginNames();
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t
+nixlAgent::getPluginParams (const nixl_backend_t &type,
+                            nixl_mem_list_t &mems,
+                            nixl_b_params_t &params) const {
+
+    // TODO: unify to uppercase/lowercase and do ltrim/rtrim for type
+
+    // First try to get options from a loaded plugin
+    auto& plugin_manager = nixlPluginManager::getInstance();
+    auto plugin_handle = plugin_manager.getPlugin(type);
+
+    if (plugin_handle) {
+      // If the plugin is already loaded, get options directly
+        params = plugin_handle->getBackendOptions();
+        mems   = plugin_handle->getBackendMems();
+        return NIXL_SUCCESS;
+    }
+
+    // If plugin isn't loaded yet, try to load it temporarily
+    plugin_handle = plugin_manager.loadPlugin(type);
+    if (plugin_handle) {
+        params = plugin_handle->getBackendOptions();
+        mems   = plugin_handle->getBackendMems();
+
+        NIXL_LOCK_GUARD(data->lock);
+
+        // We don't keep the plugin loaded if we didn't have it before
+        if (data->backendEngines.count(type) == 0) {
+            plugin_manager.unloadPlugin(type);
+        }
+        return NIXL_SUCCESS;
+    }
+
+    return NIXL_ERR_NOT_FOUND;
+}
+
+nixl_status_t
+nixlAgent::getBackendParams (const nixlBackendH* backend,
+                             nixl_mem_list_t &mems,
+                             nixl_b_params_t &params) const {
+    if (!backend)
+        return NIXL_ERR_INVALID_PARAM;
+
+    NIXL_LOCK_GUARD(data->lock);
+    mems   = backend->engine->getSupportedMems();
+    params = backend->engine->getCustomParams();
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t
+nixlAgent::createBackend(const nixl_backend_t &type,
+                         const nixl_b_params_t &params,
+                         nixlBackendH* &bknd_hndl) {
+
+    nixlBackendEngine*    backend = nullptr;
+    nixlBackendInitParams init_params;
+    nixl_mem_list_t       mems;
+    nixl_status_t         ret;
+    std::string           str;
+    backend_list_t*       backend_list;
+
+    NIXL_LOCK_GUARD(data->lock);
+    // Registering same type of backend is not supported, unlikely and prob error
+    if (data->backendEngines.count(type)!=0)
+        return NIXL_ERR_INVALID_PARAM;
+
+    init_params.localAgent   = data->name;
+    init_params.type         = type;
+    init_params.customParams = const_cast<nixl_b_params_t*>(&params);
+    init_params.enableProgTh = data->config.useProgThread;
+    init_params.pthrDelay    = data->config.pthrDelay;
+    init_params.syncMode     = data->config.syncMode;
+
+    if (params.count(shared_instance_param) != 0) {
+        // Attach to the instance shared by the agents of the process, created on first use
+        std::shared_ptr<nixlSharedBackend> instance;
+        ret = nixlSharedBackend::attach(&init_params, instance);
+        if (ret != NIXL_SUCCESS)
+            return ret;
+        backend = new nixlSharedEngine(&init_params, instance);
+    } else {
+        // First, try to load the backend as a plugin
+        auto& plugin_manager = nixlPluginManager::getInstance();
+        auto plugin_handle = plugin_manager.loadPlugin(type);
+
+        if (plugin_handle) {
+            // Plugin found, use it to create the backend
+            backend = plugin_handle->createEngine(&init_params);
+        } else {
+            NIXL_ERROR << "Unsupported backend: " << type;
+            return NIXL_ERR_NOT_FOUND;
+        }
+    }
+
+    if (backend) {
+        if (backend->getInitErr()) {
+            delete backend;
+            return NIXL_ERR_BACKEND;
+        }
+
+        if (backend->supportsRemote()) {
+            ret = backend->getConnInfo(str);
+            if (ret != NIXL_SUCCESS) {
+                delete backend;
+                return ret;
+            }
+            data->connMD[type] = str;
+        }
+
+        if (backend->supportsLocal()) {
+            ret = backend->connect(data->name);
+
+            if (NIXL_SUCCESS != ret) {
+                delete backend;
+                return ret;
+            }
+        }
+
+        bknd_hndl = new nixlBackendH(backend);
+        if (!bknd_hndl) {
+            delete backend;
+            return NIXL_ERR_BACKEND;
+        }
+
+        data->backendEngines[type] = backend;
+        if (params.count(shared_instance_param) != 0)
+            data->sharedEngines.insert(backend);
+        data->backendHandles[type] = bknd_hndl;
+        mems = backend->getSupportedMems();
+        for (auto & elm : mems) {
+            backend_list = &data->memToBackend[elm];
+            // First time creating this backend handle, so unique
+            // The order of creation sets the preference order
+            backend_list->push_back(backend);
+        }
+
+        if (backend->supportsRemote()) {
+            data->notifEngines.push_back(backend);
+
+            // Subscriptions are served without draining if the backend routes notifications
+            // on its own progress thread
+            nixlAgentData* agent_data = data.get();
+            ret = backend->setNotifHandler(
+                    [agent_data](const std::string &remote_agent, nixl_blob_t &msg) {
+                        return agent_data->handleNotif(remote_agent, msg);
+                    });
+            if (ret != NIXL_SUCCESS || !backend->supportsProgTh())
+                data->notifDrainNeeded = true;
+        }
+
+        // Transfers of backends without a completion handler are checked by the queues
+        nixlAgentData* agent_data = data.get();
+        ret = backend->setXferComplHandler(
+                [agent_data](nixlBackendReqH* handle, nixl_status_t status) {
+                    agent_data->complXfer(handle, status);
+                });
+        if (ret == NIXL_SUCCESS)
+            data->complEngines.insert(backend);
+
+        // TODO: Check if backend supports ProgThread
+        //       when threading is in agent
+
+        NIXL_DEBUG << "Created backend: " << type;
+
+        return NIXL_SUCCESS;
+    }
+
+    return NIXL_ERR_BACKEND;
+}
+
+nixl_status_t
+nixlAgent::registerMem(const nixl_reg_dlist_t &descs,
+                       const nixl_opt_args_t* extra_params) {
+
+    backend_list_t* backend_list;
+    nixl_status_t   ret;
+    unsigned int    count = 0;
+
+    NIXL_LOCK_GUARD(data->lock);
+    if (!extra_params || extra_params->backends.size() == 0) {
+        backend_list = &data->memToBackend[descs.getType()];
+        if (backend_list->empty())
+            return NIXL_ERR_NOT_FOUND;
+    } else {
+        backend_list = new backend_list_t();
+        for (auto & elm : extra_params->backends)
+            backend_list->push_back(elm->engine);
+    }
+
+    // Best effort, if at least one succeeds NIXL_SUCCESS is returned
+    // Can become more sophisticated to have a soft error case
+    for (size_t i=0; i<backend_list->size(); ++i) {
+        nixlBackendEngine* backend = (*backend_list)[i];
+        // meta_descs use to be passed to loadLocalData
+        nixl_sec_dlist_t sec_descs(descs.getType(), false);
+        std::unique_lock<std::mutex> engine_lock;
+        if (auto *reg_lock = data->getRegEngineLock(backend, descs.getType()))
+            engine_lock = std::unique_lock<std::mutex>(*reg_lock);
+        ret = data->memorySection->addDescList(descs, backend, sec_descs);
+        if (ret == NIXL_SUCCESS) {
+            if (backend->supportsLocal()) {
+                if (data->remoteSections.count(data->name) == 0)
+                    data->remoteSections[data->name] =
+                          new nixlRemoteSection(data->name);
+
+                ret = data->remoteSections[data->name]->loadLocalData(
+                                                        sec_descs, backend);
+                if (ret == NIXL_SUCCESS)
+                    count++;
+                else
+                    data->memorySection->remDescList(descs, backend);
+            } else {
+                count++;
+            }
+        } // a bad_ret can be saved in an else
+    }
+
+    if (extra_params && extra_params->backends.size() > 0)
+        delete backend_list;
+
+    if (count > 0)
+        return NIXL_SUCCESS;
+    else
+        return NIXL_ERR_BACKEND;
+}
+
+nixl_status_t
+nixlAgent::deregisterMem(const nixl_reg_dlist_t &descs,
+                         const nixl_opt_args_t* extra_params) {
+
+
+    backend_set_t     backend_set;
+    nixl_status_t     ret, bad_ret=NIXL_SUCCESS;
+
+    // Published blocks leave the directory before their memory goes away
+    data->unpublishDeregistered(this, descs);
+
+    NIXL_LOCK_GUARD(data->lock);
+    if (!extra_params || extra_params->backends.size() == 0) {
+        backend_set_t* avail_backends;
+        avail_backends = data->memorySection->queryBackends(
+                                              descs.getType());
+        if (!avail_backends || avail_backends->empty())
+            return NIXL_ERR_NOT_FOUND;
+        // Make a copy as we might change it in remDescList
+        backend_set = *avail_backends;
+    } else {
+        for (auto & elm : extra_params->backends)
+            backend_set.insert(elm->engine);
+    }
+
+    // Doing best effort, and returning err if any
+    for (auto & backend : backend_set) {
+        std::unique_lock<std::mutex> engine_lock;
+        if (auto *reg_lock = data->getRegEngineLock(backend, descs.getType()))
+            engine_lock = std::unique_lock<std::mutex>(*reg_lock);
+        ret = data->memorySection->remDescList(descs, backend);
+        if (ret != NIXL_SUCCESS)
+            bad_ret = ret;
+    }
+
+    return bad_ret;
+}
+
+nixl_status_t
+nixlAgent::registerMemAsync(const nixl_reg_dlist_t &descs,
+                            nixlRegReqH* &req_hndl,
+                            const nixl_opt_args_t* extra_params) {
+
+    backend_list_t backend_list;
+
+    // Registration threads update the agent state concurrently to the user
+    if (data->config.syncMode == nixl_thread_sync_t::NIXL_THREAD_SYNC_NONE) {
+        NIXL_ERROR << "Asynchronous registration requires a thread safe agent";
+        return NIXL_ERR_NOT_ALLOWED;
+    }
+
+    NIXL_LOCK_GUARD(data->lock);
+    if (!extra_params || extra_params->backends.size() == 0) {
+        backend_list = data->memToBackend[descs.getType()];
+        if (backend_list.empty())
+            return NIXL_ERR_NOT_FOUND;
+    } else {
+        for (auto & elm : extra_params->backends)
+            backend_list.push_back(elm->engine);
+    }
+
+    auto req = std::make_unique<nixlRegReqH>(descs, false);
+    for (auto & backend : backend_list)
+        req->backends.emplace_back(backend,
+                                   data->getRegEngineLock(backend, descs.getType()),
+                                   descs.getType());
+
+    // Backends with parallel registration get a task per region, others a single task
+    // that registers the regions in order.
+    std::vector<std::tuple<size_t, int, int>> tasks;
+    for (size_t i = 0; i < req->backends.size(); ++i) {
+        if (req->backends[i].engineLock || descs.descCount() == 0) {
+            tasks.emplace_back(i, 0, descs.descCount());
+        } else {
+            for (int j = 0; j < descs.descCount(); ++j)
+                tasks.emplace_back(i, j, j + 1);
+        }
+    }
+
+    for (auto & [backend_idx, first, last] : tasks)
+        req->backends[backend_idx].pendingTasks++;
+    req->pendingTasks = tasks.size();
+    req_hndl = req.release();
+
+    for (auto & [backend_idx, first, last] : tasks) {
+        data->enqueueRegWork([agent_data = data.get(), req = req_hndl,
+                              backend_idx = backend_idx, first = first, last = last]() {
+            agent_data->runRegTask(req, backend_idx, first, last);
+        });
+    }
+
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t
+nixlAgent::deregisterMemAsync(const nixl_reg_dlist_t &descs,
+                              nixlRegReqH* &req_hndl,
+                              const nixl_opt_args_t* extra_params) {
+
+    backend_set_t backend_set;
+
+    if (data->config.syncMode == nixl_thread_sync_t::NIXL_THREAD_SYNC_NONE) {
+        NIXL_ERROR << "Asynchronous deregistration requires a thread safe agent";
+        return NIXL_ERR_NOT_ALLOWED;
+    }
+
+    data->unpublishDeregistered(this, descs);
+
+    NIXL_LOCK_GUARD(data->lock);
+    if (!extra_params || extra_params->backends.size() == 0) {
+        backend_set_t* avail_backends;
+        avail_backends = data->memorySection->queryBackends(
+                                              descs.getType());
+        if (!avail_backends || avail_backends->empty())
+            return NIXL_ERR_NOT_FOUND;
+        // Make a copy as we might change it in detachDescList
+        backend_set = *avail_backends;
+    } else {
+        for (auto & elm : extra_params->backends)
+            backend_set.insert(elm->engine);
+    }
+
+    // Regions are removed from the agent right away, only the backend calls are deferred
+    auto req = std::make_unique<nixlRegReqH>(descs, true);
+    std::vector<std::tuple<size_t, int, int>> tasks;
+    for (auto & backend : backend_set) {
+        req->backends.emplace_back(backend,
+                                   data->getRegEngineLock(backend, descs.getType()),
+                                   descs.getType());
+        auto &bknd = req->backends.back();
+        bknd.status = data->memorySection->detachDescList(descs, backend, bknd.localDescs);
+
+        size_t backend_idx = req->backends.size() - 1;
+        int count = bknd.localDescs.descCount();
+        if (bknd.engineLock || count == 0) {
+            tasks.emplace_back(backend_idx, 0, count);
+        } else {
+            for (int j = 0; j < count; ++j)
+                tasks.emplace_back(backend_idx, j, j + 1);
+        }
+    }
+
+    for (auto & [backend_idx, first, last] : tasks)
+        req->backends[backend_idx].pendingTasks++;
+    req->pendingTasks = tasks.size();
+    req_hndl = req.release();
+
+    for (auto & [backend_idx, first, last] : tasks) {
+        data->enqueueRegWork([agent_data = data.get(), req = req_hndl,
+                              backend_idx = backend_idx, first = first, last = last]() {
+            agent_data->runDeregTask(req, backend_idx, first, last);
+        });
+    }
+
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t
+nixlAgent::getRegStatus(nixlRegReqH* req_hndl) const {
+    if (!req_hndl)
+        return NIXL_ERR_INVALID_PARAM;
+
+    std::lock_guard<std::mutex> req_lock(req_hndl->lock);
+    return req_hndl->status;
+}
+
+nixl_status_t
+nixlAgent::releaseRegReq(nixlRegReqH* req_hndl) const {
+    if (!req_hndl)
+        return NIXL_ERR_INVALID_PARAM;
+
+    nixl_status_t status;
+    {
+        std::unique_lock<std::mutex> req_lock(req_hndl->lock);
+        req_hndl->cv.wait(req_lock, [req_hndl]() { return req_hndl->status != NIXL_IN_PROG; });
+        status = req_hndl->status;
+    }
+
+    delete req_hndl;
+    return status;
+}
+
+nixl_status_t
+nixlAgent::makeConnection(const std::string &remote_agent,
+                          const nixl_opt_args_t* extra_params) {
+    nixlBackendEngine* eng;
+    nixl_status_t ret;
+    std::set<nixl_backend_t> backend_set;
+    int count = 0;
+
+    NIXL_LOCK_GUARD(data->lock);
+    if (data->remoteBackends.count(remote_agent) == 0)
+        return NIXL_ERR_NOT_FOUND;
+
+    if (!extra_params || extra_params->backends.size() == 0) {
+        if (data->remoteBackends[remote_agent].empty())
+            return NIXL_ERR_NOT_FOUND;
+        for (auto & [r_bknd, conn_info] : data->remoteBackends[remote_agent])
+            backend_set.insert(r_bknd);
+    } else {
+        for (auto & elm : extra_params->backends)
+            backend_set.insert(elm->engine->getType());
+    }
+
+    // For now trying to make all the connections, can become best effort,
+    for (auto & backend: backend_set) {
+        if (data->backendEngines.count(backend)!=0) {
+            eng = data->backendEngines[backend];
+            ret = eng->connect(remote_agent);
+            if (ret)
+                break;
+            count++;
+        }
+    }
+
+    if (ret)
+        return ret;
+    else if (count == 0) // No common backend
+        return NIXL_ERR_BACKEND;
+    else
+        return NIXL_SUCCESS;
+}
+
+nixl_status_t
+nixlAgent::prepXferDlist (const std::string &agent_name,
+                          const nixl_xfer_dlist_t &descs,
+                          nixlDlistH* &dlist_hndl,
+                          const nixl_opt_args_t* extra_params) const {
+
+    // Using a set as order is not important to revert the operation
+    backend_set_t* backend_set;
+    nixl_status_t  ret;
+    int            count = 0;
+    bool           init_side = (agent_name == NIXL_INIT_AGENT);
+
+    // Conversions are only applied to requests made by createXferReq
+    if (extra_params && extra_params->hasConversion) {
+        NIXL_ERROR << "Conversions are not supported with prepared descriptor lists";
+        return NIXL_ERR_NOT_SUPPORTED;
+    }
+
+    NIXL_LOCK_GUARD(data->lock);
+    // When central KV is supported, still it should return error,
+    // just we can add a call to fetchRemoteMD for next time
+    if (!init_side && (data->remoteSections.count(agent_name) == 0))
+        return NIXL_ERR_NOT_FOUND;
+
+    if (!extra_params || extra_params->backends.size() == 0) {
+        if (!init_side)
+            backend_set = data->remoteSections[agent_name]->
+                                queryBackends(descs.getType());
+        else
+            backend_set = data->memorySection->
+                                queryBackends(descs.getType());
+
+        if (!backend_set || backend_set->empty())
+            return NIXL_ERR_NOT_FOUND;
+    } else {
+        backend_set = new backend_set_t();
+        for (auto & elm : extra_params->backends)
+            backend_set->insert(elm->engine);
+    }
+
+    // TODO [Perf]: Avoid heap allocation on the datapath, maybe use a mem pool
+
+    nixlDlistH *handle = new nixlDlistH;
+    if (init_side) {
+        handle->isLocal     = true;
+        handle->remoteAgent = "";
+    } else {
+        handle->isLocal     = false;
+        handle->remoteAgent = agent_name;
+    }
+
+    for (auto & backend : *backend_set) {
+        handle->descs[backend] = new nixl_meta_dlist_t (
+                                         descs.getType(),
+                                         descs.isSorted());
+        if (init_side)
+            ret = data->memorySection->populate(
+                       descs, backend, *(handle->descs[backend]));
+        else
+            ret = data->remoteSections[agent_name]->populate(
+                       descs, backend, *(handle->descs[backend]));
+        if (ret == NIXL_SUCCESS) {
+            count++;
+        } else {
+            delete handle->descs[backend];
+            handle->descs.erase(backend);
+        }
+    }
+
+    if (extra_params && extra_params->backends.size() > 0)
+        delete backend_set;
+
+    if (count == 0) {
+        delete handle;
+        dlist_hndl = nullptr;
+        return NIXL_ERR_NOT_FOUND;
+    } else {
+        dlist_hndl = handle;
+        return NIXL_SUCCESS;
+    }
+}
+
+nixl_status_t
+nixlAgent::makeXferReq (const nixl_xfer_op_t &operation,
+                        const nixlDlistH* local_side,
+                        const std::vector<int> &local_indices,
+                        const nixlDlistH* remote_side,
+                        const std::vector<int> &remote_indices,
+                        nixlXferReqH* &req_hndl,
+                        const nixl_opt_args_t* extra_params) const {
+
+    nixl_opt_b_args_t  opt_args;
+    nixl_status_t      ret;
+    int                desc_count = (int) local_indices.size();
+    nixlBackendEngine* backend    = nullptr;
+
+    req_hndl = nullptr;
+
+    if (!local_side || !remote_side)
+        return NIXL_ERR_INVALID_PARAM;
+
+    if ((!local_side->isLocal) || (remote_side->isLocal))
+        return NIXL_ERR_INVALID_PARAM;
+
+    if (extra_params && extra_params->hasConversion) {
+        NIXL_ERROR << "Conversions are not supported with prepared descriptor lists";
+        return NIXL_ERR_NOT_SUPPORTED;
+    }
+
+    NIXL_LOCK_GUARD(data->lock);
+    // The remote was invalidated in between prepXferDlist and this call
+    if (data->remoteSections.count(remote_side->remoteAgent) == 0) {
+        delete req_hndl;
+        return NIXL_ERR_NOT_FOUND;
+    }
+
+    if (extra_params && extra_params->backends.size() > 0) {
+        for (auto & elm : extra_params->backends) {
+            if ((local_side->descs.count(elm->engine) > 0) &&
+                (remote_side->descs.count(elm->engine) > 0)) {
+                backend = elm->engine;
+                break;
+            }
+        }
+    } else {
+        for (auto & loc_bknd : local_side->descs) {
+            for (auto & rem_bknd : remote_side->descs) {
+                if (loc_bknd.first == rem_bknd.first) {
+                    backend = loc_bknd.first;
+                    break;
+                }
+            }
+            if (backend)
+                break;
+        }
+    }
+
+    if (!backend)
+        return NIXL_ERR_INVALID_PARAM;
+
+    nixl_meta_dlist_t* local_descs  = local_side->descs.at(backend);
+    nixl_meta_dlist_t* remote_descs = remote_side->descs.at(backend);
+
+    if ((desc_count == 0) || (remote_indices.size() == 0) ||
+        (desc_count != (int) remote_indices.size()))
+        return NIXL_ERR_INVALID_PARAM;
+
+    for (int i=0; i<desc_count; ++i) {
+        if ((local_indices[i] >= local_descs->descCount())
+               || (local_indices[i]<0))
+            return NIXL_ERR_INVALID_PARAM;
+        if ((remote_indices[i] >= remote_descs->descCount())
+               || (remote_indices[i]<0))
+            return NIXL_ERR_INVALID_PARAM;
+        if ((*local_descs )[local_indices [i]].len !=
+            (*remote_descs)[remote_indices[i]].len)
+            return NIXL_ERR_INVALID_PARAM;
+    }
+
+    if (extra_params && extra_params->hasNotif) {
+        opt_args.notifMsg = extra_params->notifMsg;
+        opt_args.hasNotif = true;
+    }
+
+    if ((opt_args.hasNotif) && (!backend->supportsNotif())) {
+        return NIXL_ERR_BACKEND;
+    }
+
+    // Populate has been already done, no benefit in having sorted descriptors
+    // which will be overwritten by [] assignment operator.
+    nixlXferReqH* handle   = new nixlXferReqH;
+    handle->initiatorDescs = new nixl_meta_dlist_t (
+                                     local_descs->getType(),
+                                     false, desc_count);
+
+    handle->targetDescs    = new nixl_meta_dlist_t (
+                                     remote_descs->getType(),
+                                     false, desc_count);
+
+    if (extra_params && extra_params->skipDescMerge) {
+        for (int i=0; i<desc_count; ++i) {
+            (*handle->initiatorDescs)[i] =
+                                     (*local_descs)[local_indices[i]];
+            (*handle->targetDescs)[i] =
+                                     (*remote_descs)[remote_indices[i]];
+        }
+    } else {
+        int i = 0, j = 0; //final list size
+        while (i<(desc_count)) {
+            nixlMetaDesc local_desc1  = (*local_descs) [local_indices[i]];
+            nixlMetaDesc remote_desc1 = (*remote_descs)[remote_indices[i]];
+
+            if(i != (desc_count-1) ) {
+                nixlMetaDesc* local_desc2  = &((*local_descs) [local_indices[i+1]]);
+                nixlMetaDesc* remote_desc2 = &((*remote_descs)[remote_indices[i+1]]);
+
+              while (((local_desc1.addr + local_desc1.len) == local_desc2->addr)
+                  && ((remote_desc1.addr + remote_desc1.len) == remote_desc2->addr)
+                  && (local_desc1.metadataP == local_desc2->metadataP)
+                  && (remote_desc1.metadataP == remote_desc2->metadataP)
+                  && (local_desc1.devId == local_desc2->devId)
+                  && (remote_desc1.devId == remote_desc2->devId)) {
+
+                    local_desc1.len += local_desc2->len;
+                    remote_desc1.len += remote_desc2->len;
+
+                    i++;
+                    if(i == (desc_count-1)) break;
+
+                    local_desc2  = &((*local_descs) [local_indices[i+1]]);
+                    remote_desc2 = &((*remote_descs)[remote_indices[i+1]]);
+                }
+            }
+
+            (*handle->initiatorDescs)[j] = local_desc1;
+            (*handle->targetDescs)   [j] = remote_desc1;
+            j++;
+            i++;
+        }
+        NIXL_DEBUG << "reqH descList size down to " << j;
+        handle->initiatorDescs->resize(j);
+        handle->targetDescs->resize(j);
+    }
+
+    handle->engine      = backend;
+    handle->remoteAgent = remote_side->remoteAgent;
+    handle->notifMsg    = opt_args.notifMsg;
+    handle->hasNotif    = opt_args.hasNotif;
+    handle->backendOp   = operation;
+    handle->status      = NIXL_ERR_NOT_POSTED;
+
+    handle->sharedNotif = data->sharedNotifTo(backend, handle->remoteAgent);
+    if (opt_args.hasNotif)
+        opt_args.notifMsg = data->notifMsgTo(handle->sharedNotif, handle->remoteAgent,
+                                             opt_args.notifMsg);
+
+    ret = handle->engine->prepXfer (handle->backendOp,
+                                    *handle->initiatorDescs,
+                                    *handle->targetDescs,
+                                    handle->remoteAgent,
+                                    handle->backendHandle,
+                                    &opt_args);
+    if (ret != NIXL_SUCCESS) {
+        delete handle;
+        return ret;
+    }
+
+    req_hndl = handle;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t
+nixlAgent::createXferReq(const nixl_xfer_op_t &operation,
+                         const nixl_xfer_dlist_t &local_descs,
+                         const nixl_xfer_dlist_t &remote_descs,
+                         const std::string &remote_agent,
+                         nixlXferReqH* &req_hndl,
+                         const nixl_opt_args_t* extra_params) const {
+    nixl_status_t     ret1, ret2;
+    nixl_opt_b_args_t opt_args;
+    backend_set_t*    backend_set = new backend_set_t();
+
+    req_hndl = nullptr;
+
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    if (data->remoteSections.count(remote_agent) == 0)
+    {
+        delete backend_set;
+        return NIXL_ERR_NOT_FOUND;
+    }
+
+    // Check the correspondence between descriptor lists. With a conversion, descriptors
+    // hold the same number of elements of their own type.
+    const bool convert = extra_params && extra_params->hasConversion;
+    size_t local_elem = 1, remote_elem = 1;
+    if (convert) {
+        if (!nixlDtype::isValid(extra_params->conversion)) {
+            delete backend_set;
+            return NIXL_ERR_INVALID_PARAM;
+        }
+        local_elem  = nixlDtype::elemSize(extra_params->conversion.localType);
+        remote_elem = nixlDtype::elemSize(extra_params->conversion.remoteType);
+    }
+
+    if (local_descs.descCount() != remote_descs.descCount()) {
+        delete backend_set;
+        return NIXL_ERR_INVALID_PARAM;
+    }
+    for (int i=0; i<local_descs.descCount(); ++i) {
+        if ((local_descs[i].len % local_elem) || (remote_descs[i].len % remote_elem) ||
+            (local_descs[i].len / local_elem != remote_descs[i].len / remote_elem)) {
+            delete backend_set;
+            return NIXL_ERR_INVALID_PARAM;
+        }
+    }
+
+    if (!extra_params || extra_params->backends.size() == 0) {
+        // Finding backends that support the corresponding memories
+        // locally and remotely, and find the common ones.
+        backend_set_t* local_set =
+            data->memorySection->queryBackends(local_descs.getType());
+        backend_set_t* remote_set =
+            data->remoteSections[remote_agent]->queryBackends(
+                                                remote_descs.getType());
+        if (!local_set || !remote_set) {
+            delete backend_set;
+            return NIXL_ERR_NOT_FOUND;
+        }
+
+        for (auto & elm : *local_set)
+            if (remote_set->count(elm) != 0)
+                backend_set->insert(elm);
+
+        if (backend_set->empty()) {
+            delete backend_set;
+            return NIXL_ERR_NOT_FOUND;
+        }
+    } else {
+        for (auto & elm : extra_params->backends)
+            backend_set->insert(elm->engine);
+    }
+
+    if (convert) {
+        for (auto it = backend_set->begin(); it != backend_set->end();)
+            it = (*it)->supportsConversion() ? std::next(it) : backend_set->erase(it);
+        if (backend_set->empty()) {
+            NIXL_ERROR << "No backend supports the conversion of the transfer";
+            delete backend_set;
+            return NIXL_ERR_NOT_SUPPORTED;
+        }
+    }
+
+    // TODO: when central KV is supported, add a call to fetchRemoteMD
+    // TODO: merge descriptors back to back in memory (like makeXferReq).
+    // TODO [Perf]: Avoid heap allocation on the datapath, maybe use a mem pool
+
+    nixlXferReqH *handle   = new nixlXferReqH;
+    handle->initiatorDescs = new nixl_meta_dlist_t (
+                                     local_descs.getType(),
+                                     local_descs.isSorted());
+
+    handle->targetDescs    = new nixl_meta_dlist_t (
+                                     remote_descs.getType(),
+                                     remote_descs.isSorted());
+
+    // Currently we loop through and find first local match. Can use a
+    // preference list or more exhaustive search.
+    for (auto & backend : *backend_set) {
+        // If populate fails, it clears the resp before return
+        ret1 = data->memorySection->populate(
+                     local_descs, backend, *handle->initiatorDescs);
+        ret2 = data->remoteSections[remote_agent]->populate(
+                     remote_descs, backend, *handle->targetDescs);
+
+        if ((ret1 == NIXL_SUCCESS) && (ret2 == NIXL_SUCCESS)) {
+            NIXL_INFO << "Selected backend: " << backend->getType();
+            handle->engine = backend;
+            break;
+        }
+    }
+
+    delete backend_set;
+
+    if (!handle->engine) {
+        delete handle;
+        return NIXL_ERR_NOT_FOUND;
+    }
+
+    if (extra_params) {
+        if (extra_params->hasNotif) {
+            opt_args.notifMsg = extra_params->notifMsg;
+            opt_args.hasNotif = true;
+        }
+
+        if (extra_params->customParam.length() > 0)
+            opt_args.customParam = extra_params->customParam;
+
+        if (convert) {
+            opt_args.conversion    = extra_params->conversion;
+            opt_args.hasConversion = true;
+        }
+    }
+
+    if (opt_args.hasNotif && (!handle->engine->supportsNotif())) {
+        delete handle;
+        return NIXL_ERR_BACKEND;
+    }
+
+    handle->remoteAgent = remote_agent;
+    handle->backendOp   = operation;
+    handle->status      = NIXL_ERR_NOT_POSTED;
+    handle->notifMsg    = opt_args.notifMsg;
+    handle->hasNotif    = opt_args.hasNotif;
+
+    handle->sharedNotif = data->sharedNotifTo(handle->engine, remote_agent);
+    if (opt_args.hasNotif)
+        opt_args.notifMsg = data->notifMsgTo(handle->sharedNotif, remote_agent,
+                                             opt_args.notifMsg);
+
+    ret1 = handle->engine->prepXfer (handle->backendOp,
+                                     *handle->initiatorDescs,
+                                     *handle->targetDescs,
+                                     handle->remoteAgent,
+                                     handle->backendHandle,
+                                     &opt_args);
+    if (ret1 != NIXL_SUCCESS) {
+        delete handle;
+        return ret1;
+    }
+
+    req_hndl = handle;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t
+nixlAgent::createLayoutXferReq(const nixl_xfer_op_t &operation,
+                               const nixlTensorLayout &local_layout,
+                               const nixlTensorLayout &remote_layout,
+                               const std::string &remote_agent,
+                               nixlXferReqH* &req_hndl,
+                               const nixl_opt_args_t* extra_params) const {
+    nixl_xfer_dlist_t local_descs(local_layout.memType);
+    nixl_xfer_dlist_t remote_descs(remote_layout.memType);
+
+    req_hndl = nullptr;
+
+    nixl_status_t ret = nixlTensorLayout::toDescs(local_layout, remote_layout,
+                                                  local_descs, remote_descs);
+    if (ret != NIXL_SUCCESS)
+        return ret;
+
+    if (local_descs.descCount() == 0) {
+        NIXL_ERROR << "Tensor layout transfer is empty";
+        return NIXL_ERR_INVALID_PARAM;
+    }
+
+    NIXL_DEBUG << "Tensor layout transfer of " << local_layout.numElems()
+               << " elements lowered to " << local_descs.descCount() << " descriptors";
+
+    return createXferReq(operation, local_descs, remote_descs, remote_agent, req_hndl,
+                         extra_params);
+}
+
+nixl_status_t
+nixlAgent::estimateXferCost(const nixlXferReqH *req_hndl,
+                            std::chrono::microseconds &duration,
+                            std::chrono::microseconds &err_margin,
+                            nixl_cost_t &method,
+                            const nixl_opt_args_t* extra_params) const
+{
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+
+    // Check if the remote agent connection info is still valid
+    // (assuming cost estimation requires connection info like transfers)
+    if (!req_hndl->remoteAgent.empty() &&
+        (data->remoteSections.count(req_hndl->remoteAgent) == 0)) {
+        NIXL_ERROR << "Invalid request handle: remote agent not found";
+        return NIXL_ERR_NOT_FOUND;
+    }
+
+    if (!req_hndl->engine) {
+        NIXL_ERROR << "Invalid request handle: engine is null";
+        return NIXL_ERR_UNKNOWN;
+    }
+
+    return req_hndl->engine->estimateXferCost(req_hndl->backendOp,
+                                              *req_hndl->initiatorDescs,
+                                              *req_hndl->targetDescs,
+                                              req_hndl->remoteAgent,
+                                              req_hndl->backendHandle,
+                                              duration,
+                                              err_margin,
+                                              method,
+                                              extra_params);
+}
+
+nixl_status_t
+nixlAgent::postXferReq(nixlXferReqH *req_hndl,
+                       const nixl_opt_args_t* extra_params) const {
+    nixl_status_t ret;
+    nixl_opt_b_args_t opt_args;
+
+    opt_args.hasNotif = false;
+
+    if (!req_hndl)
+        return NIXL_ERR_INVALID_PARAM;
+
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    // Check if the remote was invalidated before post/repost
+    if (data->remoteSections.count(req_hndl->remoteAgent) == 0) {
+        delete req_hndl;
+        return NIXL_ERR_NOT_FOUND;
+    }
+
+    // We can't repost while a request is in progress
+    if (req_hndl->status == NIXL_IN_PROG) {
+        req_hndl->status = req_hndl->engine->checkXfer(
+                                     req_hndl->backendHandle);
+        if (req_hndl->status == NIXL_IN_PROG) {
+            delete req_hndl;
+            return NIXL_ERR_REPOST_ACTIVE;
+        }
+    }
+
+    // Carrying over notification from xfer handle creation time
+    if (req_hndl->hasNotif) {
+        opt_args.notifMsg = req_hndl->notifMsg;
+        opt_args.hasNotif = true;
+    }
+
+    // Updating the notification based on opt_args
+    if (extra_params) {
+        if (extra_params->hasNotif) {
+            req_hndl->notifMsg = extra_params->notifMsg;
+            opt_args.notifMsg  = extra_params->notifMsg;
+            req_hndl->hasNotif = true;
+            opt_args.hasNotif  = true;
+        } else {
+            req_hndl->hasNotif = false;
+            opt_args.hasNotif  = false;
+        }
+    }
+
+    if (opt_args.hasNotif && (!req_hndl->engine->supportsNotif())) {
+        delete req_hndl;
+        return NIXL_ERR_BACKEND;
+    }
+
+    if (opt_args.hasNotif)
+        opt_args.notifMsg = data->notifMsgTo(req_hndl->sharedNotif, req_hndl->remoteAgent,
+                                             opt_args.notifMsg);
+
+    // Bound requests are armed before the post, the backend can report the completion
+    // before postXfer returns
+    nixlComplQueueH* cq = req_hndl->complQueue;
+    const bool armed = (cq != nullptr) && (req_hndl->backendHandle != nullptr) &&
+                       (data->complEngines.count(req_hndl->engine) > 0);
+    if (armed) {
+        const std::lock_guard<std::mutex> guard(cq->lock);
+        cq->armed[req_hndl->backendHandle] = req_hndl;
+    }
+
+    // If status is not NIXL_IN_PROG we can repost,
+    ret = req_hndl->engine->postXfer (req_hndl->backendOp,
+                                     *req_hndl->initiatorDescs,
+                                     *req_hndl->targetDescs,
+                                      req_hndl->remoteAgent,
+                                      req_hndl->backendHandle,
+                                      &opt_args);
+    req_hndl->status = ret;
+
+    if (cq != nullptr) {
+        const std::lock_guard<std::mutex> guard(cq->lock);
+        if (ret != NIXL_IN_PROG) {
+            // Completed or failed within the post, unless the handler reported it already
+            if (!armed || cq->armed.erase(req_hndl->backendHandle) > 0)
+                cq->push(req_hndl, ret);
+        } else if (!armed) {
+            cq->polled.push_back(req_hndl);
+        }
+    }
+    return ret;
+}
+
+nixl_status_t
+nixlAgent::getXferStatus (nixlXferReqH *req_hndl) const {
+
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    // If the status is done, no need to recheck.
+    if (req_hndl->status == NIXL_IN_PROG) {
+        // Check if the remote was invalidated before completion
+        if (data->remoteSections.count(req_hndl->remoteAgent) == 0) {
+            delete req_hndl;
             return NIXL_ERR_NOT_FOUND;
-    } else {
-        backend_list = new backend_list_t();
-        for (auto & elm : extra_params->backends)
-            backend_list->push_back(elm->engine);
+        }
+        req_hndl->status = req_hndl->engine->checkXfer(
+                                     req_hndl->backendHandle);
     }
 
-    // Best effort, if at least one succeeds NIXL_SUCCESS is returned
-    // Can become more sophisticated to have a soft error case
-    for (size_t i=0; i<backend_list->size(); ++i) {
-        nixlBackendEngine* backend = (*backend_list)[i];
-        // meta_descs use to be passed to loadLocalData
-        nixl_sec_dlist_t sec_descs(descs.getType(), false);
-        ret = data->memorySection->addDescList(descs, backend, sec_descs);
-        if (ret == NIXL_SUCCESS) {
-            if (backend->supportsLocal()) {
-                if (data->remoteSections.count(data->name) == 0)
-                    data->remoteSections[data->name] =
-                          new nixlRemoteSection(data->name);
+    return req_hndl->status;
+}
 
-                ret = data->remoteSections[data->name]->loadLocalData(
-                                                        sec_descs, backend);
-                if (ret == NIXL_SUCCESS)
-                    count++;
-                else
-                    data->memorySection->remDescList(descs, backend);
-            } else {
-                count++;
+
+nixl_status_t
+nixlAgent::queryXferBackend(const nixlXferReqH* req_hndl,
+                            nixlBackendH* &backend) const {
+    NIXL_LOCK_GUARD(data->lock);
+    backend = data->backendHandles[req_hndl->engine->getType()];
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t
+nixlAgent::releaseXferReq(nixlXferReqH *req_hndl) const {
+
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    // Before the backend handle is released, which it is tracked by in the queue
+    if (req_hndl->complQueue != nullptr) {
+        req_hndl->complQueue->unbind(req_hndl, req_hndl->backendHandle);
+        req_hndl->complQueue = nullptr;
+    }
+
+    //attempt to cancel request
+    if(req_hndl->status == NIXL_IN_PROG) {
+        req_hndl->status = req_hndl->engine->checkXfer(
+                                     req_hndl->backendHandle);
+
+        if(req_hndl->status == NIXL_IN_PROG) {
+
+            req_hndl->status = req_hndl->engine->releaseReqH(
+                                         req_hndl->backendHandle);
+
+            if(req_hndl->status < 0)
+                return NIXL_ERR_REPOST_ACTIVE;
+
+            // just in case the backend doesn't set to NULL on success
+            // this will prevent calling releaseReqH again in destructor
+            req_hndl->backendHandle = nullptr;
+        }
+    }
+    delete req_hndl;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t
+nixlAgent::releasedDlistH (nixlDlistH* dlist_hndl) const {
+    NIXL_LOCK_GUARD(data->lock);
+    delete dlist_hndl;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t
+nixlAgent::createComplQueue(nixlComplQueueH* &cq_hndl) {
+    auto cq = std::make_unique<nixlComplQueueH>();
+    if (cq->fd < 0) {
+        NIXL_ERROR << "Failed to create the eventfd of a completion queue: "
+                   << strerror(errno);
+        return NIXL_ERR_BACKEND;
+    }
+
+    const std::unique_lock<std::shared_mutex> cq_lock(data->complQueuesLock);
+    data->complQueues.push_back(cq.get());
+    cq_hndl = cq.release();
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t
+nixlAgent::bindXferReq(nixlXferReqH* req_hndl, nixlComplQueueH* cq_hndl) const {
+    if (!req_hndl)
+        return NIXL_ERR_INVALID_PARAM;
+
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    if (req_hndl->status == NIXL_IN_PROG) {
+        req_hndl->status = req_hndl->engine->checkXfer(req_hndl->backendHandle);
+        if (req_hndl->status == NIXL_IN_PROG)
+            return NIXL_ERR_REPOST_ACTIVE;
+    }
+
+    if (req_hndl->complQueue != nullptr)
+        req_hndl->complQueue->unbind(req_hndl, req_hndl->backendHandle);
+
+    req_hndl->complQueue = cq_hndl;
+    if (cq_hndl != nullptr) {
+        const std::lock_guard<std::mutex> guard(cq_hndl->lock);
+        cq_hndl->bound.push_back(req_hndl);
+    }
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t
+nixlAgent::pollCompletions(nixlComplQueueH* cq_hndl,
+                           std::vector<nixl_xfer_compl_t> &compls,
+                           size_t max_compls) const {
+    if (!cq_hndl)
+        return NIXL_ERR_INVALID_PARAM;
+
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    data->checkPolledXfers(cq_hndl);
+
+    const std::lock_guard<std::mutex> guard(cq_hndl->lock);
+    auto &done = cq_hndl->done;
+    const size_t count = std::min(max_compls, done.size());
+    for (size_t i = 0; i < count; i++) {
+        done[i].req->status = done[i].status;
+        compls.push_back(done[i]);
+    }
+    done.erase(done.begin(), done.begin() + count);
+
+    if (done.empty())
+        cq_hndl->resetSignal();
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t
+nixlAgent::waitCompletions(nixlComplQueueH* cq_hndl,
+                           std::chrono::microseconds timeout) const {
+    if (!cq_hndl)
+        return NIXL_ERR_INVALID_PARAM;
+
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (true) {
+        bool polled;
+        {
+            NIXL_SHARED_LOCK_GUARD(data->lock);
+            data->checkPolledXfers(cq_hndl);
+
+            const std::lock_guard<std::mutex> guard(cq_hndl->lock);
+            if (!cq_hndl->done.empty())
+                return NIXL_SUCCESS;
+            polled = !cq_hndl->polled.empty();
+        }
+
+        auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(
+                             deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0)
+            return NIXL_IN_PROG;
+
+        // Requests without a completion handler don't signal the eventfd, they are
+        // checked again after a short wait
+        if (polled)
+            remaining = std::min(remaining, compl_poll_interval);
+
+        struct pollfd pfd = {cq_hndl->fd, POLLIN, 0};
+        const struct timespec ts = {
+            static_cast<time_t>(remaining.count() / 1000000),
+            static_cast<long>((remaining.count() % 1000000) * 1000)};
+        if (ppoll(&pfd, 1, &ts, nullptr) < 0 && errno != EINTR) {
+            NIXL_ERROR << "Failed to wait on a completion queue: " << strerror(errno);
+            return NIXL_ERR_BACKEND;
+        }
+    }
+}
+
+nixl_status_t
+nixlAgent::getComplQueueFd(const nixlComplQueueH* cq_hndl, int &fd) const {
+    if (!cq_hndl)
+        return NIXL_ERR_INVALID_PARAM;
+
+    fd = cq_hndl->fd;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t
+nixlAgent::releaseComplQueue(nixlComplQueueH* cq_hndl) {
+    if (!cq_hndl)
+        return NIXL_ERR_INVALID_PARAM;
+
+    // Posts, binds and polls use the queue under the shared agent lock
+    NIXL_LOCK_GUARD(data->lock);
+    {
+        const std::unique_lock<std::shared_mutex> cq_lock(data->complQueuesLock);
+        auto it = std::find(data->complQueues.begin(), data->complQueues.end(), cq_hndl);
+        if (it == data->complQueues.end())
+            return NIXL_ERR_NOT_FOUND;
+        data->complQueues.erase(it);
+    }
+
+    {
+        const std::lock_guard<std::mutex> guard(cq_hndl->lock);
+        for (auto & req : cq_hndl->bound)
+            req->complQueue = nullptr;
+    }
+    delete cq_hndl;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t
+nixlAgent::setDirMembers(const std::vector<std::string> &agents) {
+    std::map<std::string, nixlDirMsg> publish;
+
+    std::unordered_set<std::string> unique(agents.begin(), agents.end());
+    if (agents.empty() || unique.size() != agents.size() || unique.count("")) {
+        NIXL_ERROR << "Directory members have to be a non-empty list of distinct agents";
+        return NIXL_ERR_INVALID_PARAM;
+    }
+
+    {
+        std::lock_guard<std::mutex> dir_lock(data->dirLock);
+        data->dirMembers.clear();
+        for (auto &agent : agents)
+            data->dirMembers.emplace_back(agent, dirNameHash(agent));
+
+        // Entries of keys this agent is no longer the shard of are republished by their
+        // holders to the new shards
+        for (auto it = data->dirShard.begin(); it != data->dirShard.end();) {
+            if (data->dirHome(it->first) != data->name)
+                it = data->dirShard.erase(it);
+            else
+                ++it;
+        }
+
+        for (auto &[key, entry] : data->dirPublished)
+            dirMsgTo(publish, data->dirHome(key), nixl_dir_op_t::PUBLISH)
+                .blocks.push_back(dirBlock(key, entry));
+    }
+
+    nixl_dir_msgs_t msgs(std::make_move_iterator(publish.begin()),
+                         std::make_move_iterator(publish.end()));
+    return data->sendDir(this, msgs);
+}
+
+nixl_status_t
+nixlAgent::publishBlocks(const std::vector<uint64_t> &keys,
+                         const nixl_xfer_dlist_t &descs) {
+    std::map<std::string, nixlDirMsg> publish;
+
+    if (keys.empty() || keys.size() != (size_t)descs.descCount())
+        return NIXL_ERR_INVALID_PARAM;
+
+    // Blocks have to be registered with at least one backend
+    {
+        NIXL_SHARED_LOCK_GUARD(data->lock);
+        bool registered = false;
+        backend_set_t* backends = data->memorySection->queryBackends(descs.getType());
+        if (backends) {
+            for (auto &backend : *backends) {
+                nixl_meta_dlist_t resp(descs.getType(), descs.isSorted());
+                if (data->memorySection->populate(descs, backend, resp) == NIXL_SUCCESS) {
+                    registered = true;
+                    break;
+                }
             }
-        } // a bad_ret can be saved in an else
+        }
+        if (!registered) {
+            NIXL_ERROR << "Blocks to publish are not within registered memory";
+            return NIXL_ERR_NOT_FOUND;
+        }
     }
 
-    if (extra_params && extra_params->backends.size() > 0)
-        delete backend_list;
+    {
+        std::lock_guard<std::mutex> dir_lock(data->dirLock);
+        if (data->dirMembers.empty()) {
+            NIXL_ERROR << "Directory members are not set";
+            return NIXL_ERR_NOT_ALLOWED;
+        }
 
-    if (count > 0)
-        return NIXL_SUCCESS;
-    else
-        return NIXL_ERR_BACKEND;
+        for (size_t i = 0; i < keys.size(); i++) {
+            const nixlDirEntry entry = {data->name, descs[i].addr, descs[i].len,
+                                        descs[i].devId, descs.getType()};
+            data->dirPublished[keys[i]] = entry;
+            dirMsgTo(publish, data->dirHome(keys[i]), nixl_dir_op_t::PUBLISH)
+                .blocks.push_back(dirBlock(keys[i], entry));
+        }
+    }
+
+    nixl_dir_msgs_t msgs(std::make_move_iterator(publish.begin()),
+                         std::make_move_iterator(publish.end()));
+    return data->sendDir(this, msgs);
 }
 
 nixl_status_t
-nixlAgent::deregisterMem(const nixl_reg_dlist_t &descs,
-                         const nixl_opt_args_t* extra_params) {
+nixlAgent::unpublishBlocks(const std::vector<uint64_t> &keys) {
+    std::map<std::string, nixlDirMsg> unpublish;
 
+    {
+        std::lock_guard<std::mutex> dir_lock(data->dirLock);
+        if (data->dirMembers.empty())
+            return NIXL_ERR_NOT_ALLOWED;
 
-    backend_set_t     backend_set;
-    nixl_status_t     ret, bad_ret=NIXL_SUCCESS;
+        for (auto &key : keys) {
+            auto it = data->dirPublished.find(key);
+            if (it == data->dirPublished.end())
+                continue;
+            dirMsgTo(unpublish, data->dirHome(key), nixl_dir_op_t::UNPUBLISH)
+                .blocks.push_back(dirBlock(key, it->second));
+            data->dirPublished.erase(it);
+        }
+    }
 
-    NIXL_LOCK_GUARD(data->lock);
-    if (!extra_params || extra_params->backends.size() == 0) {
-        backend_set_t* avail_backends;
-        avail_backends = data->memorySection->queryBackends(
-                                              descs.getType());
-        if (!avail_backends || avail_backends->empty())
-            return NIXL_ERR_NOT_FOUND;
-        // Make a copy as we might change it in remDescList
-        backend_set = *avail_backends;
-    } else {
-        for (auto & elm : extra_params->backends)
-            backend_set.insert(elm->engine);
+    nixl_dir_msgs_t msgs(std::make_move_iterator(unpublish.begin()),
+                         std::make_move_iterator(unpublish.end()));
+    return data->sendDir(this, msgs);
+}
+
+nixl_status_t
+nixlAgent::lookupBlocks(const std::vector<uint64_t> &keys,
+                        nixlDirLookupH* &lookup_hndl,
+                        const nixl_opt_args_t* extra_params) {
+    std::map<std::string, nixlDirMsg> queries;
+    lookup_hndl = nullptr;
+
+    if (keys.empty())
+        return NIXL_ERR_INVALID_PARAM;
+
+    std::chrono::microseconds timeout = dir_lookup_timeout;
+    if (extra_params && extra_params->lookupTimeoutUs)
+        timeout = std::chrono::microseconds(extra_params->lookupTimeoutUs);
+
+    auto handle      = std::make_unique<nixlDirLookupH>();
+    handle->keys     = keys;
+    handle->deadline = std::chrono::steady_clock::now() + timeout;
+    {
+        std::lock_guard<std::mutex> dir_lock(data->dirLock);
+        if (data->dirMembers.empty()) {
+            NIXL_ERROR << "Directory members are not set";
+            return NIXL_ERR_NOT_ALLOWED;
+        }
+
+        handle->lookupId = data->dirLookupCount++;
+        for (auto &key : keys) {
+            nixlDirBlock block = {};
+            block.key = key;
+            dirMsgTo(queries, data->dirHome(key), nixl_dir_op_t::QUERY, handle->lookupId)
+                .blocks.push_back(block);
+        }
+        handle->pendingShards = queries.size();
+        data->dirLookups[handle->lookupId] = handle.get();
     }
 
-    // Doing best effort, and returning err if any
-    for (auto & backend : backend_set) {
-        ret = data->memorySection->remDescList(descs, backend);
-        if (ret != NIXL_SUCCESS)
-            bad_ret = ret;
+    // Queries to this agent are answered right away
+    nixl_dir_msgs_t msgs(std::make_move_iterator(queries.begin()),
+                         std::make_move_iterator(queries.end()));
+    nixl_status_t ret = data->sendDir(this, msgs);
+    if (ret != NIXL_SUCCESS) {
+        std::lock_guard<std::mutex> dir_lock(data->dirLock);
+        data->dirLookups.erase(handle->lookupId);
+        return ret;
     }
 
-    return bad_ret;
+    lookup_hndl = handle.release();
+    return NIXL_SUCCESS;
 }
 
 nixl_status_t
-nixlAgent::makeConnection(const std::string &remote_agent,
-                          const nixl_opt_args_t* extra_params) {
-    nixlBackendEngine* eng;
-    nixl_status_t ret;
-    std::set<nixl_backend_t> backend_set;
-    int count = 0;
-
-    NIXL_LOCK_GUARD(data->lock);
-    if (data->remoteBackends.count(remote_agent) == 0)
-        return NIXL_ERR_NOT_FOUND;
+nixlAgent::getLookupStatus(nixlDirLookupH* lookup_hndl) {
+    if (!lookup_hndl)
+        return NIXL_ERR_INVALID_PARAM;
 
-    if (!extra_params || extra_params->backends.size() == 0) {
-        if (data->remoteBackends[remote_agent].empty())
-            return NIXL_ERR_NOT_FOUND;
-        for (auto & [r_bknd, conn_info] : data->remoteBackends[remote_agent])
-            backend_set.insert(r_bknd);
-    } else {
-        for (auto & elm : extra_params->backends)
-            backend_set.insert(elm->engine->getType());
+    {
+        std::lock_guard<std::mutex> dir_lock(data->dirLock);
+        if (lookup_hndl->status != NIXL_IN_PROG)
+            return lookup_hndl->status;
     }
 
-    // For now trying to make all the connections, can become best effort,
-    for (auto & backend: backend_set) {
-        if (data->backendEngines.count(backend)!=0) {
-            eng = data->backendEngines[backend];
-            ret = eng->connect(remote_agent);
-            if (ret)
-                break;
-            count++;
+    // Answers arrive as notifications, other notifications drained here are kept for
+    // getNotifs. If another thread is draining, it receives the answers.
+    std::unique_lock<std::mutex> drain_lock(data->notifDrainLock, std::try_to_lock);
+    if (drain_lock.owns_lock()) {
+        notif_list_t agent_msgs;
+        {
+            NIXL_LOCK_GUARD(data->lock);
+            data->drainNotifs(data->notifEngines, agent_msgs);
         }
+        data->relayDrained(this, agent_msgs);
+        data->trimUnrouted();
     }
 
-    if (ret)
-        return ret;
-    else if (count == 0) // No common backend
-        return NIXL_ERR_BACKEND;
-    else
-        return NIXL_SUCCESS;
+    std::lock_guard<std::mutex> dir_lock(data->dirLock);
+    if (lookup_hndl->status == NIXL_IN_PROG &&
+        std::chrono::steady_clock::now() >= lookup_hndl->deadline) {
+        // Answers that arrive later are dropped
+        NIXL_ERROR << "Lookup " << lookup_hndl->lookupId << " timed out waiting for "
+                   << lookup_hndl->pendingShards << " directory shards";
+        lookup_hndl->status = NIXL_ERR_REMOTE_DISCONNECT;
+        data->dirLookups.erase(lookup_hndl->lookupId);
+    }
+    return lookup_hndl->status;
 }
 
 nixl_status_t
-nixlAgent::prepXferDlist (const std::string &agent_name,
-                          const nixl_xfer_dlist_t &descs,
-                          nixlDlistH* &dlist_hndl,
-                          const nixl_opt_args_t* extra_params) const {
+nixlAgent::getLookupResults(const nixlDirLookupH* lookup_hndl,
+                            std::vector<nixl_dir_blocks_t> &blocks) const {
+    if (!lookup_hndl)
+        return NIXL_ERR_INVALID_PARAM;
 
-    // Using a set as order is not important to revert the operation
-    backend_set_t* backend_set;
-    nixl_status_t  ret;
-    int            count = 0;
-    bool           init_side = (agent_name == NIXL_INIT_AGENT);
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    std::lock_guard<std::mutex> dir_lock(data->dirLock);
+    if (lookup_hndl->status != NIXL_SUCCESS)
+        return lookup_hndl->status;
+
+    std::map<std::pair<std::string, nixl_mem_t>, size_t> groups;
+    for (auto &key : lookup_hndl->keys) {
+        auto it = lookup_hndl->found.find(key);
+        if (it == lookup_hndl->found.end())
+            continue;
 
-    NIXL_LOCK_GUARD(data->lock);
-    // When central KV is supported, still it should return error,
-    // just we can add a call to fetchRemoteMD for next time
-    if (!init_side && (data->remoteSections.count(agent_name) == 0))
-        return NIXL_ERR_NOT_FOUND;
+        // Unpublishing is not acknowledged by the shards, so a block can be answered after
+        // its holder deregistered it. Only blocks registered with the holder, as far as this
+        // agent knows it, are returned.
+        const nixlDirEntry &entry = it->second;
+        if (!data->dirRegistered(entry))
+            continue;
+        auto group = groups.emplace(std::make_pair(entry.agent, entry.memType), blocks.size());
+        if (group.second)
+            blocks.emplace_back(entry.agent, entry.memType);
+        nixl_dir_blocks_t &holder = blocks[group.first->second];
+        holder.keys.push_back(key);
+        holder.descs.addDesc(nixlBasicDesc(entry.addr, entry.len, entry.devId));
+    }
+    return NIXL_SUCCESS;
+}
 
-    if (!extra_params || extra_params->backends.size() == 0) {
-        if (!init_side)
-            backend_set = data->remoteSections[agent_name]->
-                                queryBackends(descs.getType());
-        else
-            backend_set = data->memorySection->
-                                queryBackends(descs.getType());
+nixl_status_t
+nixlAgent::releaseLookup(nixlDirLookupH* lookup_hndl) {
+    if (!lookup_hndl)
+        return NIXL_ERR_INVALID_PARAM;
 
-        if (!backend_set || backend_set->empty())
-            return NIXL_ERR_NOT_FOUND;
-    } else {
-        backend_set = new backend_set_t();
-        for (auto & elm : extra_params->backends)
-            backend_set->insert(elm->engine);
+    {
+        std::lock_guard<std::mutex> dir_lock(data->dirLock);
+        data->dirLookups.erase(lookup_hndl->lookupId);
     }
+    delete lookup_hndl;
+    return NIXL_SUCCESS;
+}
 
-    // TODO [Perf]: Avoid heap allocation on the datapath, maybe use a mem pool
+nixl_status_t
+nixlAgent::createMultiXferReq(const nixl_xfer_op_t &operation,
+                              const nixl_xfer_dlist_t &local_descs,
+                              const nixl_xfer_dlist_t &remote_descs,
+                              const std::vector<std::string> &remote_agents,
+                              nixlMultiXferReqH* &req_hndl,
+                              const nixl_opt_args_t* extra_params) const {
+    req_hndl = nullptr;
 
-    nixlDlistH *handle = new nixlDlistH;
-    if (init_side) {
-        handle->isLocal     = true;
-        handle->remoteAgent = "";
-    } else {
-        handle->isLocal     = false;
-        handle->remoteAgent = agent_name;
+    if (local_descs.descCount() == 0 || local_descs.descCount() != remote_descs.descCount() ||
+        remote_agents.size() != (size_t)remote_descs.descCount()) {
+        NIXL_ERROR << "Multi-peer transfer needs one remote agent per descriptor";
+        return NIXL_ERR_INVALID_PARAM;
     }
 
-    for (auto & backend : *backend_set) {
-        handle->descs[backend] = new nixl_meta_dlist_t (
-                                         descs.getType(),
-                                         descs.isSorted());
-        if (init_side)
-            ret = data->memorySection->populate(
-                       descs, backend, *(handle->descs[backend]));
-        else
-            ret = data->remoteSections[agent_name]->populate(
-                       descs, backend, *(handle->descs[backend]));
-        if (ret == NIXL_SUCCESS) {
-            count++;
-        } else {
-            delete handle->descs[backend];
-            handle->descs.erase(backend);
+    // Split the descriptors per remote agent, keeping their order within each agent
+    std::vector<std::string> agent_order;
+    std::unordered_map<std::string, std::pair<nixl_xfer_dlist_t, nixl_xfer_dlist_t>> agent_descs;
+    for (int i = 0; i < remote_descs.descCount(); i++) {
+        auto it = agent_descs.find(remote_agents[i]);
+        if (it == agent_descs.end()) {
+            agent_order.push_back(remote_agents[i]);
+            it = agent_descs.emplace(remote_agents[i],
+                                     std::make_pair(nixl_xfer_dlist_t(local_descs.getType()),
+                                                    nixl_xfer_dlist_t(remote_descs.getType())))
+                     .first;
         }
+        it->second.first.addDesc(local_descs[i]);
+        it->second.second.addDesc(remote_descs[i]);
     }
 
-    if (extra_params && extra_params->backends.size() > 0)
-        delete backend_set;
-
-    if (count == 0) {
-        delete handle;
-        dlist_hndl = nullptr;
-        return NIXL_ERR_NOT_FOUND;
-    } else {
-        dlist_hndl = handle;
-        return NIXL_SUCCESS;
+    auto handle = std::make_unique<nixlMultiXferReqH>();
+    for (auto &agent : agent_order) {
+        nixlXferReqH* req = nullptr;
+        auto &descs = agent_descs.at(agent);
+        nixl_status_t ret = createXferReq(operation, descs.first, descs.second, agent, req,
+                                          extra_params);
+        if (ret != NIXL_SUCCESS) {
+            NIXL_ERROR << "Failed to create multi-peer transfer part for " << agent;
+            for (auto &created : handle->reqs)
+                releaseXferReq(created);
+            return ret;
+        }
+        handle->reqs.push_back(req);
     }
+
+    req_hndl = handle.release();
+    return NIXL_SUCCESS;
 }
 
 nixl_status_t
-nixlAgent::makeXferReq (const nixl_xfer_op_t &operation,
-                        const nixlDlistH* local_side,
-                        const std::vector<int> &local_indices,
-                        const nixlDlistH* remote_side,
-                        const std::vector<int> &remote_indices,
-                        nixlXferReqH* &req_hndl,
-                        const nixl_opt_args_t* extra_params) const {
+nixlAgent::postMultiXferReq(nixlMultiXferReqH* req_hndl,
+                            const nixl_opt_args_t* extra_params) const {
+    if (!req_hndl)
+        return NIXL_ERR_INVALID_PARAM;
 
-    nixl_opt_b_args_t  opt_args;
-    nixl_status_t      ret;
-    int                desc_count = (int) local_indices.size();
-    nixlBackendEngine* backend    = nullptr;
+    if (getMultiXferStatus(req_hndl) == NIXL_IN_PROG)
+        return NIXL_ERR_REPOST_ACTIVE;
+
+    // Parts are posted without releasing them on errors, unlike postXferReq,
+    // since the multi-peer handle still refers to them
+    req_hndl->status = NIXL_SUCCESS;
+    for (auto &req : req_hndl->reqs) {
+        if (extra_params) {
+            req->hasNotif = extra_params->hasNotif;
+            if (extra_params->hasNotif)
+                req->notifMsg = extra_params->notifMsg;
+        }
 
-    req_hndl = nullptr;
+        nixl_status_t ret = data->postGraphReq(req);
+        if (ret < 0) {
+            NIXL_ERROR << "Failed to post multi-peer transfer part for " << req->remoteAgent
+                       << ": " << nixlEnumStrings::statusStr(ret);
+            req_hndl->status = ret;
+            return ret;
+        }
+        if (ret == NIXL_IN_PROG)
+            req_hndl->status = NIXL_IN_PROG;
+    }
 
-    if (!local_side || !remote_side)
-        return NIXL_ERR_INVALID_PARAM;
+    return req_hndl->status;
+}
 
-    if ((!local_side->isLocal) || (remote_side->isLocal))
+nixl_status_t
+nixlAgent::getMultiXferStatus(nixlMultiXferReqH* req_hndl) const {
+    if (!req_hndl)
         return NIXL_ERR_INVALID_PARAM;
 
-    NIXL_LOCK_GUARD(data->lock);
-    // The remote was invalidated in between prepXferDlist and this call
-    if (data->remoteSections.count(remote_side->remoteAgent) == 0) {
-        delete req_hndl;
-        return NIXL_ERR_NOT_FOUND;
+    if (req_hndl->status != NIXL_IN_PROG)
+        return req_hndl->status;
+
+    // Group the parts still in progress per backend, so each backend
+    // checks all of its parts in one call
+    std::unordered_map<nixlBackendEngine*, std::vector<nixlXferReqH*>> pending;
+    std::vector<nixlBackendReqH*> handles;
+    std::vector<nixl_status_t> status;
+
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    req_hndl->status = NIXL_SUCCESS;
+    for (auto &req : req_hndl->reqs) {
+        if (req->status != NIXL_IN_PROG)
+            continue;
+        // Check if the remote was invalidated before completion
+        if (data->remoteSections.count(req->remoteAgent) == 0) {
+            req_hndl->status = NIXL_ERR_NOT_FOUND;
+            return req_hndl->status;
+        }
+        pending[req->engine].push_back(req);
     }
 
-    if (extra_params && extra_params->backends.size() > 0) {
-        for (auto & elm : extra_params->backends) {
-            if ((local_side->descs.count(elm->engine) > 0) &&
-                (remote_side->descs.count(elm->engine) > 0)) {
-                backend = elm->engine;
-                break;
-            }
+    for (auto &[engine, reqs] : pending) {
+        handles.clear();
+        for (auto &req : reqs)
+            handles.push_back(req->backendHandle);
+
+        nixl_status_t ret = engine->checkXfers(handles, status);
+        if (ret < 0) {
+            req_hndl->status = ret;
+            return ret;
         }
-    } else {
-        for (auto & loc_bknd : local_side->descs) {
-            for (auto & rem_bknd : remote_side->descs) {
-                if (loc_bknd.first == rem_bknd.first) {
-                    backend = loc_bknd.first;
-                    break;
-                }
-            }
-            if (backend)
-                break;
+
+        for (size_t i = 0; i < reqs.size(); i++) {
+            reqs[i]->status = status[i];
+            if (status[i] < 0)
+                req_hndl->status = status[i];
+            else if (status[i] == NIXL_IN_PROG && req_hndl->status == NIXL_SUCCESS)
+                req_hndl->status = NIXL_IN_PROG;
         }
     }
 
-    if (!backend)
+    return req_hndl->status;
+}
+
+nixl_status_t
+nixlAgent::releaseMultiXferReq(nixlMultiXferReqH* req_hndl) const {
+    if (!req_hndl)
+        return NIXL_ERR_INVALID_PARAM;
+
+    nixl_status_t ret = NIXL_SUCCESS;
+    for (auto &req : req_hndl->reqs)
+        if (releaseXferReq(req) != NIXL_SUCCESS)
+            ret = NIXL_ERR_REPOST_ACTIVE;
+
+    delete req_hndl;
+    return ret;
+}
+
+nixl_status_t
+nixlAgent::createReplicaXferReq(const nixl_xfer_op_t &operation,
+                                const nixl_xfer_dlist_t &local_descs,
+                                const std::vector<nixl_xfer_dlist_t> &remote_descs,
+                                const std::vector<std::string> &remote_agents,
+                                nixlReplicaXferReqH* &req_hndl,
+                                const nixl_opt_args_t* extra_params) {
+    req_hndl = nullptr;
+    data->reapStagedReads(this);
+
+    if (remote_descs.empty() || remote_descs.size() != remote_agents.size()) {
+        NIXL_ERROR << "Replicated transfer needs one remote agent per remote descriptor list";
+        return NIXL_ERR_INVALID_PARAM;
+    }
+
+    auto handle = std::make_unique<nixlReplicaXferReqH>(operation, local_descs);
+    if (extra_params)
+        handle->createArgs = *extra_params;
+
+    const auto &args = handle->createArgs;
+    if (args.hedgePercentile < 0 || args.hedgePercentile > 1) {
+        NIXL_ERROR << "Hedge percentile must be between 0 and 1";
+        return NIXL_ERR_INVALID_PARAM;
+    }
+    handle->quorum = args.writeQuorum ? args.writeQuorum : remote_descs.size();
+    if (handle->quorum > remote_descs.size()) {
+        NIXL_ERROR << "Write quorum of " << handle->quorum << " exceeds the "
+                   << remote_descs.size() << " targets";
         return NIXL_ERR_INVALID_PARAM;
+    }
+
+    const bool staged = (operation == NIXL_READ && remote_descs.size() > 1 &&
+                         local_descs.getType() == DRAM_SEG);
+    for (auto &desc : local_descs)
+        handle->stagingLen += desc.len;
+
+    for (size_t i = 0; i < remote_descs.size(); i++) {
+        handle->replicas.push_back({remote_agents[i], remote_descs[i]});
+
+        nixl_status_t ret = NIXL_SUCCESS;
+        nixl_xfer_dlist_t staged_descs(DRAM_SEG);
+        if (staged)
+            ret = data->stageReplicaRead(this, handle.get(), i, staged_descs);
+        if (ret == NIXL_SUCCESS)
+            ret = createXferReq(operation, staged ? staged_descs : local_descs,
+                                remote_descs[i], remote_agents[i],
+                                handle->replicas.back().req, extra_params);
+        if (ret != NIXL_SUCCESS) {
+            NIXL_ERROR << "Failed to create replicated transfer part for " << remote_agents[i];
+            data->releaseReplicas(this, handle.get());
+            return ret;
+        }
+    }
 
-    nixl_meta_dlist_t* local_descs  = local_side->descs.at(backend);
-    nixl_meta_dlist_t* remote_descs = remote_side->descs.at(backend);
+    req_hndl = handle.release();
+    return NIXL_SUCCESS;
+}
 
-    if ((desc_count == 0) || (remote_indices.size() == 0) ||
-        (desc_count != (int) remote_indices.size()))
+nixl_status_t
+nixlAgent::postReplicaXferReq(nixlReplicaXferReqH* req_hndl) const {
+    if (!req_hndl)
         return NIXL_ERR_INVALID_PARAM;
 
-    for (int i=0; i<desc_count; ++i) {
-        if ((local_indices[i] >= local_descs->descCount())
-               || (local_indices[i]<0))
-            return NIXL_ERR_INVALID_PARAM;
-        if ((remote_indices[i] >= remote_descs->descCount())
-               || (remote_indices[i]<0))
-            return NIXL_ERR_INVALID_PARAM;
-        if ((*local_descs )[local_indices [i]].len !=
-            (*remote_descs)[remote_indices[i]].len)
-            return NIXL_ERR_INVALID_PARAM;
-    }
+    if (getReplicaXferStatus(req_hndl) == NIXL_IN_PROG)
+        return NIXL_ERR_REPOST_ACTIVE;
 
-    if (extra_params && extra_params->hasNotif) {
-        opt_args.notifMsg = extra_params->notifMsg;
-        opt_args.hasNotif = true;
+    // Writes left to finish after their quorum, staged reads that lost are skipped
+    // until they finished
+    for (auto &replica : req_hndl->replicas) {
+        if (replica.status != NIXL_IN_PROG)
+            continue;
+        if (!replica.lost)
+            return NIXL_ERR_REPOST_ACTIVE;
+        replica.status = data->checkGraphReq(replica.req);
+        replica.lost   = (replica.status == NIXL_IN_PROG);
     }
 
-    if ((opt_args.hasNotif) && (!backend->supportsNotif())) {
-        return NIXL_ERR_BACKEND;
+    req_hndl->lastError = NIXL_SUCCESS;
+    req_hndl->status    = NIXL_IN_PROG;
+
+    if (req_hndl->operation == NIXL_WRITE) {
+        for (auto &replica : req_hndl->replicas) {
+            replica.status = data->postGraphReq(replica.req);
+            if (replica.status < 0)
+                NIXL_ERROR << "Failed to post replicated write to " << replica.agent << ": "
+                           << nixlEnumStrings::statusStr(replica.status);
+        }
+        return getReplicaXferStatus(req_hndl);
     }
 
-    // Populate has been already done, no benefit in having sorted descriptors
-    // which will be overwritten by [] assignment operator.
-    nixlXferReqH* handle   = new nixlXferReqH;
-    handle->initiatorDescs = new nixl_meta_dlist_t (
-                                     local_descs->getType(),
-                                     false, desc_count);
+    // The first source is posted by the status check, as it is due right away
+    const auto &args = req_hndl->createArgs;
+    for (auto &replica : req_hndl->replicas)
+        if (!replica.lost)
+            replica.status = NIXL_ERR_NOT_POSTED;
+    req_hndl->nextRead   = 0;
+    req_hndl->won        = false;
+    req_hndl->hedgeDelay = args.hedgeDelayUs ?
+                           std::chrono::microseconds(args.hedgeDelayUs) :
+                           data->hedgeDelayFor(req_hndl->replicas[0].agent,
+                                               args.hedgePercentile);
+    req_hndl->hedgeAt    = std::chrono::steady_clock::now();
+    return getReplicaXferStatus(req_hndl);
+}
 
-    handle->targetDescs    = new nixl_meta_dlist_t (
-                                     remote_descs->getType(),
-                                     false, desc_count);
+nixl_status_t
+nixlAgent::getReplicaXferStatus(nixlReplicaXferReqH* req_hndl) const {
+    if (!req_hndl)
+        return NIXL_ERR_INVALID_PARAM;
 
-    if (extra_params && extra_params->skipDescMerge) {
-        for (int i=0; i<desc_count; ++i) {
-            (*handle->initiatorDescs)[i] =
-                                     (*local_descs)[local_indices[i]];
-            (*handle->targetDescs)[i] =
-                                     (*remote_descs)[remote_indices[i]];
+    if (req_hndl->operation == NIXL_WRITE) {
+        // Targets still in progress are checked even after the quorum was reached
+        size_t done = 0, failed = 0;
+        for (auto &replica : req_hndl->replicas) {
+            if (replica.status == NIXL_IN_PROG)
+                replica.status = data->checkGraphReq(replica.req);
+            if (replica.status == NIXL_SUCCESS) {
+                done++;
+            } else if (replica.status < 0 && replica.status != NIXL_ERR_NOT_POSTED) {
+                failed++;
+                req_hndl->lastError = replica.status;
+            }
         }
-    } else {
-        int i = 0, j = 0; //final list size
-        while (i<(desc_count)) {
-            nixlMetaDesc local_desc1  = (*local_descs) [local_indices[i]];
-            nixlMetaDesc remote_desc1 = (*remote_descs)[remote_indices[i]];
 
-            if(i != (desc_count-1) ) {
-                nixlMetaDesc* local_desc2  = &((*local_descs) [local_indices[i+1]]);
-                nixlMetaDesc* remote_desc2 = &((*remote_descs)[remote_indices[i+1]]);
+        if (req_hndl->status == NIXL_IN_PROG) {
+            if (done >= req_hndl->quorum)
+                req_hndl->status = NIXL_SUCCESS;
+            else if (failed > req_hndl->replicas.size() - req_hndl->quorum)
+                req_hndl->status = req_hndl->lastError;
+        }
+        return req_hndl->status;
+    }
 
-              while (((local_desc1.addr + local_desc1.len) == local_desc2->addr)
-                  && ((remote_desc1.addr + remote_desc1.len) == remote_desc2->addr)
-                  && (local_desc1.metadataP == local_desc2->metadataP)
-                  && (remote_desc1.metadataP == remote_desc2->metadataP)
-                  && (local_desc1.devId == local_desc2->devId)
-                  && (remote_desc1.devId == remote_desc2->devId)) {
+    if (req_hndl->status != NIXL_IN_PROG)
+        return req_hndl->status;
 
-                    local_desc1.len += local_desc2->len;
-                    remote_desc1.len += remote_desc2->len;
+    const auto now = std::chrono::steady_clock::now();
+    bool in_flight = false;
+    for (size_t i = 0; i < req_hndl->replicas.size(); i++) {
+        auto &replica = req_hndl->replicas[i];
+        if (replica.status != NIXL_IN_PROG)
+            continue;
 
-                    i++;
-                    if(i == (desc_count-1)) break;
+        replica.status = data->checkGraphReq(replica.req);
+        if (replica.lost) {
+            // Read of a previous post into its staging buffer
+            replica.lost = (replica.status == NIXL_IN_PROG);
+            continue;
+        }
+        if (replica.status == NIXL_SUCCESS && !req_hndl->won)
+            data->finishReplicaRead(req_hndl, i, now);
+        else if (replica.status == NIXL_IN_PROG)
+            in_flight = true;
+        else if (replica.status < 0)
+            req_hndl->lastError = replica.status;
+    }
 
-                    local_desc2  = &((*local_descs) [local_indices[i+1]]);
-                    remote_desc2 = &((*remote_descs)[remote_indices[i+1]]);
-                }
-            }
+    // Post the next source once the hedge delay passed, or right away if
+    // no read is left in flight as the previous sources failed
+    while (!req_hndl->won && req_hndl->nextRead < req_hndl->replicas.size() &&
+           (!in_flight || now >= req_hndl->hedgeAt)) {
+        const size_t idx = req_hndl->nextRead++;
+        auto &replica = req_hndl->replicas[idx];
+        if (!replica.req || replica.lost)
+            continue;
 
-            (*handle->initiatorDescs)[j] = local_desc1;
-            (*handle->targetDescs)   [j] = remote_desc1;
-            j++;
-            i++;
+        if (idx > 0)
+            NIXL_DEBUG << "Hedging replicated read to " << replica.agent;
+        replica.postTime = now;
+        replica.status   = data->postGraphReq(replica.req);
+        if (replica.status == NIXL_SUCCESS) {
+            data->finishReplicaRead(req_hndl, idx, now);
+            break;
         }
-        NIXL_DEBUG << "reqH descList size down to " << j;
-        handle->initiatorDescs->resize(j);
-        handle->targetDescs->resize(j);
+        if (replica.status == NIXL_IN_PROG) {
+            in_flight = true;
+            req_hndl->hedgeAt = now + req_hndl->hedgeDelay;
+            break;
+        }
+        NIXL_ERROR << "Failed to post replicated read from " << replica.agent << ": "
+                   << nixlEnumStrings::statusStr(replica.status);
+        req_hndl->lastError = replica.status;
     }
 
-    handle->engine      = backend;
-    handle->remoteAgent = remote_side->remoteAgent;
-    handle->notifMsg    = opt_args.notifMsg;
-    handle->hasNotif    = opt_args.hasNotif;
-    handle->backendOp   = operation;
-    handle->status      = NIXL_ERR_NOT_POSTED;
-
-    ret = handle->engine->prepXfer (handle->backendOp,
-                                    *handle->initiatorDescs,
-                                    *handle->targetDescs,
-                                    handle->remoteAgent,
-                                    handle->backendHandle,
-                                    &opt_args);
-    if (ret != NIXL_SUCCESS) {
-        delete handle;
-        return ret;
+    // Losers of unstaged reads write to the local descriptors, so they are waited for
+    if (req_hndl->won) {
+        if (!in_flight || req_hndl->replicas[0].staging)
+            req_hndl->status = NIXL_SUCCESS;
+        return req_hndl->status;
     }
 
-    req_hndl = handle;
+    if (!in_flight)
+        req_hndl->status = (req_hndl->lastError != NIXL_SUCCESS) ? req_hndl->lastError :
+                                                                  NIXL_ERR_NOT_FOUND;
+    return req_hndl->status;
+}
+
+nixl_status_t
+nixlAgent::getReplicaXferSource(const nixlReplicaXferReqH* req_hndl, size_t &source) const {
+    if (!req_hndl || req_hndl->operation != NIXL_READ || req_hndl->status != NIXL_SUCCESS)
+        return NIXL_ERR_INVALID_PARAM;
+
+    source = req_hndl->source;
     return NIXL_SUCCESS;
 }
 
 nixl_status_t
-nixlAgent::createXferReq(const nixl_xfer_op_t &operation,
-                         const nixl_xfer_dlist_t &local_descs,
-                         const nixl_xfer_dlist_t &remote_descs,
-                         const std::string &remote_agent,
-                         nixlXferReqH* &req_hndl,
-                         const nixl_opt_args_t* extra_params) const {
-    nixl_status_t     ret1, ret2;
-    nixl_opt_b_args_t opt_args;
-    backend_set_t*    backend_set = new backend_set_t();
+nixlAgent::releaseReplicaXferReq(nixlReplicaXferReqH* req_hndl) {
+    if (!req_hndl)
+        return NIXL_ERR_INVALID_PARAM;
 
-    req_hndl = nullptr;
+    nixl_status_t ret = data->releaseReplicas(this, req_hndl);
+    delete req_hndl;
+    data->reapStagedReads(this);
+    return ret;
+}
 
-    NIXL_SHARED_LOCK_GUARD(data->lock);
-    if (data->remoteSections.count(remote_agent) == 0)
-    {
-        delete backend_set;
-        return NIXL_ERR_NOT_FOUND;
-    }
+nixl_status_t
+nixlAgent::createXferGraph(nixlXferGraphH* &graph_hndl) const {
+    graph_hndl = new nixlXferGraphH();
+    return NIXL_SUCCESS;
+}
 
-    // Check the correspondence between descriptor lists
-    if (local_descs.descCount() != remote_descs.descCount())
+nixl_status_t
+nixlAgent::addXferGraphNode(nixlXferGraphH* graph_hndl,
+                            nixlXferReqH* req_hndl,
+                            const std::vector<nixlXferReqH*> &deps) const {
+    if (!graph_hndl || !req_hndl)
         return NIXL_ERR_INVALID_PARAM;
-    for (int i=0; i<local_descs.descCount(); ++i)
-        if (local_descs[i].len != remote_descs[i].len)
-            return NIXL_ERR_INVALID_PARAM;
 
-    if (!extra_params || extra_params->backends.size() == 0) {
-        // Finding backends that support the corresponding memories
-        // locally and remotely, and find the common ones.
-        backend_set_t* local_set =
-            data->memorySection->queryBackends(local_descs.getType());
-        backend_set_t* remote_set =
-            data->remoteSections[remote_agent]->queryBackends(
-                                                remote_descs.getType());
-        if (!local_set || !remote_set) {
-            delete backend_set;
-            return NIXL_ERR_NOT_FOUND;
-        }
+    std::lock_guard<std::mutex> lock(data->graphLock);
+    if (graph_hndl->status == NIXL_IN_PROG) {
+        NIXL_ERROR << "Cannot modify a transfer graph while it is in progress";
+        return NIXL_ERR_NOT_ALLOWED;
+    }
 
-        for (auto & elm : *local_set)
-            if (remote_set->count(elm) != 0)
-                backend_set->insert(elm);
+    if (graph_hndl->nodeIndex.count(req_hndl) != 0) {
+        NIXL_ERROR << "Transfer request is already part of the graph";
+        return NIXL_ERR_INVALID_PARAM;
+    }
 
-        if (backend_set->empty()) {
-            delete backend_set;
+    // Dependencies have to be added before, so the graph is acyclic by construction
+    std::vector<size_t> dep_indices;
+    for (auto &dep : deps) {
+        auto it = graph_hndl->nodeIndex.find(dep);
+        if (it == graph_hndl->nodeIndex.end()) {
+            NIXL_ERROR << "Transfer graph dependency was not added to the graph";
             return NIXL_ERR_NOT_FOUND;
         }
-    } else {
-        for (auto & elm : extra_params->backends)
-            backend_set->insert(elm->engine);
+        if (std::find(dep_indices.begin(), dep_indices.end(), it->second) == dep_indices.end())
+            dep_indices.push_back(it->second);
     }
 
-    // TODO: when central KV is supported, add a call to fetchRemoteMD
-    // TODO: merge descriptors back to back in memory (like makeXferReq).
-    // TODO [Perf]: Avoid heap allocation on the datapath, maybe use a mem pool
+    const size_t idx = graph_hndl->nodes.size();
+    for (auto &dep_idx : dep_indices)
+        graph_hndl->nodes[dep_idx].successors.push_back(idx);
 
-    nixlXferReqH *handle   = new nixlXferReqH;
-    handle->initiatorDescs = new nixl_meta_dlist_t (
-                                     local_descs.getType(),
-                                     local_descs.isSorted());
+    graph_hndl->nodes.emplace_back();
+    graph_hndl->nodes.back().req     = req_hndl;
+    graph_hndl->nodes.back().numDeps = dep_indices.size();
+    graph_hndl->nodeIndex[req_hndl]  = idx;
+    return NIXL_SUCCESS;
+}
 
-    handle->targetDescs    = new nixl_meta_dlist_t (
-                                     remote_descs.getType(),
-                                     remote_descs.isSorted());
+nixl_status_t
+nixlAgent::postXferGraph(nixlXferGraphH* graph_hndl) const {
+    if (!graph_hndl)
+        return NIXL_ERR_INVALID_PARAM;
 
-    // Currently we loop through and find first local match. Can use a
-    // preference list or more exhaustive search.
-    for (auto & backend : *backend_set) {
-        // If populate fails, it clears the resp before return
-        ret1 = data->memorySection->populate(
-                     local_descs, backend, *handle->initiatorDescs);
-        ret2 = data->remoteSections[remote_agent]->populate(
-                     remote_descs, backend, *handle->targetDescs);
+    std::lock_guard<std::mutex> lock(data->graphLock);
+    if (graph_hndl->status == NIXL_IN_PROG)
+        return NIXL_ERR_REPOST_ACTIVE;
 
-        if ((ret1 == NIXL_SUCCESS) && (ret2 == NIXL_SUCCESS)) {
-            NIXL_INFO << "Selected backend: " << backend->getType();
-            handle->engine = backend;
-            break;
-        }
+    std::vector<size_t> ready;
+    for (size_t i = 0; i < graph_hndl->nodes.size(); i++) {
+        auto &node       = graph_hndl->nodes[i];
+        node.pendingDeps = node.numDeps;
+        if (node.numDeps == 0)
+            ready.push_back(i);
     }
 
-    delete backend_set;
+    graph_hndl->running.clear();
+    graph_hndl->remaining = graph_hndl->nodes.size();
+    graph_hndl->status    = NIXL_IN_PROG;
 
-    if (!handle->engine) {
-        delete handle;
-        return NIXL_ERR_NOT_FOUND;
+    data->progressGraph(graph_hndl, ready);
+
+    if (graph_hndl->status == NIXL_IN_PROG && data->config.useProgThread) {
+        data->startGraphThread();
+        data->activeGraphs.push_back(graph_hndl);
+        data->graphCV.notify_one();
     }
 
-    if (extra_params) {
-        if (extra_params->hasNotif) {
-            opt_args.notifMsg = extra_params->notifMsg;
-            opt_args.hasNotif = true;
-        }
+    return graph_hndl->status;
+}
 
-        if (extra_params->customParam.length() > 0)
-            opt_args.customParam = extra_params->customParam;
-    }
+nixl_status_t
+nixlAgent::getXferGraphStatus(nixlXferGraphH* graph_hndl) const {
+    if (!graph_hndl)
+        return NIXL_ERR_INVALID_PARAM;
 
-    if (opt_args.hasNotif && (!handle->engine->supportsNotif())) {
-        delete handle;
-        return NIXL_ERR_BACKEND;
-    }
+    if (graph_hndl->status != NIXL_IN_PROG)
+        return graph_hndl->status;
 
-    handle->remoteAgent = remote_agent;
-    handle->backendOp   = operation;
-    handle->status      = NIXL_ERR_NOT_POSTED;
-    handle->notifMsg    = opt_args.notifMsg;
-    handle->hasNotif    = opt_args.hasNotif;
+    // With graph thread, the graph is progressed in the background, still help
+    // it when the lock is free so polling doesn't delay the next stages
+    std::unique_lock<std::mutex> lock(data->graphLock, std::defer_lock);
+    if (data->config.useProgThread) {
+        if (!lock.try_lock())
+            return graph_hndl->status;
+    } else {
+        lock.lock();
+    }
 
-    ret1 = handle->engine->prepXfer (handle->backendOp,
-                                     *handle->initiatorDescs,
-                                     *handle->targetDescs,
-                                     handle->remoteAgent,
-                                     handle->backendHandle,
-                                     &opt_args);
-    if (ret1 != NIXL_SUCCESS) {
-        delete handle;
-        return ret1;
+    if (graph_hndl->status == NIXL_IN_PROG) {
+        std::vector<size_t> ready;
+        data->progressGraph(graph_hndl, ready);
     }
 
-    req_hndl = handle;
-    return NIXL_SUCCESS;
+    return graph_hndl->status;
 }
 
 nixl_status_t
-nixlAgent::estimateXferCost(const nixlXferReqH *req_hndl,
-                            std::chrono::microseconds &duration,
-                            std::chrono::microseconds &err_margin,
-                            nixl_cost_t &method,
-                            const nixl_opt_args_t* extra_params) const
-{
-    NIXL_SHARED_LOCK_GUARD(data->lock);
-
-    // Check if the remote agent connection info is still valid
-    // (assuming cost estimation requires connection info like transfers)
-    if (!req_hndl->remoteAgent.empty() &&
-        (data->remoteSections.count(req_hndl->remoteAgent) == 0)) {
-        NIXL_ERROR << "Invalid request handle: remote agent not found";
-        return NIXL_ERR_NOT_FOUND;
-    }
+nixlAgent::releaseXferGraph(nixlXferGraphH* graph_hndl) const {
+    if (!graph_hndl)
+        return NIXL_ERR_INVALID_PARAM;
 
-    if (!req_hndl->engine) {
-        NIXL_ERROR << "Invalid request handle: engine is null";
-        return NIXL_ERR_UNKNOWN;
-    }
+    std::lock_guard<std::mutex> lock(data->graphLock);
+    auto &active = data->activeGraphs;
+    active.erase(std::remove(active.begin(), active.end(), graph_hndl), active.end());
 
-    return req_hndl->engine->estimateXferCost(req_hndl->backendOp,
-                                              *req_hndl->initiatorDescs,
-                                              *req_hndl->targetDescs,
-                                              req_hndl->remoteAgent,
-                                              req_hndl->backendHandle,
-                                              duration,
-                                              err_margin,
-                                              method,
-                                              extra_params);
+    // Requests in flight stay with the user, releasing them cancels the transfers
+    if (graph_hndl->status == NIXL_IN_PROG)
+        NIXL_DEBUG << "Releasing transfer graph with requests in progress";
+
+    delete graph_hndl;
+    return NIXL_SUCCESS;
 }
 
 nixl_status_t
-nixlAgent::postXferReq(nixlXferReqH *req_hndl,
-                       const nixl_opt_args_t* extra_params) const {
-    nixl_status_t ret;
-    nixl_opt_b_args_t opt_args;
-
-    opt_args.hasNotif = false;
+nixlAgent::createBcastReq(const nixl_xfer_dlist_t &local_descs,
+                          const std::vector<std::string> &remote_agents,
+                          const std::vector<nixl_xfer_dlist_t> &remote_descs,
+                          nixlBcastReqH* &req_hndl,
+                          const nixl_opt_args_t* extra_params) const {
+    req_hndl = nullptr;
 
-    if (!req_hndl)
+    if (local_descs.descCount() != 1 || remote_agents.empty() ||
+        remote_agents.size() != remote_descs.size()) {
+        NIXL_ERROR << "Broadcast takes a single local descriptor and one per remote agent";
         return NIXL_ERR_INVALID_PARAM;
-
-    NIXL_SHARED_LOCK_GUARD(data->lock);
-    // Check if the remote was invalidated before post/repost
-    if (data->remoteSections.count(req_hndl->remoteAgent) == 0) {
-        delete req_hndl;
-        return NIXL_ERR_NOT_FOUND;
     }
 
-    // We can't repost while a request is in progress
-    if (req_hndl->status == NIXL_IN_PROG) {
-        req_hndl->status = req_hndl->engine->checkXfer(
-                                     req_hndl->backendHandle);
-        if (req_hndl->status == NIXL_IN_PROG) {
-            delete req_hndl;
-            return NIXL_ERR_REPOST_ACTIVE;
-        }
-    }
+    const size_t total_len = local_descs[0].len;
+    if (total_len == 0)
+        return NIXL_ERR_INVALID_PARAM;
 
-    // Carrying over notification from xfer handle creation time
-    if (req_hndl->hasNotif) {
-        opt_args.notifMsg = req_hndl->notifMsg;
-        opt_args.hasNotif = true;
+    // Nodes of the schedule in the order of remote_agents, the initiator first
+    nixl_bcast_tree_t nodes;
+    nodes.push_back({data->name, local_descs[0].addr, local_descs[0].devId,
+                     local_descs.getType(), 0});
+    for (size_t i = 0; i < remote_agents.size(); i++) {
+        if (remote_descs[i].descCount() != 1 || remote_descs[i][0].len != total_len) {
+            NIXL_ERROR << "Broadcast buffer of " << remote_agents[i]
+                       << " doesn't match the local buffer";
+            return NIXL_ERR_INVALID_PARAM;
+        }
+        if (remote_agents[i] == data->name ||
+            std::find(remote_agents.begin(), remote_agents.begin() + i, remote_agents[i]) !=
+                remote_agents.begin() + i) {
+            NIXL_ERROR << "Broadcast receiver " << remote_agents[i] << " is invalid or repeated";
+            return NIXL_ERR_INVALID_PARAM;
+        }
+        nodes.push_back({remote_agents[i], remote_descs[i][0].addr, remote_descs[i][0].devId,
+                         remote_descs[i].getType(), 0});
     }
 
-    // Updating the notification based on opt_args
+    size_t chunk_size = bcast_default_chunk_size;
+    size_t fanout     = 1;
+    nixl_opt_args_t xfer_params;
     if (extra_params) {
-        if (extra_params->hasNotif) {
-            req_hndl->notifMsg = extra_params->notifMsg;
-            opt_args.notifMsg  = extra_params->notifMsg;
-            req_hndl->hasNotif = true;
-            opt_args.hasNotif  = true;
-        } else {
-            req_hndl->hasNotif = false;
-            opt_args.hasNotif  = false;
-        }
+        if (extra_params->bcastChunkSize > 0)
+            chunk_size = extra_params->bcastChunkSize;
+        if (extra_params->bcastFanout == 0)
+            return NIXL_ERR_INVALID_PARAM;
+        fanout = extra_params->bcastFanout;
+        xfer_params.backends = extra_params->backends;
     }
 
-    if (opt_args.hasNotif && (!req_hndl->engine->supportsNotif())) {
-        delete req_hndl;
-        return NIXL_ERR_BACKEND;
+    auto handle = std::make_unique<nixlBcastReqH>();
+    handle->bcastId  = data->name + ":" + std::to_string(data->bcastCount++);
+    handle->totalLen = total_len;
+    if (extra_params && extra_params->hasNotif)
+        handle->notifMsg = extra_params->notifMsg;
+    bcastBuildTree(nodes, 0, fanout, handle->schedule);
+
+    // The initiator writes every chunk to each of its children, the rest of the
+    // schedule is covered by the relays. Chunk notifications are set on post.
+    const auto &tree = handle->schedule;
+    for (auto &child : bcastChildren(tree, 0)) {
+        for (size_t offset = 0; offset < total_len; offset += chunk_size) {
+            const size_t len = std::min(chunk_size, total_len - offset);
+            nixl_xfer_dlist_t chunk_local(tree[0].memType);
+            nixl_xfer_dlist_t chunk_remote(tree[child].memType);
+            chunk_local.addDesc(nixlBasicDesc(tree[0].addr + offset, len, tree[0].devId));
+            chunk_remote.addDesc(nixlBasicDesc(tree[child].addr + offset, len,
+                                               tree[child].devId));
+
+            nixlXferReqH* req = nullptr;
+            nixl_status_t ret = createXferReq(NIXL_WRITE, chunk_local, chunk_remote,
+                                              tree[child].agent, req, &xfer_params);
+            if (ret != NIXL_SUCCESS) {
+                NIXL_ERROR << "Failed to create broadcast transfer to " << tree[child].agent;
+                for (auto &chunk : handle->chunks)
+                    releaseXferReq(chunk.req);
+                return ret;
+            }
+            handle->chunks.push_back({req, child, offset, len});
+        }
     }
 
-    // If status is not NIXL_IN_PROG we can repost,
-    ret = req_hndl->engine->postXfer (req_hndl->backendOp,
-                                     *req_hndl->initiatorDescs,
-                                     *req_hndl->targetDescs,
-                                      req_hndl->remoteAgent,
-                                      req_hndl->backendHandle,
-                                      &opt_args);
-    req_hndl->status = ret;
-    return ret;
+    req_hndl = handle.release();
+    return NIXL_SUCCESS;
 }
 
 nixl_status_t
-nixlAgent::getXferStatus (nixlXferReqH *req_hndl) const {
+nixlAgent::postBcastReq(nixlBcastReqH* req_hndl) const {
+    if (!req_hndl)
+        return NIXL_ERR_INVALID_PARAM;
 
-    NIXL_SHARED_LOCK_GUARD(data->lock);
-    // If the status is done, no need to recheck.
-    if (req_hndl->status == NIXL_IN_PROG) {
-        // Check if the remote was invalidated before completion
-        if (data->remoteSections.count(req_hndl->remoteAgent) == 0) {
-            delete req_hndl;
-            return NIXL_ERR_NOT_FOUND;
+    if (getBcastStatus(req_hndl) == NIXL_IN_PROG)
+        return NIXL_ERR_REPOST_ACTIVE;
+
+    // Receivers count bytes per broadcast id, so every post gets its own. The children
+    // report the status of their subtrees to the state of the post.
+    const std::string id = req_hndl->bcastId + ":" + std::to_string(req_hndl->postCount++);
+    const auto &tree     = req_hndl->schedule;
+    {
+        std::lock_guard<std::mutex> bcast_lock(data->bcastLock);
+        data->bcastStates.erase(req_hndl->postId);
+        auto &state    = data->bcastStates[id];
+        state.tree     = tree;
+        state.received = req_hndl->totalLen;
+        state.total    = req_hndl->totalLen;
+    }
+    req_hndl->postId = id;
+
+    req_hndl->status = NIXL_SUCCESS;
+    for (auto &chunk : req_hndl->chunks) {
+        const bcastChunk header = {chunk.offset, chunk.len, req_hndl->totalLen};
+        chunk.req->hasNotif = true;
+        chunk.req->notifMsg = bcastMsg(id, data->name, req_hndl->notifMsg, header, tree,
+                                       chunk.child, chunk.offset == 0);
+
+        nixl_status_t ret = data->postGraphReq(chunk.req);
+        if (ret < 0) {
+            NIXL_ERROR << "Failed to post broadcast transfer to " << chunk.req->remoteAgent
+                       << ": " << nixlEnumStrings::statusStr(ret);
+            req_hndl->status = ret;
+            return ret;
         }
-        req_hndl->status = req_hndl->engine->checkXfer(
-                                     req_hndl->backendHandle);
     }
 
+    // Completes once the children report their subtrees
+    req_hndl->status = NIXL_IN_PROG;
     return req_hndl->status;
 }
 
-
 nixl_status_t
-nixlAgent::queryXferBackend(const nixlXferReqH* req_hndl,
-                            nixlBackendH* &backend) const {
-    NIXL_LOCK_GUARD(data->lock);
-    backend = data->backendHandles[req_hndl->engine->getType()];
-    return NIXL_SUCCESS;
-}
+nixlAgent::getBcastStatus(nixlBcastReqH* req_hndl) const {
+    if (!req_hndl)
+        return NIXL_ERR_INVALID_PARAM;
 
-nixl_status_t
-nixlAgent::releaseXferReq(nixlXferReqH *req_hndl) const {
+    if (req_hndl->status != NIXL_IN_PROG)
+        return req_hndl->status;
 
-    NIXL_SHARED_LOCK_GUARD(data->lock);
-    //attempt to cancel request
-    if(req_hndl->status == NIXL_IN_PROG) {
-        req_hndl->status = req_hndl->engine->checkXfer(
-                                     req_hndl->backendHandle);
+    nixl_status_t status = NIXL_SUCCESS;
+    for (auto &chunk : req_hndl->chunks) {
+        nixl_status_t ret = data->checkGraphReq(chunk.req);
+        if (ret < 0) {
+            status = ret;
+            break;
+        }
+        if (ret == NIXL_IN_PROG)
+            status = NIXL_IN_PROG;
+    }
 
-        if(req_hndl->status == NIXL_IN_PROG) {
+    // Statuses of the subtrees arrive as notifications, other notifications drained
+    // here are kept for getNotifs. If another thread is draining, it receives them.
+    if (status == NIXL_SUCCESS) {
+        std::unique_lock<std::mutex> drain_lock(data->notifDrainLock, std::try_to_lock);
+        if (drain_lock.owns_lock()) {
+            notif_list_t agent_msgs;
+            {
+                NIXL_LOCK_GUARD(data->lock);
+                data->drainNotifs(data->notifEngines, agent_msgs);
+            }
+            data->relayDrained(this, agent_msgs);
+            data->trimUnrouted();
+        }
+    }
 
-            req_hndl->status = req_hndl->engine->releaseReqH(
-                                         req_hndl->backendHandle);
+    std::lock_guard<std::mutex> bcast_lock(data->bcastLock);
+    auto it = data->bcastStates.find(req_hndl->postId);
+    if (it != data->bcastStates.end()) {
+        if (status == NIXL_SUCCESS || it->second.status < 0)
+            status = data->bcastSubtreeStatus(it->second);
+        if (status != NIXL_IN_PROG)
+            data->bcastStates.erase(it);
+    }
 
-            if(req_hndl->status < 0)
-                return NIXL_ERR_REPOST_ACTIVE;
+    req_hndl->status = status;
+    return req_hndl->status;
+}
 
-            // just in case the backend doesn't set to NULL on success
-            // this will prevent calling releaseReqH again in destructor
-            req_hndl->backendHandle = nullptr;
-        }
+nixl_status_t
+nixlAgent::releaseBcastReq(nixlBcastReqH* req_hndl) const {
+    if (!req_hndl)
+        return NIXL_ERR_INVALID_PARAM;
+
+    nixl_status_t ret = NIXL_SUCCESS;
+    for (auto &chunk : req_hndl->chunks)
+        if (releaseXferReq(chunk.req) != NIXL_SUCCESS)
+            ret = NIXL_ERR_REPOST_ACTIVE;
+
+    {
+        std::lock_guard<std::mutex> bcast_lock(data->bcastLock);
+        data->bcastStates.erase(req_hndl->postId);
     }
     delete req_hndl;
-    return NIXL_SUCCESS;
+    return ret;
 }
 
 nixl_status_t
-nixlAgent::releasedDlistH (nixlDlistH* dlist_hndl) const {
-    NIXL_LOCK_GUARD(data->lock);
-    delete dlist_hndl;
-    return NIXL_SUCCESS;
+nixlAgent::getNotifs(nixl_notifs_t &notif_map,
+                     const nixl_opt_args_t* extra_params) {
+    notif_list_t    agent_msgs;
+    nixl_status_t   ret;
+    backend_list_t  backend_list;
+    const bool      all_backends = !extra_params || extra_params->backends.size() == 0;
+
+    std::lock_guard<std::mutex> drain_lock(data->notifDrainLock);
+    {
+        NIXL_LOCK_GUARD(data->lock);
+        if (all_backends) {
+            backend_list = data->notifEngines;
+        } else {
+            for (auto & elm : extra_params->backends)
+                if (elm->engine->supportsNotif())
+                    backend_list.push_back(elm->engine);
+        }
+        if (backend_list.empty())
+            return NIXL_ERR_BACKEND;
+
+        ret = data->drainNotifs(backend_list, agent_msgs);
+    }
+
+    // Relays create and post transfers, so they're done outside of the agent lock
+    data->relayDrained(this, agent_msgs);
+
+    // Notifications left over by subscription drains come first. The ones of no particular
+    // backend are only returned when all backends are queried.
+    if (all_backends)
+        backend_list.push_back(nullptr);
+    for (auto &eng : backend_list) {
+        auto it = data->notifUnrouted.find(eng);
+        if (it == data->notifUnrouted.end())
+            continue;
+        for (auto &elm : it->second)
+            notif_map[elm.first].push_back(std::move(elm.second));
+        data->notifUnrouted.erase(it);
+    }
+
+    return ret;
 }
 
 nixl_status_t
-nixlAgent::getNotifs(nixl_notifs_t &notif_map,
-                     const nixl_opt_args_t* extra_params) {
-    notif_list_t    bknd_notif_list;
-    nixl_status_t   ret, bad_ret=NIXL_SUCCESS;
+nixlAgent::genNotif(const std::string &remote_agent,
+                    const nixl_blob_t &msg,
+                    const nixl_opt_args_t* extra_params) const {
+
+    backend_list_t backend_list_value;
     backend_list_t* backend_list;
 
-    NIXL_LOCK_GUARD(data->lock);
-    if (!extra_params || extra_params->backends.size() == 0) {
+    NIXL_SHARED_LOCK_GUARD(data->lock);
+    if (!extra_params || extra_params->backends.empty()) {
         backend_list = &data->notifEngines;
         if (backend_list->empty())
             return NIXL_ERR_BACKEND;
     } else {
-        backend_list = new backend_list_t();
-        for (auto & elm : extra_params->backends)
+        backend_list = &backend_list_value;
+        for (auto &elm : extra_params->backends)
             if (elm->engine->supportsNotif())
                 backend_list->push_back(elm->engine);
 
         if (backend_list->empty()) {
-            delete backend_list;
             return NIXL_ERR_BACKEND;
         }
     }
 
-    // Doing best effort, if any backend errors out we return
-    // error but proceed with the rest. We can add metadata about
-    // the backend to the msg, but user could put it themselves.
+    bool localNotif = data->name == remote_agent;
     for (auto & eng: *backend_list) {
-        bknd_notif_list.clear();
-        ret = eng->getNotifs(bknd_notif_list);
-        if (ret < 0)
-            bad_ret=ret;
+        if ((localNotif && eng->supportsLocal()) ||
+            (!localNotif &&
+             data->remoteBackends[remote_agent].count(eng->getType()) != 0)) {
+            return eng->genNotif(remote_agent,
+                                 data->notifMsgTo(data->sharedNotifTo(eng, remote_agent),
+                                                  remote_agent, msg));
+        }
+    }
 
-        if (bknd_notif_list.size() == 0)
-            continue;
+    return NIXL_ERR_NOT_FOUND;
+}
 
-        for (auto & elm: bknd_notif_list) {
-            if (notif_map.count(elm.first) == 0)
-                notif_map[elm.first] = std::vector<nixl_blob_t>();
+nixl_status_t
+nixlAgent::getCompactNotifs(nixl_compact_notif_t* notifs,
+                            size_t max_notifs,
+                            size_t &num_notifs,
+                            const nixl_opt_args_t* extra_params) {
+    nixl_status_t ret, bad_ret = NIXL_SUCCESS;
+    bool supported = false;
+
+    num_notifs = 0;
+    if (!notifs && max_notifs > 0)
+        return NIXL_ERR_INVALID_PARAM;
 
-            notif_map[elm.first].push_back(elm.second);
-        }
-    }
+    NIXL_LOCK_GUARD(data->lock);
+    // Same backend selection as getNotifs, without building a list per call
+    auto get_from = [&](nixlBackendEngine* eng) {
+        if (!eng->supportsCompactNotif())
+            return;
+        supported = true;
+
+        size_t count = 0;
+        ret = eng->getCompactNotifs(notifs + num_notifs, max_notifs - num_notifs, count);
+        if (ret < 0)
+            bad_ret = ret;
+        num_notifs += count;
+    };
 
-    if (extra_params && extra_params->backends.size() > 0)
-        delete backend_list;
+    if (!extra_params || extra_params->backends.empty()) {
+        for (auto &eng : data->notifEngines)
+            get_from(eng);
+    } else {
+        for (auto &elm : extra_params->backends)
+            if (elm->engine->supportsNotif())
+                get_from(elm->engine);
+    }
 
+    if (!supported)
+        return NIXL_ERR_NOT_SUPPORTED;
     return bad_ret;
 }
 
 nixl_status_t
-nixlAgent::genNotif(const std::string &remote_agent,
-                    const nixl_blob_t &msg,
-                    const nixl_opt_args_t* extra_params) const {
+nixlAgent::genCompactNotif(const std::string &remote_agent,
+                           uint64_t tag,
+                           const void* payload,
+                           size_t len,
+                           const nixl_opt_args_t* extra_params) const {
+    if (len > compact_notif_max_payload || (!payload && len > 0)) {
+        NIXL_ERROR << "Compact notification payload of " << len << " bytes, at most "
+                   << compact_notif_max_payload << " are supported";
+        return NIXL_ERR_INVALID_PARAM;
+    }
 
     backend_list_t backend_list_value;
     backend_list_t* backend_list;
@@ -984,29 +3715,116 @@ nixlAgent::genNotif(const std::string &remote_agent,
     NIXL_SHARED_LOCK_GUARD(data->lock);
     if (!extra_params || extra_params->backends.empty()) {
         backend_list = &data->notifEngines;
-        if (backend_list->empty())
-            return NIXL_ERR_BACKEND;
     } else {
         backend_list = &backend_list_value;
         for (auto &elm : extra_params->backends)
             if (elm->engine->supportsNotif())
                 backend_list->push_back(elm->engine);
-
-        if (backend_list->empty()) {
-            return NIXL_ERR_BACKEND;
-        }
     }
 
+    bool supported = false;
     bool localNotif = data->name == remote_agent;
     for (auto & eng: *backend_list) {
+        if (!eng->supportsCompactNotif())
+            continue;
+        supported = true;
+
         if ((localNotif && eng->supportsLocal()) ||
             (!localNotif &&
              data->remoteBackends[remote_agent].count(eng->getType()) != 0)) {
-            return eng->genNotif(remote_agent, msg);
+            return eng->genCompactNotif(remote_agent, tag, payload, len);
         }
     }
 
-    return NIXL_ERR_NOT_FOUND;
+    return supported ? NIXL_ERR_NOT_FOUND : NIXL_ERR_NOT_SUPPORTED;
+}
+
+nixl_status_t
+nixlAgent::subscribeNotifs(const nixl_blob_t &prefix,
+                           nixlNotifSubH* &sub_hndl) {
+    std::unique_lock<std::shared_mutex> sub_lock(data->notifSubLock);
+    if (data->notifSubs.count(prefix) != 0) {
+        NIXL_ERROR << "Notifications with prefix '" << prefix << "' are already subscribed";
+        return NIXL_ERR_INVALID_PARAM;
+    }
+
+    sub_hndl = new nixlNotifSubH(prefix);
+    data->notifSubs[prefix] = sub_hndl;
+    data->notifSubLens[prefix.size()]++;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t
+nixlAgent::getSubNotifs(nixlNotifSubH* sub_hndl,
+                        nixl_notifs_t &notif_map) {
+    notif_list_t  notif_list;
+    nixl_status_t ret = NIXL_SUCCESS;
+
+    if (!sub_hndl)
+        return NIXL_ERR_INVALID_PARAM;
+
+    {
+        std::lock_guard<std::mutex> queue_lock(sub_hndl->lock);
+        notif_list.swap(sub_hndl->queue);
+    }
+
+    // Only one thread drains the backends, the others return what's already routed
+    // to them and get their notifications drained on the next call. Broadcast and
+    // directory messages queued by the notification handlers are processed even if
+    // the backends route notifications on their own.
+    if ((notif_list.empty() && data->notifDrainNeeded) || data->notifAgentQueued) {
+        std::unique_lock<std::mutex> drain_lock(data->notifDrainLock, std::try_to_lock);
+        if (drain_lock.owns_lock()) {
+            notif_list_t agent_msgs;
+            {
+                NIXL_LOCK_GUARD(data->lock);
+                if (data->notifDrainNeeded)
+                    ret = data->drainNotifs(data->notifEngines, agent_msgs);
+                else
+                    data->drainNotifs(backend_list_t(), agent_msgs);
+            }
+            data->relayDrained(this, agent_msgs);
+            data->trimUnrouted();
+            drain_lock.unlock();
+
+            std::lock_guard<std::mutex> queue_lock(sub_hndl->lock);
+            notif_list.insert(notif_list.end(),
+                              std::make_move_iterator(sub_hndl->queue.begin()),
+                              std::make_move_iterator(sub_hndl->queue.end()));
+            sub_hndl->queue.clear();
+        }
+    }
+
+    for (auto &elm : notif_list)
+        notif_map[elm.first].push_back(std::move(elm.second));
+
+    return ret;
+}
+
+nixl_status_t
+nixlAgent::unsubscribeNotifs(nixlNotifSubH* sub_hndl) {
+    if (!sub_hndl)
+        return NIXL_ERR_INVALID_PARAM;
+
+    // Once removed, nothing is routed to the subscription anymore
+    std::lock_guard<std::mutex> drain_lock(data->notifDrainLock);
+    {
+        std::unique_lock<std::shared_mutex> sub_lock(data->notifSubLock);
+        auto it = data->notifSubs.find(sub_hndl->prefix);
+        if (it == data->notifSubs.end() || it->second != sub_hndl)
+            return NIXL_ERR_NOT_FOUND;
+
+        data->notifSubs.erase(it);
+        auto len = data->notifSubLens.find(sub_hndl->prefix.size());
+        if (--len->second == 0)
+            data->notifSubLens.erase(len);
+    }
+
+    data->keepUnrouted(nullptr, sub_hndl->queue);
+    data->trimUnrouted();
+
+    delete sub_hndl;
+    return NIXL_SUCCESS;
 }
 
 nixl_status_t
@@ -1183,7 +4001,12 @@ nixlAgent::loadRemoteMD (const nixl_blob_t &remote_metadata,
 
             eng = data->backendEngines[nixl_backend];
             if (eng->supportsRemote()) {
-                ret = eng->loadRemoteConnInfo(remote_agent, conn_info);
+                // The mark of agents on shared backend instances is kept in remoteBackends
+                if (conn_info.compare(0, shared_prefix.size(), shared_prefix) == 0)
+                    ret = eng->loadRemoteConnInfo(remote_agent,
+                                                  conn_info.substr(shared_prefix.size()));
+                else
+                    ret = eng->loadRemoteConnInfo(remote_agent, conn_info);
                 if (ret)
                     return ret; // Error in load
                 count++;
@@ -1243,6 +4066,18 @@ nixlAgent::invalidateRemoteMD(const std::string &remote_agent) {
         ret = NIXL_SUCCESS;
     }
 
+    // Blocks of the agent can't be reached anymore, drop them from the directory shard
+    std::lock_guard<std::mutex> dir_lock(data->dirLock);
+    for (auto it = data->dirShard.begin(); it != data->dirShard.end();) {
+        auto &entries = it->second;
+        entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                     [&remote_agent](const nixlDirEntry &entry) {
+                                         return entry.agent == remote_agent;
+                                     }),
+                      entries.end());
+        it = entries.empty() ? data->dirShard.erase(it) : std::next(it);
+    }
+
     return ret;
 }
 
@@ -1258,6 +4093,12 @@ nixlAgent::sendLocalMD (const nixl_opt_args_t* extra_params) const {
         return NIXL_SUCCESS;
     }
 
+    // If no IP is provided, use the built-in metadata server when there is one
+    if (data->useMDServer) {
+        data->enqueueCommWork(std::make_tuple(MDS_SEND, default_metadata_label, 0, std::move(myMD)));
+        return NIXL_SUCCESS;
+    }
+
 #if HAVE_ETCD
     // If no IP is provided, use etcd (now via thread)
     if (data->useEtcd) {
@@ -1283,6 +4124,15 @@ nixlAgent::sendLocalPartialMD(const nixl_reg_dlist_t &descs,
         return NIXL_SUCCESS;
     }
 
+    if (data->useMDServer) {
+        if (!extra_params || extra_params->metadataLabel.empty()) {
+            NIXL_ERROR << "Metadata label is required for metadata server send of local partial metadata";
+            return NIXL_ERR_INVALID_PARAM;
+        }
+        data->enqueueCommWork(std::make_tuple(MDS_SEND, extra_params->metadataLabel, 0, std::move(myMD)));
+        return NIXL_SUCCESS;
+    }
+
 #if HAVE_ETCD
     // If no IP is provided, use etcd (now via thread)
     if (data->useEtcd) {
@@ -1308,6 +4158,15 @@ nixlAgent::fetchRemoteMD (const std::string remote_name,
         return NIXL_SUCCESS;
     }
 
+    // Fetches queued together are sent to the metadata server as one batch
+    if (data->useMDServer) {
+        std::string metadata_label = extra_params && !extra_params->metadataLabel.empty() ?
+                                     extra_params->metadataLabel :
+                                     default_metadata_label;
+        data->enqueueCommWork(std::make_tuple(MDS_FETCH, std::move(metadata_label), 0, remote_name));
+        return NIXL_SUCCESS;
+    }
+
 #if HAVE_ETCD
     // If no IP is provided, use etcd via thread with watch capability
     if (data->useEtcd) {
@@ -1331,6 +4190,11 @@ nixlAgent::invalidateLocalMD (const nixl_opt_args_t* extra_params) const {
         return NIXL_SUCCESS;
     }
 
+    if (data->useMDServer) {
+        data->enqueueCommWork(std::make_tuple(MDS_INVAL, "", 0, ""));
+        return NIXL_SUCCESS;
+    }
+
 #if HAVE_ETCD
     // If no IP is provided, use etcd via thread
     if (data->useEtcd) {
@@ -21,12 +21,16 @@
 #include "common/str_tools.h"
 #include "agent_data.h"
 #include "common/nixl_log.h"
+#include "md_server_msg.h"
+#include "nixl_md_server.h"
 #if HAVE_ETCD
 #include <etcd/Client.hpp>
 #include <etcd/Watcher.hpp>
 #include <future>
 #endif // HAVE_ETCD
+#include <absl/strings/numbers.h>
 #include <absl/strings/str_format.h>
+#include <set>
 
 const std::string default_metadata_label = "metadata";
 
@@ -101,7 +105,7 @@ sendCommMessage(int fd, const std::string& msg) {
     };
 
     for (size_t i = 0, offset = 0, sent = 0; i < iov_size;) {
-        auto bytes = send(fd, static_cast<char *>(iov[i].iov_base) + offset, iov[i].iov_len - offset, 0);
+        auto bytes = send(fd, static_cast<char *>(iov[i].iov_base) + offset, iov[i].iov_len - offset, MSG_NOSIGNAL);
         if (bytes < 0) {
             if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK) {
                 continue;
@@ -414,6 +418,185 @@ public:
 };
 #endif // HAVE_ETCD
 
+class nixlMDServerClient {
+private:
+    std::string ip;
+    int port = default_md_server_port;
+    int fd = -1;
+    nixlTime::us_t nextConnect = 0;
+
+    // Published labels and fetches, sent again to a server the client reconnects to
+    std::map<std::string, nixl_blob_t> published;
+    std::set<std::pair<std::string, std::string>> fetched;
+
+    // Last generation loaded per agent and label, and invalidated per agent
+    std::map<std::pair<std::string, std::string>, uint64_t> loadedGens;
+    std::unordered_map<std::string, uint64_t> invalidGens;
+
+    static constexpr nixlTime::us_t reconnect_delay = 1000000;
+
+    void disconnect() {
+        close(fd);
+        fd = -1;
+        nextConnect = nixlTime::getUs() + reconnect_delay;
+    }
+
+    bool sendMsg(const std::string &msg) {
+        try {
+            sendCommMessage(fd, msg);
+            return true;
+        }
+        catch (const std::runtime_error &e) {
+            NIXL_ERROR << "Lost connection to metadata server " << ip << ":" << port << ": "
+                       << e.what();
+            disconnect();
+            return false;
+        }
+    }
+
+    // A new server, or a restarted one, starts from its first generation
+    bool ensureConnected(const std::string &agent_name) {
+        if (fd >= 0)
+            return true;
+        if (nixlTime::getUs() < nextConnect)
+            return false;
+
+        fd = connectToIP(ip, port);
+        if (fd < 0) {
+            NIXL_ERROR << "Could not connect to metadata server " << ip << ":" << port;
+            nextConnect = nixlTime::getUs() + reconnect_delay;
+            return false;
+        }
+        NIXL_DEBUG << "Connected to metadata server " << ip << ":" << port;
+        loadedGens.clear();
+        invalidGens.clear();
+
+        std::vector<nixlMDServerEntry> entries;
+        for (const auto &[label, md] : published)
+            entries.push_back({agent_name, label, 0, md});
+        if (!entries.empty() && !sendMsg(nixlMDServerMsg::encode(nixlMDServerMsg::put, entries)))
+            return false;
+
+        entries.clear();
+        for (const auto &[agent, label] : fetched)
+            entries.push_back({agent, label, 0, ""});
+        return entries.empty() || sendMsg(nixlMDServerMsg::encode(nixlMDServerMsg::get, entries));
+    }
+
+public:
+    nixlMDServerClient(const std::string &address) {
+        const auto sep = address.find(':');
+        ip = address.substr(0, sep);
+        if (sep != std::string::npos && !absl::SimpleAtoi(address.substr(sep + 1), &port))
+            throw std::runtime_error("Invalid metadata server address: " + address);
+    }
+
+    ~nixlMDServerClient() {
+        if (fd >= 0)
+            close(fd);
+    }
+
+    nixl_status_t publish(const std::string &agent_name, const std::string &label,
+                          const nixl_blob_t &md) {
+        published[label] = md;
+        if (!ensureConnected(agent_name))
+            return NIXL_ERR_BACKEND;
+        return sendMsg(nixlMDServerMsg::encode(nixlMDServerMsg::put, {{agent_name, label, 0, md}})) ?
+            NIXL_SUCCESS : NIXL_ERR_BACKEND;
+    }
+
+    nixl_status_t remove(const std::string &agent_name) {
+        published.clear();
+        if (!ensureConnected(agent_name))
+            return NIXL_ERR_BACKEND;
+        return sendMsg(nixlMDServerMsg::encode(nixlMDServerMsg::del, {{agent_name, "", 0, ""}})) ?
+            NIXL_SUCCESS : NIXL_ERR_BACKEND;
+    }
+
+    // Metadata that is already stored comes back in one message for the whole batch
+    nixl_status_t fetch(const std::string &agent_name,
+                        const std::vector<std::pair<std::string, std::string>> &batch) {
+        std::vector<nixlMDServerEntry> entries;
+        for (const auto &[agent, label] : batch) {
+            fetched.emplace(agent, label);
+            entries.push_back({agent, label, 0, ""});
+        }
+        // A reconnection fetches all the labels already
+        if (fd < 0)
+            return ensureConnected(agent_name) ? NIXL_SUCCESS : NIXL_ERR_BACKEND;
+        return sendMsg(nixlMDServerMsg::encode(nixlMDServerMsg::get, entries)) ?
+            NIXL_SUCCESS : NIXL_ERR_BACKEND;
+    }
+
+    // Loads and invalidates the metadata pushed by the server
+    void processPushes(nixlAgent *my_agent, const std::string &agent_name) {
+        if (!ensureConnected(agent_name))
+            return;
+
+        char peek;
+        if (recv(fd, &peek, 1, MSG_PEEK | MSG_DONTWAIT) == 0) {
+            NIXL_ERROR << "Metadata server " << ip << ":" << port << " closed the connection";
+            disconnect();
+            return;
+        }
+
+        std::string msg;
+        std::string op;
+        std::vector<nixlMDServerEntry> entries;
+        while (true) {
+            try {
+                if (!recvCommMessage(fd, msg))
+                    break;
+            }
+            catch (const std::runtime_error &e) {
+                NIXL_ERROR << "Lost connection to metadata server " << ip << ":" << port << ": "
+                           << e.what();
+                disconnect();
+                return;
+            }
+
+            if (!nixlMDServerMsg::decode(msg, op, entries)) {
+                NIXL_ERROR << "Received a malformed message from metadata server";
+                continue;
+            }
+
+            for (const auto &entry : entries) {
+                // Older than what was loaded or invalidated, pushes can cross fetch replies
+                auto &loaded_gen = loadedGens[{entry.agent, entry.label}];
+                auto &invalid_gen = invalidGens[entry.agent];
+                if (op == nixlMDServerMsg::load) {
+                    if (entry.gen <= loaded_gen || entry.gen <= invalid_gen)
+                        continue;
+                    loaded_gen = entry.gen;
+
+                    std::string remote_agent;
+                    nixl_status_t ret = my_agent->loadRemoteMD(entry.md, remote_agent);
+                    if (ret != NIXL_SUCCESS) {
+                        NIXL_ERROR << "Failed to load remote metadata of agent " << entry.agent
+                                   << " from metadata server: " << ret;
+                    } else if (remote_agent != entry.agent) {
+                        NIXL_ERROR << "Metadata mismatch for agent: " << entry.agent
+                                   << " from md: " << remote_agent;
+                    } else {
+                        NIXL_DEBUG << "Loaded metadata of agent " << entry.agent << " label "
+                                   << entry.label << " generation " << entry.gen;
+                    }
+                } else if (op == nixlMDServerMsg::inval) {
+                    if (entry.gen <= invalid_gen)
+                        continue;
+                    invalid_gen = entry.gen;
+                    nixl_status_t ret = my_agent->invalidateRemoteMD(entry.agent);
+                    if (ret != NIXL_SUCCESS && ret != NIXL_ERR_NOT_FOUND)
+                        NIXL_ERROR << "Failed to invalidate remote metadata for agent: "
+                                   << entry.agent << ": " << ret;
+                } else {
+                    NIXL_ERROR << "Received unknown operation " << op << " from metadata server";
+                }
+            }
+        }
+    }
+};
+
 } // unnamed namespace
 
 void nixlAgentData::commWorker(nixlAgent* myAgent){
@@ -425,9 +608,14 @@ void nixlAgentData::commWorker(nixlAgent* myAgent){
         etcdClient = std::make_unique<nixlEtcdClient>(name);
     }
 #endif // HAVE_ETCD
+    std::unique_ptr<nixlMDServerClient> mdsClient;
+    if (useMDServer) {
+        mdsClient = std::make_unique<nixlMDServerClient>(mdServerAddr);
+    }
 
     while(!(commThreadStop)) {
         std::vector<nixl_comm_req_t> work_queue;
+        std::vector<std::pair<std::string, std::string>> mds_fetches;
 
         // first, accept new connections
         int new_fd = 0;
@@ -502,6 +690,27 @@ void nixlAgentData::commWorker(nixlAgent* myAgent){
                 sendCommMessage(client_fd, "NIXLCOMM:INVL" + name);
                 break;
             }
+            case MDS_SEND: {
+                const std::string &metadata_label = req_ip;
+                nixl_status_t ret = mdsClient->publish(name, metadata_label, my_MD);
+                if (ret != NIXL_SUCCESS) {
+                    NIXL_ERROR << "Failed to store metadata in metadata server: " << ret;
+                }
+                break;
+            }
+            case MDS_FETCH: {
+                const std::string &metadata_label = req_ip;
+                const std::string &remote_agent = my_MD;
+                mds_fetches.emplace_back(remote_agent, metadata_label);
+                break;
+            }
+            case MDS_INVAL: {
+                nixl_status_t ret = mdsClient->remove(name);
+                if (ret != NIXL_SUCCESS) {
+                    NIXL_ERROR << "Failed to invalidate metadata in metadata server: " << ret;
+                }
+                break;
+            }
 #if HAVE_ETCD
                 // ETCD operations using existing methods
                 case ETCD_SEND:
@@ -574,6 +783,13 @@ void nixlAgentData::commWorker(nixlAgent* myAgent){
             }
         }
 
+        if (!mds_fetches.empty()) {
+            nixl_status_t ret = mdsClient->fetch(name, mds_fetches);
+            if (ret != NIXL_SUCCESS) {
+                NIXL_ERROR << "Failed to fetch metadata from metadata server: " << ret;
+            }
+        }
+
         // third, do remote commands
         auto socket_iter = remoteSockets.begin();
         while (socket_iter != remoteSockets.end()) {
@@ -630,6 +846,10 @@ void nixlAgentData::commWorker(nixlAgent* myAgent){
         }
 #endif // HAVE_ETCD
 
+        if (mdsClient) {
+            mdsClient->processPushes(myAgent, name);
+        }
+
         nixlTime::us_t start = nixlTime::getUs();
         while( (start + config.lthrDelay) > nixlTime::getUs()) {
             std::this_thread::yield();
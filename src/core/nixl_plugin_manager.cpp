@@ -405,4 +405,9 @@ void nixlPluginManager::registerBuiltinPlugins() {
         extern nixlBackendPlugin *createStaticObjPlugin();
         registerStaticPlugin ("OBJ", createStaticObjPlugin);
 #endif // STATIC_PLUGIN_OBJ
+
+#ifdef STATIC_PLUGIN_URING_TCP
+        extern nixlBackendPlugin *createStaticUringTcpPlugin();
+        registerStaticPlugin("URING_TCP", createStaticUringTcpPlugin);
+#endif // STATIC_PLUGIN_URING_TCP
 }
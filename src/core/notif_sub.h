@@ -0,0 +1,42 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __NOTIF_SUB_H_
+#define __NOTIF_SUB_H_
+
+#include <mutex>
+
+#include "nixl_types.h"
+#include "backend/backend_aux.h"
+
+// Subscription to notifications starting with a prefix. The queue is filled by the thread
+// that receives a matching notification, a backend handler or a drain of the backends, and
+// is swapped out by the subscriber, so subscribers only contend with the producers.
+class nixlNotifSubH {
+    private:
+        const nixl_blob_t prefix;
+
+        std::mutex        lock;
+        notif_list_t      queue;
+
+    public:
+        inline nixlNotifSubH(const nixl_blob_t &prefix) : prefix(prefix) { }
+
+    friend class nixlAgent;
+    friend class nixlAgentData;
+};
+
+#endif
@@ -0,0 +1,64 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __REG_REQUEST_H_
+#define __REG_REQUEST_H_
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include "mem_section.h"
+
+// Asynchronous registration or deregistration of a descriptor list. The list is split
+// into tasks per backend, run by the agent registration threads, and regions are added
+// to (or were removed from) the agent sections one by one as the backend calls complete.
+class nixlRegReqH {
+    private:
+        struct backendReg {
+            nixlBackendEngine* engine;
+            std::mutex*        engineLock;  // Serializes backends without parallel registration
+            size_t             pendingTasks = 0;
+            nixl_status_t      status       = NIXL_SUCCESS;
+
+            // Regions registered so far, to be rolled back if a later one fails,
+            // or regions detached from the local section to be deregistered
+            nixl_sec_dlist_t   localDescs;
+            nixl_sec_dlist_t   selfDescs;
+
+            backendReg(nixlBackendEngine* engine, std::mutex* engine_lock, nixl_mem_t mem)
+                : engine(engine), engineLock(engine_lock),
+                  localDescs(mem, false), selfDescs(mem, false) { }
+        };
+
+        nixl_reg_dlist_t        descs;
+        bool                    dereg;
+        std::vector<backendReg> backends;
+
+        std::mutex              lock;
+        std::condition_variable cv;
+        size_t                  pendingTasks = 0;
+        nixl_status_t           status       = NIXL_IN_PROG;
+
+    public:
+        inline nixlRegReqH(const nixl_reg_dlist_t &descs, bool dereg)
+            : descs(descs), dereg(dereg) { }
+
+    friend class nixlAgent;
+    friend class nixlAgentData;
+};
+
+#endif
@@ -0,0 +1,424 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "shared_backend.h"
+#include "plugin_manager.h"
+#include "serdes/serdes.h"
+#include "common/nixl_log.h"
+
+#include <utility>
+
+namespace {
+
+std::mutex registryLock;
+std::map<std::pair<nixl_backend_t, std::string>, std::weak_ptr<nixlSharedBackend>> registry;
+
+} // namespace
+
+nixl_blob_t
+sharedNotifMsg(const std::string &src, const std::string &dst, const nixl_blob_t &msg) {
+    nixlSerDes sd;
+
+    sd.addStr("src", src);
+    sd.addStr("dst", dst);
+    sd.addStr("msg", msg);
+    return shared_prefix + sd.exportStr();
+}
+
+bool
+sharedNotifParse(const nixl_blob_t &str, std::string &src, std::string &dst, nixl_blob_t &msg) {
+    nixlSerDes sd;
+
+    if (str.compare(0, shared_prefix.size(), shared_prefix) != 0 ||
+        sd.importStr(str.substr(shared_prefix.size())) != NIXL_SUCCESS)
+        return false;
+
+    src = sd.getStr("src");
+    dst = sd.getStr("dst");
+    msg = sd.getStr("msg");
+    return !src.empty() && !dst.empty();
+}
+
+/*** nixlSharedBackend implementation ***/
+nixlSharedBackend::nixlSharedBackend(const std::string &name, const nixl_b_params_t &params,
+                                     const nixlBackendInitParams &init_params,
+                                     std::shared_ptr<const nixlPluginHandle> plugin,
+                                     nixlBackendEngine* engine)
+    : type(init_params.type), name(name), owner(init_params.localAgent), params(params),
+      progTh(init_params.enableProgTh), pthrDelay(init_params.pthrDelay),
+      syncMode(init_params.syncMode), plugin(std::move(plugin)), engine(engine) {
+    // Notifications for agents with a handler are passed to it from the engine
+    handlerSet = engine->setNotifHandler(
+                         [this](const std::string &remote_agent, nixl_blob_t &msg) {
+                             return dispatchNotif(remote_agent, msg);
+                         }) == NIXL_SUCCESS;
+}
+
+nixlSharedBackend::~nixlSharedBackend() {
+    plugin->destroyEngine(engine);
+    NIXL_DEBUG << "Destroyed shared " << type << " backend instance " << name;
+}
+
+nixl_status_t
+nixlSharedBackend::attach(const nixlBackendInitParams* init_params,
+                          std::shared_ptr<nixlSharedBackend> &instance) {
+    nixl_b_params_t params = *init_params->customParams;
+    const std::string name = params[shared_instance_param];
+    params.erase(shared_instance_param);
+
+    std::lock_guard<std::mutex> registry_lock(registryLock);
+    instance = registry[{init_params->type, name}].lock();
+    if (instance) {
+        if (instance->params != params) {
+            NIXL_ERROR << "Parameters of shared " << init_params->type << " backend instance "
+                       << name << " differ from the ones it was created with";
+            return NIXL_ERR_INVALID_PARAM;
+        }
+        if (init_params->syncMode != instance->syncMode ||
+            init_params->enableProgTh != instance->progTh ||
+            (init_params->enableProgTh && init_params->pthrDelay != instance->pthrDelay)) {
+            NIXL_ERROR << "Thread settings of agent " << init_params->localAgent
+                       << " differ from the ones shared " << init_params->type
+                       << " backend instance " << name << " was created with";
+            return NIXL_ERR_INVALID_PARAM;
+        }
+        return NIXL_SUCCESS;
+    }
+
+    auto plugin = nixlPluginManager::getInstance().loadPlugin(init_params->type);
+    if (!plugin) {
+        NIXL_ERROR << "Unsupported backend: " << init_params->type;
+        return NIXL_ERR_NOT_FOUND;
+    }
+
+    // The first agent attached is the local agent of the engine. Agents call the engine
+    // concurrently, whatever their own thread sync mode.
+    nixlBackendInitParams engine_params = *init_params;
+    engine_params.customParams = &params;
+    engine_params.syncMode     = nixl_thread_sync_t::NIXL_THREAD_SYNC_RW;
+    nixlBackendEngine* engine = plugin->createEngine(&engine_params);
+    if (!engine)
+        return NIXL_ERR_BACKEND;
+    if (engine->getInitErr()) {
+        plugin->destroyEngine(engine);
+        return NIXL_ERR_BACKEND;
+    }
+
+    instance = std::make_shared<nixlSharedBackend>(name, params, *init_params, plugin, engine);
+    registry[{init_params->type, name}] = instance;
+    NIXL_DEBUG << "Created shared " << init_params->type << " backend instance " << name;
+    return NIXL_SUCCESS;
+}
+
+bool
+nixlSharedBackend::dispatchNotif(const std::string &remote_agent, nixl_blob_t &msg) {
+    std::string src, dst;
+    nixl_blob_t inner;
+
+    if (!sharedNotifParse(msg, src, dst, inner))
+        return false;
+
+    std::shared_lock<std::shared_mutex> handler_lock(handlerLock);
+    auto handler = handlers.find(dst);
+    return handler != handlers.end() && handler->second(remote_agent, msg);
+}
+
+void
+nixlSharedBackend::demuxNotifs(notif_list_t &notif_list) {
+    std::string src, dst;
+    nixl_blob_t inner;
+
+    for (auto &elm : notif_list) {
+        auto queue = notifs.end();
+        if (sharedNotifParse(elm.second, src, dst, inner))
+            queue = notifs.find(dst);
+
+        // Without a known destination, the notification goes to the local agent of the engine
+        // if still attached, otherwise to any agent
+        if (queue == notifs.end()) {
+            NIXL_DEBUG << "Notification from " << elm.first << " without an attached destination";
+            queue = notifs.find(owner);
+            if (queue == notifs.end())
+                queue = notifs.begin();
+        }
+        queue->second.push_back(std::move(elm));
+    }
+}
+
+/*** nixlSharedEngine implementation ***/
+nixlSharedEngine::nixlSharedEngine(const nixlBackendInitParams* init_params,
+                                   std::shared_ptr<nixlSharedBackend> instance)
+    : nixlBackendEngine(init_params), instance(std::move(instance)),
+      engine(this->instance->engine) {
+    std::unique_lock<std::shared_mutex> lock(this->instance->lock);
+    this->instance->notifs[localAgent];
+}
+
+nixlSharedEngine::~nixlSharedEngine() {
+    {
+        std::unique_lock<std::shared_mutex> lock(instance->lock);
+        for (auto &reg : regs)
+            engine->deregisterMem(reg.first);
+        regs.clear();
+    }
+
+    {
+        std::unique_lock<std::shared_mutex> handler_lock(instance->handlerLock);
+        instance->handlers.erase(localAgent);
+    }
+
+    std::vector<std::string> peers;
+    {
+        std::unique_lock<std::shared_mutex> lock(instance->lock);
+        for (auto &conn : instance->conns)
+            peers.insert(peers.end(), conn.second.count(localAgent), conn.first);
+
+        // Notifications not received yet are dropped with the agent
+        instance->notifs.erase(localAgent);
+    }
+
+    for (auto &peer : peers)
+        releaseConn(peer);
+}
+
+const std::string &
+nixlSharedEngine::peerName(const std::string &remote_agent) const {
+    return remote_agent == localAgent ? instance->owner : remote_agent;
+}
+
+nixl_status_t
+nixlSharedEngine::releaseConn(const std::string &peer) {
+    std::unique_lock<std::shared_mutex> lock(instance->lock);
+    auto conn = instance->conns.find(peer);
+    if (conn == instance->conns.end())
+        return NIXL_ERR_NOT_FOUND;
+
+    auto user = conn->second.find(localAgent);
+    if (user == conn->second.end())
+        return NIXL_ERR_NOT_FOUND;
+    conn->second.erase(user);
+
+    // The connection is kept while another agent uses it
+    if (!conn->second.empty())
+        return NIXL_SUCCESS;
+
+    instance->conns.erase(conn);
+    return engine->disconnect(peer);
+}
+
+nixl_status_t
+nixlSharedEngine::registerMem(const nixlBlobDesc &mem, const nixl_mem_t &nixl_mem,
+                              nixlBackendMD* &out) {
+    nixl_status_t ret;
+
+    if (engine->supportsParallelReg(nixl_mem)) {
+        std::shared_lock<std::shared_mutex> lock(instance->lock);
+        ret = engine->registerMem(mem, nixl_mem, out);
+    } else {
+        std::unique_lock<std::shared_mutex> lock(instance->lock);
+        ret = engine->registerMem(mem, nixl_mem, out);
+    }
+
+    if (ret == NIXL_SUCCESS) {
+        std::lock_guard<std::mutex> reg_lock(regLock);
+        regs[out] = nixl_mem;
+    }
+    return ret;
+}
+
+nixl_status_t
+nixlSharedEngine::deregisterMem(nixlBackendMD* meta) {
+    nixl_mem_t nixl_mem;
+    {
+        std::lock_guard<std::mutex> reg_lock(regLock);
+        auto reg = regs.find(meta);
+        if (reg == regs.end())
+            return NIXL_ERR_NOT_FOUND;
+        nixl_mem = reg->second;
+        regs.erase(reg);
+    }
+
+    if (engine->supportsParallelReg(nixl_mem)) {
+        std::shared_lock<std::shared_mutex> lock(instance->lock);
+        return engine->deregisterMem(meta);
+    }
+    std::unique_lock<std::shared_mutex> lock(instance->lock);
+    return engine->deregisterMem(meta);
+}
+
+nixl_status_t
+nixlSharedEngine::connect(const std::string &remote_agent) {
+    const std::string &peer = peerName(remote_agent);
+    std::unique_lock<std::shared_mutex> lock(instance->lock);
+
+    // Connection of the engine to itself is made once, for all the agents
+    if (peer == instance->owner) {
+        auto &users = instance->conns[peer];
+        if (users.empty()) {
+            nixl_status_t ret = engine->connect(peer);
+            if (ret != NIXL_SUCCESS) {
+                instance->conns.erase(peer);
+                return ret;
+            }
+        }
+        users.insert(localAgent);
+        return NIXL_SUCCESS;
+    }
+
+    return engine->connect(peer);
+}
+
+nixl_status_t
+nixlSharedEngine::disconnect(const std::string &remote_agent) {
+    return releaseConn(peerName(remote_agent));
+}
+
+nixl_status_t
+nixlSharedEngine::unloadMD(nixlBackendMD* input) {
+    std::unique_lock<std::shared_mutex> lock(instance->lock);
+    return engine->unloadMD(input);
+}
+
+nixl_status_t
+nixlSharedEngine::prepXfer(const nixl_xfer_op_t &operation, const nixl_meta_dlist_t &local,
+                           const nixl_meta_dlist_t &remote, const std::string &remote_agent,
+                           nixlBackendReqH* &handle, const nixl_opt_b_args_t* opt_args) const {
+    std::shared_lock<std::shared_mutex> lock(instance->lock);
+    return engine->prepXfer(operation, local, remote, peerName(remote_agent), handle, opt_args);
+}
+
+nixl_status_t
+nixlSharedEngine::estimateXferCost(const nixl_xfer_op_t &operation,
+                                   const nixl_meta_dlist_t &local,
+                                   const nixl_meta_dlist_t &remote,
+                                   const std::string &remote_agent,
+                                   nixlBackendReqH* const &handle,
+                                   std::chrono::microseconds &duration,
+                                   std::chrono::microseconds &err_margin,
+                                   nixl_cost_t &method,
+                                   const nixl_opt_args_t* extra_params) const {
+    std::shared_lock<std::shared_mutex> lock(instance->lock);
+    return engine->estimateXferCost(operation, local, remote, peerName(remote_agent), handle,
+                                    duration, err_margin, method, extra_params);
+}
+
+nixl_status_t
+nixlSharedEngine::postXfer(const nixl_xfer_op_t &operation, const nixl_meta_dlist_t &local,
+                           const nixl_meta_dlist_t &remote, const std::string &remote_agent,
+                           nixlBackendReqH* &handle, const nixl_opt_b_args_t* opt_args) const {
+    std::shared_lock<std::shared_mutex> lock(instance->lock);
+    return engine->postXfer(operation, local, remote, peerName(remote_agent), handle, opt_args);
+}
+
+nixl_status_t
+nixlSharedEngine::checkXfer(nixlBackendReqH* handle) const {
+    std::shared_lock<std::shared_mutex> lock(instance->lock);
+    return engine->checkXfer(handle);
+}
+
+nixl_status_t
+nixlSharedEngine::checkXfers(const std::vector<nixlBackendReqH*> &handles,
+                             std::vector<nixl_status_t> &status) const {
+    std::shared_lock<std::shared_mutex> lock(instance->lock);
+    return engine->checkXfers(handles, status);
+}
+
+nixl_status_t
+nixlSharedEngine::releaseReqH(nixlBackendReqH* handle) const {
+    std::shared_lock<std::shared_mutex> lock(instance->lock);
+    return engine->releaseReqH(handle);
+}
+
+nixl_status_t
+nixlSharedEngine::getPublicData(const nixlBackendMD* meta, std::string &str) const {
+    std::shared_lock<std::shared_mutex> lock(instance->lock);
+    return engine->getPublicData(meta, str);
+}
+
+nixl_status_t
+nixlSharedEngine::getConnInfo(std::string &str) const {
+    nixl_status_t ret = engine->getConnInfo(str);
+    if (ret == NIXL_SUCCESS)
+        str = shared_prefix + str;
+    return ret;
+}
+
+nixl_status_t
+nixlSharedEngine::loadRemoteConnInfo(const std::string &remote_agent,
+                                     const std::string &remote_conn_info) {
+    std::unique_lock<std::shared_mutex> lock(instance->lock);
+    auto &users = instance->conns[remote_agent];
+    users.insert(localAgent);
+
+    // Loaded already by another agent, or the engine itself when it's the local agent
+    if (users.size() > 1)
+        return NIXL_SUCCESS;
+
+    nixl_status_t ret = engine->loadRemoteConnInfo(remote_agent, remote_conn_info);
+    if (ret != NIXL_SUCCESS)
+        instance->conns.erase(remote_agent);
+    return ret;
+}
+
+nixl_status_t
+nixlSharedEngine::loadRemoteMD(const nixlBlobDesc &input, const nixl_mem_t &nixl_mem,
+                               const std::string &remote_agent, nixlBackendMD* &output) {
+    std::unique_lock<std::shared_mutex> lock(instance->lock);
+    return engine->loadRemoteMD(input, nixl_mem, peerName(remote_agent), output);
+}
+
+nixl_status_t
+nixlSharedEngine::loadLocalMD(nixlBackendMD* input, nixlBackendMD* &output) {
+    std::unique_lock<std::shared_mutex> lock(instance->lock);
+    return engine->loadLocalMD(input, output);
+}
+
+nixl_status_t
+nixlSharedEngine::getNotifs(notif_list_t &notif_list) {
+    notif_list_t received;
+
+    if (!notif_list.empty())
+        return NIXL_ERR_INVALID_PARAM;
+
+    std::unique_lock<std::shared_mutex> lock(instance->lock);
+    nixl_status_t ret = engine->getNotifs(received);
+    instance->demuxNotifs(received);
+    notif_list.swap(instance->notifs[localAgent]);
+    return ret;
+}
+
+nixl_status_t
+nixlSharedEngine::genNotif(const std::string &remote_agent, const std::string &msg) const {
+    std::shared_lock<std::shared_mutex> lock(instance->lock);
+    return engine->genNotif(peerName(remote_agent), msg);
+}
+
+nixl_status_t
+nixlSharedEngine::setNotifHandler(nixl_notif_handler_t handler) {
+    if (!instance->handlerSet)
+        return NIXL_ERR_NOT_SUPPORTED;
+
+    std::unique_lock<std::shared_mutex> handler_lock(instance->handlerLock);
+    instance->handlers[localAgent] = std::move(handler);
+    return NIXL_SUCCESS;
+}
+
+int
+nixlSharedEngine::progress() {
+    std::shared_lock<std::shared_mutex> lock(instance->lock);
+    return engine->progress();
+}
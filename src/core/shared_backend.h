@@ -0,0 +1,171 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __SHARED_BACKEND_H_
+#define __SHARED_BACKEND_H_
+
+#include <map>
+#include <memory>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+#include "backend/backend_engine.h"
+
+class nixlPluginHandle;
+
+// Backend parameter to attach to a backend instance shared by the agents of the process
+const std::string shared_instance_param = "shared_instance";
+
+// Notifications sent by or to agents of a shared instance carry their source and destination
+// agents, and connection info of such agents is marked, so that the peers can add them.
+const std::string shared_prefix = "NIXL_SHARED|";
+
+nixl_blob_t sharedNotifMsg(const std::string &src, const std::string &dst, const nixl_blob_t &msg);
+
+// Returns false if msg is not a shared instance notification, fields are only set otherwise
+bool sharedNotifParse(const nixl_blob_t &str, std::string &src, std::string &dst, nixl_blob_t &msg);
+
+// A backend engine shared by several agents, created by the first agent attaching to it and
+// destroyed when the last one detaches. Connections are counted per agent, and received
+// notifications are queued per destination agent until its engine gets them. The engine is
+// always created thread safe, as the agents call it from their own threads, and agents
+// attach only with the thread settings the instance was created with.
+class nixlSharedBackend {
+    private:
+        const nixl_backend_t                      type;
+        const std::string                         name;
+        const std::string                         owner;  // Local agent of the engine
+        const nixl_b_params_t                     params;
+        // Thread settings of the agents, the engine itself is always thread safe
+        const bool                                progTh;
+        const nixlTime::us_t                      pthrDelay;
+        const nixl_thread_sync_t                  syncMode;
+        std::shared_ptr<const nixlPluginHandle>   plugin;
+        nixlBackendEngine*                        engine;
+
+        // Serializes control operations, transfers and notifications take it shared
+        std::shared_mutex                         lock;
+        // Agents using each connection, an agent connected to itself is also a user of
+        // the connection to the local agent of the engine
+        std::map<std::string, std::multiset<std::string>> conns;
+        std::map<std::string, notif_list_t>       notifs;
+
+        bool                                      handlerSet = false;
+        std::shared_mutex                         handlerLock;
+        std::map<std::string, nixl_notif_handler_t> handlers;
+
+        bool dispatchNotif(const std::string &remote_agent, nixl_blob_t &msg);
+        void demuxNotifs(notif_list_t &notif_list);
+
+    public:
+        nixlSharedBackend(const std::string &name, const nixl_b_params_t &params,
+                          const nixlBackendInitParams &init_params,
+                          std::shared_ptr<const nixlPluginHandle> plugin,
+                          nixlBackendEngine* engine);
+        ~nixlSharedBackend();
+
+        // Finds or creates the instance named in the parameters of init_params
+        static nixl_status_t attach(const nixlBackendInitParams* init_params,
+                                    std::shared_ptr<nixlSharedBackend> &instance);
+
+    friend class nixlSharedEngine;
+};
+
+// Engine of an agent attached to a shared instance, calls are forwarded to the instance
+// engine, which knows the first agent attached as its local agent.
+class nixlSharedEngine : public nixlBackendEngine {
+    private:
+        std::shared_ptr<nixlSharedBackend> instance;
+        nixlBackendEngine*                 engine;
+
+        // Registrations of this agent, deregistered if left when detaching
+        std::mutex                                    regLock;
+        std::unordered_map<nixlBackendMD*, nixl_mem_t> regs;
+
+        // The agent itself is known to the instance engine by the name of its local agent
+        const std::string &peerName(const std::string &remote_agent) const;
+        nixl_status_t releaseConn(const std::string &remote_agent);
+
+    public:
+        nixlSharedEngine(const nixlBackendInitParams* init_params,
+                         std::shared_ptr<nixlSharedBackend> instance);
+        ~nixlSharedEngine();
+
+        bool supportsRemote() const override { return engine->supportsRemote(); }
+        bool supportsLocal() const override { return engine->supportsLocal(); }
+        bool supportsNotif() const override { return engine->supportsNotif(); }
+        bool supportsProgTh() const override { return engine->supportsProgTh(); }
+        bool supportsConversion() const override { return engine->supportsConversion(); }
+        bool supportsParallelReg(const nixl_mem_t &nixl_mem) const override {
+            return engine->supportsParallelReg(nixl_mem);
+        }
+        size_t getRegLen(const nixlBackendMD* meta) const override {
+            return engine->getRegLen(meta);
+        }
+
+        nixl_mem_list_t getSupportedMems() const override { return engine->getSupportedMems(); }
+
+        nixl_status_t registerMem(const nixlBlobDesc &mem, const nixl_mem_t &nixl_mem,
+                                  nixlBackendMD* &out) override;
+        nixl_status_t deregisterMem(nixlBackendMD* meta) override;
+
+        nixl_status_t connect(const std::string &remote_agent) override;
+        nixl_status_t disconnect(const std::string &remote_agent) override;
+
+        nixl_status_t unloadMD(nixlBackendMD* input) override;
+
+        nixl_status_t prepXfer(const nixl_xfer_op_t &operation, const nixl_meta_dlist_t &local,
+                               const nixl_meta_dlist_t &remote, const std::string &remote_agent,
+                               nixlBackendReqH* &handle,
+                               const nixl_opt_b_args_t* opt_args = nullptr) const override;
+        nixl_status_t estimateXferCost(const nixl_xfer_op_t &operation,
+                                       const nixl_meta_dlist_t &local,
+                                       const nixl_meta_dlist_t &remote,
+                                       const std::string &remote_agent,
+                                       nixlBackendReqH* const &handle,
+                                       std::chrono::microseconds &duration,
+                                       std::chrono::microseconds &err_margin,
+                                       nixl_cost_t &method,
+                                       const nixl_opt_args_t* extra_params = nullptr) const override;
+        nixl_status_t postXfer(const nixl_xfer_op_t &operation, const nixl_meta_dlist_t &local,
+                               const nixl_meta_dlist_t &remote, const std::string &remote_agent,
+                               nixlBackendReqH* &handle,
+                               const nixl_opt_b_args_t* opt_args = nullptr) const override;
+        nixl_status_t checkXfer(nixlBackendReqH* handle) const override;
+        nixl_status_t checkXfers(const std::vector<nixlBackendReqH*> &handles,
+                                 std::vector<nixl_status_t> &status) const override;
+        nixl_status_t releaseReqH(nixlBackendReqH* handle) const override;
+
+        nixl_status_t getPublicData(const nixlBackendMD* meta, std::string &str) const override;
+        nixl_status_t getConnInfo(std::string &str) const override;
+        nixl_status_t loadRemoteConnInfo(const std::string &remote_agent,
+                                         const std::string &remote_conn_info) override;
+        nixl_status_t loadRemoteMD(const nixlBlobDesc &input, const nixl_mem_t &nixl_mem,
+                                   const std::string &remote_agent,
+                                   nixlBackendMD* &output) override;
+        nixl_status_t loadLocalMD(nixlBackendMD* input, nixlBackendMD* &output) override;
+
+        nixl_status_t getNotifs(notif_list_t &notif_list) override;
+        nixl_status_t genNotif(const std::string &remote_agent,
+                               const std::string &msg) const override;
+        nixl_status_t setNotifHandler(nixl_notif_handler_t handler) override;
+
+        int progress() override;
+};
+
+#endif
@@ -0,0 +1,53 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __TRANSFER_GRAPH_H_
+#define __TRANSFER_GRAPH_H_
+
+#include <atomic>
+#include <unordered_map>
+#include <vector>
+
+// A set of prepared transfer requests with dependencies between them. Each request is
+// posted as soon as all of its predecessors have completed, requests without
+// predecessors are posted when the graph is posted.
+class nixlXferGraphH {
+    private:
+        struct node {
+            nixlXferReqH*       req;
+            std::vector<size_t> successors;
+            size_t              numDeps      = 0;
+            size_t              pendingDeps  = 0;
+        };
+
+        std::vector<node>                         nodes;
+        std::unordered_map<nixlXferReqH*, size_t> nodeIndex;
+
+        // Nodes whose requests are in flight, and count of nodes not yet completed
+        std::vector<size_t> running;
+        size_t              remaining = 0;
+
+        // Read without locks when graph is progressed by the graph thread
+        std::atomic<nixl_status_t> status{NIXL_ERR_NOT_POSTED};
+
+    public:
+        inline nixlXferGraphH() { }
+
+    friend class nixlAgent;
+    friend class nixlAgentData;
+};
+
+#endif
@@ -17,6 +17,11 @@
 #ifndef __TRANSFER_REQUEST_H_
 #define __TRANSFER_REQUEST_H_
 
+#include "compl_queue.h"
+
+#include <chrono>
+#include <memory>
+
 // Contains pointers to corresponding backend engine and its handler, and populated
 // and verified DescLists, and other state and metadata needed for a NIXL transfer
 class nixlXferReqH {
@@ -30,14 +35,19 @@ class nixlXferReqH {
         std::string        remoteAgent;
         nixl_blob_t        notifMsg;
         bool               hasNotif       = false;
+        bool               sharedNotif    = false;  // Notification carries the agents
 
         nixl_xfer_op_t     backendOp;
         nixl_status_t      status;
 
+        nixlComplQueueH*   complQueue     = nullptr;
+
     public:
         inline nixlXferReqH() { }
 
         inline ~nixlXferReqH() {
+            if (complQueue != nullptr)
+                complQueue->unbind(this, backendHandle);
             // delete checks for nullptr itself
             delete initiatorDescs;
             delete targetDescs;
@@ -46,6 +56,64 @@ class nixlXferReqH {
         }
 
     friend class nixlAgent;
+    friend class nixlAgentData;
+};
+
+// Transfer whose remote descriptors span several agents, made of one request per agent
+// and tracked with a single status. Requests on the same backend are checked in a batch.
+class nixlMultiXferReqH {
+    private:
+        std::vector<nixlXferReqH*> reqs;
+        nixl_status_t              status = NIXL_ERR_NOT_POSTED;
+
+    public:
+        inline nixlMultiXferReqH() { }
+
+    friend class nixlAgent;
+};
+
+// Transfer with several replicas of its remote side, made of one request per source or
+// target. Reads are posted one source at a time until one completes, writes are posted to
+// all the targets at once. Reads that lost can't be aborted by every backend, so reads
+// into DRAM from several sources are staged in a registered buffer per source, and only
+// the one that won is copied out. The others finish into their buffers, and are skipped
+// by the posts until then, or are left to the agent to release when the request is. Other reads complete once all the posted ones are done.
+class nixlReplicaXferReqH {
+    private:
+        struct replica {
+            std::string                           agent;
+            nixl_xfer_dlist_t                     descs;
+            nixlXferReqH*                         req    = nullptr;
+            nixl_status_t                         status = NIXL_ERR_NOT_POSTED;
+            std::chrono::steady_clock::time_point postTime;
+            std::unique_ptr<char[]>               staging;
+            bool                                  lost   = false;
+        };
+
+        nixl_xfer_op_t                        operation;
+        nixl_xfer_dlist_t                     localDescs;
+        nixl_opt_args_t                       createArgs;
+        std::vector<replica>                  replicas;
+        size_t                                quorum     = 0;
+        size_t                                stagingLen = 0;
+
+        // Read state, from the last post
+        size_t                                nextRead = 0;
+        size_t                                source   = 0;
+        bool                                  won      = false;
+        std::chrono::microseconds             hedgeDelay{0};
+        std::chrono::steady_clock::time_point hedgeAt;
+
+        nixl_status_t                         lastError = NIXL_SUCCESS;
+        nixl_status_t                         status    = NIXL_ERR_NOT_POSTED;
+
+    public:
+        inline nixlReplicaXferReqH(const nixl_xfer_op_t &op,
+                                   const nixl_xfer_dlist_t &local_descs)
+            : operation(op), localDescs(local_descs) { }
+
+    friend class nixlAgent;
+    friend class nixlAgentData;
 };
 
 class nixlDlistH {
@@ -0,0 +1,280 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dtype_convert.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Elements converted at once, through an FP32 buffer that stays in L1
+constexpr size_t block_elems = 256;
+
+inline uint32_t floatBits(float f) {
+    uint32_t u;
+    std::memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+inline float bitsFloat(uint32_t u) {
+    float f;
+    std::memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+constexpr float pow2(int exp) {
+    float value = 1.0f;
+    for (; exp > 0; exp--)
+        value *= 2.0f;
+    for (; exp < 0; exp++)
+        value /= 2.0f;
+    return value;
+}
+
+// Binary floating point format with E exponent and M mantissa bits. Finite only formats
+// (E4M3) use the top exponent for normal values, except for NaN with all mantissa bits set.
+template <int E, int M, bool FINITE>
+struct fpFormat {
+    static constexpr int      bias      = (1 << (E - 1)) - 1;
+    static constexpr uint32_t exp_mask  = (1u << E) - 1;
+    static constexpr uint32_t mant_mask = (1u << M) - 1;
+    static constexpr uint32_t max_code  = FINITE ? (exp_mask << M) | (mant_mask - 1)
+                                                 : ((exp_mask - 1) << M) | mant_mask;
+    static constexpr uint32_t nan_code  = (exp_mask << M) | mant_mask;
+
+    static constexpr float max_value  = FINITE
+        ? (1.0f + float(mant_mask - 1) / (1u << M)) * pow2(int(exp_mask) - bias)
+        : (1.0f + float(mant_mask) / (1u << M)) * pow2(int(exp_mask) - 1 - bias);
+    static constexpr float min_normal = pow2(1 - bias);
+    // Subnormals are multiples of 2^(1 - bias - M)
+    static constexpr float sub_scale  = pow2(bias - 1 + M);
+
+    static float decode(uint32_t code) {
+        const uint32_t exp  = (code >> M) & exp_mask;
+        const uint32_t mant = code & mant_mask;
+        float value;
+        if (exp == exp_mask && (!FINITE || mant == mant_mask))
+            value = (mant != 0) ? NAN : INFINITY;
+        else if (exp == 0)
+            value = std::ldexp(float(mant), 1 - bias - M);
+        else
+            value = std::ldexp(float(mant | (1u << M)), int(exp) - bias - M);
+        return (code >> (E + M)) ? -value : value;
+    }
+
+    // Branch free, so that loops over it vectorize
+    static uint32_t encode(float f) {
+        const uint32_t u   = floatBits(f);
+        const uint32_t abs = u & 0x7FFFFFFFu;
+        const float    a   = bitsFloat(abs);
+
+        // Normal range, the mantissa is rounded to M bits to nearest even
+        constexpr int shift = 23 - M;
+        uint32_t normal = (abs + (1u << (shift - 1)) - 1 + ((abs >> shift) & 1)) >> shift;
+        normal -= uint32_t(127 - bias) << M;
+
+        // Subnormal range, rounded to a multiple of the smallest subnormal by the addition
+        const float units = ((a < min_normal) ? a : min_normal) * sub_scale;
+        const uint32_t sub = uint32_t((units + 8388608.0f) - 8388608.0f);
+
+        uint32_t code = (a < min_normal) ? sub : normal;
+        code = (a >= max_value) ? max_code : code;
+        code = (abs > 0x7F800000u) ? nan_code : code;
+        return ((u >> 31) << (E + M)) | code;
+    }
+};
+
+using fp16Format    = fpFormat<5, 10, false>;
+using fp8E4M3Format = fpFormat<4, 3, true>;
+using fp8E5M2Format = fpFormat<5, 2, false>;
+
+inline float decodeBf16(uint16_t h) {
+    return bitsFloat(uint32_t(h) << 16);
+}
+
+inline uint16_t encodeBf16(float f) {
+    const uint32_t u   = floatBits(f);
+    const uint32_t abs = u & 0x7FFFFFFFu;
+    uint32_t code = (abs + 0x7FFFu + ((abs >> 16) & 1)) >> 16;
+    code = (code > 0x7F7Fu) ? 0x7F7Fu : code;
+    code = (abs > 0x7F800000u) ? 0x7FC0u : code;
+    return uint16_t(((u >> 16) & 0x8000u) | code);
+}
+
+// The FP16 bits shifted into an FP32 are off by the exponent bias difference, which the
+// multiplication fixes for normal and subnormal values alike
+inline float decodeFp16(uint16_t h) {
+    const uint32_t mag   = uint32_t(h & 0x7FFFu) << 13;
+    const float    value = (mag >= (0x7C00u << 13)) ? bitsFloat(mag | 0x7F800000u)
+                                                    : bitsFloat(mag) * pow2(112);
+    return (h & 0x8000u) ? -value : value;
+}
+
+#if defined(__x86_64__)
+const bool has_f16c = __builtin_cpu_supports("f16c") && __builtin_cpu_supports("avx");
+
+__attribute__((target("avx,f16c")))
+void decodeFp16F16c(const uint16_t *src, float *dst, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m128i half = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(half));
+    }
+    for (; i < n; i++)
+        dst[i] = decodeFp16(src[i]);
+}
+#endif
+
+template <typename FORMAT>
+const std::array<float, 256> &fp8Table() {
+    static const std::array<float, 256> table = []() {
+        std::array<float, 256> values;
+        for (uint32_t code = 0; code < 256; code++)
+            values[code] = FORMAT::decode(code);
+        return values;
+    }();
+    return table;
+}
+
+void decode(nixl_dtype_t type, const void *src, float *dst, size_t n) {
+    switch (type) {
+        case NIXL_DTYPE_BF16: {
+            const uint16_t *in = static_cast<const uint16_t*>(src);
+            for (size_t i = 0; i < n; i++)
+                dst[i] = decodeBf16(in[i]);
+            break;
+        }
+        case NIXL_DTYPE_FP16: {
+            const uint16_t *in = static_cast<const uint16_t*>(src);
+#if defined(__x86_64__)
+            if (has_f16c) {
+                decodeFp16F16c(in, dst, n);
+                break;
+            }
+#endif
+            for (size_t i = 0; i < n; i++)
+                dst[i] = decodeFp16(in[i]);
+            break;
+        }
+        case NIXL_DTYPE_FP8_E4M3:
+        case NIXL_DTYPE_FP8_E5M2: {
+            const auto &table = (type == NIXL_DTYPE_FP8_E4M3) ? fp8Table<fp8E4M3Format>()
+                                                              : fp8Table<fp8E5M2Format>();
+            const uint8_t *in = static_cast<const uint8_t*>(src);
+            for (size_t i = 0; i < n; i++)
+                dst[i] = table[in[i]];
+            break;
+        }
+    }
+}
+
+void encode(nixl_dtype_t type, const float *src, void *dst, size_t n) {
+    switch (type) {
+        case NIXL_DTYPE_BF16: {
+            uint16_t *out = static_cast<uint16_t*>(dst);
+            for (size_t i = 0; i < n; i++)
+                out[i] = encodeBf16(src[i]);
+            break;
+        }
+        case NIXL_DTYPE_FP16: {
+            uint16_t *out = static_cast<uint16_t*>(dst);
+            for (size_t i = 0; i < n; i++)
+                out[i] = uint16_t(fp16Format::encode(src[i]));
+            break;
+        }
+        case NIXL_DTYPE_FP8_E4M3: {
+            uint8_t *out = static_cast<uint8_t*>(dst);
+            for (size_t i = 0; i < n; i++)
+                out[i] = uint8_t(fp8E4M3Format::encode(src[i]));
+            break;
+        }
+        case NIXL_DTYPE_FP8_E5M2: {
+            uint8_t *out = static_cast<uint8_t*>(dst);
+            for (size_t i = 0; i < n; i++)
+                out[i] = uint8_t(fp8E5M2Format::encode(src[i]));
+            break;
+        }
+    }
+}
+
+void convert(nixl_dtype_t src_type, nixl_dtype_t dst_type, float factor,
+             const void *src, void *dst, size_t count) {
+    const size_t src_size = nixlDtype::elemSize(src_type);
+    const size_t dst_size = nixlDtype::elemSize(dst_type);
+    float buffer[block_elems];
+
+    for (size_t done = 0; done < count; done += block_elems) {
+        const size_t n = std::min(block_elems, count - done);
+        decode(src_type, static_cast<const char*>(src) + done * src_size, buffer, n);
+        if (factor != 1.0f) {
+            for (size_t i = 0; i < n; i++)
+                buffer[i] *= factor;
+        }
+        encode(dst_type, buffer, static_cast<char*>(dst) + done * dst_size, n);
+    }
+}
+
+float scaleOf(const nixl_xfer_conv_t &conv) {
+    return (conv.scaleMode == NIXL_SCALE_FIXED) ? conv.scale : 1.0f;
+}
+
+}
+
+namespace nixlDtype {
+
+size_t elemSize(nixl_dtype_t type) {
+    switch (type) {
+        case NIXL_DTYPE_BF16:
+        case NIXL_DTYPE_FP16:
+            return 2;
+        case NIXL_DTYPE_FP8_E4M3:
+        case NIXL_DTYPE_FP8_E5M2:
+            return 1;
+    }
+    return 0;
+}
+
+bool isValid(const nixl_xfer_conv_t &conv) {
+    // Only the 16-bit types are converted to and from FP8
+    if ((conv.localType != NIXL_DTYPE_BF16 && conv.localType != NIXL_DTYPE_FP16) ||
+        (conv.remoteType != NIXL_DTYPE_FP8_E4M3 && conv.remoteType != NIXL_DTYPE_FP8_E5M2))
+        return false;
+    switch (conv.scaleMode) {
+        case NIXL_SCALE_NONE:
+            return true;
+        case NIXL_SCALE_FIXED:
+            return std::isfinite(conv.scale) && conv.scale > 0.0f;
+    }
+    return false;
+}
+
+void toRemote(const nixl_xfer_conv_t &conv, const void *src, void *dst, size_t count) {
+    convert(conv.localType, conv.remoteType, 1.0f / scaleOf(conv), src, dst, count);
+}
+
+void toLocal(const nixl_xfer_conv_t &conv, const void *src, void *dst, size_t count) {
+    convert(conv.remoteType, conv.localType, scaleOf(conv), src, dst, count);
+}
+
+}
@@ -0,0 +1,43 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __DTYPE_CONVERT_H
+#define __DTYPE_CONVERT_H
+
+#include <cstddef>
+#include "nixl_types.h"
+
+// Element type conversions of transfers, applied by backends in their copy or staging
+// stage. Elements are converted through FP32 in blocks, with vectorized loops for the
+// 16-bit types and a lookup table to decode FP8. Rounding is to nearest even, and values
+// out of the range of the destination type saturate to its largest finite value.
+namespace nixlDtype {
+
+    // Size of an element in bytes
+    size_t elemSize(nixl_dtype_t type);
+
+    // Checks the types, BF16 or FP16 to FP8, and the scale of a conversion
+    bool isValid(const nixl_xfer_conv_t &conv);
+
+    // Converts count elements from the local type at src to the remote type at dst
+    void toRemote(const nixl_xfer_conv_t &conv, const void *src, void *dst, size_t count);
+
+    // Converts count elements from the remote type at src to the local type at dst
+    void toLocal(const nixl_xfer_conv_t &conv, const void *src, void *dst, size_t count);
+
+}
+
+#endif
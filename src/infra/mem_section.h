@@ -82,6 +82,17 @@ class nixlMemSection {
 
 class nixlLocalSection : public nixlMemSection {
     public:
+        // Registers a single region with the backend without adding it to the section
+        static nixl_status_t registerDesc (const nixlBlobDesc &mem_elm,
+                                           const nixl_mem_t &nixl_mem,
+                                           nixlBackendEngine* backend,
+                                           nixlSectionDesc &local_sec,
+                                           nixlSectionDesc &self_sec);
+
+        // Adds regions registered through registerDesc
+        nixl_status_t insertDescList (const nixl_sec_dlist_t &local_elms,
+                                      nixlBackendEngine* backend);
+
         nixl_status_t addDescList (const nixl_reg_dlist_t &mem_elms,
                                    nixlBackendEngine* backend,
                                    nixl_sec_dlist_t &remote_self);
@@ -90,6 +101,11 @@ class nixlLocalSection : public nixlMemSection {
         nixl_status_t remDescList (const nixl_reg_dlist_t &mem_elms,
                                    nixlBackendEngine* backend);
 
+        // Same as remDescList, but the regions are returned instead of being deregistered
+        nixl_status_t detachDescList (const nixl_reg_dlist_t &mem_elms,
+                                      nixlBackendEngine* backend,
+                                      nixl_sec_dlist_t &detached);
+
         nixl_status_t serialize(nixlSerDes* serializer) const;
 
         nixl_status_t serializePartial(nixlSerDes* serializer,
@@ -116,6 +132,9 @@ class nixlRemoteSection : public nixlMemSection {
         // When adding self as a remote agent for local operations
         nixl_status_t loadLocalData (const nixl_sec_dlist_t& mem_elms,
                                      nixlBackendEngine* backend);
+        // Removes entries added by loadLocalData, metadata is released by the caller
+        nixl_status_t remLocalData (const nixl_sec_dlist_t& mem_elms,
+                                    nixlBackendEngine* backend);
         ~nixlRemoteSection();
 };
 
@@ -0,0 +1,201 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+#include "nixl_layout.h"
+#include "common/nixl_log.h"
+
+/*** Class nixlTensorLayout implementation ***/
+
+nixlTensorLayout::nixlTensorLayout(uintptr_t addr,
+                                   uint64_t dev_id,
+                                   nixl_mem_t mem_type,
+                                   size_t elem_size,
+                                   const std::vector<size_t> &shape,
+                                   const std::vector<size_t> &strides) :
+                                   addr(addr), devId(dev_id), memType(mem_type),
+                                   elemSize(elem_size), shape(shape), strides(strides) {
+    if (this->strides.empty()) {
+        this->strides.resize(shape.size());
+        size_t stride = elem_size;
+        for (size_t d = shape.size(); d > 0; d--) {
+            this->strides[d - 1] = stride;
+            stride *= shape[d - 1];
+        }
+    }
+}
+
+size_t nixlTensorLayout::numElems() const {
+    size_t count = 1;
+    for (auto &size : shape)
+        count *= size;
+    return count;
+}
+
+nixl_status_t nixlTensorLayout::slice(size_t dim, size_t start, size_t len,
+                                      nixlTensorLayout &out) const {
+    if (dim >= shape.size() || dim >= strides.size() || start + len > shape[dim])
+        return NIXL_ERR_INVALID_PARAM;
+
+    out             = *this;
+    out.addr       += start * strides[dim];
+    out.shape[dim]  = len;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlTensorLayout::permute(const std::vector<size_t> &perm,
+                                        nixlTensorLayout &out) const {
+    if (perm.size() != shape.size() || strides.size() != shape.size())
+        return NIXL_ERR_INVALID_PARAM;
+
+    std::vector<bool> seen(perm.size(), false);
+    for (auto &d : perm) {
+        if (d >= perm.size() || seen[d])
+            return NIXL_ERR_INVALID_PARAM;
+        seen[d] = true;
+    }
+
+    out = *this;
+    for (size_t d = 0; d < perm.size(); d++) {
+        out.shape[d]   = shape[perm[d]];
+        out.strides[d] = strides[perm[d]];
+    }
+    return NIXL_SUCCESS;
+}
+
+namespace {
+
+struct layoutLoop {
+    size_t size;
+    size_t srcStride;
+    size_t dstStride;
+};
+
+// Loop nest over the common index space of both layouts, outermost loop first,
+// with the innermost dimensions that are contiguous in both merged into `run`
+// bytes. An empty tensor is reported with a run of 0.
+nixl_status_t
+makeLoops(const nixlTensorLayout &src, const nixlTensorLayout &dst,
+          std::vector<layoutLoop> &loops, size_t &run) {
+    if (src.shape != dst.shape || src.elemSize != dst.elemSize || src.elemSize == 0 ||
+        src.strides.size() != src.shape.size() || dst.strides.size() != dst.shape.size()) {
+        NIXL_ERROR << "Tensor layouts of the transfer don't match";
+        return NIXL_ERR_INVALID_PARAM;
+    }
+
+    loops.clear();
+    run = 0;
+    for (size_t d = 0; d < src.shape.size(); d++) {
+        if (src.shape[d] == 0)
+            return NIXL_SUCCESS;
+        if (src.shape[d] > 1)
+            loops.push_back({src.shape[d], src.strides[d], dst.strides[d]});
+    }
+
+    // Elements are matched by index, so the loops can be reordered freely,
+    // the ones with the smallest strides go innermost
+    std::stable_sort(loops.begin(), loops.end(), [](const layoutLoop &a, const layoutLoop &b) {
+        return std::tie(a.dstStride, a.srcStride) > std::tie(b.dstStride, b.srcStride);
+    });
+
+    run = src.elemSize;
+    while (!loops.empty() && loops.back().srcStride == run && loops.back().dstStride == run) {
+        run *= loops.back().size;
+        loops.pop_back();
+    }
+
+    // Merge the remaining loops that are contiguous with the next one in both layouts
+    std::vector<layoutLoop> merged;
+    for (auto &loop : loops) {
+        if (!merged.empty() && merged.back().srcStride == loop.srcStride * loop.size &&
+            merged.back().dstStride == loop.dstStride * loop.size) {
+            merged.back().size      *= loop.size;
+            merged.back().srcStride  = loop.srcStride;
+            merged.back().dstStride  = loop.dstStride;
+        } else {
+            merged.push_back(loop);
+        }
+    }
+    loops.swap(merged);
+    return NIXL_SUCCESS;
+}
+
+template<typename Func>
+void
+forEachRun(const std::vector<layoutLoop> &loops, uintptr_t src, uintptr_t dst, Func &&func) {
+    std::vector<size_t> idx(loops.size(), 0);
+    for (;;) {
+        func(src, dst);
+
+        size_t d = loops.size();
+        for (; d > 0; d--) {
+            const auto &loop = loops[d - 1];
+            if (++idx[d - 1] < loop.size) {
+                src += loop.srcStride;
+                dst += loop.dstStride;
+                break;
+            }
+            idx[d - 1] = 0;
+            src -= loop.srcStride * (loop.size - 1);
+            dst -= loop.dstStride * (loop.size - 1);
+        }
+
+        if (d == 0)
+            return;
+    }
+}
+
+} // namespace
+
+nixl_status_t nixlTensorLayout::toDescs(const nixlTensorLayout &src,
+                                        const nixlTensorLayout &dst,
+                                        nixl_xfer_dlist_t &src_descs,
+                                        nixl_xfer_dlist_t &dst_descs) {
+    std::vector<layoutLoop> loops;
+    size_t run;
+
+    if (src_descs.getType() != src.memType || dst_descs.getType() != dst.memType)
+        return NIXL_ERR_INVALID_PARAM;
+
+    nixl_status_t ret = makeLoops(src, dst, loops, run);
+    if (ret != NIXL_SUCCESS || run == 0)
+        return ret;
+
+    forEachRun(loops, src.addr, dst.addr, [&](uintptr_t src_addr, uintptr_t dst_addr) {
+        src_descs.addDesc(nixlBasicDesc(src_addr, run, src.devId));
+        dst_descs.addDesc(nixlBasicDesc(dst_addr, run, dst.devId));
+    });
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlTensorLayout::copy(const nixlTensorLayout &src, const nixlTensorLayout &dst) {
+    std::vector<layoutLoop> loops;
+    size_t run;
+
+    if (src.memType != DRAM_SEG || dst.memType != DRAM_SEG)
+        return NIXL_ERR_NOT_SUPPORTED;
+
+    nixl_status_t ret = makeLoops(src, dst, loops, run);
+    if (ret != NIXL_SUCCESS || run == 0)
+        return ret;
+
+    forEachRun(loops, src.addr, dst.addr, [&](uintptr_t src_addr, uintptr_t dst_addr) {
+        memcpy(reinterpret_cast<void*>(dst_addr), reinterpret_cast<const void*>(src_addr), run);
+    });
+    return NIXL_SUCCESS;
+}
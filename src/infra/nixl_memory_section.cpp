@@ -146,15 +146,63 @@ nixl_status_t nixlMemSection::populate (const nixl_xfer_dlist_t &query,
 
 /*** Class nixlLocalSection implementation ***/
 
-// Calls into backend engine to register the memories in the desc list
-nixl_status_t nixlLocalSection::addDescList (const nixl_reg_dlist_t &mem_elms,
-                                             nixlBackendEngine* backend,
-                                             nixl_sec_dlist_t &remote_self) {
+// Calls into backend engine to register a single memory region, no section state is
+// touched so this can run without the agent lock.
+nixl_status_t nixlLocalSection::registerDesc (const nixlBlobDesc &mem_elm,
+                                              const nixl_mem_t &nixl_mem,
+                                              nixlBackendEngine* backend,
+                                              nixlSectionDesc &local_sec,
+                                              nixlSectionDesc &self_sec) {
+    nixl_status_t ret;
+
+    // TODO: For now trusting the user, but there can be a more checks mode
+    //       where we find overlaps and split the memories or warn the user
+    ret = backend->registerMem(mem_elm, nixl_mem, local_sec.metadataP);
+    if (ret != NIXL_SUCCESS)
+        return ret;
+
+    if (backend->supportsLocal()) {
+        ret = backend->loadLocalMD(local_sec.metadataP, self_sec.metadataP);
+        if (ret != NIXL_SUCCESS) {
+            backend->deregisterMem(local_sec.metadataP);
+            return ret;
+        }
+    }
+    if (backend->supportsRemote()) {
+        ret = backend->getPublicData(local_sec.metadataP, local_sec.metaBlob);
+        if (ret != NIXL_SUCCESS) {
+            // A backend might use the same object for both initiator/target
+            // side of a transfer, so no need for unloadMD in that case.
+            if (backend->supportsLocal() && self_sec.metadataP != local_sec.metadataP)
+                backend->unloadMD(self_sec.metadataP);
+            backend->deregisterMem(local_sec.metadataP);
+            return ret;
+        }
+    }
 
+    nixlBasicDesc *lp = &local_sec;
+    *lp = mem_elm; // Copy the basic desc part
+    if (((nixl_mem == BLK_SEG) || (nixl_mem == OBJ_SEG) ||
+         (nixl_mem == FILE_SEG)) && (lp->len==0)) {
+        // File has no range limit, unless the backend resolved it, e.g., when mapping it
+        lp->len = backend->getRegLen(local_sec.metadataP);
+        if (lp->len == 0)
+            lp->len = SIZE_MAX;
+    }
+
+    if (backend->supportsLocal()) {
+        nixlBasicDesc *rp = &self_sec;
+        *rp = *lp;
+    }
+    return NIXL_SUCCESS;
+}
+
+// Adds already registered memories to the section
+nixl_status_t nixlLocalSection::insertDescList (const nixl_sec_dlist_t &local_elms,
+                                                nixlBackendEngine* backend) {
     if (!backend)
         return NIXL_ERR_INVALID_PARAM;
-    // Find the MetaDesc list, or add it to the map
-    nixl_mem_t     nixl_mem     = mem_elms.getType();
+    nixl_mem_t     nixl_mem     = local_elms.getType();
     section_key_t  sec_key      = std::make_pair(nixl_mem, backend);
 
     auto it = sectionMap.find(sec_key);
@@ -164,73 +212,51 @@ nixl_status_t nixlLocalSection::addDescList (const nixl_reg_dlist_t &mem_elms,
     }
     nixl_sec_dlist_t *target = sectionMap[sec_key];
 
-    // Add entries to the target list
-    nixlSectionDesc local_sec, self_sec;
-    nixlBasicDesc *lp = &local_sec;
-    nixlBasicDesc *rp = &self_sec;
-    nixl_status_t ret;
-
-    int i;
-    for (i = 0; i < mem_elms.descCount(); ++i) {
-        // TODO: For now trusting the user, but there can be a more checks mode
-        //       where we find overlaps and split the memories or warn the user
-        ret = backend->registerMem(mem_elms[i], nixl_mem, local_sec.metadataP);
-        if (ret != NIXL_SUCCESS)
-            break;
+    for (auto & elm : local_elms)
+        target->addDesc(elm);
+    return NIXL_SUCCESS;
+}
 
-        if (backend->supportsLocal()) {
-            ret = backend->loadLocalMD(local_sec.metadataP, self_sec.metadataP);
-            if (ret != NIXL_SUCCESS) {
-                backend->deregisterMem(local_sec.metadataP);
-                break;
-            }
-        }
-        if (backend->supportsRemote()) {
-            ret = backend->getPublicData(local_sec.metadataP, local_sec.metaBlob);
-            if (ret != NIXL_SUCCESS) {
-                // A backend might use the same object for both initiator/target
-                // side of a transfer, so no need for unloadMD in that case.
-                if (backend->supportsLocal() && self_sec.metadataP != local_sec.metadataP)
-                    backend->unloadMD(self_sec.metadataP);
-                backend->deregisterMem(local_sec.metadataP);
-                break;
-            }
-        }
+// Calls into backend engine to register the memories in the desc list
+nixl_status_t nixlLocalSection::addDescList (const nixl_reg_dlist_t &mem_elms,
+                                             nixlBackendEngine* backend,
+                                             nixl_sec_dlist_t &remote_self) {
 
-        *lp = mem_elms[i]; // Copy the basic desc part
-        if (((nixl_mem == BLK_SEG) || (nixl_mem == OBJ_SEG) ||
-             (nixl_mem == FILE_SEG)) && (lp->len==0))
-            lp->len = SIZE_MAX; // File has no range limit
+    if (!backend)
+        return NIXL_ERR_INVALID_PARAM;
+    nixl_mem_t       nixl_mem = mem_elms.getType();
+    nixl_sec_dlist_t local_elms(nixl_mem, false);
+    nixlSectionDesc  local_sec, self_sec;
+    nixl_status_t    ret = NIXL_SUCCESS;
 
-        target->addDesc(local_sec);
+    for (int i = 0; i < mem_elms.descCount(); ++i) {
+        ret = registerDesc(mem_elms[i], nixl_mem, backend, local_sec, self_sec);
+        if (ret != NIXL_SUCCESS)
+            break;
 
-        if (backend->supportsLocal()) {
-            *rp = *lp;
+        local_elms.addDesc(local_sec);
+        if (backend->supportsLocal())
             remote_self.addDesc(self_sec);
-        }
     }
 
     // Abort in case of error
     if (ret != NIXL_SUCCESS) {
-        for (int j = 0; j < i; ++j) {
-            int index = target->getIndex(mem_elms[j]);
-
-            if (backend->supportsLocal()) {
-                int self_index = remote_self.getIndex(mem_elms[j]);
-                // Should never be negative, as we just added it in previous loop
-                if (self_index >= 0 && remote_self[self_index].metadataP != (*target)[index].metadataP)
-                    backend->unloadMD(remote_self[self_index].metadataP);
-            }
-            backend->deregisterMem((*target)[index].metadataP);
-            target->remDesc(index);
+        for (int j = 0; j < local_elms.descCount(); ++j) {
+            if (backend->supportsLocal() &&
+                remote_self[j].metadataP != local_elms[j].metadataP)
+                backend->unloadMD(remote_self[j].metadataP);
+            backend->deregisterMem(local_elms[j].metadataP);
         }
         remote_self.clear();
+        return ret;
     }
-    return ret;
+
+    return insertDescList(local_elms, backend);
 }
 
-nixl_status_t nixlLocalSection::remDescList (const nixl_reg_dlist_t &mem_elms,
-                                             nixlBackendEngine *backend) {
+nixl_status_t nixlLocalSection::detachDescList (const nixl_reg_dlist_t &mem_elms,
+                                                nixlBackendEngine *backend,
+                                                nixl_sec_dlist_t &detached) {
     if (!backend)
         return NIXL_ERR_INVALID_PARAM;
     nixl_mem_t     nixl_mem     = mem_elms.getType();
@@ -241,7 +267,7 @@ nixl_status_t nixlLocalSection::remDescList (const nixl_reg_dlist_t &mem_elms,
     nixl_sec_dlist_t *target = it->second;
 
     // First check if the mem_elms are present in the list,
-    // don't deregister anything in case any is missing.
+    // don't detach anything in case any is missing.
     for (auto & elm : mem_elms) {
         int index = target->getIndex(elm);
         if (index < 0)
@@ -251,7 +277,7 @@ nixl_status_t nixlLocalSection::remDescList (const nixl_reg_dlist_t &mem_elms,
     for (auto & elm : mem_elms) {
         int index = target->getIndex(elm);
         // Already checked, elm should always be found. Can add a check in debug mode.
-        backend->deregisterMem((*target)[index].metadataP);
+        detached.addDesc((*target)[index]);
         target->remDesc(index);
     }
 
@@ -264,6 +290,19 @@ nixl_status_t nixlLocalSection::remDescList (const nixl_reg_dlist_t &mem_elms,
     return NIXL_SUCCESS;
 }
 
+nixl_status_t nixlLocalSection::remDescList (const nixl_reg_dlist_t &mem_elms,
+                                             nixlBackendEngine *backend) {
+    nixl_sec_dlist_t detached(mem_elms.getType(), false);
+    nixl_status_t ret = detachDescList(mem_elms, backend, detached);
+    if (ret != NIXL_SUCCESS)
+        return ret;
+
+    for (auto & elm : detached)
+        backend->deregisterMem(elm.metadataP);
+
+    return NIXL_SUCCESS;
+}
+
 namespace {
 nixl_status_t serializeSections(nixlSerDes* serializer,
                                 const section_map_t &sections) {
@@ -447,6 +486,32 @@ nixl_status_t nixlRemoteSection::loadLocalData (
     return NIXL_SUCCESS;
 }
 
+nixl_status_t nixlRemoteSection::remLocalData (
+                                 const nixl_sec_dlist_t& mem_elms,
+                                 nixlBackendEngine* backend) {
+
+    section_key_t sec_key = std::make_pair(mem_elms.getType(), backend);
+    auto it = sectionMap.find(sec_key);
+    if (it == sectionMap.end())
+        return NIXL_ERR_NOT_FOUND;
+    nixl_sec_dlist_t *target = it->second;
+
+    // Metadata is owned by the caller, only the entries are removed
+    for (auto & elm: mem_elms) {
+        int index = target->getIndex(elm);
+        if (index >= 0)
+            target->remDesc(index);
+    }
+
+    if (target->descCount() == 0) {
+        delete target;
+        sectionMap.erase(sec_key);
+        memToBackend[mem_elms.getType()].erase(backend);
+    }
+
+    return NIXL_SUCCESS;
+}
+
 nixlRemoteSection::~nixlRemoteSection() {
     for (auto &[sec_key, dlist] : sectionMap) {
         nixlBackendEngine* eng = sec_key.second;
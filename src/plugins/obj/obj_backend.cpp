@@ -18,12 +18,14 @@
 #include "obj_backend.h"
 #include "common/nixl_log.h"
 #include "nixl_types.h"
+#include <absl/strings/numbers.h>
 #include <absl/strings/str_format.h>
 #include <memory>
 #include <future>
 #include <vector>
 #include <chrono>
 #include <algorithm>
+#include <type_traits>
 
 namespace {
 
@@ -34,6 +36,90 @@ getNumThreads (nixl_b_params_t *custom_params) {
         std::max (1u, std::thread::hardware_concurrency() / 2);
 }
 
+// Parses an optional numeric parameter, returns false if it is set to an invalid value
+template<typename T>
+bool
+getNumParam (nixl_b_params_t *custom_params, const std::string &key, T &value) {
+    auto it = custom_params->find (key);
+    if (it == custom_params->end()) return true;
+
+    bool valid;
+    if constexpr (std::is_floating_point_v<T>)
+        valid = absl::SimpleAtod (it->second, &value);
+    else
+        valid = absl::SimpleAtoi (it->second, &value);
+    if (!valid) NIXL_ERROR << absl::StrFormat ("Invalid value of %s: %s", key, it->second);
+    return valid;
+}
+
+std::shared_ptr<IS3Client>
+createLimiter (nixl_b_params_t *custom_params,
+               std::shared_ptr<IS3Client> s3_client,
+               bool &init_err) {
+    if (!custom_params) return s3_client;
+
+    // Opt-in, as it caps the requests in flight and retries throttled requests
+    auto adaptive_it = custom_params->find ("adaptive_concurrency");
+    if (adaptive_it == custom_params->end() || adaptive_it->second != "true") return s3_client;
+
+    nixlObjConcurrencyLimiter::params limits;
+    size_t initial_window = limits.initial_window;
+    size_t max_window = limits.max_window;
+    size_t backoff_ms = limits.backoff_base.count();
+    if (!getNumParam (custom_params, "initial_inflight", initial_window) ||
+        !getNumParam (custom_params, "max_inflight", max_window) ||
+        !getNumParam (custom_params, "max_retries", limits.max_retries) ||
+        !getNumParam (custom_params, "retry_backoff_ms", backoff_ms)) {
+        init_err = true;
+        return s3_client;
+    }
+    if (initial_window == 0 || max_window == 0) {
+        NIXL_ERROR << "Invalid concurrency limits: the in-flight windows can't be empty";
+        init_err = true;
+        return s3_client;
+    }
+    limits.initial_window = initial_window;
+    limits.max_window = max_window;
+    limits.backoff_base = std::chrono::milliseconds (backoff_ms);
+
+    return std::make_shared<nixlObjConcurrencyLimiter> (s3_client, limits);
+}
+
+std::unique_ptr<nixlObjPacker>
+createPacker (nixl_b_params_t *custom_params,
+              const std::string &local_agent,
+              std::shared_ptr<IS3Client> s3_client,
+              bool &init_err) {
+    size_t threshold = 0;
+    size_t container_size = 64 * 1024 * 1024;
+    double gc_ratio = 0.5;
+    if (!custom_params) return nullptr;
+
+    if (!getNumParam (custom_params, "pack_threshold", threshold) ||
+        !getNumParam (custom_params, "pack_container_size", container_size) ||
+        !getNumParam (custom_params, "pack_gc_ratio", gc_ratio)) {
+        init_err = true;
+        return nullptr;
+    }
+    if (threshold == 0) return nullptr;
+
+    if (container_size == 0 || gc_ratio < 0 || gc_ratio > 1) {
+        NIXL_ERROR << absl::StrFormat (
+            "Invalid packing parameters: container size %d, GC ratio %f", container_size, gc_ratio);
+        init_err = true;
+        return nullptr;
+    }
+
+    const std::string prefix = custom_params->count ("pack_prefix") > 0 ?
+        custom_params->at ("pack_prefix") :
+        "nixl-pack/" + local_agent + "/";
+
+    NIXL_INFO << absl::StrFormat (
+        "Packing objects of up to %d bytes into containers of %d bytes", threshold, container_size);
+    return std::make_unique<nixlObjPacker> (
+        s3_client, prefix, threshold, container_size, gc_ratio);
+}
+
 bool
 isValidPrepXferParams (const nixl_xfer_op_t &operation,
                        const nixl_meta_dlist_t &local,
@@ -116,7 +202,12 @@ nixlObjEngine::nixlObjEngine (const nixlBackendInitParams *init_params)
     : nixlBackendEngine (init_params),
       executor_ (
           std::make_shared<AsioThreadPoolExecutor> (getNumThreads (init_params->customParams))),
-      s3_client_ (std::make_shared<AwsS3Client> (init_params->customParams, executor_)) {
+      s3_client_ (createLimiter (
+          init_params->customParams,
+          std::make_shared<AwsS3Client> (init_params->customParams, executor_),
+          initErr)),
+      packer_ (createPacker (
+          init_params->customParams, init_params->localAgent, s3_client_, initErr)) {
     NIXL_INFO << "Object storage backend initialized with S3 client wrapper";
 }
 
@@ -125,12 +216,16 @@ nixlObjEngine::nixlObjEngine (const nixlBackendInitParams *init_params,
                               std::shared_ptr<IS3Client> s3_client)
     : nixlBackendEngine (init_params),
       executor_ (std::make_shared<AsioThreadPoolExecutor> (std::thread::hardware_concurrency())),
-      s3_client_ (s3_client) {
+      s3_client_ (createLimiter (init_params->customParams, s3_client, initErr)),
+      packer_ (createPacker (
+          init_params->customParams, init_params->localAgent, s3_client_, initErr)) {
     s3_client_->setExecutor (executor_);
     NIXL_INFO << "Object storage backend initialized with injected S3 client";
 }
 
 nixlObjEngine::~nixlObjEngine() {
+    // The packer waits for its callbacks, which need the executor running
+    packer_.reset();
     executor_->WaitUntilStopped();
 }
 
@@ -186,6 +281,7 @@ nixlObjEngine::postXfer (const nixl_xfer_op_t &operation,
                          nixlBackendReqH *&handle,
                          const nixl_opt_b_args_t *opt_args) const {
     nixlObjBackendReqH *req_h = static_cast<nixlObjBackendReqH *> (handle);
+    std::vector<nixlObjPackItem> pack_items;
 
     for (int i = 0; i < local.descCount(); ++i) {
         const auto &local_desc = local[i];
@@ -198,33 +294,40 @@ nixlObjEngine::postXfer (const nixl_xfer_op_t &operation,
             return NIXL_ERR_INVALID_PARAM;
         }
 
-        auto status_promise = std::make_shared<std::promise<nixl_status_t>>();
-        req_h->status_futures_.push_back (status_promise->get_future());
-
         uintptr_t data_ptr = local_desc.addr;
         size_t data_len = local_desc.len;
         size_t offset = remote_desc.addr;
 
+        // Small objects are aggregated and uploaded together once all descriptors are scanned
+        if (operation == NIXL_WRITE && packer_ && packer_->isPackable (offset, data_len)) {
+            pack_items.push_back ({obj_key_search->second, data_ptr, data_len});
+            continue;
+        }
+
+        auto status_promise = std::make_shared<std::promise<nixl_status_t>>();
+        req_h->status_futures_.push_back (status_promise->get_future());
+
         // S3 client interface signals completion via a callback, but NIXL API polls request handle
         // for the status code. Use future/promise pair to bridge the gap.
-        if (operation == NIXL_WRITE)
-            s3_client_->PutObjectAsync (obj_key_search->second,
-                                        data_ptr,
-                                        data_len,
-                                        offset,
-                                        [status_promise] (bool success) {
-                                            status_promise->set_value (success ? NIXL_SUCCESS :
-                                                                                 NIXL_ERR_BACKEND);
-                                        });
-        else
-            s3_client_->GetObjectAsync (obj_key_search->second,
-                                        data_ptr,
-                                        data_len,
-                                        offset,
-                                        [status_promise] (bool success) {
-                                            status_promise->set_value (success ? NIXL_SUCCESS :
-                                                                                 NIXL_ERR_BACKEND);
-                                        });
+        auto callback = [status_promise] (S3Result result) {
+            status_promise->set_value (result == S3Result::SUCCESS ? NIXL_SUCCESS :
+                                                                     NIXL_ERR_BACKEND);
+        };
+
+        if (operation == NIXL_WRITE) {
+            if (packer_) packer_->invalidate (obj_key_search->second);
+            s3_client_->PutObjectAsync (
+                obj_key_search->second, data_ptr, data_len, offset, callback);
+        } else if (!packer_ ||
+                   !packer_->read (obj_key_search->second, data_ptr, data_len, offset, callback)) {
+            s3_client_->GetObjectAsync (
+                obj_key_search->second, data_ptr, data_len, offset, callback);
+        }
+    }
+
+    if (!pack_items.empty()) {
+        for (auto &future : packer_->write (pack_items))
+            req_h->status_futures_.push_back (std::move (future));
     }
 
     return NIXL_IN_PROG;
@@ -19,6 +19,8 @@
 #define OBJ_BACKEND_H
 
 #include "obj_executor.h"
+#include "obj_limiter.h"
+#include "obj_pack.h"
 #include "obj_s3_client.h"
 #include <string>
 #include <memory>
@@ -108,6 +110,7 @@ private:
     std::shared_ptr<AsioThreadPoolExecutor> executor_;
     std::shared_ptr<IS3Client> s3_client_;
     std::unordered_map<uint64_t, std::string> dev_id_to_obj_key_;
+    std::unique_ptr<nixlObjPacker> packer_;
 };
 
 #endif // OBJ_BACKEND_H
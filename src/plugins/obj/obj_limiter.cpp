@@ -0,0 +1,232 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "obj_limiter.h"
+#include "common/nixl_log.h"
+#include <absl/strings/str_format.h>
+#include <algorithm>
+#include <limits>
+#include <string>
+
+namespace {
+
+// Weight of a new sample in the smoothed latency ratio
+constexpr double latency_ewma_weight = 0.125;
+
+// Multiplicative decrease factors for throttling and latency inflation
+constexpr double throttle_decrease = 0.5;
+constexpr double latency_decrease = 0.9;
+
+size_t
+sizeClass (size_t len) {
+    size_t size_class = 0;
+    while (len > 1) {
+        len >>= 1;
+        size_class++;
+    }
+    return size_class;
+}
+
+} // namespace
+
+nixlObjConcurrencyLimiter::nixlObjConcurrencyLimiter (std::shared_ptr<IS3Client> s3_client,
+                                                      const params &limits)
+    : s3_client_ (s3_client),
+      limits_ (limits),
+      window_ (std::clamp (limits.initial_window, limits.min_window, limits.max_window)),
+      rng_ (std::random_device{}()),
+      retry_thread_ ([this]() { retryLoop(); }) {
+    min_latency_us_.fill (std::numeric_limits<double>::max());
+}
+
+nixlObjConcurrencyLimiter::~nixlObjConcurrencyLimiter() {
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        stop_ = true;
+    }
+    retry_cv_.notify_all();
+    retry_thread_.join();
+}
+
+void
+nixlObjConcurrencyLimiter::PutObjectAsync (std::string_view key,
+                                           uintptr_t data_ptr,
+                                           size_t data_len,
+                                           size_t offset,
+                                           PutObjectCallback callback) {
+    auto req = std::make_shared<request>();
+    req->issue = [this, key = std::string (key), data_ptr, data_len, offset] (S3Callback cb) {
+        s3_client_->PutObjectAsync (key, data_ptr, data_len, offset, std::move (cb));
+    };
+    req->callback = std::move (callback);
+    req->size_class = sizeClass (data_len);
+    submit (std::move (req));
+}
+
+void
+nixlObjConcurrencyLimiter::GetObjectAsync (std::string_view key,
+                                           uintptr_t data_ptr,
+                                           size_t data_len,
+                                           size_t offset,
+                                           GetObjectCallback callback) {
+    auto req = std::make_shared<request>();
+    req->issue = [this, key = std::string (key), data_ptr, data_len, offset] (S3Callback cb) {
+        s3_client_->GetObjectAsync (key, data_ptr, data_len, offset, std::move (cb));
+    };
+    req->callback = std::move (callback);
+    req->size_class = sizeClass (data_len);
+    submit (std::move (req));
+}
+
+void
+nixlObjConcurrencyLimiter::DeleteObjectAsync (std::string_view key,
+                                              DeleteObjectCallback callback) {
+    auto req = std::make_shared<request>();
+    req->issue = [this, key = std::string (key)] (S3Callback cb) {
+        s3_client_->DeleteObjectAsync (key, std::move (cb));
+    };
+    req->callback = std::move (callback);
+    req->size_class = 0;
+    submit (std::move (req));
+}
+
+double
+nixlObjConcurrencyLimiter::getWindow() const {
+    std::lock_guard<std::mutex> lock (mutex_);
+    return window_;
+}
+
+size_t
+nixlObjConcurrencyLimiter::getInflight() const {
+    std::lock_guard<std::mutex> lock (mutex_);
+    return inflight_;
+}
+
+size_t
+nixlObjConcurrencyLimiter::getThrottledCount() const {
+    std::lock_guard<std::mutex> lock (mutex_);
+    return throttled_;
+}
+
+void
+nixlObjConcurrencyLimiter::submit (std::shared_ptr<request> req) {
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        pending_.push_back (std::move (req));
+    }
+    dispatch();
+}
+
+void
+nixlObjConcurrencyLimiter::dispatch() {
+    std::vector<std::shared_ptr<request>> ready;
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        const auto now = clock::now();
+        while (!pending_.empty() && inflight_ < static_cast<size_t> (window_)) {
+            auto req = std::move (pending_.front());
+            pending_.pop_front();
+            req->issued = now;
+            inflight_++;
+            ready.push_back (std::move (req));
+        }
+    }
+
+    // The wrapped client may complete inline, issue outside of the lock
+    for (auto &req : ready)
+        req->issue ([this, req] (S3Result result) { onComplete (req, result); });
+}
+
+void
+nixlObjConcurrencyLimiter::onComplete (std::shared_ptr<request> req, S3Result result) {
+    bool retry_req = false;
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        inflight_--;
+
+        if (result == S3Result::THROTTLED) {
+            throttled_++;
+            decrease (req->issued, throttle_decrease);
+
+            if (req->attempt < limits_.max_retries) {
+                const auto backoff =
+                    std::min<int64_t> (limits_.backoff_max.count(),
+                                       limits_.backoff_base.count() << std::min (req->attempt, 20u));
+                std::uniform_int_distribution<int64_t> jitter (0, backoff);
+                req->attempt++;
+                retries_.push ({clock::now() + std::chrono::milliseconds (jitter (rng_)), req});
+                retry_req = true;
+            }
+        } else if (result == S3Result::SUCCESS) {
+            const double latency_us = std::chrono::duration<double, std::micro> (
+                                          clock::now() - req->issued)
+                                          .count();
+            double &min_latency_us = min_latency_us_[req->size_class];
+            min_latency_us = std::min (min_latency_us, latency_us);
+
+            const double ratio = latency_us / std::max (min_latency_us, 1.0);
+            latency_ratio_ += latency_ewma_weight * (ratio - latency_ratio_);
+
+            if (latency_ratio_ > limits_.latency_tolerance)
+                decrease (req->issued, latency_decrease);
+            else
+                window_ = std::min (limits_.max_window, window_ + 1.0 / window_);
+        }
+    }
+
+    if (retry_req)
+        retry_cv_.notify_one();
+    else
+        req->callback (result);
+
+    dispatch();
+}
+
+void
+nixlObjConcurrencyLimiter::decrease (clock::time_point issued, double factor) {
+    // Requests issued before the last decrease saw the old window, don't react twice
+    if (issued < last_decrease_) return;
+
+    window_ = std::max (limits_.min_window, window_ * factor);
+    last_decrease_ = clock::now();
+    NIXL_DEBUG << absl::StrFormat ("Object store concurrency window decreased to %.1f", window_);
+}
+
+void
+nixlObjConcurrencyLimiter::retryLoop() {
+    std::unique_lock<std::mutex> lock (mutex_);
+    while (!stop_) {
+        if (retries_.empty()) {
+            retry_cv_.wait (lock);
+            continue;
+        }
+
+        const auto deadline = retries_.top().deadline;
+        if (clock::now() < deadline) {
+            retry_cv_.wait_until (lock, deadline);
+            continue;
+        }
+
+        auto req = retries_.top().req;
+        retries_.pop();
+        pending_.push_back (std::move (req));
+
+        lock.unlock();
+        dispatch();
+        lock.lock();
+    }
+}
@@ -0,0 +1,151 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OBJ_LIMITER_H
+#define OBJ_LIMITER_H
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <thread>
+#include <vector>
+#include "obj_s3_client.h"
+
+/**
+ * Adaptive concurrency limiter in front of an S3 client.
+ *
+ * Requests are queued and issued to the wrapped client while the number of requests in
+ * flight to the bucket is below the current window. The window follows an AIMD policy:
+ * it grows by one request per window of successful completions while the observed latency
+ * stays within a tolerance of the best latency seen for the same request size, and shrinks
+ * multiplicatively on throttling responses or on latency inflation, at most once per round
+ * trip. Latency inflation at a constant window means the extra requests only queue in the
+ * store without adding throughput, so the window stops growing at the throughput knee.
+ *
+ * Throttled requests are retried after an exponential backoff with full jitter, up to a
+ * maximum number of attempts after which the throttled result is reported to the caller.
+ */
+class nixlObjConcurrencyLimiter : public IS3Client {
+public:
+    struct params {
+        double initial_window = 32;
+        double min_window = 1;
+        double max_window = 1024;
+        double latency_tolerance = 2.0;
+        unsigned max_retries = 8;
+        std::chrono::milliseconds backoff_base{10};
+        std::chrono::milliseconds backoff_max{2000};
+    };
+
+    nixlObjConcurrencyLimiter (std::shared_ptr<IS3Client> s3_client, const params &limits);
+    ~nixlObjConcurrencyLimiter() override;
+
+    void
+    setExecutor (std::shared_ptr<Aws::Utils::Threading::Executor> executor) override {
+        s3_client_->setExecutor (executor);
+    }
+
+    void
+    PutObjectAsync (std::string_view key,
+                    uintptr_t data_ptr,
+                    size_t data_len,
+                    size_t offset,
+                    PutObjectCallback callback) override;
+
+    void
+    GetObjectAsync (std::string_view key,
+                    uintptr_t data_ptr,
+                    size_t data_len,
+                    size_t offset,
+                    GetObjectCallback callback) override;
+
+    void
+    DeleteObjectAsync (std::string_view key, DeleteObjectCallback callback) override;
+
+    double
+    getWindow() const;
+
+    size_t
+    getInflight() const;
+
+    size_t
+    getThrottledCount() const;
+
+private:
+    using clock = std::chrono::steady_clock;
+    using S3Callback = std::function<void (S3Result)>;
+
+    struct request {
+        std::function<void (S3Callback)> issue;
+        S3Callback callback;
+        size_t size_class;
+        unsigned attempt = 0;
+        clock::time_point issued;
+    };
+
+    struct retry {
+        clock::time_point deadline;
+        std::shared_ptr<request> req;
+
+        bool
+        operator> (const retry &other) const {
+            return deadline > other.deadline;
+        }
+    };
+
+    void
+    submit (std::shared_ptr<request> req);
+
+    void
+    dispatch();
+
+    void
+    onComplete (std::shared_ptr<request> req, S3Result result);
+
+    // Must be called with mutex_ held
+    void
+    decrease (clock::time_point issued, double factor);
+
+    void
+    retryLoop();
+
+    std::shared_ptr<IS3Client> s3_client_;
+    const params limits_;
+
+    mutable std::mutex mutex_;
+    std::deque<std::shared_ptr<request>> pending_;
+    double window_;
+    size_t inflight_ = 0;
+    size_t throttled_ = 0;
+    double latency_ratio_ = 1.0;
+    clock::time_point last_decrease_;
+    std::array<double, 64> min_latency_us_;
+    std::mt19937_64 rng_;
+
+    std::condition_variable retry_cv_;
+    std::priority_queue<retry, std::vector<retry>, std::greater<retry>> retries_;
+    bool stop_ = false;
+    std::thread retry_thread_;
+};
+
+#endif // OBJ_LIMITER_H
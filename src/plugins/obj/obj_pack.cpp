@@ -0,0 +1,368 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "obj_pack.h"
+#include "common/nixl_log.h"
+#include <absl/strings/str_format.h>
+#include <algorithm>
+#include <random>
+
+nixlObjPacker::nixlObjPacker (std::shared_ptr<IS3Client> s3_client,
+                              std::string container_prefix,
+                              size_t threshold,
+                              size_t container_size,
+                              double gc_ratio)
+    : s3_client_ (s3_client),
+      container_prefix_ (absl::StrFormat ("%s%08x-",
+                                          container_prefix,
+                                          static_cast<uint32_t> (std::random_device{}()))),
+      threshold_ (std::min (threshold, container_size)),
+      container_size_ (container_size),
+      gc_ratio_ (gc_ratio) {}
+
+nixlObjPacker::~nixlObjPacker() {
+    // Uploads, reads and garbage collection still in flight call back into the packer
+    std::unique_lock<std::mutex> lock (mutex_);
+    drained_.wait (lock, [this] { return outstanding_ == 0; });
+}
+
+std::shared_ptr<void>
+nixlObjPacker::track() {
+    std::lock_guard<std::mutex> lock (mutex_);
+    ++outstanding_;
+    return std::shared_ptr<void> (nullptr, [this] (void *) {
+        std::lock_guard<std::mutex> lock (mutex_);
+        if (--outstanding_ == 0) drained_.notify_all();
+    });
+}
+
+std::string
+nixlObjPacker::nextContainerName() {
+    return container_prefix_ + std::to_string (next_container_id_++);
+}
+
+std::vector<std::future<nixl_status_t>>
+nixlObjPacker::write (const std::vector<nixlObjPackItem> &items) {
+    std::vector<std::future<nixl_status_t>> futures;
+
+    std::vector<uint64_t> item_gens;
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        for (const auto &item : items) {
+            auto &pending = pending_[item.key];
+            pending.gen = ++next_gen_;
+            pending.writes++;
+            item_gens.push_back (pending.gen);
+        }
+    }
+
+    size_t i = 0;
+    while (i < items.size()) {
+        const std::string name = nextContainerName();
+        auto buffer = std::make_shared<std::vector<char>>();
+        std::vector<nixlObjPackEntry> entries;
+        std::vector<std::string> keys;
+        std::vector<uint64_t> gens;
+
+        for (; i < items.size(); ++i) {
+            const auto &item = items[i];
+            if (!buffer->empty() && buffer->size() + item.data_len > container_size_) break;
+
+            const char *data = reinterpret_cast<const char *> (item.data_ptr);
+            entries.push_back ({name, buffer->size(), item.data_len});
+            keys.push_back (item.key);
+            gens.push_back (item_gens[i]);
+            buffer->insert (buffer->end(), data, data + item.data_len);
+        }
+
+        auto status_promise = std::make_shared<std::promise<nixl_status_t>>();
+        futures.push_back (status_promise->get_future());
+
+        NIXL_DEBUG << absl::StrFormat (
+            "Packing %d objects into container %s of %d bytes", keys.size(), name, buffer->size());
+
+        s3_client_->PutObjectAsync (
+            name,
+            reinterpret_cast<uintptr_t> (buffer->data()),
+            buffer->size(),
+            0,
+            [this, name, buffer, entries = std::move (entries), keys = std::move (keys),
+             gens = std::move (gens), status_promise, token = track()] (S3Result result) {
+                const bool success = result == S3Result::SUCCESS;
+                if (success) {
+                    commitContainer (name, buffer->size(), entries, keys, gens);
+                } else {
+                    std::lock_guard<std::mutex> lock (mutex_);
+                    for (size_t j = 0; j < keys.size(); ++j)
+                        endWrite (keys[j], gens[j]);
+                }
+                status_promise->set_value (success ? NIXL_SUCCESS : NIXL_ERR_BACKEND);
+            });
+    }
+
+    return futures;
+}
+
+bool
+nixlObjPacker::read (const std::string &key,
+                     uintptr_t data_ptr,
+                     size_t data_len,
+                     size_t offset,
+                     GetObjectCallback callback) {
+    nixlObjPackEntry entry;
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        auto it = index_.find (key);
+        if (it == index_.end()) return false;
+
+        entry = it->second;
+        if (offset + data_len > entry.len) {
+            NIXL_ERROR << absl::StrFormat ("Read of [%d, %d) is out of bounds of packed object %s "
+                                           "of %d bytes",
+                                           offset,
+                                           offset + data_len,
+                                           key,
+                                           entry.len);
+            callback (S3Result::FAILURE);
+            return true;
+        }
+
+        // Pin the container so that garbage collection doesn't delete it under the read
+        containers_[entry.container].readers++;
+    }
+
+    s3_client_->GetObjectAsync (
+        entry.container,
+        data_ptr,
+        data_len,
+        entry.offset + offset,
+        [this, container = entry.container, callback, token = track()] (S3Result result) {
+            gcAction action;
+            {
+                std::lock_guard<std::mutex> lock (mutex_);
+                containers_[container].readers--;
+                action = maybeCollect (container);
+            }
+            runGc (action);
+            callback (result);
+        });
+
+    return true;
+}
+
+void
+nixlObjPacker::invalidate (const std::string &key) {
+    gcAction action;
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        // Packed writes of the key in flight are older than the direct write
+        auto pending_it = pending_.find (key);
+        if (pending_it != pending_.end()) pending_it->second.gen = ++next_gen_;
+
+        const std::string container = dropEntry (key);
+        if (container.empty()) return;
+        action = maybeCollect (container);
+    }
+    runGc (action);
+}
+
+size_t
+nixlObjPacker::getContainerCount() const {
+    std::lock_guard<std::mutex> lock (mutex_);
+    return containers_.size();
+}
+
+void
+nixlObjPacker::commitContainer (const std::string &name,
+                                size_t size,
+                                const std::vector<nixlObjPackEntry> &entries,
+                                const std::vector<std::string> &keys,
+                                const std::vector<uint64_t> &gens) {
+    std::vector<gcAction> actions;
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        std::unordered_set<std::string> affected;
+
+        auto &new_container = containers_[name];
+        new_container.size = size;
+        for (size_t i = 0; i < keys.size(); ++i) {
+            // Keys written or invalidated since are left dead in the container
+            if (!endWrite (keys[i], gens[i])) continue;
+
+            const std::string old_container = dropEntry (keys[i]);
+            if (!old_container.empty()) affected.insert (old_container);
+
+            index_[keys[i]] = entries[i];
+            new_container.live += entries[i].len;
+            new_container.keys.insert (keys[i]);
+        }
+
+        // Collect only after the whole batch is indexed, the new container may have been
+        // among the affected ones if a key was written twice in the same batch.
+        affected.insert (name);
+        for (const auto &container : affected)
+            actions.push_back (maybeCollect (container));
+    }
+
+    for (const auto &action : actions)
+        runGc (action);
+}
+
+bool
+nixlObjPacker::endWrite (const std::string &key, uint64_t gen) {
+    auto it = pending_.find (key);
+    const bool latest = it->second.gen == gen;
+    if (--it->second.writes == 0) pending_.erase (it);
+    return latest;
+}
+
+std::string
+nixlObjPacker::dropEntry (const std::string &key) {
+    auto it = index_.find (key);
+    if (it == index_.end()) return "";
+
+    const std::string container = it->second.container;
+    auto container_it = containers_.find (container);
+    if (container_it != containers_.end()) {
+        container_it->second.live -= it->second.len;
+        container_it->second.keys.erase (key);
+    }
+
+    index_.erase (it);
+    return container;
+}
+
+nixlObjPacker::gcAction
+nixlObjPacker::maybeCollect (const std::string &name) {
+    auto it = containers_.find (name);
+    if (it == containers_.end()) return {};
+
+    auto &container = it->second;
+    if (container.readers > 0 || container.compacting) return {};
+
+    if (container.live == 0) {
+        containers_.erase (it);
+        return {gcAction::DELETE, name, 0};
+    }
+
+    if (container.live < gc_ratio_ * container.size) {
+        container.compacting = true;
+        return {gcAction::COMPACT, name, container.size};
+    }
+
+    return {};
+}
+
+void
+nixlObjPacker::runGc (const gcAction &action) {
+    switch (action.type) {
+    case gcAction::NONE:
+        break;
+    case gcAction::DELETE:
+        NIXL_DEBUG << "Deleting dead container " << action.name;
+        s3_client_->DeleteObjectAsync (action.name, [name = action.name] (S3Result result) {
+            if (result != S3Result::SUCCESS)
+                NIXL_WARN << "Failed to delete dead container " << name;
+        });
+        break;
+    case gcAction::COMPACT:
+        compact (action.name, action.size);
+        break;
+    }
+}
+
+void
+nixlObjPacker::compact (const std::string &name, size_t size) {
+    NIXL_DEBUG << "Compacting container " << name;
+
+    auto buffer = std::make_shared<std::vector<char>> (size);
+    s3_client_->GetObjectAsync (
+        name,
+        reinterpret_cast<uintptr_t> (buffer->data()),
+        size,
+        0,
+        [this, name, buffer, token = track()] (S3Result result) {
+            const std::string new_name = nextContainerName();
+            auto packed = std::make_shared<std::vector<char>>();
+            std::vector<nixlObjPackEntry> entries;
+            std::vector<size_t> old_offsets;
+            std::vector<std::string> keys;
+            {
+                std::lock_guard<std::mutex> lock (mutex_);
+                auto it = containers_.find (name);
+                if (result != S3Result::SUCCESS) {
+                    NIXL_WARN << "Failed to read container " << name << " for compaction";
+                    it->second.compacting = false;
+                    return;
+                }
+
+                for (const auto &key : it->second.keys) {
+                    const auto &entry = index_.at (key);
+                    entries.push_back ({new_name, packed->size(), entry.len});
+                    old_offsets.push_back (entry.offset);
+                    keys.push_back (key);
+                    packed->insert (packed->end(),
+                                    buffer->begin() + entry.offset,
+                                    buffer->begin() + entry.offset + entry.len);
+                }
+            }
+
+            s3_client_->PutObjectAsync (
+                new_name,
+                reinterpret_cast<uintptr_t> (packed->data()),
+                packed->size(),
+                0,
+                [this, name, new_name, packed, entries = std::move (entries),
+                 old_offsets = std::move (old_offsets), keys = std::move (keys),
+                 token = track()] (S3Result result) {
+                    std::vector<gcAction> actions;
+                    {
+                        std::lock_guard<std::mutex> lock (mutex_);
+                        auto &old_container = containers_.at (name);
+                        old_container.compacting = false;
+                        if (result != S3Result::SUCCESS) {
+                            // Leave the container as is, compaction is retried on the
+                            // next entry that dies in it.
+                            NIXL_WARN << "Failed to write compacted container " << new_name;
+                            return;
+                        }
+
+                        auto &new_container = containers_[new_name];
+                        new_container.size = packed->size();
+                        for (size_t i = 0; i < keys.size(); ++i) {
+                            // Skip entries that were overwritten while compaction was running
+                            auto it = index_.find (keys[i]);
+                            if (it == index_.end() || it->second.container != name ||
+                                it->second.offset != old_offsets[i])
+                                continue;
+
+                            it->second = entries[i];
+                            old_container.live -= entries[i].len;
+                            old_container.keys.erase (keys[i]);
+                            new_container.live += entries[i].len;
+                            new_container.keys.insert (keys[i]);
+                        }
+
+                        actions.push_back (maybeCollect (name));
+                        actions.push_back (maybeCollect (new_name));
+                    }
+
+                    for (const auto &action : actions)
+                        runGc (action);
+                });
+        });
+}
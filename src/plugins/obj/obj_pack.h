@@ -0,0 +1,183 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OBJ_PACK_H
+#define OBJ_PACK_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "obj_s3_client.h"
+#include "nixl_types.h"
+
+/**
+ * Location of a packed logical object inside a container object.
+ */
+struct nixlObjPackEntry {
+    std::string container;
+    size_t offset;
+    size_t len;
+};
+
+/**
+ * A small logical object write to be packed into a container object.
+ */
+struct nixlObjPackItem {
+    std::string key;
+    uintptr_t data_ptr;
+    size_t data_len;
+};
+
+/**
+ * Packs small logical objects into large container objects.
+ *
+ * Writes of small objects are copied into a staging buffer and uploaded as one container
+ * object per batch, and an in-memory index maps each logical key to its range inside the
+ * container. Reads of packed keys are served with ranged GETs on the container. Containers
+ * are deleted once all of their entries are overwritten, and compacted into a new container
+ * when their live fraction drops below the configured ratio.
+ *
+ * The index is local to the engine and is not persisted, so packed objects are only
+ * readable by the engine instance that wrote them.
+ */
+class nixlObjPacker {
+public:
+    nixlObjPacker (std::shared_ptr<IS3Client> s3_client,
+                   std::string container_prefix,
+                   size_t threshold,
+                   size_t container_size,
+                   double gc_ratio);
+    ~nixlObjPacker();
+
+    /**
+     * Check whether a write of the given range is small enough to be packed.
+     */
+    bool
+    isPackable (size_t offset, size_t len) const {
+        return offset == 0 && len > 0 && len <= threshold_;
+    }
+
+    /**
+     * Upload the items packed into as few containers as possible. The index is updated
+     * once a container upload succeeds.
+     * @return One future per container upload
+     */
+    std::vector<std::future<nixl_status_t>>
+    write (const std::vector<nixlObjPackItem> &items);
+
+    /**
+     * Read a range of a packed logical object with a ranged GET on its container.
+     * @return false if the key is not packed, in which case the callback is not invoked
+     */
+    bool
+    read (const std::string &key,
+          uintptr_t data_ptr,
+          size_t data_len,
+          size_t offset,
+          GetObjectCallback callback);
+
+    /**
+     * Drop the index entry of a key that was written directly, bypassing the packer.
+     * Packed writes of the key still in flight are not indexed when they complete.
+     */
+    void
+    invalidate (const std::string &key);
+
+    size_t
+    getContainerCount() const;
+
+private:
+    struct container {
+        size_t size = 0;
+        size_t live = 0;
+        size_t readers = 0;
+        bool compacting = false;
+        std::unordered_set<std::string> keys;
+    };
+
+    // Packed writes of a key in flight, and the generation of its latest write or
+    // invalidation. Only the write of that generation is indexed when it completes.
+    struct pendingKey {
+        uint64_t gen = 0;
+        size_t writes = 0;
+    };
+
+    struct gcAction {
+        enum { NONE, DELETE, COMPACT } type = NONE;
+        std::string name;
+        size_t size = 0;
+    };
+
+    std::string
+    nextContainerName();
+
+    void
+    commitContainer (const std::string &name,
+                     size_t size,
+                     const std::vector<nixlObjPackEntry> &entries,
+                     const std::vector<std::string> &keys,
+                     const std::vector<uint64_t> &gens);
+
+    // Ends a packed write of the key and returns whether it is the latest one, must be
+    // called with mutex_ held
+    bool
+    endWrite (const std::string &key, uint64_t gen);
+
+    // Removes the key from the index and returns its container, must be called with mutex_ held
+    std::string
+    dropEntry (const std::string &key);
+
+    // Decides whether a container should be deleted or compacted, must be called with mutex_
+    // held. The returned action issues S3 requests and must be run after releasing the lock.
+    gcAction
+    maybeCollect (const std::string &name);
+
+    void
+    runGc (const gcAction &action);
+
+    void
+    compact (const std::string &name, size_t size);
+
+    // Counts an S3 callback that references the packer as outstanding, until the returned
+    // token is destroyed along with the callback
+    std::shared_ptr<void>
+    track();
+
+    std::shared_ptr<IS3Client> s3_client_;
+    const std::string container_prefix_;
+    const size_t threshold_;
+    const size_t container_size_;
+    const double gc_ratio_;
+    std::atomic<uint64_t> next_container_id_ = 0;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, nixlObjPackEntry> index_;
+    std::unordered_map<std::string, container> containers_;
+    std::unordered_map<std::string, pendingKey> pending_;
+    uint64_t next_gen_ = 0;
+    size_t outstanding_ = 0;
+    std::condition_variable drained_;
+};
+
+#endif // OBJ_PACK_H
@@ -24,6 +24,8 @@
 #include <aws/s3/model/GetObjectRequest.h>
 #include <aws/s3/model/PutObjectResult.h>
 #include <aws/s3/model/GetObjectResult.h>
+#include <aws/s3/model/DeleteObjectRequest.h>
+#include <aws/core/http/HttpResponse.h>
 #include <aws/core/http/Scheme.h>
 #include <aws/core/auth/AWSCredentials.h>
 #include <aws/core/client/ClientConfiguration.h>
@@ -117,6 +119,19 @@ getBucketName (nixl_b_params_t *custom_params) {
                               "set AWS_DEFAULT_BUCKET environment variable");
 }
 
+template<typename Outcome>
+S3Result
+toS3Result (const Outcome &outcome) {
+    if (outcome.IsSuccess()) return S3Result::SUCCESS;
+
+    const auto response_code = outcome.GetError().GetResponseCode();
+    if (response_code == Aws::Http::HttpResponseCode::SERVICE_UNAVAILABLE ||
+        response_code == Aws::Http::HttpResponseCode::TOO_MANY_REQUESTS)
+        return S3Result::THROTTLED;
+
+    return S3Result::FAILURE;
+}
+
 } // namespace
 
 AwsS3Client::AwsS3Client (nixl_b_params_t *custom_params,
@@ -165,7 +180,7 @@ AwsS3Client::PutObjectAsync (std::string_view key,
                              PutObjectCallback callback) {
     // AWS S3 doesn't support partial put operations with offset
     if (offset != 0) {
-        callback (false);
+        callback (S3Result::FAILURE);
         return;
     }
 
@@ -185,7 +200,7 @@ AwsS3Client::PutObjectAsync (std::string_view key,
             const Aws::S3::Model::PutObjectRequest &req,
             const Aws::S3::Model::PutObjectOutcome &outcome,
             const std::shared_ptr<const Aws::Client::AsyncCallerContext> &context) {
-            callback (outcome.IsSuccess());
+            callback (toS3Result (outcome));
         },
         nullptr);
 }
@@ -216,7 +231,23 @@ AwsS3Client::GetObjectAsync (std::string_view key,
                           const Aws::S3::Model::GetObjectRequest &req,
                           const Aws::S3::Model::GetObjectOutcome &outcome,
                           const std::shared_ptr<const Aws::Client::AsyncCallerContext> &context) {
-            callback (outcome.IsSuccess());
+            callback (toS3Result (outcome));
+        },
+        nullptr);
+}
+
+void
+AwsS3Client::DeleteObjectAsync (std::string_view key, DeleteObjectCallback callback) {
+    Aws::S3::Model::DeleteObjectRequest request;
+    request.WithBucket (bucket_name_).WithKey (Aws::String (key));
+
+    s3_client_->DeleteObjectAsync (
+        request,
+        [callback] (const Aws::S3::S3Client *client,
+                    const Aws::S3::Model::DeleteObjectRequest &req,
+                    const Aws::S3::Model::DeleteObjectOutcome &outcome,
+                    const std::shared_ptr<const Aws::Client::AsyncCallerContext> &context) {
+            callback (toS3Result (outcome));
         },
         nullptr);
 }
@@ -27,12 +27,19 @@
 #include <aws/core/Aws.h>
 #include "nixl_types.h"
 
-using PutObjectCallback = std::function<void (bool success)>;
-using GetObjectCallback = std::function<void (bool success)>;
+/**
+ * Result of an asynchronous S3 request. Throttling responses (503 SlowDown, 429) are reported
+ * separately from other failures so that callers can back off and retry them.
+ */
+enum class S3Result { SUCCESS, THROTTLED, FAILURE };
+
+using PutObjectCallback = std::function<void (S3Result result)>;
+using GetObjectCallback = std::function<void (S3Result result)>;
+using DeleteObjectCallback = std::function<void (S3Result result)>;
 
 /**
  * Abstract interface for S3 client operations.
- * Provides async operations for PutObject and GetObject.
+ * Provides async operations for PutObject, GetObject and DeleteObject.
  */
 class IS3Client {
 public:
@@ -74,6 +81,14 @@ public:
                     size_t data_len,
                     size_t offset,
                     GetObjectCallback callback) = 0;
+
+    /**
+     * Asynchronously delete an object from S3.
+     * @param key The object key
+     * @param callback Callback function to handle the result
+     */
+    virtual void
+    DeleteObjectAsync (std::string_view key, DeleteObjectCallback callback) = 0;
 };
 
 /**
@@ -106,6 +121,9 @@ public:
                     size_t offset,
                     GetObjectCallback callback) override;
 
+    void
+    DeleteObjectAsync (std::string_view key, DeleteObjectCallback callback) override;
+
 private:
     std::unique_ptr<Aws::SDKOptions, std::function<void (Aws::SDKOptions *)>> aws_options_;
     std::unique_ptr<Aws::S3::S3Client> s3_client_;
@@ -23,8 +23,9 @@
 #include <time.h>
 #include <stdexcept>
 
-aioQueue::aioQueue(int num_entries, nixl_xfer_op_t operation)
-    : aiocbs(num_entries), num_entries(num_entries), num_completed(0), num_submitted(0), operation(operation) {
+aioQueue::aioQueue(int num_entries, nixl_xfer_op_t operation, bool allow_short)
+    : aiocbs(num_entries), pending(num_entries, false), num_entries(num_entries), num_completed(0), num_submitted(0),
+      operation(operation), allow_short(allow_short) {
     if (num_entries <= 0) {
         throw std::runtime_error("Invalid number of entries for AIO queue");
     }
@@ -34,23 +35,28 @@ aioQueue::aioQueue(int num_entries, nixl_xfer_op_t operation)
 }
 
 aioQueue::~aioQueue() {
-    // There should not be any in-flight I/Os at destruction time
-    if (num_submitted > num_completed) {
-        NIXL_ERROR << "Programming error: Destroying aioQueue with " << (num_submitted - num_completed) << " in-flight I/Os";
-    }
-
-    // Cancel any remaining I/Os
-    for (auto& aiocb : aiocbs) {
-        if (aiocb.aio_fildes != 0) {
-            aio_cancel(aiocb.aio_fildes, &aiocb);
+    // I/Os of a canceled transfer may still be in flight, the ones that can't be
+    // canceled are waited for before their control blocks are freed
+    for (size_t i = 0; i < aiocbs.size(); i++) {
+        if (!pending[i])
+            continue;
+        if (aio_cancel(aiocbs[i].aio_fildes, &aiocbs[i]) == AIO_NOTCANCELED) {
+            const struct aiocb *list[] = {&aiocbs[i]};
+            while (aio_error(&aiocbs[i]) == EINPROGRESS)
+                aio_suspend(list, 1, nullptr);
         }
     }
 }
 
 nixl_status_t
 aioQueue::submit (const nixl_meta_dlist_t &, const nixl_meta_dlist_t &) {
+    // Control blocks are kept across submits, so that the transfer can be reposted
+    num_submitted = 0;
+    num_completed = 0;
+
     // Submit all I/Os at once
-    for (auto& aiocb : aiocbs) {
+    for (size_t i = 0; i < aiocbs.size(); i++) {
+        auto& aiocb = aiocbs[i];
         if (aiocb.aio_fildes == 0 || aiocb.aio_nbytes == 0) continue;
 
         // Check if file descriptor is valid
@@ -70,9 +76,9 @@ aioQueue::submit (const nixl_meta_dlist_t &, const nixl_meta_dlist_t &) {
             if (errno == EAGAIN) {
                 // If we hit the kernel limit, cancel all submitted I/Os and return error
                 NIXL_ERROR << "AIO submit failed: kernel queue full";
-                for (auto& cb : aiocbs) {
-                    if (cb.aio_fildes != 0) {
-                        aio_cancel(cb.aio_fildes, &cb);
+                for (size_t j = 0; j < i; j++) {
+                    if (pending[j]) {
+                        aio_cancel(aiocbs[j].aio_fildes, &aiocbs[j]);
                     }
                 }
                 return NIXL_ERR_BACKEND;
@@ -81,41 +87,42 @@ aioQueue::submit (const nixl_meta_dlist_t &, const nixl_meta_dlist_t &) {
             return NIXL_ERR_BACKEND;
         }
 
+        pending[i] = true;
         num_submitted++;
     }
 
-    num_completed = 0;
     return NIXL_IN_PROG;
 }
 
 nixl_status_t aioQueue::checkCompleted() {
-    if (num_completed == num_entries)
+    if (num_completed == num_submitted)
         return NIXL_SUCCESS;
 
     // Check all submitted I/Os
-    for (auto& aiocb : aiocbs) {
-        if (aiocb.aio_fildes == 0 || aiocb.aio_nbytes == 0)
-            continue;  // Skip unused control blocks
+    for (size_t i = 0; i < aiocbs.size(); i++) {
+        if (!pending[i])
+            continue;  // Skip unused or completed control blocks
 
+        auto& aiocb = aiocbs[i];
         int status = aio_error(&aiocb);
         if (status == 0) {  // Operation completed
+            pending[i] = false;
             ssize_t ret = aio_return(&aiocb);
-            if (ret < 0 || ret != static_cast<ssize_t>(aiocb.aio_nbytes)) {
+            if (ret < 0 || (!allow_short && ret != static_cast<ssize_t>(aiocb.aio_nbytes))) {
                 NIXL_PERROR << "AIO operation failed or incomplete";
                 return NIXL_ERR_BACKEND;
             }
             num_completed++;
-            aiocb.aio_fildes = 0;  // Mark as completed
-            aiocb.aio_nbytes = 0;
         } else if (status == EINPROGRESS) {
             return NIXL_IN_PROG;  // At least one operation still in progress
         } else {
+            pending[i] = false;
             NIXL_PERROR << "AIO error";
             return NIXL_ERR_BACKEND;
         }
     }
 
-    return (num_completed == num_entries) ? NIXL_SUCCESS : NIXL_IN_PROG;
+    return (num_completed == num_submitted) ? NIXL_SUCCESS : NIXL_IN_PROG;
 }
 
 nixl_status_t aioQueue::prepIO(int fd, void* buf, size_t len, off_t offset) {
@@ -28,10 +28,12 @@ class nixlPosixBackendReqH;
 class aioQueue : public nixlPosixQueue {
     private:
         std::vector<struct aiocb> aiocbs;  // Array of AIO control blocks
+        std::vector<bool> pending;         // Submitted I/Os not completed yet
         int num_entries;                   // Total number of entries expected
         int num_completed;                 // Number of completed operations
-        int num_submitted;                 // Track number of submitted I/Os
+        int num_submitted;                 // Number of I/Os of the last submit
         nixl_xfer_op_t operation;          // Whether this is a read operation
+        const bool allow_short;            // Short transfers (e.g. reads at EOF) complete
 
         // Delete copy and move operations
         aioQueue(const aioQueue&) = delete;
@@ -40,7 +42,7 @@ class aioQueue : public nixlPosixQueue {
         aioQueue& operator=(aioQueue&&) = delete;
 
     public:
-        aioQueue(int num_entries, nixl_xfer_op_t operation);
+        aioQueue(int num_entries, nixl_xfer_op_t operation, bool allow_short = false);
         ~aioQueue();
         nixl_status_t
         submit (const nixl_meta_dlist_t &, const nixl_meta_dlist_t &) override;
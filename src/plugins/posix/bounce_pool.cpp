@@ -0,0 +1,57 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bounce_pool.h"
+#include <stdlib.h>
+#include <unistd.h>
+
+nixlPosixBouncePool::nixlPosixBouncePool(size_t buffer_size, size_t max_cached)
+    : buffer_size(buffer_size)
+    , alignment(sysconf(_SC_PAGESIZE))
+    , max_cached(max_cached) {}
+
+nixlPosixBouncePool::~nixlPosixBouncePool() {
+    for (void* buffer : free_buffers)
+        free(buffer);
+}
+
+void* nixlPosixBouncePool::get() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (!free_buffers.empty()) {
+            void* buffer = free_buffers.back();
+            free_buffers.pop_back();
+            return buffer;
+        }
+    }
+
+    void* buffer;
+    if (posix_memalign(&buffer, alignment, buffer_size) != 0)
+        return nullptr;
+    return buffer;
+}
+
+void nixlPosixBouncePool::put(void* buffer) {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (free_buffers.size() < max_cached) {
+            free_buffers.push_back(buffer);
+            return;
+        }
+    }
+    free(buffer);
+}
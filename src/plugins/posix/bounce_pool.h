@@ -0,0 +1,51 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BOUNCE_POOL_H
+#define BOUNCE_POOL_H
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+// Pool of page aligned bounce buffers of a fixed size, used for the unaligned parts of
+// transfers to files opened with O_DIRECT. Buffers are allocated on demand and up to
+// max_cached of them are kept for reuse once released.
+class nixlPosixBouncePool {
+    private:
+        const size_t       buffer_size;
+        const size_t       alignment;
+        const size_t       max_cached;
+        std::mutex         lock;
+        std::vector<void*> free_buffers;
+
+        nixlPosixBouncePool(const nixlPosixBouncePool&) = delete;
+        nixlPosixBouncePool& operator=(const nixlPosixBouncePool&) = delete;
+
+    public:
+        nixlPosixBouncePool(size_t buffer_size, size_t max_cached);
+        ~nixlPosixBouncePool();
+
+        size_t getBufferSize() const { return buffer_size; }
+        size_t getAlignment() const { return alignment; }
+
+        // Returns nullptr if the allocation fails
+        void* get();
+        void put(void* buffer);
+};
+
+#endif // BOUNCE_POOL_H
@@ -0,0 +1,115 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "file_cache.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <absl/strings/str_format.h>
+#include "common/nixl_log.h"
+
+nixlPosixFileCache::nixlPosixFileCache(size_t max_open, int open_flags)
+    : max_open(max_open), open_flags(open_flags) {}
+
+nixlPosixFileCache::~nixlPosixFileCache() {
+    for (auto &[path, entry] : files) {
+        if (entry.refs > 0)
+            NIXL_WARN << "Closing file " << path << " still used by " << entry.refs
+                      << " requests";
+        close(entry.fd);
+    }
+}
+
+int nixlPosixFileCache::acquire(const std::string &path) {
+    std::lock_guard<std::mutex> guard(lock);
+
+    auto it = files.find(path);
+    if (it != files.end()) {
+        if (it->second.refs++ == 0)
+            idle.erase(it->second.idle_it);
+        hits++;
+        return it->second.fd;
+    }
+
+    // Make room first, so the limit holds as long as enough files are idle
+    closeIdle(max_open > 0 ? max_open - 1 : 0);
+
+    int fd = open(path.c_str(), open_flags | O_RDWR | O_CREAT, 0644);
+    if (fd < 0 && (errno == EACCES || errno == EROFS))
+        fd = open(path.c_str(), open_flags | O_RDONLY);
+    if (fd < 0) {
+        NIXL_PERROR << "Failed to open file " << path;
+        return -1;
+    }
+
+    opens++;
+    files[path] = {fd, 1, idle.end()};
+    if (files.size() > max_open)
+        NIXL_DEBUG << absl::StrFormat("%d files in use, above the limit of %d open files",
+                                      files.size(), max_open);
+    return fd;
+}
+
+void nixlPosixFileCache::release(const std::string &path) {
+    std::lock_guard<std::mutex> guard(lock);
+
+    auto it = files.find(path);
+    if (it == files.end() || it->second.refs == 0)
+        return;
+
+    if (--it->second.refs == 0) {
+        idle.push_front(path);
+        it->second.idle_it = idle.begin();
+        closeIdle(max_open);
+    }
+}
+
+void nixlPosixFileCache::remove(const std::string &path) {
+    std::lock_guard<std::mutex> guard(lock);
+
+    auto it = files.find(path);
+    if (it == files.end() || it->second.refs > 0)
+        return;
+
+    idle.erase(it->second.idle_it);
+    close(it->second.fd);
+    files.erase(it);
+}
+
+void nixlPosixFileCache::closeIdle(size_t limit) {
+    while (files.size() > limit && !idle.empty()) {
+        auto it = files.find(idle.back());
+        idle.pop_back();
+        close(it->second.fd);
+        files.erase(it);
+    }
+}
+
+size_t nixlPosixFileCache::getOpenCount() {
+    std::lock_guard<std::mutex> guard(lock);
+    return files.size();
+}
+
+size_t nixlPosixFileCache::getOpens() {
+    std::lock_guard<std::mutex> guard(lock);
+    return opens;
+}
+
+size_t nixlPosixFileCache::getHits() {
+    std::lock_guard<std::mutex> guard(lock);
+    return hits;
+}
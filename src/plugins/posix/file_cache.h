@@ -0,0 +1,67 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FILE_CACHE_H
+#define FILE_CACHE_H
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Bounded cache of open file descriptors for files registered by path. Files are opened on
+// first use and stay open while used by a transfer request, idle files are closed in least
+// recently used order once more than max_open files are open.
+class nixlPosixFileCache {
+    private:
+        struct fileEntry {
+            int                              fd;
+            size_t                           refs;
+            std::list<std::string>::iterator idle_it;  // Valid only when refs is 0
+        };
+
+        const size_t                               max_open;
+        const int                                  open_flags;
+        std::mutex                                 lock;
+        std::unordered_map<std::string, fileEntry> files;
+        std::list<std::string>                     idle;  // Most recently used first
+        size_t                                     opens = 0;
+        size_t                                     hits  = 0;
+
+        void closeIdle(size_t limit);
+
+        nixlPosixFileCache(const nixlPosixFileCache&) = delete;
+        nixlPosixFileCache& operator=(const nixlPosixFileCache&) = delete;
+
+    public:
+        nixlPosixFileCache(size_t max_open, int open_flags);
+        ~nixlPosixFileCache();
+
+        // Returns the fd of the file, or -1 with errno set, to be released after use
+        int acquire(const std::string &path);
+        void release(const std::string &path);
+
+        // Closes the file if no transfer uses it
+        void remove(const std::string &path);
+
+        size_t getOpenCount();
+        size_t getOpens();
+        size_t getHits();
+};
+
+#endif // FILE_CACHE_H
@@ -16,14 +16,27 @@
  */
 
 #include <iostream>
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <errno.h>
+#include <fcntl.h>
+#include <fstream>
 #include <stdexcept>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include <unistd.h>
 #include "posix_backend.h"
 #include <absl/log/log.h>
+#include <absl/strings/numbers.h>
 #include <absl/strings/str_format.h>
 #include "common/nixl_log.h"
+#include "common/str_tools.h"
 #include "queue_factory_impl.h"
+#include "dtype_convert.h"
 #include "nixl_types.h"
 
 namespace {
@@ -43,8 +56,8 @@ namespace {
             return false;
         }
 
-        if (remote.getType() != FILE_SEG) {
-            NIXL_ERROR << absl::StrFormat("Error: Remote memory type must be FILE_SEG, got %d", remote.getType());
+        if (remote.getType() != FILE_SEG && remote.getType() != BLK_SEG) {
+            NIXL_ERROR << absl::StrFormat("Error: Remote memory type must be FILE_SEG or BLK_SEG, got %d", remote.getType());
             return false;
         }
 
@@ -106,6 +119,198 @@ namespace {
         }
         return queue_t::AIO;
     }
+
+    constexpr size_t default_bounce_buffer_size = 1024 * 1024;
+    constexpr size_t staging_alignment = 4096;
+    constexpr size_t default_bounce_pool_size = 64;
+
+    // Leave half of the process fd limit to the application
+    size_t getDefaultMaxOpenFiles() {
+        struct rlimit limit;
+        if (getrlimit(RLIMIT_NOFILE, &limit) < 0 || limit.rlim_cur == RLIM_INFINITY)
+            return 1024;
+        return std::max<size_t>(limit.rlim_cur / 2, 1);
+    }
+
+    bool getBoolParam(const nixl_b_params_t* custom_params, const std::string &key) {
+        if (!custom_params || custom_params->count(key) == 0)
+            return false;
+        const auto &value = custom_params->at(key);
+        return value == "true" || value == "1";
+    }
+
+    size_t getSizeParam(const nixl_b_params_t* custom_params, const std::string &key,
+                        size_t default_value) {
+        size_t value;
+        if (!custom_params || custom_params->count(key) == 0)
+            return default_value;
+        if (!absl::SimpleAtoi(custom_params->at(key), &value)) {
+            NIXL_WARN << absl::StrFormat("Invalid value %s for %s, using %zu",
+                                         custom_params->at(key), key, default_value);
+            return default_value;
+        }
+        return value;
+    }
+
+    // Returns the alignment of buffers, lengths and offsets required for I/O on fd, or 0 if
+    // fd was not opened with O_DIRECT and any alignment works
+    size_t getDirectIoAlignment(int fd) {
+        int flags = fcntl(fd, F_GETFL);
+        if (flags < 0 || !(flags & O_DIRECT))
+            return 0;
+
+#ifdef STATX_DIOALIGN
+        struct statx stx;
+        if (statx(fd, "", AT_EMPTY_PATH, STATX_DIOALIGN, &stx) == 0 &&
+            (stx.stx_mask & STATX_DIOALIGN) && stx.stx_dio_offset_align != 0) {
+            return std::max(stx.stx_dio_offset_align, stx.stx_dio_mem_align);
+        }
+#endif
+
+        struct stat st;
+        if (fstat(fd, &st) == 0) {
+            int block_size;
+            if (S_ISBLK(st.st_mode) && ioctl(fd, BLKSSZGET, &block_size) == 0 && block_size > 0)
+                return block_size;
+
+            // The preferred I/O size is a multiple of the logical block size of the device
+            size_t io_size = st.st_blksize;
+            if (io_size >= 512 && (io_size & (io_size - 1)) == 0)
+                return io_size;
+        }
+        return sysconf(_SC_PAGESIZE);
+    }
+
+    // Returns the size of a file or block device, or -1 on error
+    off_t getFileSize(int fd) {
+        struct stat st;
+        if (fstat(fd, &st) < 0)
+            return -1;
+
+        uint64_t size;
+        if (S_ISBLK(st.st_mode))
+            return (ioctl(fd, BLKGETSIZE64, &size) < 0) ? -1 : static_cast<off_t>(size);
+        return st.st_size;
+    }
+
+    // Returns the largest I/O a block device takes in a single request, or 0 if not limited
+    size_t getMaxIoSize(int fd, const struct stat &st) {
+        if (!S_ISBLK(st.st_mode))
+            return 0;
+
+        // Partitions have the request queue of their disk
+        for (const char *queue : {"queue", "../queue"}) {
+            std::ifstream limit(absl::StrFormat("/sys/dev/block/%d:%d/%s/max_sectors_kb",
+                                                major(st.st_rdev), minor(st.st_rdev), queue));
+            size_t max_kb;
+            if (limit >> max_kb && max_kb > 0)
+                return max_kb * 1024;
+        }
+
+        unsigned short max_sectors;
+        if (ioctl(fd, BLKSECTGET, &max_sectors) == 0 && max_sectors > 0)
+            return max_sectors * 512;
+        return 0;
+    }
+
+    // Opens the block device of a BLK_SEG registration and probes its capabilities
+    nixl_status_t openBlockDevice(const nixlBlobDesc &mem, nixlPosixBlockMD &md) {
+        if (mem.metaInfo.empty()) {
+            md.fd = mem.devId;
+        } else {
+            // Block devices bypass the page cache unless the file system doesn't support it
+            for (int flags : {O_RDWR | O_DIRECT, O_RDONLY | O_DIRECT, O_RDWR, O_RDONLY}) {
+                md.fd = open(mem.metaInfo.c_str(), flags);
+                if (md.fd >= 0 || (errno != EACCES && errno != EROFS && errno != EINVAL))
+                    break;
+            }
+            if (md.fd < 0) {
+                NIXL_PERROR << "Failed to open block device " << mem.metaInfo;
+                return NIXL_ERR_BACKEND;
+            }
+            md.owned = true;
+        }
+
+        struct stat st;
+        if (fstat(md.fd, &st) < 0) {
+            NIXL_PERROR << "Failed to stat block device " << mem.devId;
+            return NIXL_ERR_BACKEND;
+        }
+        if (!S_ISBLK(st.st_mode) && !S_ISREG(st.st_mode)) {
+            NIXL_ERROR << absl::StrFormat("Device %d is neither a block device nor a file",
+                                          mem.devId);
+            return NIXL_ERR_INVALID_PARAM;
+        }
+
+        // Without O_DIRECT any alignment works for I/O, but offsets stay in whole blocks
+        int block_size;
+        md.block_size = getDirectIoAlignment(md.fd);
+        if (!md.block_size) {
+            md.block_size = (S_ISBLK(st.st_mode) && ioctl(md.fd, BLKSSZGET, &block_size) == 0)
+                ? block_size : 512;
+        }
+        md.max_io_size = getMaxIoSize(md.fd, st);
+        md.size        = getFileSize(md.fd);
+        if (md.size < 0) {
+            NIXL_PERROR << "Failed to get size of block device " << mem.devId;
+            return NIXL_ERR_BACKEND;
+        }
+
+        if (mem.len && mem.addr + mem.len > static_cast<uint64_t>(md.size)) {
+            NIXL_ERROR << absl::StrFormat("Range [%d, %d) is past the end of device %d of %d "
+                                          "bytes", mem.addr, mem.addr + mem.len, mem.devId,
+                                          md.size);
+            return NIXL_ERR_INVALID_PARAM;
+        }
+
+        NIXL_DEBUG << absl::StrFormat("Block device %d: %d bytes, %d bytes blocks, %d bytes "
+                                      "max I/O", mem.devId, md.size, md.block_size,
+                                      md.max_io_size);
+        return NIXL_SUCCESS;
+    }
+
+    // Parses the "<unit>:<path>,<path>,..." metaInfo of a striped volume, after its prefix
+    const std::string stripe_prefix = "stripe:";
+
+    nixl_status_t parseStripe(const std::string &spec, nixlBackendMD* &out) {
+        size_t sep = spec.find(':');
+        size_t unit = 0;
+        if (sep == std::string::npos || !absl::SimpleAtoi(spec.substr(0, sep), &unit) || !unit) {
+            NIXL_ERROR << "Invalid stripe unit in striped volume: " << spec;
+            return NIXL_ERR_INVALID_PARAM;
+        }
+
+        auto stripe_md = std::make_unique<nixlPosixStripeMD>(unit);
+        for (const auto &path : str_split(spec.substr(sep + 1), ",")) {
+            if (path.empty()) {
+                NIXL_ERROR << "Empty member path in striped volume: " << spec;
+                return NIXL_ERR_INVALID_PARAM;
+            }
+            stripe_md->members.push_back(std::make_unique<nixlPosixFileMD>(path));
+        }
+        if (stripe_md->members.empty()) {
+            NIXL_ERROR << "No member files in striped volume: " << spec;
+            return NIXL_ERR_INVALID_PARAM;
+        }
+
+        NIXL_DEBUG << absl::StrFormat("Striped volume over %d files, %d bytes stripe unit",
+                                      stripe_md->members.size(), unit);
+        out = stripe_md.release();
+        return NIXL_SUCCESS;
+    }
+
+    off_t alignDown(off_t value, size_t align) {
+        return value - value % static_cast<off_t>(align);
+    }
+
+    off_t alignUp(off_t value, size_t align) {
+        return alignDown(value + align - 1, align);
+    }
+}
+
+nixlPosixBlockMD::~nixlPosixBlockMD() {
+    if (owned && fd >= 0)
+        close(fd);
 }
 
 // -----------------------------------------------------------------------------
@@ -116,14 +321,23 @@ nixlPosixBackendReqH::nixlPosixBackendReqH(const nixl_xfer_op_t &op,
                                            const nixl_meta_dlist_t &loc,
                                            const nixl_meta_dlist_t &rem,
                                            const nixl_opt_b_args_t* args,
-                                           const nixl_b_params_t* params)
+                                           const nixl_b_params_t* params,
+                                           std::shared_ptr<nixlPosixBouncePool> bounce_pool,
+                                           std::shared_ptr<nixlPosixFileCache> file_cache)
     : operation(op)
     , local(loc)
     , remote(rem)
     , opt_args(args)
     , custom_params_(params)
     , queue_depth_(loc.descCount())
-    , queue_type_(getQueueType(params)) {
+    , queue_type_(getQueueType(params))
+    , file_cache_(std::move(file_cache))
+    , bounce_pool_(std::move(bounce_pool))
+    , convert_(args && args->hasConversion)
+    , conversion_(args ? args->conversion : nixl_xfer_conv_t())
+    , staged_(DRAM_SEG)
+    , striped_local_(DRAM_SEG)
+    , striped_remote_(rem.getType()) {
     if (queue_type_ == nixlPosixQueue::queue_t::UNSUPPORTED) {
         throw exception(
             absl::StrFormat("Unsupported backend type: %s", queue_type_),
@@ -135,29 +349,45 @@ nixlPosixBackendReqH::nixlPosixBackendReqH(const nixl_xfer_op_t &op,
             absl::StrFormat("Invalid descriptor count - local: %zu, remote: %zu", local.descCount(), remote.descCount()),
             NIXL_ERR_INVALID_PARAM);
     }
+}
 
-    nixl_status_t status = initQueues();
-    if (status != NIXL_SUCCESS) {
-        throw exception(
-            absl::StrFormat("Failed to initialize queues: %s", queue_type_),
-            status);
+nixlPosixBackendReqH::~nixlPosixBackendReqH() {
+    // Queues finish the I/Os of a canceled transfer before the buffers they use are released
+    queue.reset();
+    direct_.clear();
+    rmw_.queue.reset();
+    bounce_.queue.reset();
+    for (auto &range : bounce_ranges_) {
+        if (range.buffer)
+            bounce_pool_->put(range.buffer);
+    }
+    for (auto &[path, fd] : files_)
+        file_cache_->release(path);
+    free(staging_);
+}
+
+void nixlPosixBackendReqH::ioBatch::add(int fd, void *buf, size_t len, off_t offset) {
+    local.addDesc(nixlMetaDesc(reinterpret_cast<uintptr_t>(buf), len, 0));
+    remote.addDesc(nixlMetaDesc(offset, len, fd));
+}
+
+std::unique_ptr<nixlPosixQueue>
+nixlPosixBackendReqH::createQueue(int num_entries, nixl_xfer_op_t op, bool allow_short) const {
+    switch (queue_type_) {
+        case nixlPosixQueue::queue_t::AIO:
+            return QueueFactory::createAioQueue(num_entries, op, allow_short);
+        case nixlPosixQueue::queue_t::URING:
+            return QueueFactory::createUringQueue(num_entries, op, allow_short);
+        default:
+            throw exception(absl::StrFormat("Invalid queue type: %s", queue_type_),
+                            NIXL_ERR_INVALID_PARAM);
     }
 }
 
 
 nixl_status_t nixlPosixBackendReqH::initQueues() {
     try {
-        switch (queue_type_) {
-            case nixlPosixQueue::queue_t::AIO:
-                queue = QueueFactory::createAioQueue(queue_depth_, operation);
-                break;
-            case nixlPosixQueue::queue_t::URING:
-                queue = QueueFactory::createUringQueue(queue_depth_, operation);
-                break;
-            default:
-                NIXL_ERROR << absl::StrFormat("Invalid queue type: %s", queue_type_);
-                return NIXL_ERR_INVALID_PARAM;
-        }
+        queue = createQueue(queue_depth_, operation, false);
         return NIXL_SUCCESS;
     } catch (const nixlPosixBackendReqH::exception& e) {
         NIXL_ERROR << absl::StrFormat("Failed to initialize queues: %s", e.what());
@@ -168,32 +398,558 @@ nixl_status_t nixlPosixBackendReqH::initQueues() {
     }
 }
 
-nixl_status_t nixlPosixBackendReqH::prepXfer() {
-    for (auto [local_it, remote_it] = std::make_pair(local.begin(), remote.begin());
-         local_it != local.end() && remote_it != remote.end();
-         ++local_it, ++remote_it) {
-        nixl_status_t status = queue->prepIO(
-            remote_it->devId,
-            reinterpret_cast<void*>(local_it->addr),
-            remote_it->len,
-            remote_it->addr
-        );
+nixl_status_t nixlPosixBackendReqH::prepBatch(ioBatch &batch, nixl_xfer_op_t op,
+                                              bool allow_short) {
+    if (batch.local.descCount() == 0)
+        return NIXL_SUCCESS;
 
+    try {
+        batch.queue = createQueue(batch.local.descCount(), op, allow_short);
+    } catch (const nixlPosixBackendReqH::exception& e) {
+        NIXL_ERROR << absl::StrFormat("Failed to initialize queues: %s", e.what());
+        return e.code();
+    } catch (const std::exception& e) {
+        NIXL_ERROR << absl::StrFormat("Failed to initialize queues: %s", e.what());
+        return NIXL_ERR_BACKEND;
+    }
+
+    for (int i = 0; i < batch.local.descCount(); ++i) {
+        nixl_status_t status = batch.queue->prepIO(
+            batch.remote[i].devId,
+            reinterpret_cast<void*>(batch.local[i].addr),
+            batch.remote[i].len,
+            batch.remote[i].addr
+        );
         if (status != NIXL_SUCCESS) {
             NIXL_ERROR << "Error preparing I/O operation";
             return status;
         }
     }
+    return NIXL_SUCCESS;
+}
 
+nixl_status_t nixlPosixBackendReqH::submitBatch(ioBatch &batch) {
+    if (!batch.queue)
+        return NIXL_SUCCESS;
+
+    batch.done = false;
+    nixl_status_t status = batch.queue->submit(batch.local, batch.remote);
+    return (status == NIXL_IN_PROG) ? NIXL_SUCCESS : status;
+}
+
+nixl_status_t nixlPosixBackendReqH::checkBatch(ioBatch &batch) {
+    if (batch.done)
+        return NIXL_SUCCESS;
+
+    nixl_status_t status = batch.queue->checkCompleted();
+    if (status == NIXL_SUCCESS)
+        batch.done = true;
+    return status;
+}
+
+nixl_status_t
+nixlPosixBackendReqH::planBounce(std::vector<bouncePiece> &pieces,
+                                 const std::unordered_map<int, size_t> &alignments) {
+    // Pieces sharing a block go through the same bounce buffer, otherwise concurrent
+    // read-modify-writes of the block would overwrite each other. Such pieces are always
+    // within the same buffer sized window, so a range never exceeds the buffer size.
+    std::sort(pieces.begin(), pieces.end(), [](const bouncePiece &a, const bouncePiece &b) {
+        return (a.fd != b.fd) ? (a.fd < b.fd) : (a.start < b.start);
+    });
+
+    for (auto &piece : pieces) {
+        size_t align = alignments.at(piece.fd);
+        off_t start  = alignDown(piece.start, align);
+        off_t end    = alignUp(piece.end, align);
+        if (!bounce_ranges_.empty() && bounce_ranges_.back().fd == piece.fd &&
+            start < bounce_ranges_.back().end) {
+            bounce_ranges_.back().end = std::max(bounce_ranges_.back().end, end);
+            bounce_ranges_.back().pieces.push_back(piece);
+        } else {
+            bounce_ranges_.push_back({piece.fd, start, end, align, nullptr, false, {piece}});
+        }
+    }
+
+    for (auto &range : bounce_ranges_) {
+        range.buffer = static_cast<char*>(bounce_pool_->get());
+        if (!range.buffer) {
+            NIXL_ERROR << "Failed to allocate bounce buffer";
+            return NIXL_ERR_BACKEND;
+        }
+
+        const size_t len = range.end - range.start;
+        bounce_.add(range.fd, range.buffer, len, range.start);
+        if (operation != NIXL_WRITE)
+            continue;
+
+        // Blocks only partially written have to be read first. For a contiguous piece
+        // these are the first and last blocks, otherwise the whole range is read.
+        off_t covered_start = range.pieces.front().start;
+        off_t covered_end   = covered_start;
+        bool contiguous     = true;
+        for (auto &piece : range.pieces) {
+            contiguous  = contiguous && (piece.start <= covered_end);
+            covered_end = std::max(covered_end, piece.end);
+        }
+
+        const bool head = covered_start > range.start;
+        const bool tail = covered_end < range.end;
+        range.rmw = !contiguous || head || tail;
+        if (!contiguous) {
+            rmw_.add(range.fd, range.buffer, len, range.start);
+            continue;
+        }
+        if (head)
+            rmw_.add(range.fd, range.buffer, range.align, range.start);
+        if (tail && !(head && range.end - range.start == static_cast<off_t>(range.align)))
+            rmw_.add(range.fd, range.buffer + len - range.align, range.align,
+                     range.end - range.align);
+    }
+
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlPosixBackendReqH::submitBounce() {
+    if (operation == NIXL_WRITE) {
+        for (auto &range : bounce_ranges_) {
+            for (auto &piece : range.pieces)
+                memcpy(range.buffer + (piece.start - range.start), piece.user,
+                       piece.end - piece.start);
+        }
+    }
+    return submitBatch(bounce_);
+}
+
+nixl_status_t nixlPosixBackendReqH::finishBounce() {
+    struct stat st;
+
+    if (operation == NIXL_READ) {
+        for (auto &range : bounce_ranges_) {
+            const off_t size = getFileSize(range.fd);
+            if (size < 0) {
+                NIXL_PERROR << "Failed to get file size";
+                return NIXL_ERR_BACKEND;
+            }
+
+            // Bounce reads may be short at the end of the file, but not short of the data
+            for (auto &piece : range.pieces) {
+                if (piece.end > size) {
+                    NIXL_ERROR << absl::StrFormat("Read of [%d, %d) past the end of file",
+                                                  piece.start, piece.end);
+                    return NIXL_ERR_BACKEND;
+                }
+                memcpy(piece.user, range.buffer + (piece.start - range.start),
+                       piece.end - piece.start);
+            }
+        }
+        return NIXL_SUCCESS;
+    }
+
+    // Writes of whole blocks may extend the file past the written data. Only the padding
+    // of the last block is trimmed, and only while nothing else moved the end of the file.
+    for (auto &[fd, size] : file_sizes_) {
+        const off_t end = write_ends_[fd];
+        off_t padded_end = end;
+        for (auto &range : bounce_ranges_) {
+            if (range.fd == fd)
+                padded_end = std::max(padded_end, range.end);
+        }
+        if (padded_end <= std::max(size, end))
+            continue;
+
+        if (fstat(fd, &st) < 0) {
+            NIXL_PERROR << "Failed to get file size";
+            return NIXL_ERR_BACKEND;
+        }
+        if (st.st_size == padded_end && ftruncate(fd, std::max(size, end)) < 0) {
+            NIXL_PERROR << "Failed to truncate file";
+            return NIXL_ERR_BACKEND;
+        }
+    }
     return NIXL_SUCCESS;
 }
 
+int nixlPosixBackendReqH::getFileFd(const nixlMetaDesc &desc) {
+    auto file_md = static_cast<nixlPosixFileMD*>(desc.metadataP);
+    if (!file_md)
+        return desc.devId;
+
+    auto it = files_.find(file_md->path);
+    if (it != files_.end())
+        return it->second;
+
+    // Files stay open while the request exists, so that reposting doesn't reopen them
+    int fd = file_cache_->acquire(file_md->path);
+    if (fd >= 0)
+        files_[file_md->path] = fd;
+    return fd;
+}
+
+int nixlPosixBackendReqH::getBlockFd(const nixlMetaDesc &desc) {
+    auto block_md = static_cast<nixlPosixBlockMD*>(desc.metadataP);
+    if (!block_md) {
+        NIXL_ERROR << absl::StrFormat("Block device %d is not registered", desc.devId);
+        return -1;
+    }
+
+    if (desc.addr % block_md->block_size || desc.len % block_md->block_size) {
+        NIXL_ERROR << absl::StrFormat("Range [%d, %d) of device %d is not aligned to its %d "
+                                      "bytes blocks", desc.addr, desc.addr + desc.len,
+                                      desc.devId, block_md->block_size);
+        return -1;
+    }
+    if (desc.addr + desc.len > static_cast<uint64_t>(block_md->size)) {
+        NIXL_ERROR << absl::StrFormat("Range [%d, %d) is past the end of device %d",
+                                      desc.addr, desc.addr + desc.len, desc.devId);
+        return -1;
+    }
+
+    if (block_md->max_io_size)
+        max_io_sizes_[block_md->fd] = block_md->max_io_size;
+    return block_md->fd;
+}
+
+void nixlPosixBackendReqH::addDirect(int fd, char *buf, size_t len, off_t offset) {
+    // Each device gets its own queue, e.g., for the members of a striped volume
+    struct stat st;
+    dev_t dev = 0;
+    if (fstat(fd, &st) == 0)
+        dev = S_ISBLK(st.st_mode) ? st.st_rdev : st.st_dev;
+
+    auto &batch = direct_[dev];
+    auto max_it = max_io_sizes_.find(fd);
+    const size_t max_len = (max_it != max_io_sizes_.end()) ? max_it->second : len;
+    for (size_t done = 0; done < len; done += max_len)
+        batch.add(fd, buf + done, std::min(max_len, len - done), offset + done);
+}
+
+nixl_status_t nixlPosixBackendReqH::prepStripes() {
+    const nixl_meta_dlist_t &unstriped = convert_ ? staged_ : local;
+    for (auto remote_it = remote.begin(); remote_it != remote.end(); ++remote_it)
+        striped_ = striped_ || dynamic_cast<nixlPosixStripeMD*>(remote_it->metadataP);
+    if (!striped_)
+        return NIXL_SUCCESS;
+
+    for (auto [local_it, remote_it] = std::make_pair(unstriped.begin(), remote.begin());
+         local_it != unstriped.end() && remote_it != remote.end();
+         ++local_it, ++remote_it) {
+        auto stripe_md = dynamic_cast<nixlPosixStripeMD*>(remote_it->metadataP);
+        if (!stripe_md) {
+            striped_local_.addDesc(*local_it);
+            striped_remote_.addDesc(*remote_it);
+            continue;
+        }
+
+        const uint64_t unit  = stripe_md->unit;
+        const uint64_t width = stripe_md->members.size();
+        for (uint64_t done = 0; done < remote_it->len;) {
+            const uint64_t offset = remote_it->addr + done;
+            const uint64_t stripe = offset / unit;
+            const uint64_t len    = std::min(unit - offset % unit, remote_it->len - done);
+
+            nixlMetaDesc buf(local_it->addr + done, len, local_it->devId);
+            buf.metadataP = local_it->metadataP;
+            nixlMetaDesc io((stripe / width) * unit + offset % unit, len, remote_it->devId);
+            io.metadataP = stripe_md->members[stripe % width].get();
+            striped_local_.addDesc(buf);
+            striped_remote_.addDesc(io);
+            done += len;
+        }
+    }
+
+    NIXL_DEBUG << absl::StrFormat("Striped %d descriptors into %d I/Os", remote.descCount(),
+                                  striped_remote_.descCount());
+    return NIXL_SUCCESS;
+}
+
+// Each descriptor gets a page aligned range of the staging buffer, so that the staged
+// I/Os are as aligned as their file offsets
+nixl_status_t nixlPosixBackendReqH::prepConversion() {
+    const size_t local_elem  = nixlDtype::elemSize(conversion_.localType);
+    const size_t remote_elem = nixlDtype::elemSize(conversion_.remoteType);
+    if (!nixlDtype::isValid(conversion_)) {
+        NIXL_ERROR << "Invalid element type conversion";
+        return NIXL_ERR_INVALID_PARAM;
+    }
+
+    std::vector<size_t> offsets;
+    size_t total = 0;
+    for (auto [local_it, remote_it] = std::make_pair(local.begin(), remote.begin());
+         local_it != local.end() && remote_it != remote.end();
+         ++local_it, ++remote_it) {
+        if (local_it->len % local_elem || remote_it->len % remote_elem ||
+            local_it->len / local_elem != remote_it->len / remote_elem) {
+            NIXL_ERROR << absl::StrFormat("Descriptors of %zu and %zu bytes don't hold the same "
+                                          "number of elements", local_it->len, remote_it->len);
+            return NIXL_ERR_INVALID_PARAM;
+        }
+        offsets.push_back(total);
+        total += alignUp(remote_it->len, staging_alignment);
+    }
+
+    if (posix_memalign(&staging_, staging_alignment,
+                       std::max(total, staging_alignment)) != 0) {
+        staging_ = nullptr;
+        NIXL_ERROR << absl::StrFormat("Failed to allocate a %zu bytes staging buffer", total);
+        return NIXL_ERR_BACKEND;
+    }
+
+    auto offset_it = offsets.begin();
+    for (auto remote_it = remote.begin(); remote_it != remote.end(); ++remote_it, ++offset_it) {
+        staged_.addDesc(nixlMetaDesc(reinterpret_cast<uintptr_t>(staging_) + *offset_it,
+                                     remote_it->len, 0));
+    }
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlPosixBackendReqH::prepXfer() {
+    std::unordered_map<int, size_t> alignments;
+    std::vector<int> fds;
+    const bool block = (remote.getType() == BLK_SEG);
+
+    if (convert_) {
+        nixl_status_t status = prepConversion();
+        if (status != NIXL_SUCCESS)
+            return status;
+    }
+
+    nixl_status_t status = prepStripes();
+    if (status != NIXL_SUCCESS)
+        return status;
+
+    // Members of striped volumes have their fd in the batches, like files given by path
+    const nixl_meta_dlist_t &io_local  = ioLocal();
+    const nixl_meta_dlist_t &io_remote = ioRemote();
+    use_batches_ = striped_;
+    fds.reserve(io_remote.descCount());
+    for (auto [local_it, remote_it] = std::make_pair(io_local.begin(), io_remote.begin());
+         local_it != io_local.end() && remote_it != io_remote.end();
+         ++local_it, ++remote_it) {
+        int fd = block ? getBlockFd(*remote_it) : getFileFd(*remote_it);
+        if (fd < 0)
+            return block ? NIXL_ERR_INVALID_PARAM : NIXL_ERR_BACKEND;
+        fds.push_back(fd);
+
+        // Files given by path have their fd in the batches instead of the descriptors
+        if (fd != static_cast<int>(remote_it->devId))
+            use_batches_ = true;
+
+        // I/Os larger than the device takes are split
+        auto max_it = max_io_sizes_.find(fd);
+        if (max_it != max_io_sizes_.end() && remote_it->len > max_it->second)
+            use_batches_ = true;
+
+        auto align_it = alignments.find(fd);
+        if (align_it == alignments.end())
+            align_it = alignments.emplace(fd, getDirectIoAlignment(fd)).first;
+
+        size_t align = align_it->second;
+        if (align && ((local_it->addr | remote_it->addr | remote_it->len) % align))
+            use_batches_ = true;
+    }
+
+    if (!use_batches_) {
+        status = initQueues();
+        if (status != NIXL_SUCCESS)
+            return status;
+
+        for (auto [local_it, remote_it] = std::make_pair(io_local.begin(), io_remote.begin());
+             local_it != io_local.end() && remote_it != io_remote.end();
+             ++local_it, ++remote_it) {
+            status = queue->prepIO(
+                remote_it->devId,
+                reinterpret_cast<void*>(local_it->addr),
+                remote_it->len,
+                remote_it->addr
+            );
+
+            if (status != NIXL_SUCCESS) {
+                NIXL_ERROR << "Error preparing I/O operation";
+                return status;
+            }
+        }
+
+        return NIXL_SUCCESS;
+    }
+
+    // Aligned interiors of the descriptors go direct, unaligned heads and tails through
+    // bounce buffers. Descriptors whose buffer and offset are misaligned differently have
+    // no aligned interior and go through bounce buffers in buffer sized windows.
+    const size_t window = bounce_pool_ ? bounce_pool_->getBufferSize() : 0;
+    std::vector<bouncePiece> pieces;
+    auto fd_it = fds.begin();
+    for (auto [local_it, remote_it] = std::make_pair(io_local.begin(), io_remote.begin());
+         local_it != io_local.end() && remote_it != io_remote.end();
+         ++local_it, ++remote_it, ++fd_it) {
+        int fd      = *fd_it;
+        char *buf   = reinterpret_cast<char*>(local_it->addr);
+        off_t start = remote_it->addr;
+        off_t end   = start + remote_it->len;
+
+        size_t align = alignments[fd];
+        if (!align) {
+            addDirect(fd, buf, remote_it->len, start);
+            continue;
+        }
+
+        if (!bounce_pool_ || align > bounce_pool_->getAlignment() || window % align) {
+            NIXL_ERROR << absl::StrFormat("Unaligned I/O with %zu bytes alignment not supported",
+                                          align);
+            return NIXL_ERR_NOT_SUPPORTED;
+        }
+
+        // Writes to block devices are whole blocks and never change their size
+        if (!block)
+            write_ends_[fd] = std::max(write_ends_[fd], end);
+        if (local_it->addr % align == remote_it->addr % align) {
+            off_t head_end = std::min(alignUp(start, align), end);
+            if (head_end > start)
+                pieces.push_back({fd, start, head_end, buf});
+
+            off_t mid_start = alignUp(start, align);
+            off_t mid_end   = alignDown(end, align);
+            if (mid_start < mid_end)
+                addDirect(fd, buf + (mid_start - start), mid_end - mid_start, mid_start);
+
+            off_t tail_start = std::max(mid_end, head_end);
+            if (tail_start < end)
+                pieces.push_back({fd, tail_start, end, buf + (tail_start - start)});
+        } else {
+            for (off_t w = alignDown(start, window); w < end; w += window) {
+                off_t piece_start = std::max(w, start);
+                off_t piece_end   = std::min<off_t>(w + window, end);
+                pieces.push_back({fd, piece_start, piece_end, buf + (piece_start - start)});
+            }
+        }
+    }
+
+    status = planBounce(pieces, alignments);
+    if (status != NIXL_SUCCESS)
+        return status;
+
+    // Only files with bounce buffers writes may need their size fixed
+    for (auto it = write_ends_.begin(); it != write_ends_.end();) {
+        bool bounced = std::any_of(bounce_ranges_.begin(), bounce_ranges_.end(),
+                                   [&](const bounceRange &range) { return range.fd == it->first; });
+        it = bounced ? std::next(it) : write_ends_.erase(it);
+    }
+
+    int num_direct = 0;
+    for (auto &[dev, batch] : direct_)
+        num_direct += batch.local.descCount();
+    NIXL_DEBUG << absl::StrFormat("Split transfer: %d direct I/Os on %d devices, %d bounce "
+                                  "buffers, %d blocks to read before writing",
+                                  num_direct, direct_.size(), bounce_ranges_.size(),
+                                  rmw_.local.descCount());
+
+    for (auto &[dev, batch] : direct_) {
+        status = prepBatch(batch, operation, false);
+        if (status != NIXL_SUCCESS)
+            return status;
+    }
+    status = prepBatch(rmw_, NIXL_READ, true);
+    if (status == NIXL_SUCCESS)
+        status = prepBatch(bounce_, operation, operation == NIXL_READ);
+    return status;
+}
+
 nixl_status_t nixlPosixBackendReqH::checkXfer() {
-    return queue->checkCompleted();
+    nixl_status_t status = checkIo();
+    if (status != NIXL_SUCCESS || !convert_ || operation != NIXL_READ || converted_)
+        return status;
+
+    // Reads land in the staging buffer in the remote type
+    for (auto [local_it, staged_it] = std::make_pair(local.begin(), staged_.begin());
+         local_it != local.end() && staged_it != staged_.end();
+         ++local_it, ++staged_it) {
+        nixlDtype::toLocal(conversion_, reinterpret_cast<const void*>(staged_it->addr),
+                           reinterpret_cast<void*>(local_it->addr),
+                           staged_it->len / nixlDtype::elemSize(conversion_.remoteType));
+    }
+    converted_ = true;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlPosixBackendReqH::checkIo() {
+    if (!use_batches_)
+        return queue->checkCompleted();
+
+    nixl_status_t direct_status = NIXL_SUCCESS;
+    for (auto &[dev, batch] : direct_) {
+        nixl_status_t status = checkBatch(batch);
+        if (status < 0)
+            return status;
+        if (status != NIXL_SUCCESS)
+            direct_status = NIXL_IN_PROG;
+    }
+
+    if (!rmw_.done) {
+        nixl_status_t status = checkBatch(rmw_);
+        if (status != NIXL_SUCCESS)
+            return status;
+        status = submitBounce();
+        if (status != NIXL_SUCCESS)
+            return status;
+    }
+
+    nixl_status_t bounce_status = checkBatch(bounce_);
+    if (bounce_status < 0)
+        return bounce_status;
+
+    if (direct_status != NIXL_SUCCESS || bounce_status != NIXL_SUCCESS)
+        return NIXL_IN_PROG;
+    return finishBounce();
 }
 
 nixl_status_t nixlPosixBackendReqH::postXfer() {
-    return queue->submit (local, remote);
+    if (convert_) {
+        converted_ = false;
+        if (operation == NIXL_WRITE) {
+            for (auto [local_it, staged_it] = std::make_pair(local.begin(), staged_.begin());
+                 local_it != local.end() && staged_it != staged_.end();
+                 ++local_it, ++staged_it) {
+                nixlDtype::toRemote(conversion_, reinterpret_cast<const void*>(local_it->addr),
+                                    reinterpret_cast<void*>(staged_it->addr),
+                                    staged_it->len / nixlDtype::elemSize(conversion_.remoteType));
+            }
+        }
+    }
+
+    if (!use_batches_)
+        return queue->submit (ioLocal(), ioRemote());
+
+    nixl_status_t status;
+    for (auto &[dev, batch] : direct_) {
+        status = submitBatch(batch);
+        if (status != NIXL_SUCCESS)
+            return status;
+    }
+
+    if (operation == NIXL_WRITE) {
+        struct stat st;
+        file_sizes_.clear();
+        for (auto &[fd, end] : write_ends_) {
+            if (fstat(fd, &st) < 0) {
+                NIXL_PERROR << "Failed to get file size";
+                return NIXL_ERR_BACKEND;
+            }
+            file_sizes_[fd] = st.st_size;
+        }
+
+        // Blocks past the end of the file read short, their tail has to be zero
+        for (auto &range : bounce_ranges_) {
+            if (range.rmw)
+                memset(range.buffer, 0, range.end - range.start);
+        }
+
+        if (rmw_.queue) {
+            status = submitBatch(rmw_);
+            return (status == NIXL_SUCCESS) ? NIXL_IN_PROG : status;
+        }
+    }
+
+    status = submitBounce();
+    return (status == NIXL_SUCCESS) ? NIXL_IN_PROG : status;
 }
 
 // -----------------------------------------------------------------------------
@@ -209,23 +965,101 @@ nixlPosixEngine::nixlPosixEngine(const nixlBackendInitParams* init_params)
                                       queue_type_);
         return;
     }
+
+    bounce_pool_ = std::make_shared<nixlPosixBouncePool>(
+        getSizeParam(init_params->customParams, "bounce_buffer_size", default_bounce_buffer_size),
+        getSizeParam(init_params->customParams, "bounce_pool_size", default_bounce_pool_size));
+    file_cache_ = std::make_shared<nixlPosixFileCache>(
+        getSizeParam(init_params->customParams, "max_open_files", getDefaultMaxOpenFiles()),
+        getBoolParam(init_params->customParams, "use_direct_io") ? O_DIRECT : 0);
     NIXL_INFO << absl::StrFormat("POSIX backend initialized using %s backend", queue_type_);
 }
 
+nixlPosixEngine::~nixlPosixEngine() {
+    if (file_cache_ && file_cache_->getOpens() > 0) {
+        NIXL_DEBUG << absl::StrFormat("POSIX file cache: %d opens, %d hits",
+                                      file_cache_->getOpens(), file_cache_->getHits());
+    }
+}
+
 nixl_status_t nixlPosixEngine::registerMem(const nixlBlobDesc &mem,
                                            const nixl_mem_t &nixl_mem,
                                            nixlBackendMD* &out) {
+    out = nullptr;
     auto supported_mems = getSupportedMems();
-    if (std::find(supported_mems.begin(), supported_mems.end(), nixl_mem) != supported_mems.end())
-        return NIXL_SUCCESS;
+    if (std::find(supported_mems.begin(), supported_mems.end(), nixl_mem) == supported_mems.end())
+        return NIXL_ERR_NOT_SUPPORTED;
+
+    // Striped volumes are one registration over several files, e.g., on different mounts
+    if (nixl_mem == FILE_SEG && mem.metaInfo.rfind(stripe_prefix, 0) == 0)
+        return parseStripe(mem.metaInfo.substr(stripe_prefix.size()), out);
+
+    // Files with a path in metaInfo are identified by devId and opened on demand,
+    // otherwise devId is the fd of a file opened by the application
+    if (nixl_mem == FILE_SEG && !mem.metaInfo.empty())
+        out = new nixlPosixFileMD(mem.metaInfo);
+
+    // Block devices are opened and probed once, when registered
+    if (nixl_mem == BLK_SEG) {
+        auto block_md = std::make_unique<nixlPosixBlockMD>();
+        nixl_status_t status = openBlockDevice(mem, *block_md);
+        if (status != NIXL_SUCCESS)
+            return status;
+        out = block_md.release();
+    }
 
-    return NIXL_ERR_NOT_SUPPORTED;
+    return NIXL_SUCCESS;
 }
 
-nixl_status_t nixlPosixEngine::deregisterMem(nixlBackendMD *) {
+nixl_status_t nixlPosixEngine::deregisterMem(nixlBackendMD *meta) {
+    auto file_md = dynamic_cast<nixlPosixFileMD*>(meta);
+    if (file_md)
+        file_cache_->remove(file_md->path);
+
+    auto stripe_md = dynamic_cast<nixlPosixStripeMD*>(meta);
+    if (stripe_md) {
+        for (auto &member : stripe_md->members)
+            file_cache_->remove(member->path);
+    }
+    delete meta;
     return NIXL_SUCCESS;
 }
 
+nixl_status_t nixlPosixEngine::loadLocalMD(nixlBackendMD* input, nixlBackendMD* &output) {
+    output = nullptr;
+    if (!input)
+        return NIXL_SUCCESS;
+
+    if (auto file_md = dynamic_cast<nixlPosixFileMD*>(input)) {
+        output = new nixlPosixFileMD(file_md->path);
+        return NIXL_SUCCESS;
+    }
+
+    if (auto stripe_md = dynamic_cast<nixlPosixStripeMD*>(input)) {
+        auto copy = new nixlPosixStripeMD(stripe_md->unit);
+        for (auto &member : stripe_md->members)
+            copy->members.push_back(std::make_unique<nixlPosixFileMD>(member->path));
+        output = copy;
+        return NIXL_SUCCESS;
+    }
+
+    if (auto block_md = dynamic_cast<nixlPosixBlockMD*>(input)) {
+        // The copy holds its own descriptor, closed when it is unloaded
+        auto copy = std::make_unique<nixlPosixBlockMD>(*block_md);
+        copy->fd = dup(block_md->fd);
+        if (copy->fd < 0) {
+            NIXL_PERROR << "Failed to duplicate block device descriptor " << block_md->fd;
+            return NIXL_ERR_BACKEND;
+        }
+        copy->owned = true;
+        output = copy.release();
+        return NIXL_SUCCESS;
+    }
+
+    NIXL_ERROR << "Unknown POSIX metadata type";
+    return NIXL_ERR_INVALID_PARAM;
+}
+
 nixl_status_t nixlPosixEngine::prepXfer(const nixl_xfer_op_t &operation,
                                         const nixl_meta_dlist_t &local,
                                         const nixl_meta_dlist_t &remote,
@@ -251,7 +1085,9 @@ nixl_status_t nixlPosixEngine::prepXfer(const nixl_xfer_op_t &operation,
                 return NIXL_ERR_INVALID_PARAM;
         }
 
-        auto posix_handle = std::make_unique<nixlPosixBackendReqH>(operation, local, remote, opt_args, &params);
+        auto posix_handle = std::make_unique<nixlPosixBackendReqH>(operation, local, remote, opt_args,
+                                                                   &params, bounce_pool_,
+                                                                   file_cache_);
         nixl_status_t status = posix_handle->prepXfer();
         if (status != NIXL_SUCCESS) {
             return status;
@@ -18,15 +18,83 @@
 #ifndef POSIX_BACKEND_H
 #define POSIX_BACKEND_H
 
+#include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <absl/strings/str_format.h>
 #include "backend/backend_engine.h"
 #include "posix_queue.h"
+#include "bounce_pool.h"
+#include "file_cache.h"
+
+// Metadata of a file registered by path through metaInfo, opened through the file cache
+class nixlPosixFileMD : public nixlBackendMD {
+public:
+    const std::string path;
+
+    nixlPosixFileMD(const std::string &path) : nixlBackendMD(true), path(path) {}
+};
+
+// Striped volume registered as one FILE_SEG through a metaInfo of the form
+// "stripe:<unit>:<path>,<path>,...". Offsets of the volume are spread round robin over its
+// member files in stripe units, so that the I/Os of a descriptor go to all the members.
+class nixlPosixStripeMD : public nixlBackendMD {
+public:
+    const size_t                                  unit;
+    std::vector<std::unique_ptr<nixlPosixFileMD>> members;
+
+    nixlPosixStripeMD(size_t unit) : nixlBackendMD(true), unit(unit) {}
+};
+
+// Block device, or file used as one, registered as BLK_SEG. Descriptor addresses are byte
+// offsets on the device, and have to be aligned to its logical block size like lengths.
+class nixlPosixBlockMD : public nixlBackendMD {
+public:
+    int    fd;
+    bool   owned;        // Opened by the backend from the path in metaInfo
+    size_t block_size;   // Logical block size
+    size_t max_io_size;  // Largest single I/O of the device, 0 if not limited
+    off_t  size;         // Device size in bytes
+
+    nixlPosixBlockMD() : nixlBackendMD(true), fd(-1), owned(false), block_size(0),
+                         max_io_size(0), size(0) {}
+    ~nixlPosixBlockMD();
+};
 
 class nixlPosixBackendReqH : public nixlBackendReqH {
 private:
+    // Unaligned part of a descriptor on a file opened with O_DIRECT, in file offsets
+    struct bouncePiece {
+        int   fd;
+        off_t start;
+        off_t end;
+        char  *user;
+    };
+
+    // Aligned file range staged in a bounce buffer, shared by all pieces within it
+    struct bounceRange {
+        int                      fd;
+        off_t                    start;
+        off_t                    end;
+        size_t                   align;
+        char                     *buffer;
+        bool                     rmw;     // Has blocks to read before writing
+        std::vector<bouncePiece> pieces;
+    };
+
+    // I/Os of one phase of the transfer, submitted to their own queue
+    struct ioBatch {
+        nixl_meta_dlist_t               local;
+        nixl_meta_dlist_t               remote;
+        std::unique_ptr<nixlPosixQueue> queue;
+        bool                            done = true;
+
+        ioBatch() : local(DRAM_SEG), remote(FILE_SEG) {}
+        void add(int fd, void *buf, size_t len, off_t offset);
+    };
+
     const nixl_xfer_op_t            &operation;      // The transfer operation (read/write)
     const nixl_meta_dlist_t         &local;          // Local memory descriptor list
     const nixl_meta_dlist_t         &remote;         // Remote memory descriptor list
@@ -36,15 +104,66 @@ private:
     std::unique_ptr<nixlPosixQueue> queue;           // Async I/O queue instance
     const nixlPosixQueue::queue_t   queue_type_;     // Type of queue used
 
+    // Files registered by path used by this request, and their fds
+    std::shared_ptr<nixlPosixFileCache>  file_cache_;
+    std::unordered_map<std::string, int> files_;
+    std::unordered_map<int, size_t>      max_io_sizes_;  // Per block device fd
+
+    // Only used when descriptors are not aligned for O_DIRECT or files are given by path
+    std::shared_ptr<nixlPosixBouncePool> bounce_pool_;
+    std::vector<bounceRange>        bounce_ranges_;  // Bounce buffers, by fd and offset
+    std::map<dev_t, ioBatch>        direct_;         // Aligned parts of the descriptors, per device
+    ioBatch                         rmw_;            // Partial blocks to read before writes
+    ioBatch                         bounce_;         // Bounce buffers transfers
+    std::unordered_map<int, off_t>  write_ends_;     // Per fd end of written data
+    std::unordered_map<int, off_t>  file_sizes_;     // Per fd size before writing
+    bool                            use_batches_ = false;
+
+    // Transfers with an element type conversion do their I/O from a staging buffer in the
+    // remote type, converted from the local buffers before writes and to them after reads
+    const bool                      convert_;
+    const nixl_xfer_conv_t          conversion_;
+    void                            *staging_ = nullptr;
+    nixl_meta_dlist_t               staged_;         // Local descriptors in the staging buffer
+    bool                            converted_ = false;
+
+    // Descriptors on striped volumes, split into the I/Os of their member files
+    bool                            striped_ = false;
+    nixl_meta_dlist_t               striped_local_;
+    nixl_meta_dlist_t               striped_remote_;
+
+    const nixl_meta_dlist_t &ioLocal() const {
+        return striped_ ? striped_local_ : (convert_ ? staged_ : local);
+    }
+    const nixl_meta_dlist_t &ioRemote() const { return striped_ ? striped_remote_ : remote; }
+    nixl_status_t prepConversion();
+    nixl_status_t prepStripes();
+
     nixl_status_t initQueues();                      // Initialize async I/O queue
+    int getFileFd(const nixlMetaDesc &desc);
+    int getBlockFd(const nixlMetaDesc &desc);
+    void addDirect(int fd, char *buf, size_t len, off_t offset);
+    std::unique_ptr<nixlPosixQueue> createQueue(int num_entries, nixl_xfer_op_t op,
+                                                bool allow_short) const;
+    nixl_status_t prepBatch(ioBatch &batch, nixl_xfer_op_t op, bool allow_short);
+    nixl_status_t submitBatch(ioBatch &batch);
+    nixl_status_t checkBatch(ioBatch &batch);
+
+    nixl_status_t planBounce(std::vector<bouncePiece> &pieces,
+                             const std::unordered_map<int, size_t> &alignments);
+    nixl_status_t submitBounce();
+    nixl_status_t finishBounce();
+    nixl_status_t checkIo();
 
 public:
     nixlPosixBackendReqH(const nixl_xfer_op_t &operation,
                          const nixl_meta_dlist_t &local,
                          const nixl_meta_dlist_t &remote,
                          const nixl_opt_b_args_t* opt_args,
-                         const nixl_b_params_t* custom_params);
-    ~nixlPosixBackendReqH() {};
+                         const nixl_b_params_t* custom_params,
+                         std::shared_ptr<nixlPosixBouncePool> bounce_pool = nullptr,
+                         std::shared_ptr<nixlPosixFileCache> file_cache = nullptr);
+    ~nixlPosixBackendReqH();
 
     nixl_status_t postXfer();
     nixl_status_t prepXfer();
@@ -64,10 +183,12 @@ public:
 class nixlPosixEngine : public nixlBackendEngine {
 private:
     const nixlPosixQueue::queue_t queue_type_;
+    std::shared_ptr<nixlPosixBouncePool> bounce_pool_;
+    std::shared_ptr<nixlPosixFileCache> file_cache_;
 
 public:
     nixlPosixEngine(const nixlBackendInitParams* init_params);
-    virtual ~nixlPosixEngine() = default;
+    virtual ~nixlPosixEngine();
 
     bool supportsRemote() const override {
         return false;
@@ -85,8 +206,17 @@ public:
         return false;
     }
 
+    bool supportsConversion() const override {
+        return true;
+    }
+
     nixl_mem_list_t getSupportedMems() const override {
-        return {FILE_SEG, DRAM_SEG};
+        return {FILE_SEG, DRAM_SEG, BLK_SEG};
+    }
+
+    // Only DRAM registration is stateless, files and devices share the fd cache
+    bool supportsParallelReg(const nixl_mem_t &nixl_mem) const override {
+        return nixl_mem == DRAM_SEG;
     }
 
     nixl_status_t registerMem(const nixlBlobDesc &mem,
@@ -104,6 +234,7 @@ public:
     }
 
     nixl_status_t unloadMD(nixlBackendMD* input) override {
+        delete input;
         return NIXL_SUCCESS;
     }
 
@@ -124,10 +255,8 @@ public:
     nixl_status_t checkXfer(nixlBackendReqH* handle) const override;
     nixl_status_t releaseReqH(nixlBackendReqH* handle) const override;
 
-    nixl_status_t loadLocalMD(nixlBackendMD* input, nixlBackendMD* &output) override {
-        output = input;
-        return NIXL_SUCCESS;
-    }
+    // The loopback entry gets its own copy, as it outlives the registration it came from
+    nixl_status_t loadLocalMD(nixlBackendMD* input, nixlBackendMD* &output) override;
 };
 
 #endif // POSIX_BACKEND_H
@@ -46,7 +46,7 @@ static nixl_b_params_t get_backend_options() {
 
 // Function to get supported backend mem types
 static nixl_mem_list_t get_backend_mems() {
-    return {DRAM_SEG, FILE_SEG};
+    return {DRAM_SEG, FILE_SEG, BLK_SEG};
 }
 
 #ifdef STATIC_PLUGIN_POSIX
@@ -21,9 +21,12 @@
 #include "posix_queue.h"
 
 namespace QueueFactory {
-    std::unique_ptr<nixlPosixQueue> createAioQueue(int num_entries, nixl_xfer_op_t operation);
+    // Short transfers are errors unless allow_short is set
+    std::unique_ptr<nixlPosixQueue>
+    createAioQueue(int num_entries, nixl_xfer_op_t operation, bool allow_short = false);
 
-    std::unique_ptr<nixlPosixQueue> createUringQueue(int num_entries, nixl_xfer_op_t operation);
+    std::unique_ptr<nixlPosixQueue>
+    createUringQueue(int num_entries, nixl_xfer_op_t operation, bool allow_short = false);
 
     bool isUringAvailable();
 };
@@ -75,12 +75,14 @@ nixl_status_t UringQueue::init(int entries, const io_uring_params& params) {
     return NIXL_SUCCESS;
 }
 
-UringQueue::UringQueue(int num_entries, const io_uring_params& params, nixl_xfer_op_t operation)
+UringQueue::UringQueue(int num_entries, const io_uring_params& params, nixl_xfer_op_t operation,
+                       bool allow_short)
     : num_entries(num_entries)
     , num_completed(0)
     , prep_op(operation == NIXL_READ ?
         reinterpret_cast<io_uring_prep_func_t>(io_uring_prep_read) :
         reinterpret_cast<io_uring_prep_func_t>(io_uring_prep_write))
+    , allow_short(allow_short)
 {
     if (num_entries <= 0) {
         throw std::invalid_argument("Invalid number of entries for UringQueue");
@@ -109,6 +111,8 @@ UringQueue::submit (const nixl_meta_dlist_t &local, const nixl_meta_dlist_t &rem
             return NIXL_ERR_BACKEND;
         }
         prep_op (sqe, fd, buf, len, offset);
+        // The length is checked against the result on completion
+        sqe->user_data = len;
     }
 
     int ret = io_uring_submit(&uring);
@@ -141,6 +145,11 @@ nixl_status_t UringQueue::checkCompleted() {
             NIXL_ERROR << absl::StrFormat("IO operation failed: %s", nixl_strerror(-res));
             return NIXL_ERR_BACKEND;
         }
+        if (!allow_short && static_cast<__u64>(res) != cqe->user_data) {
+            NIXL_ERROR << absl::StrFormat("IO operation incomplete: %d of %llu bytes", res,
+                                          static_cast<unsigned long long>(cqe->user_data));
+            return NIXL_ERR_BACKEND;
+        }
         count++;
     }
 
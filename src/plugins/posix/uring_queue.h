@@ -34,6 +34,7 @@ class UringQueue : public nixlPosixQueue {
         const int num_entries;         // Total number of entries expected in this ring
         int num_completed;             // Number of completed operations so far
         io_uring_prep_func_t prep_op;  // Pointer to prep function
+        const bool allow_short;        // Short transfers (e.g. reads at EOF) complete
 
         // Initialize the queue with the given parameters
         nixl_status_t init(int num_entries, const struct io_uring_params& params);
@@ -45,7 +46,8 @@ class UringQueue : public nixlPosixQueue {
         UringQueue& operator=(UringQueue&&) = delete;
 
     public:
-        UringQueue(int num_entries, const struct io_uring_params& params, nixl_xfer_op_t operation);
+        UringQueue(int num_entries, const struct io_uring_params& params, nixl_xfer_op_t operation,
+                   bool allow_short = false);
         ~UringQueue();
         nixl_status_t
         submit (const nixl_meta_dlist_t &local, const nixl_meta_dlist_t &remote) override;
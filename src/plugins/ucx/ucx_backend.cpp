@@ -20,10 +20,15 @@
 #include "serdes/serdes.h"
 #include "common/nixl_log.h"
 
+#include <algorithm>
+#include <cstdlib>
 #include <optional>
 #include <limits>
 #include <string.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "absl/strings/numbers.h"
 
 #ifdef HAVE_CUDA
@@ -41,6 +46,87 @@ namespace {
             src.clear();
         }
     }
+
+    void moveCompactList(std::vector<nixl_compact_notif_t> &src,
+                         std::vector<nixl_compact_notif_t> &tgt)
+    {
+        tgt.insert(tgt.end(), src.begin(), src.end());
+        src.clear();
+    }
+
+    // Moves as many notifications as fit to the array, the rest stay in the list
+    size_t takeCompactList(std::vector<nixl_compact_notif_t> &src,
+                           nixl_compact_notif_t *tgt, size_t max_notifs)
+    {
+        const size_t count = std::min(src.size(), max_notifs);
+        std::copy(src.begin(), src.begin() + count, tgt);
+        src.erase(src.begin(), src.begin() + count);
+        return count;
+    }
+
+    // A compact notification is sent as an AM header, followed by the payload and the
+    // sender name. UCX copies the header on send, so nothing is allocated for it.
+    struct compactNotifHdr {
+        uint64_t tag;
+        uint16_t len;
+        uint16_t nameLen;
+        uint32_t reserved;  // Explicit padding, sent as zero
+    };
+    static_assert(sizeof(compactNotifHdr) == 16, "Compact notification header has no padding");
+
+    constexpr size_t compact_notif_max_inline = 256;
+
+    // UCX settings from the tuning profile entry for the expected message size, followed by
+    // the explicit ucx_config overrides. UCX configuration is per context, so a single profile
+    // entry is applied, the one for the largest sizes unless ucx_tune_size is given.
+    std::optional<nixl::ucx::configList> getUcxConfig(const nixl_b_params_t &params)
+    {
+        nixl::ucx::configList config;
+
+        std::string profile_path;
+        const auto profile_it = params.find("ucx_tune_profile");
+        if (profile_it != params.end() && !profile_it->second.empty()) {
+            profile_path = profile_it->second;
+        } else if (const char *env_path = std::getenv("NIXL_UCX_TUNE_PROFILE")) {
+            profile_path = env_path;
+        }
+
+        if (!profile_path.empty()) {
+            const auto profile = nixl::ucx::tuneProfile::load(profile_path);
+            if (!profile)
+                return std::nullopt;
+
+            const nixl::ucx::tuneEntry *entry = nullptr;
+            const auto size_it = params.find("ucx_tune_size");
+            size_t size;
+            if (size_it != params.end() && !size_it->second.empty()) {
+                if (!absl::SimpleAtoi(size_it->second, &size)) {
+                    NIXL_ERROR << "Invalid ucx_tune_size: " << size_it->second;
+                    return std::nullopt;
+                }
+                entry = profile->lookup(size);
+            } else if (!profile->getEntries().empty()) {
+                entry = &profile->getEntries().back();
+            }
+
+            if (entry) {
+                NIXL_INFO << "Applying UCX tuning profile " << profile_path << " entry for sizes "
+                          << entry->minSize << "-" << entry->maxSize << ": "
+                          << nixl::ucx::formatConfigList(entry->config);
+                config = entry->config;
+            }
+        }
+
+        const auto config_it = params.find("ucx_config");
+        if (config_it != params.end()) {
+            const auto overrides = nixl::ucx::parseConfigList(config_it->second);
+            if (!overrides)
+                return std::nullopt;
+            config.insert(config.end(), overrides->begin(), overrides->end());
+        }
+
+        return config;
+    }
 }
 
 /****************************************
@@ -364,7 +450,7 @@ public:
     }
 
 
-    nixl_status_t status()
+    nixl_status_t status(bool progress = true)
     {
         nixlUcxIntReq *req = head.next();
         nixl_status_t out_ret = NIXL_SUCCESS;
@@ -376,8 +462,10 @@ public:
 
         const auto &uw = eng.getWorker(worker_id);
 
-        /* Maximum progress */
-        while (uw->progress());
+        /* Maximum progress, unless the caller already progressed the worker */
+        if (progress) {
+            while (uw->progress());
+        }
 
         /* Go over all request updating their status */
         while(req) {
@@ -568,11 +656,35 @@ nixlUcxEngine::nixlUcxEngine (const nixlBackendInitParams* init_params)
         err_handling_mode = UCP_ERR_HANDLING_MODE_PEER;
     }
 
+    // FILE_SEG is opt-in, other file backends would otherwise get their ranges mapped too
+    const auto file_reg_it = custom_params->find("file_registration");
+    fileReg = file_reg_it != custom_params->end() && file_reg_it->second == "true";
+
+    const auto file_residency_it = custom_params->find("file_residency");
+    if (file_residency_it != custom_params->end() && !file_residency_it->second.empty()) {
+        if (file_residency_it->second == "prefault") {
+            fileResidency = nixl_ucx_file_residency_t::PREFAULT;
+        } else if (file_residency_it->second == "lock") {
+            fileResidency = nixl_ucx_file_residency_t::LOCK;
+        } else if (file_residency_it->second != "none") {
+            NIXL_ERROR << "Invalid file_residency: " << file_residency_it->second;
+            initErr = true;
+            return;
+        }
+    }
+
+    const auto ucx_config = getUcxConfig(*custom_params);
+    if (!ucx_config) {
+        initErr = true;
+        return;
+    }
+
     uc = std::make_shared<nixlUcxContext>(devs, sizeof(nixlUcxIntReq),
                                           _internalRequestInit,
                                           _internalRequestFini,
                                           pthrOn,
-                                          err_handling_mode, numWorkers, init_params->syncMode);
+                                          err_handling_mode, numWorkers, init_params->syncMode,
+                                          *ucx_config);
 
     for (unsigned int i = 0; i < numWorkers; i++)
         uws.emplace_back(std::make_unique<nixlUcxWorker>(uc));
@@ -604,6 +716,19 @@ nixlUcxEngine::nixlUcxEngine (const nixlBackendInitParams* init_params)
     uw->regAmCallback(CONN_CHECK, connectionCheckAmCb, this);
     uw->regAmCallback(DISCONNECT, connectionTermAmCb, this);
     uw->regAmCallback(NOTIF_STR, notifAmCb, this);
+    uw->regAmCallback(NOTIF_COMPACT, notifCompactAmCb, this);
+
+    ucp_worker_attr_t worker_attr;
+    worker_attr.field_mask = UCP_WORKER_ATTR_FIELD_MAX_AM_HEADER;
+    if (ucp_worker_query(uw->getWorker(), &worker_attr) == UCS_OK)
+        maxAmHeader = worker_attr.max_am_header;
+    else
+        maxAmHeader = sizeof(compactNotifHdr);
+
+    // Enough for bursts of small notifications without growing the lists
+    compactMainList.reserve(1024);
+    compactPthrPriv.reserve(1024);
+    compactPthr.reserve(1024);
 
     // Temp fixup
     if (getenv("NIXL_DISABLE_CUDA_ADDR_WA")) {
@@ -622,6 +747,8 @@ nixl_mem_list_t nixlUcxEngine::getSupportedMems () const {
     nixl_mem_list_t mems;
     mems.push_back(DRAM_SEG);
     mems.push_back(VRAM_SEG);
+    if (fileReg)
+        mems.push_back(FILE_SEG);
     return mems;
 }
 
@@ -807,11 +934,80 @@ nixl_status_t nixlUcxEngine::loadRemoteConnInfo (const std::string &remote_agent
 /****************************************
  * Memory management
 *****************************************/
+
+// Maps the range of a FILE_SEG descriptor, whose devId is the file descriptor and addr the
+// offset in the file. A zero length maps the file up to its current end.
+nixl_status_t nixlUcxEngine::fileMap(const nixlBlobDesc &mem, nixlUcxPrivateMetadata &priv,
+                                     void* &addr, size_t &len, bool &read_only) const
+{
+    // Path based or striped descriptors carry an ID in devId, not a file descriptor
+    if (!mem.metaInfo.empty()) {
+        NIXL_ERROR << "FILE_SEG descriptors with metaInfo are not supported by UCX";
+        return NIXL_ERR_NOT_SUPPORTED;
+    }
+
+    const int fd = mem.devId;
+    const int flags = fcntl(fd, F_GETFL);
+    if (flags < 0) {
+        NIXL_PERROR << "Invalid file descriptor " << fd;
+        return NIXL_ERR_INVALID_PARAM;
+    }
+    // Shared mappings need read access, even for remote writes only
+    if ((flags & O_ACCMODE) == O_WRONLY) {
+        NIXL_ERROR << "File descriptor " << fd << " is not open for reading";
+        return NIXL_ERR_INVALID_PARAM;
+    }
+    read_only = (flags & O_ACCMODE) == O_RDONLY;
+
+    len = mem.len;
+    if (len == 0) {
+        struct stat st;
+        if (fstat(fd, &st) < 0 || (uint64_t)st.st_size <= mem.addr) {
+            NIXL_ERROR << "Nothing to map from offset " << mem.addr << " of file descriptor "
+                       << fd;
+            return NIXL_ERR_INVALID_PARAM;
+        }
+        len = st.st_size - mem.addr;
+    }
+
+    // mmap offsets are page aligned, the range starts within the first page
+    const uint64_t page_mask = sysconf(_SC_PAGESIZE) - 1;
+    const uint64_t map_offset = mem.addr & ~page_mask;
+    priv.mapLen = len + (mem.addr - map_offset);
+
+    int map_flags = MAP_SHARED;
+    if (fileResidency != nixl_ucx_file_residency_t::NONE)
+        map_flags |= MAP_POPULATE;
+    void *map_addr = mmap(nullptr, priv.mapLen, read_only ? PROT_READ : PROT_READ | PROT_WRITE,
+                          map_flags, fd, map_offset);
+    if (map_addr == MAP_FAILED) {
+        NIXL_PERROR << "Failed to map " << len << " bytes at offset " << mem.addr
+                    << " of file descriptor " << fd;
+        return NIXL_ERR_BACKEND;
+    }
+
+    // Page cache pages can be reclaimed under memory pressure unless locked
+    if (fileResidency == nixl_ucx_file_residency_t::LOCK && mlock(map_addr, priv.mapLen) < 0) {
+        NIXL_PERROR << "Failed to lock the pages of file descriptor " << fd;
+        munmap(map_addr, priv.mapLen);
+        return NIXL_ERR_BACKEND;
+    }
+
+    priv.mapAddr = map_addr;
+    priv.addrBase = (uintptr_t)map_addr - map_offset;
+    priv.fileLen = len;
+    addr = (void*)(priv.addrBase + mem.addr);
+    return NIXL_SUCCESS;
+}
+
 nixl_status_t nixlUcxEngine::registerMem (const nixlBlobDesc &mem,
                                           const nixl_mem_t &nixl_mem,
                                           nixlBackendMD* &out)
 {
     auto priv = std::make_unique<nixlUcxPrivateMetadata>();
+    void *addr = (void*) mem.addr;
+    size_t len = mem.len;
+    bool read_only = false;
 
     if (nixl_mem == VRAM_SEG) {
         bool need_restart;
@@ -826,24 +1022,44 @@ nixl_status_t nixlUcxEngine::registerMem (const nixlBlobDesc &mem,
         }
     }
 
+    if (nixl_mem == FILE_SEG) {
+        if (!fileReg)
+            return NIXL_ERR_NOT_SUPPORTED;
+        const nixl_status_t status = fileMap(mem, *priv, addr, len, read_only);
+        if (status != NIXL_SUCCESS)
+            return status;
+    }
+
     // TODO: Add nixl_mem check?
-    const int ret = uc->memReg((void*) mem.addr, mem.len, priv->mem, nixl_mem);
+    const int ret = uc->memReg(addr, len, priv->mem, nixl_mem, read_only);
     if (ret) {
+        if (priv->mapAddr)
+            munmap(priv->mapAddr, priv->mapLen);
         return NIXL_ERR_BACKEND;
     }
     priv->rkeyStr = uc->packRkey(priv->mem);
 
     if (priv->rkeyStr.empty()) {
+        uc->memDereg(priv->mem);
+        if (priv->mapAddr)
+            munmap(priv->mapAddr, priv->mapLen);
         return NIXL_ERR_BACKEND;
     }
     out = priv.release();
     return NIXL_SUCCESS;
 }
 
+size_t nixlUcxEngine::getRegLen(const nixlBackendMD* meta) const
+{
+    return static_cast<const nixlUcxPrivateMetadata*>(meta)->fileLen;
+}
+
 nixl_status_t nixlUcxEngine::deregisterMem (nixlBackendMD* meta)
 {
     nixlUcxPrivateMetadata *priv = (nixlUcxPrivateMetadata*) meta;
     uc->memDereg(priv->mem);
+    if (priv->mapAddr)
+        munmap(priv->mapAddr, priv->mapLen);
     delete priv;
     return NIXL_SUCCESS;
 }
@@ -852,6 +1068,9 @@ nixl_status_t nixlUcxEngine::getPublicData (const nixlBackendMD* meta,
                                             std::string &str) const {
     const nixlUcxPrivateMetadata *priv = (nixlUcxPrivateMetadata*) meta;
     str = priv->get();
+    // Remote agents address file ranges by offset, they need the base of the mapping
+    if (priv->mapAddr)
+        str.insert(0, (const char*)&priv->addrBase, sizeof(priv->addrBase));
     return NIXL_SUCCESS;
 }
 
@@ -900,7 +1119,10 @@ nixlUcxEngine::loadLocalMD (nixlBackendMD* input,
                             nixlBackendMD* &output)
 {
     nixlUcxPrivateMetadata* input_md = (nixlUcxPrivateMetadata*) input;
-    return internalMDHelper(input_md->rkeyStr, localAgent, output);
+    const nixl_status_t ret = internalMDHelper(input_md->rkeyStr, localAgent, output);
+    if (ret == NIXL_SUCCESS)
+        ((nixlUcxPublicMetadata*) output)->addrBase = input_md->addrBase;
+    return ret;
 }
 
 // To be cleaned up
@@ -911,7 +1133,19 @@ nixl_status_t nixlUcxEngine::loadRemoteMD (const nixlBlobDesc &input,
 {
     // Set CUDA context of first device, UCX will anyways detect proper device when sending
     nixlUcxCudaCtxGuard guard(nixl_mem, m_cudaPrimaryCtx);
-    return internalMDHelper(input.metaInfo, remote_agent, output);
+    if (nixl_mem != FILE_SEG)
+        return internalMDHelper(input.metaInfo, remote_agent, output);
+
+    uint64_t addr_base;
+    if (input.metaInfo.size() <= sizeof(addr_base))
+        return NIXL_ERR_INVALID_PARAM;
+    std::memcpy(&addr_base, input.metaInfo.data(), sizeof(addr_base));
+
+    const nixl_status_t ret =
+        internalMDHelper(input.metaInfo.substr(sizeof(addr_base)), remote_agent, output);
+    if (ret == NIXL_SUCCESS)
+        ((nixlUcxPublicMetadata*) output)->addrBase = addr_base;
+    return ret;
 }
 
 nixl_status_t nixlUcxEngine::unloadMD (nixlBackendMD* input) {
@@ -1038,14 +1272,15 @@ nixl_status_t nixlUcxEngine::postXfer (const nixl_xfer_op_t &operation,
     }
 
     for(i = 0; i < lcnt; i++) {
-        void *laddr = (void*) local[i].addr;
-        size_t lsize = local[i].len;
-        void *raddr = (void*) remote[i].addr;
-        size_t rsize = remote[i].len;
-
         lmd = (nixlUcxPrivateMetadata*) local[i].metadataP;
         rmd = (nixlUcxPublicMetadata*) remote[i].metadataP;
 
+        // File offsets are translated to the addresses of their mappings, zero otherwise
+        void *laddr = (void*) (local[i].addr + lmd->addrBase);
+        size_t lsize = local[i].len;
+        void *raddr = (void*) (remote[i].addr + rmd->addrBase);
+        size_t rsize = remote[i].len;
+
         if (lsize != rsize) {
             return NIXL_ERR_INVALID_PARAM;
         }
@@ -1094,11 +1329,38 @@ nixl_status_t nixlUcxEngine::postXfer (const nixl_xfer_op_t &operation,
 }
 
 nixl_status_t nixlUcxEngine::checkXfer (nixlBackendReqH* handle) const
+{
+    return checkXferPriv(handle, true);
+}
+
+nixl_status_t nixlUcxEngine::checkXfers (const std::vector<nixlBackendReqH*> &handles,
+                                         std::vector<nixl_status_t> &status) const
+{
+    /* Requests to different agents share the workers, progress each worker
+       once for the whole batch instead of once per request */
+    std::vector<bool> progressed(uws.size(), false);
+    for (auto &handle : handles) {
+        size_t workerId = ((nixlUcxBackendH *)handle)->getWorkerId();
+        if (!progressed[workerId]) {
+            while (getWorker(workerId)->progress());
+            progressed[workerId] = true;
+        }
+    }
+
+    status.resize(handles.size());
+    for (size_t i = 0; i < handles.size(); i++) {
+        status[i] = checkXferPriv(handles[i], false);
+    }
+
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlUcxEngine::checkXferPriv (nixlBackendReqH* handle, bool progress) const
 {
     nixlUcxBackendH *intHandle = (nixlUcxBackendH *)handle;
     size_t workerId = intHandle->getWorkerId();
 
-    nixl_status_t status = intHandle->status();
+    nixl_status_t status = intHandle->status(progress);
     auto& notif = intHandle->notification();
     if (status == NIXL_SUCCESS && notif.has_value()) {
         nixlUcxReq req;
@@ -1188,6 +1450,9 @@ nixlUcxEngine::notifAmCb(void *arg, const void *header,
     std::string remote_name = ser_des.getStr("name");
     std::string msg = ser_des.getStr("msg");
 
+    if (engine->notifHandler && engine->notifHandler(remote_name, msg))
+        return UCS_OK;
+
     if (engine->isProgressThread()) {
         /* Append to the private list to allow batching */
         engine->notifPthrPriv.push_back(std::make_pair(std::move(remote_name), std::move(msg)));
@@ -1207,6 +1472,11 @@ void nixlUcxEngine::notifProgressCombineHelper(notif_list_t &src, notif_list_t &
 void nixlUcxEngine::notifProgress()
 {
     notifProgressCombineHelper(notifPthrPriv, notifPthr);
+
+    if (!compactPthrPriv.empty()) {
+        const std::lock_guard<std::mutex> lock(notifMtx);
+        moveCompactList(compactPthrPriv, compactPthr);
+    }
 }
 
 nixl_status_t nixlUcxEngine::getNotifs(notif_list_t &notif_list)
@@ -1222,6 +1492,12 @@ nixl_status_t nixlUcxEngine::getNotifs(notif_list_t &notif_list)
     return NIXL_SUCCESS;
 }
 
+nixl_status_t nixlUcxEngine::setNotifHandler(nixl_notif_handler_t handler)
+{
+    notifHandler = std::move(handler);
+    return NIXL_SUCCESS;
+}
+
 nixl_status_t nixlUcxEngine::genNotif(const std::string &remote_agent, const std::string &msg) const
 {
     nixl_status_t ret;
@@ -1242,3 +1518,132 @@ nixl_status_t nixlUcxEngine::genNotif(const std::string &remote_agent, const std
     }
     return NIXL_SUCCESS;
 }
+
+nixl_status_t nixlUcxEngine::notifCompactSendPriv(const std::string &remote_agent,
+                                                  uint64_t tag, const void *payload,
+                                                  size_t len, nixlUcxReq &req,
+                                                  size_t worker_id) const
+{
+    auto search = remoteConnMap.find(remote_agent);
+
+    if(search == remoteConnMap.end()) {
+        return NIXL_ERR_NOT_FOUND;
+    }
+
+    if (localAgent.size() > std::numeric_limits<uint16_t>::max())
+        return NIXL_ERR_NOT_SUPPORTED;
+
+    const compactNotifHdr hdr = {tag, static_cast<uint16_t>(len),
+                                 static_cast<uint16_t>(localAgent.size()), 0};
+    const size_t total = sizeof(hdr) + len + localAgent.size();
+    const uint32_t flags = UCP_AM_SEND_FLAG_EAGER | UCP_AM_SEND_FLAG_COPY_HEADER;
+
+    if (total <= std::min(maxAmHeader, compact_notif_max_inline)) {
+        char buffer[compact_notif_max_inline];
+        std::memcpy(buffer, &hdr, sizeof(hdr));
+        if (len)
+            std::memcpy(buffer + sizeof(hdr), payload, len);
+        std::memcpy(buffer + sizeof(hdr) + len, localAgent.data(), localAgent.size());
+        return search->second->getEp(worker_id)->sendAm(NOTIF_COMPACT, buffer, total,
+                                                        NULL, 0, flags, req);
+    }
+
+    // Long agent names don't fit in the header, they are sent as data
+    auto buffer = std::make_unique<std::string>();
+    buffer->append(static_cast<const char*>(payload), len);
+    buffer->append(localAgent);
+    nixl_status_t ret = search->second->getEp(worker_id)->sendAm(
+            NOTIF_COMPACT, (void*)&hdr, sizeof(hdr), (void*)buffer->data(), buffer->size(),
+            flags, req);
+
+    if (ret == NIXL_IN_PROG) {
+        nixlUcxIntReq* nReq = (nixlUcxIntReq*)req;
+        nReq->amBuffer = std::move(buffer);
+    }
+    return ret;
+}
+
+ucs_status_t
+nixlUcxEngine::notifCompactAmCb(void *arg, const void *header,
+                                size_t header_length, void *data,
+                                size_t length,
+                                const ucp_am_recv_param_t *param)
+{
+    nixlUcxEngine* engine = (nixlUcxEngine*) arg;
+
+    NIXL_ASSERT(!(param->recv_attr & UCP_AM_RECV_ATTR_FLAG_RNDV));
+    if (header_length < sizeof(compactNotifHdr)) {
+        NIXL_ERROR << "Invalid compact notification of " << header_length << " bytes";
+        return UCS_OK;
+    }
+
+    compactNotifHdr hdr;
+    std::memcpy(&hdr, header, sizeof(hdr));
+
+    // Payload and name follow the header, either within it or as data
+    const char *body = (header_length > sizeof(hdr)) ?
+                       static_cast<const char*>(header) + sizeof(hdr) :
+                       static_cast<const char*>(data);
+    const size_t body_length = (header_length > sizeof(hdr)) ?
+                               header_length - sizeof(hdr) : length;
+    if (hdr.len > compact_notif_max_payload || body_length != size_t(hdr.len) + hdr.nameLen) {
+        NIXL_ERROR << "Invalid compact notification, payload " << hdr.len << " bytes, name "
+                   << hdr.nameLen << " bytes, received " << body_length << " bytes";
+        return UCS_OK;
+    }
+
+    // Agent names are kept for the engine lifetime, and looked up without allocating
+    std::string_view name(body + hdr.len, hdr.nameLen);
+    auto agent_it = engine->compactAgents.find(name);
+    if (agent_it == engine->compactAgents.end()) {
+        engine->compactAgentNames.emplace_back(name);
+        const std::string &stored = engine->compactAgentNames.back();
+        agent_it = engine->compactAgents.insert(std::string_view(stored)).first;
+    }
+
+    auto &list = engine->isProgressThread() ? engine->compactPthrPriv : engine->compactMainList;
+    nixl_compact_notif_t &notif = list.emplace_back();
+    notif.agent = *agent_it;
+    notif.tag   = hdr.tag;
+    notif.len   = hdr.len;
+    std::memcpy(notif.payload, body, hdr.len);
+
+    return UCS_OK;
+}
+
+nixl_status_t nixlUcxEngine::getCompactNotifs(nixl_compact_notif_t* notifs, size_t max_notifs,
+                                              size_t &num_notifs)
+{
+    if(!pthrOn) while(progress());
+
+    num_notifs = takeCompactList(compactMainList, notifs, max_notifs);
+
+    const std::lock_guard<std::mutex> lock(notifMtx);
+    num_notifs += takeCompactList(compactPthr, notifs + num_notifs, max_notifs - num_notifs);
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlUcxEngine::genCompactNotif(const std::string &remote_agent, uint64_t tag,
+                                             const void* payload, size_t len) const
+{
+    nixl_status_t ret;
+    nixlUcxReq req;
+    size_t wid = getWorkerId();
+
+    if (len > compact_notif_max_payload)
+        return NIXL_ERR_INVALID_PARAM;
+
+    ret = notifCompactSendPriv(remote_agent, tag, payload, len, req, wid);
+
+    switch(ret) {
+    case NIXL_IN_PROG:
+        /* do not track the request */
+        getWorker(wid)->reqRelease(req);
+    case NIXL_SUCCESS:
+        break;
+    default:
+        /* error case */
+        return ret;
+    }
+    return NIXL_SUCCESS;
+}
@@ -17,6 +17,8 @@
 #ifndef NIXL_SRC_PLUGINS_UCX_UCX_BACKEND_H
 #define NIXL_SRC_PLUGINS_UCX_UCX_BACKEND_H
 
+#include <deque>
+#include <unordered_set>
 #include <vector>
 #include <cstring>
 #include <iostream>
@@ -37,7 +39,10 @@
 #include "ucx/ucx_utils.h"
 #include "common/list_elem.h"
 
-enum ucx_cb_op_t {CONN_CHECK, NOTIF_STR, DISCONNECT};
+enum ucx_cb_op_t {CONN_CHECK, NOTIF_STR, DISCONNECT, NOTIF_COMPACT};
+
+// What registration does to the pages of a FILE_SEG range before remote agents access them
+enum class nixl_ucx_file_residency_t {NONE, PREFAULT, LOCK};
 
 class nixlUcxConnection : public nixlBackendConnMD {
     private:
@@ -60,6 +65,12 @@ class nixlUcxPrivateMetadata : public nixlBackendMD {
         nixlUcxMem mem;
         nixl_blob_t rkeyStr;
 
+        // Mapping of a FILE_SEG range, the address of a file offset is addrBase + offset
+        void *mapAddr = nullptr;
+        size_t mapLen = 0;
+        uint64_t addrBase = 0;
+        size_t fileLen = 0;  // Length of the range from its offset, resolved for zero lengths
+
     public:
         nixlUcxPrivateMetadata() : nixlBackendMD(true) {
         }
@@ -75,6 +86,8 @@ class nixlUcxPrivateMetadata : public nixlBackendMD {
 class nixlUcxPublicMetadata : public nixlBackendMD {
     private:
         std::vector<nixlUcxRkey> rkeys;
+        // Translates the file offsets of a remote FILE_SEG range to addresses
+        uint64_t addrBase = 0;
     public:
         ucx_connection_ptr_t conn;
 
@@ -128,11 +141,24 @@ class nixlUcxEngine
         notif_list_t notifMainList;
         std::mutex  notifMtx;
         notif_list_t notifPthrPriv, notifPthr;
+        // Takes notifications before they are queued, e.g. for agent subscriptions
+        nixl_notif_handler_t notifHandler;
+
+        /* Compact notifications, in lists that keep their capacity */
+        std::vector<nixl_compact_notif_t> compactMainList;
+        std::vector<nixl_compact_notif_t> compactPthrPriv, compactPthr;
+        // Names of the agents that sent compact notifications, referenced by them
+        std::deque<std::string> compactAgentNames;
+        std::unordered_set<std::string_view> compactAgents;
+        size_t maxAmHeader = 0;
 
         // Map of agent name to saved nixlUcxConnection info
         std::unordered_map<std::string, ucx_connection_ptr_t,
                            std::hash<std::string>, strEqual> remoteConnMap;
 
+        /* File registration */
+        bool fileReg = false;
+        nixl_ucx_file_residency_t fileResidency = nixl_ucx_file_residency_t::NONE;
 
         void vramInitCtx();
         void vramFiniCtx();
@@ -166,6 +192,8 @@ class nixlUcxEngine
         nixl_status_t internalMDHelper (const nixl_blob_t &blob,
                                         const std::string &agent,
                                         nixlBackendMD* &output);
+        nixl_status_t fileMap(const nixlBlobDesc &mem, nixlUcxPrivateMetadata &priv,
+                              void* &addr, size_t &len, bool &read_only) const;
 
         // Notifications
         static ucs_status_t notifAmCb(void *arg, const void *header,
@@ -176,9 +204,18 @@ class nixlUcxEngine
                                     const std::string &msg,
                                     nixlUcxReq &req,
                                     size_t worker_id) const;
+        static ucs_status_t notifCompactAmCb(void *arg, const void *header,
+                                             size_t header_length, void *data,
+                                             size_t length,
+                                             const ucp_am_recv_param_t *param);
+        nixl_status_t notifCompactSendPriv(const std::string &remote_agent,
+                                           uint64_t tag, const void *payload, size_t len,
+                                           nixlUcxReq &req, size_t worker_id) const;
         void notifProgress();
         void notifProgressCombineHelper(notif_list_t &src, notif_list_t &tgt);
 
+        nixl_status_t checkXferPriv(nixlBackendReqH* handle, bool progress) const;
+
     public:
         nixlUcxEngine(const nixlBackendInitParams* init_params);
         ~nixlUcxEngine();
@@ -186,9 +223,11 @@ class nixlUcxEngine
         bool supportsRemote() const override { return true; }
         bool supportsLocal() const override { return true; }
         bool supportsNotif() const override { return true; }
+        bool supportsCompactNotif() const override { return true; }
         bool supportsProgTh() const override { return pthrOn; }
 
         nixl_mem_list_t getSupportedMems() const override;
+        size_t getRegLen(const nixlBackendMD* meta) const override;
 
         /* Object management */
         nixl_status_t getPublicData (const nixlBackendMD* meta,
@@ -240,12 +279,19 @@ class nixlUcxEngine
                                 const nixl_opt_b_args_t* opt_args=nullptr) const override;
 
         nixl_status_t checkXfer (nixlBackendReqH* handle) const override;
+        nixl_status_t checkXfers (const std::vector<nixlBackendReqH*> &handles,
+                                  std::vector<nixl_status_t> &status) const override;
         nixl_status_t releaseReqH(nixlBackendReqH* handle) const override;
 
         int progress() override;
 
         nixl_status_t getNotifs(notif_list_t &notif_list);
         nixl_status_t genNotif(const std::string &remote_agent, const std::string &msg) const override;
+        nixl_status_t getCompactNotifs(nixl_compact_notif_t* notifs, size_t max_notifs,
+                                       size_t &num_notifs) override;
+        nixl_status_t genCompactNotif(const std::string &remote_agent, uint64_t tag,
+                                      const void* payload, size_t len) const override;
+        nixl_status_t setNotifHandler(nixl_notif_handler_t handler) override;
 
         //public function for UCX worker to mark connections as connected
         nixl_status_t checkConn(const std::string &remote_agent);
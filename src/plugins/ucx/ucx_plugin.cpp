@@ -44,7 +44,10 @@ namespace
    }
 
    [[nodiscard]] nixl_b_params_t get_backend_options() {
-       return get_ucx_backend_common_options();
+       nixl_b_params_t params = get_ucx_backend_common_options();
+       params["file_registration"] = "false"; // or "true", to register FILE_SEG
+       params["file_residency"] = "none"; // or "prefault", "lock"
+       return params;
    }
 
    [[nodiscard]] nixl_mem_list_t get_backend_mems() {
@@ -773,3 +773,23 @@ nixlUcxMoEngine::genNotif(const string &remote_agent, const string &msg) const
 {
     return engines[0]->genNotif(getEngName(remote_agent, 0), msg);
 }
+
+nixl_status_t
+nixlUcxMoEngine::getCompactNotifs(nixl_compact_notif_t* notifs, size_t max_notifs,
+                                  size_t &num_notifs)
+{
+    return engines[0]->getCompactNotifs(notifs, max_notifs, num_notifs);
+}
+
+nixl_status_t
+nixlUcxMoEngine::genCompactNotif(const string &remote_agent, uint64_t tag,
+                                 const void* payload, size_t len) const
+{
+    return engines[0]->genCompactNotif(getEngName(remote_agent, 0), tag, payload, len);
+}
+
+nixl_status_t
+nixlUcxMoEngine::setNotifHandler(nixl_notif_handler_t handler)
+{
+    return engines[0]->setNotifHandler(std::move(handler));
+}
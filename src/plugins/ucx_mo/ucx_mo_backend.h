@@ -115,6 +115,7 @@ public:
     bool supportsRemote () const { return true; }
     bool supportsLocal  () const { return false; }
     bool supportsNotif  () const { return true; }
+    bool supportsCompactNotif () const { return true; }
     bool supportsProgTh () const { return pthrOn; }
 
     nixl_mem_list_t getSupportedMems () const;
@@ -164,6 +165,11 @@ public:
 
     nixl_status_t getNotifs(notif_list_t &notif_list);
     nixl_status_t genNotif(const std::string &remote_agent, const std::string &msg) const;
+    nixl_status_t getCompactNotifs(nixl_compact_notif_t* notifs, size_t max_notifs,
+                                   size_t &num_notifs);
+    nixl_status_t genCompactNotif(const std::string &remote_agent, uint64_t tag,
+                                  const void* payload, size_t len) const;
+    nixl_status_t setNotifHandler(nixl_notif_handler_t handler);
 
     //public function for UCX worker to mark connections as connected
     nixl_status_t checkConn(const std::string &remote_agent);
@@ -0,0 +1,1103 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "uring_tcp_backend.h"
+
+#include <arpa/inet.h>
+#include <ifaddrs.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "absl/strings/numbers.h"
+#include "common/nixl_log.h"
+
+// A connection, opened by this agent to send requests or accepted to serve a remote agent
+struct uringTcpConn {
+    int fd;
+    std::string agent;
+    bool outgoing;
+    uringTcpCtx recvCtx{uringTcpCtx::RECV, this};
+
+    // Receive side, the header of the current frame and then its payload
+    uringTcpHdr hdr;
+    size_t hdrFill = 0;
+    bool inPayload = false;
+    size_t payloadLeft = 0;
+    uint8_t *payloadDst = nullptr;
+    bool payloadToStr = false;
+    std::string payloadStr;
+
+    // Send side, one frame is sent at a time to keep the stream in order
+    std::deque<uringTcpFrame*> sendQueue;
+    bool sending = false;
+
+    // Operations answered on this connection
+    std::unordered_set<uint64_t> opIds;
+    // Submissions whose completions are still expected
+    size_t inflight = 0;
+    bool closing = false;
+};
+
+// A frame being sent: the header, followed by the payload either copied after it in buf or
+// sent from where it is with a zero-copy send
+struct uringTcpFrame {
+    uringTcpCtx ctx{uringTcpCtx::SEND, this};
+    uringTcpConn *conn = nullptr;
+    std::vector<uint8_t> buf;
+    const uint8_t *zcPayload = nullptr;
+    size_t zcLen = 0;
+    bool hasOp = false;
+    uint64_t opId = 0;
+
+    unsigned part = 0; // 0 while sending buf, 1 while sending zcPayload
+    size_t offset = 0;
+    unsigned zcNotifs = 0;
+    bool sent = false;
+};
+
+namespace {
+
+constexpr unsigned ring_entries = 1024;
+constexpr int buf_group = 0;
+constexpr int send_flags = MSG_NOSIGNAL;
+// Largest HELLO and NOTIF payloads, longer frames are protocol errors
+constexpr size_t hello_max_len = 4096;
+constexpr size_t notif_max_len = 16 * 1024 * 1024;
+
+uringTcpFrame *makeFrame(uring_tcp_op_t op, int32_t status, uint64_t id, uint64_t addr,
+                         uint64_t len, const void *payload = nullptr, bool zero_copy = false) {
+    auto *frame = new uringTcpFrame;
+    const uringTcpHdr hdr{static_cast<uint32_t>(op), status, id, addr, len};
+    const size_t copied = (payload && !zero_copy) ? len : 0;
+
+    frame->buf.resize(sizeof(hdr) + copied);
+    std::memcpy(frame->buf.data(), &hdr, sizeof(hdr));
+    if (copied)
+        std::memcpy(frame->buf.data() + sizeof(hdr), payload, copied);
+    if (payload && zero_copy && len) {
+        frame->zcPayload = static_cast<const uint8_t*>(payload);
+        frame->zcLen = len;
+    }
+    return frame;
+}
+
+bool sendAll(int fd, const void *data, size_t len) {
+    auto *ptr = static_cast<const uint8_t*>(data);
+    while (len) {
+        const ssize_t ret = ::send(fd, ptr, len, MSG_NOSIGNAL);
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret <= 0)
+            return false;
+        ptr += ret;
+        len -= ret;
+    }
+    return true;
+}
+
+void setNoDelay(int fd) {
+    const int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+// First non-loopback IPv4 address, for the connection info when no address is configured
+std::string defaultIpAddr() {
+    ifaddrs *ifas;
+    std::string ip = "127.0.0.1";
+    if (getifaddrs(&ifas) < 0)
+        return ip;
+
+    for (ifaddrs *ifa = ifas; ifa; ifa = ifa->ifa_next) {
+        if (!ifa->ifa_addr || ifa->ifa_addr->sa_family != AF_INET)
+            continue;
+        const auto *sin = reinterpret_cast<const sockaddr_in*>(ifa->ifa_addr);
+        if (ntohl(sin->sin_addr.s_addr) >> 24 == 127)
+            continue;
+        char buf[INET_ADDRSTRLEN];
+        if (inet_ntop(AF_INET, &sin->sin_addr, buf, sizeof(buf))) {
+            ip = buf;
+            break;
+        }
+    }
+    freeifaddrs(ifas);
+    return ip;
+}
+
+template<typename T>
+bool getSizeParam(const nixl_b_params_t &params, const std::string &key, T &value) {
+    const auto it = params.find(key);
+    if (it == params.end() || it->second.empty())
+        return true;
+    if (!absl::SimpleAtoi(it->second, &value) || value == 0) {
+        NIXL_ERROR << "Invalid value of " << key << ": " << it->second;
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+/****************************************
+ * Constructor/Destructor
+*****************************************/
+
+nixlUringTcpEngine::nixlUringTcpEngine(const nixlBackendInitParams *init_params)
+    : nixlBackendEngine(init_params) {
+    const nixl_b_params_t &params = *init_params->customParams;
+
+    const auto ip_it = params.find("ip_addr");
+    if (ip_it != params.end())
+        ipAddr = ip_it->second;
+
+    unsigned long listen_port = 0;
+    const auto port_it = params.find("port");
+    if (port_it != params.end() && !port_it->second.empty() &&
+        (!absl::SimpleAtoi(port_it->second, &listen_port) || listen_port > UINT16_MAX)) {
+        NIXL_ERROR << "Invalid port: " << port_it->second;
+        initErr = true;
+        return;
+    }
+    port = listen_port;
+
+    if (localAgent.size() > hello_max_len) {
+        NIXL_ERROR << "Agent name is longer than " << hello_max_len << " bytes";
+        initErr = true;
+        return;
+    }
+
+    if (!getSizeParam(params, "num_conns", numConns) ||
+        !getSizeParam(params, "chunk_size", chunkSize) ||
+        !getSizeParam(params, "zc_threshold", zcThreshold) ||
+        !getSizeParam(params, "num_bufs", numBufs) ||
+        !getSizeParam(params, "buf_size", bufSize)) {
+        initErr = true;
+        return;
+    }
+    // Provided buffer rings have a power of 2 number of entries
+    if ((numBufs & (numBufs - 1)) != 0 || numBufs > 32768) {
+        NIXL_ERROR << "num_bufs must be a power of 2 up to 32768: " << numBufs;
+        initErr = true;
+        return;
+    }
+
+    if (setupListener() != NIXL_SUCCESS || setupRing() != NIXL_SUCCESS) {
+        initErr = true;
+        return;
+    }
+
+    // Transfers to this agent go through the listening address
+    peerAddrs[localAgent] = ipAddr + ":" + std::to_string(port);
+
+    serviceThread = std::thread(&nixlUringTcpEngine::serviceLoop, this);
+}
+
+nixlUringTcpEngine::~nixlUringTcpEngine() {
+    if (serviceThread.joinable()) {
+        runCmd([this]() { stop = true; });
+        serviceThread.join();
+    }
+
+    if (wakeFd >= 0)
+        close(wakeFd);
+    if (listenFd >= 0)
+        close(listenFd);
+}
+
+nixl_status_t nixlUringTcpEngine::setupListener() {
+    listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        NIXL_PERROR << "Failed to create the listening socket";
+        return NIXL_ERR_BACKEND;
+    }
+
+    const int one = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    // Only the advertised address is listened on, not every interface of the host
+    if (ipAddr.empty())
+        ipAddr = defaultIpAddr();
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, ipAddr.c_str(), &addr.sin_addr) != 1) {
+        NIXL_ERROR << "Invalid IPv4 address: " << ipAddr;
+        return NIXL_ERR_INVALID_PARAM;
+    }
+
+    socklen_t len = sizeof(addr);
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        listen(listenFd, SOMAXCONN) < 0 ||
+        getsockname(listenFd, reinterpret_cast<sockaddr*>(&addr), &len) < 0) {
+        NIXL_PERROR << "Failed to listen on port " << port;
+        return NIXL_ERR_BACKEND;
+    }
+    port = ntohs(addr.sin_port);
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlUringTcpEngine::setupRing() {
+    wakeFd = eventfd(0, EFD_CLOEXEC);
+    if (wakeFd < 0) {
+        NIXL_PERROR << "Failed to create the wakeup eventfd";
+        return NIXL_ERR_BACKEND;
+    }
+
+    io_uring_params params{};
+    int ret = io_uring_queue_init_params(ring_entries, &ring, &params);
+    if (ret < 0) {
+        NIXL_ERROR << "Failed to initialize io_uring: " << strerror(-ret);
+        return NIXL_ERR_BACKEND;
+    }
+
+    // Zero-copy sends came with multishot receives, in Linux 6.0, provided buffer rings
+    // are checked by their setup below
+    io_uring_probe *probe = io_uring_get_probe_ring(&ring);
+    const bool send_zc = probe && io_uring_opcode_supported(probe, IORING_OP_SEND_ZC);
+    if (probe)
+        io_uring_free_probe(probe);
+    if (!send_zc) {
+        NIXL_ERROR << "io_uring of this kernel lacks zero-copy sends and multishot receives, "
+                   << "Linux 6.0 or newer is required";
+        io_uring_queue_exit(&ring);
+        return NIXL_ERR_NOT_SUPPORTED;
+    }
+
+    bufs.resize(size_t(numBufs) * bufSize);
+    bufRing = io_uring_setup_buf_ring(&ring, numBufs, buf_group, 0, &ret);
+    if (!bufRing) {
+        NIXL_ERROR << "Failed to set up the provided buffers: " << strerror(-ret);
+        io_uring_queue_exit(&ring);
+        return NIXL_ERR_BACKEND;
+    }
+    for (unsigned i = 0; i < numBufs; i++)
+        io_uring_buf_ring_add(bufRing, bufs.data() + i * bufSize, bufSize, i,
+                              io_uring_buf_ring_mask(numBufs), i);
+    io_uring_buf_ring_advance(bufRing, numBufs);
+    return NIXL_SUCCESS;
+}
+
+/****************************************
+ * Connection management
+*****************************************/
+
+nixl_status_t nixlUringTcpEngine::getConnInfo(std::string &str) const {
+    str = ipAddr + ":" + std::to_string(port);
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlUringTcpEngine::loadRemoteConnInfo(const std::string &remote_agent,
+                                                     const std::string &remote_conn_info) {
+    const std::lock_guard<std::mutex> lock(peersMutex);
+    peerAddrs[remote_agent] = remote_conn_info;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlUringTcpEngine::connect(const std::string &remote_agent) {
+    // Connections to this agent are opened by the first transfer that needs them
+    if (remote_agent == localAgent)
+        return NIXL_SUCCESS;
+    return openConns(remote_agent);
+}
+
+nixl_status_t nixlUringTcpEngine::disconnect(const std::string &remote_agent) {
+    {
+        const std::lock_guard<std::mutex> lock(peersMutex);
+        connectedPeers.erase(remote_agent);
+        if (remote_agent != localAgent)
+            peerAddrs.erase(remote_agent);
+    }
+
+    runCmd([this, remote_agent]() {
+        const auto it = peerConns.find(remote_agent);
+        if (it == peerConns.end())
+            return;
+        for (uringTcpConn *conn : std::vector<uringTcpConn*>(it->second))
+            closeConn(conn);
+    });
+    return NIXL_SUCCESS;
+}
+
+// Opens the connection pool to a remote agent, each connection starting with a HELLO
+nixl_status_t nixlUringTcpEngine::openConns(const std::string &remote_agent) const {
+    const std::lock_guard<std::mutex> lock(peersMutex);
+    if (connectedPeers.count(remote_agent))
+        return NIXL_SUCCESS;
+
+    const auto it = peerAddrs.find(remote_agent);
+    if (it == peerAddrs.end())
+        return NIXL_ERR_NOT_FOUND;
+
+    const std::string &info = it->second;
+    const size_t colon = info.rfind(':');
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    unsigned long remote_port;
+    if (colon == std::string::npos ||
+        inet_pton(AF_INET, info.substr(0, colon).c_str(), &addr.sin_addr) != 1 ||
+        !absl::SimpleAtoi(info.substr(colon + 1), &remote_port) || remote_port > UINT16_MAX) {
+        NIXL_ERROR << "Invalid connection info of " << remote_agent << ": " << info;
+        return NIXL_ERR_INVALID_PARAM;
+    }
+    addr.sin_port = htons(remote_port);
+
+    const uringTcpHdr hello{static_cast<uint32_t>(uring_tcp_op_t::HELLO), 0, 0, 0,
+                            localAgent.size()};
+    std::vector<int> fds;
+    for (size_t i = 0; i < numConns; i++) {
+        const int fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd >= 0)
+            fds.push_back(fd);
+        if (fd < 0 ||
+            ::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) < 0 ||
+            !sendAll(fd, &hello, sizeof(hello)) ||
+            !sendAll(fd, localAgent.data(), localAgent.size())) {
+            NIXL_PERROR << "Failed to connect to " << remote_agent << " at " << info;
+            for (int opened : fds)
+                close(opened);
+            return NIXL_ERR_BACKEND;
+        }
+        setNoDelay(fd);
+    }
+
+    connectedPeers.insert(remote_agent);
+    auto *engine = const_cast<nixlUringTcpEngine*>(this);
+    runCmd([engine, fds, remote_agent]() {
+        for (int fd : fds)
+            engine->addConn(fd, remote_agent, true);
+    });
+    return NIXL_SUCCESS;
+}
+
+void nixlUringTcpEngine::runCmd(std::function<void()> cmd) const {
+    bool wakeup;
+    {
+        const std::lock_guard<std::mutex> lock(cmdMutex);
+        // A non-empty queue has a wakeup pending already
+        wakeup = cmdQueue.empty();
+        cmdQueue.push_back(std::move(cmd));
+    }
+
+    if (wakeup) {
+        const uint64_t one = 1;
+        if (write(wakeFd, &one, sizeof(one)) != sizeof(one))
+            NIXL_PERROR << "Failed to wake up the service thread";
+    }
+}
+
+/****************************************
+ * Memory management
+*****************************************/
+
+nixl_status_t nixlUringTcpEngine::registerMem(const nixlBlobDesc &mem, const nixl_mem_t &nixl_mem,
+                                              nixlBackendMD* &out) {
+    if (nixl_mem != DRAM_SEG)
+        return NIXL_ERR_NOT_SUPPORTED;
+
+    const std::lock_guard<std::mutex> lock(regionsMutex);
+    regions.emplace(mem.addr, mem.len);
+    out = new nixlUringTcpMD(mem.addr, mem.len);
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlUringTcpEngine::deregisterMem(nixlBackendMD *meta) {
+    auto *md = static_cast<nixlUringTcpMD*>(meta);
+    {
+        const std::lock_guard<std::mutex> lock(regionsMutex);
+        auto [begin, end] = regions.equal_range(md->addr);
+        auto it = std::find_if(begin, end, [md](const auto &region) {
+            return region.second == md->len;
+        });
+        if (it != end)
+            regions.erase(it);
+    }
+    delete md;
+    return NIXL_SUCCESS;
+}
+
+// Remote agents can only access registered memory
+bool nixlUringTcpEngine::isRegistered(uint64_t addr, uint64_t len) const {
+    if (addr + len < addr)
+        return false;
+
+    const std::lock_guard<std::mutex> lock(regionsMutex);
+    for (auto it = regions.upper_bound(addr); it != regions.begin();) {
+        --it;
+        if (it->first + it->second >= addr + len)
+            return true;
+    }
+    return false;
+}
+
+// Targets check the addresses against their registrations, there is no metadata to share
+nixl_status_t nixlUringTcpEngine::getPublicData(const nixlBackendMD *meta,
+                                                std::string &str) const {
+    str.clear();
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlUringTcpEngine::loadLocalMD(nixlBackendMD *input, nixlBackendMD* &output) {
+    output = nullptr;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlUringTcpEngine::loadRemoteMD(const nixlBlobDesc &input,
+                                               const nixl_mem_t &nixl_mem,
+                                               const std::string &remote_agent,
+                                               nixlBackendMD* &output) {
+    output = nullptr;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlUringTcpEngine::unloadMD(nixlBackendMD *input) {
+    return NIXL_SUCCESS;
+}
+
+/****************************************
+ * Data movement
+*****************************************/
+
+nixl_status_t nixlUringTcpEngine::prepXfer(const nixl_xfer_op_t &operation,
+                                           const nixl_meta_dlist_t &local,
+                                           const nixl_meta_dlist_t &remote,
+                                           const std::string &remote_agent,
+                                           nixlBackendReqH* &handle,
+                                           const nixl_opt_b_args_t *opt_args) const {
+    if (operation != NIXL_READ && operation != NIXL_WRITE)
+        return NIXL_ERR_INVALID_PARAM;
+    if (local.descCount() != remote.descCount())
+        return NIXL_ERR_INVALID_PARAM;
+
+    handle = new nixlUringTcpReqH;
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlUringTcpEngine::postXfer(const nixl_xfer_op_t &operation,
+                                           const nixl_meta_dlist_t &local,
+                                           const nixl_meta_dlist_t &remote,
+                                           const std::string &remote_agent,
+                                           nixlBackendReqH* &handle,
+                                           const nixl_opt_b_args_t *opt_args) const {
+    auto *req = static_cast<nixlUringTcpReqH*>(handle);
+    if (req->xfer) {
+        const std::lock_guard<std::mutex> lock(req->xfer->complMutex);
+        if (req->xfer->status == NIXL_IN_PROG)
+            return NIXL_ERR_REPOST_ACTIVE;
+    }
+
+    const nixl_status_t ret = openConns(remote_agent);
+    if (ret != NIXL_SUCCESS)
+        return ret;
+
+    std::vector<std::pair<nixlBasicDesc, nixlBasicDesc>> descs;
+    descs.reserve(local.descCount());
+    for (int i = 0; i < local.descCount(); i++) {
+        if (local[i].len != remote[i].len)
+            return NIXL_ERR_INVALID_PARAM;
+        descs.emplace_back(local[i], remote[i]);
+    }
+
+    auto xfer = std::make_shared<uringTcpXfer>();
+    xfer->handle = handle;
+    xfer->remoteAgent = remote_agent;
+    if (opt_args && opt_args->hasNotif) {
+        if (opt_args->notifMsg.size() > notif_max_len)
+            return NIXL_ERR_INVALID_PARAM;
+        xfer->hasNotif = true;
+        xfer->notifMsg = opt_args->notifMsg;
+    }
+    req->xfer = xfer;
+
+    auto *engine = const_cast<nixlUringTcpEngine*>(this);
+    runCmd([engine, xfer, operation, descs = std::move(descs)]() mutable {
+        engine->postOps(xfer, operation, std::move(descs));
+    });
+    return NIXL_IN_PROG;
+}
+
+nixl_status_t nixlUringTcpEngine::checkXfer(nixlBackendReqH *handle) const {
+    const auto *req = static_cast<nixlUringTcpReqH*>(handle);
+    return req->xfer ? req->xfer->status.load() : NIXL_ERR_INVALID_PARAM;
+}
+
+nixl_status_t nixlUringTcpEngine::releaseReqH(nixlBackendReqH *handle) const {
+    // Pending operations keep the transfer state until they complete
+    auto *req = static_cast<nixlUringTcpReqH*>(handle);
+    if (req->xfer) {
+        const std::lock_guard<std::mutex> lock(req->xfer->complMutex);
+        req->xfer->handle = nullptr;
+    }
+    delete req;
+    return NIXL_SUCCESS;
+}
+
+/****************************************
+ * Notifications
+*****************************************/
+
+nixl_status_t nixlUringTcpEngine::getNotifs(notif_list_t &notif_list) {
+    if (!notif_list.empty())
+        return NIXL_ERR_INVALID_PARAM;
+
+    const std::lock_guard<std::mutex> lock(notifMutex);
+    notif_list.swap(notifList);
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlUringTcpEngine::genNotif(const std::string &remote_agent,
+                                           const std::string &msg) const {
+    if (msg.size() > notif_max_len)
+        return NIXL_ERR_INVALID_PARAM;
+
+    const nixl_status_t ret = openConns(remote_agent);
+    if (ret != NIXL_SUCCESS)
+        return ret;
+
+    auto *engine = const_cast<nixlUringTcpEngine*>(this);
+    runCmd([engine, remote_agent, msg]() { engine->sendNotif(remote_agent, msg); });
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlUringTcpEngine::setNotifHandler(nixl_notif_handler_t handler) {
+    notifHandler = std::move(handler);
+    return NIXL_SUCCESS;
+}
+
+nixl_status_t nixlUringTcpEngine::setXferComplHandler(nixl_xfer_compl_handler_t handler) {
+    complHandler = std::move(handler);
+    return NIXL_SUCCESS;
+}
+
+/****************************************
+ * Service thread
+*****************************************/
+
+void nixlUringTcpEngine::serviceLoop() {
+    armAccept();
+    armWakeup();
+
+    // After a stop, wait for the closed connections to complete their submissions
+    while (!stop || !conns.empty()) {
+        const int ret = io_uring_submit_and_wait(&ring, 1);
+        if (ret < 0 && ret != -EINTR) {
+            NIXL_ERROR << "io_uring wait failed: " << strerror(-ret);
+            break;
+        }
+
+        io_uring_cqe *cqe;
+        while (io_uring_peek_cqe(&ring, &cqe) == 0) {
+            const io_uring_cqe copy = *cqe;
+            io_uring_cqe_seen(&ring, cqe);
+            handleCqe(copy);
+        }
+
+        if (stop) {
+            for (auto &[fd, conn] : conns)
+                closeConn(conn.get());
+        }
+    }
+
+    for (auto &[fd, conn] : conns) {
+        for (uringTcpFrame *frame : conn->sendQueue)
+            delete frame;
+        close(fd);
+    }
+    conns.clear();
+    shutdown(listenFd, SHUT_RDWR);
+    io_uring_free_buf_ring(&ring, bufRing, numBufs, buf_group);
+    io_uring_queue_exit(&ring);
+}
+
+io_uring_sqe *nixlUringTcpEngine::getSqe() {
+    io_uring_sqe *sqe = io_uring_get_sqe(&ring);
+    while (!sqe) {
+        // The submission queue is full, hand it over to the kernel
+        io_uring_submit(&ring);
+        sqe = io_uring_get_sqe(&ring);
+    }
+    return sqe;
+}
+
+void nixlUringTcpEngine::armAccept() {
+    io_uring_sqe *sqe = getSqe();
+    io_uring_prep_multishot_accept(sqe, listenFd, nullptr, nullptr, 0);
+    io_uring_sqe_set_data(sqe, &acceptCtx);
+}
+
+void nixlUringTcpEngine::armWakeup() {
+    io_uring_sqe *sqe = getSqe();
+    io_uring_prep_read(sqe, wakeFd, &wakeVal, sizeof(wakeVal), 0);
+    io_uring_sqe_set_data(sqe, &wakeCtx);
+}
+
+void nixlUringTcpEngine::armRecv(uringTcpConn *conn) {
+    io_uring_sqe *sqe = getSqe();
+    io_uring_prep_recv_multishot(sqe, conn->fd, nullptr, 0, 0);
+    sqe->flags |= IOSQE_BUFFER_SELECT;
+    sqe->buf_group = buf_group;
+    io_uring_sqe_set_data(sqe, &conn->recvCtx);
+    conn->inflight++;
+}
+
+void nixlUringTcpEngine::handleCqe(const io_uring_cqe &cqe) {
+    auto *ctx = static_cast<uringTcpCtx*>(io_uring_cqe_get_data(&cqe));
+
+    switch (ctx->kind) {
+    case uringTcpCtx::ACCEPT:
+        if (cqe.res >= 0) {
+            setNoDelay(cqe.res);
+            addConn(cqe.res, "", false);
+        } else if (!stop) {
+            NIXL_ERROR << "Failed to accept a connection: " << strerror(-cqe.res);
+        }
+        if (!(cqe.flags & IORING_CQE_F_MORE) && !stop)
+            armAccept();
+        break;
+
+    case uringTcpCtx::WAKEUP: {
+        std::vector<std::function<void()>> cmds;
+        {
+            const std::lock_guard<std::mutex> lock(cmdMutex);
+            cmds.swap(cmdQueue);
+        }
+        for (auto &cmd : cmds)
+            cmd();
+        if (!stop)
+            armWakeup();
+        break;
+    }
+
+    case uringTcpCtx::RECV:
+        handleRecv(static_cast<uringTcpConn*>(ctx->obj), cqe);
+        break;
+
+    case uringTcpCtx::SEND:
+        handleSend(static_cast<uringTcpFrame*>(ctx->obj), cqe);
+        break;
+    }
+}
+
+void nixlUringTcpEngine::addConn(int fd, const std::string &agent, bool outgoing) {
+    auto conn = std::make_unique<uringTcpConn>();
+    conn->fd = fd;
+    conn->agent = agent;
+    conn->outgoing = outgoing;
+    if (outgoing)
+        peerConns[agent].push_back(conn.get());
+
+    armRecv(conn.get());
+    conns[fd] = std::move(conn);
+}
+
+// Stops using a connection, it is released once its submissions completed
+void nixlUringTcpEngine::closeConn(uringTcpConn *conn) {
+    if (conn->closing)
+        return;
+    conn->closing = true;
+    shutdown(conn->fd, SHUT_RDWR);
+
+    // Frames that were not submitted yet are dropped
+    while (conn->sendQueue.size() > (conn->sending ? 1 : 0)) {
+        delete conn->sendQueue.back();
+        conn->sendQueue.pop_back();
+    }
+
+    for (uint64_t id : std::vector<uint64_t>(conn->opIds.begin(), conn->opIds.end()))
+        opDone(id, true);
+
+    if (conn->outgoing) {
+        auto &pool = peerConns[conn->agent];
+        pool.erase(std::remove(pool.begin(), pool.end(), conn), pool.end());
+        if (pool.empty()) {
+            peerConns.erase(conn->agent);
+            const std::lock_guard<std::mutex> lock(peersMutex);
+            connectedPeers.erase(conn->agent);
+        }
+    }
+}
+
+void nixlUringTcpEngine::releaseConn(uringTcpConn *conn) {
+    for (uringTcpFrame *frame : conn->sendQueue)
+        delete frame;
+    close(conn->fd);
+    conns.erase(conn->fd);
+}
+
+void nixlUringTcpEngine::handleRecv(uringTcpConn *conn, const io_uring_cqe &cqe) {
+    const bool more = cqe.flags & IORING_CQE_F_MORE;
+    if (!more)
+        conn->inflight--;
+
+    if (cqe.res > 0) {
+        const unsigned bid = cqe.flags >> IORING_CQE_BUFFER_SHIFT;
+        uint8_t *buf = bufs.data() + size_t(bid) * bufSize;
+        consume(conn, buf, cqe.res);
+
+        // The data was consumed, the buffer goes back to the kernel right away
+        io_uring_buf_ring_add(bufRing, buf, bufSize, bid, io_uring_buf_ring_mask(numBufs), 0);
+        io_uring_buf_ring_advance(bufRing, 1);
+        if (!more && !conn->closing)
+            armRecv(conn);
+    } else if (cqe.res == -ENOBUFS) {
+        // All the buffers were in use when data arrived, they are back now
+        if (!more && !conn->closing)
+            armRecv(conn);
+    } else {
+        if (cqe.res < 0 && !conn->closing)
+            NIXL_ERROR << "Receive from " << conn->agent << " failed: " << strerror(-cqe.res);
+        closeConn(conn);
+    }
+
+    if (conn->closing && conn->inflight == 0)
+        releaseConn(conn);
+}
+
+/****************************************
+ * Frame parsing
+*****************************************/
+
+void nixlUringTcpEngine::consume(uringTcpConn *conn, const uint8_t *data, size_t len) {
+    while (len && !conn->closing) {
+        if (!conn->inPayload) {
+            const size_t take = std::min(len, sizeof(conn->hdr) - conn->hdrFill);
+            std::memcpy(reinterpret_cast<uint8_t*>(&conn->hdr) + conn->hdrFill, data, take);
+            conn->hdrFill += take;
+            data += take;
+            len -= take;
+            if (conn->hdrFill == sizeof(conn->hdr)) {
+                conn->hdrFill = 0;
+                startFrame(conn);
+            }
+            continue;
+        }
+
+        const size_t take = std::min(len, conn->payloadLeft);
+        if (conn->payloadDst) {
+            std::memcpy(conn->payloadDst, data, take);
+            conn->payloadDst += take;
+        } else if (conn->payloadToStr) {
+            conn->payloadStr.append(reinterpret_cast<const char*>(data), take);
+        }
+        data += take;
+        len -= take;
+        conn->payloadLeft -= take;
+        if (conn->payloadLeft == 0)
+            endFrame(conn);
+    }
+}
+
+// Sets up where the payload of a received header goes, a payload with nowhere to go is skipped
+void nixlUringTcpEngine::startFrame(uringTcpConn *conn) {
+    uringTcpHdr &hdr = conn->hdr;
+    size_t payload = 0;
+    conn->payloadDst = nullptr;
+    conn->payloadToStr = false;
+    conn->payloadStr.clear();
+
+    switch (static_cast<uring_tcp_op_t>(hdr.op)) {
+    case uring_tcp_op_t::HELLO:
+    case uring_tcp_op_t::NOTIF: {
+        const uring_tcp_op_t op = static_cast<uring_tcp_op_t>(hdr.op);
+        if (hdr.len > (op == uring_tcp_op_t::HELLO ? hello_max_len : notif_max_len)) {
+            NIXL_ERROR << "Frame " << hdr.op << " of " << hdr.len << " bytes from "
+                       << conn->agent << " is too long";
+            closeConn(conn);
+            return;
+        }
+        payload = hdr.len;
+        conn->payloadToStr = true;
+        break;
+    }
+
+    case uring_tcp_op_t::WRITE:
+        payload = hdr.len;
+        if (isRegistered(hdr.addr, hdr.len))
+            conn->payloadDst = reinterpret_cast<uint8_t*>(hdr.addr);
+        else
+            hdr.status = NIXL_ERR_INVALID_PARAM;
+        break;
+
+    case uring_tcp_op_t::READ_DATA: {
+        payload = hdr.len;
+        const auto it = ops.find(hdr.id);
+        if (it == ops.end() || hdr.status != NIXL_SUCCESS)
+            break;
+        if (it->second.len == hdr.len)
+            conn->payloadDst = it->second.localAddr;
+        else
+            hdr.status = NIXL_ERR_BACKEND;
+        break;
+    }
+
+    case uring_tcp_op_t::READ:
+    case uring_tcp_op_t::WRITE_ACK:
+        break;
+
+    default:
+        NIXL_ERROR << "Invalid frame " << hdr.op << " from " << conn->agent;
+        closeConn(conn);
+        return;
+    }
+
+    if (payload == 0) {
+        endFrame(conn);
+        return;
+    }
+    conn->inPayload = true;
+    conn->payloadLeft = payload;
+}
+
+void nixlUringTcpEngine::endFrame(uringTcpConn *conn) {
+    const uringTcpHdr &hdr = conn->hdr;
+    conn->inPayload = false;
+
+    switch (static_cast<uring_tcp_op_t>(hdr.op)) {
+    case uring_tcp_op_t::HELLO:
+        conn->agent = std::move(conn->payloadStr);
+        break;
+
+    case uring_tcp_op_t::NOTIF: {
+        nixl_blob_t msg = std::move(conn->payloadStr);
+        if (notifHandler && notifHandler(conn->agent, msg))
+            break;
+        const std::lock_guard<std::mutex> lock(notifMutex);
+        notifList.emplace_back(conn->agent, std::move(msg));
+        break;
+    }
+
+    case uring_tcp_op_t::WRITE:
+        queueFrame(conn, makeFrame(uring_tcp_op_t::WRITE_ACK, hdr.status, hdr.id, 0, 0));
+        break;
+
+    case uring_tcp_op_t::READ:
+        if (isRegistered(hdr.addr, hdr.len))
+            queueFrame(conn, makeFrame(uring_tcp_op_t::READ_DATA, NIXL_SUCCESS, hdr.id, 0,
+                                       hdr.len, reinterpret_cast<const void*>(hdr.addr),
+                                       hdr.len >= zcThreshold));
+        else
+            queueFrame(conn, makeFrame(uring_tcp_op_t::READ_DATA, NIXL_ERR_INVALID_PARAM,
+                                       hdr.id, 0, 0));
+        break;
+
+    case uring_tcp_op_t::READ_DATA:
+    case uring_tcp_op_t::WRITE_ACK:
+        opAnswered(hdr.id, hdr.status);
+        break;
+    }
+}
+
+/****************************************
+ * Frame sending
+*****************************************/
+
+void nixlUringTcpEngine::queueFrame(uringTcpConn *conn, uringTcpFrame *frame) {
+    if (conn->closing) {
+        delete frame;
+        return;
+    }
+    frame->conn = conn;
+    conn->sendQueue.push_back(frame);
+    sendNext(conn);
+}
+
+void nixlUringTcpEngine::sendNext(uringTcpConn *conn) {
+    if (conn->sending || conn->closing || conn->sendQueue.empty())
+        return;
+
+    uringTcpFrame *frame = conn->sendQueue.front();
+    io_uring_sqe *sqe = getSqe();
+    if (frame->part == 0)
+        io_uring_prep_send(sqe, conn->fd, frame->buf.data() + frame->offset,
+                           frame->buf.size() - frame->offset, send_flags);
+    else
+        io_uring_prep_send_zc(sqe, conn->fd, frame->zcPayload + frame->offset,
+                              frame->zcLen - frame->offset, send_flags, 0);
+    io_uring_sqe_set_data(sqe, &frame->ctx);
+    conn->sending = true;
+    conn->inflight++;
+}
+
+void nixlUringTcpEngine::handleSend(uringTcpFrame *frame, const io_uring_cqe &cqe) {
+    uringTcpConn *conn = frame->conn;
+
+    // Zero-copy sends complete twice: the result, then when the kernel released the data
+    if (cqe.flags & IORING_CQE_F_NOTIF) {
+        conn->inflight--;
+        if (--frame->zcNotifs == 0 && frame->sent)
+            freeFrame(frame);
+    } else {
+        if (cqe.flags & IORING_CQE_F_MORE)
+            frame->zcNotifs++;
+        else
+            conn->inflight--;
+        conn->sending = false;
+
+        const size_t part_len = frame->part == 0 ? frame->buf.size() : frame->zcLen;
+        if (cqe.res > 0)
+            frame->offset += cqe.res;
+
+        if (cqe.res <= 0 || conn->closing) {
+            if (!conn->closing)
+                NIXL_ERROR << "Send to " << conn->agent << " failed: "
+                           << strerror(cqe.res < 0 ? -cqe.res : EPIPE);
+            conn->sendQueue.pop_front();
+            frame->sent = true;
+            closeConn(conn);
+            if (frame->zcNotifs == 0)
+                freeFrame(frame);
+        } else if (frame->offset < part_len) {
+            sendNext(conn);
+        } else if (frame->part == 0 && frame->zcPayload) {
+            frame->part = 1;
+            frame->offset = 0;
+            sendNext(conn);
+        } else {
+            conn->sendQueue.pop_front();
+            frame->sent = true;
+            if (frame->zcNotifs == 0)
+                freeFrame(frame);
+            sendNext(conn);
+        }
+    }
+
+    if (conn->closing && conn->inflight == 0)
+        releaseConn(conn);
+}
+
+// The payload of a request may only be reused once its frame is freed
+void nixlUringTcpEngine::freeFrame(uringTcpFrame *frame) {
+    if (frame->hasOp)
+        opSent(frame->opId);
+    delete frame;
+}
+
+/****************************************
+ * Transfer operations
+*****************************************/
+
+// Splits the descriptors in chunks spread over the connections to the remote agent
+void nixlUringTcpEngine::postOps(const std::shared_ptr<uringTcpXfer> &xfer,
+                                 nixl_xfer_op_t operation,
+                                 std::vector<std::pair<nixlBasicDesc, nixlBasicDesc>> &&descs) {
+    const auto pool_it = peerConns.find(xfer->remoteAgent);
+    if (pool_it == peerConns.end() || pool_it->second.empty()) {
+        NIXL_ERROR << "No connection to " << xfer->remoteAgent;
+        xferDone(xfer, NIXL_ERR_BACKEND);
+        return;
+    }
+    const std::vector<uringTcpConn*> pool = pool_it->second;
+
+    for (const auto &[local, remote] : descs) {
+        for (size_t offset = 0; offset < local.len; offset += chunkSize) {
+            const size_t len = std::min(chunkSize, local.len - offset);
+            uringTcpConn *conn = pool[nextConn++ % pool.size()];
+            uint8_t *local_addr = reinterpret_cast<uint8_t*>(local.addr) + offset;
+            const uint64_t id = nextOpId++;
+
+            ops.emplace(id, pendingOp{xfer, conn, local_addr, len});
+            conn->opIds.insert(id);
+            xfer->pendingOps++;
+
+            uringTcpFrame *frame;
+            if (operation == NIXL_WRITE)
+                frame = makeFrame(uring_tcp_op_t::WRITE, NIXL_SUCCESS, id, remote.addr + offset,
+                                  len, local_addr, len >= zcThreshold);
+            else
+                frame = makeFrame(uring_tcp_op_t::READ, NIXL_SUCCESS, id, remote.addr + offset,
+                                  len);
+            frame->hasOp = true;
+            frame->opId = id;
+            queueFrame(conn, frame);
+        }
+    }
+
+    if (xfer->pendingOps == 0) {
+        if (xfer->hasNotif)
+            sendNotif(xfer->remoteAgent, xfer->notifMsg);
+        xferDone(xfer, NIXL_SUCCESS);
+    }
+}
+
+void nixlUringTcpEngine::opSent(uint64_t id) {
+    const auto it = ops.find(id);
+    if (it == ops.end())
+        return;
+    it->second.sent = true;
+    if (it->second.answered)
+        opDone(id, false);
+}
+
+void nixlUringTcpEngine::opAnswered(uint64_t id, int32_t status) {
+    const auto it = ops.find(id);
+    if (it == ops.end())
+        return;
+    if (status != NIXL_SUCCESS) {
+        NIXL_ERROR << "Transfer to " << it->second.xfer->remoteAgent << " failed: " << status;
+        opDone(id, true);
+        return;
+    }
+    it->second.answered = true;
+    if (it->second.sent)
+        opDone(id, false);
+}
+
+// The transfer completes with its last operation, and its notification follows the data
+void nixlUringTcpEngine::opDone(uint64_t id, bool failed) {
+    const auto it = ops.find(id);
+    if (it == ops.end())
+        return;
+
+    const std::shared_ptr<uringTcpXfer> xfer = it->second.xfer;
+    it->second.conn->opIds.erase(id);
+    ops.erase(it);
+
+    if (failed)
+        xfer->failed = true;
+    if (--xfer->pendingOps != 0)
+        return;
+
+    if (xfer->failed) {
+        xferDone(xfer, NIXL_ERR_BACKEND);
+        return;
+    }
+    if (xfer->hasNotif)
+        sendNotif(xfer->remoteAgent, xfer->notifMsg);
+    xferDone(xfer, NIXL_SUCCESS);
+}
+
+void nixlUringTcpEngine::xferDone(const std::shared_ptr<uringTcpXfer> &xfer,
+                                  nixl_status_t status) {
+    const std::lock_guard<std::mutex> lock(xfer->complMutex);
+    if (complHandler && xfer->handle)
+        complHandler(xfer->handle, status);
+    xfer->status = status;
+}
+
+void nixlUringTcpEngine::sendNotif(const std::string &remote_agent, const std::string &msg) {
+    const auto it = peerConns.find(remote_agent);
+    if (it == peerConns.end() || it->second.empty()) {
+        NIXL_ERROR << "No connection to send a notification to " << remote_agent;
+        return;
+    }
+    queueFrame(it->second.front(),
+               makeFrame(uring_tcp_op_t::NOTIF, NIXL_SUCCESS, 0, 0, msg.size(), msg.data()));
+}
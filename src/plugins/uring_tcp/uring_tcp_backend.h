@@ -0,0 +1,239 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NIXL_SRC_PLUGINS_URING_TCP_URING_TCP_BACKEND_H
+#define NIXL_SRC_PLUGINS_URING_TCP_URING_TCP_BACKEND_H
+
+#include <liburing.h>
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "nixl.h"
+#include "backend/backend_engine.h"
+
+// Frames exchanged on the connections, a header followed by len payload bytes for the
+// operations that carry data. Requests go from the initiator to the target on connections
+// the initiator opened, and the target answers on the same connection.
+enum class uring_tcp_op_t : uint32_t {
+    HELLO,     // Initiator name, first frame of a connection
+    WRITE,     // Data to store at addr, answered with WRITE_ACK
+    WRITE_ACK, // No payload, status of the WRITE
+    READ,      // No payload, asks for len bytes at addr, answered with READ_DATA
+    READ_DATA, // The bytes asked for, or no payload with an error status
+    NOTIF      // Notification message
+};
+
+struct uringTcpHdr {
+    uint32_t op;
+    int32_t status;
+    uint64_t id;
+    uint64_t addr;
+    uint64_t len;
+};
+
+static_assert(sizeof(uringTcpHdr) == 32, "Frame header must be packed");
+
+// State of a posted transfer, shared by the request handle and its pending operations
+struct uringTcpXfer {
+    std::atomic<nixl_status_t> status{NIXL_IN_PROG};
+    // The completion handler is called with the request handle before the status is set, under
+    // complMutex, so that the handle is not reposted or released before the handler returns
+    std::mutex complMutex;
+    nixlBackendReqH *handle = nullptr;
+    // Owned by the service thread
+    size_t pendingOps = 0;
+    bool failed = false;
+    std::string remoteAgent;
+    bool hasNotif = false;
+    std::string notifMsg;
+};
+
+class nixlUringTcpReqH : public nixlBackendReqH {
+public:
+    std::shared_ptr<uringTcpXfer> xfer;
+};
+
+class nixlUringTcpMD : public nixlBackendMD {
+public:
+    nixlUringTcpMD(uintptr_t addr, size_t len) : nixlBackendMD(true), addr(addr), len(len) {}
+
+    const uintptr_t addr;
+    const size_t len;
+};
+
+struct uringTcpConn;
+struct uringTcpFrame;
+
+// What a completion refers to, the user data of the submissions
+struct uringTcpCtx {
+    enum kind_t { ACCEPT, WAKEUP, RECV, SEND } kind;
+    void *obj = nullptr;
+};
+
+// Transfer between DRAM regions of two agents over TCP sockets driven by io_uring. A
+// service thread owns the ring: it accepts connections, receives with multishot receives
+// into provided buffers, sends large payloads with zero-copy sends and serves the requests of
+// remote agents. Application threads hand work over to it through a command queue.
+class nixlUringTcpEngine : public nixlBackendEngine {
+public:
+    nixlUringTcpEngine(const nixlBackendInitParams *init_params);
+    ~nixlUringTcpEngine();
+
+    bool supportsRemote() const override { return true; }
+    bool supportsLocal() const override { return true; }
+    bool supportsNotif() const override { return true; }
+    bool supportsProgTh() const override { return true; }
+
+    nixl_mem_list_t getSupportedMems() const override { return {DRAM_SEG}; }
+
+    nixl_status_t registerMem(const nixlBlobDesc &mem, const nixl_mem_t &nixl_mem,
+                              nixlBackendMD* &out) override;
+    nixl_status_t deregisterMem(nixlBackendMD *meta) override;
+
+    nixl_status_t getConnInfo(std::string &str) const override;
+    nixl_status_t loadRemoteConnInfo(const std::string &remote_agent,
+                                     const std::string &remote_conn_info) override;
+    nixl_status_t connect(const std::string &remote_agent) override;
+    nixl_status_t disconnect(const std::string &remote_agent) override;
+
+    nixl_status_t getPublicData(const nixlBackendMD *meta, std::string &str) const override;
+    nixl_status_t loadLocalMD(nixlBackendMD *input, nixlBackendMD* &output) override;
+    nixl_status_t loadRemoteMD(const nixlBlobDesc &input, const nixl_mem_t &nixl_mem,
+                               const std::string &remote_agent,
+                               nixlBackendMD* &output) override;
+    nixl_status_t unloadMD(nixlBackendMD *input) override;
+
+    nixl_status_t prepXfer(const nixl_xfer_op_t &operation, const nixl_meta_dlist_t &local,
+                           const nixl_meta_dlist_t &remote, const std::string &remote_agent,
+                           nixlBackendReqH* &handle,
+                           const nixl_opt_b_args_t *opt_args = nullptr) const override;
+    nixl_status_t postXfer(const nixl_xfer_op_t &operation, const nixl_meta_dlist_t &local,
+                           const nixl_meta_dlist_t &remote, const std::string &remote_agent,
+                           nixlBackendReqH* &handle,
+                           const nixl_opt_b_args_t *opt_args = nullptr) const override;
+    nixl_status_t checkXfer(nixlBackendReqH *handle) const override;
+    nixl_status_t releaseReqH(nixlBackendReqH *handle) const override;
+
+    nixl_status_t getNotifs(notif_list_t &notif_list) override;
+    nixl_status_t genNotif(const std::string &remote_agent, const std::string &msg) const override;
+    nixl_status_t setNotifHandler(nixl_notif_handler_t handler) override;
+    nixl_status_t setXferComplHandler(nixl_xfer_compl_handler_t handler) override;
+
+private:
+    // An operation waiting for the target, a chunk of a descriptor
+    struct pendingOp {
+        std::shared_ptr<uringTcpXfer> xfer;
+        uringTcpConn *conn;
+        uint8_t *localAddr; // Destination of READ_DATA
+        size_t len;
+        bool sent = false;     // The request, and its data for writes, left this agent
+        bool answered = false; // The target acknowledged the write or sent the data
+    };
+
+    /* Parameters */
+    std::string ipAddr;
+    size_t numConns = 2;
+    size_t chunkSize = 1 << 20;
+    size_t zcThreshold = 16 * 1024;
+    unsigned numBufs = 256;
+    size_t bufSize = 64 * 1024;
+
+    int listenFd = -1;
+    uint16_t port = 0;
+
+    /* Application side, protected by peersMutex */
+    mutable std::mutex peersMutex;
+    std::unordered_map<std::string, std::string> peerAddrs;
+    mutable std::unordered_set<std::string> connectedPeers;
+
+    /* Memory remote agents can access, protected by regionsMutex */
+    mutable std::mutex regionsMutex;
+    std::multimap<uintptr_t, size_t> regions;
+
+    /* Commands to the service thread */
+    mutable std::mutex cmdMutex;
+    mutable std::vector<std::function<void()>> cmdQueue;
+    int wakeFd = -1;
+
+    /* Notifications */
+    std::mutex notifMutex;
+    notif_list_t notifList;
+    nixl_notif_handler_t notifHandler;
+    nixl_xfer_compl_handler_t complHandler;
+
+    /* Service thread state */
+    io_uring ring;
+    io_uring_buf_ring *bufRing = nullptr;
+    std::vector<uint8_t> bufs;
+    uint64_t wakeVal;
+    uringTcpCtx acceptCtx{uringTcpCtx::ACCEPT};
+    uringTcpCtx wakeCtx{uringTcpCtx::WAKEUP};
+    std::unordered_map<int, std::unique_ptr<uringTcpConn>> conns;
+    std::unordered_map<std::string, std::vector<uringTcpConn*>> peerConns;
+    std::unordered_map<uint64_t, pendingOp> ops;
+    uint64_t nextOpId = 0;
+    size_t nextConn = 0;
+    bool stop = false;
+    std::thread serviceThread;
+
+    nixl_status_t setupListener();
+    nixl_status_t setupRing();
+    nixl_status_t openConns(const std::string &remote_agent) const;
+    void runCmd(std::function<void()> cmd) const;
+
+    void serviceLoop();
+    io_uring_sqe *getSqe();
+    void armAccept();
+    void armWakeup();
+    void armRecv(uringTcpConn *conn);
+    void handleCqe(const io_uring_cqe &cqe);
+    void handleRecv(uringTcpConn *conn, const io_uring_cqe &cqe);
+    void handleSend(uringTcpFrame *frame, const io_uring_cqe &cqe);
+
+    void addConn(int fd, const std::string &agent, bool outgoing);
+    void closeConn(uringTcpConn *conn);
+    void releaseConn(uringTcpConn *conn);
+
+    void consume(uringTcpConn *conn, const uint8_t *data, size_t len);
+    void startFrame(uringTcpConn *conn);
+    void endFrame(uringTcpConn *conn);
+    bool isRegistered(uint64_t addr, uint64_t len) const;
+
+    void queueFrame(uringTcpConn *conn, uringTcpFrame *frame);
+    void sendNext(uringTcpConn *conn);
+    void freeFrame(uringTcpFrame *frame);
+
+    void postOps(const std::shared_ptr<uringTcpXfer> &xfer, nixl_xfer_op_t operation,
+                 std::vector<std::pair<nixlBasicDesc, nixlBasicDesc>> &&descs);
+    void opSent(uint64_t id);
+    void opAnswered(uint64_t id, int32_t status);
+    void opDone(uint64_t id, bool failed);
+    void xferDone(const std::shared_ptr<uringTcpXfer> &xfer, nixl_status_t status);
+    void sendNotif(const std::string &remote_agent, const std::string &msg);
+};
+
+#endif // NIXL_SRC_PLUGINS_URING_TCP_URING_TCP_BACKEND_H
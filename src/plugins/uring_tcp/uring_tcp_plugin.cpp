@@ -0,0 +1,86 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "uring_tcp_backend.h"
+#include "backend/backend_plugin.h"
+
+// Function to create a new io_uring TCP backend engine instance
+static nixlBackendEngine* create_uring_tcp_engine(const nixlBackendInitParams* init_params) {
+    return new nixlUringTcpEngine(init_params);
+}
+
+static void destroy_uring_tcp_engine(nixlBackendEngine *engine) {
+    delete engine;
+}
+
+// Function to get the plugin name
+static const char* get_plugin_name() {
+    return "URING_TCP";
+}
+
+// Function to get the plugin version
+static const char* get_plugin_version() {
+    return "0.1.0";
+}
+
+// Function to get backend options
+static nixl_b_params_t get_backend_options() {
+    nixl_b_params_t params;
+    params["ip_addr"] = "";
+    params["port"] = "0";
+    params["num_conns"] = "2";
+    params["chunk_size"] = "1048576";
+    params["zc_threshold"] = "16384";
+    params["num_bufs"] = "256";
+    params["buf_size"] = "65536";
+    return params;
+}
+
+// Function to get supported backend mem types
+static nixl_mem_list_t get_backend_mems() {
+    return {DRAM_SEG};
+}
+
+// Static plugin structure
+static nixlBackendPlugin plugin = {
+    NIXL_PLUGIN_API_VERSION,
+    create_uring_tcp_engine,
+    destroy_uring_tcp_engine,
+    get_plugin_name,
+    get_plugin_version,
+    get_backend_options,
+    get_backend_mems
+};
+
+#ifdef STATIC_PLUGIN_URING_TCP
+
+nixlBackendPlugin* createStaticUringTcpPlugin() {
+    return &plugin; // Return the static plugin instance
+}
+
+#else
+
+// Plugin initialization function
+extern "C" NIXL_PLUGIN_EXPORT nixlBackendPlugin* nixl_plugin_init() {
+    return &plugin;
+}
+
+// Plugin cleanup function
+extern "C" NIXL_PLUGIN_EXPORT void nixl_plugin_fini() {
+}
+
+#endif
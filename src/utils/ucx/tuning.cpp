@@ -0,0 +1,159 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "tuning.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include <absl/strings/numbers.h>
+#include <absl/strings/str_format.h>
+
+#include "common/nixl_log.h"
+
+namespace nixl::ucx {
+namespace {
+    constexpr std::string_view ucx_prefix = "UCX_";
+}
+
+std::optional<configList>
+parseConfigList (const std::string &str) {
+    configList list;
+    std::istringstream stream (str);
+    std::string token;
+
+    while (stream >> token) {
+        const auto pos = token.find ('=');
+        if (pos == 0 || pos == std::string::npos) {
+            NIXL_ERROR << "Invalid UCX config entry, expected KEY=VALUE: " << token;
+            return std::nullopt;
+        }
+
+        std::string key = token.substr (0, pos);
+        if (key.rfind (ucx_prefix, 0) == 0) key.erase (0, ucx_prefix.size());
+        list.emplace_back (std::move (key), token.substr (pos + 1));
+    }
+
+    return list;
+}
+
+std::string
+formatConfigList (const configList &list) {
+    std::string str;
+    for (const auto &[key, value] : list) {
+        if (!str.empty()) str += ' ';
+        str += key + '=' + value;
+    }
+    return str;
+}
+
+std::optional<tuneProfile>
+tuneProfile::load (const std::string &path) {
+    std::ifstream file (path);
+    if (!file) {
+        NIXL_ERROR << "Failed to open UCX tuning profile " << path;
+        return std::nullopt;
+    }
+
+    tuneProfile profile;
+    std::string line;
+    for (size_t line_num = 1; std::getline (file, line); ++line_num) {
+        const auto comment = line.find ('#');
+        if (comment != std::string::npos) line.resize (comment);
+
+        std::istringstream stream (line);
+        std::string min_size, max_size, bandwidth;
+        if (!(stream >> min_size)) continue;
+
+        tuneEntry entry;
+        if (!(stream >> max_size >> bandwidth) || !absl::SimpleAtoi (min_size, &entry.minSize) ||
+            !absl::SimpleAtoi (max_size, &entry.maxSize) ||
+            !absl::SimpleAtod (bandwidth, &entry.bandwidth) || entry.minSize > entry.maxSize) {
+            NIXL_ERROR << absl::StrFormat (
+                "Invalid UCX tuning profile entry at %s:%d", path, line_num);
+            return std::nullopt;
+        }
+
+        std::string rest;
+        std::getline (stream, rest);
+        auto config = parseConfigList (rest);
+        if (!config) {
+            NIXL_ERROR << absl::StrFormat ("Invalid UCX config at %s:%d", path, line_num);
+            return std::nullopt;
+        }
+
+        entry.config = std::move (*config);
+        profile.addEntry (std::move (entry));
+    }
+
+    return profile;
+}
+
+bool
+tuneProfile::save (const std::string &path) const {
+    std::ofstream file (path, std::ios::trunc);
+    if (!file) {
+        NIXL_ERROR << "Failed to create UCX tuning profile " << path;
+        return false;
+    }
+
+    file << "# min_size max_size bandwidth_mbps [KEY=VALUE ...]\n";
+    for (const auto &entry : entries_) {
+        file << absl::StrFormat ("%d %d %.1f %s\n",
+                                 entry.minSize,
+                                 entry.maxSize,
+                                 entry.bandwidth,
+                                 formatConfigList (entry.config));
+    }
+
+    file.flush();
+    if (!file) {
+        NIXL_ERROR << "Failed to write UCX tuning profile " << path;
+        return false;
+    }
+    return true;
+}
+
+void
+tuneProfile::addEntry (tuneEntry entry) {
+    auto it = std::upper_bound (
+        entries_.begin(), entries_.end(), entry.minSize, [] (size_t size, const tuneEntry &e) {
+            return size < e.minSize;
+        });
+    entries_.insert (it, std::move (entry));
+}
+
+const tuneEntry *
+tuneProfile::lookup (size_t size) const noexcept {
+    const tuneEntry *best = nullptr;
+    size_t best_distance = 0;
+
+    for (const auto &entry : entries_) {
+        if (size >= entry.minSize && size <= entry.maxSize) return &entry;
+
+        const size_t distance =
+            size < entry.minSize ? entry.minSize - size : size - entry.maxSize;
+        if (!best || distance < best_distance) {
+            best = &entry;
+            best_distance = distance;
+        }
+    }
+
+    return best;
+}
+} // namespace nixl::ucx
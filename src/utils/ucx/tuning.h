@@ -0,0 +1,76 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NIXL_SRC_UTILS_UCX_TUNING_H
+#define NIXL_SRC_UTILS_UCX_TUNING_H
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace nixl::ucx {
+// UCX configuration keys and values, keys without the UCX_ prefix
+using configList = std::vector<std::pair<std::string, std::string>>;
+
+// Parse a whitespace separated list of KEY=VALUE pairs, the UCX_ prefix of keys is optional
+[[nodiscard]] std::optional<configList>
+parseConfigList (const std::string &str);
+
+[[nodiscard]] std::string
+formatConfigList (const configList &list);
+
+// Best UCX configuration found by calibration for messages in [minSize, maxSize]
+struct tuneEntry {
+    size_t minSize;
+    size_t maxSize;
+    double bandwidth; // MB/s measured during calibration
+    configList config;
+};
+
+// A set of tuned UCX configurations per message size range. Stored as a text file with
+// one entry per line: "<min_size> <max_size> <bandwidth> [KEY=VALUE ...]", '#' starts a
+// comment.
+class tuneProfile {
+public:
+    tuneProfile() = default;
+
+    [[nodiscard]] static std::optional<tuneProfile>
+    load (const std::string &path);
+
+    [[nodiscard]] bool
+    save (const std::string &path) const;
+
+    void
+    addEntry (tuneEntry entry);
+
+    // Entry whose range contains size, or the closest one if size is out of all ranges
+    [[nodiscard]] const tuneEntry *
+    lookup (size_t size) const noexcept;
+
+    [[nodiscard]] const std::vector<tuneEntry> &
+    getEntries() const noexcept {
+        return entries_;
+    }
+
+private:
+    std::vector<tuneEntry> entries_;
+};
+} // namespace nixl::ucx
+
+#endif
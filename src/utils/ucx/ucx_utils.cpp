@@ -343,7 +343,8 @@ nixlUcxContext::nixlUcxContext(std::vector<std::string> devs,
                                bool prog_thread,
                                ucp_err_handling_mode_t __err_handling_mode,
                                unsigned long num_workers,
-                               nixl_thread_sync_t sync_mode)
+                               nixl_thread_sync_t sync_mode,
+                               const nixl::ucx::configList &config_overrides)
 {
     ucp_params_t ucp_params;
 
@@ -406,6 +407,11 @@ nixlUcxContext::nixlUcxContext(std::vector<std::string> devs,
         config.modify ("MAX_RMA_RAILS", "2");
     }
 
+    // Tuned or user provided settings replace the defaults above, environment still wins
+    for (const auto &[key, value] : config_overrides) {
+        config.modify (key, value);
+    }
+
     const auto status = ucp_init (&ucp_params, config.getUcpConfig(), &ctx);
     if (status != UCS_OK) {
         throw std::runtime_error ("Failed to create UCX context: " +
@@ -496,7 +502,8 @@ absl::StatusOr<std::unique_ptr<nixlUcxEp>> nixlUcxWorker::connect(void* addr, st
  * =========================================== */
 
 
-int nixlUcxContext::memReg(void *addr, size_t size, nixlUcxMem &mem, nixl_mem_t nixl_mem_type)
+int nixlUcxContext::memReg(void *addr, size_t size, nixlUcxMem &mem, nixl_mem_t nixl_mem_type,
+                           bool read_only)
 {
     //mem.uw = this;
     mem.base = addr;
@@ -510,6 +517,12 @@ int nixlUcxContext::memReg(void *addr, size_t size, nixlUcxMem &mem, nixl_mem_t
         .length  = mem.size,
     };
 
+    // Pages mapped without write access can't be registered for remote writes
+    if (read_only) {
+        mem_params.field_mask |= UCP_MEM_MAP_PARAM_FIELD_PROT;
+        mem_params.prot = UCP_MEM_MAP_PROT_LOCAL_READ | UCP_MEM_MAP_PROT_REMOTE_READ;
+    }
+
     ucs_status_t status = ucp_mem_map(ctx, &mem_params, &mem.memh);
     if (status != UCS_OK) {
         /* TODOL: MSW_NET_ERROR(priv->net, "failed to ucp_mem_map (%s)\n", ucs_status_string(status)); */
@@ -29,6 +29,8 @@ extern "C"
 
 #include "absl/status/statusor.h"
 
+#include "tuning.h"
+
 enum class nixl_ucx_mt_t {
     SINGLE,
     CTX,
@@ -154,11 +156,13 @@ public:
     nixlUcxContext(std::vector<std::string> devices,
                    size_t req_size, req_cb_t init_cb, req_cb_t fini_cb,
                    bool prog_thread, ucp_err_handling_mode_t err_handling_mode,
-                   unsigned long num_workers, nixl_thread_sync_t sync_mode);
+                   unsigned long num_workers, nixl_thread_sync_t sync_mode,
+                   const nixl::ucx::configList &config_overrides = {});
     ~nixlUcxContext();
 
     /* Memory management */
-    int memReg(void *addr, size_t size, nixlUcxMem &mem, nixl_mem_t nixl_mem_type);
+    int memReg(void *addr, size_t size, nixlUcxMem &mem, nixl_mem_t nixl_mem_type,
+               bool read_only = false);
     [[nodiscard]] std::string packRkey(nixlUcxMem &mem);
     void memDereg(nixlUcxMem &mem);
 
@@ -205,7 +209,10 @@ private:
     return {
         { "ucx_devices", "" },
         { "ucx_error_handling_mode", "none" }, // or "peer"
-        { "num_workers", "1" }
+        { "num_workers", "1" },
+        { "ucx_tune_profile", "" },
+        { "ucx_tune_size", "" },
+        { "ucx_config", "" }
     };
 }
 
@@ -0,0 +1,136 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <numeric>
+#include <vector>
+#include "nixl.h"
+
+namespace gtest {
+namespace layout {
+
+namespace {
+
+uintptr_t addrOf(std::vector<uint16_t> &buffer)
+{
+    return reinterpret_cast<uintptr_t>(buffer.data());
+}
+
+std::vector<uint16_t> iota(size_t count)
+{
+    std::vector<uint16_t> buffer(count);
+    std::iota(buffer.begin(), buffer.end(), 0);
+    return buffer;
+}
+
+} // namespace
+
+TEST(TensorLayout, ContiguousIsSingleDescriptor)
+{
+    auto src = iota(4 * 8 * 16);
+    std::vector<uint16_t> dst(src.size());
+    nixlTensorLayout src_layout(addrOf(src), 0, DRAM_SEG, 2, {4, 8, 16});
+    nixlTensorLayout dst_layout(addrOf(dst), 0, DRAM_SEG, 2, {4, 8, 16});
+
+    nixl_xfer_dlist_t src_descs(DRAM_SEG), dst_descs(DRAM_SEG);
+    ASSERT_EQ(nixlTensorLayout::toDescs(src_layout, dst_layout, src_descs, dst_descs),
+              NIXL_SUCCESS);
+    ASSERT_EQ(src_descs.descCount(), 1);
+    EXPECT_EQ(src_descs[0].len, src.size() * 2);
+    EXPECT_EQ(dst_descs[0].addr, addrOf(dst));
+}
+
+TEST(TensorLayout, HeadReshardIsOneRunPerToken)
+{
+    // Producer has 8 heads, consumer gets 2 of them: [tokens, heads, head_dim]
+    constexpr size_t tokens = 16, heads = 8, head_dim = 64;
+    constexpr size_t first_head = 2, num_heads = 2;
+    auto src = iota(tokens * heads * head_dim);
+    std::vector<uint16_t> dst(tokens * num_heads * head_dim, 0);
+
+    nixlTensorLayout src_layout(addrOf(src), 0, DRAM_SEG, 2, {tokens, heads, head_dim});
+    nixlTensorLayout src_view;
+    ASSERT_EQ(src_layout.slice(1, first_head, num_heads, src_view), NIXL_SUCCESS);
+    nixlTensorLayout dst_layout(addrOf(dst), 0, DRAM_SEG, 2, {tokens, num_heads, head_dim});
+
+    nixl_xfer_dlist_t src_descs(DRAM_SEG), dst_descs(DRAM_SEG);
+    ASSERT_EQ(nixlTensorLayout::toDescs(src_view, dst_layout, src_descs, dst_descs),
+              NIXL_SUCCESS);
+    EXPECT_EQ(src_descs.descCount(), (int)tokens);
+    EXPECT_EQ(src_descs[0].len, num_heads * head_dim * 2);
+
+    ASSERT_EQ(nixlTensorLayout::copy(src_view, dst_layout), NIXL_SUCCESS);
+    for (size_t t = 0; t < tokens; t++) {
+        for (size_t h = 0; h < num_heads; h++) {
+            for (size_t d = 0; d < head_dim; d++) {
+                ASSERT_EQ(dst[(t * num_heads + h) * head_dim + d],
+                          src[(t * heads + first_head + h) * head_dim + d]);
+            }
+        }
+    }
+}
+
+TEST(TensorLayout, PermutedCopy)
+{
+    // Source is [heads, tokens, head_dim], destination is [tokens, heads, head_dim]
+    constexpr size_t tokens = 5, heads = 3, head_dim = 4;
+    auto src = iota(heads * tokens * head_dim);
+    std::vector<uint16_t> dst(src.size(), 0);
+
+    nixlTensorLayout src_layout(addrOf(src), 0, DRAM_SEG, 2, {heads, tokens, head_dim});
+    nixlTensorLayout src_view;
+    ASSERT_EQ(src_layout.permute({1, 0, 2}, src_view), NIXL_SUCCESS);
+    nixlTensorLayout dst_layout(addrOf(dst), 0, DRAM_SEG, 2, {tokens, heads, head_dim});
+
+    nixl_xfer_dlist_t src_descs(DRAM_SEG), dst_descs(DRAM_SEG);
+    ASSERT_EQ(nixlTensorLayout::toDescs(src_view, dst_layout, src_descs, dst_descs),
+              NIXL_SUCCESS);
+    EXPECT_EQ(src_descs.descCount(), (int)(tokens * heads));
+
+    ASSERT_EQ(nixlTensorLayout::copy(src_view, dst_layout), NIXL_SUCCESS);
+    for (size_t t = 0; t < tokens; t++) {
+        for (size_t h = 0; h < heads; h++) {
+            for (size_t d = 0; d < head_dim; d++) {
+                ASSERT_EQ(dst[(t * heads + h) * head_dim + d],
+                          src[(h * tokens + t) * head_dim + d]);
+            }
+        }
+    }
+}
+
+TEST(TensorLayout, InvalidLayouts)
+{
+    auto src = iota(64);
+    std::vector<uint16_t> dst(64);
+    nixlTensorLayout src_layout(addrOf(src), 0, DRAM_SEG, 2, {8, 8});
+    nixlTensorLayout dst_layout(addrOf(dst), 0, DRAM_SEG, 2, {4, 16});
+    nixlTensorLayout view;
+
+    nixl_xfer_dlist_t src_descs(DRAM_SEG), dst_descs(DRAM_SEG);
+    EXPECT_EQ(nixlTensorLayout::toDescs(src_layout, dst_layout, src_descs, dst_descs),
+              NIXL_ERR_INVALID_PARAM);
+    EXPECT_EQ(src_layout.slice(0, 4, 5, view), NIXL_ERR_INVALID_PARAM);
+    EXPECT_EQ(src_layout.slice(2, 0, 1, view), NIXL_ERR_INVALID_PARAM);
+    EXPECT_EQ(src_layout.permute({0, 0}, view), NIXL_ERR_INVALID_PARAM);
+
+    nixlTensorLayout vram_layout(addrOf(dst), 0, VRAM_SEG, 2, {8, 8});
+    EXPECT_EQ(nixlTensorLayout::copy(src_layout, vram_layout), NIXL_ERR_NOT_SUPPORTED);
+}
+
+} // namespace layout
+} // namespace gtest
@@ -18,6 +18,7 @@
 #include <thread>
 #include <random>
 #include "nixl.h"
+#include "nixl_md_server.h"
 #include "common.h"
 
 namespace gtest {
@@ -489,5 +490,116 @@ TEST_F(MetadataExchangeTestFixture, LocalNonLocalMDExchange)
     ASSERT_EQ("agent_0", remote_name);
 }
 
+class MDServerTestFixture : public MetadataExchangeTestFixture {
+protected:
+    void SetUp() override
+    {
+        server_ = std::make_unique<nixlMDServer>(0);
+        ASSERT_EQ(server_->start(), NIXL_SUCCESS);
+
+        // Agents take the server address when they are created
+        const std::string address = "127.0.0.1:" + std::to_string(server_->getPort());
+        setenv("NIXL_MD_SERVER", address.c_str(), 1);
+        MetadataExchangeTestFixture::SetUp();
+        unsetenv("NIXL_MD_SERVER");
+    }
+
+    void TearDown() override
+    {
+        MetadataExchangeTestFixture::TearDown();
+        server_.reset();
+    }
+
+    // Metadata goes through the comm threads, so its effects show up after a while
+    template<typename Pred> static bool waitFor(Pred pred)
+    {
+        for (int i = 0; i < 500; i++) {
+            if (pred()) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return false;
+    }
+
+    std::unique_ptr<nixlMDServer> server_;
+};
+
+TEST_F(MDServerTestFixture, SendFetchPushAndInvalidate)
+{
+    initAgentsDefault();
+
+    auto &src = agents_[0];
+    auto &dst = agents_[1];
+
+    // Fetching before the metadata is sent waits for it
+    ASSERT_EQ(dst.agent->fetchRemoteMD(src.name), NIXL_SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    ASSERT_EQ(dst.agent->checkRemoteMD(src.name, {DRAM_SEG}), NIXL_ERR_NOT_FOUND);
+
+    ASSERT_EQ(src.agent->sendLocalMD(), NIXL_SUCCESS);
+    ASSERT_TRUE(waitFor([&] {
+        return dst.agent->checkRemoteMD(src.name, {DRAM_SEG}) == NIXL_SUCCESS;
+    }));
+
+    // Updates are pushed to the agents that fetched the metadata
+    MemBuffer extra(1024);
+    nixl_reg_dlist_t extra_reg(DRAM_SEG);
+    extra_reg.addDesc(extra.getBlobDesc());
+    ASSERT_EQ(src.agent->registerMem(extra_reg), NIXL_SUCCESS);
+
+    nixl_xfer_dlist_t extra_descs(DRAM_SEG);
+    extra_descs.addDesc(extra.getBasicDesc());
+    ASSERT_EQ(dst.agent->checkRemoteMD(src.name, extra_descs), NIXL_ERR_NOT_FOUND);
+    ASSERT_EQ(src.agent->sendLocalMD(), NIXL_SUCCESS);
+    ASSERT_TRUE(waitFor([&] {
+        return dst.agent->checkRemoteMD(src.name, extra_descs) == NIXL_SUCCESS;
+    }));
+
+    ASSERT_EQ(src.agent->invalidateLocalMD(), NIXL_SUCCESS);
+    ASSERT_TRUE(waitFor([&] {
+        return dst.agent->checkRemoteMD(src.name, {DRAM_SEG}) == NIXL_ERR_NOT_FOUND;
+    }));
+
+    // A new generation after the invalidation is pushed again
+    ASSERT_EQ(src.agent->sendLocalMD(), NIXL_SUCCESS);
+    ASSERT_TRUE(waitFor([&] {
+        return dst.agent->checkRemoteMD(src.name, {DRAM_SEG}) == NIXL_SUCCESS;
+    }));
+
+    ASSERT_EQ(src.agent->deregisterMem(extra_reg), NIXL_SUCCESS);
+}
+
+TEST_F(MDServerTestFixture, PartialMetadataLabels)
+{
+    initAgentsDefault();
+
+    auto &src = agents_[0];
+    auto &dst = agents_[1];
+
+    nixl_opt_args_t args;
+    ASSERT_EQ(src.agent->sendLocalPartialMD({DRAM_SEG}, &args), NIXL_ERR_INVALID_PARAM);
+
+    args.metadataLabel = "conn_info";
+    ASSERT_EQ(src.agent->sendLocalPartialMD({DRAM_SEG}, &args), NIXL_SUCCESS);
+
+    nixl_reg_dlist_t descs(DRAM_SEG);
+    nixl_xfer_dlist_t xfer_descs(DRAM_SEG);
+    descs.addDesc(src.buffers[0].getBlobDesc());
+    xfer_descs.addDesc(src.buffers[0].getBasicDesc());
+    args.metadataLabel = "buffer_0";
+    ASSERT_EQ(src.agent->sendLocalPartialMD(descs, &args), NIXL_SUCCESS);
+
+    // Both labels are fetched in one batch, the connection info has to be loaded first
+    nixl_opt_args_t fetch_args;
+    fetch_args.metadataLabel = "conn_info";
+    ASSERT_EQ(dst.agent->fetchRemoteMD(src.name, &fetch_args), NIXL_SUCCESS);
+    fetch_args.metadataLabel = "buffer_0";
+    ASSERT_EQ(dst.agent->fetchRemoteMD(src.name, &fetch_args), NIXL_SUCCESS);
+    ASSERT_TRUE(waitFor([&] {
+        return dst.agent->checkRemoteMD(src.name, xfer_descs) == NIXL_SUCCESS;
+    }));
+}
+
 } // namespace metadata_exchange
 } // namespace gtest
@@ -0,0 +1,202 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mock_net_engine.h"
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+namespace mocks {
+
+namespace {
+
+class MockNetReqH : public nixlBackendReqH {
+public:
+  struct copy {
+    void *dst;
+    const void *src;
+    size_t len;
+  };
+
+  std::vector<copy> copies;
+  std::chrono::steady_clock::time_point deadline;
+  bool done = false;
+};
+
+class MockNetMD : public nixlBackendMD {
+public:
+  MockNetMD() : nixlBackendMD(true) {}
+};
+
+unsigned getParam(const nixl_b_params_t *params, const std::string &key) {
+  auto it = params->find(key);
+  return (it == params->end()) ? 0 : std::stoul(it->second);
+}
+
+} // namespace
+
+MockNetBackendEngine::MockNetBackendEngine(const nixlBackendInitParams *init_params)
+    : nixlBackendEngine(init_params) {
+  local.latency = std::chrono::microseconds(getParam(init_params->customParams, "latency_us"));
+  local.stall = std::chrono::microseconds(getParam(init_params->customParams, "stall_us"));
+  local.stallEvery = getParam(init_params->customParams, "stall_every");
+  links[localAgent] = local;
+}
+
+MockNetBackendEngine::~MockNetBackendEngine() {}
+
+std::chrono::microseconds MockNetBackendEngine::nextDelay(const std::string &remote_agent) const {
+  std::lock_guard<std::mutex> guard(linksLock);
+  auto it = links.find(remote_agent);
+  if (it == links.end())
+    return std::chrono::microseconds(0);
+
+  auto &l = it->second;
+  if (l.stallEvery > 0 && ++l.count % l.stallEvery == 0)
+    return l.latency + l.stall;
+  return l.latency;
+}
+
+nixl_status_t MockNetBackendEngine::registerMem(const nixlBlobDesc &mem, const nixl_mem_t &nixl_mem,
+                                                nixlBackendMD *&out) {
+  out = new MockNetMD();
+  return NIXL_SUCCESS;
+}
+
+nixl_status_t MockNetBackendEngine::deregisterMem(nixlBackendMD *meta) {
+  delete meta;
+  return NIXL_SUCCESS;
+}
+
+nixl_status_t MockNetBackendEngine::connect(const std::string &remote_agent) {
+  return NIXL_SUCCESS;
+}
+
+nixl_status_t MockNetBackendEngine::disconnect(const std::string &remote_agent) {
+  return NIXL_SUCCESS;
+}
+
+nixl_status_t MockNetBackendEngine::unloadMD(nixlBackendMD *input) {
+  delete input;
+  return NIXL_SUCCESS;
+}
+
+nixl_status_t MockNetBackendEngine::prepXfer(const nixl_xfer_op_t &operation,
+                                             const nixl_meta_dlist_t &local,
+                                             const nixl_meta_dlist_t &remote,
+                                             const std::string &remote_agent,
+                                             nixlBackendReqH *&handle,
+                                             const nixl_opt_b_args_t *opt_args) const {
+  handle = new MockNetReqH();
+  return NIXL_SUCCESS;
+}
+
+nixl_status_t MockNetBackendEngine::postXfer(const nixl_xfer_op_t &operation,
+                                             const nixl_meta_dlist_t &local,
+                                             const nixl_meta_dlist_t &remote,
+                                             const std::string &remote_agent,
+                                             nixlBackendReqH *&handle,
+                                             const nixl_opt_b_args_t *opt_args) const {
+  auto req = static_cast<MockNetReqH *>(handle);
+
+  // Agents share the process, so remote addresses can be accessed directly
+  req->copies.clear();
+  for (int i = 0; i < local.descCount(); i++) {
+    void *local_addr = reinterpret_cast<void *>(local[i].addr);
+    void *remote_addr = reinterpret_cast<void *>(remote[i].addr);
+    if (operation == NIXL_WRITE)
+      req->copies.push_back({remote_addr, local_addr, local[i].len});
+    else
+      req->copies.push_back({local_addr, remote_addr, local[i].len});
+  }
+
+  req->done = false;
+  req->deadline = std::chrono::steady_clock::now() + nextDelay(remote_agent);
+  return checkXfer(handle);
+}
+
+nixl_status_t MockNetBackendEngine::checkXfer(nixlBackendReqH *handle) const {
+  auto req = static_cast<MockNetReqH *>(handle);
+  if (req->done)
+    return NIXL_SUCCESS;
+  if (std::chrono::steady_clock::now() < req->deadline)
+    return NIXL_IN_PROG;
+
+  for (auto &c : req->copies)
+    std::memcpy(c.dst, c.src, c.len);
+  req->done = true;
+  return NIXL_SUCCESS;
+}
+
+nixl_status_t MockNetBackendEngine::releaseReqH(nixlBackendReqH *handle) const {
+  // Transfers in progress are canceled, as their data is only copied once done
+  delete handle;
+  return NIXL_SUCCESS;
+}
+
+nixl_status_t MockNetBackendEngine::getPublicData(const nixlBackendMD *meta,
+                                                  std::string &str) const {
+  str.clear();
+  return NIXL_SUCCESS;
+}
+
+nixl_status_t MockNetBackendEngine::getConnInfo(std::string &str) const {
+  str = std::to_string(local.latency.count()) + "," + std::to_string(local.stall.count()) +
+        "," + std::to_string(local.stallEvery);
+  return NIXL_SUCCESS;
+}
+
+nixl_status_t MockNetBackendEngine::loadRemoteConnInfo(const std::string &remote_agent,
+                                                       const std::string &remote_conn_info) {
+  std::istringstream info(remote_conn_info);
+  std::string latency, stall, stall_every;
+  if (!std::getline(info, latency, ',') || !std::getline(info, stall, ',') ||
+      !std::getline(info, stall_every))
+    return NIXL_ERR_INVALID_PARAM;
+
+  link l;
+  l.latency = std::chrono::microseconds(std::stoul(latency));
+  l.stall = std::chrono::microseconds(std::stoul(stall));
+  l.stallEvery = std::stoul(stall_every);
+
+  std::lock_guard<std::mutex> guard(linksLock);
+  links[remote_agent] = l;
+  return NIXL_SUCCESS;
+}
+
+nixl_status_t MockNetBackendEngine::loadRemoteMD(const nixlBlobDesc &input,
+                                                 const nixl_mem_t &nixl_mem,
+                                                 const std::string &remote_agent,
+                                                 nixlBackendMD *&output) {
+  output = new MockNetMD();
+  return NIXL_SUCCESS;
+}
+
+nixl_status_t MockNetBackendEngine::loadLocalMD(nixlBackendMD *input,
+                                                nixlBackendMD *&output) {
+  output = new MockNetMD();
+  return NIXL_SUCCESS;
+}
+
+nixl_status_t MockNetBackendEngine::getNotifs(notif_list_t &notif_list) {
+  return NIXL_SUCCESS;
+}
+
+nixl_status_t MockNetBackendEngine::genNotif(const std::string &remote_agent,
+                                             const std::string &msg) const {
+  return NIXL_ERR_NOT_SUPPORTED;
+}
+} // namespace mocks
@@ -0,0 +1,94 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TEST_GTEST_MOCKS_MOCK_NET_BACKEND_ENGINE_H
+#define TEST_GTEST_MOCKS_MOCK_NET_BACKEND_ENGINE_H
+
+#include "backend/backend_engine.h"
+#include "backend/backend_plugin.h"
+#include <chrono>
+#include <map>
+#include <mutex>
+
+namespace mocks {
+
+// DRAM backend for agents in the same process, which copies the data with the latency
+// of a network. Each engine emulates the latency of reaching its own memory, set through
+// the "latency_us" backend parameter, and passes it to the other agents in its connection
+// info. Every "stall_every" transfers to it, a transfer also stalls for "stall_us", as a
+// congested link or a slow storage target would.
+class MockNetBackendEngine : public nixlBackendEngine {
+public:
+  MockNetBackendEngine(const nixlBackendInitParams *init_params);
+  ~MockNetBackendEngine();
+
+  bool supportsRemote() const override { return true; }
+  bool supportsLocal() const override { return true; }
+  bool supportsNotif() const override { return false; }
+  bool supportsProgTh() const override { return false; }
+  nixl_mem_list_t getSupportedMems() const override { return nixl_mem_list_t{DRAM_SEG}; }
+
+  nixl_status_t registerMem(const nixlBlobDesc &mem, const nixl_mem_t &nixl_mem,
+                            nixlBackendMD *&out) override;
+  nixl_status_t deregisterMem(nixlBackendMD *meta) override;
+  nixl_status_t connect(const std::string &remote_agent) override;
+  nixl_status_t disconnect(const std::string &remote_agent) override;
+  nixl_status_t unloadMD(nixlBackendMD *input) override;
+  nixl_status_t prepXfer(const nixl_xfer_op_t &operation,
+                         const nixl_meta_dlist_t &local,
+                         const nixl_meta_dlist_t &remote,
+                         const std::string &remote_agent,
+                         nixlBackendReqH *&handle,
+                         const nixl_opt_b_args_t *opt_args) const override;
+  nixl_status_t postXfer(const nixl_xfer_op_t &operation,
+                         const nixl_meta_dlist_t &local,
+                         const nixl_meta_dlist_t &remote,
+                         const std::string &remote_agent,
+                         nixlBackendReqH *&handle,
+                         const nixl_opt_b_args_t *opt_args) const override;
+  nixl_status_t checkXfer(nixlBackendReqH *handle) const override;
+  nixl_status_t releaseReqH(nixlBackendReqH *handle) const override;
+  nixl_status_t getPublicData(const nixlBackendMD *meta, std::string &str) const override;
+  nixl_status_t getConnInfo(std::string &str) const override;
+  nixl_status_t loadRemoteConnInfo(const std::string &remote_agent,
+                                   const std::string &remote_conn_info) override;
+  nixl_status_t loadRemoteMD(const nixlBlobDesc &input,
+                             const nixl_mem_t &nixl_mem,
+                             const std::string &remote_agent,
+                             nixlBackendMD *&output) override;
+  nixl_status_t loadLocalMD(nixlBackendMD *input, nixlBackendMD *&output) override;
+  nixl_status_t getNotifs(notif_list_t &notif_list) override;
+  nixl_status_t genNotif(const std::string &remote_agent,
+                         const std::string &msg) const override;
+
+private:
+  struct link {
+    std::chrono::microseconds latency{0};
+    std::chrono::microseconds stall{0};
+    unsigned stallEvery = 0;
+    unsigned count = 0;
+  };
+
+  // Delay of the next transfer to an agent, counting it towards the stalls
+  std::chrono::microseconds nextDelay(const std::string &remote_agent) const;
+
+  link local;
+  mutable std::mutex linksLock;
+  mutable std::map<std::string, link> links;
+};
+} // namespace mocks
+
+#endif
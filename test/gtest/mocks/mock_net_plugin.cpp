@@ -0,0 +1,55 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mock_net_engine.h"
+
+namespace mocks {
+namespace net_plugin {
+
+static nixlBackendEngine *create_engine(const nixlBackendInitParams *params) {
+  return new MockNetBackendEngine(params);
+}
+
+static void destroy_engine(nixlBackendEngine *engine) { delete engine; }
+
+static const char *get_plugin_name() { return "MOCK_NET"; }
+
+static const char *get_plugin_version() { return "0.0.1"; }
+
+static nixl_b_params_t get_backend_options() {
+  return nixl_b_params_t{{"latency_us", "0"}, {"stall_us", "0"}, {"stall_every", "0"}};
+}
+
+static nixl_mem_list_t get_backend_mems() { return nixl_mem_list_t{DRAM_SEG}; }
+
+static nixlBackendPlugin plugin = {
+  NIXL_PLUGIN_API_VERSION,
+  create_engine,
+  destroy_engine,
+  get_plugin_name,
+  get_plugin_version,
+  get_backend_options,
+  get_backend_mems
+};
+} // namespace net_plugin
+
+} // namespace mocks
+
+extern "C" nixlBackendPlugin *nixl_plugin_init() {
+  return &mocks::net_plugin::plugin;
+}
+
+extern "C" void nixl_plugin_fini() {}
@@ -0,0 +1,251 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include "nixl.h"
+
+namespace gtest {
+namespace replica_xfer {
+
+using namespace std::chrono_literals;
+
+// Agents are connected through the MOCK_NET backend, which emulates the latency of
+// reaching each agent, and its stalls, to get slow and fast sources of the same data
+class ReplicaXferTest : public testing::Test {
+protected:
+    struct AgentContext {
+        std::unique_ptr<nixlAgent> agent;
+        std::string name;
+        std::vector<uint8_t> buffer;
+
+        AgentContext(const std::string &name) :
+            agent(std::make_unique<nixlAgent>(name, nixlAgentConfig(false))),
+            name(name), buffer(BUFF_SIZE_)
+        {
+        }
+
+        nixlBasicDesc getDesc() const
+        {
+            return nixlBasicDesc(reinterpret_cast<uintptr_t>(buffer.data()), buffer.size(), 0);
+        }
+    };
+
+    void SetUp() override
+    {
+        // Initiator, slow source, fast source, and fast source with periodic stalls
+        addAgent(0, 0, 0);
+        addAgent(SLOW_LATENCY_US_, 0, 0);
+        addAgent(FAST_LATENCY_US_, 0, 0);
+        addAgent(FAST_LATENCY_US_, STALL_US_, STALL_EVERY_);
+
+        for (size_t i = 1; i < agents_.size(); i++)
+            for (size_t j = 0; j < BUFF_SIZE_; j++)
+                agents_[i].buffer[j] = j % 251;
+
+        for (auto &src : agents_) {
+            std::string md;
+            ASSERT_EQ(src.agent->getLocalMD(md), NIXL_SUCCESS);
+            for (auto &dst : agents_) {
+                if (&dst == &src)
+                    continue;
+                std::string remote_name;
+                ASSERT_EQ(dst.agent->loadRemoteMD(md, remote_name), NIXL_SUCCESS);
+                ASSERT_EQ(remote_name, src.name);
+            }
+        }
+    }
+
+    void TearDown() override
+    {
+        agents_.clear();
+    }
+
+    void addAgent(unsigned latency_us, unsigned stall_us, unsigned stall_every)
+    {
+        agents_.emplace_back("agent_" + std::to_string(agents_.size()));
+        auto &ctx = agents_.back();
+
+        nixl_b_params_t params = {{"latency_us", std::to_string(latency_us)},
+                                  {"stall_us", std::to_string(stall_us)},
+                                  {"stall_every", std::to_string(stall_every)}};
+        nixlBackendH *backend = nullptr;
+        ASSERT_EQ(ctx.agent->createBackend("MOCK_NET", params, backend), NIXL_SUCCESS);
+
+        nixl_reg_dlist_t dlist(DRAM_SEG);
+        dlist.addDesc(nixlBlobDesc(ctx.getDesc(), ""));
+        ASSERT_EQ(ctx.agent->registerMem(dlist), NIXL_SUCCESS);
+    }
+
+    nixlReplicaXferReqH *createReq(nixl_xfer_op_t op, const std::vector<size_t> &remotes,
+                                   const nixl_opt_args_t &args)
+    {
+        nixl_xfer_dlist_t local(DRAM_SEG);
+        local.addDesc(agents_[0].getDesc());
+
+        std::vector<nixl_xfer_dlist_t> remote_descs;
+        std::vector<std::string> remote_agents;
+        for (auto idx : remotes) {
+            remote_descs.emplace_back(DRAM_SEG);
+            remote_descs.back().addDesc(agents_[idx].getDesc());
+            remote_agents.push_back(agents_[idx].name);
+        }
+
+        nixlReplicaXferReqH *req = nullptr;
+        EXPECT_EQ(initiator().createReplicaXferReq(op, local, remote_descs, remote_agents,
+                                                   req, &args), NIXL_SUCCESS);
+        return req;
+    }
+
+    // Posts the request and waits for it, returning how long it took
+    std::chrono::microseconds run(nixlReplicaXferReqH *req)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        nixl_status_t status = initiator().postReplicaXferReq(req);
+        while (status == NIXL_IN_PROG)
+            status = initiator().getReplicaXferStatus(req);
+        EXPECT_EQ(status, NIXL_SUCCESS);
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start);
+    }
+
+    size_t source(nixlReplicaXferReqH *req)
+    {
+        size_t src = SIZE_MAX;
+        EXPECT_EQ(initiator().getReplicaXferSource(req, src), NIXL_SUCCESS);
+        return src;
+    }
+
+    nixlAgent &initiator()
+    {
+        return *agents_[0].agent;
+    }
+
+    static constexpr size_t BUFF_SIZE_ = 64 * 1024;
+    static constexpr unsigned SLOW_LATENCY_US_ = 200000;
+    static constexpr unsigned FAST_LATENCY_US_ = 1000;
+    static constexpr unsigned STALL_US_ = 200000;
+    static constexpr unsigned STALL_EVERY_ = 16;
+
+    std::vector<AgentContext> agents_;
+};
+
+TEST_F(ReplicaXferTest, HedgedRead)
+{
+    nixl_opt_args_t args;
+    args.hedgeDelayUs = 5000;
+    auto req = createReq(NIXL_READ, {1, 2}, args);
+    ASSERT_NE(req, nullptr);
+
+    // The slow source is hedged, and skipped by the reposts while the read it lost is
+    // still in progress
+    for (int i = 0; i < 3; i++) {
+        std::fill(agents_[0].buffer.begin(), agents_[0].buffer.end(), 0);
+        EXPECT_LT(run(req), std::chrono::microseconds(SLOW_LATENCY_US_ / 2));
+        EXPECT_EQ(source(req), 1);
+        EXPECT_EQ(agents_[0].buffer, agents_[2].buffer);
+    }
+
+    // The release doesn't wait for the read that lost, which finishes into its staging
+    // buffer and is released by the next request, the local one is left alone
+    std::fill(agents_[0].buffer.begin(), agents_[0].buffer.end(), 0);
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(initiator().releaseReplicaXferReq(req), NIXL_SUCCESS);
+    EXPECT_LT(std::chrono::steady_clock::now() - start,
+              std::chrono::microseconds(SLOW_LATENCY_US_ / 2));
+    std::this_thread::sleep_for(std::chrono::microseconds(SLOW_LATENCY_US_));
+
+    // A fast primary source completes before the hedge delay
+    args.hedgeDelayUs = SLOW_LATENCY_US_;
+    req = createReq(NIXL_READ, {2, 1}, args);
+    EXPECT_EQ(agents_[0].buffer, std::vector<uint8_t>(BUFF_SIZE_, 0));
+    ASSERT_NE(req, nullptr);
+    run(req);
+    EXPECT_EQ(source(req), 0);
+    EXPECT_EQ(initiator().releaseReplicaXferReq(req), NIXL_SUCCESS);
+}
+
+TEST_F(ReplicaXferTest, PercentileHedgedRead)
+{
+    // The stalls are rarer than the percentile, so the hedge delay derived from the
+    // latencies of the source stays close to the latency without stalls
+    nixl_opt_args_t args;
+    args.hedgePercentile = 0.9;
+    auto req = createReq(NIXL_READ, {3, 2}, args);
+    ASSERT_NE(req, nullptr);
+
+    std::chrono::microseconds max_latency(0);
+    size_t hedged = 0;
+    for (size_t i = 0; i < 4 * STALL_EVERY_; i++) {
+        max_latency = std::max(max_latency, run(req));
+        hedged += source(req);
+    }
+    EXPECT_LT(max_latency, std::chrono::microseconds(STALL_US_ / 2));
+    EXPECT_GE(hedged, 4);
+    EXPECT_EQ(agents_[0].buffer, agents_[3].buffer);
+    EXPECT_EQ(initiator().releaseReplicaXferReq(req), NIXL_SUCCESS);
+}
+
+TEST_F(ReplicaXferTest, ReadFailover)
+{
+    nixl_opt_args_t args;
+    args.hedgeDelayUs = 10 * SLOW_LATENCY_US_;
+    auto req = createReq(NIXL_READ, {1, 2}, args);
+    ASSERT_NE(req, nullptr);
+
+    // The source that went away is skipped without waiting for the hedge delay
+    ASSERT_EQ(initiator().invalidateRemoteMD(agents_[1].name), NIXL_SUCCESS);
+    EXPECT_LT(run(req), std::chrono::microseconds(SLOW_LATENCY_US_));
+    EXPECT_EQ(source(req), 1);
+    EXPECT_EQ(agents_[0].buffer, agents_[2].buffer);
+    EXPECT_EQ(initiator().releaseReplicaXferReq(req), NIXL_SUCCESS);
+}
+
+TEST_F(ReplicaXferTest, QuorumWrite)
+{
+    for (size_t j = 0; j < BUFF_SIZE_; j++)
+        agents_[0].buffer[j] = j % 127;
+
+    nixl_opt_args_t args;
+    args.writeQuorum = 4;
+    nixl_xfer_dlist_t local(DRAM_SEG);
+    nixlReplicaXferReqH *req = nullptr;
+    std::vector<nixl_xfer_dlist_t> remote_descs(3, nixl_xfer_dlist_t(DRAM_SEG));
+    EXPECT_EQ(initiator().createReplicaXferReq(NIXL_WRITE, local, remote_descs,
+                                               {"agent_1", "agent_2", "agent_3"}, req, &args),
+              NIXL_ERR_INVALID_PARAM);
+
+    args.writeQuorum = 2;
+    req = createReq(NIXL_WRITE, {1, 2, 3}, args);
+    ASSERT_NE(req, nullptr);
+
+    // Done once the two fast targets have the data, the slow one is still in progress
+    EXPECT_LT(run(req), std::chrono::microseconds(SLOW_LATENCY_US_ / 2));
+    EXPECT_EQ(agents_[2].buffer, agents_[0].buffer);
+    EXPECT_EQ(agents_[3].buffer, agents_[0].buffer);
+    EXPECT_NE(agents_[1].buffer, agents_[0].buffer);
+    EXPECT_EQ(initiator().postReplicaXferReq(req), NIXL_ERR_REPOST_ACTIVE);
+
+    // The slow target is still progressed by the status checks
+    std::this_thread::sleep_for(std::chrono::microseconds(SLOW_LATENCY_US_));
+    EXPECT_EQ(initiator().getReplicaXferStatus(req), NIXL_SUCCESS);
+    EXPECT_EQ(agents_[1].buffer, agents_[0].buffer);
+    EXPECT_EQ(initiator().releaseReplicaXferReq(req), NIXL_SUCCESS);
+}
+
+} // namespace replica_xfer
+} // namespace gtest
@@ -24,12 +24,17 @@
 #include <absl/strings/str_format.h>
 #include <absl/time/clock.h>
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <memory>
+#include <unordered_map>
 #include <string>
 #include <thread>
 #include <vector>
 #include <thread>
 #include <mutex>
+#include <unistd.h>
 
 #ifdef HAVE_CUDA
 #include <cuda_runtime.h>
@@ -115,6 +120,10 @@ protected:
             params["num_workers"] = "2";
         }
 
+        if (getBackendName() == "UCX") {
+            params["file_registration"] = "true";
+        }
+
         return params;
     }
 
@@ -141,6 +150,34 @@ protected:
         agents.clear();
     }
 
+    void addAgents(size_t count)
+    {
+        // Extra agents without listener, metadata is exchanged with exchangeMD
+        while (count-- != 0) {
+            agents.emplace_back(std::make_unique<nixlAgent>(getAgentName(agents.size()),
+                                                            getConfig(0)));
+            nixlBackendH *backend_handle = nullptr;
+            nixl_status_t status = agents.back()->createBackend(
+                    getBackendName(), getBackendParams(), backend_handle);
+            ASSERT_EQ(status, NIXL_SUCCESS);
+        }
+    }
+
+    void addSharedAgents(size_t count, const std::string &instance)
+    {
+        // Agents attached to one backend instance, created by the first of them
+        nixl_b_params_t params = getBackendParams();
+        params["shared_instance"] = instance;
+        while (count-- != 0) {
+            agents.emplace_back(std::make_unique<nixlAgent>(getAgentName(agents.size()),
+                                                            getConfig(0)));
+            nixlBackendH *backend_handle = nullptr;
+            nixl_status_t status = agents.back()->createBackend(
+                    getBackendName(), params, backend_handle);
+            ASSERT_EQ(status, NIXL_SUCCESS);
+        }
+    }
+
     std::string getBackendName() const
     {
         return GetParam();
@@ -332,6 +369,234 @@ protected:
         invalidateMD();
     }
 
+    void
+    doCompactNotificationTest(nixlAgent &from,
+                              const std::string &from_name,
+                              nixlAgent &to,
+                              const std::string &to_name,
+                              size_t count) {
+        exchangeMD();
+
+        // Payload of every size, with the tag as content
+        for (size_t i = 0; i < count; ++i) {
+            std::vector<uint8_t> payload(i % (compact_notif_max_payload + 1), uint8_t(i));
+            nixl_status_t status =
+                    from.genCompactNotif(to_name, i, payload.data(), payload.size());
+            if (status == NIXL_ERR_NOT_SUPPORTED) {
+                invalidateMD();
+                GTEST_SKIP() << "Compact notifications are not supported";
+            }
+            ASSERT_EQ(status, NIXL_SUCCESS);
+        }
+        std::vector<uint8_t> too_long(compact_notif_max_payload + 1);
+        EXPECT_EQ(from.genCompactNotif(to_name, 0, too_long.data(), too_long.size()),
+                  NIXL_ERR_INVALID_PARAM);
+        ASSERT_EQ(from.genNotif(to_name, NOTIF_MSG), NIXL_SUCCESS);
+
+        // Fewer entries than notifications, the rest is returned by the next calls
+        std::vector<nixl_compact_notif_t> notifs(count / 4);
+        std::vector<bool> received(count, false);
+        size_t total = 0;
+        for (int i = 0; i < retry_count && total < count; i++) {
+            size_t num_notifs = 0;
+            ASSERT_EQ(to.getCompactNotifs(notifs.data(), notifs.size(), num_notifs),
+                      NIXL_SUCCESS);
+            ASSERT_LE(num_notifs, notifs.size());
+
+            for (size_t j = 0; j < num_notifs; ++j) {
+                const auto &notif = notifs[j];
+                EXPECT_EQ(notif.agent, from_name);
+                ASSERT_LT(notif.tag, count);
+                EXPECT_FALSE(received[notif.tag]);
+                received[notif.tag] = true;
+
+                EXPECT_EQ(notif.len, notif.tag % (compact_notif_max_payload + 1));
+                for (size_t k = 0; k < notif.len; ++k) {
+                    EXPECT_EQ(notif.payload[k], uint8_t(notif.tag));
+                }
+            }
+            total += num_notifs;
+            if (num_notifs == 0) {
+                std::this_thread::sleep_for(retry_timeout);
+            }
+        }
+        EXPECT_EQ(total, count);
+
+        // String notifications are received separately
+        verifyNotifs(to, from_name, 1);
+
+        invalidateMD();
+    }
+
+    void
+    doSubscribedNotificationTest(nixlAgent &from,
+                                 const std::string &from_name,
+                                 nixlAgent &to,
+                                 const std::string &to_name,
+                                 size_t repeat,
+                                 size_t num_streams) {
+        exchangeMD();
+
+        // One subscription per stream and a nested one, which takes the longest match
+        std::vector<nixlNotifSubH *> subs(num_streams + 1);
+        for (size_t i = 0; i < num_streams; ++i) {
+            ASSERT_EQ(to.subscribeNotifs(absl::StrFormat("stream%d|", i), subs[i]),
+                      NIXL_SUCCESS);
+        }
+        ASSERT_EQ(to.subscribeNotifs("stream0|nested|", subs[num_streams]), NIXL_SUCCESS);
+        nixlNotifSubH *dup_sub = nullptr;
+        EXPECT_EQ(to.subscribeNotifs("stream0|", dup_sub), NIXL_ERR_INVALID_PARAM);
+
+        std::vector<std::string> prefixes;
+        for (size_t i = 0; i < num_streams; ++i) {
+            prefixes.push_back(absl::StrFormat("stream%d|", i));
+        }
+        prefixes.push_back("stream0|nested|");
+
+        // Each stream is sent by a thread of its own, and consumed by a thread of its own
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i <= num_streams; ++i) {
+            threads.emplace_back([&, i]() {
+                for (size_t j = 0; j < repeat; ++j) {
+                    ASSERT_EQ(from.genNotif(to_name, prefixes[i] + std::to_string(j)),
+                              NIXL_SUCCESS);
+                }
+            });
+        }
+        threads.emplace_back([&]() {
+            for (size_t j = 0; j < repeat; ++j) {
+                ASSERT_EQ(from.genNotif(to_name, NOTIF_MSG), NIXL_SUCCESS);
+            }
+        });
+
+        std::vector<std::thread> consumers;
+        for (size_t i = 0; i <= num_streams; ++i) {
+            consumers.emplace_back([&, i]() {
+                nixl_notifs_t notif_map;
+                for (int k = 0; k < retry_count * 10; k++) {
+                    ASSERT_EQ(to.getSubNotifs(subs[i], notif_map), NIXL_SUCCESS);
+                    if (notif_map[from_name].size() >= repeat) {
+                        break;
+                    }
+                    std::this_thread::sleep_for(retry_timeout);
+                }
+
+                // Notifications of a stream keep the order they were sent in
+                auto &notif_list = notif_map[from_name];
+                ASSERT_EQ(notif_list.size(), repeat);
+                for (size_t j = 0; j < repeat; ++j) {
+                    EXPECT_EQ(notif_list[j], prefixes[i] + std::to_string(j));
+                }
+            });
+        }
+
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        // Notifications matching no subscription are received by getNotifs
+        verifyNotifs(to, from_name, repeat);
+
+        for (auto &consumer : consumers) {
+            consumer.join();
+        }
+
+        for (auto sub : subs) {
+            EXPECT_EQ(to.unsubscribeNotifs(sub), NIXL_SUCCESS);
+        }
+
+        // Without subscriptions, everything goes back to getNotifs
+        ASSERT_EQ(from.genNotif(to_name, prefixes[0] + "0"), NIXL_SUCCESS);
+        nixl_notifs_t notif_map;
+        for (int i = 0; i < retry_count && notif_map[from_name].empty(); i++) {
+            ASSERT_EQ(to.getNotifs(notif_map), NIXL_SUCCESS);
+            std::this_thread::sleep_for(retry_timeout);
+        }
+        ASSERT_EQ(notif_map[from_name].size(), 1u);
+        EXPECT_EQ(notif_map[from_name].front(), prefixes[0] + "0");
+
+        invalidateMD();
+    }
+
+    void doSharedBackendTest(size_t num_shared, size_t size)
+    {
+        const size_t first_shared = agents.size();
+        addSharedAgents(num_shared, "shared_test");
+
+        // Agent i writes a block of i + 1 bytes at offset i * size of each other agent
+        std::vector<std::vector<MemBuffer>> buffers(agents.size());
+        for (size_t i = 0; i < agents.size(); i++) {
+            createRegisteredMem(getAgent(i), size * agents.size(), 1, DRAM_SEG, buffers[i]);
+            std::memset(data(buffers[i][0]), int(i + 1), size * agents.size());
+        }
+        exchangeMD();
+
+        auto write = [&](size_t from, size_t to) {
+            nixl_xfer_dlist_t src(DRAM_SEG), dst(DRAM_SEG);
+            src.addDesc(nixlBasicDesc(buffers[from][0] + from * size, size, DEV_ID));
+            dst.addDesc(nixlBasicDesc(buffers[to][0] + from * size, size, DEV_ID));
+            std::memset(data(buffers[to][0]) + from * size, 0, size);
+
+            nixl_opt_args_t extra_params;
+            extra_params.hasNotif = true;
+            extra_params.notifMsg = NOTIF_MSG;
+            nixlXferReqH *xfer_req = nullptr;
+            ASSERT_EQ(getAgent(from).createXferReq(NIXL_WRITE, src, dst, getAgentName(to),
+                                                   xfer_req, &extra_params),
+                      NIXL_SUCCESS);
+            nixl_status_t status = getAgent(from).postXferReq(xfer_req);
+            ASSERT_TRUE((status == NIXL_SUCCESS) || (status == NIXL_IN_PROG));
+
+            // The notification comes from the sending agent, also on a shared instance
+            waitForXfer(getAgent(from), getAgentName(from), getAgent(to), xfer_req);
+            EXPECT_EQ(getAgent(from).releaseXferReq(xfer_req), NIXL_SUCCESS);
+
+            const uint8_t *block = data(buffers[to][0]) + from * size;
+            EXPECT_EQ(std::count(block, block + size, uint8_t(from + 1)), size);
+        };
+
+        for (size_t from = 0; from < agents.size(); from++) {
+            for (size_t to = 0; to < agents.size(); to++) {
+                if (from != to) {
+                    write(from, to);
+                }
+            }
+        }
+
+        // Agents with other thread settings than the instance's can't attach to it
+        nixlAgent other_sync("shared_other_sync",
+                             nixlAgentConfig(true, false, 0,
+                                             nixl_thread_sync_t::NIXL_THREAD_SYNC_NONE, 0,
+                                             100000));
+        nixl_b_params_t shared_params = getBackendParams();
+        shared_params["shared_instance"] = "shared_test";
+        nixlBackendH *other_handle = nullptr;
+        EXPECT_EQ(other_sync.createBackend(getBackendName(), shared_params, other_handle),
+                  NIXL_ERR_INVALID_PARAM);
+
+        // The instance stays with the other agents when the agent that created it leaves
+        for (size_t i = 0; i < agents.size(); i++) {
+            if (i != first_shared) {
+                EXPECT_EQ(getAgent(i).invalidateRemoteMD(getAgentName(first_shared)),
+                          NIXL_SUCCESS);
+            }
+        }
+        agents[first_shared].reset();
+        buffers[first_shared].clear();
+
+        for (size_t from = 0; from < agents.size(); from++) {
+            for (size_t to = first_shared + 1; to < agents.size(); to++) {
+                if (from != to && from != first_shared) {
+                    write(from, to);
+                    write(to, from);
+                }
+            }
+        }
+        ASSERT_EQ(getAgent(first_shared + 1).genNotif(getAgentName(first_shared + 1), NOTIF_MSG),
+                  NIXL_SUCCESS);
+        verifyNotifs(getAgent(first_shared + 1), getAgentName(first_shared + 1), 1);
+    }
+
     void doTransfer(nixlAgent &from, const std::string &from_name,
                     nixlAgent &to, const std::string &to_name, size_t size,
                     size_t count, size_t repeat, size_t num_threads,
@@ -398,6 +663,691 @@ protected:
         invalidateMD();
     }
 
+    void doMultiPeerTransfer(size_t num_peers, size_t num_blocks, size_t block_size)
+    {
+        std::vector<std::vector<MemBuffer>> buffers(num_peers + 1);
+        createRegisteredMem(getAgent(0), block_size * num_blocks, 1, DRAM_SEG, buffers[0]);
+        for (size_t i = 1; i <= num_peers; i++) {
+            createRegisteredMem(getAgent(i), block_size * num_blocks, 1, DRAM_SEG, buffers[i]);
+            std::memset(data(buffers[i][0]), 0, block_size * num_blocks);
+        }
+        exchangeMD();
+
+        // Scatter the blocks round-robin to the peers, each at the block's own offset
+        nixl_xfer_dlist_t local(DRAM_SEG), remote(DRAM_SEG);
+        std::vector<std::string> remote_agents;
+        for (size_t block = 0; block < num_blocks; block++) {
+            const size_t peer   = 1 + block % num_peers;
+            const size_t offset = block * block_size;
+            local.addDesc(nixlBasicDesc(buffers[0][0] + offset, block_size, DEV_ID));
+            remote.addDesc(nixlBasicDesc(buffers[peer][0] + offset, block_size, DEV_ID));
+            remote_agents.push_back(getAgentName(peer));
+            std::memset(data(buffers[0][0]) + offset, 'a' + block % 26, block_size);
+        }
+
+        nixl_opt_args_t extra_params;
+        extra_params.hasNotif = true;
+        extra_params.notifMsg = NOTIF_MSG;
+
+        nixlAgent &from = getAgent(0);
+        nixlMultiXferReqH *scatter = nullptr, *gather = nullptr;
+        ASSERT_EQ(from.createMultiXferReq(NIXL_WRITE, local, remote, remote_agents, scatter,
+                                          &extra_params),
+                  NIXL_SUCCESS);
+        ASSERT_EQ(from.createMultiXferReq(NIXL_READ, local, remote, remote_agents, gather),
+                  NIXL_SUCCESS);
+
+        nixl_status_t status = from.postMultiXferReq(scatter);
+        ASSERT_TRUE((status == NIXL_SUCCESS) || (status == NIXL_IN_PROG));
+        EXPECT_TRUE(wait_until_true(
+                [&]() { return from.getMultiXferStatus(scatter) == NIXL_SUCCESS; }));
+
+        // One notification per peer, each peer has only its own blocks
+        for (size_t i = 1; i <= num_peers; i++) {
+            verifyNotifs(getAgent(i), getAgentName(0), 1);
+        }
+        for (size_t block = 0; block < num_blocks; block++) {
+            const size_t peer   = 1 + block % num_peers;
+            const size_t offset = block * block_size;
+            EXPECT_EQ(std::memcmp(data(buffers[peer][0]) + offset,
+                                  data(buffers[0][0]) + offset, block_size), 0)
+                    << "Block " << block;
+        }
+
+        // Gather the blocks back into the cleared local buffer
+        std::vector<uint8_t> expected(data(buffers[0][0]),
+                                      data(buffers[0][0]) + block_size * num_blocks);
+        std::memset(data(buffers[0][0]), 0, block_size * num_blocks);
+
+        status = from.postMultiXferReq(gather);
+        ASSERT_TRUE((status == NIXL_SUCCESS) || (status == NIXL_IN_PROG));
+        EXPECT_TRUE(wait_until_true(
+                [&]() { return from.getMultiXferStatus(gather) == NIXL_SUCCESS; }));
+        EXPECT_EQ(std::memcmp(data(buffers[0][0]), expected.data(), expected.size()), 0);
+
+        EXPECT_EQ(from.releaseMultiXferReq(scatter), NIXL_SUCCESS);
+        EXPECT_EQ(from.releaseMultiXferReq(gather), NIXL_SUCCESS);
+        invalidateMD();
+    }
+
+    nixl_status_t waitForReg(nixlAgent &agent, nixlRegReqH *req)
+    {
+        nixl_status_t status;
+        wait_until_true([&]() {
+            status = agent.getRegStatus(req);
+            return status != NIXL_IN_PROG;
+        });
+        return status;
+    }
+
+    void doAsyncRegistration(size_t size, size_t count)
+    {
+        std::vector<std::vector<MemBuffer>> buffers(2);
+        std::vector<nixlRegReqH*> reg_reqs(2, nullptr);
+        for (size_t i = 0; i < 2; i++) {
+            for (size_t j = 0; j < count; j++) {
+                buffers[i].emplace_back(size, DRAM_SEG);
+            }
+            auto reg_list = makeDescList<nixlBlobDesc>(buffers[i], DRAM_SEG);
+            ASSERT_EQ(getAgent(i).registerMemAsync(reg_list, reg_reqs[i]), NIXL_SUCCESS);
+            ASSERT_NE(reg_reqs[i], nullptr);
+        }
+
+        // Both agents register concurrently, metadata is complete once both are done
+        for (size_t i = 0; i < 2; i++) {
+            EXPECT_EQ(waitForReg(getAgent(i), reg_reqs[i]), NIXL_SUCCESS);
+            EXPECT_EQ(getAgent(i).releaseRegReq(reg_reqs[i]), NIXL_SUCCESS);
+        }
+        exchangeMD();
+
+        for (size_t j = 0; j < count; j++) {
+            std::memset(data(buffers[0][j]), 'a' + j % 26, size);
+            std::memset(data(buffers[1][j]), 0, size);
+        }
+
+        nixl_opt_args_t extra_params;
+        extra_params.hasNotif = true;
+        extra_params.notifMsg = NOTIF_MSG;
+
+        nixlAgent &from = getAgent(0);
+        nixlXferReqH *xfer_req = nullptr;
+        ASSERT_EQ(from.createXferReq(NIXL_WRITE,
+                                     makeDescList<nixlBasicDesc>(buffers[0], DRAM_SEG),
+                                     makeDescList<nixlBasicDesc>(buffers[1], DRAM_SEG),
+                                     getAgentName(1), xfer_req, &extra_params),
+                  NIXL_SUCCESS);
+        nixl_status_t status = from.postXferReq(xfer_req);
+        ASSERT_TRUE((status == NIXL_SUCCESS) || (status == NIXL_IN_PROG));
+        waitForXfer(from, getAgentName(0), getAgent(1), xfer_req);
+        EXPECT_EQ(from.releaseXferReq(xfer_req), NIXL_SUCCESS);
+
+        for (size_t j = 0; j < count; j++) {
+            EXPECT_EQ(std::memcmp(data(buffers[0][j]), data(buffers[1][j]), size), 0)
+                    << "Buffer " << j;
+        }
+        invalidateMD();
+
+        for (size_t i = 0; i < 2; i++) {
+            auto reg_list = makeDescList<nixlBlobDesc>(buffers[i], DRAM_SEG);
+            nixlRegReqH *dereg_req = nullptr;
+            ASSERT_EQ(getAgent(i).deregisterMemAsync(reg_list, dereg_req), NIXL_SUCCESS);
+            EXPECT_EQ(getAgent(i).releaseRegReq(dereg_req), NIXL_SUCCESS);
+
+            // The regions are gone, deregistering them again fails
+            EXPECT_NE(getAgent(i).deregisterMem(reg_list), NIXL_SUCCESS);
+        }
+    }
+
+    // Agent 1 serves ranges of a tmpfs file registered as FILE_SEG, agent 0 reads them into
+    // its DRAM buffers and writes them back with another content
+    void doFileSegTest(size_t size, size_t count)
+    {
+        nixl_mem_list_t mems;
+        nixl_b_params_t params;
+        ASSERT_EQ(getAgent(1).getPluginParams(getBackendName(), mems, params), NIXL_SUCCESS);
+        if (std::find(mems.begin(), mems.end(), FILE_SEG) == mems.end() &&
+            !params.count("file_registration")) {
+            GTEST_SKIP() << getBackendName() << " does not support FILE_SEG";
+        }
+
+        char path[] = "/dev/shm/nixl_gtest_XXXXXX";
+        const int fd = mkstemp(path);
+        ASSERT_GE(fd, 0);
+        unlink(path);
+
+        // The ranges don't start at a page boundary
+        constexpr size_t offset = 512;
+        std::vector<char> content(offset + size * count);
+        for (size_t i = 0; i < content.size(); i++) {
+            content[i] = 'a' + i % 26;
+        }
+        ASSERT_EQ(pwrite(fd, content.data(), content.size(), 0), ssize_t(content.size()));
+
+        nixl_reg_dlist_t file_reg(FILE_SEG);
+        nixl_xfer_dlist_t file_descs(FILE_SEG);
+        for (size_t j = 0; j < count; j++) {
+            file_reg.addDesc(nixlBlobDesc(offset + j * size, size, fd));
+            file_descs.addDesc(nixlBasicDesc(offset + j * size, size, fd));
+        }
+        ASSERT_EQ(getAgent(1).registerMem(file_reg), NIXL_SUCCESS);
+
+        std::vector<MemBuffer> buffers;
+        createRegisteredMem(getAgent(0), size, count, DRAM_SEG, buffers);
+        exchangeMD();
+
+        nixl_opt_args_t extra_params;
+        extra_params.hasNotif = true;
+        extra_params.notifMsg = NOTIF_MSG;
+
+        nixlAgent &from = getAgent(0);
+        for (nixl_xfer_op_t op : {NIXL_READ, NIXL_WRITE}) {
+            for (size_t j = 0; j < count; j++) {
+                std::memset(data(buffers[j]), op == NIXL_READ ? 0 : 'A' + j, size);
+            }
+
+            nixlXferReqH *xfer_req = nullptr;
+            ASSERT_EQ(from.createXferReq(op, makeDescList<nixlBasicDesc>(buffers, DRAM_SEG),
+                                         file_descs, getAgentName(1), xfer_req, &extra_params),
+                      NIXL_SUCCESS);
+            nixl_status_t status = from.postXferReq(xfer_req);
+            ASSERT_TRUE((status == NIXL_SUCCESS) || (status == NIXL_IN_PROG));
+            waitForXfer(from, getAgentName(0), getAgent(1), xfer_req);
+            EXPECT_EQ(from.releaseXferReq(xfer_req), NIXL_SUCCESS);
+
+            // Reads got the file content, writes replaced it
+            for (size_t j = 0; j < count; j++) {
+                std::vector<char> file_range(size);
+                ASSERT_EQ(pread(fd, file_range.data(), size, offset + j * size), ssize_t(size));
+                EXPECT_EQ(std::memcmp(data(buffers[j]), file_range.data(), size), 0)
+                        << "Range " << j;
+            }
+        }
+
+        invalidateMD();
+        EXPECT_EQ(getAgent(1).deregisterMem(file_reg), NIXL_SUCCESS);
+        close(fd);
+    }
+
+    // Writes each buffer with its own request, all bound to one completion queue, and
+    // collects one completion per request and round
+    void doComplQueueTest(size_t size, size_t count, size_t repeat)
+    {
+        std::vector<MemBuffer> src_buffers, dst_buffers;
+        createRegisteredMem(getAgent(0), size, count, DRAM_SEG, src_buffers);
+        createRegisteredMem(getAgent(1), size, count, DRAM_SEG, dst_buffers);
+        exchangeMD();
+
+        nixlAgent &from = getAgent(0);
+        nixlComplQueueH *cq = nullptr;
+        ASSERT_EQ(from.createComplQueue(cq), NIXL_SUCCESS);
+        int fd = -1;
+        EXPECT_EQ(from.getComplQueueFd(cq, fd), NIXL_SUCCESS);
+        EXPECT_GE(fd, 0);
+
+        std::vector<nixlXferReqH*> reqs(count, nullptr);
+        for (size_t j = 0; j < count; j++) {
+            ASSERT_EQ(from.createXferReq(NIXL_WRITE,
+                                         makeDescList<nixlBasicDesc>({src_buffers[j]}, DRAM_SEG),
+                                         makeDescList<nixlBasicDesc>({dst_buffers[j]}, DRAM_SEG),
+                                         getAgentName(1), reqs[j]),
+                      NIXL_SUCCESS);
+            ASSERT_EQ(from.bindXferReq(reqs[j], cq), NIXL_SUCCESS);
+        }
+
+        for (size_t round = 0; round < repeat; round++) {
+            for (size_t j = 0; j < count; j++) {
+                std::memset(data(src_buffers[j]), 'a' + (round + j) % 26, size);
+                const nixl_status_t status = from.postXferReq(reqs[j]);
+                ASSERT_TRUE((status == NIXL_SUCCESS) || (status == NIXL_IN_PROG));
+            }
+
+            std::unordered_map<nixlXferReqH*, size_t> completed;
+            std::vector<nixl_xfer_compl_t> compls;
+            EXPECT_TRUE(wait_until_true([&]() {
+                from.waitCompletions(cq, std::chrono::milliseconds(10));
+                compls.clear();
+                EXPECT_EQ(from.pollCompletions(cq, compls), NIXL_SUCCESS);
+                for (const auto &compl_entry : compls) {
+                    EXPECT_EQ(compl_entry.status, NIXL_SUCCESS);
+                    EXPECT_EQ(from.getXferStatus(compl_entry.req), NIXL_SUCCESS);
+                    completed[compl_entry.req]++;
+                }
+                return completed.size() == count;
+            }));
+
+            for (size_t j = 0; j < count; j++) {
+                EXPECT_EQ(completed[reqs[j]], 1u) << "Request " << j;
+                EXPECT_EQ(std::memcmp(data(src_buffers[j]), data(dst_buffers[j]), size), 0)
+                        << "Buffer " << j;
+            }
+        }
+
+        // Nothing left, and unbound requests are no longer reported
+        std::vector<nixl_xfer_compl_t> compls;
+        EXPECT_EQ(from.waitCompletions(cq, std::chrono::milliseconds(1)), NIXL_IN_PROG);
+        ASSERT_EQ(from.bindXferReq(reqs[0], nullptr), NIXL_SUCCESS);
+        nixl_status_t status = from.postXferReq(reqs[0]);
+        ASSERT_TRUE((status == NIXL_SUCCESS) || (status == NIXL_IN_PROG));
+        EXPECT_TRUE(wait_until_true([&]() { return from.getXferStatus(reqs[0]) != NIXL_IN_PROG; }));
+        EXPECT_EQ(from.pollCompletions(cq, compls), NIXL_SUCCESS);
+        EXPECT_TRUE(compls.empty());
+
+        // Releasing the queue unbinds the other requests
+        EXPECT_EQ(from.releaseComplQueue(cq), NIXL_SUCCESS);
+        for (auto req : reqs) {
+            EXPECT_EQ(from.releaseXferReq(req), NIXL_SUCCESS);
+        }
+        invalidateMD();
+    }
+
+    // Moves heads [first_head, first_head + num_heads) of a [tokens, heads, head_dim] fp16
+    // tensor to a [tokens, num_heads, head_dim] tensor, as a tensor layout transfer and
+    // with one descriptor per head slice
+    void doLayoutReshard(size_t tokens, size_t heads, size_t head_dim, size_t first_head,
+                         size_t num_heads)
+    {
+        constexpr size_t elem_size = 2;
+        std::vector<MemBuffer> src, dst;
+        createRegisteredMem(getAgent(0), tokens * heads * head_dim * elem_size, 1, DRAM_SEG,
+                            src);
+        createRegisteredMem(getAgent(1), tokens * num_heads * head_dim * elem_size, 1,
+                            DRAM_SEG, dst);
+        exchangeMD();
+
+        for (size_t i = 0; i < src[0].getSize(); i++) {
+            data(src[0])[i] = static_cast<uint8_t>(i * 7 + i / 251);
+        }
+
+        nixlTensorLayout src_layout(src[0], DEV_ID, DRAM_SEG, elem_size,
+                                    {tokens, heads, head_dim});
+        nixlTensorLayout dst_layout(dst[0], DEV_ID, DRAM_SEG, elem_size,
+                                    {tokens, num_heads, head_dim});
+        nixlTensorLayout src_view;
+        ASSERT_EQ(src_layout.slice(1, first_head, num_heads, src_view), NIXL_SUCCESS);
+
+        // Expected consumer tensor, from the reference implementation
+        std::vector<uint8_t> expected(dst[0].getSize());
+        nixlTensorLayout expected_layout(reinterpret_cast<uintptr_t>(expected.data()), DEV_ID,
+                                         DRAM_SEG, elem_size, {tokens, num_heads, head_dim});
+        ASSERT_EQ(nixlTensorLayout::copy(src_view, expected_layout), NIXL_SUCCESS);
+
+        nixl_xfer_dlist_t slice_src(DRAM_SEG), slice_dst(DRAM_SEG);
+        const size_t slice_len = head_dim * elem_size;
+        for (size_t t = 0; t < tokens; t++) {
+            for (size_t h = 0; h < num_heads; h++) {
+                slice_src.addDesc(nixlBasicDesc(
+                        src[0] + ((t * heads + first_head + h) * slice_len), slice_len, DEV_ID));
+                slice_dst.addDesc(nixlBasicDesc(
+                        dst[0] + ((t * num_heads + h) * slice_len), slice_len, DEV_ID));
+            }
+        }
+
+        nixlAgent &from = getAgent(0);
+        auto run = [&](bool use_layout) {
+            std::memset(data(dst[0]), 0, dst[0].getSize());
+            auto start_time = absl::Now();
+
+            nixlXferReqH *xfer_req = nullptr;
+            nixl_status_t status;
+            if (use_layout) {
+                status = from.createLayoutXferReq(NIXL_WRITE, src_view, dst_layout,
+                                                  getAgentName(1), xfer_req);
+            } else {
+                status = from.createXferReq(NIXL_WRITE, slice_src, slice_dst, getAgentName(1),
+                                            xfer_req);
+            }
+            EXPECT_EQ(status, NIXL_SUCCESS);
+
+            status = from.postXferReq(xfer_req);
+            while (status == NIXL_IN_PROG) {
+                status = from.getXferStatus(xfer_req);
+            }
+            EXPECT_EQ(status, NIXL_SUCCESS);
+            auto total_time = absl::ToDoubleMicroseconds(absl::Now() - start_time);
+
+            EXPECT_EQ(std::memcmp(data(dst[0]), expected.data(), expected.size()), 0);
+            EXPECT_EQ(from.releaseXferReq(xfer_req), NIXL_SUCCESS);
+            return total_time;
+        };
+
+        auto slice_time  = run(false);
+        auto layout_time = run(true);
+        Logger() << "Re-sharding " << num_heads << " of " << heads << " heads for " << tokens
+                 << " tokens: " << slice_time << " us with " << slice_src.descCount()
+                 << " slice descriptors, " << layout_time << " us with tensor layout";
+
+        invalidateMD();
+    }
+
+    void doBroadcast(size_t num_receivers, unsigned fanout, size_t size,
+                     size_t chunk_size)
+    {
+        std::vector<std::vector<MemBuffer>> buffers(num_receivers + 1);
+        for (size_t i = 0; i <= num_receivers; i++) {
+            createRegisteredMem(getAgent(i), size, 1, DRAM_SEG, buffers[i]);
+        }
+        exchangeMD();
+
+        nixl_xfer_dlist_t local(DRAM_SEG);
+        local.addDesc(nixlBasicDesc(buffers[0][0], size, DEV_ID));
+        std::vector<std::string> remote_agents;
+        std::vector<nixl_xfer_dlist_t> remote_descs;
+        for (size_t i = 1; i <= num_receivers; i++) {
+            remote_agents.push_back(getAgentName(i));
+            remote_descs.emplace_back(DRAM_SEG);
+            remote_descs.back().addDesc(nixlBasicDesc(buffers[i][0], size, DEV_ID));
+            std::memset(data(buffers[i][0]), 0, size);
+        }
+        std::memset(data(buffers[0][0]), 'a' + fanout, size);
+
+        nixl_opt_args_t extra_params;
+        extra_params.hasNotif       = true;
+        extra_params.notifMsg       = NOTIF_MSG;
+        extra_params.bcastChunkSize = chunk_size;
+        extra_params.bcastFanout    = fanout;
+
+        nixlAgent &from = getAgent(0);
+        nixlBcastReqH *bcast = nullptr;
+        ASSERT_EQ(from.createBcastReq(local, remote_agents, remote_descs, bcast,
+                                      &extra_params),
+                  NIXL_SUCCESS);
+
+        nixl_status_t status = from.postBcastReq(bcast);
+        ASSERT_TRUE((status == NIXL_SUCCESS) || (status == NIXL_IN_PROG));
+
+        // Receivers relay chunks within getNotifs, so all of them are polled
+        std::vector<nixl_notifs_t> notif_maps(num_receivers + 1);
+        EXPECT_TRUE(wait_until_true([&]() {
+            bool done = (from.getBcastStatus(bcast) == NIXL_SUCCESS);
+            for (size_t i = 1; i <= num_receivers; i++) {
+                EXPECT_EQ(getAgent(i).getNotifs(notif_maps[i]), NIXL_SUCCESS);
+                done = done && !notif_maps[i].empty();
+            }
+            return done;
+        }));
+
+        for (size_t i = 1; i <= num_receivers; i++) {
+            auto &notif_list = notif_maps[i][getAgentName(0)];
+            EXPECT_EQ(notif_list.size(), 1u) << "Receiver " << i << ", fanout " << fanout;
+            EXPECT_EQ(notif_list, std::vector<nixl_blob_t>(1, NOTIF_MSG));
+            EXPECT_EQ(std::memcmp(data(buffers[i][0]), data(buffers[0][0]), size), 0)
+                    << "Receiver " << i << ", fanout " << fanout;
+        }
+
+        EXPECT_EQ(from.releaseBcastReq(bcast), NIXL_SUCCESS);
+        invalidateMD();
+
+        for (size_t i = 0; i <= num_receivers; i++) {
+            auto reg_list = makeDescList<nixlBlobDesc>(buffers[i], DRAM_SEG);
+            EXPECT_EQ(getAgent(i).deregisterMem(reg_list), NIXL_SUCCESS);
+        }
+    }
+
+    void doBroadcastRelayFailure(size_t size)
+    {
+        std::vector<std::vector<MemBuffer>> buffers(3);
+        for (size_t i = 0; i < 3; i++) {
+            createRegisteredMem(getAgent(i), size, 1, DRAM_SEG, buffers[i]);
+        }
+        exchangeMD();
+
+        // The first receiver of the chain can't relay to the second one
+        ASSERT_EQ(getAgent(1).invalidateRemoteMD(getAgentName(2)), NIXL_SUCCESS);
+
+        nixl_xfer_dlist_t local(DRAM_SEG);
+        local.addDesc(nixlBasicDesc(buffers[0][0], size, DEV_ID));
+        std::vector<nixl_xfer_dlist_t> remote_descs(2, nixl_xfer_dlist_t(DRAM_SEG));
+        for (size_t i = 1; i < 3; i++) {
+            remote_descs[i - 1].addDesc(nixlBasicDesc(buffers[i][0], size, DEV_ID));
+        }
+
+        nixl_opt_args_t extra_params;
+        extra_params.bcastChunkSize = 64 * 1024;
+        nixlAgent &from = getAgent(0);
+        nixlBcastReqH *bcast = nullptr;
+        ASSERT_EQ(from.createBcastReq(local, {getAgentName(1), getAgentName(2)}, remote_descs,
+                                      bcast, &extra_params),
+                  NIXL_SUCCESS);
+        nixl_status_t status = from.postBcastReq(bcast);
+        ASSERT_TRUE((status == NIXL_SUCCESS) || (status == NIXL_IN_PROG));
+
+        // The failure is reported back to the initiator instead of a success
+        nixl_notifs_t notif_map;
+        EXPECT_TRUE(wait_until_true([&]() {
+            EXPECT_EQ(getAgent(1).getNotifs(notif_map), NIXL_SUCCESS);
+            status = from.getBcastStatus(bcast);
+            return status != NIXL_IN_PROG;
+        }));
+        EXPECT_EQ(status, NIXL_ERR_NOT_FOUND);
+        EXPECT_EQ(from.releaseBcastReq(bcast), NIXL_SUCCESS);
+
+        nixl_blob_t md;
+        std::string remote_name;
+        ASSERT_EQ(getAgent(2).getLocalMD(md), NIXL_SUCCESS);
+        ASSERT_EQ(getAgent(1).loadRemoteMD(md, remote_name), NIXL_SUCCESS);
+        invalidateMD();
+
+        for (size_t i = 0; i < 3; i++) {
+            auto reg_list = makeDescList<nixlBlobDesc>(buffers[i], DRAM_SEG);
+            EXPECT_EQ(getAgent(i).deregisterMem(reg_list), NIXL_SUCCESS);
+        }
+    }
+
+    // Looks the keys up from agent `from`, with the other agents serving as shards
+    std::vector<nixl_dir_blocks_t> lookupBlocks(size_t from, const std::vector<uint64_t> &keys)
+    {
+        nixlDirLookupH *lookup = nullptr;
+        std::vector<nixl_dir_blocks_t> blocks;
+        EXPECT_EQ(getAgent(from).lookupBlocks(keys, lookup), NIXL_SUCCESS);
+        if (!lookup) {
+            return blocks;
+        }
+
+        EXPECT_TRUE(wait_until_true([&]() {
+            for (size_t i = 0; i < agents.size(); i++) {
+                nixl_notifs_t notif_map;
+                if (i != from) {
+                    EXPECT_EQ(getAgent(i).getNotifs(notif_map), NIXL_SUCCESS);
+                }
+            }
+            return getAgent(from).getLookupStatus(lookup) == NIXL_SUCCESS;
+        }));
+        EXPECT_EQ(getAgent(from).getLookupResults(lookup, blocks), NIXL_SUCCESS);
+        EXPECT_EQ(getAgent(from).releaseLookup(lookup), NIXL_SUCCESS);
+        return blocks;
+    }
+
+    static size_t countBlocks(const std::vector<nixl_dir_blocks_t> &blocks)
+    {
+        size_t count = 0;
+        for (const auto &holder : blocks) {
+            count += holder.keys.size();
+        }
+        return count;
+    }
+
+    void doBlockDirectory(size_t num_blocks, size_t block_size)
+    {
+        const size_t num_agents = agents.size();
+        std::vector<std::vector<MemBuffer>> buffers(num_agents);
+        std::vector<std::string> members;
+        for (size_t i = 0; i < num_agents; i++) {
+            createRegisteredMem(getAgent(i), block_size * num_blocks, 1, DRAM_SEG, buffers[i]);
+            std::memset(data(buffers[i][0]), 'a' + i, block_size * num_blocks);
+            members.push_back(getAgentName(i));
+        }
+        exchangeMD();
+
+        for (size_t i = 0; i < num_agents; i++) {
+            ASSERT_EQ(getAgent(i).setDirMembers(members), NIXL_SUCCESS);
+        }
+
+        // Agents other than the first one publish their blocks, key i * num_blocks + j
+        // for block j of agent i
+        std::vector<uint64_t> keys;
+        for (size_t i = 1; i < num_agents; i++) {
+            std::vector<uint64_t> agent_keys;
+            nixl_xfer_dlist_t descs(DRAM_SEG);
+            for (size_t j = 0; j < num_blocks; j++) {
+                agent_keys.push_back(i * num_blocks + j);
+                descs.addDesc(nixlBasicDesc(
+                        static_cast<uintptr_t>(buffers[i][0]) + j * block_size, block_size,
+                        DEV_ID));
+            }
+            ASSERT_EQ(getAgent(i).publishBlocks(agent_keys, descs), NIXL_SUCCESS);
+            keys.insert(keys.end(), agent_keys.begin(), agent_keys.end());
+        }
+        // Not published
+        keys.push_back(num_agents * num_blocks);
+
+        std::vector<nixl_dir_blocks_t> blocks;
+        EXPECT_TRUE(wait_until_true([&]() {
+            blocks = lookupBlocks(0, keys);
+            return countBlocks(blocks) == keys.size() - 1;
+        }));
+        ASSERT_EQ(blocks.size(), num_agents - 1);
+
+        // Found blocks are read by the first agent straight from the lookup results
+        for (const auto &holder : blocks) {
+            ASSERT_EQ(holder.keys.size(), num_blocks);
+            for (size_t j = 0; j < num_blocks; j++) {
+                EXPECT_EQ(holder.agent, getAgentName(holder.keys[j] / num_blocks));
+                EXPECT_EQ(holder.descs[j].len, block_size);
+            }
+
+            nixl_xfer_dlist_t local(DRAM_SEG);
+            for (size_t j = 0; j < num_blocks; j++) {
+                local.addDesc(nixlBasicDesc(
+                        static_cast<uintptr_t>(buffers[0][0]) + j * block_size, block_size,
+                        DEV_ID));
+            }
+            nixlXferReqH *xfer_req = nullptr;
+            ASSERT_EQ(getAgent(0).createXferReq(NIXL_READ, local, holder.descs, holder.agent,
+                                                xfer_req),
+                      NIXL_SUCCESS);
+            nixl_status_t status = getAgent(0).postXferReq(xfer_req);
+            EXPECT_TRUE(wait_until_true([&]() {
+                status = getAgent(0).getXferStatus(xfer_req);
+                return status != NIXL_IN_PROG;
+            }));
+            EXPECT_EQ(status, NIXL_SUCCESS);
+            EXPECT_EQ(getAgent(0).releaseXferReq(xfer_req), NIXL_SUCCESS);
+
+            const size_t holder_idx = holder.keys[0] / num_blocks;
+            for (size_t j = 0; j < num_blocks; j++) {
+                EXPECT_EQ(data(buffers[0][0])[j * block_size], 'a' + holder_idx);
+            }
+        }
+
+        // Lookups fail if the shards don't answer in time, here as they are not progressed
+        nixl_opt_args_t lookup_args;
+        lookup_args.lookupTimeoutUs = 1000;
+        nixlDirLookupH *lookup = nullptr;
+        ASSERT_EQ(getAgent(0).lookupBlocks(keys, lookup, &lookup_args), NIXL_SUCCESS);
+        nixl_status_t lookup_status;
+        EXPECT_TRUE(wait_until_true([&]() {
+            lookup_status = getAgent(0).getLookupStatus(lookup);
+            return lookup_status != NIXL_IN_PROG;
+        }));
+        EXPECT_EQ(lookup_status, NIXL_ERR_REMOTE_DISCONNECT);
+        EXPECT_EQ(getAgent(0).releaseLookup(lookup), NIXL_SUCCESS);
+
+        // Blocks outside the registered memory of their holder known to the reader are
+        // left out, here memory registered after the metadata exchange
+        std::vector<MemBuffer> late_buffers;
+        createRegisteredMem(getAgent(2), block_size, 1, DRAM_SEG, late_buffers);
+        const uint64_t late_key = num_agents * num_blocks + 1;
+        nixl_xfer_dlist_t late_desc(DRAM_SEG);
+        late_desc.addDesc(nixlBasicDesc(late_buffers[0], block_size, DEV_ID));
+        ASSERT_EQ(getAgent(2).publishBlocks({late_key}, late_desc), NIXL_SUCCESS);
+        EXPECT_TRUE(wait_until_true([&]() {
+            blocks = lookupBlocks(2, {late_key});
+            return blocks.size() == 1 && blocks[0].agent == getAgentName(2);
+        }));
+        EXPECT_EQ(countBlocks(lookupBlocks(0, {late_key})), 0);
+        auto late_list = makeDescList<nixlBlobDesc>(late_buffers, DRAM_SEG);
+        EXPECT_EQ(getAgent(2).deregisterMem(late_list), NIXL_SUCCESS);
+
+        // A key published again moves to its last holder, and back once unpublished
+        const uint64_t shared_key = num_blocks;
+        nixl_xfer_dlist_t shared_desc(DRAM_SEG);
+        shared_desc.addDesc(nixlBasicDesc(buffers[0][0], block_size, DEV_ID));
+        ASSERT_EQ(getAgent(0).publishBlocks({shared_key}, shared_desc), NIXL_SUCCESS);
+        EXPECT_TRUE(wait_until_true([&]() {
+            blocks = lookupBlocks(1, {shared_key});
+            return blocks.size() == 1 && blocks[0].agent == getAgentName(0);
+        }));
+        ASSERT_EQ(getAgent(0).unpublishBlocks({shared_key}), NIXL_SUCCESS);
+        EXPECT_TRUE(wait_until_true([&]() {
+            blocks = lookupBlocks(1, {shared_key});
+            return blocks.size() == 1 && blocks[0].agent == getAgentName(1);
+        }));
+
+        // Blocks move to the remaining shards when members change
+        members.pop_back();
+        for (size_t i = 0; i < num_agents; i++) {
+            ASSERT_EQ(getAgent(i).setDirMembers(members), NIXL_SUCCESS);
+        }
+        EXPECT_TRUE(wait_until_true([&]() {
+            blocks = lookupBlocks(0, keys);
+            return countBlocks(blocks) == keys.size() - 1;
+        }));
+
+        // Blocks of deregistered memory are unpublished
+        auto reg_list = makeDescList<nixlBlobDesc>(buffers[1], DRAM_SEG);
+        EXPECT_EQ(getAgent(1).deregisterMem(reg_list), NIXL_SUCCESS);
+        EXPECT_TRUE(wait_until_true([&]() {
+            blocks = lookupBlocks(0, keys);
+            return countBlocks(blocks) == keys.size() - 1 - num_blocks;
+        }));
+        for (const auto &holder : blocks) {
+            EXPECT_NE(holder.agent, getAgentName(1));
+        }
+
+        // So are the blocks of agents whose metadata is invalidated on the shards
+        for (size_t i = 0; i < members.size(); i++) {
+            EXPECT_EQ(getAgent(i).invalidateRemoteMD(getAgentName(num_agents - 1)),
+                      NIXL_SUCCESS);
+        }
+        blocks = lookupBlocks(0, keys);
+        EXPECT_EQ(countBlocks(blocks), num_blocks * (num_agents - 3));
+        for (const auto &holder : blocks) {
+            EXPECT_NE(holder.agent, getAgentName(num_agents - 1));
+        }
+
+        for (size_t i = 0; i < num_agents; i++) {
+            if (i != 1) {
+                reg_list = makeDescList<nixlBlobDesc>(buffers[i], DRAM_SEG);
+                EXPECT_EQ(getAgent(i).deregisterMem(reg_list), NIXL_SUCCESS);
+            }
+        }
+    }
+
+    nixlXferReqH *
+    createXfer(nixlAgent &from, const std::string &to_name, nixl_xfer_op_t op,
+               uintptr_t local_addr, uintptr_t remote_addr, size_t size,
+               bool notif = false)
+    {
+        nixl_xfer_dlist_t local(DRAM_SEG), remote(DRAM_SEG);
+        local.addDesc(nixlBasicDesc(local_addr, size, DEV_ID));
+        remote.addDesc(nixlBasicDesc(remote_addr, size, DEV_ID));
+
+        nixl_opt_args_t extra_params;
+        extra_params.hasNotif = notif;
+        extra_params.notifMsg = NOTIF_MSG;
+
+        nixlXferReqH *xfer_req = nullptr;
+        nixl_status_t status = from.createXferReq(op, local, remote, to_name,
+                                                  xfer_req, &extra_params);
+        EXPECT_EQ(status, NIXL_SUCCESS);
+        return xfer_req;
+    }
+
+    static uint8_t *data(const MemBuffer &buffer)
+    {
+        return reinterpret_cast<uint8_t *>(static_cast<uintptr_t>(buffer));
+    }
+
     nixlAgent &getAgent(size_t idx)
     {
         return *agents[idx];
@@ -481,6 +1431,26 @@ TEST_P(TestTransfer, SelfNotification) {
             getAgent(0), getAgentName(0), getAgent(0), getAgentName(0), repeat, num_threads);
 }
 
+TEST_P(TestTransfer, CompactNotification) {
+    doCompactNotificationTest(getAgent(0), getAgentName(0), getAgent(1), getAgentName(1), 1000);
+}
+
+TEST_P(TestTransfer, SubscribedNotification) {
+    constexpr size_t repeat = 1000;
+    constexpr size_t num_streams = 8;
+    doSubscribedNotificationTest(
+            getAgent(0), getAgentName(0), getAgent(1), getAgentName(1), repeat, num_streams);
+}
+
+TEST_P(TestTransfer, SharedBackend) {
+    // UCX_MO does not support local communication
+    if (getBackendName() == "UCX_MO") {
+        GTEST_SKIP() << "UCX_MO does not support local communication";
+    }
+
+    doSharedBackendTest(3, 4096);
+}
+
 TEST_P(TestTransfer, ListenerCommSize) {
     std::vector<MemBuffer> buffers;
     createRegisteredMem(getAgent(1), 64, 10000, DRAM_SEG, buffers);
@@ -490,7 +1460,186 @@ TEST_P(TestTransfer, ListenerCommSize) {
         wait_until_true([&]() { return checkRemoteMD(0, 1) == NIXL_SUCCESS; }));
 }
 
+TEST_P(TestTransfer, XferGraph)
+{
+    constexpr size_t size = 64 * 1024;
+    std::vector<MemBuffer> src, mid, local, out;
+
+    createRegisteredMem(getAgent(0), size, 1, DRAM_SEG, src);
+    createRegisteredMem(getAgent(0), size, 1, DRAM_SEG, local);
+    createRegisteredMem(getAgent(1), size, 1, DRAM_SEG, mid);
+    createRegisteredMem(getAgent(1), size, 1, DRAM_SEG, out);
+    exchangeMD();
+
+    for (size_t i = 0; i < size; i++) {
+        data(src[0])[i] = static_cast<uint8_t>(i % 251);
+    }
+    memset(data(local[0]), 0, size);
+    memset(data(out[0]), 0, size);
+
+    // Diamond: write to the peer, read back both halves, then write them
+    // to the final location with a notification
+    nixlAgent &from = getAgent(0);
+    const std::string to_name = getAgentName(1);
+    constexpr size_t half = size / 2;
+    nixlXferReqH *write_mid = createXfer(from, to_name, NIXL_WRITE, src[0], mid[0], size);
+    nixlXferReqH *read_low = createXfer(from, to_name, NIXL_READ, local[0], mid[0], half);
+    nixlXferReqH *read_high = createXfer(from, to_name, NIXL_READ,
+                                         local[0] + half, mid[0] + half, half);
+    nixlXferReqH *write_out = createXfer(from, to_name, NIXL_WRITE, local[0], out[0], size,
+                                         true);
+
+    nixlXferGraphH *graph = nullptr;
+    ASSERT_EQ(from.createXferGraph(graph), NIXL_SUCCESS);
+    ASSERT_EQ(from.addXferGraphNode(graph, write_mid), NIXL_SUCCESS);
+    ASSERT_EQ(from.addXferGraphNode(graph, read_low, {write_mid}), NIXL_SUCCESS);
+    ASSERT_EQ(from.addXferGraphNode(graph, read_high, {write_mid}), NIXL_SUCCESS);
+    ASSERT_EQ(from.addXferGraphNode(graph, write_out, {read_low, read_high}), NIXL_SUCCESS);
+
+    // A request can be added to a graph only once
+    EXPECT_EQ(from.addXferGraphNode(graph, write_out), NIXL_ERR_INVALID_PARAM);
+
+    for (int repeat = 0; repeat < 2; repeat++) {
+        nixl_status_t status = from.postXferGraph(graph);
+        ASSERT_TRUE((status == NIXL_SUCCESS) || (status == NIXL_IN_PROG));
+        while (status == NIXL_IN_PROG) {
+            status = from.getXferGraphStatus(graph);
+        }
+        EXPECT_EQ(status, NIXL_SUCCESS);
+        EXPECT_EQ(memcmp(data(src[0]), data(out[0]), size), 0);
+
+        verifyNotifs(getAgent(1), getAgentName(0), 1);
+        memset(data(out[0]), 0, size);
+    }
+
+    EXPECT_EQ(from.releaseXferGraph(graph), NIXL_SUCCESS);
+    for (auto *req : {write_mid, read_low, read_high, write_out}) {
+        EXPECT_EQ(from.releaseXferReq(req), NIXL_SUCCESS);
+    }
+
+    invalidateMD();
+}
+
+TEST_P(TestTransfer, XferGraphPipelineLatency)
+{
+    constexpr size_t size = 4096;
+    constexpr size_t num_stages = 4;
+    constexpr size_t repeat = 200;
+    std::vector<MemBuffer> local, remote;
+
+    createRegisteredMem(getAgent(0), size, num_stages + 1, DRAM_SEG, local);
+    createRegisteredMem(getAgent(1), size, num_stages, DRAM_SEG, remote);
+    exchangeMD();
+
+    // Each stage moves the output of the previous one: local[i] -> remote[i] -> local[i + 1]
+    nixlAgent &from = getAgent(0);
+    std::vector<nixlXferReqH *> stages;
+    for (size_t i = 0; i < num_stages; i++) {
+        stages.push_back(createXfer(from, getAgentName(1), NIXL_WRITE, local[i], remote[i],
+                                    size));
+        stages.push_back(createXfer(from, getAgentName(1), NIXL_READ, local[i + 1], remote[i],
+                                    size));
+    }
+
+    nixlXferGraphH *graph = nullptr;
+    ASSERT_EQ(from.createXferGraph(graph), NIXL_SUCCESS);
+    for (size_t i = 0; i < stages.size(); i++) {
+        std::vector<nixlXferReqH *> deps;
+        if (i > 0) {
+            deps.push_back(stages[i - 1]);
+        }
+        ASSERT_EQ(from.addXferGraphNode(graph, stages[i], deps), NIXL_SUCCESS);
+    }
+
+    // Application driven pipeline: poll each stage and post the next one
+    auto start_time = absl::Now();
+    for (size_t i = 0; i < repeat; i++) {
+        for (auto *stage : stages) {
+            nixl_status_t status = from.postXferReq(stage);
+            while (status == NIXL_IN_PROG) {
+                status = from.getXferStatus(stage);
+            }
+            ASSERT_EQ(status, NIXL_SUCCESS);
+        }
+    }
+    auto polling_time = absl::ToDoubleMicroseconds(absl::Now() - start_time) / repeat;
+
+    start_time = absl::Now();
+    for (size_t i = 0; i < repeat; i++) {
+        nixl_status_t status = from.postXferGraph(graph);
+        while (status == NIXL_IN_PROG) {
+            status = from.getXferGraphStatus(graph);
+        }
+        ASSERT_EQ(status, NIXL_SUCCESS);
+    }
+    auto graph_time = absl::ToDoubleMicroseconds(absl::Now() - start_time) / repeat;
+
+    Logger() << stages.size() << " stage pipeline of " << size << " bytes: "
+             << polling_time << " us with application polling, "
+             << graph_time << " us with transfer graph";
+
+    EXPECT_EQ(from.releaseXferGraph(graph), NIXL_SUCCESS);
+    for (auto *stage : stages) {
+        EXPECT_EQ(from.releaseXferReq(stage), NIXL_SUCCESS);
+    }
+
+    invalidateMD();
+}
+
+TEST_P(TestTransfer, MultiPeerXfer)
+{
+    constexpr size_t num_peers = 3;
+    addAgents(num_peers - 1);
+    doMultiPeerTransfer(num_peers, 16, 4096);
+}
+
+TEST_P(TestTransfer, LayoutXferReshard)
+{
+    doLayoutReshard(1024, 8, 128, 2, 2);
+}
+
+TEST_P(TestTransfer, Broadcast)
+{
+    constexpr size_t num_receivers = 7;
+    addAgents(num_receivers - 1);
+
+    // Chain and trees, the last chunk is shorter than the others
+    for (unsigned fanout : {1, 2, 3}) {
+        doBroadcast(num_receivers, fanout, 1024 * 1024 + 100, 64 * 1024);
+    }
+}
+
+TEST_P(TestTransfer, BroadcastRelayFailure)
+{
+    addAgents(1);
+    doBroadcastRelayFailure(256 * 1024);
+}
+
+TEST_P(TestTransfer, AsyncRegistration)
+{
+    doAsyncRegistration(64 * 1024, 32);
+}
+
+TEST_P(TestTransfer, FileSegRemoteAccess)
+{
+    doFileSegTest(64 * 1024, 8);
+}
+
+TEST_P(TestTransfer, CompletionQueue)
+{
+    doComplQueueTest(64 * 1024, 32, 4);
+}
+
+TEST_P(TestTransfer, BlockDirectory)
+{
+    addAgents(2);
+    doBlockDirectory(16, 4096);
+}
+
 INSTANTIATE_TEST_SUITE_P(ucx, TestTransfer, testing::Values("UCX"));
 INSTANTIATE_TEST_SUITE_P(ucx_mo, TestTransfer, testing::Values("UCX_MO"));
+#ifdef HAVE_URING_TCP
+INSTANTIATE_TEST_SUITE_P(uring_tcp, TestTransfer, testing::Values("URING_TCP"));
+#endif
 
 } // namespace gtest
@@ -0,0 +1,249 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "dtype_convert.h"
+
+namespace gtest::dtype {
+
+namespace {
+
+struct fp8Limits {
+    nixl_dtype_t type;
+    int mantBits;
+    float maxValue;
+    float minNormal;
+    float minSubnormal;
+    uint8_t maxCode;
+    uint8_t nanCode;
+};
+
+constexpr fp8Limits e4m3 = {NIXL_DTYPE_FP8_E4M3, 3, 448.0f, 0x1p-6f, 0x1p-9f, 0x7e, 0x7f};
+constexpr fp8Limits e5m2 = {NIXL_DTYPE_FP8_E5M2, 2, 57344.0f, 0x1p-14f, 0x1p-16f, 0x7b, 0x7f};
+
+nixl_xfer_conv_t
+makeConv (nixl_dtype_t local, nixl_dtype_t remote, float scale = 0.0f) {
+    nixl_xfer_conv_t conv;
+    conv.localType = local;
+    conv.remoteType = remote;
+    if (scale != 0.0f) {
+        conv.scaleMode = NIXL_SCALE_FIXED;
+        conv.scale = scale;
+    }
+    return conv;
+}
+
+float
+bf16Value (uint16_t code) {
+    const uint32_t bits = uint32_t (code) << 16;
+    float value;
+    std::memcpy (&value, &bits, sizeof (value));
+    return value;
+}
+
+float
+fp16Value (uint16_t code) {
+    const int exp = (code >> 10) & 0x1f;
+    const int mant = code & 0x3ff;
+    float value;
+    if (exp == 0x1f)
+        value = mant ? NAN : INFINITY;
+    else if (exp == 0)
+        value = std::ldexp (float (mant), -24);
+    else
+        value = std::ldexp (float (mant | 0x400), exp - 25);
+    return (code & 0x8000) ? -value : value;
+}
+
+float
+localValue (nixl_dtype_t type, uint16_t code) {
+    return (type == NIXL_DTYPE_BF16) ? bf16Value (code) : fp16Value (code);
+}
+
+std::vector<uint8_t>
+toFp8 (const nixl_xfer_conv_t &conv, const std::vector<uint16_t> &src) {
+    std::vector<uint8_t> dst (src.size());
+    nixlDtype::toRemote (conv, src.data(), dst.data(), src.size());
+    return dst;
+}
+
+// Converts every 16-bit code to FP8 and back, and checks the round trip against the
+// rounding error bound of the FP8 type, the saturation and the NaN handling
+void
+checkRoundTrip (nixl_dtype_t local, const fp8Limits &fp8) {
+    const auto conv = makeConv (local, fp8.type);
+    std::vector<uint16_t> src (1 << 16);
+    for (size_t i = 0; i < src.size(); i++)
+        src[i] = uint16_t (i);
+
+    const auto remote = toFp8 (conv, src);
+    std::vector<uint16_t> back (src.size());
+    nixlDtype::toLocal (conv, remote.data(), back.data(), back.size());
+
+    const float rel_bound = std::ldexp (1.0f, -(fp8.mantBits + 1));
+    for (size_t i = 0; i < src.size(); i++) {
+        const float x = localValue (local, src[i]);
+        const float y = localValue (local, back[i]);
+        const float ax = std::fabs (x);
+        SCOPED_TRACE (testing::Message() << "code 0x" << std::hex << i << " value " << x);
+
+        if (std::isnan (x)) {
+            EXPECT_EQ (remote[i] & 0x7f, fp8.nanCode);
+            EXPECT_TRUE (std::isnan (y));
+            continue;
+        }
+
+        EXPECT_EQ (std::signbit (x), std::signbit (y));
+        if (ax >= fp8.maxValue) {
+            EXPECT_EQ (remote[i] & 0x7f, fp8.maxCode);
+            EXPECT_EQ (std::fabs (y), fp8.maxValue);
+        } else if (ax >= fp8.minNormal) {
+            EXPECT_LE (std::fabs (y - x), ax * rel_bound);
+        } else {
+            EXPECT_LE (std::fabs (y - x), fp8.minSubnormal / 2);
+        }
+    }
+}
+
+} // namespace
+
+TEST (DtypeConvertTest, Validity) {
+    EXPECT_TRUE (nixlDtype::isValid (makeConv (NIXL_DTYPE_BF16, NIXL_DTYPE_FP8_E4M3)));
+    EXPECT_TRUE (nixlDtype::isValid (makeConv (NIXL_DTYPE_BF16, NIXL_DTYPE_FP8_E5M2)));
+    EXPECT_TRUE (nixlDtype::isValid (makeConv (NIXL_DTYPE_FP16, NIXL_DTYPE_FP8_E4M3)));
+    EXPECT_TRUE (nixlDtype::isValid (makeConv (NIXL_DTYPE_FP16, NIXL_DTYPE_FP8_E5M2, 0.5f)));
+
+    EXPECT_FALSE (nixlDtype::isValid (makeConv (NIXL_DTYPE_FP8_E4M3, NIXL_DTYPE_BF16)));
+    EXPECT_FALSE (nixlDtype::isValid (makeConv (NIXL_DTYPE_BF16, NIXL_DTYPE_FP16)));
+    EXPECT_FALSE (nixlDtype::isValid (makeConv (NIXL_DTYPE_BF16, NIXL_DTYPE_BF16)));
+    EXPECT_FALSE (nixlDtype::isValid (makeConv (NIXL_DTYPE_FP8_E4M3, NIXL_DTYPE_FP8_E5M2)));
+
+    EXPECT_FALSE (nixlDtype::isValid (makeConv (NIXL_DTYPE_BF16, NIXL_DTYPE_FP8_E4M3, -1.0f)));
+    EXPECT_FALSE (nixlDtype::isValid (makeConv (NIXL_DTYPE_BF16, NIXL_DTYPE_FP8_E4M3, NAN)));
+    EXPECT_FALSE (
+        nixlDtype::isValid (makeConv (NIXL_DTYPE_BF16, NIXL_DTYPE_FP8_E4M3, INFINITY)));
+    auto zero_scale = makeConv (NIXL_DTYPE_BF16, NIXL_DTYPE_FP8_E4M3);
+    zero_scale.scaleMode = NIXL_SCALE_FIXED;
+    zero_scale.scale = 0.0f;
+    EXPECT_FALSE (nixlDtype::isValid (zero_scale));
+}
+
+TEST (DtypeConvertTest, RoundTripBf16E4m3) {
+    checkRoundTrip (NIXL_DTYPE_BF16, e4m3);
+}
+
+TEST (DtypeConvertTest, RoundTripBf16E5m2) {
+    checkRoundTrip (NIXL_DTYPE_BF16, e5m2);
+}
+
+TEST (DtypeConvertTest, RoundTripFp16E4m3) {
+    checkRoundTrip (NIXL_DTYPE_FP16, e4m3);
+}
+
+TEST (DtypeConvertTest, RoundTripFp16E5m2) {
+    checkRoundTrip (NIXL_DTYPE_FP16, e5m2);
+}
+
+// Every FP8 value other than NaN is exact in both 16-bit types
+TEST (DtypeConvertTest, Fp8CodesExact) {
+    for (const auto local : {NIXL_DTYPE_BF16, NIXL_DTYPE_FP16}) {
+        for (const auto &fp8 : {e4m3, e5m2}) {
+            const auto conv = makeConv (local, fp8.type);
+            std::vector<uint8_t> codes;
+            for (unsigned code = 0; code < 256; code++) {
+                if ((code & 0x7f) <= fp8.maxCode)
+                    codes.push_back (uint8_t (code));
+            }
+
+            std::vector<uint16_t> wide (codes.size());
+            nixlDtype::toLocal (conv, codes.data(), wide.data(), codes.size());
+            std::vector<uint8_t> back (codes.size());
+            nixlDtype::toRemote (conv, wide.data(), back.data(), codes.size());
+            EXPECT_EQ (back, codes) << "local " << local << " remote " << fp8.type;
+        }
+    }
+}
+
+TEST (DtypeConvertTest, RoundToNearestEven) {
+    // 1 + 1/16 and 1 + 3/16 are halfway between E4M3 values, 1 + 1/8 between E5M2 ones
+    const std::vector<uint16_t> src = {0x3f80, 0x3f88, 0x3f98, 0x3f90, 0x3fa0, 0x3f89};
+    EXPECT_EQ (toFp8 (makeConv (NIXL_DTYPE_BF16, NIXL_DTYPE_FP8_E4M3), src),
+               (std::vector<uint8_t>{0x38, 0x38, 0x3a, 0x39, 0x3a, 0x39}));
+    EXPECT_EQ (toFp8 (makeConv (NIXL_DTYPE_BF16, NIXL_DTYPE_FP8_E5M2), src),
+               (std::vector<uint8_t>{0x3c, 0x3c, 0x3d, 0x3c, 0x3d, 0x3c}));
+}
+
+TEST (DtypeConvertTest, Saturation) {
+    // 448, 464, 1e4, 65504 and +-Inf in FP16
+    const std::vector<uint16_t> src = {0x5f00, 0x5f40, 0x70e2, 0x7bff, 0x7c00, 0xfc00};
+    EXPECT_EQ (toFp8 (makeConv (NIXL_DTYPE_FP16, NIXL_DTYPE_FP8_E4M3), src),
+               (std::vector<uint8_t>{0x7e, 0x7e, 0x7e, 0x7e, 0x7e, 0xfe}));
+    EXPECT_EQ (toFp8 (makeConv (NIXL_DTYPE_FP16, NIXL_DTYPE_FP8_E5M2), src),
+               (std::vector<uint8_t>{0x5f, 0x5f, 0x71, 0x7b, 0x7b, 0xfb}));
+
+    // Infinite E5M2 values saturate to the largest FP16 value on the way back
+    const std::vector<uint8_t> inf = {0x7c, 0xfc};
+    std::vector<uint16_t> wide (inf.size());
+    nixlDtype::toLocal (
+        makeConv (NIXL_DTYPE_FP16, NIXL_DTYPE_FP8_E5M2), inf.data(), wide.data(), inf.size());
+    EXPECT_EQ (wide, (std::vector<uint16_t>{0x7bff, 0xfbff}));
+}
+
+TEST (DtypeConvertTest, NotANumber) {
+    const std::vector<uint16_t> src = {0x7fc0, 0xffc0, 0x7f81};
+    EXPECT_EQ (toFp8 (makeConv (NIXL_DTYPE_BF16, NIXL_DTYPE_FP8_E4M3), src),
+               (std::vector<uint8_t>{0x7f, 0xff, 0x7f}));
+    EXPECT_EQ (toFp8 (makeConv (NIXL_DTYPE_BF16, NIXL_DTYPE_FP8_E5M2), src),
+               (std::vector<uint8_t>{0x7f, 0xff, 0x7f}));
+
+    const std::vector<uint8_t> nan = {0x7f, 0xff};
+    std::vector<uint16_t> wide (nan.size());
+    nixlDtype::toLocal (
+        makeConv (NIXL_DTYPE_BF16, NIXL_DTYPE_FP8_E4M3), nan.data(), wide.data(), nan.size());
+    EXPECT_TRUE (std::isnan (bf16Value (wide[0])));
+    EXPECT_TRUE (std::isnan (bf16Value (wide[1])));
+}
+
+TEST (DtypeConvertTest, Subnormals) {
+    // 1, 1/2, 3/2, 5/4 and 3 times the smallest subnormal of each type, in FP16. The
+    // halfway cases round to even, the smallest value down to zero
+    const std::vector<uint16_t> e4m3_src = {0x1800, 0x1400, 0x1a00, 0x1500, 0x1e00};
+    EXPECT_EQ (toFp8 (makeConv (NIXL_DTYPE_FP16, NIXL_DTYPE_FP8_E4M3), e4m3_src),
+               (std::vector<uint8_t>{0x01, 0x00, 0x02, 0x01, 0x03}));
+    // 1, 1/2, 3/2, 5/2 and 3/4 times the smallest E5M2 subnormal
+    const std::vector<uint16_t> e5m2_src = {0x0100, 0x0080, 0x0180, 0x0280, 0x00c0};
+    EXPECT_EQ (toFp8 (makeConv (NIXL_DTYPE_FP16, NIXL_DTYPE_FP8_E5M2), e5m2_src),
+               (std::vector<uint8_t>{0x01, 0x00, 0x02, 0x02, 0x01}));
+}
+
+TEST (DtypeConvertTest, FixedScale) {
+    // 4, 1536 (past the E4M3 range unscaled) and -448, divided by the scale on the way out
+    const auto conv = makeConv (NIXL_DTYPE_BF16, NIXL_DTYPE_FP8_E4M3, 4.0f);
+    const std::vector<uint16_t> src = {0x4080, 0x44c0, 0xc3e0};
+    const auto remote = toFp8 (conv, src);
+    EXPECT_EQ (remote, (std::vector<uint8_t>{0x38, 0x7c, 0xee}));
+
+    std::vector<uint16_t> back (src.size());
+    nixlDtype::toLocal (conv, remote.data(), back.data(), back.size());
+    EXPECT_EQ (back, src);
+}
+
+} // namespace gtest::dtype
@@ -0,0 +1,136 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GTEST_UNIT_OBJ_FS_S3_CLIENT_H
+#define GTEST_UNIT_OBJ_FS_S3_CLIENT_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "obj_s3_client.h"
+#include "obj_executor.h"
+
+namespace gtest::obj {
+
+/**
+ * Filesystem-backed stand-in for an S3 bucket. Every object is stored as a file under a
+ * temporary directory, requests run on the engine executor and may be delayed by a fixed
+ * per-request latency to emulate a remote object store.
+ */
+class FsS3Client : public IS3Client {
+public:
+    explicit FsS3Client (std::chrono::microseconds latency = std::chrono::microseconds (0))
+        : latency_ (latency) {
+        char dir_template[] = "/tmp/nixl_obj_test_XXXXXX";
+        root_ = mkdtemp (dir_template);
+    }
+
+    ~FsS3Client() override {
+        std::filesystem::remove_all (root_);
+    }
+
+    void
+    setExecutor (std::shared_ptr<Aws::Utils::Threading::Executor> executor) override {
+        executor_ = executor;
+    }
+
+    void
+    PutObjectAsync (std::string_view key,
+                    uintptr_t data_ptr,
+                    size_t data_len,
+                    size_t offset,
+                    PutObjectCallback callback) override {
+        puts_++;
+        const bool slow = !slow_put_prefix_.empty() && key.substr (0, slow_put_prefix_.size()) ==
+                                                           slow_put_prefix_;
+        submit ([this, path = pathOf (key), data_ptr, data_len, offset, callback, slow]() {
+            if (slow) std::this_thread::sleep_for (slow_put_latency_);
+            if (offset != 0) return callback (S3Result::FAILURE);
+            std::filesystem::create_directories (path.parent_path());
+            std::ofstream file (path, std::ios::binary | std::ios::trunc);
+            file.write (reinterpret_cast<const char *> (data_ptr), data_len);
+            callback (file.good() ? S3Result::SUCCESS : S3Result::FAILURE);
+        });
+    }
+
+    void
+    GetObjectAsync (std::string_view key,
+                    uintptr_t data_ptr,
+                    size_t data_len,
+                    size_t offset,
+                    GetObjectCallback callback) override {
+        gets_++;
+        submit ([path = pathOf (key), data_ptr, data_len, offset, callback]() {
+            std::ifstream file (path, std::ios::binary);
+            file.seekg (offset);
+            file.read (reinterpret_cast<char *> (data_ptr), data_len);
+            callback (file.good() ? S3Result::SUCCESS : S3Result::FAILURE);
+        });
+    }
+
+    void
+    DeleteObjectAsync (std::string_view key, DeleteObjectCallback callback) override {
+        deletes_++;
+        submit ([path = pathOf (key), callback]() {
+            const bool removed = std::filesystem::remove (path);
+            callback (removed ? S3Result::SUCCESS : S3Result::FAILURE);
+        });
+    }
+
+    size_t
+    getObjectCount() const {
+        size_t count = 0;
+        for (const auto &entry : std::filesystem::recursive_directory_iterator (root_))
+            count += entry.is_regular_file();
+        return count;
+    }
+
+    std::atomic<size_t> puts_ = 0;
+    std::atomic<size_t> gets_ = 0;
+    std::atomic<size_t> deletes_ = 0;
+
+    // Extra latency of the puts of keys with the prefix, set before the puts are issued
+    std::string slow_put_prefix_;
+    std::chrono::microseconds slow_put_latency_{0};
+
+private:
+    std::filesystem::path
+    pathOf (std::string_view key) const {
+        return root_ / std::string (key);
+    }
+
+    void
+    submit (std::function<void()> task) {
+        executor_->Submit ([this, task]() {
+            if (latency_.count() > 0) std::this_thread::sleep_for (latency_);
+            task();
+        });
+    }
+
+    std::filesystem::path root_;
+    std::chrono::microseconds latency_;
+    std::shared_ptr<Aws::Utils::Threading::Executor> executor_;
+};
+
+} // namespace gtest::obj
+
+#endif // GTEST_UNIT_OBJ_FS_S3_CLIENT_H
@@ -0,0 +1,272 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include "nixl_types.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "obj_backend.h"
+#include "obj_executor.h"
+#include "obj_limiter.h"
+
+namespace gtest::obj {
+
+/**
+ * Mock bucket that serves up to a fixed number of concurrent requests and answers any
+ * request beyond that capacity with a throttling response.
+ */
+class CapacityS3Client : public IS3Client {
+public:
+    CapacityS3Client (size_t capacity, std::chrono::microseconds service_time)
+        : capacity_ (capacity),
+          service_time_ (service_time) {}
+
+    void
+    setExecutor (std::shared_ptr<Aws::Utils::Threading::Executor> executor) override {
+        executor_ = executor;
+    }
+
+    void
+    PutObjectAsync (std::string_view key,
+                    uintptr_t data_ptr,
+                    size_t data_len,
+                    size_t offset,
+                    PutObjectCallback callback) override {
+        serve (callback);
+    }
+
+    void
+    GetObjectAsync (std::string_view key,
+                    uintptr_t data_ptr,
+                    size_t data_len,
+                    size_t offset,
+                    GetObjectCallback callback) override {
+        serve (callback);
+    }
+
+    void
+    DeleteObjectAsync (std::string_view key, DeleteObjectCallback callback) override {
+        serve (callback);
+    }
+
+    std::atomic<size_t> requests_ = 0;
+    std::atomic<size_t> throttled_ = 0;
+    std::atomic<size_t> max_inflight_ = 0;
+
+private:
+    void
+    serve (std::function<void (S3Result)> callback) {
+        requests_++;
+        const size_t inflight = ++inflight_;
+        size_t max_inflight = max_inflight_;
+        while (inflight > max_inflight &&
+               !max_inflight_.compare_exchange_weak (max_inflight, inflight))
+            ;
+
+        const bool throttle = inflight > capacity_;
+        executor_->Submit ([this, callback, throttle]() {
+            std::this_thread::sleep_for (throttle ? service_time_ / 4 : service_time_);
+            inflight_--;
+            if (throttle) throttled_++;
+            callback (throttle ? S3Result::THROTTLED : S3Result::SUCCESS);
+        });
+    }
+
+    const size_t capacity_;
+    const std::chrono::microseconds service_time_;
+    std::atomic<size_t> inflight_ = 0;
+    std::shared_ptr<Aws::Utils::Threading::Executor> executor_;
+};
+
+class ObjLimiterTestFixture : public testing::Test {
+protected:
+    std::shared_ptr<AsioThreadPoolExecutor> executor_ =
+        std::make_shared<AsioThreadPoolExecutor> (64);
+    std::shared_ptr<CapacityS3Client> bucket_;
+    std::unique_ptr<nixlObjConcurrencyLimiter> limiter_;
+
+    void
+    TearDown() override {
+        limiter_.reset();
+        executor_->WaitUntilStopped();
+    }
+
+    void
+    createLimiter (size_t capacity, const nixlObjConcurrencyLimiter::params &limits) {
+        bucket_ = std::make_shared<CapacityS3Client> (capacity, std::chrono::microseconds (500));
+        limiter_ = std::make_unique<nixlObjConcurrencyLimiter> (bucket_, limits);
+        limiter_->setExecutor (executor_);
+    }
+
+    std::vector<S3Result>
+    runRequests (size_t count) {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::vector<S3Result> results;
+
+        for (size_t i = 0; i < count; ++i) {
+            limiter_->GetObjectAsync ("key-" + std::to_string (i),
+                                      0,
+                                      4096,
+                                      0,
+                                      [&] (S3Result result) {
+                                          std::lock_guard<std::mutex> lock (mutex);
+                                          results.push_back (result);
+                                          cv.notify_one();
+                                      });
+        }
+
+        std::unique_lock<std::mutex> lock (mutex);
+        cv.wait_for (lock, std::chrono::seconds (30), [&]() { return results.size() == count; });
+        return results;
+    }
+};
+
+TEST_F (ObjLimiterTestFixture, WindowConvergesToCapacity) {
+    nixlObjConcurrencyLimiter::params limits;
+    limits.initial_window = 32;
+    limits.backoff_base = std::chrono::milliseconds (1);
+    createLimiter (8, limits);
+
+    const auto results = runRequests (1000);
+    ASSERT_EQ (results.size(), 1000);
+    for (auto result : results)
+        EXPECT_EQ (result, S3Result::SUCCESS);
+
+    // Throttling shrinks the window and the store is no longer overrun most of the time
+    EXPECT_GT (limiter_->getThrottledCount(), 0);
+    EXPECT_LT (limiter_->getWindow(), 32);
+    EXPECT_LT (bucket_->throttled_, bucket_->requests_ / 4);
+    EXPECT_EQ (limiter_->getInflight(), 0);
+}
+
+TEST_F (ObjLimiterTestFixture, WindowGrowsWithoutThrottling) {
+    nixlObjConcurrencyLimiter::params limits;
+    limits.initial_window = 2;
+    createLimiter (1024, limits);
+
+    const auto results = runRequests (500);
+    ASSERT_EQ (results.size(), 500);
+    EXPECT_EQ (limiter_->getThrottledCount(), 0);
+    EXPECT_GT (limiter_->getWindow(), 2);
+    EXPECT_GT (bucket_->max_inflight_, 2);
+}
+
+TEST_F (ObjLimiterTestFixture, InflightNeverExceedsWindow) {
+    nixlObjConcurrencyLimiter::params limits;
+    limits.initial_window = 4;
+    limits.max_window = 4;
+    createLimiter (1024, limits);
+
+    const auto results = runRequests (200);
+    ASSERT_EQ (results.size(), 200);
+    EXPECT_LE (bucket_->max_inflight_, 4);
+}
+
+TEST_F (ObjLimiterTestFixture, ThrottledAfterMaxRetries) {
+    nixlObjConcurrencyLimiter::params limits;
+    limits.max_retries = 3;
+    limits.backoff_base = std::chrono::milliseconds (1);
+    createLimiter (0, limits);
+
+    const auto results = runRequests (4);
+    ASSERT_EQ (results.size(), 4);
+    for (auto result : results)
+        EXPECT_EQ (result, S3Result::THROTTLED);
+
+    EXPECT_EQ (bucket_->requests_, 4 * (limits.max_retries + 1));
+    EXPECT_EQ (limiter_->getWindow(), limits.min_window);
+}
+
+TEST_F (ObjLimiterTestFixture, EngineRetriesThrottledTransfers) {
+    bucket_ = std::make_shared<CapacityS3Client> (4, std::chrono::microseconds (500));
+
+    nixl_b_params_t custom_params = {
+        {"adaptive_concurrency", "true"}, {"initial_inflight", "16"}, {"retry_backoff_ms", "1"}};
+    nixlBackendInitParams init_params;
+    init_params.localAgent = "test-agent";
+    init_params.type = "OBJ";
+    init_params.customParams = &custom_params;
+    init_params.enableProgTh = false;
+    init_params.pthrDelay = 0;
+    init_params.syncMode = nixl_thread_sync_t::NIXL_THREAD_SYNC_RW;
+    auto obj_engine = std::make_unique<nixlObjEngine> (&init_params, bucket_);
+
+    nixlBlobDesc remote_desc;
+    remote_desc.devId = 1;
+    remote_desc.metaInfo = "test-throttle-key";
+    nixlBackendMD *remote_metadata = nullptr;
+    ASSERT_EQ (obj_engine->registerMem (remote_desc, OBJ_SEG, remote_metadata), NIXL_SUCCESS);
+
+    std::vector<char> buffer (64 * 1024);
+    nixl_meta_dlist_t local_descs (DRAM_SEG);
+    nixl_meta_dlist_t remote_descs (OBJ_SEG);
+    for (size_t i = 0; i < 64; ++i) {
+        local_descs.addDesc (
+            nixlMetaDesc (reinterpret_cast<uintptr_t> (buffer.data()) + i * 1024, 1024, 0));
+        remote_descs.addDesc (nixlMetaDesc (i * 1024, 1024, 1));
+    }
+
+    nixlBackendReqH *handle = nullptr;
+    ASSERT_EQ (obj_engine->prepXfer (
+                   NIXL_READ, local_descs, remote_descs, init_params.localAgent, handle, nullptr),
+               NIXL_SUCCESS);
+    ASSERT_EQ (obj_engine->postXfer (
+                   NIXL_READ, local_descs, remote_descs, init_params.localAgent, handle, nullptr),
+               NIXL_IN_PROG);
+
+    nixl_status_t status;
+    do {
+        status = obj_engine->checkXfer (handle);
+    } while (status == NIXL_IN_PROG);
+    EXPECT_EQ (status, NIXL_SUCCESS);
+    EXPECT_GT (bucket_->throttled_, 0);
+
+    obj_engine->releaseReqH (handle);
+    obj_engine->deregisterMem (remote_metadata);
+}
+
+TEST_F (ObjLimiterTestFixture, InvalidLimitsFailInit) {
+    bucket_ = std::make_shared<CapacityS3Client> (4, std::chrono::microseconds (0));
+
+    nixlBackendInitParams init_params;
+    init_params.localAgent = "test-agent";
+    init_params.type = "OBJ";
+    init_params.enableProgTh = false;
+    init_params.pthrDelay = 0;
+    init_params.syncMode = nixl_thread_sync_t::NIXL_THREAD_SYNC_RW;
+    for (const auto &custom_params : std::vector<nixl_b_params_t>{
+             {{"initial_inflight", "many"}},
+             {{"max_inflight", "0"}},
+             {{"max_retries", "-1"}},
+             {{"retry_backoff_ms", "1.5"}},
+         }) {
+        nixl_b_params_t params = custom_params;
+        params["adaptive_concurrency"] = "true";
+        init_params.customParams = &params;
+        nixlObjEngine obj_engine (&init_params, bucket_);
+        EXPECT_TRUE (obj_engine.getInitErr()) << custom_params.begin()->first;
+    }
+}
+
+} // namespace gtest::obj
@@ -50,7 +50,9 @@ public:
                     size_t data_len,
                     size_t offset,
                     PutObjectCallback callback) override {
-        pending_callbacks_.push_back ([callback, this]() { callback (simulate_success_); });
+        pending_callbacks_.push_back ([callback, this]() {
+            callback (simulate_success_ ? S3Result::SUCCESS : S3Result::FAILURE);
+        });
     }
 
     void
@@ -66,7 +68,14 @@ public:
                     buffer[i] = static_cast<char> ('A' + ((i + offset) % 26));
                 }
             }
-            callback (simulate_success_);
+            callback (simulate_success_ ? S3Result::SUCCESS : S3Result::FAILURE);
+        });
+    }
+
+    void
+    DeleteObjectAsync (std::string_view key, DeleteObjectCallback callback) override {
+        pending_callbacks_.push_back ([callback, this]() {
+            callback (simulate_success_ ? S3Result::SUCCESS : S3Result::FAILURE);
         });
     }
 
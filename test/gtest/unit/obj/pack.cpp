@@ -0,0 +1,335 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include "nixl_types.h"
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "obj_backend.h"
+#include "fs_s3_client.h"
+
+namespace gtest::obj {
+
+class ObjPackTestFixture : public testing::Test {
+protected:
+    static constexpr size_t block_size_ = 1024;
+    static constexpr size_t num_keys_ = 64;
+
+    std::unique_ptr<nixlObjEngine> obj_engine_;
+    std::shared_ptr<FsS3Client> fs_s3_client_;
+    nixlBackendInitParams init_params_;
+    nixl_b_params_t custom_params_ = {
+        {"pack_threshold", "4096"},
+        {"pack_container_size", "16384"},
+        {"pack_gc_ratio", "0.5"},
+    };
+    std::vector<nixlBackendMD *> obj_metadata_;
+
+    void
+    SetUp() override {
+        createEngine (std::chrono::microseconds (0));
+    }
+
+    void
+    TearDown() override {
+        destroyEngine();
+    }
+
+    void
+    createEngine (std::chrono::microseconds latency) {
+        init_params_.localAgent = "test-agent";
+        init_params_.type = "OBJ";
+        init_params_.customParams = &custom_params_;
+        init_params_.enableProgTh = false;
+        init_params_.pthrDelay = 0;
+        init_params_.syncMode = nixl_thread_sync_t::NIXL_THREAD_SYNC_RW;
+
+        fs_s3_client_ = std::make_shared<FsS3Client> (latency);
+        obj_engine_ = std::make_unique<nixlObjEngine> (&init_params_, fs_s3_client_);
+
+        for (size_t i = 0; i < num_keys_; ++i) {
+            nixlBlobDesc remote_desc;
+            remote_desc.devId = i;
+            remote_desc.metaInfo = "key-" + std::to_string (i);
+            nixlBackendMD *metadata = nullptr;
+            ASSERT_EQ (obj_engine_->registerMem (remote_desc, OBJ_SEG, metadata), NIXL_SUCCESS);
+            obj_metadata_.push_back (metadata);
+        }
+    }
+
+    void
+    destroyEngine() {
+        for (auto *metadata : obj_metadata_)
+            obj_engine_->deregisterMem (metadata);
+        obj_metadata_.clear();
+        obj_engine_.reset();
+        fs_s3_client_.reset();
+    }
+
+    static void
+    fillBuffer (std::vector<char> &buffer, uint64_t dev_id, char seed) {
+        for (size_t i = 0; i < buffer.size(); ++i)
+            buffer[i] = static_cast<char> (seed + dev_id * 7 + i % 251);
+    }
+
+    static bool
+    waitFor (const std::function<bool()> &predicate) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds (5);
+        while (!predicate()) {
+            if (std::chrono::steady_clock::now() > deadline) return false;
+            std::this_thread::sleep_for (std::chrono::milliseconds (1));
+        }
+        return true;
+    }
+
+    nixlBackendReqH *
+    postTransfer (nixl_xfer_op_t operation,
+                  std::vector<std::vector<char>> &buffers,
+                  const std::vector<uint64_t> &dev_ids) {
+        nixl_meta_dlist_t local_descs (DRAM_SEG);
+        nixl_meta_dlist_t remote_descs (OBJ_SEG);
+        for (size_t i = 0; i < dev_ids.size(); ++i) {
+            local_descs.addDesc (nixlMetaDesc (
+                reinterpret_cast<uintptr_t> (buffers[i].data()), buffers[i].size(), 0));
+            remote_descs.addDesc (nixlMetaDesc (0, buffers[i].size(), dev_ids[i]));
+        }
+
+        nixlBackendReqH *handle = nullptr;
+        EXPECT_EQ (
+            obj_engine_->prepXfer (
+                operation, local_descs, remote_descs, init_params_.localAgent, handle, nullptr),
+            NIXL_SUCCESS);
+        EXPECT_EQ (
+            obj_engine_->postXfer (
+                operation, local_descs, remote_descs, init_params_.localAgent, handle, nullptr),
+            NIXL_IN_PROG);
+        return handle;
+    }
+
+    void
+    waitTransfer (nixlBackendReqH *handle) {
+        nixl_status_t status;
+        do {
+            status = obj_engine_->checkXfer (handle);
+        } while (status == NIXL_IN_PROG);
+        EXPECT_EQ (status, NIXL_SUCCESS);
+
+        obj_engine_->releaseReqH (handle);
+    }
+
+    void
+    transfer (nixl_xfer_op_t operation,
+              std::vector<std::vector<char>> &buffers,
+              const std::vector<uint64_t> &dev_ids) {
+        waitTransfer (postTransfer (operation, buffers, dev_ids));
+    }
+
+    void
+    writeKeys (const std::vector<uint64_t> &dev_ids, size_t size, char seed) {
+        std::vector<std::vector<char>> buffers (dev_ids.size(), std::vector<char> (size));
+        for (size_t i = 0; i < dev_ids.size(); ++i)
+            fillBuffer (buffers[i], dev_ids[i], seed);
+        transfer (NIXL_WRITE, buffers, dev_ids);
+    }
+
+    void
+    verifyKeys (const std::vector<uint64_t> &dev_ids, size_t size, char seed) {
+        std::vector<std::vector<char>> buffers (dev_ids.size(), std::vector<char> (size, 0));
+        transfer (NIXL_READ, buffers, dev_ids);
+        for (size_t i = 0; i < dev_ids.size(); ++i) {
+            std::vector<char> expected (size);
+            fillBuffer (expected, dev_ids[i], seed);
+            EXPECT_EQ (buffers[i], expected) << "Mismatch in key " << dev_ids[i];
+        }
+    }
+
+    static std::vector<uint64_t>
+    range (uint64_t first, uint64_t last) {
+        std::vector<uint64_t> dev_ids;
+        for (uint64_t i = first; i < last; ++i)
+            dev_ids.push_back (i);
+        return dev_ids;
+    }
+};
+
+TEST_F (ObjPackTestFixture, SmallWritesShareContainer) {
+    writeKeys (range (0, 8), block_size_, 'a');
+
+    EXPECT_EQ (fs_s3_client_->puts_, 1);
+    EXPECT_EQ (fs_s3_client_->getObjectCount(), 1);
+
+    verifyKeys (range (0, 8), block_size_, 'a');
+    EXPECT_EQ (fs_s3_client_->gets_, 8);
+}
+
+TEST_F (ObjPackTestFixture, ContainerSizeIsRespected) {
+    writeKeys (range (0, 40), block_size_, 'a');
+
+    EXPECT_EQ (fs_s3_client_->puts_, 3);
+    EXPECT_EQ (fs_s3_client_->getObjectCount(), 3);
+
+    verifyKeys (range (0, 40), block_size_, 'a');
+}
+
+TEST_F (ObjPackTestFixture, LargeWritesBypassPacking) {
+    writeKeys (range (0, 2), 8192, 'a');
+
+    EXPECT_EQ (fs_s3_client_->puts_, 2);
+    EXPECT_EQ (fs_s3_client_->getObjectCount(), 2);
+
+    verifyKeys (range (0, 2), 8192, 'a');
+}
+
+TEST_F (ObjPackTestFixture, ReadFromOffsetInPackedObject) {
+    writeKeys ({3}, block_size_, 'a');
+
+    std::vector<char> expected (block_size_);
+    fillBuffer (expected, 3, 'a');
+
+    const size_t offset = 100;
+    const size_t length = 200;
+    std::vector<char> buffer (length);
+    nixl_meta_dlist_t local_descs (DRAM_SEG);
+    nixl_meta_dlist_t remote_descs (OBJ_SEG);
+    local_descs.addDesc (nixlMetaDesc (reinterpret_cast<uintptr_t> (buffer.data()), length, 0));
+    remote_descs.addDesc (nixlMetaDesc (offset, length, 3));
+
+    nixlBackendReqH *handle = nullptr;
+    ASSERT_EQ (obj_engine_->prepXfer (
+                   NIXL_READ, local_descs, remote_descs, init_params_.localAgent, handle, nullptr),
+               NIXL_SUCCESS);
+    obj_engine_->postXfer (
+        NIXL_READ, local_descs, remote_descs, init_params_.localAgent, handle, nullptr);
+
+    nixl_status_t status;
+    do {
+        status = obj_engine_->checkXfer (handle);
+    } while (status == NIXL_IN_PROG);
+    EXPECT_EQ (status, NIXL_SUCCESS);
+    EXPECT_TRUE (std::equal (buffer.begin(), buffer.end(), expected.begin() + offset));
+
+    obj_engine_->releaseReqH (handle);
+}
+
+TEST_F (ObjPackTestFixture, OverwrittenContainerIsDeleted) {
+    writeKeys (range (0, 4), block_size_, 'a');
+    writeKeys (range (0, 4), block_size_, 'b');
+
+    EXPECT_TRUE (waitFor ([this]() { return fs_s3_client_->getObjectCount() == 1; }));
+    EXPECT_EQ (fs_s3_client_->deletes_, 1);
+
+    verifyKeys (range (0, 4), block_size_, 'b');
+}
+
+TEST_F (ObjPackTestFixture, SparseContainerIsCompacted) {
+    writeKeys (range (0, 4), block_size_, 'a');
+    writeKeys (range (1, 4), block_size_, 'b');
+
+    // The first container keeps a single live entry out of four and is rewritten
+    EXPECT_TRUE (waitFor ([this]() {
+        return fs_s3_client_->deletes_ == 1 && fs_s3_client_->getObjectCount() == 2;
+    }));
+    EXPECT_EQ (fs_s3_client_->puts_, 3);
+
+    verifyKeys ({0}, block_size_, 'a');
+    verifyKeys (range (1, 4), block_size_, 'b');
+}
+
+TEST_F (ObjPackTestFixture, DirectWriteInvalidatesPackedObject) {
+    writeKeys ({0, 1}, block_size_, 'a');
+    writeKeys ({0}, 8192, 'b');
+
+    verifyKeys ({0}, 8192, 'b');
+    verifyKeys ({1}, block_size_, 'a');
+}
+
+TEST_F (ObjPackTestFixture, DirectWriteOverridesPackedWriteInFlight) {
+    // The packed write completes after the direct one, and must not be indexed over it
+    fs_s3_client_->slow_put_prefix_ = "nixl-pack/";
+    fs_s3_client_->slow_put_latency_ = std::chrono::milliseconds (50);
+
+    std::vector<std::vector<char>> packed (1, std::vector<char> (block_size_));
+    fillBuffer (packed[0], 0, 'a');
+    auto *handle = postTransfer (NIXL_WRITE, packed, {0});
+    writeKeys ({0}, 8192, 'b');
+    waitTransfer (handle);
+
+    verifyKeys ({0}, 8192, 'b');
+}
+
+TEST_F (ObjPackTestFixture, DestroyWithCompactionInFlight) {
+    destroyEngine();
+    createEngine (std::chrono::milliseconds (20));
+    writeKeys (range (0, 4), block_size_, 'a');
+    writeKeys (range (1, 4), block_size_, 'b');
+
+    // The engine waits for the compaction it just started
+    destroyEngine();
+    createEngine (std::chrono::microseconds (0));
+}
+
+TEST_F (ObjPackTestFixture, InvalidParamsFailInit) {
+    destroyEngine();
+    for (const auto &[key, value] : std::vector<std::pair<std::string, std::string>>{
+             {"pack_threshold", "4k"},
+             {"pack_container_size", "-1"},
+             {"pack_gc_ratio", "half"},
+             {"pack_gc_ratio", "2"},
+         }) {
+        nixl_b_params_t params = custom_params_;
+        params[key] = value;
+        init_params_.customParams = &params;
+        nixlObjEngine engine (&init_params_, std::make_shared<FsS3Client> (
+                                                 std::chrono::microseconds (0)));
+        EXPECT_TRUE (engine.getInitErr()) << key << "=" << value;
+    }
+    createEngine (std::chrono::microseconds (0));
+}
+
+TEST_F (ObjPackTestFixture, PackingReducesRequestsWithLatency) {
+    const auto dev_ids = range (0, num_keys_);
+    auto timeWrites = [&]() {
+        const auto start = std::chrono::steady_clock::now();
+        writeKeys (dev_ids, block_size_, 'a');
+        return std::chrono::duration_cast<std::chrono::microseconds> (
+                   std::chrono::steady_clock::now() - start)
+            .count();
+    };
+
+    destroyEngine();
+    createEngine (std::chrono::milliseconds (2));
+    const auto packed_us = timeWrites();
+    const size_t packed_puts = fs_s3_client_->puts_;
+
+    destroyEngine();
+    custom_params_.erase ("pack_threshold");
+    createEngine (std::chrono::milliseconds (2));
+    const auto unpacked_us = timeWrites();
+    const size_t unpacked_puts = fs_s3_client_->puts_;
+
+    RecordProperty ("packed_us", std::to_string (packed_us));
+    RecordProperty ("unpacked_us", std::to_string (unpacked_us));
+    EXPECT_EQ (unpacked_puts, num_keys_);
+    EXPECT_EQ (packed_puts, num_keys_ * block_size_ / 16384);
+}
+
+} // namespace gtest::obj
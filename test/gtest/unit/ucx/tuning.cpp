@@ -0,0 +1,122 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <unistd.h>
+
+#include "tuning.h"
+
+namespace gtest::ucx {
+
+class UcxTuneProfileTest : public testing::Test {
+protected:
+    std::string path_;
+
+    void
+    SetUp() override {
+        char path[] = "/tmp/nixl_ucx_tune_XXXXXX";
+        const int fd = mkstemp (path);
+        ASSERT_GE (fd, 0);
+        close (fd);
+        path_ = path;
+    }
+
+    void
+    TearDown() override {
+        std::remove (path_.c_str());
+    }
+
+    void
+    writeFile (const std::string &content) {
+        std::ofstream file (path_, std::ios::trunc);
+        file << content;
+    }
+};
+
+TEST (UcxConfigListTest, ParseAndFormat) {
+    const auto list = nixl::ucx::parseConfigList (" UCX_TLS=shm,tcp  RNDV_THRESH=8k ");
+    ASSERT_TRUE (list.has_value());
+    ASSERT_EQ (list->size(), 2);
+    EXPECT_EQ ((*list)[0], std::make_pair (std::string ("TLS"), std::string ("shm,tcp")));
+    EXPECT_EQ ((*list)[1], std::make_pair (std::string ("RNDV_THRESH"), std::string ("8k")));
+    EXPECT_EQ (nixl::ucx::formatConfigList (*list), "TLS=shm,tcp RNDV_THRESH=8k");
+
+    EXPECT_TRUE (nixl::ucx::parseConfigList ("")->empty());
+    EXPECT_FALSE (nixl::ucx::parseConfigList ("TLS").has_value());
+    EXPECT_FALSE (nixl::ucx::parseConfigList ("=tcp").has_value());
+}
+
+TEST_F (UcxTuneProfileTest, SaveAndLoad) {
+    nixl::ucx::tuneProfile profile;
+    profile.addEntry (
+        {65537, std::numeric_limits<size_t>::max(), 9000.5, {{"MAX_RMA_RAILS", "4"}}});
+    profile.addEntry ({0, 65536, 1200, {{"ZCOPY_THRESH", "16k"}, {"MAX_RMA_RAILS", "1"}}});
+    ASSERT_TRUE (profile.save (path_));
+
+    const auto loaded = nixl::ucx::tuneProfile::load (path_);
+    ASSERT_TRUE (loaded.has_value());
+    ASSERT_EQ (loaded->getEntries().size(), 2);
+
+    const auto &small = loaded->getEntries()[0];
+    EXPECT_EQ (small.minSize, 0);
+    EXPECT_EQ (small.maxSize, 65536);
+    EXPECT_DOUBLE_EQ (small.bandwidth, 1200);
+    EXPECT_EQ (nixl::ucx::formatConfigList (small.config), "ZCOPY_THRESH=16k MAX_RMA_RAILS=1");
+
+    const auto &large = loaded->getEntries()[1];
+    EXPECT_EQ (large.maxSize, std::numeric_limits<size_t>::max());
+    EXPECT_EQ (nixl::ucx::formatConfigList (large.config), "MAX_RMA_RAILS=4");
+}
+
+TEST_F (UcxTuneProfileTest, Lookup) {
+    writeFile ("# comment\n"
+               "4096 16384 100 ZCOPY_THRESH=auto\n"
+               "\n"
+               "1048576 4194304 900 ZCOPY_THRESH=16k  # trailing comment\n");
+
+    const auto profile = nixl::ucx::tuneProfile::load (path_);
+    ASSERT_TRUE (profile.has_value());
+
+    EXPECT_EQ (profile->lookup (8192)->minSize, 4096);
+    EXPECT_EQ (profile->lookup (2 * 1048576)->minSize, 1048576);
+    // Out of range sizes resolve to the closest range
+    EXPECT_EQ (profile->lookup (0)->minSize, 4096);
+    EXPECT_EQ (profile->lookup (32768)->minSize, 4096);
+    EXPECT_EQ (profile->lookup (1000000)->minSize, 1048576);
+    EXPECT_EQ (profile->lookup (1ull << 30)->minSize, 1048576);
+
+    EXPECT_EQ (nixl::ucx::tuneProfile().lookup (4096), nullptr);
+}
+
+TEST_F (UcxTuneProfileTest, InvalidProfile) {
+    writeFile ("4096 100 ZCOPY_THRESH=auto\n");
+    EXPECT_FALSE (nixl::ucx::tuneProfile::load (path_).has_value());
+
+    writeFile ("16384 4096 100\n");
+    EXPECT_FALSE (nixl::ucx::tuneProfile::load (path_).has_value());
+
+    writeFile ("0 4096 100 ZCOPY_THRESH\n");
+    EXPECT_FALSE (nixl::ucx::tuneProfile::load (path_).has_value());
+
+    EXPECT_FALSE (nixl::ucx::tuneProfile::load ("/nonexistent/profile").has_value());
+}
+
+} // namespace gtest::ucx
@@ -0,0 +1,292 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Measures the latency from a block directory lookup to the completion of the transfer of
+ * the blocks found, with many agents in this process. Every agent is a directory shard and
+ * publishes the blocks of its buffer, and the first agent looks up a random run of
+ * consecutive blocks, e.g., the KV blocks of a cached prefix, then reads them from their
+ * holders. The shards serve queries from a thread polling their notifications.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "nixl.h"
+#include "absl/strings/numbers.h"
+
+namespace {
+
+struct benchOptions {
+    std::string backend = "UCX";
+    size_t agents = 16;
+    size_t blocks = 1024;
+    size_t blockSize = 64 * 1024;
+    size_t lookupBlocks = 32;
+    size_t iters = 1000;
+};
+
+void printUsage(const char *prog) {
+    std::cout << "Usage: " << prog << " [options]\n"
+              << "  --backend B        Backend to transfer with (default UCX)\n"
+              << "  --agents N         Agents in the process, at least 2 (default 16)\n"
+              << "  --blocks N         Blocks published per agent (default 1024)\n"
+              << "  --block-size BYTES Block size (default 64K)\n"
+              << "  --lookup-blocks N  Blocks per lookup (default 32)\n"
+              << "  --iters N          Lookups (default 1000)\n";
+}
+
+bool parseArgs(int argc, char *argv[], benchOptions &opts) {
+    for (int i = 1; i < argc; i++) {
+        const std::string arg(argv[i]);
+        if (arg == "-h" || arg == "--help" || i + 1 == argc)
+            return false;
+
+        const std::string value(argv[++i]);
+        if (arg == "--backend") {
+            opts.backend = value;
+        } else if (arg == "--agents") {
+            if (!absl::SimpleAtoi(value, &opts.agents) || opts.agents < 2)
+                return false;
+        } else if (arg == "--blocks") {
+            if (!absl::SimpleAtoi(value, &opts.blocks) || opts.blocks == 0)
+                return false;
+        } else if (arg == "--block-size") {
+            if (!absl::SimpleAtoi(value, &opts.blockSize) || opts.blockSize == 0)
+                return false;
+        } else if (arg == "--lookup-blocks") {
+            if (!absl::SimpleAtoi(value, &opts.lookupBlocks) || opts.lookupBlocks == 0)
+                return false;
+        } else if (arg == "--iters") {
+            if (!absl::SimpleAtoi(value, &opts.iters) || opts.iters == 0)
+                return false;
+        } else {
+            return false;
+        }
+    }
+    return opts.lookupBlocks <= opts.blocks * (opts.agents - 1);
+}
+
+std::string agentName(size_t i) {
+    return "dir_bench_" + std::to_string(i);
+}
+
+struct benchAgent {
+    std::unique_ptr<nixlAgent> agent;
+    std::vector<char> buffer;
+};
+
+bool setupAgents(const benchOptions &opts, std::vector<benchAgent> &agents) {
+    nixlAgentConfig cfg(false, false, 0, nixl_thread_sync_t::NIXL_THREAD_SYNC_RW);
+    std::vector<std::string> members;
+    for (size_t i = 0; i < opts.agents; i++) {
+        benchAgent &bench_agent = agents.emplace_back();
+        bench_agent.agent = std::make_unique<nixlAgent>(agentName(i), cfg);
+        // The first agent only reads, into a buffer of one lookup
+        bench_agent.buffer.resize(opts.blockSize * (i ? opts.blocks : opts.lookupBlocks));
+        members.push_back(agentName(i));
+
+        nixl_b_params_t params;
+        nixl_mem_list_t mems;
+        nixlBackendH *backend_h;
+        if (bench_agent.agent->getPluginParams(opts.backend, mems, params) != NIXL_SUCCESS ||
+            bench_agent.agent->createBackend(opts.backend, params, backend_h) != NIXL_SUCCESS) {
+            std::cerr << "Failed to create backend " << opts.backend << "\n";
+            return false;
+        }
+
+        nixl_reg_dlist_t descs(DRAM_SEG);
+        descs.addDesc(nixlBlobDesc((uintptr_t)bench_agent.buffer.data(),
+                                   bench_agent.buffer.size(), 0));
+        if (bench_agent.agent->registerMem(descs) != NIXL_SUCCESS) {
+            std::cerr << "Failed to register memory\n";
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < opts.agents; i++) {
+        nixl_blob_t md;
+        if (agents[i].agent->getLocalMD(md) != NIXL_SUCCESS)
+            return false;
+        for (size_t j = 0; j < opts.agents; j++) {
+            std::string name;
+            if (i != j && agents[j].agent->loadRemoteMD(md, name) != NIXL_SUCCESS) {
+                std::cerr << "Failed to exchange metadata\n";
+                return false;
+            }
+        }
+    }
+
+    // Block j of agent i has key (i - 1) * blocks + j, so consecutive keys span holders
+    // only at the ends of their runs
+    for (size_t i = 0; i < opts.agents; i++) {
+        if (agents[i].agent->setDirMembers(members) != NIXL_SUCCESS)
+            return false;
+        if (i == 0)
+            continue;
+
+        std::vector<uint64_t> keys;
+        nixl_xfer_dlist_t descs(DRAM_SEG);
+        for (size_t j = 0; j < opts.blocks; j++) {
+            keys.push_back((i - 1) * opts.blocks + j);
+            descs.addDesc(nixlBasicDesc((uintptr_t)agents[i].buffer.data() + j * opts.blockSize,
+                                        opts.blockSize, 0));
+        }
+        if (agents[i].agent->publishBlocks(keys, descs) != NIXL_SUCCESS) {
+            std::cerr << "Failed to publish blocks\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+// Polls the notifications of the shards, so that they answer the queries
+void serveShards(std::vector<benchAgent> &agents, std::atomic<bool> &stop) {
+    while (!stop) {
+        for (size_t i = 1; i < agents.size(); i++) {
+            nixl_notifs_t notifs;
+            agents[i].agent->getNotifs(notifs);
+        }
+    }
+}
+
+bool lookup(nixlAgent &agent, const std::vector<uint64_t> &keys,
+            std::vector<nixl_dir_blocks_t> &blocks) {
+    nixlDirLookupH *lookup_h;
+    if (agent.lookupBlocks(keys, lookup_h) != NIXL_SUCCESS)
+        return false;
+
+    nixl_status_t status;
+    do {
+        status = agent.getLookupStatus(lookup_h);
+    } while (status == NIXL_IN_PROG);
+
+    blocks.clear();
+    if (status == NIXL_SUCCESS)
+        status = agent.getLookupResults(lookup_h, blocks);
+    agent.releaseLookup(lookup_h);
+    return status == NIXL_SUCCESS;
+}
+
+bool readBlocks(const benchOptions &opts, benchAgent &reader,
+                const std::vector<nixl_dir_blocks_t> &blocks) {
+    std::vector<nixlXferReqH *> reqs;
+    size_t offset = 0;
+    bool ok = true;
+    for (const auto &holder : blocks) {
+        nixl_xfer_dlist_t local(DRAM_SEG);
+        for (int i = 0; i < holder.descs.descCount(); i++, offset += opts.blockSize)
+            local.addDesc(nixlBasicDesc((uintptr_t)reader.buffer.data() + offset,
+                                        opts.blockSize, 0));
+
+        nixlXferReqH *req;
+        if (reader.agent->createXferReq(NIXL_READ, local, holder.descs, holder.agent, req) !=
+            NIXL_SUCCESS)
+            return false;
+        if (reader.agent->postXferReq(req) < 0)
+            ok = false;
+        reqs.push_back(req);
+    }
+
+    for (auto &req : reqs) {
+        nixl_status_t status;
+        do {
+            status = reader.agent->getXferStatus(req);
+        } while (ok && status == NIXL_IN_PROG);
+        ok = ok && status == NIXL_SUCCESS;
+        reader.agent->releaseXferReq(req);
+    }
+    return ok;
+}
+
+double percentile(std::vector<double> &samples, double p) {
+    std::sort(samples.begin(), samples.end());
+    return samples[std::min(samples.size() - 1, size_t(p * samples.size()))];
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    benchOptions opts;
+    if (!parseArgs(argc, argv, opts)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::vector<benchAgent> agents;
+    if (!setupAgents(opts, agents))
+        return 1;
+
+    std::atomic<bool> stop = false;
+    std::thread server([&]() { serveShards(agents, stop); });
+
+    std::mt19937_64 gen(2025);
+    const uint64_t num_keys = opts.blocks * (opts.agents - 1);
+    std::uniform_int_distribution<uint64_t> first_key(0, num_keys - opts.lookupBlocks);
+    std::vector<double> lookup_us, total_us;
+    std::vector<nixl_dir_blocks_t> blocks;
+    bool ok = true;
+
+    // The first lookups wait for the publications to reach the shards
+    for (size_t found = 0; ok && found < opts.lookupBlocks;) {
+        std::vector<uint64_t> keys(opts.lookupBlocks);
+        std::iota(keys.begin(), keys.end(), num_keys - opts.lookupBlocks);
+        ok = lookup(*agents[0].agent, keys, blocks);
+        found = 0;
+        for (const auto &holder : blocks)
+            found += holder.keys.size();
+    }
+
+    for (size_t iter = 0; ok && iter < opts.iters; iter++) {
+        std::vector<uint64_t> keys(opts.lookupBlocks);
+        std::iota(keys.begin(), keys.end(), first_key(gen));
+
+        const auto start = std::chrono::steady_clock::now();
+        ok = lookup(*agents[0].agent, keys, blocks);
+        const auto found = std::chrono::steady_clock::now();
+        ok = ok && readBlocks(opts, agents[0], blocks);
+        const auto done = std::chrono::steady_clock::now();
+
+        lookup_us.push_back(std::chrono::duration<double, std::micro>(found - start).count());
+        total_us.push_back(std::chrono::duration<double, std::micro>(done - start).count());
+    }
+
+    stop = true;
+    server.join();
+    if (!ok) {
+        std::cerr << "Lookup or transfer failed\n";
+        return 1;
+    }
+
+    std::cout << opts.agents << " agents, " << opts.iters << " lookups of "
+              << opts.lookupBlocks << " blocks of " << opts.blockSize << " bytes\n"
+              << std::fixed << std::setprecision(1)
+              << "  lookup:             p50 " << percentile(lookup_us, 0.5) << " us, p99 "
+              << percentile(lookup_us, 0.99) << " us\n"
+              << "  lookup to transfer: p50 " << percentile(total_us, 0.5) << " us, p99 "
+              << percentile(total_us, 0.99) << " us\n";
+    return 0;
+}
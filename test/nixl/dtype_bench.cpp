@@ -0,0 +1,210 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Measures the element type conversions of transfers. For each pair of a 16-bit local type
+ * and an FP8 remote type, a buffer of normally distributed values is converted to FP8 and
+ * back, and the throughput of both directions is reported next to a plain copy of the
+ * buffer. The effective bandwidth is the rate at which local bytes cross a link of the
+ * given bandwidth when they travel as FP8 and the conversion overlaps the wire, against
+ * the link bandwidth of an unconverted transfer. The round trip error of the values in the
+ * normal FP8 range is reported as the largest and the RMS relative error.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "nixl_types.h"
+#include "dtype_convert.h"
+#include "absl/strings/numbers.h"
+
+namespace {
+
+struct benchOptions {
+    size_t numElems = 1UL << 27;
+    size_t iters = 10;
+    double linkGBps = 25;
+};
+
+void printUsage(const char *prog) {
+    std::cout << "Usage: " << prog << " [options]\n"
+              << "  --elems N              Elements per buffer (default 128M)\n"
+              << "  --iters N              Conversions timed per direction (default 10)\n"
+              << "  --link-gbps GBPS       Link bandwidth of the effective bandwidth "
+                 "(default 25)\n";
+}
+
+bool parseArgs(int argc, char *argv[], benchOptions &opts) {
+    for (int i = 1; i < argc; i++) {
+        const std::string arg(argv[i]);
+        if (arg == "-h" || arg == "--help" || i + 1 == argc)
+            return false;
+
+        const std::string value(argv[++i]);
+        if (arg == "--elems") {
+            if (!absl::SimpleAtoi(value, &opts.numElems) || opts.numElems == 0)
+                return false;
+        } else if (arg == "--iters") {
+            if (!absl::SimpleAtoi(value, &opts.iters) || opts.iters == 0)
+                return false;
+        } else if (arg == "--link-gbps") {
+            if (!absl::SimpleAtod(value, &opts.linkGBps) || opts.linkGBps <= 0)
+                return false;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+float bf16Value(uint16_t code) {
+    const uint32_t bits = uint32_t(code) << 16;
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+uint16_t bf16Code(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return uint16_t(bits >> 16);
+}
+
+float fp16Value(uint16_t code) {
+    const int exp  = (code >> 10) & 0x1f;
+    const int mant = code & 0x3ff;
+    const float value = (exp == 0) ? std::ldexp(float(mant), -24)
+                                   : std::ldexp(float(mant | 0x400), exp - 25);
+    return (code & 0x8000) ? -value : value;
+}
+
+// Truncates a value of the normal FP16 range, smaller ones are flushed to zero
+uint16_t fp16Code(float value) {
+    int exp;
+    const float mant = std::frexp(std::fabs(value), &exp);
+    const uint16_t sign = std::signbit(value) ? 0x8000 : 0;
+    if (exp + 14 <= 0)
+        return sign;
+    return sign | uint16_t((exp + 14) << 10) | (uint16_t(mant * 2048) & 0x3ff);
+}
+
+const char *typeName(nixl_dtype_t type) {
+    switch (type) {
+        case NIXL_DTYPE_BF16:
+            return "BF16";
+        case NIXL_DTYPE_FP16:
+            return "FP16";
+        case NIXL_DTYPE_FP8_E4M3:
+            return "E4M3";
+        case NIXL_DTYPE_FP8_E5M2:
+            return "E5M2";
+    }
+    return "?";
+}
+
+template <typename FUNC>
+double timeGBps(size_t bytes, size_t iters, FUNC &&func) {
+    func();
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iters; i++)
+        func();
+    const double sec = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    return double(bytes) * iters / sec / 1e9;
+}
+
+void run(const benchOptions &opts, nixl_dtype_t local, nixl_dtype_t remote) {
+    nixl_xfer_conv_t conv;
+    conv.localType  = local;
+    conv.remoteType = remote;
+
+    const bool bf16 = (local == NIXL_DTYPE_BF16);
+    const size_t local_bytes = opts.numElems * sizeof(uint16_t);
+    std::vector<uint16_t> src(opts.numElems);
+    std::vector<uint16_t> back(opts.numElems);
+    std::vector<uint16_t> copy(opts.numElems);
+    std::vector<uint8_t> wire(opts.numElems);
+
+    // Values of the range an FP8 KV cache is typically scaled to
+    std::mt19937 gen(42);
+    std::normal_distribution<float> dist(0.0f, 16.0f);
+    for (auto &code : src) {
+        const float value = dist(gen);
+        code = bf16 ? bf16Code(value) : fp16Code(value);
+    }
+
+    const double copy_gbps = timeGBps(local_bytes, opts.iters, [&]() {
+        std::memcpy(copy.data(), src.data(), local_bytes);
+    });
+    const double out_gbps = timeGBps(local_bytes, opts.iters, [&]() {
+        nixlDtype::toRemote(conv, src.data(), wire.data(), opts.numElems);
+    });
+    const double in_gbps = timeGBps(local_bytes, opts.iters, [&]() {
+        nixlDtype::toLocal(conv, wire.data(), back.data(), opts.numElems);
+    });
+
+    const float min_normal = (remote == NIXL_DTYPE_FP8_E4M3) ? 0x1p-6f : 0x1p-14f;
+    double max_err = 0;
+    double sum_sq  = 0;
+    size_t counted = 0;
+    for (size_t i = 0; i < opts.numElems; i++) {
+        const double x = bf16 ? bf16Value(src[i]) : fp16Value(src[i]);
+        const double y = bf16 ? bf16Value(back[i]) : fp16Value(back[i]);
+        if (std::fabs(x) < min_normal)
+            continue;
+        const double err = std::fabs(y - x) / std::fabs(x);
+        max_err = std::max(max_err, err);
+        sum_sq += err * err;
+        counted++;
+    }
+
+    // FP8 halves the bytes on the wire, so the link carries local bytes at twice its rate
+    // unless the slower conversion direction falls behind
+    const double effective = std::min({2 * opts.linkGBps, out_gbps, in_gbps});
+
+    std::cout << "  " << typeName(local) << " -> " << typeName(remote) << std::fixed
+              << std::setprecision(2) << ": copy " << copy_gbps << " GB/s, to remote "
+              << out_gbps << " GB/s, to local " << in_gbps << " GB/s, effective "
+              << effective << " GB/s (" << effective / opts.linkGBps << "x)"
+              << std::setprecision(4) << ", max error " << max_err << ", rms error "
+              << (counted ? std::sqrt(sum_sq / counted) : 0.0) << "\n";
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    benchOptions opts;
+    if (!parseArgs(argc, argv, opts)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::cout << opts.numElems << " elements, " << opts.iters << " iterations, link "
+              << opts.linkGBps << " GB/s\n";
+    for (const auto local : {NIXL_DTYPE_BF16, NIXL_DTYPE_FP16})
+        for (const auto remote : {NIXL_DTYPE_FP8_E4M3, NIXL_DTYPE_FP8_E5M2})
+            run(opts, local, remote);
+    return 0;
+}
@@ -0,0 +1,276 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Compares two ways of serving blocks of a local file to a remote reader. In the copy path
+ * the owner reads the blocks of each request into registered DRAM with pread() and the reader
+ * reads them from there, in the direct path the file is registered as FILE_SEG and the reader
+ * reads the blocks from the file pages. Both agents run in this process, so the transfers go
+ * through the backend's loopback path. The file should be on tmpfs or a DAX mount, or be in
+ * the page cache, to leave the disk out of the measurement.
+ */
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "nixl.h"
+#include "absl/strings/numbers.h"
+
+namespace {
+
+struct benchOptions {
+    std::string backend = "UCX";
+    std::string file;
+    std::string residency = "none";
+    size_t blockSize = 1UL << 20;
+    size_t blocks = 256;
+    size_t batch = 16;
+    size_t iters = 4;
+};
+
+void printUsage(const char *prog) {
+    std::cout << "Usage: " << prog << " [options]\n"
+              << "  --backend B       Backend to transfer with (default UCX)\n"
+              << "  --file PATH       File to serve, created with the blocks if missing\n"
+              << "                    (default a temporary file in /dev/shm)\n"
+              << "  --residency P     file_residency backend parameter (default none)\n"
+              << "  --block-size N    Block size (default 1M)\n"
+              << "  --blocks N        Blocks in the file (default 256)\n"
+              << "  --batch N         Blocks read per request (default 16)\n"
+              << "  --iters N         Passes over the file (default 4)\n";
+}
+
+bool parseArgs(int argc, char *argv[], benchOptions &opts) {
+    for (int i = 1; i < argc; i++) {
+        const std::string arg(argv[i]);
+        if (arg == "-h" || arg == "--help" || i + 1 == argc)
+            return false;
+
+        const std::string value(argv[++i]);
+        if (arg == "--backend") {
+            opts.backend = value;
+        } else if (arg == "--file") {
+            opts.file = value;
+        } else if (arg == "--residency") {
+            opts.residency = value;
+        } else if (arg == "--block-size") {
+            if (!absl::SimpleAtoi(value, &opts.blockSize) || opts.blockSize == 0)
+                return false;
+        } else if (arg == "--blocks") {
+            if (!absl::SimpleAtoi(value, &opts.blocks) || opts.blocks == 0)
+                return false;
+        } else if (arg == "--batch") {
+            if (!absl::SimpleAtoi(value, &opts.batch) || opts.batch == 0)
+                return false;
+        } else if (arg == "--iters") {
+            if (!absl::SimpleAtoi(value, &opts.iters) || opts.iters == 0)
+                return false;
+        } else {
+            return false;
+        }
+    }
+    return opts.batch <= opts.blocks;
+}
+
+// Opens the file to serve, filling it with the blocks when it is shorter
+int openFile(const benchOptions &opts) {
+    int fd;
+    if (opts.file.empty()) {
+        char path[] = "/dev/shm/nixl_file_serve_XXXXXX";
+        fd = mkstemp(path);
+        if (fd >= 0)
+            unlink(path);
+    } else {
+        fd = open(opts.file.c_str(), O_RDWR | O_CREAT, 0644);
+    }
+    if (fd < 0)
+        return fd;
+
+    struct stat st;
+    const size_t file_size = opts.blockSize * opts.blocks;
+    if (fstat(fd, &st) == 0 && size_t(st.st_size) >= file_size)
+        return fd;
+
+    const std::vector<char> block(opts.blockSize, 'k');
+    for (size_t i = 0; i < opts.blocks; i++) {
+        if (pwrite(fd, block.data(), block.size(), i * opts.blockSize) != ssize_t(block.size())) {
+            close(fd);
+            return -1;
+        }
+    }
+    return fd;
+}
+
+struct benchResult {
+    double wallSec = 0;
+    bool ok = false;
+};
+
+class benchAgents {
+public:
+    benchAgents(const benchOptions &opts) {
+        nixlAgentConfig cfg(true, false, 0, nixl_thread_sync_t::NIXL_THREAD_SYNC_RW);
+        owner = std::make_unique<nixlAgent>("file_owner", cfg);
+        reader = std::make_unique<nixlAgent>("file_reader", cfg);
+
+        for (nixlAgent *agent : {owner.get(), reader.get()}) {
+            nixl_b_params_t params;
+            nixl_mem_list_t mems;
+            nixlBackendH *backend_h;
+            if (agent->getPluginParams(opts.backend, mems, params) != NIXL_SUCCESS)
+                return;
+            params["file_registration"] = "true";
+            params["file_residency"] = opts.residency;
+            if (agent->createBackend(opts.backend, params, backend_h) != NIXL_SUCCESS) {
+                std::cerr << "Failed to create backend " << opts.backend << "\n";
+                return;
+            }
+        }
+        valid = true;
+    }
+
+    // Loads the owner's metadata, after its registrations
+    bool connect() {
+        nixl_blob_t md;
+        std::string name;
+        return owner->getLocalMD(md) == NIXL_SUCCESS &&
+               reader->loadRemoteMD(md, name) == NIXL_SUCCESS;
+    }
+
+    std::unique_ptr<nixlAgent> owner;
+    std::unique_ptr<nixlAgent> reader;
+    bool valid = false;
+};
+
+bool waitXfer(nixlAgent &agent, nixlXferReqH *req) {
+    nixl_status_t status = agent.postXferReq(req);
+    while (status == NIXL_IN_PROG)
+        status = agent.getXferStatus(req);
+    return status == NIXL_SUCCESS;
+}
+
+benchResult run(const benchOptions &opts, int fd, bool direct) {
+    benchResult result;
+    benchAgents agents(opts);
+    if (!agents.valid)
+        return result;
+
+    const size_t request_size = opts.blockSize * opts.batch;
+    std::vector<char> dst(request_size);
+    nixl_reg_dlist_t dst_reg(DRAM_SEG);
+    dst_reg.addDesc(nixlBlobDesc((uintptr_t)dst.data(), dst.size(), 0));
+
+    // The copy path stages the blocks of a request in registered DRAM of the owner
+    std::vector<char> staging(direct ? 0 : request_size);
+    nixl_reg_dlist_t src_reg(direct ? FILE_SEG : DRAM_SEG);
+    if (direct)
+        src_reg.addDesc(nixlBlobDesc(0, opts.blockSize * opts.blocks, fd));
+    else
+        src_reg.addDesc(nixlBlobDesc((uintptr_t)staging.data(), staging.size(), 0));
+
+    if (agents.reader->registerMem(dst_reg) != NIXL_SUCCESS ||
+        agents.owner->registerMem(src_reg) != NIXL_SUCCESS) {
+        std::cerr << "Failed to register memory\n";
+        return result;
+    }
+    if (!agents.connect()) {
+        std::cerr << "Failed to exchange metadata\n";
+        return result;
+    }
+
+    nixl_xfer_dlist_t local(DRAM_SEG);
+    local.addDesc(nixlBasicDesc((uintptr_t)dst.data(), request_size, 0));
+
+    const size_t requests = opts.blocks / opts.batch;
+    const auto start = std::chrono::steady_clock::now();
+    bool ok = true;
+    for (size_t iter = 0; iter < opts.iters * requests && ok; iter++) {
+        const size_t offset = (iter % requests) * request_size;
+
+        nixl_xfer_dlist_t remote(direct ? FILE_SEG : DRAM_SEG);
+        if (direct) {
+            remote.addDesc(nixlBasicDesc(offset, request_size, fd));
+        } else {
+            if (pread(fd, staging.data(), request_size, offset) != ssize_t(request_size))
+                return result;
+            remote.addDesc(nixlBasicDesc((uintptr_t)staging.data(), request_size, 0));
+        }
+
+        nixlXferReqH *req;
+        if (agents.reader->createXferReq(NIXL_READ, local, remote, "file_owner", req) !=
+            NIXL_SUCCESS)
+            return result;
+        ok = waitXfer(*agents.reader, req);
+        agents.reader->releaseXferReq(req);
+    }
+    result.wallSec =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    agents.reader->invalidateRemoteMD("file_owner");
+    agents.owner->deregisterMem(src_reg);
+    agents.reader->deregisterMem(dst_reg);
+    result.ok = ok;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    benchOptions opts;
+    if (!parseArgs(argc, argv, opts)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    const int fd = openFile(opts);
+    if (fd < 0) {
+        std::cerr << "Failed to prepare the file to serve\n";
+        return 1;
+    }
+
+    const size_t requests = opts.blocks / opts.batch;
+    std::cout << opts.iters * requests << " reads of " << opts.batch << " blocks of "
+              << opts.blockSize << " bytes\n";
+
+    for (bool direct : {false, true}) {
+        const benchResult result = run(opts, fd, direct);
+        if (!result.ok) {
+            std::cerr << (direct ? "Direct" : "Copy") << " path failed\n";
+            close(fd);
+            return 1;
+        }
+
+        const double total_gb =
+            double(opts.blockSize) * opts.batch * requests * opts.iters / (1UL << 30);
+        std::cout << "  " << std::setw(8) << std::left << (direct ? "direct:" : "copy:")
+                  << std::fixed << std::setprecision(2) << total_gb / result.wallSec
+                  << " GB/s, " << std::setprecision(1)
+                  << result.wallSec * 1e6 / (requests * opts.iters) << " us per read\n";
+    }
+
+    close(fd);
+    return 0;
+}
@@ -0,0 +1,207 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Measures metadata exchange through the built-in metadata server with many agents in this
+ * process, all connected to a server embedded in it. Every agent publishes its metadata and
+ * fetches the metadata of all the others, then the first agent invalidates and publishes
+ * its metadata again, which the server pushes to the agents that fetched it. Each phase is
+ * timed until all the agents see its effect.
+ */
+
+#include <stdlib.h>
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "nixl.h"
+#include "nixl_md_server.h"
+#include "absl/strings/numbers.h"
+
+namespace {
+
+struct benchOptions {
+    std::string backend = "UCX";
+    size_t agents = 32;
+    size_t buffers = 64;
+    uint64_t commDelayUs = 1000;
+    size_t timeoutSec = 60;
+};
+
+void printUsage(const char *prog) {
+    std::cout << "Usage: " << prog << " [options]\n"
+              << "  --backend B        Backend of the agents (default UCX)\n"
+              << "  --agents N         Agents in the process, at least 2 (default 32)\n"
+              << "  --buffers N        Buffers registered per agent (default 64)\n"
+              << "  --comm-delay-us N  Delay between comm thread iterations (default 1000)\n"
+              << "  --timeout-sec N    Time limit of each phase (default 60)\n";
+}
+
+bool parseArgs(int argc, char *argv[], benchOptions &opts) {
+    for (int i = 1; i < argc; i++) {
+        const std::string arg(argv[i]);
+        if (arg == "-h" || arg == "--help" || i + 1 == argc)
+            return false;
+
+        const std::string value(argv[++i]);
+        if (arg == "--backend") {
+            opts.backend = value;
+        } else if (arg == "--agents") {
+            if (!absl::SimpleAtoi(value, &opts.agents) || opts.agents < 2)
+                return false;
+        } else if (arg == "--buffers") {
+            if (!absl::SimpleAtoi(value, &opts.buffers) || opts.buffers == 0)
+                return false;
+        } else if (arg == "--comm-delay-us") {
+            if (!absl::SimpleAtoi(value, &opts.commDelayUs))
+                return false;
+        } else if (arg == "--timeout-sec") {
+            if (!absl::SimpleAtoi(value, &opts.timeoutSec) || opts.timeoutSec == 0)
+                return false;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+struct benchAgent {
+    std::string name;
+    std::unique_ptr<nixlAgent> agent;
+    std::vector<char> buffer;
+};
+
+// Polls until every agent but the first satisfies the predicate, returns the elapsed time
+double waitAll(const benchOptions &opts, std::vector<benchAgent> &agents, size_t first,
+               const std::function<bool(benchAgent &)> &pred) {
+    const auto start = std::chrono::steady_clock::now();
+    const auto deadline = start + std::chrono::seconds(opts.timeoutSec);
+    for (size_t i = first; i < agents.size(); i++) {
+        while (!pred(agents[i])) {
+            if (std::chrono::steady_clock::now() > deadline)
+                return -1;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void printPhase(const std::string &phase, double sec, size_t ops, const std::string &unit) {
+    std::cout << "  " << std::setw(24) << std::left << phase << std::fixed
+              << std::setprecision(1) << sec * 1e3 << " ms";
+    if (ops)
+        std::cout << ", " << std::setprecision(0) << ops / sec << " " << unit << "/s";
+    std::cout << "\n";
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    benchOptions opts;
+    if (!parseArgs(argc, argv, opts)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    nixlMDServer server(0);
+    if (server.start() != NIXL_SUCCESS) {
+        std::cerr << "Failed to start the metadata server\n";
+        return 1;
+    }
+    const std::string address = "127.0.0.1:" + std::to_string(server.getPort());
+    setenv("NIXL_MD_SERVER", address.c_str(), 1);
+
+    std::vector<benchAgent> agents(opts.agents);
+    nixlAgentConfig cfg(false, false, 0, nixl_thread_sync_t::NIXL_THREAD_SYNC_RW, 1, 0,
+                        opts.commDelayUs);
+    for (size_t i = 0; i < opts.agents; i++) {
+        auto &agent = agents[i];
+        agent.name = "md_agent_" + std::to_string(i);
+        agent.agent = std::make_unique<nixlAgent>(agent.name, cfg);
+        agent.buffer.resize(opts.buffers * 4096);
+
+        nixlBackendH *backend_h;
+        nixl_reg_dlist_t reg(DRAM_SEG);
+        for (size_t b = 0; b < opts.buffers; b++)
+            reg.addDesc(nixlBlobDesc((uintptr_t)agent.buffer.data() + b * 4096, 4096, 0));
+        if (agent.agent->createBackend(opts.backend, {}, backend_h) != NIXL_SUCCESS ||
+            agent.agent->registerMem(reg) != NIXL_SUCCESS) {
+            std::cerr << "Failed to set agent " << agent.name << " up\n";
+            return 1;
+        }
+    }
+
+    nixl_blob_t md;
+    agents[0].agent->getLocalMD(md);
+    std::cout << opts.agents << " agents, " << md.size() << " bytes of metadata each, server "
+              << address << "\n";
+
+    // Fetches of all the peers are queued together and reach the server as batches
+    for (auto &agent : agents) {
+        if (agent.agent->sendLocalMD() != NIXL_SUCCESS)
+            return 1;
+        for (auto &peer : agents) {
+            if (&peer != &agent && agent.agent->fetchRemoteMD(peer.name) != NIXL_SUCCESS)
+                return 1;
+        }
+    }
+    const double exchange_sec = waitAll(opts, agents, 0, [&](benchAgent &agent) {
+        for (auto &peer : agents) {
+            if (&peer != &agent &&
+                agent.agent->checkRemoteMD(peer.name, {DRAM_SEG}) != NIXL_SUCCESS)
+                return false;
+        }
+        return true;
+    });
+    if (exchange_sec < 0) {
+        std::cerr << "All to all exchange timed out\n";
+        return 1;
+    }
+    printPhase("all to all exchange:", exchange_sec, opts.agents * (opts.agents - 1), "loads");
+
+    if (agents[0].agent->invalidateLocalMD() != NIXL_SUCCESS)
+        return 1;
+    const double inval_sec = waitAll(opts, agents, 1, [&](benchAgent &agent) {
+        return agent.agent->checkRemoteMD(agents[0].name, {DRAM_SEG}) == NIXL_ERR_NOT_FOUND;
+    });
+    if (inval_sec < 0) {
+        std::cerr << "Invalidation push timed out\n";
+        return 1;
+    }
+    printPhase("invalidation push:", inval_sec, 0, "");
+
+    if (agents[0].agent->sendLocalMD() != NIXL_SUCCESS)
+        return 1;
+    const double update_sec = waitAll(opts, agents, 1, [&](benchAgent &agent) {
+        return agent.agent->checkRemoteMD(agents[0].name, {DRAM_SEG}) == NIXL_SUCCESS;
+    });
+    if (update_sec < 0) {
+        std::cerr << "Update push timed out\n";
+        return 1;
+    }
+    printPhase("update push:", update_sec, 0, "");
+
+    agents.clear();
+    unsetenv("NIXL_MD_SERVER");
+    return 0;
+}
@@ -0,0 +1,402 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Measures the notification message rate between two agents of this process, and the CPU
+ * time the receiver spends per notification, for string and compact notifications.
+ *
+ * The sender keeps at most a window of notifications in flight, so that the rate is
+ * limited by the receiver. The receiver polls in its own thread, and its CPU time is
+ * measured with the thread CPU clock.
+ *
+ * With --consumers, notifications are also sent round robin to streams consumed by a
+ * thread each, once demultiplexed by the consumers from shared getNotifs calls, and once
+ * through a subscription per stream. The mean latency from send to consumption is reported.
+ */
+
+#include <time.h>
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "nixl.h"
+#include "absl/strings/numbers.h"
+
+namespace {
+
+struct benchOptions {
+    std::string backend = "UCX";
+    size_t count = 1000000;
+    size_t window = 1024;
+    size_t payload = 8;
+    size_t consumers = 0;
+};
+
+void printUsage(const char *prog) {
+    std::cout << "Usage: " << prog << " [options]\n"
+              << "  --backend B     Backend to send notifications with (default UCX)\n"
+              << "  --count N       Number of notifications (default 1000000)\n"
+              << "  --window N      Notifications in flight (default 1024)\n"
+              << "  --payload BYTES Payload size, at most " << compact_notif_max_payload
+              << " (default 8)\n"
+              << "  --consumers N   Also measure N consumer threads, one stream each (default 0)\n";
+}
+
+bool parseArgs(int argc, char *argv[], benchOptions &opts) {
+    for (int i = 1; i < argc; i++) {
+        const std::string arg(argv[i]);
+        if (arg == "-h" || arg == "--help" || i + 1 == argc)
+            return false;
+
+        const std::string value(argv[++i]);
+        if (arg == "--backend") {
+            opts.backend = value;
+        } else if (arg == "--count") {
+            if (!absl::SimpleAtoi(value, &opts.count) || opts.count == 0)
+                return false;
+        } else if (arg == "--window") {
+            if (!absl::SimpleAtoi(value, &opts.window) || opts.window == 0)
+                return false;
+        } else if (arg == "--payload") {
+            if (!absl::SimpleAtoi(value, &opts.payload) ||
+                opts.payload > compact_notif_max_payload)
+                return false;
+        } else if (arg == "--consumers") {
+            if (!absl::SimpleAtoi(value, &opts.consumers))
+                return false;
+        } else {
+            return false;
+        }
+    }
+    return opts.consumers <= opts.count;
+}
+
+double threadCpuSec() {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+struct benchResult {
+    double wallSec = 0;
+    double recvCpuSec = 0;
+    double latencyUs = 0;
+    bool ok = false;
+};
+
+class notifReceiver {
+public:
+    virtual ~notifReceiver() = default;
+    // Returns the number of notifications received, or -1 on error
+    virtual long poll() = 0;
+};
+
+class stringReceiver : public notifReceiver {
+public:
+    stringReceiver(nixlAgent &agent) : agent(agent) {}
+
+    long poll() override {
+        notifs.clear();
+        if (agent.getNotifs(notifs) != NIXL_SUCCESS)
+            return -1;
+
+        long count = 0;
+        for (const auto &[name, list] : notifs)
+            count += list.size();
+        return count;
+    }
+
+private:
+    nixlAgent &agent;
+    nixl_notifs_t notifs;
+};
+
+class compactReceiver : public notifReceiver {
+public:
+    compactReceiver(nixlAgent &agent, size_t window) : agent(agent), notifs(window) {}
+
+    long poll() override {
+        size_t count;
+        if (agent.getCompactNotifs(notifs.data(), notifs.size(), count) != NIXL_SUCCESS)
+            return -1;
+        return count;
+    }
+
+private:
+    nixlAgent &agent;
+    std::vector<nixl_compact_notif_t> notifs;
+};
+
+bool setupAgents(const benchOptions &opts, nixlAgent &sender, nixlAgent &receiver) {
+    for (nixlAgent *agent : {&sender, &receiver}) {
+        nixl_b_params_t params;
+        nixl_mem_list_t mems;
+        nixlBackendH *backend_h;
+        if (agent->getPluginParams(opts.backend, mems, params) != NIXL_SUCCESS ||
+            agent->createBackend(opts.backend, params, backend_h) != NIXL_SUCCESS) {
+            std::cerr << "Failed to create backend " << opts.backend << "\n";
+            return false;
+        }
+    }
+
+    nixl_blob_t md;
+    std::string name;
+    if (receiver.getLocalMD(md) != NIXL_SUCCESS || sender.loadRemoteMD(md, name) != NIXL_SUCCESS ||
+        sender.getLocalMD(md) != NIXL_SUCCESS || receiver.loadRemoteMD(md, name) != NIXL_SUCCESS) {
+        std::cerr << "Failed to exchange metadata\n";
+        return false;
+    }
+    return true;
+}
+
+benchResult run(const benchOptions &opts, bool compact) {
+    benchResult result;
+
+    nixlAgentConfig cfg(false, false, 0, nixl_thread_sync_t::NIXL_THREAD_SYNC_RW);
+    nixlAgent sender("notif_bench_sender", cfg);
+    nixlAgent receiver("notif_bench_receiver", cfg);
+    if (!setupAgents(opts, sender, receiver))
+        return result;
+
+    std::unique_ptr<notifReceiver> recv;
+    std::unique_ptr<notifReceiver> self;
+    if (compact) {
+        recv = std::make_unique<compactReceiver>(receiver, opts.window);
+        self = std::make_unique<compactReceiver>(sender, opts.window);
+    } else {
+        recv = std::make_unique<stringReceiver>(receiver);
+        self = std::make_unique<stringReceiver>(sender);
+    }
+
+    std::atomic<size_t> received = 0;
+    std::atomic<bool> failed = false;
+    std::thread recv_thread([&]() {
+        const double start = threadCpuSec();
+        while (received < opts.count && !failed) {
+            long count = recv->poll();
+            if (count < 0)
+                failed = true;
+            else
+                received += count;
+        }
+        result.recvCpuSec = threadCpuSec() - start;
+    });
+
+    const std::string msg(opts.payload, 'x');
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t sent = 0; sent < opts.count && !failed; sent++) {
+        // Polling the sender progresses its sends
+        while (sent - received >= opts.window && !failed)
+            self->poll();
+
+        nixl_status_t status = compact ?
+            sender.genCompactNotif("notif_bench_receiver", sent, msg.data(), msg.size()) :
+            sender.genNotif("notif_bench_receiver", msg);
+        if (status != NIXL_SUCCESS) {
+            std::cerr << "Failed to send notification: " << nixlEnumStrings::statusStr(status)
+                      << "\n";
+            failed = true;
+        }
+    }
+    recv_thread.join();
+    result.wallSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+                         .count();
+
+    result.ok = !failed;
+    return result;
+}
+
+// Notifications are "<stream>|<send time>", each consumer checks that it only gets its own
+class streamConsumers {
+public:
+    streamConsumers(nixlAgent &agent, size_t num_streams, bool subscribed)
+        : agent(agent), subs(num_streams), queues(num_streams) {
+        for (size_t i = 0; i < num_streams && subscribed; i++)
+            if (agent.subscribeNotifs(prefix(i), subs[i]) != NIXL_SUCCESS)
+                failed = true;
+    }
+
+    ~streamConsumers() {
+        for (auto sub : subs)
+            if (sub)
+                agent.unsubscribeNotifs(sub);
+    }
+
+    static std::string prefix(size_t stream) { return std::to_string(stream) + "|"; }
+
+    // Returns the notifications of the stream, or -1 on error
+    long poll(size_t stream, double &latency_sum) {
+        std::vector<nixl_blob_t> msgs;
+        if (subs[stream]) {
+            nixl_notifs_t notifs;
+            if (agent.getSubNotifs(subs[stream], notifs) != NIXL_SUCCESS)
+                return -1;
+            for (auto &[name, list] : notifs)
+                for (auto &msg : list)
+                    msgs.push_back(std::move(msg));
+        } else {
+            // Demultiplexing by the application, any consumer may get the others' notifications
+            nixl_notifs_t notifs;
+            if (agent.getNotifs(notifs) != NIXL_SUCCESS)
+                return -1;
+
+            std::lock_guard<std::mutex> lock(queuesLock);
+            for (auto &[name, list] : notifs)
+                for (auto &msg : list)
+                    queues[std::stoul(msg)].push_back(std::move(msg));
+            msgs.swap(queues[stream]);
+        }
+
+        const int64_t now = nowNs();
+        for (const auto &msg : msgs) {
+            if (msg.compare(0, prefix(stream).size(), prefix(stream)) != 0)
+                return -1;
+            latency_sum += (now - std::stoll(msg.substr(prefix(stream).size()))) * 1e-3;
+        }
+        return msgs.size();
+    }
+
+    bool failed = false;
+
+private:
+    nixlAgent &agent;
+    std::vector<nixlNotifSubH*> subs;
+    std::mutex queuesLock;
+    std::vector<std::vector<nixl_blob_t>> queues;
+};
+
+benchResult runStreams(const benchOptions &opts, bool subscribed) {
+    benchResult result;
+
+    nixlAgentConfig cfg(true, false, 0, nixl_thread_sync_t::NIXL_THREAD_SYNC_RW);
+    nixlAgent sender("notif_bench_sender", cfg);
+    nixlAgent receiver("notif_bench_receiver", cfg);
+    if (!setupAgents(opts, sender, receiver))
+        return result;
+
+    streamConsumers consumers(receiver, opts.consumers, subscribed);
+    if (consumers.failed) {
+        std::cerr << "Failed to subscribe to notifications\n";
+        return result;
+    }
+
+    const size_t per_stream = opts.count / opts.consumers;
+    std::atomic<size_t> received = 0;
+    std::atomic<bool> failed = false;
+    std::vector<double> latency_sums(opts.consumers, 0);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < opts.consumers; i++) {
+        threads.emplace_back([&, i]() {
+            size_t stream_received = 0;
+            while (stream_received < per_stream && !failed) {
+                long count = consumers.poll(i, latency_sums[i]);
+                if (count < 0) {
+                    failed = true;
+                    break;
+                }
+                stream_received += count;
+                received += count;
+            }
+        });
+    }
+
+    nixl_notifs_t self_notifs;
+    const size_t total = per_stream * opts.consumers;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t sent = 0; sent < total && !failed; sent++) {
+        while (sent - received >= opts.window && !failed)
+            sender.getNotifs(self_notifs);
+
+        const std::string msg = streamConsumers::prefix(sent % opts.consumers) +
+                                std::to_string(nowNs());
+        if (sender.genNotif("notif_bench_receiver", msg) != NIXL_SUCCESS) {
+            std::cerr << "Failed to send notification\n";
+            failed = true;
+        }
+    }
+    for (auto &thread : threads)
+        thread.join();
+    result.wallSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+                         .count();
+
+    for (double sum : latency_sums)
+        result.latencyUs += sum;
+    result.latencyUs /= total;
+    result.ok = !failed;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    benchOptions opts;
+    if (!parseArgs(argc, argv, opts)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::cout << opts.count << " notifications of " << opts.payload << " bytes, window "
+              << opts.window << "\n";
+
+    for (bool compact : {false, true}) {
+        const benchResult result = run(opts, compact);
+        if (!result.ok) {
+            std::cerr << (compact ? "Compact" : "String") << " notifications failed\n";
+            return 1;
+        }
+
+        std::cout << "  " << std::setw(10) << std::left << (compact ? "compact:" : "string:")
+                  << std::fixed << std::setprecision(2) << opts.count / result.wallSec / 1e6
+                  << " M notifs/s, receiver " << std::setprecision(0)
+                  << result.recvCpuSec * 1e9 / opts.count << " ns CPU per notif\n";
+    }
+
+    if (opts.consumers == 0)
+        return 0;
+
+    std::cout << opts.consumers << " consumer threads\n";
+    for (bool subscribed : {false, true}) {
+        const benchResult result = runStreams(opts, subscribed);
+        if (!result.ok) {
+            std::cerr << (subscribed ? "Subscribed" : "Demultiplexed")
+                      << " notifications failed\n";
+            return 1;
+        }
+
+        std::cout << "  " << std::setw(12) << std::left
+                  << (subscribed ? "subscribed:" : "demux:") << std::fixed
+                  << std::setprecision(2)
+                  << opts.count / opts.consumers * opts.consumers / result.wallSec / 1e6
+                  << " M notifs/s, mean latency " << std::setprecision(1) << result.latencyUs
+                  << " us\n";
+    }
+    return 0;
+}
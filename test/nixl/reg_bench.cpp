@@ -0,0 +1,202 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Measures engine startup and shutdown registration cost. Large anonymous DRAM regions are
+ * registered and deregistered with the given backends, once with registerMem/deregisterMem
+ * and once with the asynchronous API, and the wall time of both is reported.
+ *
+ * The regions are not touched before registration, so the measurement includes faulting in
+ * and pinning the pages the way a serving engine would at startup.
+ */
+
+#include <sys/mman.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "nixl.h"
+#include "common/str_tools.h"
+#include "absl/strings/numbers.h"
+
+namespace {
+
+struct benchOptions {
+    std::vector<std::string> backends;
+    size_t regionSize = 1UL << 30;
+    size_t numRegions = 16;
+    unsigned int threads = 0;
+};
+
+void printUsage(const char *prog) {
+    std::cout << "Usage: " << prog << " [options]\n"
+              << "  --backends B1,B2,...   Backends to register with (default UCX)\n"
+              << "  --region-size BYTES    Size of each region (default 1G)\n"
+              << "  --regions N            Number of regions (default 16)\n"
+              << "  --threads N            Registration threads, 0 for one per core "
+                 "(default 0)\n";
+}
+
+bool parseArgs(int argc, char *argv[], benchOptions &opts) {
+    for (int i = 1; i < argc; i++) {
+        const std::string arg(argv[i]);
+        if (arg == "-h" || arg == "--help" || i + 1 == argc)
+            return false;
+
+        const std::string value(argv[++i]);
+        if (arg == "--backends") {
+            opts.backends = str_split_substr(value, ",");
+        } else if (arg == "--region-size") {
+            if (!absl::SimpleAtoi(value, &opts.regionSize) || opts.regionSize == 0)
+                return false;
+        } else if (arg == "--regions") {
+            if (!absl::SimpleAtoi(value, &opts.numRegions) || opts.numRegions == 0)
+                return false;
+        } else if (arg == "--threads") {
+            if (!absl::SimpleAtoi(value, &opts.threads))
+                return false;
+        } else {
+            return false;
+        }
+    }
+
+    if (opts.backends.empty())
+        opts.backends.push_back("UCX");
+    return true;
+}
+
+class regionSet {
+public:
+    regionSet(size_t region_size, size_t num_regions) : size(region_size) {
+        for (size_t i = 0; i < num_regions; i++) {
+            void *addr = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (addr == MAP_FAILED)
+                break;
+            regions.push_back(addr);
+        }
+    }
+
+    ~regionSet() {
+        for (void *addr : regions)
+            munmap(addr, size);
+    }
+
+    bool valid(size_t num_regions) const { return regions.size() == num_regions; }
+
+    nixl_reg_dlist_t descs() const {
+        nixl_reg_dlist_t reg_descs(DRAM_SEG);
+        for (void *addr : regions)
+            reg_descs.addDesc(nixlBlobDesc((uintptr_t)addr, size, 0));
+        return reg_descs;
+    }
+
+private:
+    const size_t size;
+    std::vector<void*> regions;
+};
+
+struct benchResult {
+    double regSec   = 0;
+    double deregSec = 0;
+    bool ok         = false;
+};
+
+benchResult run(const benchOptions &opts, bool async) {
+    benchResult result;
+
+    nixlAgentConfig cfg(false, false, 0, nixl_thread_sync_t::NIXL_THREAD_SYNC_RW);
+    cfg.regThreads = opts.threads;
+    nixlAgent agent("reg_bench", cfg);
+
+    for (const auto &backend : opts.backends) {
+        nixl_b_params_t params;
+        nixl_mem_list_t mems;
+        nixlBackendH *backend_h;
+        if (agent.getPluginParams(backend, mems, params) != NIXL_SUCCESS ||
+            agent.createBackend(backend, params, backend_h) != NIXL_SUCCESS) {
+            std::cerr << "Failed to create backend " << backend << "\n";
+            return result;
+        }
+    }
+
+    // Fresh regions every run, so that no run benefits from pages faulted in by another
+    regionSet regions(opts.regionSize, opts.numRegions);
+    if (!regions.valid(opts.numRegions)) {
+        std::cerr << "Failed to map " << opts.numRegions << " regions of " << opts.regionSize
+                  << " bytes\n";
+        return result;
+    }
+    const nixl_reg_dlist_t descs = regions.descs();
+
+    using clock = std::chrono::steady_clock;
+    auto start = clock::now();
+    if (async) {
+        nixlRegReqH *req;
+        if (agent.registerMemAsync(descs, req) != NIXL_SUCCESS ||
+            agent.releaseRegReq(req) != NIXL_SUCCESS)
+            return result;
+    } else if (agent.registerMem(descs) != NIXL_SUCCESS) {
+        return result;
+    }
+    result.regSec = std::chrono::duration<double>(clock::now() - start).count();
+
+    start = clock::now();
+    if (async) {
+        nixlRegReqH *req;
+        if (agent.deregisterMemAsync(descs, req) != NIXL_SUCCESS ||
+            agent.releaseRegReq(req) != NIXL_SUCCESS)
+            return result;
+    } else if (agent.deregisterMem(descs) != NIXL_SUCCESS) {
+        return result;
+    }
+    result.deregSec = std::chrono::duration<double>(clock::now() - start).count();
+
+    result.ok = true;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    benchOptions opts;
+    if (!parseArgs(argc, argv, opts)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    const double total_gb = double(opts.regionSize) * opts.numRegions / (1UL << 30);
+    std::cout << opts.numRegions << " regions of " << opts.regionSize << " bytes ("
+              << std::fixed << std::setprecision(1) << total_gb << " GB)\n";
+
+    for (bool async : {false, true}) {
+        const benchResult result = run(opts, async);
+        if (!result.ok) {
+            std::cerr << (async ? "Asynchronous" : "Synchronous") << " registration failed\n";
+            return 1;
+        }
+
+        std::cout << "  " << std::setw(12) << std::left << (async ? "async:" : "sync:")
+                  << std::setprecision(3) << "register " << result.regSec << " s ("
+                  << total_gb / result.regSec << " GB/s), deregister " << result.deregSec
+                  << " s\n";
+    }
+    return 0;
+}
@@ -0,0 +1,244 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Compares agents of one process with backends of their own to agents attached to a shared
+ * backend instance. Each agent writes blocks to the next one in a ring from a thread of its
+ * own, with a notification per transfer, and the aggregate throughput, the process CPU time
+ * and the time to create the agents and their backends are reported for both setups.
+ */
+
+#include <sys/resource.h>
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "nixl.h"
+#include "absl/strings/numbers.h"
+
+namespace {
+
+struct benchOptions {
+    std::string backend = "UCX";
+    size_t agents = 8;
+    size_t size = 1UL << 20;
+    size_t iters = 1000;
+    bool progressThread = true;
+};
+
+void printUsage(const char *prog) {
+    std::cout << "Usage: " << prog << " [options]\n"
+              << "  --backend B          Backend to transfer with (default UCX)\n"
+              << "  --agents N           Agents in the process, at least 2 (default 8)\n"
+              << "  --size BYTES         Transfer size (default 1M)\n"
+              << "  --iters N            Transfers per agent (default 1000)\n"
+              << "  --progress-thread B  Use agent progress threads, 0 or 1 (default 1)\n";
+}
+
+bool parseArgs(int argc, char *argv[], benchOptions &opts) {
+    for (int i = 1; i < argc; i++) {
+        const std::string arg(argv[i]);
+        if (arg == "-h" || arg == "--help" || i + 1 == argc)
+            return false;
+
+        const std::string value(argv[++i]);
+        if (arg == "--backend") {
+            opts.backend = value;
+        } else if (arg == "--agents") {
+            if (!absl::SimpleAtoi(value, &opts.agents) || opts.agents < 2)
+                return false;
+        } else if (arg == "--size") {
+            if (!absl::SimpleAtoi(value, &opts.size) || opts.size == 0)
+                return false;
+        } else if (arg == "--iters") {
+            if (!absl::SimpleAtoi(value, &opts.iters) || opts.iters == 0)
+                return false;
+        } else if (arg == "--progress-thread") {
+            if (!absl::SimpleAtob(value, &opts.progressThread))
+                return false;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+double processCpuSec() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+           (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+}
+
+std::string agentName(size_t i) {
+    return "shared_bench_" + std::to_string(i);
+}
+
+struct benchResult {
+    double setupSec = 0;
+    double wallSec = 0;
+    double cpuSec = 0;
+    bool ok = false;
+};
+
+struct benchAgent {
+    std::unique_ptr<nixlAgent> agent;
+    // Source block at the start of the buffer, the previous agent writes after it
+    std::vector<char> buffer;
+};
+
+bool setupAgents(const benchOptions &opts, bool shared, std::vector<benchAgent> &agents) {
+    nixlAgentConfig cfg(opts.progressThread, false, 0, nixl_thread_sync_t::NIXL_THREAD_SYNC_RW);
+    for (size_t i = 0; i < opts.agents; i++) {
+        benchAgent &bench_agent = agents.emplace_back();
+        bench_agent.agent = std::make_unique<nixlAgent>(agentName(i), cfg);
+        bench_agent.buffer.resize(opts.size * 2);
+
+        nixl_b_params_t params;
+        nixl_mem_list_t mems;
+        nixlBackendH *backend_h;
+        if (bench_agent.agent->getPluginParams(opts.backend, mems, params) != NIXL_SUCCESS)
+            return false;
+        if (shared)
+            params["shared_instance"] = "shared_bench";
+        if (bench_agent.agent->createBackend(opts.backend, params, backend_h) != NIXL_SUCCESS) {
+            std::cerr << "Failed to create backend " << opts.backend << "\n";
+            return false;
+        }
+
+        nixl_reg_dlist_t descs(DRAM_SEG);
+        descs.addDesc(nixlBlobDesc((uintptr_t)bench_agent.buffer.data(),
+                                   bench_agent.buffer.size(), 0));
+        if (bench_agent.agent->registerMem(descs) != NIXL_SUCCESS) {
+            std::cerr << "Failed to register memory\n";
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < opts.agents; i++) {
+        nixl_blob_t md;
+        std::string name;
+        benchAgent &next = agents[(i + 1) % opts.agents];
+        if (next.agent->getLocalMD(md) != NIXL_SUCCESS ||
+            agents[i].agent->loadRemoteMD(md, name) != NIXL_SUCCESS) {
+            std::cerr << "Failed to exchange metadata\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool writeRing(const benchOptions &opts, std::vector<benchAgent> &agents, size_t i) {
+    nixlAgent &agent = *agents[i].agent;
+    const benchAgent &next = agents[(i + 1) % opts.agents];
+    const std::string next_name = agentName((i + 1) % opts.agents);
+    const std::string prev_name = agentName((i + opts.agents - 1) % opts.agents);
+
+    nixl_xfer_dlist_t src(DRAM_SEG), dst(DRAM_SEG);
+    src.addDesc(nixlBasicDesc((uintptr_t)agents[i].buffer.data(), opts.size, 0));
+    dst.addDesc(nixlBasicDesc((uintptr_t)next.buffer.data() + opts.size, opts.size, 0));
+
+    nixl_opt_args_t extra_params;
+    extra_params.hasNotif = true;
+    extra_params.notifMsg = "x";
+    nixlXferReqH *req;
+    if (agent.createXferReq(NIXL_WRITE, src, dst, next_name, req, &extra_params) !=
+        NIXL_SUCCESS)
+        return false;
+
+    // Each write waits for its completion and for the previous agent's write to this one
+    size_t received = 0;
+    bool ok = true;
+    for (size_t iter = 0; iter < opts.iters && ok; iter++) {
+        nixl_status_t status = agent.postXferReq(req);
+        while (status == NIXL_IN_PROG)
+            status = agent.getXferStatus(req);
+        ok = status == NIXL_SUCCESS;
+
+        while (ok && received <= iter) {
+            nixl_notifs_t notifs;
+            ok = agent.getNotifs(notifs) == NIXL_SUCCESS;
+            received += notifs[prev_name].size();
+        }
+    }
+
+    agent.releaseXferReq(req);
+    return ok;
+}
+
+benchResult run(const benchOptions &opts, bool shared) {
+    benchResult result;
+    std::vector<benchAgent> agents;
+
+    auto start = std::chrono::steady_clock::now();
+    if (!setupAgents(opts, shared, agents))
+        return result;
+    result.setupSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+                          .count();
+
+    std::atomic<bool> failed = false;
+    std::vector<std::thread> threads;
+    const double cpu_start = processCpuSec();
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < opts.agents; i++)
+        threads.emplace_back([&, i]() {
+            if (!writeRing(opts, agents, i))
+                failed = true;
+        });
+    for (auto &thread : threads)
+        thread.join();
+    result.wallSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+                         .count();
+    result.cpuSec = processCpuSec() - cpu_start;
+
+    result.ok = !failed;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    benchOptions opts;
+    if (!parseArgs(argc, argv, opts)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::cout << opts.agents << " agents, " << opts.iters << " writes of " << opts.size
+              << " bytes each\n";
+
+    for (bool shared : {false, true}) {
+        const benchResult result = run(opts, shared);
+        if (!result.ok) {
+            std::cerr << (shared ? "Shared" : "Separate") << " backends failed\n";
+            return 1;
+        }
+
+        const double total_gb = double(opts.size) * opts.iters * opts.agents / (1UL << 30);
+        std::cout << "  " << std::setw(10) << std::left << (shared ? "shared:" : "separate:")
+                  << std::fixed << std::setprecision(2) << total_gb / result.wallSec
+                  << " GB/s, " << result.cpuSec / result.wallSec << " cores busy, setup "
+                  << std::setprecision(3) << result.setupSec << " s\n";
+    }
+    return 0;
+}
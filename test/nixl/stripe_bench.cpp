@@ -0,0 +1,219 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Measures how the bandwidth of POSIX transfers to a striped volume scales with its width.
+ * For each width the volume is registered as one FILE_SEG over that many member files,
+ * spread round robin over the given directories, and a buffer is written to it and read
+ * back. Directories on different mounts or devices give each member its own I/O queue, so
+ * they should be given to see the scaling of the devices rather than of one of them.
+ */
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "nixl.h"
+#include "absl/strings/numbers.h"
+#include "common/str_tools.h"
+
+namespace {
+
+struct benchOptions {
+    std::vector<std::string> dirs = {"/dev/shm"};
+    std::string queue = "aio";
+    size_t maxWidth = 8;
+    size_t stripeUnit = 1UL << 20;
+    size_t size = 256UL << 20;
+    size_t iters = 4;
+    bool directIo = false;
+};
+
+void printUsage(const char *prog) {
+    std::cout << "Usage: " << prog << " [options]\n"
+              << "  --dirs D,D,...    Directories of the member files, used round robin\n"
+              << "                    (default /dev/shm)\n"
+              << "  --queue Q         POSIX queue, aio or uring (default aio)\n"
+              << "  --max-width N     Largest number of member files (default 8)\n"
+              << "  --stripe-unit N   Stripe unit (default 1M)\n"
+              << "  --size N          Bytes transferred per iteration (default 256M)\n"
+              << "  --iters N         Writes and reads per width (default 4)\n"
+              << "  --direct-io 0|1   Open the member files with O_DIRECT (default 0)\n";
+}
+
+bool parseArgs(int argc, char *argv[], benchOptions &opts) {
+    for (int i = 1; i < argc; i++) {
+        const std::string arg(argv[i]);
+        if (arg == "-h" || arg == "--help" || i + 1 == argc)
+            return false;
+
+        const std::string value(argv[++i]);
+        if (arg == "--dirs") {
+            opts.dirs = str_split(value, ",");
+        } else if (arg == "--queue") {
+            if (value != "aio" && value != "uring")
+                return false;
+            opts.queue = value;
+        } else if (arg == "--max-width") {
+            if (!absl::SimpleAtoi(value, &opts.maxWidth) || opts.maxWidth == 0)
+                return false;
+        } else if (arg == "--stripe-unit") {
+            if (!absl::SimpleAtoi(value, &opts.stripeUnit) || opts.stripeUnit == 0)
+                return false;
+        } else if (arg == "--size") {
+            if (!absl::SimpleAtoi(value, &opts.size) || opts.size == 0)
+                return false;
+        } else if (arg == "--iters") {
+            if (!absl::SimpleAtoi(value, &opts.iters) || opts.iters == 0)
+                return false;
+        } else if (arg == "--direct-io") {
+            if (!absl::SimpleAtob(value, &opts.directIo))
+                return false;
+        } else {
+            return false;
+        }
+    }
+    return !opts.dirs.empty();
+}
+
+struct benchResult {
+    double writeSec = 0;
+    double readSec = 0;
+    bool ok = false;
+};
+
+bool runXfer(nixlAgent &agent, nixl_xfer_op_t op, const nixl_xfer_dlist_t &local,
+             const nixl_xfer_dlist_t &volume, size_t iters, double &sec) {
+    nixlXferReqH *req;
+    if (agent.createXferReq(op, local, volume, "stripe_bench", req) != NIXL_SUCCESS)
+        return false;
+
+    // The request is reposted, so that its preparation is left out of the measurement
+    const auto start = std::chrono::steady_clock::now();
+    nixl_status_t status = NIXL_SUCCESS;
+    for (size_t iter = 0; iter < iters && status == NIXL_SUCCESS; iter++) {
+        status = agent.postXferReq(req);
+        while (status == NIXL_IN_PROG)
+            status = agent.getXferStatus(req);
+    }
+    sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    agent.releaseXferReq(req);
+    return status == NIXL_SUCCESS;
+}
+
+benchResult run(const benchOptions &opts, nixlAgent &agent, char *buf, size_t width) {
+    benchResult result;
+    std::vector<std::string> paths;
+    std::string spec = "stripe:" + std::to_string(opts.stripeUnit) + ":";
+    for (size_t i = 0; i < width; i++) {
+        paths.push_back(opts.dirs[i % opts.dirs.size()] + "/nixl_stripe_bench_" +
+                        std::to_string(getpid()) + "_" + std::to_string(i));
+        spec += (i ? "," : "") + paths.back();
+    }
+
+    nixl_reg_dlist_t volume_reg(FILE_SEG);
+    nixlBlobDesc volume_desc(0, 0, 0);
+    volume_desc.metaInfo = spec;
+    volume_reg.addDesc(volume_desc);
+    if (agent.registerMem(volume_reg) != NIXL_SUCCESS) {
+        std::cerr << "Failed to register the striped volume\n";
+        return result;
+    }
+
+    nixl_xfer_dlist_t local(DRAM_SEG);
+    nixl_xfer_dlist_t volume(FILE_SEG);
+    local.addDesc(nixlBasicDesc((uintptr_t)buf, opts.size, 0));
+    volume.addDesc(nixlBasicDesc(0, opts.size, 0));
+    result.ok = runXfer(agent, NIXL_WRITE, local, volume, opts.iters, result.writeSec) &&
+                runXfer(agent, NIXL_READ, local, volume, opts.iters, result.readSec);
+
+    agent.deregisterMem(volume_reg);
+    for (const auto &path : paths)
+        unlink(path.c_str());
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    benchOptions opts;
+    if (!parseArgs(argc, argv, opts)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    nixlAgent agent("stripe_bench", nixlAgentConfig(true));
+    nixl_b_params_t params;
+    nixlBackendH *backend_h;
+    params["use_" + opts.queue] = "true";
+    params["use_direct_io"] = opts.directIo ? "true" : "false";
+    if (agent.createBackend("POSIX", params, backend_h) != NIXL_SUCCESS) {
+        std::cerr << "Failed to create the POSIX backend\n";
+        return 1;
+    }
+
+    void *ptr;
+    if (posix_memalign(&ptr, 4096, opts.size) != 0) {
+        std::cerr << "Failed to allocate the buffer\n";
+        return 1;
+    }
+    std::fill_n(static_cast<char *>(ptr), opts.size, 's');
+    nixl_reg_dlist_t buf_reg(DRAM_SEG);
+    buf_reg.addDesc(nixlBlobDesc((uintptr_t)ptr, opts.size, 0));
+    if (agent.registerMem(buf_reg) != NIXL_SUCCESS) {
+        std::cerr << "Failed to register the buffer\n";
+        free(ptr);
+        return 1;
+    }
+
+    std::cout << opts.iters << " writes and reads of " << opts.size << " bytes, "
+              << opts.stripeUnit << " bytes stripe unit, over " << opts.dirs.size()
+              << " directories\n";
+
+    int ret = 0;
+    double base_write = 0, base_read = 0;
+    for (size_t width = 1; width <= opts.maxWidth; width *= 2) {
+        const benchResult result = run(opts, agent, static_cast<char *>(ptr), width);
+        if (!result.ok) {
+            std::cerr << "Width " << width << " failed\n";
+            ret = 1;
+            break;
+        }
+
+        const double total_gb = double(opts.size) * opts.iters / (1UL << 30);
+        const double write_gbs = total_gb / result.writeSec;
+        const double read_gbs = total_gb / result.readSec;
+        if (width == 1) {
+            base_write = write_gbs;
+            base_read = read_gbs;
+        }
+        std::cout << "  width " << std::setw(3) << std::left << width << std::fixed
+                  << std::setprecision(2) << " write " << write_gbs << " GB/s (x"
+                  << write_gbs / base_write << "), read " << read_gbs << " GB/s (x"
+                  << read_gbs / base_read << ")\n";
+    }
+
+    agent.deregisterMem(buf_reg);
+    free(ptr);
+    return ret;
+}
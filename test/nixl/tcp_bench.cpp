@@ -0,0 +1,227 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Compares TCP transports on loopback. Two agents of this process exchange buffers of each
+ * given size with every backend, the initiator keeping a window of transfers in flight, and
+ * the bandwidth, the transfer rate and the CPU time of the process per GB moved are reported.
+ *
+ * The CPU time includes the progress and service threads of the backends. Run with
+ * UCX_TLS=tcp to make UCX use TCP sockets for the comparison.
+ */
+
+#include <sys/resource.h>
+
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "nixl.h"
+#include "common/str_tools.h"
+#include "absl/strings/numbers.h"
+
+namespace {
+
+struct benchOptions {
+    std::vector<std::string> backends;
+    std::vector<size_t> sizes;
+    size_t iters = 1000;
+    size_t window = 8;
+    nixl_xfer_op_t op = NIXL_WRITE;
+};
+
+void printUsage(const char *prog) {
+    std::cout << "Usage: " << prog << " [options]\n"
+              << "  --backends B1,B2,...   Backends to compare (default URING_TCP,UCX)\n"
+              << "  --sizes S1,S2,...      Transfer sizes in bytes (default 4K,64K,1M,16M)\n"
+              << "  --iters N              Transfers per size (default 1000)\n"
+              << "  --window N             Transfers in flight (default 8)\n"
+              << "  --op read|write        Operation (default write)\n";
+}
+
+bool parseArgs(int argc, char *argv[], benchOptions &opts) {
+    for (int i = 1; i < argc; i++) {
+        const std::string arg(argv[i]);
+        if (arg == "-h" || arg == "--help" || i + 1 == argc)
+            return false;
+
+        const std::string value(argv[++i]);
+        if (arg == "--backends") {
+            opts.backends = str_split_substr(value, ",");
+        } else if (arg == "--sizes") {
+            for (const auto &size_str : str_split_substr(value, ",")) {
+                size_t size;
+                if (!absl::SimpleAtoi(size_str, &size) || size == 0)
+                    return false;
+                opts.sizes.push_back(size);
+            }
+        } else if (arg == "--iters") {
+            if (!absl::SimpleAtoi(value, &opts.iters) || opts.iters == 0)
+                return false;
+        } else if (arg == "--window") {
+            if (!absl::SimpleAtoi(value, &opts.window) || opts.window == 0)
+                return false;
+        } else if (arg == "--op") {
+            if (value != "read" && value != "write")
+                return false;
+            opts.op = value == "read" ? NIXL_READ : NIXL_WRITE;
+        } else {
+            return false;
+        }
+    }
+
+    if (opts.backends.empty())
+        opts.backends = {"URING_TCP", "UCX"};
+    if (opts.sizes.empty())
+        opts.sizes = {4096, 65536, 1 << 20, 16 << 20};
+    return true;
+}
+
+double cpuSeconds() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+           (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+struct benchResult {
+    double gbps = 0;
+    double xferRate = 0;
+    double cpuSecPerGb = 0;
+    bool ok = false;
+};
+
+// The window is a set of buffers of the given size, one per transfer in flight
+benchResult run(const std::string &backend, const benchOptions &opts, size_t size) {
+    benchResult result;
+    nixlAgentConfig cfg(true);
+    nixlAgent initiator("initiator", cfg);
+    nixlAgent target("target", cfg);
+
+    for (nixlAgent *agent : {&initiator, &target}) {
+        nixl_b_params_t params;
+        nixl_mem_list_t mems;
+        nixlBackendH *backend_h;
+        if (agent->getPluginParams(backend, mems, params) != NIXL_SUCCESS ||
+            agent->createBackend(backend, params, backend_h) != NIXL_SUCCESS) {
+            std::cerr << "Failed to create backend " << backend << "\n";
+            return result;
+        }
+    }
+
+    std::vector<uint8_t> local(size * opts.window, 1);
+    std::vector<uint8_t> remote(size * opts.window, 2);
+    nixl_reg_dlist_t local_reg(DRAM_SEG), remote_reg(DRAM_SEG);
+    local_reg.addDesc(nixlBlobDesc((uintptr_t)local.data(), local.size(), 0));
+    remote_reg.addDesc(nixlBlobDesc((uintptr_t)remote.data(), remote.size(), 0));
+    if (initiator.registerMem(local_reg) != NIXL_SUCCESS ||
+        target.registerMem(remote_reg) != NIXL_SUCCESS)
+        return result;
+
+    std::string md, remote_name;
+    if (target.getLocalMD(md) != NIXL_SUCCESS ||
+        initiator.loadRemoteMD(md, remote_name) != NIXL_SUCCESS)
+        return result;
+
+    std::vector<nixlXferReqH*> reqs(opts.window);
+    for (size_t i = 0; i < opts.window; i++) {
+        nixl_xfer_dlist_t local_descs(DRAM_SEG), remote_descs(DRAM_SEG);
+        local_descs.addDesc(nixlBasicDesc((uintptr_t)local.data() + i * size, size, 0));
+        remote_descs.addDesc(nixlBasicDesc((uintptr_t)remote.data() + i * size, size, 0));
+        if (initiator.createXferReq(opts.op, local_descs, remote_descs, remote_name,
+                                    reqs[i]) != NIXL_SUCCESS)
+            return result;
+    }
+
+    using clock = std::chrono::steady_clock;
+    const double cpu_start = cpuSeconds();
+    const auto start = clock::now();
+
+    // Each slot of the window is reposted as soon as its previous transfer completes
+    size_t posted = 0, completed = 0;
+    std::vector<bool> active(opts.window, false);
+    while (completed < opts.iters) {
+        for (size_t i = 0; i < opts.window; i++) {
+            if (active[i]) {
+                const nixl_status_t status = initiator.getXferStatus(reqs[i]);
+                if (status == NIXL_IN_PROG)
+                    continue;
+                if (status != NIXL_SUCCESS)
+                    return result;
+                active[i] = false;
+                completed++;
+            }
+            if (posted < opts.iters) {
+                const nixl_status_t status = initiator.postXferReq(reqs[i]);
+                if (status < 0)
+                    return result;
+                posted++;
+                if (status == NIXL_IN_PROG)
+                    active[i] = true;
+                else
+                    completed++;
+            }
+        }
+    }
+
+    const double sec = std::chrono::duration<double>(clock::now() - start).count();
+    const double cpu_sec = cpuSeconds() - cpu_start;
+    const double gb = double(size) * opts.iters / 1e9;
+
+    for (nixlXferReqH *req : reqs)
+        initiator.releaseXferReq(req);
+    initiator.invalidateRemoteMD(remote_name);
+    initiator.deregisterMem(local_reg);
+    target.deregisterMem(remote_reg);
+
+    result.gbps = gb / sec;
+    result.xferRate = opts.iters / sec;
+    result.cpuSecPerGb = cpu_sec / gb;
+    result.ok = true;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    benchOptions opts;
+    if (!parseArgs(argc, argv, opts)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::cout << std::setw(12) << std::left << "backend" << std::setw(12) << "size"
+              << std::setw(12) << "GB/s" << std::setw(14) << "xfers/s" << "CPU s/GB\n";
+    for (const auto &backend : opts.backends) {
+        for (size_t size : opts.sizes) {
+            const benchResult result = run(backend, opts, size);
+            if (!result.ok) {
+                std::cerr << backend << " failed with transfers of " << size << " bytes\n";
+                return 1;
+            }
+
+            std::cout << std::setw(12) << backend << std::setw(12) << size << std::fixed
+                      << std::setprecision(3) << std::setw(12) << result.gbps
+                      << std::setprecision(0) << std::setw(14) << result.xferRate
+                      << std::setprecision(3) << result.cpuSecPerGb << "\n";
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,274 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Calibrates UCX configuration for the UCX backend. Every candidate configuration is
+ * applied to a pair of in-process agents and WRITE bandwidth is measured for a set of
+ * message sizes. The best candidate per size is written to a tuning profile, adjacent sizes
+ * with the same winner are merged into one range. The profile is loaded by the UCX backend
+ * through the ucx_tune_profile parameter or the NIXL_UCX_TUNE_PROFILE environment variable.
+ *
+ * Transports are selected as usual through the UCX environment, e.g. UCX_TLS=tcp or
+ * UCX_TLS=shm to calibrate on a single host.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "nixl.h"
+#include "tuning.h"
+#include "common/str_tools.h"
+#include "absl/strings/numbers.h"
+
+namespace {
+
+const std::string initiator_name("ucx_tune_initiator");
+const std::string target_name("ucx_tune_target");
+
+constexpr size_t max_descs_per_xfer = 64;
+
+struct tuneOptions {
+    std::vector<std::pair<std::string, std::vector<std::string>>> params;
+    std::vector<size_t> sizes;
+    int iters = 16;
+    std::string output = "nixl_ucx_tune.profile";
+};
+
+void printUsage(const char *prog) {
+    std::cout << "Usage: " << prog << " [options]\n"
+              << "  --param KEY=V1|V2|...  UCX setting to sweep, may be repeated; the cartesian\n"
+              << "                         product of all settings is evaluated\n"
+              << "  --sizes S1,S2,...      Message sizes in bytes (default 4K..64M, x4 steps)\n"
+              << "  --iters N              Timed transfers per size (default 16)\n"
+              << "  --output PATH          Profile to write (default nixl_ucx_tune.profile)\n";
+}
+
+bool parseArgs(int argc, char *argv[], tuneOptions &opts) {
+    for (int i = 1; i < argc; i++) {
+        const std::string arg(argv[i]);
+        if (arg == "-h" || arg == "--help" || i + 1 == argc)
+            return false;
+
+        const std::string value(argv[++i]);
+        if (arg == "--param") {
+            const auto pos = value.find('=');
+            if (pos == 0 || pos == std::string::npos)
+                return false;
+            opts.params.emplace_back(value.substr(0, pos),
+                                     str_split_substr(value.substr(pos + 1), "|"));
+        } else if (arg == "--sizes") {
+            for (const auto &size_str : str_split_substr(value, ",")) {
+                size_t size;
+                if (!absl::SimpleAtoi(size_str, &size) || size == 0)
+                    return false;
+                opts.sizes.push_back(size);
+            }
+        } else if (arg == "--iters") {
+            if (!absl::SimpleAtoi(value, &opts.iters) || opts.iters <= 0)
+                return false;
+        } else if (arg == "--output") {
+            opts.output = value;
+        } else {
+            return false;
+        }
+    }
+
+    if (opts.sizes.empty()) {
+        for (size_t size = 4096; size <= 64 * 1024 * 1024; size *= 4)
+            opts.sizes.push_back(size);
+    }
+    std::sort(opts.sizes.begin(), opts.sizes.end());
+    opts.sizes.erase(std::unique(opts.sizes.begin(), opts.sizes.end()), opts.sizes.end());
+
+    // Settings that typically matter for RMA writes, when nothing is given explicitly
+    if (opts.params.empty()) {
+        opts.params.push_back({"ZCOPY_THRESH", {"auto", "16k", "256k"}});
+        opts.params.push_back({"MAX_RMA_RAILS", {"1", "2", "4"}});
+    }
+    return true;
+}
+
+std::vector<nixl::ucx::configList> makeCandidates(const tuneOptions &opts) {
+    // Library defaults serve as the baseline every candidate has to beat
+    std::vector<nixl::ucx::configList> candidates(1);
+    for (const auto &[key, values] : opts.params) {
+        std::vector<nixl::ucx::configList> expanded;
+        for (const auto &candidate : candidates) {
+            for (const auto &value : values) {
+                expanded.push_back(candidate);
+                expanded.back().emplace_back(key, value);
+            }
+        }
+        candidates = std::move(expanded);
+    }
+
+    candidates.insert(candidates.begin(), nixl::ucx::configList());
+    return candidates;
+}
+
+// Returns bandwidth in MB/s per size, 0 for sizes that could not be measured
+std::vector<double> measure(const nixl::ucx::configList &candidate, const tuneOptions &opts) {
+    std::vector<double> bandwidth(opts.sizes.size(), 0);
+    const size_t buf_size = opts.sizes.back();
+
+    nixlAgentConfig cfg(false);
+    nixlAgent initiator(initiator_name, cfg);
+    nixlAgent target(target_name, cfg);
+
+    const nixl_b_params_t params = {{"ucx_config", nixl::ucx::formatConfigList(candidate)}};
+    nixlBackendH *init_backend, *target_backend;
+    if (initiator.createBackend("UCX", params, init_backend) != NIXL_SUCCESS ||
+        target.createBackend("UCX", params, target_backend) != NIXL_SUCCESS) {
+        std::cerr << "Failed to create UCX backend\n";
+        return bandwidth;
+    }
+
+    std::vector<char> src(buf_size, 0x5a), dst(buf_size, 0);
+    nixl_reg_dlist_t src_reg(DRAM_SEG), dst_reg(DRAM_SEG);
+    src_reg.addDesc(nixlBlobDesc((uintptr_t)src.data(), buf_size, 0));
+    dst_reg.addDesc(nixlBlobDesc((uintptr_t)dst.data(), buf_size, 0));
+    if (initiator.registerMem(src_reg) != NIXL_SUCCESS ||
+        target.registerMem(dst_reg) != NIXL_SUCCESS) {
+        std::cerr << "Failed to register memory\n";
+        return bandwidth;
+    }
+
+    nixl_blob_t target_md;
+    std::string remote_name;
+    target.getLocalMD(target_md);
+    initiator.loadRemoteMD(target_md, remote_name);
+
+    for (size_t i = 0; i < opts.sizes.size(); i++) {
+        const size_t size = opts.sizes[i];
+        const size_t num_descs = std::clamp<size_t>(buf_size / size, 1, max_descs_per_xfer);
+
+        nixl_xfer_dlist_t src_descs(DRAM_SEG), dst_descs(DRAM_SEG);
+        for (size_t d = 0; d < num_descs; d++) {
+            src_descs.addDesc(nixlBasicDesc((uintptr_t)src.data() + d * size, size, 0));
+            dst_descs.addDesc(nixlBasicDesc((uintptr_t)dst.data() + d * size, size, 0));
+        }
+
+        nixlXferReqH *req;
+        if (initiator.createXferReq(NIXL_WRITE, src_descs, dst_descs, target_name, req) !=
+            NIXL_SUCCESS)
+            continue;
+
+        // The first round trip establishes the connection and is not timed
+        auto run = [&]() {
+            nixl_status_t status = initiator.postXferReq(req);
+            nixl_notifs_t notifs;
+            while (status == NIXL_IN_PROG) {
+                // Target side progress is needed by transports that emulate RMA
+                target.getNotifs(notifs);
+                status = initiator.getXferStatus(req);
+            }
+            return status;
+        };
+
+        bool ok = run() == NIXL_SUCCESS;
+        const auto start = std::chrono::steady_clock::now();
+        for (int iter = 0; ok && iter < opts.iters; iter++)
+            ok = run() == NIXL_SUCCESS;
+        const std::chrono::duration<double, std::micro> elapsed =
+            std::chrono::steady_clock::now() - start;
+
+        if (ok)
+            bandwidth[i] = double(size * num_descs * opts.iters) / elapsed.count();
+        initiator.releaseXferReq(req);
+    }
+
+    initiator.invalidateRemoteMD(target_name);
+    initiator.deregisterMem(src_reg);
+    target.deregisterMem(dst_reg);
+    return bandwidth;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    tuneOptions opts;
+    if (!parseArgs(argc, argv, opts)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // Calibrate from the library defaults, not from a previously tuned profile
+    unsetenv("NIXL_UCX_TUNE_PROFILE");
+
+    const auto candidates = makeCandidates(opts);
+    std::vector<std::vector<double>> results;
+    for (const auto &candidate : candidates) {
+        results.push_back(measure(candidate, opts));
+
+        const std::string name = candidate.empty() ? std::string("<defaults>") :
+                                                     nixl::ucx::formatConfigList(candidate);
+        std::cout << name << "\n";
+        for (size_t i = 0; i < opts.sizes.size(); i++) {
+            std::cout << "  " << std::setw(12) << opts.sizes[i] << " bytes: " << std::fixed
+                      << std::setprecision(1) << results.back()[i] << " MB/s\n";
+        }
+    }
+
+    // Best candidate per size, merged into ranges covering the whole size space
+    nixl::ucx::tuneProfile profile;
+    size_t range_start = 0;
+    for (size_t i = 0; i < opts.sizes.size(); i++) {
+        size_t best = 0;
+        for (size_t c = 1; c < candidates.size(); c++) {
+            if (results[c][i] > results[best][i])
+                best = c;
+        }
+
+        if (results[best][i] == 0) {
+            std::cerr << "No candidate completed transfers of " << opts.sizes[i] << " bytes\n";
+            return 1;
+        }
+
+        const bool last = i + 1 == opts.sizes.size();
+        size_t next_best = 0;
+        if (!last) {
+            for (size_t c = 1; c < candidates.size(); c++) {
+                if (results[c][i + 1] > results[next_best][i + 1])
+                    next_best = c;
+            }
+        }
+
+        if (last || next_best != best) {
+            const size_t range_end = last ? std::numeric_limits<size_t>::max() : opts.sizes[i];
+            profile.addEntry({range_start, range_end, results[best][i], candidates[best]});
+            range_start = range_end + (last ? 0 : 1);
+        }
+    }
+
+    if (!profile.save(opts.output))
+        return 1;
+
+    std::cout << "Tuning profile written to " << opts.output << "\n";
+    for (const auto &entry : profile.getEntries()) {
+        std::cout << "  " << entry.minSize << "-" << entry.maxSize << ": "
+                  << (entry.config.empty() ? std::string("<defaults>") :
+                                             nixl::ucx::formatConfigList(entry.config))
+                  << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+
+# SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Measures the rate of posted transfers from a number of Python threads sharing one agent.
+# Scaling is close to linear on free-threaded Python builds, or with the GIL as long as
+# most of the time is spent in NIXL calls, which release it.
+
+import sys
+import threading
+import time
+
+import nixl._utils as nixl_utils
+from nixl._api import nixl_agent, nixl_agent_config
+
+
+def post_loop(agent: nixl_agent, handle, duration: float, counts: list, idx: int):
+    posted = 0
+    deadline = time.perf_counter() + duration
+    while time.perf_counter() < deadline:
+        state = agent.transfer(handle)
+        while state == "PROC":
+            state = agent.check_xfer_state(handle)
+        assert state == "DONE"
+        posted += 1
+    counts[idx] = posted
+
+
+def run(agent: nixl_agent, addr: int, size: int, num_threads: int, duration: float):
+    handles = []
+    for i in range(num_threads):
+        src = agent.get_xfer_descs([(addr + 2 * i * size, size, 0)], "DRAM")
+        dst = agent.get_xfer_descs([(addr + (2 * i + 1) * size, size, 0)], "DRAM")
+        handles.append(agent.initialize_xfer("WRITE", src, dst, agent.name))
+
+    counts = [0] * num_threads
+    threads = [
+        threading.Thread(target=post_loop, args=(agent, handles[i], duration, counts, i))
+        for i in range(num_threads)
+    ]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+
+    for handle in handles:
+        agent.release_xfer_handle(handle)
+
+    return sum(counts) / duration
+
+
+if __name__ == "__main__":
+    import argparse
+    import os
+
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--max-threads", type=int, default=8)
+    parser.add_argument("--size", type=int, default=4096)
+    parser.add_argument("--duration", type=float, default=2.0)
+    parser.add_argument("--backend", type=str, default="UCX")
+    args = parser.parse_args()
+
+    print("Using NIXL Plugins from:")
+    print(os.environ["NIXL_PLUGIN_DIR"])
+    gil = getattr(sys, "_is_gil_enabled", lambda: True)()
+    print(f"GIL enabled: {gil}")
+
+    agent = nixl_agent("agent", nixl_agent_config(backends=[args.backend], thread_safe=True))
+
+    buf_size = 2 * args.max_threads * args.size
+    addr = nixl_utils.malloc_passthru(buf_size)
+    reg_descs = agent.get_reg_descs([(addr, buf_size, 0, "")], "DRAM")
+    assert agent.register_memory(reg_descs) is not None
+
+    base = None
+    num_threads = 1
+    while num_threads <= args.max_threads:
+        rate = run(agent, addr, args.size, num_threads, args.duration)
+        base = base or rate
+        print(
+            f"threads: {num_threads:3d}\tposts/sec: {rate:12.0f}\tscaling: {rate / base:5.2f}x"
+        )
+        num_threads *= 2
+
+    agent.deregister_memory(reg_descs)
+    nixl_utils.free_passthru(addr)
@@ -13,6 +13,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import threading
 import uuid
 
 import pytest
@@ -187,3 +188,44 @@ def test_incorrect_plugin_env(monkeypatch):
 
     with pytest.raises(RuntimeError):
         nixl_agent("bad env agent")
+
+
+@pytest.mark.timeout(30)
+def test_multithreaded_post():
+    agent = nixl_agent(str(uuid.uuid4()), nixl_agent_config(thread_safe=True))
+    num_threads = 4
+    size = 4096
+
+    addr = utils.malloc_passthru(2 * num_threads * size)
+    reg_descs = agent.get_reg_descs([(addr, 2 * num_threads * size, 0, "")], "DRAM")
+    assert agent.register_memory(reg_descs) is not None
+
+    errors = []
+
+    def worker(i):
+        try:
+            src = agent.get_xfer_descs([(addr + 2 * i * size, size, 0)], "DRAM")
+            dst = agent.get_xfer_descs([(addr + (2 * i + 1) * size, size, 0)], "DRAM")
+            handle = agent.initialize_xfer("WRITE", src, dst, agent.name)
+            for _ in range(100):
+                state = agent.transfer(handle)
+                while state == "PROC":
+                    state = agent.check_xfer_state(handle)
+                assert state == "DONE"
+            # Releasing twice is safe and the handle can't be used afterwards
+            agent.release_xfer_handle(handle)
+            agent.release_xfer_handle(handle)
+            with pytest.raises(bindings.nixlNotFoundError):
+                agent.transfer(handle)
+        except Exception as e:
+            errors.append(e)
+
+    threads = [threading.Thread(target=worker, args=(i,)) for i in range(num_threads)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+
+    assert not errors
+    agent.deregister_memory(reg_descs)
+    utils.free_passthru(addr)
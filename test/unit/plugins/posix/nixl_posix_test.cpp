@@ -20,8 +20,10 @@
 #include <stdlib.h>
 #include <fcntl.h>
 #include <sys/stat.h>
+#include <sys/resource.h>
 #include <iomanip>
 #include <cassert>
+#include <cmath>
 #include <cstring>
 #include <string>
 #include <absl/strings/str_format.h>
@@ -32,6 +34,7 @@
 #include <stdexcept>
 #include <cstdio>
 #include <getopt.h>
+#include <random>
 
 namespace {
     const size_t page_size = sysconf(_SC_PAGESIZE);
@@ -190,6 +193,46 @@ namespace {
             }
         }
     };
+
+    // Runs a transfer to completion and reports the time it took
+    nixl_status_t
+    run_transfer (nixlAgent &agent,
+                  nixl_xfer_op_t op,
+                  const nixl_xfer_dlist_t &local,
+                  const nixl_xfer_dlist_t &remote,
+                  const std::string &agent_name,
+                  nixlTime::us_t &duration,
+                  const nixl_opt_args_t *extra_params = nullptr) {
+        nixlXferReqH *treq = nullptr;
+        nixl_status_t status =
+            agent.createXferReq (op, local, remote, agent_name, treq, extra_params);
+        if (status != NIXL_SUCCESS) {
+            std::cerr << "Failed to create transfer request - status: "
+                      << nixlEnumStrings::statusStr (status) << std::endl;
+            return status;
+        }
+
+        nixlTime::us_t time_start = nixlTime::getUs();
+        status = agent.postXferReq (treq);
+        while (status == NIXL_IN_PROG) {
+            status = agent.getXferStatus (treq);
+        }
+        nixlTime::us_t time_end = nixlTime::getUs();
+
+        agent.releaseXferReq (treq);
+        if (status != NIXL_SUCCESS) {
+            std::cerr << "Transfer failed - status: " << nixlEnumStrings::statusStr (status)
+                      << std::endl;
+            return status;
+        }
+        duration = time_end - time_start;
+        return NIXL_SUCCESS;
+    }
+
+    size_t count_open_fds() {
+        return std::distance (std::filesystem::directory_iterator ("/proc/self/fd"),
+                              std::filesystem::directory_iterator());
+    }
 }
 
 int
@@ -740,6 +783,840 @@ test_posix_repost (std::string test_files_dir_path_abs_path, bool use_uring) {
     return 0;
 }
 
+int
+test_posix_unaligned (std::string test_files_dir_path_abs_path, bool use_uring) {
+    constexpr int num_blocks = 256;
+    constexpr size_t block_size = 3 * 4096 + 100; // Not a multiple of any block size
+    constexpr off_t file_start = 1000;
+    constexpr size_t file_size = file_start + num_blocks * block_size + 5000;
+    constexpr char background = 'z';
+    const std::string agent_name = "POSIXUnalignedTester";
+
+    nixl_b_params_t params;
+    params[use_uring ? "use_uring" : "use_aio"] = "true";
+
+    print_segment_title ("NIXL STORAGE UNALIGNED O_DIRECT TEST STARTING (POSIX PLUGIN)");
+
+    std::string file_path = test_files_dir_path_abs_path + "/" +
+        generate_timestamped_filename (test_file_name) + "_unaligned";
+    int direct_fd = open (file_path.c_str(), O_RDWR | O_CREAT | O_DIRECT, std_file_permissions);
+    if (direct_fd < 0 && errno == EINVAL) {
+        std::cout << "O_DIRECT not supported in " << test_files_dir_path_abs_path
+                  << ", skipping" << std::endl;
+        return 0;
+    }
+    tempFile file (file_path, O_RDWR | O_CREAT, std_file_permissions);
+    if (direct_fd < 0) {
+        std::cerr << "Failed to open file with O_DIRECT: " << strerror (errno) << std::endl;
+        return 1;
+    }
+
+    nixlBackendH *posix = nullptr;
+    nixlAgent agent (agent_name, nixlAgentConfig (true));
+    if (agent.createBackend ("POSIX", params, posix) != NIXL_SUCCESS) {
+        std::cerr << "Failed to create POSIX backend" << std::endl;
+        close (direct_fd);
+        return 1;
+    }
+
+    print_segment_title (phase_title ("Preparing file and buffers"));
+
+    // Existing file content around and between the blocks must survive the writes
+    std::vector<char> expected (file_size, background);
+    if (pwrite (file, expected.data(), file_size, 0) != static_cast<ssize_t> (file_size)) {
+        std::cerr << "Failed to initialize file" << std::endl;
+        close (direct_fd);
+        return 1;
+    }
+
+    // Even blocks have buffers misaligned like their file offsets, so their interiors go
+    // direct, odd blocks are misaligned differently and go through bounce buffers only
+    std::unique_ptr<void, PosixMemalignDeleter> buffers[2];
+    const size_t buffer_size = file_start + num_blocks * block_size + page_size;
+    for (auto &buffer : buffers) {
+        void *ptr;
+        if (posix_memalign (&ptr, page_size, buffer_size) != 0) {
+            std::cerr << "DRAM allocation failed" << std::endl;
+            close (direct_fd);
+            return 1;
+        }
+        buffer.reset (ptr);
+    }
+
+    nixl_reg_dlist_t dram_for_posix (DRAM_SEG);
+    nixl_reg_dlist_t file_for_posix (FILE_SEG);
+    nixl_xfer_dlist_t dram_xfer (DRAM_SEG);
+    nixl_xfer_dlist_t file_xfer (FILE_SEG);
+    for (auto &buffer : buffers) {
+        dram_for_posix.addDesc (nixlBlobDesc ((uintptr_t)buffer.get(), buffer_size, 0));
+    }
+    // Zero length covers the whole file, including the appended part
+    file_for_posix.addDesc (nixlBlobDesc (0, 0, direct_fd));
+
+    std::vector<char *> block_addr;
+    for (int i = 0; i < num_blocks; ++i) {
+        const off_t offset = file_start + i * block_size;
+        char *addr = (char *)buffers[i % 2].get() + offset + (i % 2) * 3;
+        block_addr.push_back (addr);
+        dram_xfer.addDesc (nixlBasicDesc ((uintptr_t)addr, block_size, 0));
+        file_xfer.addDesc (nixlBasicDesc (offset, block_size, direct_fd));
+        memset (addr, 'a' + i % 26, block_size);
+        memset (expected.data() + offset, 'a' + i % 26, block_size);
+    }
+
+    if (agent.registerMem (dram_for_posix) != NIXL_SUCCESS ||
+        agent.registerMem (file_for_posix) != NIXL_SUCCESS) {
+        std::cerr << "Failed to register memory with NIXL" << std::endl;
+        close (direct_fd);
+        return 1;
+    }
+
+    print_segment_title (phase_title ("Unaligned Memory to File Transfer"));
+    const double data_gb = double (block_size) * num_blocks / gb_size;
+    nixlTime::us_t write_time;
+    if (run_transfer (agent, NIXL_WRITE, dram_xfer, file_xfer, agent_name, write_time) !=
+        NIXL_SUCCESS) {
+        close (direct_fd);
+        return 1;
+    }
+    std::cout << "- Speed: " << data_gb / us_to_s (write_time) << " GB/s" << std::endl;
+
+    std::vector<char> file_data (file_size);
+    if (pread (file, file_data.data(), file_size, 0) != static_cast<ssize_t> (file_size) ||
+        file_data != expected) {
+        std::cerr << "File content mismatch after unaligned write" << std::endl;
+        close (direct_fd);
+        return 1;
+    }
+
+    print_segment_title (phase_title ("Unaligned File to Memory Transfer"));
+    for (auto &buffer : buffers) {
+        clear_buffer (buffer.get(), buffer_size);
+    }
+    nixlTime::us_t read_time;
+    if (run_transfer (agent, NIXL_READ, dram_xfer, file_xfer, agent_name, read_time) !=
+        NIXL_SUCCESS) {
+        close (direct_fd);
+        return 1;
+    }
+    std::cout << "- Speed: " << data_gb / us_to_s (read_time) << " GB/s" << std::endl;
+
+    for (int i = 0; i < num_blocks; ++i) {
+        if (memcmp (block_addr[i], expected.data() + file_start + i * block_size, block_size)) {
+            std::cerr << "Block " << i << " validation failed" << std::endl;
+            close (direct_fd);
+            return 1;
+        }
+    }
+
+    print_segment_title (phase_title ("Unaligned write past the end of file"));
+    // The last block is written whole, the file has to end with the data
+    const off_t append_offset = file_size - 10;
+    nixl_xfer_dlist_t append_dram (DRAM_SEG);
+    nixl_xfer_dlist_t append_file (FILE_SEG);
+    append_dram.addDesc (nixlBasicDesc ((uintptr_t)block_addr[1], block_size, 0));
+    append_file.addDesc (nixlBasicDesc (append_offset, block_size, direct_fd));
+    nixlTime::us_t append_time;
+    if (run_transfer (agent, NIXL_WRITE, append_dram, append_file, agent_name, append_time) !=
+        NIXL_SUCCESS) {
+        close (direct_fd);
+        return 1;
+    }
+
+    struct stat st;
+    fstat (file, &st);
+    if (st.st_size != static_cast<off_t> (append_offset + block_size)) {
+        std::cerr << "Unexpected file size " << st.st_size << " after appending" << std::endl;
+        close (direct_fd);
+        return 1;
+    }
+
+    if (pread (file, file_data.data(), block_size, append_offset) !=
+            static_cast<ssize_t> (block_size) ||
+        memcmp (file_data.data(), block_addr[1], block_size)) {
+        std::cerr << "File content mismatch after appending" << std::endl;
+        close (direct_fd);
+        return 1;
+    }
+    std::cout << "File size after appending: " << st.st_size << std::endl;
+
+    agent.deregisterMem (file_for_posix);
+    agent.deregisterMem (dram_for_posix);
+    close (direct_fd);
+    return 0;
+}
+
+int
+test_posix_file_cache (std::string test_files_dir_path_abs_path,
+                       bool use_direct_io,
+                       bool use_uring) {
+    constexpr int num_files = 2048;
+    constexpr size_t max_open_files = 64;
+    constexpr size_t file_size = 4096;
+    constexpr int batch_size = 32;
+    constexpr int num_read_batches = 512;
+    constexpr rlim_t fd_limit = 256;
+    const std::string agent_name = "POSIXFileCacheTester";
+
+    print_segment_title ("NIXL STORAGE FILE CACHE TEST STARTING (POSIX PLUGIN)");
+
+    // More files than the process can keep open, only the cache keeps this working
+    struct rlimit saved_limit;
+    getrlimit (RLIMIT_NOFILE, &saved_limit);
+    struct rlimit limit = saved_limit;
+    limit.rlim_cur = std::min (fd_limit, saved_limit.rlim_max);
+    setrlimit (RLIMIT_NOFILE, &limit);
+
+    int ret = 1;
+    std::vector<std::string> paths;
+    {
+        nixl_b_params_t params;
+        params[use_uring ? "use_uring" : "use_aio"] = "true";
+        params["max_open_files"] = std::to_string (max_open_files);
+        if (use_direct_io) {
+            params["use_direct_io"] = "true";
+        }
+
+        nixlBackendH *posix = nullptr;
+        nixlAgent agent (agent_name, nixlAgentConfig (true));
+        if (agent.createBackend ("POSIX", params, posix) != NIXL_SUCCESS) {
+            std::cerr << "Failed to create POSIX backend" << std::endl;
+            setrlimit (RLIMIT_NOFILE, &saved_limit);
+            return 1;
+        }
+        const size_t base_fds = count_open_fds();
+
+        print_segment_title (phase_title ("Registering files by path"));
+        std::cout << "Registering " << num_files << " files with at most " << max_open_files
+                  << " open" << std::endl;
+
+        // Files are identified by devId, the path is passed in metaInfo
+        nixl_reg_dlist_t file_for_posix (FILE_SEG);
+        const std::string base_name = test_files_dir_path_abs_path + "/" +
+            generate_timestamped_filename (test_file_name) + "_cache_";
+        for (int i = 0; i < num_files; ++i) {
+            paths.push_back (base_name + std::to_string (i));
+            nixlBlobDesc desc (0, 0, i);
+            desc.metaInfo = paths.back();
+            file_for_posix.addDesc (desc);
+        }
+
+        void *ptr;
+        const size_t buffer_size = batch_size * file_size;
+        if (posix_memalign (&ptr, page_size, buffer_size) != 0) {
+            std::cerr << "DRAM allocation failed" << std::endl;
+            setrlimit (RLIMIT_NOFILE, &saved_limit);
+            return 1;
+        }
+        std::unique_ptr<void, PosixMemalignDeleter> buffer (ptr);
+        char *data = (char *)buffer.get();
+        nixl_reg_dlist_t dram_for_posix (DRAM_SEG);
+        dram_for_posix.addDesc (nixlBlobDesc ((uintptr_t)data, buffer_size, 0));
+
+        if (agent.registerMem (dram_for_posix) != NIXL_SUCCESS ||
+            agent.registerMem (file_for_posix) != NIXL_SUCCESS) {
+            std::cerr << "Failed to register memory with NIXL" << std::endl;
+            setrlimit (RLIMIT_NOFILE, &saved_limit);
+            return 1;
+        }
+
+        auto fill_file = [&] (char *addr, int file) {
+            memset (addr, 'a' + file % 26, file_size);
+            memcpy (addr, &file, sizeof (file));
+        };
+
+        auto run_batch = [&] (nixl_xfer_op_t op, const std::vector<int> &files,
+                              nixlTime::us_t &duration) {
+            nixl_xfer_dlist_t dram_xfer (DRAM_SEG);
+            nixl_xfer_dlist_t file_xfer (FILE_SEG);
+            for (size_t i = 0; i < files.size(); ++i) {
+                dram_xfer.addDesc (nixlBasicDesc ((uintptr_t)data + i * file_size, file_size, 0));
+                file_xfer.addDesc (nixlBasicDesc (0, file_size, files[i]));
+            }
+            return run_transfer (agent, op, dram_xfer, file_xfer, agent_name, duration);
+        };
+
+        // Files are deregistered whatever the outcome of the transfers
+        auto run_transfers = [&]() {
+            print_segment_title (phase_title ("Memory to File Transfers"));
+            size_t max_fds = 0;
+            nixlTime::us_t total_time = 0;
+            for (int start = 0; start < num_files; start += batch_size) {
+                std::vector<int> files;
+                for (int i = start; i < start + batch_size && i < num_files; ++i) {
+                    fill_file (data + files.size() * file_size, i);
+                    files.push_back (i);
+                }
+                nixlTime::us_t duration;
+                if (run_batch (NIXL_WRITE, files, duration) != NIXL_SUCCESS)
+                    return 1;
+                total_time += duration;
+                max_fds = std::max (max_fds, count_open_fds());
+            }
+            std::cout << "- Write rate: " << num_files / us_to_s (total_time) << " files/s"
+                      << std::endl;
+
+            print_segment_title (phase_title ("Skewed File to Memory Transfers"));
+            {
+                // Zipf-like popularity, a few files are hot and stay in the cache
+                std::mt19937 rng (2025);
+                std::vector<double> weights;
+                for (int i = 0; i < num_files; ++i) {
+                    weights.push_back (1.0 / (i + 1));
+                }
+                std::discrete_distribution<int> popularity (weights.begin(), weights.end());
+
+                std::vector<char> expected (file_size);
+                total_time = 0;
+                for (int batch = 0; batch < num_read_batches; ++batch) {
+                    std::vector<int> files;
+                    for (int i = 0; i < batch_size; ++i) {
+                        files.push_back (popularity (rng));
+                    }
+                    clear_buffer (data, buffer_size);
+                    nixlTime::us_t duration;
+                    if (run_batch (NIXL_READ, files, duration) != NIXL_SUCCESS)
+                        return 1;
+                    total_time += duration;
+                    max_fds = std::max (max_fds, count_open_fds());
+
+                    for (size_t i = 0; i < files.size(); ++i) {
+                        fill_file (expected.data(), files[i]);
+                        if (memcmp (data + i * file_size, expected.data(), file_size)) {
+                            std::cerr << "File " << files[i] << " validation failed" << std::endl;
+                            return 1;
+                        }
+                    }
+                    printProgress (float (batch + 1) / num_read_batches);
+                }
+                std::cout << "- Read rate: " << num_read_batches * batch_size / us_to_s (total_time)
+                          << " files/s" << std::endl;
+            }
+
+            // Files used by a request stay open until it is released, at most one batch here
+            std::cout << "Open file descriptors: at most " << max_fds - base_fds << " for "
+                      << num_files << " files" << std::endl;
+            if (max_fds > base_fds + max_open_files + batch_size) {
+                std::cerr << "Too many open file descriptors: " << max_fds - base_fds << std::endl;
+                return 1;
+            }
+            return 0;
+        };
+
+        ret = run_transfers();
+        agent.deregisterMem (file_for_posix);
+        agent.deregisterMem (dram_for_posix);
+    }
+
+    for (const auto &path : paths) {
+        unlink (path.c_str());
+    }
+    setrlimit (RLIMIT_NOFILE, &saved_limit);
+    return ret;
+}
+
+int
+test_posix_block (std::string test_files_dir_path_abs_path,
+                  std::string block_device_path,
+                  bool use_uring) {
+    constexpr int num_blocks = 256;
+    constexpr size_t block_size = 64 * kb_size;
+    constexpr size_t total_size = num_blocks * block_size;
+    constexpr uint64_t block_dev_id = 1;
+    const std::string agent_name = "POSIXBlockTester";
+
+    nixl_b_params_t params;
+    params[use_uring ? "use_uring" : "use_aio"] = "true";
+
+    print_segment_title ("NIXL STORAGE BLOCK DEVICE TEST STARTING (POSIX PLUGIN)");
+
+    // Without a device, a plain file is used as the block target
+    std::unique_ptr<tempFile> target_file;
+    if (block_device_path.empty()) {
+        block_device_path = test_files_dir_path_abs_path + "/" +
+            generate_timestamped_filename (test_file_name) + "_block";
+        target_file = std::make_unique<tempFile> (
+            block_device_path, O_RDWR | O_CREAT, std_file_permissions);
+        if (ftruncate (*target_file, total_size) < 0) {
+            std::cerr << "Failed to size block target file: " << strerror (errno) << std::endl;
+            return 1;
+        }
+    }
+    std::cout << "Block target: " << block_device_path << std::endl;
+
+    // The same target through FILE_SEG, for comparison
+    int file_fd = open (block_device_path.c_str(), O_RDWR | O_DIRECT);
+    if (file_fd < 0 && errno == EINVAL) {
+        file_fd = open (block_device_path.c_str(), O_RDWR);
+    }
+    if (file_fd < 0) {
+        std::cerr << "Failed to open block target: " << strerror (errno) << std::endl;
+        return 1;
+    }
+
+    nixlBackendH *posix = nullptr;
+    nixlAgent agent (agent_name, nixlAgentConfig (true));
+    if (agent.createBackend ("POSIX", params, posix) != NIXL_SUCCESS) {
+        std::cerr << "Failed to create POSIX backend" << std::endl;
+        close (file_fd);
+        return 1;
+    }
+
+    void *ptr;
+    if (posix_memalign (&ptr, page_size, total_size) != 0) {
+        std::cerr << "DRAM allocation failed" << std::endl;
+        close (file_fd);
+        return 1;
+    }
+    std::unique_ptr<void, PosixMemalignDeleter> buffer (ptr);
+    char *data = (char *)buffer.get();
+
+    // The device is registered by path, devId only identifies it
+    nixl_reg_dlist_t dram_for_posix (DRAM_SEG);
+    nixl_reg_dlist_t blk_for_posix (BLK_SEG);
+    nixl_reg_dlist_t file_for_posix (FILE_SEG);
+    dram_for_posix.addDesc (nixlBlobDesc ((uintptr_t)data, total_size, 0));
+    nixlBlobDesc blk_desc (0, total_size, block_dev_id);
+    blk_desc.metaInfo = block_device_path;
+    blk_for_posix.addDesc (blk_desc);
+    file_for_posix.addDesc (nixlBlobDesc (0, total_size, file_fd));
+
+    if (agent.registerMem (dram_for_posix) != NIXL_SUCCESS ||
+        agent.registerMem (blk_for_posix) != NIXL_SUCCESS ||
+        agent.registerMem (file_for_posix) != NIXL_SUCCESS) {
+        std::cerr << "Failed to register memory with NIXL" << std::endl;
+        close (file_fd);
+        return 1;
+    }
+
+    auto run_phases = [&] (nixl_mem_t mem_type, uint64_t dev_id, const char *phrase) {
+        nixl_xfer_dlist_t dram_xfer (DRAM_SEG);
+        nixl_xfer_dlist_t dev_xfer (mem_type);
+        for (int i = 0; i < num_blocks; ++i) {
+            dram_xfer.addDesc (nixlBasicDesc ((uintptr_t)data + i * block_size, block_size, 0));
+            dev_xfer.addDesc (nixlBasicDesc (i * block_size, block_size, dev_id));
+        }
+
+        const char *name = (mem_type == BLK_SEG) ? "BLK_SEG" : "FILE_SEG";
+        const double data_gb = double (total_size) / gb_size;
+        nixlTime::us_t write_time, read_time;
+
+        print_segment_title (phase_title (absl::StrFormat ("Memory to %s Transfer", name)));
+        fill_test_pattern (data, phrase, total_size);
+        if (run_transfer (agent, NIXL_WRITE, dram_xfer, dev_xfer, agent_name, write_time) !=
+            NIXL_SUCCESS) {
+            return 1;
+        }
+
+        print_segment_title (phase_title (absl::StrFormat ("%s to Memory Transfer", name)));
+        clear_buffer (data, total_size);
+        if (run_transfer (agent, NIXL_READ, dram_xfer, dev_xfer, agent_name, read_time) !=
+            NIXL_SUCCESS) {
+            return 1;
+        }
+
+        std::vector<char> expected (total_size);
+        fill_test_pattern (expected.data(), phrase, total_size);
+        if (memcmp (data, expected.data(), total_size)) {
+            std::cerr << name << " data validation failed" << std::endl;
+            return 1;
+        }
+        std::cout << absl::StrFormat ("- %s write: %.2f GB/s, read: %.2f GB/s", name,
+                                      data_gb / us_to_s (write_time),
+                                      data_gb / us_to_s (read_time))
+                  << std::endl;
+        return 0;
+    };
+
+    int ret = run_phases (BLK_SEG, block_dev_id, repost_test_phrase_1);
+    if (ret == 0) {
+        ret = run_phases (FILE_SEG, file_fd, repost_test_phrase_2);
+    }
+
+    if (ret == 0) {
+        print_segment_title (phase_title ("Unaligned BLK_SEG Transfer"));
+        // Offsets on block devices have to be in whole blocks
+        nixl_xfer_dlist_t dram_xfer (DRAM_SEG);
+        nixl_xfer_dlist_t blk_xfer (BLK_SEG);
+        dram_xfer.addDesc (nixlBasicDesc ((uintptr_t)data, block_size, 0));
+        blk_xfer.addDesc (nixlBasicDesc (100, block_size, block_dev_id));
+        nixlXferReqH *treq = nullptr;
+        if (agent.createXferReq (NIXL_WRITE, dram_xfer, blk_xfer, agent_name, treq) ==
+            NIXL_SUCCESS) {
+            std::cerr << "Unaligned BLK_SEG transfer was not rejected" << std::endl;
+            agent.releaseXferReq (treq);
+            ret = 1;
+        } else {
+            std::cout << "Unaligned BLK_SEG transfer rejected" << std::endl;
+        }
+    }
+
+    agent.deregisterMem (file_for_posix);
+    agent.deregisterMem (blk_for_posix);
+    agent.deregisterMem (dram_for_posix);
+    close (file_fd);
+    return ret;
+}
+
+int
+test_posix_conversion (std::string test_files_dir_path_abs_path, bool use_uring) {
+    constexpr size_t num_elems = 1024 * 1024;
+    constexpr int num_blocks = 16;
+    constexpr size_t block_elems = num_elems / num_blocks;
+    constexpr float scale = 0.05f;
+    // E4M3 keeps 3 mantissa bits, with round to nearest even the error is below 2^-4
+    constexpr float max_rel_error = 1.0f / 16;
+    const std::string agent_name = "POSIXConversionTester";
+
+    nixl_b_params_t params;
+    params[use_uring ? "use_uring" : "use_aio"] = "true";
+
+    print_segment_title ("NIXL STORAGE CONVERSION TEST STARTING (POSIX PLUGIN)");
+
+    std::string file_path = test_files_dir_path_abs_path + "/" +
+        generate_timestamped_filename (test_file_name) + "_conversion";
+    tempFile file (file_path, O_RDWR | O_CREAT | O_TRUNC, std_file_permissions);
+
+    nixlBackendH *posix = nullptr;
+    nixlAgent agent (agent_name, nixlAgentConfig (true));
+    if (agent.createBackend ("POSIX", params, posix) != NIXL_SUCCESS) {
+        std::cerr << "Failed to create POSIX backend" << std::endl;
+        return 1;
+    }
+
+    print_segment_title (phase_title ("Preparing BF16 buffers"));
+
+    // BF16 values are the upper halves of FP32 values, within the E4M3 range once scaled
+    std::vector<uint16_t> source (num_elems), result (num_elems);
+    std::vector<float> values (num_elems);
+    std::mt19937 gen (2025);
+    std::uniform_real_distribution<float> dist (-20.0f, 20.0f);
+    for (size_t i = 0; i < num_elems; ++i) {
+        float value = dist (gen);
+        uint32_t bits;
+        memcpy (&bits, &value, sizeof (bits));
+        source[i] = bits >> 16;
+        bits = uint32_t (source[i]) << 16;
+        memcpy (&values[i], &bits, sizeof (bits));
+    }
+
+    nixl_reg_dlist_t dram_for_posix (DRAM_SEG);
+    nixl_reg_dlist_t file_for_posix (FILE_SEG);
+    nixl_xfer_dlist_t src_xfer (DRAM_SEG);
+    nixl_xfer_dlist_t dst_xfer (DRAM_SEG);
+    nixl_xfer_dlist_t file_xfer (FILE_SEG);
+    dram_for_posix.addDesc (
+        nixlBlobDesc ((uintptr_t)source.data(), num_elems * sizeof (uint16_t), 0));
+    dram_for_posix.addDesc (
+        nixlBlobDesc ((uintptr_t)result.data(), num_elems * sizeof (uint16_t), 0));
+    file_for_posix.addDesc (nixlBlobDesc (0, 0, file));
+    // File blocks hold one byte per element
+    for (int i = 0; i < num_blocks; ++i) {
+        const size_t elem = i * block_elems;
+        src_xfer.addDesc (nixlBasicDesc (
+            (uintptr_t)(source.data() + elem), block_elems * sizeof (uint16_t), 0));
+        dst_xfer.addDesc (nixlBasicDesc (
+            (uintptr_t)(result.data() + elem), block_elems * sizeof (uint16_t), 0));
+        file_xfer.addDesc (nixlBasicDesc (elem, block_elems, file));
+    }
+
+    if (agent.registerMem (dram_for_posix) != NIXL_SUCCESS ||
+        agent.registerMem (file_for_posix) != NIXL_SUCCESS) {
+        std::cerr << "Failed to register memory with NIXL" << std::endl;
+        return 1;
+    }
+
+    nixl_opt_args_t extra_params;
+    extra_params.hasConversion        = true;
+    extra_params.conversion.localType  = NIXL_DTYPE_BF16;
+    extra_params.conversion.remoteType = NIXL_DTYPE_FP8_E4M3;
+    extra_params.conversion.scaleMode  = NIXL_SCALE_FIXED;
+    extra_params.conversion.scale      = scale;
+
+    print_segment_title (phase_title ("BF16 Memory to FP8 File Transfer"));
+    const double data_gb = double (num_elems) * sizeof (uint16_t) / gb_size;
+    nixlTime::us_t write_time;
+    if (run_transfer (agent, NIXL_WRITE, src_xfer, file_xfer, agent_name, write_time,
+                      &extra_params) != NIXL_SUCCESS) {
+        return 1;
+    }
+    std::cout << "- Speed: " << data_gb / us_to_s (write_time) << " GB/s (BF16)" << std::endl;
+
+    struct stat st;
+    fstat (file, &st);
+    if (st.st_size != static_cast<off_t> (num_elems)) {
+        std::cerr << "Unexpected file size " << st.st_size << " for " << num_elems
+                  << " FP8 elements" << std::endl;
+        return 1;
+    }
+
+    print_segment_title (phase_title ("FP8 File to BF16 Memory Transfer"));
+    nixlTime::us_t read_time;
+    if (run_transfer (agent, NIXL_READ, dst_xfer, file_xfer, agent_name, read_time,
+                      &extra_params) != NIXL_SUCCESS) {
+        return 1;
+    }
+    std::cout << "- Speed: " << data_gb / us_to_s (read_time) << " GB/s (BF16)" << std::endl;
+
+    float worst = 0;
+    for (size_t i = 0; i < num_elems; ++i) {
+        uint32_t bits = uint32_t (result[i]) << 16;
+        float value;
+        memcpy (&value, &bits, sizeof (bits));
+        // Values that are subnormal in E4M3 only keep an absolute precision
+        const float error = std::abs (value - values[i]);
+        const float bound = std::max (std::abs (values[i]) * max_rel_error, scale / 512);
+        if (error > bound) {
+            std::cerr << "Element " << i << " is " << value << " instead of " << values[i]
+                      << std::endl;
+            return 1;
+        }
+        worst = std::max (worst, error / std::max (std::abs (values[i]), scale));
+    }
+    std::cout << "Largest relative error: " << worst << std::endl;
+
+    print_segment_title (phase_title ("Mismatched element counts"));
+    nixl_xfer_dlist_t bad_file_xfer (FILE_SEG);
+    for (int i = 0; i < num_blocks; ++i)
+        bad_file_xfer.addDesc (nixlBasicDesc (i * block_elems, block_elems * 2, file));
+    nixlXferReqH *treq = nullptr;
+    if (agent.createXferReq (
+            NIXL_WRITE, src_xfer, bad_file_xfer, agent_name, treq, &extra_params) !=
+        NIXL_ERR_INVALID_PARAM) {
+        std::cerr << "Transfer with mismatched element counts was accepted" << std::endl;
+        return 1;
+    }
+
+    agent.deregisterMem (file_for_posix);
+    agent.deregisterMem (dram_for_posix);
+    return 0;
+}
+
+int
+test_posix_replicas (std::string test_files_dir_path_abs_path, bool use_uring) {
+    constexpr int num_replicas = 3;
+    constexpr size_t buf_size = 4 * 1024 * 1024;
+    const std::string agent_name = "POSIXReplicaTester";
+
+    nixl_b_params_t params;
+    params[use_uring ? "use_uring" : "use_aio"] = "true";
+
+    print_segment_title ("NIXL STORAGE REPLICA TEST STARTING (POSIX PLUGIN)");
+
+    nixlBackendH *posix = nullptr;
+    nixlAgent agent (agent_name, nixlAgentConfig (true));
+    if (agent.createBackend ("POSIX", params, posix) != NIXL_SUCCESS) {
+        std::cerr << "Failed to create POSIX backend" << std::endl;
+        return 1;
+    }
+
+    std::vector<char> source (buf_size), result (buf_size);
+    fill_test_pattern (source.data(), repost_test_phrase_1, buf_size);
+
+    // Each replica is a file of its own, as on redundant storage targets
+    std::vector<std::unique_ptr<tempFile>> files;
+    std::vector<nixl_xfer_dlist_t> file_xfers;
+    std::vector<std::string> agents (num_replicas, agent_name);
+    nixl_reg_dlist_t dram_for_posix (DRAM_SEG);
+    nixl_reg_dlist_t file_for_posix (FILE_SEG);
+    nixl_xfer_dlist_t src_xfer (DRAM_SEG);
+    nixl_xfer_dlist_t dst_xfer (DRAM_SEG);
+    dram_for_posix.addDesc (nixlBlobDesc ((uintptr_t)source.data(), buf_size, 0));
+    dram_for_posix.addDesc (nixlBlobDesc ((uintptr_t)result.data(), buf_size, 0));
+    src_xfer.addDesc (nixlBasicDesc ((uintptr_t)source.data(), buf_size, 0));
+    dst_xfer.addDesc (nixlBasicDesc ((uintptr_t)result.data(), buf_size, 0));
+    for (int i = 0; i < num_replicas; ++i) {
+        files.push_back (std::make_unique<tempFile> (
+            test_files_dir_path_abs_path + "/" + generate_timestamped_filename (test_file_name) +
+                "_replica_" + std::to_string (i),
+            O_RDWR | O_CREAT | O_TRUNC,
+            std_file_permissions));
+        file_for_posix.addDesc (nixlBlobDesc (0, 0, *files.back()));
+        file_xfers.emplace_back (FILE_SEG);
+        file_xfers.back().addDesc (nixlBasicDesc (0, buf_size, *files.back()));
+    }
+
+    if (agent.registerMem (dram_for_posix) != NIXL_SUCCESS ||
+        agent.registerMem (file_for_posix) != NIXL_SUCCESS) {
+        std::cerr << "Failed to register memory with NIXL" << std::endl;
+        return 1;
+    }
+
+    print_segment_title (phase_title ("Memory to Replica Files Quorum Write"));
+    nixl_opt_args_t extra_params;
+    extra_params.writeQuorum = 2;
+    nixlReplicaXferReqH *wreq = nullptr;
+    if (agent.createReplicaXferReq (
+            NIXL_WRITE, src_xfer, file_xfers, agents, wreq, &extra_params) != NIXL_SUCCESS) {
+        std::cerr << "Failed to create replicated write" << std::endl;
+        return 1;
+    }
+    nixl_status_t status = agent.postReplicaXferReq (wreq);
+    while (status == NIXL_IN_PROG)
+        status = agent.getReplicaXferStatus (wreq);
+    agent.releaseReplicaXferReq (wreq);
+    if (status != NIXL_SUCCESS) {
+        std::cerr << "Replicated write failed - status: " << nixlEnumStrings::statusStr (status)
+                  << std::endl;
+        return 1;
+    }
+
+    // Only the quorum is known to be complete, the last write may have been canceled
+    std::vector<nixl_xfer_dlist_t> complete;
+    std::vector<char> check (buf_size);
+    for (int i = 0; i < num_replicas; ++i) {
+        if (pread (*files[i], check.data(), buf_size, 0) == (ssize_t)buf_size && check == source)
+            complete.push_back (file_xfers[i]);
+    }
+    if (complete.size() < 2) {
+        std::cerr << "Only " << complete.size() << " replicas were written" << std::endl;
+        return 1;
+    }
+
+    // Slow storage can't be injected here, a hedge delay of 1us hedges almost every read
+    // so that the canceled reads and the reposts are exercised
+    print_segment_title (phase_title ("Replica Files to Memory Hedged Read"));
+    extra_params.hedgeDelayUs = 1;
+    nixlReplicaXferReqH *rreq = nullptr;
+    agents.resize (complete.size());
+    if (agent.createReplicaXferReq (
+            NIXL_READ, dst_xfer, complete, agents, rreq, &extra_params) != NIXL_SUCCESS) {
+        std::cerr << "Failed to create hedged read" << std::endl;
+        return 1;
+    }
+    for (int i = 0; i < 8; ++i) {
+        std::fill (result.begin(), result.end(), 0);
+        status = agent.postReplicaXferReq (rreq);
+        while (status == NIXL_IN_PROG)
+            status = agent.getReplicaXferStatus (rreq);
+        size_t src = 0;
+        if (status != NIXL_SUCCESS || agent.getReplicaXferSource (rreq, src) != NIXL_SUCCESS) {
+            std::cerr << "Hedged read failed - status: " << nixlEnumStrings::statusStr (status)
+                      << std::endl;
+            return 1;
+        }
+        if (result != source) {
+            std::cerr << "Hedged read from replica " << src << " returned wrong data"
+                      << std::endl;
+            return 1;
+        }
+    }
+    agent.releaseReplicaXferReq (rreq);
+
+    agent.deregisterMem (file_for_posix);
+    agent.deregisterMem (dram_for_posix);
+    return 0;
+}
+
+int
+test_posix_stripe (std::string test_files_dir_path_abs_path, bool use_uring) {
+    constexpr int stripe_width = 4;
+    constexpr size_t stripe_unit = 64 * 1024;
+    constexpr size_t buf_size = 4 * 1024 * 1024;
+    // Starts and ends inside a stripe unit, so that every member gets partial units
+    constexpr size_t xfer_offset = stripe_unit / 2 + 100;
+    constexpr size_t xfer_size = buf_size - stripe_unit - 300;
+    const std::string agent_name = "POSIXStripeTester";
+
+    nixl_b_params_t params;
+    params[use_uring ? "use_uring" : "use_aio"] = "true";
+
+    print_segment_title ("NIXL STORAGE STRIPE TEST STARTING (POSIX PLUGIN)");
+
+    nixlBackendH *posix = nullptr;
+    nixlAgent agent (agent_name, nixlAgentConfig (true));
+    if (agent.createBackend ("POSIX", params, posix) != NIXL_SUCCESS) {
+        std::cerr << "Failed to create POSIX backend" << std::endl;
+        return 1;
+    }
+
+    std::vector<char> source (buf_size), result (buf_size);
+    fill_test_pattern (source.data(), repost_test_phrase_1, buf_size);
+
+    // One volume over several member files, given in metaInfo like files registered by path
+    std::vector<std::string> paths;
+    std::string spec = "stripe:" + std::to_string (stripe_unit) + ":";
+    for (int i = 0; i < stripe_width; ++i) {
+        paths.push_back (test_files_dir_path_abs_path + "/" +
+                         generate_timestamped_filename (test_file_name) + "_stripe_" +
+                         std::to_string (i));
+        unlink (paths.back().c_str());
+        spec += (i ? "," : "") + paths.back();
+    }
+
+    nixl_reg_dlist_t dram_for_posix (DRAM_SEG);
+    nixl_reg_dlist_t file_for_posix (FILE_SEG);
+    dram_for_posix.addDesc (nixlBlobDesc ((uintptr_t)source.data(), buf_size, 0));
+    dram_for_posix.addDesc (nixlBlobDesc ((uintptr_t)result.data(), buf_size, 0));
+    nixlBlobDesc volume (0, 0, 0);
+    volume.metaInfo = spec;
+    file_for_posix.addDesc (volume);
+
+    if (agent.registerMem (dram_for_posix) != NIXL_SUCCESS ||
+        agent.registerMem (file_for_posix) != NIXL_SUCCESS) {
+        std::cerr << "Failed to register memory with NIXL" << std::endl;
+        return 1;
+    }
+
+    auto run_stripe = [&]() {
+        nixl_xfer_dlist_t src_xfer (DRAM_SEG);
+        nixl_xfer_dlist_t dst_xfer (DRAM_SEG);
+        nixl_xfer_dlist_t file_xfer (FILE_SEG);
+        src_xfer.addDesc (nixlBasicDesc ((uintptr_t)source.data(), xfer_size, 0));
+        dst_xfer.addDesc (nixlBasicDesc ((uintptr_t)result.data(), xfer_size, 0));
+        file_xfer.addDesc (nixlBasicDesc (xfer_offset, xfer_size, 0));
+
+        print_segment_title (phase_title ("Memory to Striped Volume Transfer"));
+        nixlTime::us_t duration;
+        if (run_transfer (agent, NIXL_WRITE, src_xfer, file_xfer, agent_name, duration) !=
+            NIXL_SUCCESS)
+            return 1;
+        std::cout << "- Write: " << xfer_size / us_to_s (duration) / gb_size << " GB/s over "
+                  << stripe_width << " files" << std::endl;
+
+        // Each unit of the volume lands in the member and at the offset of its stripe
+        std::vector<char> unit (stripe_unit);
+        for (size_t off = xfer_offset; off < xfer_offset + xfer_size;) {
+            const size_t stripe = off / stripe_unit;
+            const size_t len = std::min (stripe_unit - off % stripe_unit,
+                                         xfer_offset + xfer_size - off);
+            const off_t member_off = (stripe / stripe_width) * stripe_unit + off % stripe_unit;
+            const int fd = open (paths[stripe % stripe_width].c_str(), O_RDONLY);
+            const ssize_t read_len = (fd < 0) ? -1 : pread (fd, unit.data(), len, member_off);
+            if (fd >= 0) {
+                close (fd);
+            }
+            if (read_len != (ssize_t)len ||
+                memcmp (unit.data(), source.data() + off - xfer_offset, len)) {
+                std::cerr << "Stripe " << stripe << " has wrong data in member "
+                          << stripe % stripe_width << std::endl;
+                return 1;
+            }
+            off += len;
+        }
+
+        print_segment_title (phase_title ("Striped Volume to Memory Transfer"));
+        if (run_transfer (agent, NIXL_READ, dst_xfer, file_xfer, agent_name, duration) !=
+            NIXL_SUCCESS)
+            return 1;
+        std::cout << "- Read: " << xfer_size / us_to_s (duration) / gb_size << " GB/s over "
+                  << stripe_width << " files" << std::endl;
+        if (memcmp (result.data(), source.data(), xfer_size)) {
+            std::cerr << "Striped volume read returned wrong data" << std::endl;
+            return 1;
+        }
+        return 0;
+    };
+
+    int ret = run_stripe();
+    agent.deregisterMem (file_for_posix);
+    agent.deregisterMem (dram_for_posix);
+    for (const auto &path : paths) {
+        unlink (path.c_str());
+    }
+    return ret;
+}
+
 int
 main (int argc, char *argv[]) {
     if (page_size <= 0) {
@@ -755,8 +1632,9 @@ main (int argc, char *argv[]) {
     std::string test_files_dir_path = default_test_files_dir_path;
     bool use_direct_io = false;
     bool use_uring = false;
+    std::string block_device_path;
 
-    while ((opt = getopt (argc, argv, "n:s:d:DUh")) != -1) {
+    while ((opt = getopt (argc, argv, "n:s:d:b:DUh")) != -1) {
         switch (opt) {
         case 'n':
             num_transfers = std::stoi (optarg);
@@ -767,6 +1645,9 @@ main (int argc, char *argv[]) {
         case 'd':
             test_files_dir_path = optarg;
             break;
+        case 'b':
+            block_device_path = optarg;
+            break;
         case 'D':
             use_direct_io = true;
             break;
@@ -776,7 +1657,7 @@ main (int argc, char *argv[]) {
         case 'h':
         default:
             std::cout << absl::StrFormat ("Usage: %s [-n num_transfers] [-s transfer_size] [-d "
-                                          "test_files_dir_path] [-D] [-U]",
+                                          "test_files_dir_path] [-b block_device] [-D] [-U]",
                                           argv[0])
                       << std::endl;
             std::cout << absl::StrFormat (
@@ -792,6 +1673,9 @@ main (int argc, char *argv[]) {
                                           "strongly recommended to use nvme device (default: %s)",
                                           default_test_files_dir_path)
                       << std::endl;
+            std::cout << absl::StrFormat ("  -b block_device       Block device for the BLK_SEG "
+                                          "test, its data is overwritten (default: a file)")
+                      << std::endl;
             std::cout << absl::StrFormat ("  -D Use O_DIRECT for file I/O") << std::endl;
             std::cout << absl::StrFormat ("  -U Use io_uring backend instead of AIO") << std::endl;
             std::cout << absl::StrFormat ("  -h Show this help message") << std::endl;
@@ -822,5 +1706,53 @@ main (int argc, char *argv[]) {
         return 1;
     }
 
+    phase_num = 1;
+
+    ret = test_posix_unaligned (test_files_dir_path_abs_path, use_uring);
+    if (ret != 0) {
+        std::cerr << "Unaligned O_DIRECT Test failed" << std::endl;
+        return 1;
+    }
+
+    phase_num = 1;
+
+    ret = test_posix_file_cache (test_files_dir_path_abs_path, use_direct_io, use_uring);
+    if (ret != 0) {
+        std::cerr << "File Cache Test failed" << std::endl;
+        return 1;
+    }
+
+    phase_num = 1;
+
+    ret = test_posix_block (test_files_dir_path_abs_path, block_device_path, use_uring);
+    if (ret != 0) {
+        std::cerr << "Block Device Test failed" << std::endl;
+        return 1;
+    }
+
+    phase_num = 1;
+
+    ret = test_posix_conversion (test_files_dir_path_abs_path, use_uring);
+    if (ret != 0) {
+        std::cerr << "Conversion Test failed" << std::endl;
+        return 1;
+    }
+
+    phase_num = 1;
+
+    ret = test_posix_replicas (test_files_dir_path_abs_path, use_uring);
+    if (ret != 0) {
+        std::cerr << "Replica Test failed" << std::endl;
+        return 1;
+    }
+
+    phase_num = 1;
+
+    ret = test_posix_stripe (test_files_dir_path_abs_path, use_uring);
+    if (ret != 0) {
+        std::cerr << "Stripe Test failed" << std::endl;
+        return 1;
+    }
+
     return 0;
 }